@@ -21,7 +21,11 @@
 #include <utility>
 #include <fstream>
 #include <algorithm>
-#include <thread>
+#if defined(__AVX__) || defined(__SSE2__)
+#include <immintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
 #include "nlohmann/json.hpp"
 #include "backend/session/anf_runtime_algorithm.h"
 #include "utils/ms_utils.h"
@@ -30,6 +34,7 @@
 #include "ir/func_graph.h"
 #include "frontend/operator/ops.h"
 #include "ir/graph_utils.h"
+#include "common/thread_pool.h"
 
 namespace mindspore {
 namespace kernel {
@@ -505,331 +510,223 @@ int Sign(float x) {
 }
 
 namespace {
-struct BucketSparseGradient {
-  float *value_;
-  int *indices_;
-  int *global_indices_;
-  size_t indices_size_;
-};
+// Below this many indices per thread the partition costs more than the reduction it splits.
+constexpr size_t kMinIndicesPerThread = 1024;
 
-struct MultiThreadReduceSparseGradientParam {
-  SparseGradient *input_grad_{nullptr};
-  SparseGradient *workspace_grad_{nullptr};
-  SparseGradient *output_grad_{nullptr};
-  size_t max_index_{0};
-  size_t value_stride_{0};
-  size_t thread_num_{0};
-  bool use_sort_reduce_{false};
-};
+inline bool IsValidIndex(int index, size_t max_index) { return index >= 0 && IntToSize(index) < max_index; }
 
-void CalculateEachBucketSize(const std::shared_ptr<SparseGradient> &sparse_grad, size_t max_index,
-                             std::vector<size_t> *each_bucket_size) {
-  MS_LOG(DEBUG) << "Start";
-  MS_EXCEPTION_IF_NULL(sparse_grad);
-  MS_EXCEPTION_IF_NULL(sparse_grad->indices_);
-  MS_EXCEPTION_IF_NULL(each_bucket_size);
-  size_t bucket_num = each_bucket_size->size();
-  for (size_t i = 0; i < sparse_grad->indices_size_; ++i) {
-    int index = sparse_grad->indices_[i];
-    if (index >= 0 && IntToSize(index) < max_index) {
-      auto bucket_id = index % bucket_num;
-      each_bucket_size->at(bucket_id)++;
-    }
+// dst[i] += src[i] for i in [0, size).
+void AddRow(float *dst, const float *src, size_t size) {
+  size_t i = 0;
+#if defined(__AVX__)
+  for (; i + 8 <= size; i += 8) {
+    _mm256_storeu_ps(dst + i, _mm256_add_ps(_mm256_loadu_ps(dst + i), _mm256_loadu_ps(src + i)));
   }
-  MS_LOG(DEBUG) << "End";
-}
-
-void SplitAndCalculateSegmentBucketSize(const MultiThreadReduceSparseGradientParam &param,
-                                        std::vector<std::shared_ptr<SparseGradient>> *segments_ptr,
-                                        std::vector<std::shared_ptr<std::vector<size_t>>> *segment_bucket_sizes_ptr) {
-  MS_EXCEPTION_IF_NULL(param.input_grad_);
-  MS_EXCEPTION_IF_NULL(segment_bucket_sizes_ptr);
-  MS_EXCEPTION_IF_NULL(segments_ptr);
-  auto &segments = *segments_ptr;
-  auto &segment_bucket_sizes = *segment_bucket_sizes_ptr;
-  auto input_grad = param.input_grad_;
-  if (param.thread_num_ < 1) {
-    MS_EXCEPTION(ArgumentError) << "Input param thread num must > 0!";
-  }
-  size_t thread_indices_size = input_grad->indices_size_ / param.thread_num_;
-  size_t left_indices_size = input_grad->indices_size_ % param.thread_num_;
-  std::vector<std::thread> threads;
-  threads.reserve(param.thread_num_);
-  segments.reserve(param.thread_num_);
-
-  size_t current_indices_offset = 0;
-  for (size_t i = 0; i < param.thread_num_; ++i) {
-    segment_bucket_sizes.emplace_back(std::make_shared<std::vector<size_t>>(param.thread_num_, 0));
-    size_t indices_size = thread_indices_size;
-    if (i < left_indices_size) {
-      indices_size += 1;
-    }
-    segments.emplace_back(std::make_shared<SparseGradient>());
-    segments[i]->value_ = input_grad->value_ + current_indices_offset * param.value_stride_;
-    segments[i]->indices_ = input_grad->indices_ + current_indices_offset;
-    segments[i]->indices_size_ = indices_size;
-    threads.emplace_back(
-      std::thread(CalculateEachBucketSize, segments[i], param.max_index_, segment_bucket_sizes[i].get()));
-    current_indices_offset += indices_size;
+#elif defined(__SSE2__)
+  for (; i + 4 <= size; i += 4) {
+    _mm_storeu_ps(dst + i, _mm_add_ps(_mm_loadu_ps(dst + i), _mm_loadu_ps(src + i)));
   }
-
-  for (size_t i = 0; i < param.thread_num_; ++i) {
-    threads[i].join();
+#elif defined(__ARM_NEON)
+  for (; i + 4 <= size; i += 4) {
+    vst1q_f32(dst + i, vaddq_f32(vld1q_f32(dst + i), vld1q_f32(src + i)));
+  }
+#endif
+  for (; i < size; ++i) {
+    dst[i] += src[i];
   }
 }
 
-void CopySegmentIndicesToBucket(const MultiThreadReduceSparseGradientParam &param,
-                                const std::shared_ptr<SparseGradient> &segment, size_t bucket_offset,
-                                const std::vector<std::shared_ptr<BucketSparseGradient>> &buckets) {
-  MS_LOG(DEBUG) << "Start";
-  MS_EXCEPTION_IF_NULL(segment);
-  MS_EXCEPTION_IF_NULL(segment->indices_);
-  std::vector<size_t> bucket_data_num(param.thread_num_, 0);
-  for (size_t i = 0; i < segment->indices_size_; ++i) {
-    int index = segment->indices_[i];
-    if (index >= 0 && IntToSize(index) < param.max_index_) {
-      auto bucket_id = index % param.thread_num_;
-      auto bucket_index = bucket_data_num[bucket_id];
-      buckets[bucket_id]->indices_[bucket_index] = index;
-      buckets[bucket_id]->global_indices_[bucket_index] = bucket_offset + i;
-      bucket_data_num[bucket_id]++;
-    }
+void CopyRow(float *dst, size_t dst_size, const float *src, size_t size) {
+  auto ret_code = memcpy_s(dst, dst_size * sizeof(float), src, size * sizeof(float));
+  if (ret_code != EOK) {
+    MS_LOG(EXCEPTION) << "Failed to copy data!";
   }
-  MS_LOG(DEBUG) << "End";
 }
+}  // namespace
 
-void GatherSegmentIndicesToOutputBucket(const MultiThreadReduceSparseGradientParam &param,
-                                        const std::vector<std::shared_ptr<SparseGradient>> &segments,
-                                        const std::vector<std::shared_ptr<std::vector<size_t>>> &segment_bucket_sizes,
-                                        std::vector<std::shared_ptr<BucketSparseGradient>> *buckets_ptr) {
-  MS_EXCEPTION_IF_NULL(param.output_grad_);
-  MS_EXCEPTION_IF_NULL(param.output_grad_->value_);
-  MS_EXCEPTION_IF_NULL(param.output_grad_->indices_);
-  MS_EXCEPTION_IF_NULL(buckets_ptr);
-  auto &buckets = *buckets_ptr;
-  size_t thread_num = param.thread_num_;
-  if (thread_num != segment_bucket_sizes.size()) {
-    MS_EXCEPTION(ArgumentError) << "Input param thread num not equal to segment size!";
-  }
-  std::vector<size_t> bucket_data_size(thread_num, 0);
-  for (size_t i = 0; i < thread_num; ++i) {
-    for (size_t j = 0; j < thread_num; ++j) {
-      bucket_data_size[j] += segment_bucket_sizes[i]->at(j);
-    }
-  }
-  size_t current_indices_offset = 0;
-  for (size_t i = 0; i < thread_num; ++i) {
-    buckets.emplace_back(std::make_shared<BucketSparseGradient>());
-    buckets[i]->value_ = param.output_grad_->value_ + current_indices_offset * param.value_stride_;
-    buckets[i]->indices_ = param.output_grad_->indices_ + current_indices_offset;
-    buckets[i]->global_indices_ = param.workspace_grad_->indices_ + current_indices_offset;
-    buckets[i]->indices_size_ = bucket_data_size[i];
-    current_indices_offset += bucket_data_size[i];
-  }
-  std::vector<size_t> tmp_bucket_data_size(thread_num, 0);
-  std::vector<std::vector<std::shared_ptr<BucketSparseGradient>>> each_thread_buckets;
-  for (size_t i = 0; i < thread_num; ++i) {
-    std::vector<std::shared_ptr<BucketSparseGradient>> thread_buckets;
-    for (size_t j = 0; j < thread_num; ++j) {
-      thread_buckets.emplace_back(std::make_shared<BucketSparseGradient>());
-      thread_buckets[j]->indices_ = buckets[j]->indices_ + tmp_bucket_data_size[j];
-      thread_buckets[j]->global_indices_ = buckets[j]->global_indices_ + tmp_bucket_data_size[j];
-      thread_buckets[j]->value_ = buckets[j]->value_ + tmp_bucket_data_size[j] * param.value_stride_;
-      thread_buckets[j]->indices_size_ = segment_bucket_sizes[i]->at(j);
-      tmp_bucket_data_size[j] += segment_bucket_sizes[i]->at(j);
-    }
-    each_thread_buckets.emplace_back(thread_buckets);
-  }
-  std::vector<std::thread> threads;
-  threads.reserve(thread_num);
-  current_indices_offset = 0;
-  for (size_t i = 0; i < thread_num; ++i) {
-    threads.emplace_back(
-      std::thread(CopySegmentIndicesToBucket, param, segments[i], current_indices_offset, each_thread_buckets[i]));
-    current_indices_offset += segments[i]->indices_size_;
+void SparseGradientReducer::RunTasks(const std::function<void(size_t)> &task) {
+  if (thread_num_ == 1) {
+    task(0);
+    return;
   }
-  for (size_t i = 0; i < thread_num; ++i) {
-    threads[i].join();
+  tasks_.resize(thread_num_);
+  for (size_t i = 0; i < thread_num_; ++i) {
+    tasks_[i] = [&task, i]() { task(i); };
   }
+  common::ThreadPool::GetInstance().SyncRun(tasks_);
 }
 
-void SortAndReduceBucketSparseGradient(const MultiThreadReduceSparseGradientParam &param,
-                                       const std::shared_ptr<BucketSparseGradient> &bucket,
-                                       const std::shared_ptr<SparseGradient> &reduced_bucket) {
-  MS_LOG(DEBUG) << "Start";
-  MS_EXCEPTION_IF_NULL(bucket);
-  MS_EXCEPTION_IF_NULL(bucket->value_);
-  MS_EXCEPTION_IF_NULL(bucket->indices_);
-  MS_EXCEPTION_IF_NULL(reduced_bucket);
-  MS_EXCEPTION_IF_NULL(reduced_bucket->value_);
-  MS_EXCEPTION_IF_NULL(reduced_bucket->indices_);
-  std::vector<std::pair<int, int>> sorted_indices;
-  sorted_indices.reserve(bucket->indices_size_);
-  for (size_t i = 0; i < bucket->indices_size_; ++i) {
-    int index = bucket->indices_[i];
-    int global_index = bucket->global_indices_[i];
-    sorted_indices.emplace_back(std::pair<int, int>(index, global_index));
-  }
-  std::sort(sorted_indices.begin(), sorted_indices.end());
-
-  float *global_value = param.input_grad_->value_;
-  size_t unique_indices_size = 0;
-  size_t max_length = reduced_bucket->indices_size_ * param.value_stride_;
-  int last_index{0};
-  size_t value_offset{0};
-  for (size_t i = 0; i < sorted_indices.size(); ++i) {
-    int index = sorted_indices[i].first;
-    int global_index = sorted_indices[i].second;
-    int global_value_offset = global_index * param.value_stride_;
-    if (i == 0 || index != last_index) {
-      if (i != 0) {
-        unique_indices_size++;
-      }
-      reduced_bucket->indices_[unique_indices_size] = index;
-      value_offset = unique_indices_size * param.value_stride_;
-      auto ret_code = memcpy_s(reduced_bucket->value_ + value_offset, (max_length - value_offset) * sizeof(float),
-                               global_value + global_value_offset, param.value_stride_ * sizeof(float));
-      if (ret_code != EOK) {
-        MS_LOG(EXCEPTION) << "Failed to copy data!";
+void SparseGradientReducer::PartitionIndices(const ReduceSparseGradientParam &param) {
+  auto input_grad = param.input_grad_;
+  size_t indices_size = input_grad->indices_size_;
+  size_t segment_size = (indices_size + thread_num_ - 1) / thread_num_;
+  segment_bucket_sizes_.assign(thread_num_ * thread_num_, 0);
+  RunTasks([this, &param, input_grad, indices_size, segment_size](size_t segment) {
+    size_t *bucket_sizes = segment_bucket_sizes_.data() + segment * thread_num_;
+    size_t end = std::min(indices_size, (segment + 1) * segment_size);
+    for (size_t i = segment * segment_size; i < end; ++i) {
+      int index = input_grad->indices_[i];
+      if (IsValidIndex(index, param.max_index_)) {
+        bucket_sizes[IntToSize(index) % thread_num_]++;
       }
-    } else {
-      for (size_t j = 0; j < param.value_stride_; ++j) {
-        reduced_bucket->value_[value_offset + j] += global_value[global_value_offset + j];
+    }
+  });
+
+  // Bucket j holds the indices of segment 0 first, then those of segment 1, and so on, which keeps the first
+  // occurrence order of the input inside every bucket.
+  bucket_offsets_.assign(thread_num_ + 1, 0);
+  bucket_write_offsets_.resize(thread_num_ * thread_num_);
+  for (size_t bucket = 0; bucket < thread_num_; ++bucket) {
+    size_t offset = bucket_offsets_[bucket];
+    for (size_t segment = 0; segment < thread_num_; ++segment) {
+      bucket_write_offsets_[segment * thread_num_ + bucket] = offset;
+      offset += segment_bucket_sizes_[segment * thread_num_ + bucket];
+    }
+    bucket_offsets_[bucket + 1] = offset;
+  }
+
+  // The bucketed indices go to the output and their positions in the input to the workspace, both are overwritten
+  // by the later steps.
+  RunTasks([this, &param, input_grad, indices_size, segment_size](size_t segment) {
+    size_t *write_offsets = bucket_write_offsets_.data() + segment * thread_num_;
+    size_t end = std::min(indices_size, (segment + 1) * segment_size);
+    for (size_t i = segment * segment_size; i < end; ++i) {
+      int index = input_grad->indices_[i];
+      if (IsValidIndex(index, param.max_index_)) {
+        size_t pos = write_offsets[IntToSize(index) % thread_num_]++;
+        param.output_grad_->indices_[pos] = index;
+        param.workspace_grad_->indices_[pos] = SizeToInt(i);
       }
     }
-    last_index = index;
-  }
-  reduced_bucket->indices_size_ = unique_indices_size;
-  MS_LOG(DEBUG) << "End";
-}
-
-void ReduceBucketSparseGradient(const MultiThreadReduceSparseGradientParam &param,
-                                const std::shared_ptr<BucketSparseGradient> &bucket,
-                                const std::shared_ptr<SparseGradient> &reduced_bucket) {
-  MS_LOG(DEBUG) << "Start";
-  MS_EXCEPTION_IF_NULL(bucket);
-  MS_EXCEPTION_IF_NULL(bucket->value_);
-  MS_EXCEPTION_IF_NULL(bucket->indices_);
-  MS_EXCEPTION_IF_NULL(reduced_bucket);
-  MS_EXCEPTION_IF_NULL(reduced_bucket->value_);
-  MS_EXCEPTION_IF_NULL(reduced_bucket->indices_);
-
-  float *global_value = param.input_grad_->value_;
-  std::unordered_map<int, size_t> index_map;
-  size_t unique_indices_size = 0;
-  size_t max_length = reduced_bucket->indices_size_ * param.value_stride_;
-  for (size_t i = 0; i < bucket->indices_size_; ++i) {
-    int index = bucket->indices_[i];
-    int global_index = bucket->global_indices_[i];
-    auto iter = index_map.find(index);
-    if (iter == index_map.end()) {
-      reduced_bucket->indices_[unique_indices_size] = index;
-      size_t start_index = unique_indices_size * param.value_stride_;
-      index_map[index] = start_index;
-      auto ret_code = memcpy_s(reduced_bucket->value_ + start_index, (max_length - start_index) * sizeof(float),
-                               global_value + global_index * param.value_stride_, param.value_stride_ * sizeof(float));
-      if (ret_code != EOK) {
-        MS_LOG(EXCEPTION) << "Failed to copy data!";
+  });
+}
+
+void SparseGradientReducer::ReduceBuckets(const ReduceSparseGradientParam &param) {
+  size_t stride = param.value_stride_;
+  const float *input_value = param.input_grad_->value_;
+  unique_sizes_.assign(thread_num_, 0);
+  if (param.use_sort_reduce_) {
+    sort_buffers_.resize(thread_num_);
+    RunTasks([this, &param, stride, input_value](size_t bucket) {
+      size_t begin = bucket_offsets_[bucket];
+      size_t end = bucket_offsets_[bucket + 1];
+      auto &sorted_indices = sort_buffers_[bucket];
+      sorted_indices.clear();
+      for (size_t i = begin; i < end; ++i) {
+        sorted_indices.emplace_back(param.output_grad_->indices_[i], param.workspace_grad_->indices_[i]);
       }
-      unique_indices_size++;
-    } else {
-      size_t start_index = iter->second;
-      size_t end_index = start_index + param.value_stride_;
-      for (size_t j = start_index, k = global_index * param.value_stride_; j < end_index; ++j, ++k) {
-        reduced_bucket->value_[j] += global_value[k];
+      std::sort(sorted_indices.begin(), sorted_indices.end());
+      float *value = param.workspace_grad_->value_ + begin * stride;
+      int *indices = param.workspace_grad_->indices_ + begin;
+      size_t max_length = (end - begin) * stride;
+      size_t unique_size = 0;
+      for (size_t i = 0; i < sorted_indices.size(); ++i) {
+        const float *row = input_value + IntToSize(sorted_indices[i].second) * stride;
+        if (i == 0 || sorted_indices[i].first != sorted_indices[i - 1].first) {
+          indices[unique_size] = sorted_indices[i].first;
+          CopyRow(value + unique_size * stride, max_length - unique_size * stride, row, stride);
+          unique_size++;
+        } else {
+          AddRow(value + (unique_size - 1) * stride, row, stride);
+        }
       }
-    }
+      unique_sizes_[bucket] = unique_size;
+    });
+    return;
   }
-  reduced_bucket->indices_size_ = unique_indices_size;
-  MS_LOG(DEBUG) << "End";
-}
 
-void ReduceBucketSparseGradientToWorkspace(const MultiThreadReduceSparseGradientParam &param,
-                                           const std::vector<std::shared_ptr<BucketSparseGradient>> &buckets,
-                                           std::vector<std::shared_ptr<SparseGradient>> *reduced_buckets_ptr) {
-  MS_EXCEPTION_IF_NULL(param.workspace_grad_);
-  MS_EXCEPTION_IF_NULL(param.workspace_grad_->value_);
-  MS_EXCEPTION_IF_NULL(param.workspace_grad_->indices_);
-  MS_EXCEPTION_IF_NULL(reduced_buckets_ptr);
-  auto &reduced_buckets = *reduced_buckets_ptr;
-  size_t thread_num = buckets.size();
-  std::vector<std::thread> threads;
-  threads.reserve(thread_num);
-
-  size_t current_indices_offset = 0;
-  for (size_t i = 0; i < thread_num; ++i) {
-    reduced_buckets.emplace_back(std::make_shared<SparseGradient>());
-    reduced_buckets[i]->value_ = param.workspace_grad_->value_ + current_indices_offset * param.value_stride_;
-    reduced_buckets[i]->indices_ = param.workspace_grad_->indices_ + current_indices_offset;
-    reduced_buckets[i]->indices_size_ = buckets[i]->indices_size_;
-    if (param.use_sort_reduce_) {
-      threads.emplace_back(std::thread(SortAndReduceBucketSparseGradient, param, buckets[i], reduced_buckets[i]));
-    } else {
-      threads.emplace_back(std::thread(ReduceBucketSparseGradient, param, buckets[i], reduced_buckets[i]));
+  // The buckets hold disjoint indices, so they share one slot table without locks. The reduced rows are written over
+  // the positions of the bucket in the workspace, which is safe as the write position never passes the read one.
+  if (index_slots_.size() < param.max_index_) {
+    index_slots_.resize(param.max_index_, -1);
+  }
+  RunTasks([this, &param, stride, input_value](size_t bucket) {
+    size_t begin = bucket_offsets_[bucket];
+    size_t end = bucket_offsets_[bucket + 1];
+    const int *bucket_indices = param.output_grad_->indices_ + begin;
+    int *positions = param.workspace_grad_->indices_ + begin;
+    float *value = param.workspace_grad_->value_ + begin * stride;
+    size_t max_length = (end - begin) * stride;
+    size_t unique_size = 0;
+    for (size_t i = 0; i < end - begin; ++i) {
+      int index = bucket_indices[i];
+      const float *row = input_value + IntToSize(positions[i]) * stride;
+      int &slot = index_slots_[IntToSize(index)];
+      if (slot < 0) {
+        slot = SizeToInt(unique_size);
+        positions[unique_size] = index;
+        CopyRow(value + unique_size * stride, max_length - unique_size * stride, row, stride);
+        unique_size++;
+      } else {
+        AddRow(value + IntToSize(slot) * stride, row, stride);
+      }
     }
-    current_indices_offset += buckets[i]->indices_size_;
-  }
-  for (size_t i = 0; i < thread_num; ++i) {
-    threads[i].join();
-  }
+    for (size_t i = 0; i < unique_size; ++i) {
+      index_slots_[IntToSize(positions[i])] = -1;
+    }
+    unique_sizes_[bucket] = unique_size;
+  });
 }
 
-void MergeReduceSparseGradient(const MultiThreadReduceSparseGradientParam &param,
-                               const std::vector<std::shared_ptr<SparseGradient>> &reduced_buckets) {
-  MS_EXCEPTION_IF_NULL(param.output_grad_);
+void SparseGradientReducer::MergeBuckets(const ReduceSparseGradientParam &param) {
   auto output_grad = param.output_grad_;
-  MS_EXCEPTION_IF_NULL(output_grad->value_);
-  MS_EXCEPTION_IF_NULL(output_grad->indices_);
-  size_t stride_data_size = param.value_stride_ * sizeof(float);
-  size_t unique_indices_size = 0;
-  for (size_t i = 0; i < reduced_buckets.size(); ++i) {
-    auto &bucket = reduced_buckets[i];
-    MS_EXCEPTION_IF_NULL(bucket);
-    if (bucket->indices_size_ == 0) {
-      continue;
-    }
-    auto ret_code = memcpy_s(output_grad->value_ + unique_indices_size * param.value_stride_,
-                             (output_grad->indices_size_ - unique_indices_size) * stride_data_size, bucket->value_,
-                             bucket->indices_size_ * stride_data_size);
+  size_t capacity = output_grad->indices_size_;
+  size_t stride = param.value_stride_;
+  merge_offsets_.assign(thread_num_ + 1, 0);
+  for (size_t bucket = 0; bucket < thread_num_; ++bucket) {
+    merge_offsets_[bucket + 1] = merge_offsets_[bucket] + unique_sizes_[bucket];
+  }
+  if (merge_offsets_[thread_num_] > capacity) {
+    MS_LOG(EXCEPTION) << "The output of the sparse gradient can hold " << capacity << " indices, but "
+                      << merge_offsets_[thread_num_] << " are unique.";
+  }
+  RunTasks([this, output_grad, capacity, stride, &param](size_t bucket) {
+    size_t size = unique_sizes_[bucket];
+    if (size == 0) {
+      return;
+    }
+    size_t src = bucket_offsets_[bucket];
+    size_t dst = merge_offsets_[bucket];
+    CopyRow(output_grad->value_ + dst * stride, (capacity - dst) * stride, param.workspace_grad_->value_ + src * stride,
+            size * stride);
+    auto ret_code = memcpy_s(output_grad->indices_ + dst, (capacity - dst) * sizeof(int),
+                             param.workspace_grad_->indices_ + src, size * sizeof(int));
     if (ret_code != EOK) {
       MS_LOG(EXCEPTION) << "Failed to copy data!";
     }
-    ret_code = memcpy_s(output_grad->indices_ + unique_indices_size,
-                        (output_grad->indices_size_ - unique_indices_size) * sizeof(int), bucket->indices_,
-                        bucket->indices_size_ * sizeof(int));
-    if (ret_code != EOK) {
-      MS_LOG(EXCEPTION) << "Failed to copy data!";
-    }
-    unique_indices_size += bucket->indices_size_;
-  }
-  output_grad->indices_size_ = unique_indices_size;
+  });
+  output_grad->indices_size_ = merge_offsets_[thread_num_];
 }
-}  // namespace
 
-void BucketReduceSparseGradient(const ReduceSparseGradientParam &param) {
+void SparseGradientReducer::Reduce(const ReduceSparseGradientParam &param) {
   MS_LOG(DEBUG) << "Start";
   MS_EXCEPTION_IF_NULL(param.input_grad_);
-  size_t thread_num = 23;
-  if (param.input_grad_->indices_size_ < thread_num) {
-    thread_num = param.input_grad_->indices_size_;
+  MS_EXCEPTION_IF_NULL(param.workspace_grad_);
+  MS_EXCEPTION_IF_NULL(param.output_grad_);
+  size_t indices_size = param.input_grad_->indices_size_;
+  if (indices_size == 0) {
+    param.output_grad_->indices_size_ = 0;
+    return;
   }
-  MultiThreadReduceSparseGradientParam multi_thread_param({param.input_grad_, param.workspace_grad_, param.output_grad_,
-                                                           param.max_index_, param.value_stride_, thread_num,
-                                                           param.use_sort_reduce_});
-  std::vector<std::shared_ptr<SparseGradient>> segments;
-  std::vector<std::shared_ptr<std::vector<size_t>>> segment_bucket_sizes;
-  SplitAndCalculateSegmentBucketSize(multi_thread_param, &segments, &segment_bucket_sizes);
-
-  std::vector<std::shared_ptr<BucketSparseGradient>> buckets;
-  GatherSegmentIndicesToOutputBucket(multi_thread_param, segments, segment_bucket_sizes, &buckets);
-
-  std::vector<std::shared_ptr<SparseGradient>> reduced_buckets;
-  ReduceBucketSparseGradientToWorkspace(multi_thread_param, buckets, &reduced_buckets);
-
-  MergeReduceSparseGradient(multi_thread_param, reduced_buckets);
+  MS_EXCEPTION_IF_NULL(param.input_grad_->value_);
+  MS_EXCEPTION_IF_NULL(param.input_grad_->indices_);
+  MS_EXCEPTION_IF_NULL(param.workspace_grad_->value_);
+  MS_EXCEPTION_IF_NULL(param.workspace_grad_->indices_);
+  MS_EXCEPTION_IF_NULL(param.output_grad_->value_);
+  MS_EXCEPTION_IF_NULL(param.output_grad_->indices_);
+  size_t pool_size = std::max(common::ThreadPool::GetInstance().thread_num(), static_cast<size_t>(1));
+  thread_num_ = std::min(pool_size, (indices_size + kMinIndicesPerThread - 1) / kMinIndicesPerThread);
+  PartitionIndices(param);
+  ReduceBuckets(param);
+  MergeBuckets(param);
   MS_LOG(DEBUG) << "End";
 }
 
+void BucketReduceSparseGradient(const ReduceSparseGradientParam &param) {
+  SparseGradientReducer reducer;
+  reducer.Reduce(param);
+}
+
 std::pair<AnfNodePtr, size_t> GetKernelInput(const AnfNodePtr &anf_node, size_t index) {
   MS_EXCEPTION_IF_NULL(anf_node);
 
@@ -1076,19 +973,17 @@ bool IsWeightBoundary(const AnfNodePtr &node) {
 
 void MultiThreadCompute(const MultiThreadComputeFunc &func, MultiThreadComputeParams *params,
                         size_t total_compute_size) {
-  const size_t kThreadNum = 24;
-  std::vector<std::thread> threads;
-  threads.reserve(kThreadNum);
+  auto &pool = common::ThreadPool::GetInstance();
+  size_t thread_num = std::max(pool.thread_num(), static_cast<size_t>(1));
+  std::vector<common::Task> tasks;
   size_t start = 0;
-  size_t once_compute_size = (total_compute_size + kThreadNum - 1) / kThreadNum;
+  size_t once_compute_size = (total_compute_size + thread_num - 1) / thread_num;
   while (start < total_compute_size) {
     size_t end = (start + once_compute_size) > total_compute_size ? total_compute_size : (start + once_compute_size);
-    threads.emplace_back(std::thread(func, params, start, end));
+    tasks.emplace_back([&func, params, start, end]() { func(params, start, end); });
     start += once_compute_size;
   }
-  for (size_t i = 0; i < threads.size(); ++i) {
-    threads[i].join();
-  }
+  pool.SyncRun(tasks);
 }
 
 std::vector<int> GetReduceAttrAxis(const CNodePtr &cnode) {
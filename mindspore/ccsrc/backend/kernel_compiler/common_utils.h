@@ -18,6 +18,7 @@
 #define MINDSPORE_CCSRC_BACKEND_KERNEL_COMPILER_COMMON_UTILS_H_
 
 #include <dirent.h>
+#include <functional>
 #include <memory>
 #include <unordered_map>
 #include <unordered_set>
@@ -29,6 +30,7 @@
 #include "backend/kernel_compiler/kernel.h"
 #include "backend/kernel_compiler/oplib/opinfo.h"
 #include "backend/kernel_compiler/kernel_build_info.h"
+#include "common/thread_pool.h"
 
 namespace mindspore {
 namespace kernel {
@@ -86,6 +88,37 @@ struct ReduceSparseGradientParam {
   bool use_sort_reduce_{false};
 };
 
+// Sums the rows of a sparse gradient which share an index. The indices are partitioned into one bucket per thread by
+// their value, and as the buckets hold disjoint indices each one is deduplicated on its own through a table from index
+// to output row. The table and the bucket bookkeeping stay allocated between calls and the work runs on
+// common::ThreadPool, so a kernel which keeps a reducer neither allocates nor starts threads in a step.
+class SparseGradientReducer {
+ public:
+  SparseGradientReducer() = default;
+  ~SparseGradientReducer() = default;
+  void Reduce(const ReduceSparseGradientParam &param);
+
+ private:
+  void RunTasks(const std::function<void(size_t)> &task);
+  void PartitionIndices(const ReduceSparseGradientParam &param);
+  void ReduceBuckets(const ReduceSparseGradientParam &param);
+  void MergeBuckets(const ReduceSparseGradientParam &param);
+
+  size_t thread_num_{0};
+  std::vector<common::Task> tasks_;
+  // segment_bucket_sizes_[i * thread_num_ + j] is the number of indices of segment i which belong to bucket j, and
+  // bucket_write_offsets_ is where segment i writes its first index of bucket j.
+  std::vector<size_t> segment_bucket_sizes_;
+  std::vector<size_t> bucket_write_offsets_;
+  std::vector<size_t> bucket_offsets_;
+  std::vector<size_t> unique_sizes_;
+  std::vector<size_t> merge_offsets_;
+  // (index, position in the input) pairs of every bucket, only used by the sort reduce.
+  std::vector<std::vector<std::pair<int, int>>> sort_buffers_;
+  // The output row of every index met in the running call, -1 for all the others.
+  std::vector<int> index_slots_;
+};
+
 struct MultiThreadComputeParams {
   float *var_;
   float *accum_;
@@ -134,6 +167,7 @@ void GetGraphRealOutput(const FuncGraphPtr &func_graph, std::vector<std::pair<An
 bool IsWeightBoundary(const AnfNodePtr &node);
 void MultiThreadCompute(const MultiThreadComputeFunc &func, MultiThreadComputeParams *params,
                         size_t total_compute_size);
+// Runs a SparseGradientReducer made for this call only, kernels keep their own reducer instead.
 void BucketReduceSparseGradient(const ReduceSparseGradientParam &param);
 std::vector<int> GetReduceAttrAxis(const CNodePtr &cnode);
 }  // namespace kernel
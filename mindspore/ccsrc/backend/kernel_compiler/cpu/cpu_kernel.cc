@@ -14,6 +14,8 @@
  * limitations under the License.
  */
 #include "backend/kernel_compiler/cpu/cpu_kernel.h"
+#include <algorithm>
+#include "common/thread_pool.h"
 
 namespace mindspore {
 namespace kernel {
@@ -76,5 +78,22 @@ void CPUKernelUtils::GetElementNumEveryDim(const std::vector<size_t> &shape, std
   }
   std::reverse(element_num->begin(), element_num->end());
 }
+
+void CPUKernelUtils::ParallelFor(const std::function<void(size_t, size_t)> &task, size_t count,
+                                 size_t min_range_size) {
+  auto &pool = common::ThreadPool::GetInstance();
+  size_t range_num = std::min(pool.thread_num(), count / std::max(min_range_size, static_cast<size_t>(1)));
+  if (range_num <= 1) {
+    task(0, count);
+    return;
+  }
+  size_t range_size = (count + range_num - 1) / range_num;
+  std::vector<common::Task> tasks;
+  for (size_t start = 0; start < count; start += range_size) {
+    size_t end = std::min(start + range_size, count);
+    tasks.emplace_back([&task, start, end]() { task(start, end); });
+  }
+  pool.SyncRun(tasks);
+}
 }  // namespace kernel
 }  // namespace mindspore
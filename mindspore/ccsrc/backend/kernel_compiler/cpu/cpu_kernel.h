@@ -80,6 +80,9 @@ class CPUKernelUtils {
   static size_t CalcOffset(const std::vector<size_t> &shape, size_t dim0, size_t dim1, size_t dim2, size_t dim3);
   static size_t GetElementNumOnAxis(const std::vector<size_t> &shape, int axis);
   static void GetElementNumEveryDim(const std::vector<size_t> &shape, std::vector<size_t> *element_num);
+  // Split [0, count) into ranges of at least min_range_size elements and run task(start, end) for each of them on the
+  // shared thread pool, a small count runs inline.
+  static void ParallelFor(const std::function<void(size_t, size_t)> &task, size_t count, size_t min_range_size);
 };
 }  // namespace kernel
 }  // namespace mindspore
@@ -0,0 +1,176 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "backend/kernel_compiler/cpu/fused_elemwise_cpu_kernel.h"
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <numeric>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include "frontend/operator/ops.h"
+#include "runtime/device/cpu/cpu_device_address.h"
+#include "utils/utils.h"
+
+namespace mindspore {
+namespace kernel {
+namespace {
+// One block of every intermediate result stays in L1 while the chain runs over it.
+constexpr size_t kBlockSize = 256;
+constexpr size_t kMinParallelSize = 64 * 1024;
+}  // namespace
+
+void FusedElemwiseCPUKernel::InitKernel(const CNodePtr &kernel_node) {
+  MS_EXCEPTION_IF_NULL(kernel_node);
+  static const std::unordered_map<std::string, std::pair<ElemwiseOpType, size_t>> kOpTypes = {
+    {prim::kPrimTensorAdd->name(), {kAdd, 2}}, {prim::kPrimSub->name(), {kSub, 2}},
+    {prim::kPrimMul->name(), {kMul, 2}},       {prim::kPrimRealDiv->name(), {kDiv, 2}},
+    {prim::kPrimRelu->name(), {kRelu, 1}},     {prim::kPrimNeg->name(), {kNeg, 1}},
+    {prim::kPrimSquare->name(), {kSquare, 1}}, {prim::kPrimSqrt->name(), {kSqrt, 1}}};
+  auto op_names = AnfAlgo::GetNodeAttr<std::vector<std::string>>(kernel_node, kAttrFusedOps);
+  auto operands = AnfAlgo::GetNodeAttr<std::vector<int>>(kernel_node, kAttrFusedOperands);
+  size_t input_num = AnfAlgo::GetInputTensorNum(kernel_node);
+  auto output_shape = AnfAlgo::GetOutputInferShape(kernel_node, 0);
+  element_num_ = std::accumulate(output_shape.begin(), output_shape.end(), static_cast<size_t>(1),
+                                 std::multiplies<size_t>());
+  is_scalar_input_.clear();
+  for (size_t i = 0; i < input_num; ++i) {
+    auto shape = AnfAlgo::GetPrevNodeOutputInferShape(kernel_node, i);
+    size_t num = std::accumulate(shape.begin(), shape.end(), static_cast<size_t>(1), std::multiplies<size_t>());
+    if (num != element_num_ && num != 1) {
+      MS_LOG(EXCEPTION) << "Input " << i << " of FusedElemwise has " << num << " elements, but the output has "
+                        << element_num_;
+    }
+    is_scalar_input_.push_back(num != element_num_);
+  }
+
+  ops_.clear();
+  size_t operand_pos = 0;
+  for (size_t k = 0; k < op_names.size(); ++k) {
+    auto iter = kOpTypes.find(op_names[k]);
+    if (iter == kOpTypes.end()) {
+      MS_LOG(EXCEPTION) << "FusedElemwise does not support op " << op_names[k];
+    }
+    ElemwiseOp op{iter->second.first, iter->second.second, {0, 0}};
+    for (size_t j = 0; j < op.operand_num; ++j, ++operand_pos) {
+      // An operand is an input of the kernel or the result of an earlier op of the chain.
+      if (operand_pos >= operands.size() || operands[operand_pos] < 0 ||
+          IntToSize(operands[operand_pos]) >= input_num + k) {
+        MS_LOG(EXCEPTION) << "Invalid operands of op " << k << " in FusedElemwise.";
+      }
+      op.operands[j] = IntToSize(operands[operand_pos]);
+    }
+    ops_.push_back(op);
+  }
+  if (ops_.empty() || operand_pos != operands.size()) {
+    MS_LOG(EXCEPTION) << "FusedElemwise has " << ops_.size() << " ops but " << operands.size() << " operands.";
+  }
+}
+
+void FusedElemwiseCPUKernel::LaunchRange(const std::vector<AddressPtr> &inputs, float *output, size_t start,
+                                         size_t end) const {
+  size_t input_num = is_scalar_input_.size();
+  std::vector<float> results(ops_.size() * kBlockSize);
+  std::vector<float> scalars(input_num * kBlockSize);
+  for (size_t i = 0; i < input_num; ++i) {
+    if (is_scalar_input_[i]) {
+      std::fill_n(scalars.data() + i * kBlockSize, kBlockSize, reinterpret_cast<float *>(inputs[i]->addr)[0]);
+    }
+  }
+  for (size_t block = start; block < end; block += kBlockSize) {
+    size_t len = std::min(kBlockSize, end - block);
+    for (size_t k = 0; k < ops_.size(); ++k) {
+      const auto &op = ops_[k];
+      const float *src[2] = {nullptr, nullptr};
+      for (size_t j = 0; j < op.operand_num; ++j) {
+        size_t index = op.operands[j];
+        if (index >= input_num) {
+          src[j] = results.data() + (index - input_num) * kBlockSize;
+        } else if (is_scalar_input_[index]) {
+          src[j] = scalars.data() + index * kBlockSize;
+        } else {
+          src[j] = reinterpret_cast<float *>(inputs[index]->addr) + block;
+        }
+      }
+      float *dst = (k + 1 == ops_.size()) ? output + block : results.data() + k * kBlockSize;
+      const float *a = src[0];
+      const float *b = src[1];
+      switch (op.type) {
+        case kAdd:
+          for (size_t i = 0; i < len; ++i) {
+            dst[i] = a[i] + b[i];
+          }
+          break;
+        case kSub:
+          for (size_t i = 0; i < len; ++i) {
+            dst[i] = a[i] - b[i];
+          }
+          break;
+        case kMul:
+          for (size_t i = 0; i < len; ++i) {
+            dst[i] = a[i] * b[i];
+          }
+          break;
+        case kDiv:
+          for (size_t i = 0; i < len; ++i) {
+            dst[i] = a[i] / b[i];
+          }
+          break;
+        case kRelu:
+          for (size_t i = 0; i < len; ++i) {
+            dst[i] = a[i] > 0 ? a[i] : 0;
+          }
+          break;
+        case kNeg:
+          for (size_t i = 0; i < len; ++i) {
+            dst[i] = -a[i];
+          }
+          break;
+        case kSquare:
+          for (size_t i = 0; i < len; ++i) {
+            dst[i] = a[i] * a[i];
+          }
+          break;
+        case kSqrt:
+          for (size_t i = 0; i < len; ++i) {
+            dst[i] = std::sqrt(a[i]);
+          }
+          break;
+        default:
+          MS_LOG(EXCEPTION) << "Unknown op type " << op.type << " in FusedElemwise.";
+      }
+    }
+  }
+}
+
+bool FusedElemwiseCPUKernel::Launch(const std::vector<kernel::AddressPtr> &inputs,
+                                    const std::vector<kernel::AddressPtr> & /*workspace*/,
+                                    const std::vector<kernel::AddressPtr> &outputs) {
+  if (inputs.size() != is_scalar_input_.size() || outputs.empty()) {
+    MS_LOG(EXCEPTION) << "FusedElemwise error input output size!";
+  }
+  auto output = reinterpret_cast<float *>(outputs[0]->addr);
+  // Ranges are aligned to whole blocks so that every thread runs full blocks except the last one.
+  size_t block_num = (element_num_ + kBlockSize - 1) / kBlockSize;
+  CPUKernelUtils::ParallelFor(
+    [this, &inputs, output](size_t start, size_t end) {
+      LaunchRange(inputs, output, start * kBlockSize, std::min(end * kBlockSize, element_num_));
+    },
+    block_num, kMinParallelSize / kBlockSize);
+  return true;
+}
+}  // namespace kernel
+}  // namespace mindspore
@@ -0,0 +1,57 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_BACKEND_KERNEL_COMPILER_CPU_FUSED_ELEMWISE_CPU_KERNEL_H_
+#define MINDSPORE_CCSRC_BACKEND_KERNEL_COMPILER_CPU_FUSED_ELEMWISE_CPU_KERNEL_H_
+#include <vector>
+#include <memory>
+#include "backend/kernel_compiler/cpu/cpu_kernel.h"
+#include "backend/kernel_compiler/cpu/cpu_kernel_factory.h"
+
+namespace mindspore {
+namespace kernel {
+// Runs the chain of elementwise ops built by ElemwiseChainFusion block by block, each block of the inputs is read
+// once and only the result of the last op is written to the output.
+class FusedElemwiseCPUKernel : public CPUKernel {
+ public:
+  FusedElemwiseCPUKernel() = default;
+  ~FusedElemwiseCPUKernel() override = default;
+
+  void InitKernel(const CNodePtr &kernel_node) override;
+
+  bool Launch(const std::vector<AddressPtr> &inputs, const std::vector<AddressPtr> &workspace,
+              const std::vector<AddressPtr> &outputs) override;
+
+ private:
+  enum ElemwiseOpType { kAdd = 0, kSub, kMul, kDiv, kRelu, kNeg, kSquare, kSqrt };
+  struct ElemwiseOp {
+    ElemwiseOpType type;
+    size_t operand_num;
+    size_t operands[2];
+  };
+  void LaunchRange(const std::vector<AddressPtr> &inputs, float *output, size_t start, size_t end) const;
+
+  std::vector<ElemwiseOp> ops_;
+  std::vector<bool> is_scalar_input_;
+  size_t element_num_{0};
+};
+
+MS_REG_CPU_KERNEL(FusedElemwise,
+                  KernelAttr().SetAllSameAttr(true).AddInputAttr(kNumberTypeFloat32).AddOutputAttr(kNumberTypeFloat32),
+                  FusedElemwiseCPUKernel);
+}  // namespace kernel
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_BACKEND_KERNEL_COMPILER_CPU_FUSED_ELEMWISE_CPU_KERNEL_H_
@@ -14,24 +14,52 @@
  * limitations under the License.
  */
 #include "backend/kernel_compiler/cpu/mkldnn/conv2d_cpu_kernel.h"
+#include <memory>
 #include <string>
 #include "utils/ms_utils.h"
 #include "backend/kernel_compiler/cpu/mkldnn/mkl_kernel_engine.h"
+#include "ir/manager.h"
 #include "runtime/device/cpu/cpu_device_address.h"
+#include "utils/utils.h"
 
 namespace mindspore {
 namespace kernel {
+namespace {
+constexpr size_t kConvWeightsIndex = 2;
+
+// The weights are static when they are a parameter this conv is the only user of, then nothing in the graph, such
+// as an optimizer, writes them in place between two launches.
+bool IsStaticWeights(const CNodePtr &kernel_node) {
+  auto weights = AnfAlgo::VisitKernel(kernel_node->input(kConvWeightsIndex), 0).first;
+  MS_EXCEPTION_IF_NULL(weights);
+  auto func_graph = kernel_node->func_graph();
+  if (!weights->isa<Parameter>() || func_graph == nullptr || func_graph->manager() == nullptr) {
+    return false;
+  }
+  auto &node_users = func_graph->manager()->node_users();
+  auto iter = node_users.find(weights);
+  return iter != node_users.end() && iter->second.size() == 1;
+}
+}  // namespace
+
 void Conv2dCPUKernel::InitKernel(const CNodePtr &kernel_node) {
   MS_EXCEPTION_IF_NULL(kernel_node);
-  std::vector<size_t> src_shape = AnfAlgo::GetInputDeviceShape(kernel_node, 0);
-  std::vector<size_t> weight_shape = AnfAlgo::GetInputDeviceShape(kernel_node, 1);
-  std::vector<size_t> dst_shape = AnfAlgo::GetOutputDeviceShape(kernel_node, 0);
+  std::vector<size_t> src_shape = AnfAlgo::GetPrevNodeOutputInferShape(kernel_node, 0);
+  std::vector<size_t> weight_shape = AnfAlgo::GetPrevNodeOutputInferShape(kernel_node, 1);
+  std::vector<size_t> dst_shape = AnfAlgo::GetOutputInferShape(kernel_node, 0);
   if (src_shape.size() != 4 || weight_shape.size() != 4) {
     MS_LOG(EXCEPTION) << "conv2d only support nchw input!";
   }
-  dnnl::memory::desc src_desc = GetDefaultMemDesc(src_shape);
+  std::string src_format = AnfAlgo::GetInputFormat(kernel_node, 0);
+  dnnl::memory::desc src_desc = GetFormatMemDesc(src_shape, src_format);
   dnnl::memory::desc weights_desc = GetDefaultMemDesc(weight_shape);
-  dnnl::memory::desc dst_desc = GetDefaultMemDesc(dst_shape);
+  dnnl::memory::desc dst_desc = GetFormatMemDesc(dst_shape, AnfAlgo::GetOutputFormat(kernel_node, 0));
+  // On blocked data the primitive picks the weights layout it runs best on, and the weights are reordered to it.
+  dnnl::memory::desc prim_weights_desc = weights_desc;
+  if (src_format == kOpFormat_NC1HWC0) {
+    dnnl::memory::dims weights_dims(weight_shape.begin(), weight_shape.end());
+    prim_weights_desc = formatted_md(weights_dims, dnnl::memory::format_tag::any);
+  }
   auto stride_ori = AnfAlgo::GetNodeAttr<std::vector<int>>(kernel_node, STRIDE);
   auto dilation_ori = AnfAlgo::GetNodeAttr<std::vector<int>>(kernel_node, DILATION);
   if (stride_ori.size() != 4 || stride_ori[2] != stride_ori[3]) {
@@ -62,15 +90,42 @@ void Conv2dCPUKernel::InitKernel(const CNodePtr &kernel_node) {
   }
   dnnl::memory::dims padding_l{int_padding_l[0], int_padding_l[1]};
   dnnl::memory::dims padding_r{int_padding_r[0], int_padding_r[1]};
-  dnnl::convolution_forward::desc desc =
-    dnnl::convolution_forward::desc(dnnl::prop_kind::forward_training, dnnl::algorithm::convolution_auto, src_desc,
-                                    weights_desc, dst_desc, strides, dilates, padding_l, padding_r);
+  // The bias and the ReLU folded in by the CPU post-op fusions are applied while the output is written.
+  has_bias_ = AnfAlgo::GetInputTensorNum(kernel_node) > 2;
+  dnnl::primitive_attr attr;
+  if (AnfAlgo::HasNodeAttr(kAttrFusedRelu, kernel_node) && AnfAlgo::GetNodeAttr<bool>(kernel_node, kAttrFusedRelu)) {
+    dnnl::post_ops ops;
+    ops.append_eltwise(1.0f, dnnl::algorithm::eltwise_relu, 0.0f, 0.0f);
+    attr.set_post_ops(ops);
+  }
+  std::shared_ptr<dnnl::convolution_forward::desc> desc;
+  dnnl::memory::desc bias_desc;
+  if (has_bias_) {
+    bias_desc = GetDefaultMemDesc({dst_shape[1]});
+    desc = std::make_shared<dnnl::convolution_forward::desc>(
+      dnnl::prop_kind::forward_training, dnnl::algorithm::convolution_auto, src_desc, prim_weights_desc, bias_desc,
+      dst_desc, strides, dilates, padding_l, padding_r);
+  } else {
+    desc = std::make_shared<dnnl::convolution_forward::desc>(
+      dnnl::prop_kind::forward_training, dnnl::algorithm::convolution_auto, src_desc, prim_weights_desc, dst_desc,
+      strides, dilates, padding_l, padding_r);
+  }
 
-  auto prim_desc = dnnl::convolution_forward::primitive_desc(desc, MKLKernelEngine::Get().engine());
+  auto prim_desc = dnnl::convolution_forward::primitive_desc(*desc, attr, MKLKernelEngine::Get().engine());
   primitive_ = std::make_shared<dnnl::convolution_forward>(prim_desc);
 
   AddArgument(DNNL_ARG_SRC, src_desc);
-  AddArgument(DNNL_ARG_WEIGHTS, weights_desc);
+  reorder_weights_ = prim_desc.weights_desc() != weights_desc;
+  if (reorder_weights_) {
+    static_weights_ = IsStaticWeights(kernel_node);
+    user_weights_ = MKLKernelEngine::Get().CreateMemory(weights_desc);
+    AddArgument(DNNL_ARG_WEIGHTS, prim_desc.weights_desc(), true);
+  } else {
+    AddArgument(DNNL_ARG_WEIGHTS, weights_desc);
+  }
+  if (has_bias_) {
+    AddArgument(DNNL_ARG_BIAS, bias_desc);
+  }
   AddArgument(DNNL_ARG_DST, dst_desc);
 }
 
@@ -81,7 +136,23 @@ bool Conv2dCPUKernel::Launch(const std::vector<kernel::AddressPtr> &inputs,
     MS_LOG(EXCEPTION) << "error input output size!";
   }
   SetArgumentHandle(DNNL_ARG_SRC, inputs[0]->addr);
-  SetArgumentHandle(DNNL_ARG_WEIGHTS, inputs[1]->addr);
+  if (!reorder_weights_) {
+    SetArgumentHandle(DNNL_ARG_WEIGHTS, inputs[1]->addr);
+  } else if (!static_weights_ || inputs[1]->addr != reordered_weights_addr_ ||
+             inputs[1]->size != reordered_weights_size_) {
+    // Static weights keep their reordered copy until they are bound to another buffer, as load_checkpoint does, or
+    // change in size. Weights the graph updates in place are reordered on every launch.
+    user_weights_.set_data_handle(inputs[1]->addr);
+    Reorder(&user_weights_, &arguments_[DNNL_ARG_WEIGHTS]);
+    reordered_weights_addr_ = inputs[1]->addr;
+    reordered_weights_size_ = inputs[1]->size;
+  }
+  if (has_bias_) {
+    if (inputs.size() < 3) {
+      MS_LOG(EXCEPTION) << "conv2d with bias needs 3 inputs, but got " << inputs.size();
+    }
+    SetArgumentHandle(DNNL_ARG_BIAS, inputs[2]->addr);
+  }
   SetArgumentHandle(DNNL_ARG_DST, outputs[0]->addr);
   ExecutePrimitive();
   return true;
@@ -31,12 +31,30 @@ class Conv2dCPUKernel : public MKLCPUKernel {
 
   bool Launch(const std::vector<AddressPtr> &inputs, const std::vector<AddressPtr> &workspace,
               const std::vector<AddressPtr> &outputs) override;
+
+ private:
+  bool has_bias_{false};
+  // Set when the primitive wants its weights in another layout than the plain OIHW ones of the input.
+  bool reorder_weights_{false};
+  // Set when no other node of the graph uses the weights, so they are not updated in place by it.
+  bool static_weights_{false};
+  dnnl::memory user_weights_;
+  // The buffer and size of the weights last reordered, static weights are reordered again when they change.
+  void *reordered_weights_addr_{nullptr};
+  size_t reordered_weights_size_{0};
 };
 
 MS_REG_CPU_KERNEL(
   Conv2D,
   KernelAttr().AddInputAttr(kNumberTypeFloat32).AddInputAttr(kNumberTypeFloat32).AddOutputAttr(kNumberTypeFloat32),
   Conv2dCPUKernel);
+MS_REG_CPU_KERNEL(Conv2D,
+                  KernelAttr()
+                    .AddInputAttr(kNumberTypeFloat32)
+                    .AddInputAttr(kNumberTypeFloat32)
+                    .AddInputAttr(kNumberTypeFloat32)
+                    .AddOutputAttr(kNumberTypeFloat32),
+                  Conv2dCPUKernel);
 }  // namespace kernel
 }  // namespace mindspore
 
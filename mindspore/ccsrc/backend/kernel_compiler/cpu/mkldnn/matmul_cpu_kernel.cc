@@ -15,10 +15,12 @@
  */
 #include "backend/kernel_compiler/cpu/mkldnn/matmul_cpu_kernel.h"
 #include <algorithm>
+#include <memory>
 #include <utility>
 #include "backend/kernel_compiler/cpu/mkldnn/mkl_kernel_engine.h"
 #include "utils/ms_utils.h"
 #include "runtime/device/cpu/cpu_device_address.h"
+#include "utils/utils.h"
 
 namespace mindspore {
 namespace kernel {
@@ -45,6 +47,48 @@ void MatMulCPUKernel::InitKernel(const CNodePtr &kernel_node) {
     trans_b_ = TRANSPOSE_YES;
   }
   dim_n_ = static_cast<dnnl_dim_t>(dst_shape[1]);
+  bool has_bias = AnfAlgo::GetInputTensorNum(kernel_node) > 2;
+  bool fused_relu =
+    AnfAlgo::HasNodeAttr(kAttrFusedRelu, kernel_node) && AnfAlgo::GetNodeAttr<bool>(kernel_node, kAttrFusedRelu);
+  if (has_bias || fused_relu) {
+    InitPostOpsPrimitive(has_bias, fused_relu);
+  }
+}
+
+// dnnl_sgemm has no epilogue, so the bias and the ReLU folded in by the CPU post-op fusions make the kernel run a
+// oneDNN matmul primitive instead. Transposed inputs are described by their strides rather than copied.
+void MatMulCPUKernel::InitPostOpsPrimitive(bool has_bias, bool fused_relu) {
+  dnnl::memory::dims src_strides =
+    trans_a_ == TRANSPOSE_YES ? dnnl::memory::dims{1, dim_m_} : dnnl::memory::dims{dim_k_, 1};
+  dnnl::memory::dims weights_strides =
+    trans_b_ == TRANSPOSE_YES ? dnnl::memory::dims{1, dim_k_} : dnnl::memory::dims{dim_n_, 1};
+  dnnl::memory::desc src_desc({dim_m_, dim_k_}, dnnl::memory::data_type::f32, src_strides);
+  dnnl::memory::desc weights_desc({dim_k_, dim_n_}, dnnl::memory::data_type::f32, weights_strides);
+  dnnl::memory::desc dst_desc = formatted_md({dim_m_, dim_n_}, dnnl::memory::format_tag::ab);
+  dnnl::primitive_attr attr;
+  if (fused_relu) {
+    dnnl::post_ops ops;
+    ops.append_eltwise(1.0f, dnnl::algorithm::eltwise_relu, 0.0f, 0.0f);
+    attr.set_post_ops(ops);
+  }
+  std::shared_ptr<dnnl::matmul::desc> desc;
+  dnnl::memory::desc bias_desc;
+  if (has_bias) {
+    bias_desc = formatted_md({1, dim_n_}, dnnl::memory::format_tag::ab);
+    desc = std::make_shared<dnnl::matmul::desc>(src_desc, weights_desc, bias_desc, dst_desc);
+  } else {
+    desc = std::make_shared<dnnl::matmul::desc>(src_desc, weights_desc, dst_desc);
+  }
+  auto prim_desc = dnnl::matmul::primitive_desc(*desc, attr, MKLKernelEngine::Get().engine());
+  primitive_ = std::make_shared<dnnl::matmul>(prim_desc);
+  has_bias_ = has_bias;
+
+  AddArgument(DNNL_ARG_SRC, src_desc);
+  AddArgument(DNNL_ARG_WEIGHTS, weights_desc);
+  if (has_bias) {
+    AddArgument(DNNL_ARG_BIAS, bias_desc);
+  }
+  AddArgument(DNNL_ARG_DST, dst_desc);
 }
 
 bool MatMulCPUKernel::Launch(const std::vector<kernel::AddressPtr> &inputs,
@@ -53,6 +97,19 @@ bool MatMulCPUKernel::Launch(const std::vector<kernel::AddressPtr> &inputs,
   if (inputs.size() < 2 || outputs.empty()) {
     MS_LOG(EXCEPTION) << "matmul error input output size!";
   }
+  if (primitive_ != nullptr) {
+    SetArgumentHandle(DNNL_ARG_SRC, inputs[0]->addr);
+    SetArgumentHandle(DNNL_ARG_WEIGHTS, inputs[1]->addr);
+    if (has_bias_) {
+      if (inputs.size() < 3) {
+        MS_LOG(EXCEPTION) << "matmul with bias needs 3 inputs, but got " << inputs.size();
+      }
+      SetArgumentHandle(DNNL_ARG_BIAS, inputs[2]->addr);
+    }
+    SetArgumentHandle(DNNL_ARG_DST, outputs[0]->addr);
+    ExecutePrimitive();
+    return true;
+  }
   dnnl_dim_t lda = dim_m_;
   if (trans_a_ == TRANSPOSE_NO) {
     lda = dim_k_;
@@ -33,17 +33,26 @@ class MatMulCPUKernel : public MKLCPUKernel {
               const std::vector<AddressPtr> &outputs) override;
 
  private:
+  void InitPostOpsPrimitive(bool has_bias, bool fused_relu);
   char trans_a_{TRANSPOSE_NO};
   char trans_b_{TRANSPOSE_NO};
   dnnl_dim_t dim_m_{0};
   dnnl_dim_t dim_n_{0};
   dnnl_dim_t dim_k_{0};
+  bool has_bias_{false};
 };
 
 MS_REG_CPU_KERNEL(
   MatMul,
   KernelAttr().AddInputAttr(kNumberTypeFloat32).AddInputAttr(kNumberTypeFloat32).AddOutputAttr(kNumberTypeFloat32),
   MatMulCPUKernel);
+MS_REG_CPU_KERNEL(MatMul,
+                  KernelAttr()
+                    .AddInputAttr(kNumberTypeFloat32)
+                    .AddInputAttr(kNumberTypeFloat32)
+                    .AddInputAttr(kNumberTypeFloat32)
+                    .AddOutputAttr(kNumberTypeFloat32),
+                  MatMulCPUKernel);
 }  // namespace kernel
 }  // namespace mindspore
 
@@ -18,6 +18,7 @@
 #include <string>
 #include <algorithm>
 #include "utils/ms_utils.h"
+#include "utils/utils.h"
 #include "backend/kernel_compiler/cpu/mkldnn/mkl_kernel_engine.h"
 
 namespace mindspore {
@@ -88,6 +89,17 @@ dnnl::memory::desc MKLCPUKernel::GetDefaultMemDesc(const std::vector<size_t> &sh
   return mem_desc;
 }
 
+dnnl::memory::desc MKLCPUKernel::GetFormatMemDesc(const std::vector<size_t> &shape, const std::string &format) {
+  if (format != kOpFormat_NC1HWC0) {
+    return GetDefaultMemDesc(shape);
+  }
+  if (shape.size() != 4) {
+    MS_LOG(EXCEPTION) << "format " << format << " only support 4d shape, but got " << shape.size();
+  }
+  dnnl::memory::dims dims(shape.begin(), shape.end());
+  return formatted_md(dims, dnnl::memory::format_tag::nChw16c);
+}
+
 void MKLCPUKernel::AddArgument(int arg_key, const dnnl::memory::desc &mem_desc, bool alloc) {
   arguments_[arg_key] = MKLKernelEngine::Get().CreateMemory(mem_desc, alloc);
 }
@@ -39,6 +39,8 @@ class MKLCPUKernel : public CPUKernel {
   void SetArgumentHandle(int arg_key, void *ptr);
   dnnl::memory::format_tag GetDefaultFormatTag(const dnnl::memory::dims &dims) const;
   dnnl::memory::desc GetDefaultMemDesc(const std::vector<size_t> &shape);
+  // The desc of data in the given device format, NC1HWC0 is the oneDNN layout nChw16c of the NCHW shape.
+  dnnl::memory::desc GetFormatMemDesc(const std::vector<size_t> &shape, const std::string &format);
   void ExecutePrimitive();
   std::unordered_map<int, dnnl::memory> arguments_;
   std::shared_ptr<dnnl::primitive> primitive_{nullptr};
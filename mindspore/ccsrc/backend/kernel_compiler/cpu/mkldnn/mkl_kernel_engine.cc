@@ -19,11 +19,17 @@
 
 namespace mindspore {
 namespace kernel {
+dnnl::stream &MKLKernelEngine::stream() {
+  thread_local dnnl::stream stream(engine_);
+  return stream;
+}
+
 void MKLKernelEngine::Execute(const std::shared_ptr<dnnl::primitive> &primitive,
                               const std::unordered_map<int, dnnl::memory> &arguments) {
   MS_EXCEPTION_IF_NULL(primitive);
-  primitive->execute(stream_, arguments);
-  (void)stream_.wait();
+  auto &current_stream = stream();
+  primitive->execute(current_stream, arguments);
+  (void)current_stream.wait();
 }
 
 dnnl::memory MKLKernelEngine::CreateMemory(const dnnl::memory::desc &mem_desc, bool alloc) {
@@ -34,7 +40,9 @@ dnnl::memory MKLKernelEngine::CreateMemory(const dnnl::memory::desc &mem_desc, b
   }
 }
 void MKLKernelEngine::Reorder(dnnl::memory *src_mem, dnnl::memory *dst_mem) {
-  dnnl::reorder(*src_mem, *dst_mem).execute(stream_, *src_mem, *dst_mem);
+  auto &current_stream = stream();
+  dnnl::reorder(*src_mem, *dst_mem).execute(current_stream, *src_mem, *dst_mem);
+  (void)current_stream.wait();
 }
 }  // namespace kernel
 }  // namespace mindspore
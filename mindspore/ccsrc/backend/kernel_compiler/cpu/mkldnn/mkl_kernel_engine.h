@@ -39,15 +39,17 @@ class MKLKernelEngine {
 
   dnnl::memory CreateMemory(const dnnl::memory::desc &mem_desc, bool alloc = false);
 
+  // Execute and Reorder wait for the primitive, so its outputs can be read on the host right after. Each thread
+  // gets its own stream, graphs run by different sessions do not share one.
   void Execute(const std::shared_ptr<dnnl::primitive> &primitive,
                const std::unordered_map<int, dnnl::memory> &arguments);
   void Reorder(dnnl::memory *src_mem, dnnl::memory *dst_mem);
 
  private:
-  MKLKernelEngine() : engine_(dnnl::engine::kind::cpu, 0), stream_(engine_) {}
+  MKLKernelEngine() : engine_(dnnl::engine::kind::cpu, 0) {}
   ~MKLKernelEngine() = default;
+  dnnl::stream &stream();
   dnnl::engine engine_;
-  dnnl::stream stream_;
 };
 }  // namespace kernel
 }  // namespace mindspore
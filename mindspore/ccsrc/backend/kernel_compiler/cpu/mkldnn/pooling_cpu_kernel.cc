@@ -24,10 +24,10 @@ namespace mindspore {
 namespace kernel {
 void PoolingCPUKernel::InitKernel(const CNodePtr &kernel_node) {
   MS_EXCEPTION_IF_NULL(kernel_node);
-  std::vector<size_t> src_shape = AnfAlgo::GetInputDeviceShape(kernel_node, 0);
-  std::vector<size_t> dst_shape = AnfAlgo::GetOutputDeviceShape(kernel_node, 0);
-  dnnl::memory::desc src_desc = GetDefaultMemDesc(src_shape);
-  dnnl::memory::desc dst_desc = GetDefaultMemDesc(dst_shape);
+  std::vector<size_t> src_shape = AnfAlgo::GetPrevNodeOutputInferShape(kernel_node, 0);
+  std::vector<size_t> dst_shape = AnfAlgo::GetOutputInferShape(kernel_node, 0);
+  dnnl::memory::desc src_desc = GetFormatMemDesc(src_shape, AnfAlgo::GetInputFormat(kernel_node, 0));
+  dnnl::memory::desc dst_desc = GetFormatMemDesc(dst_shape, AnfAlgo::GetOutputFormat(kernel_node, 0));
   std::vector<int> origin_kernel_sizes = AnfAlgo::GetNodeAttr<std::vector<int>>(kernel_node, KSIZE);
   std::vector<int> strides = AnfAlgo::GetNodeAttr<std::vector<int>>(kernel_node, STRIDES);
   if (origin_kernel_sizes.size() != 4 || strides.size() != 4) {
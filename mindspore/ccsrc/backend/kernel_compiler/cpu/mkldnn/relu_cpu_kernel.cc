@@ -22,11 +22,11 @@ namespace mindspore {
 namespace kernel {
 void ReluCPUKernel::InitKernel(const CNodePtr &kernel_node) {
   MS_EXCEPTION_IF_NULL(kernel_node);
-  std::vector<size_t> src_shape = AnfAlgo::GetInputDeviceShape(kernel_node, 0);
+  std::vector<size_t> src_shape = AnfAlgo::GetPrevNodeOutputInferShape(kernel_node, 0);
   if (src_shape.size() != 4 && src_shape.size() != 2) {
     MS_LOG(EXCEPTION) << "relu kernel dims invalid " << src_shape.size();
   }
-  dnnl::memory::desc src_desc = GetDefaultMemDesc(src_shape);
+  dnnl::memory::desc src_desc = GetFormatMemDesc(src_shape, AnfAlgo::GetInputFormat(kernel_node, 0));
 
   dnnl::eltwise_forward::desc desc =
     dnnl::eltwise_forward::desc(dnnl::prop_kind::forward_training, dnnl::algorithm::eltwise_relu, src_desc, 0.0);
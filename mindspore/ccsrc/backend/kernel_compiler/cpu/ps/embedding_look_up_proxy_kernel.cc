@@ -14,12 +14,23 @@
  * limitations under the License.
  */
 #include "backend/kernel_compiler/cpu/ps/embedding_look_up_proxy_kernel.h"
+#include <string>
 #include <vector>
 #include "frontend/parallel/ps/worker.h"
 
 namespace mindspore {
 namespace kernel {
 namespace ps {
+namespace {
+constexpr size_t kCacheStatisticsLogInterval = 1000;
+}  // namespace
+
+EmbeddingLookUpProxyKernel::~EmbeddingLookUpProxyKernel() {
+  if (cache_ != nullptr) {
+    LogCacheStatistics();
+  }
+}
+
 void EmbeddingLookUpProxyKernel::InitKernel(const CNodePtr &kernel_node) {
   EmbeddingLookUpCPUKernel::InitKernel(kernel_node);
   auto input_shape = AnfAlgo::GetPrevNodeOutputInferShape(kernel_node, 0);
@@ -46,6 +57,36 @@ void EmbeddingLookUpProxyKernel::InitKernel(const CNodePtr &kernel_node) {
     parallel::ps::Worker<float>::GetInstance().AddEmbeddingTable(key_, input_shape[axis]);
     parallel::ps::Worker<float>::GetInstance().InitPSEmbeddingTable(keys, values, lens);
   }
+  InitCache(kernel_node, input_shape[axis]);
+}
+
+void EmbeddingLookUpProxyKernel::InitCache(const CNodePtr &kernel_node, size_t row_count) {
+  if (!AnfAlgo::HasNodeAttr(kAttrCacheSize, kernel_node)) {
+    return;
+  }
+  parallel::ps::EmbeddingCacheConfig config;
+  int cache_size = AnfAlgo::GetNodeAttr<int>(kernel_node, kAttrCacheSize);
+  if (cache_size <= 0) {
+    return;
+  }
+  config.capacity = IntToSize(cache_size);
+  if (AnfAlgo::HasNodeAttr(kAttrCachePolicy, kernel_node)) {
+    auto policy = AnfAlgo::GetNodeAttr<std::string>(kernel_node, kAttrCachePolicy);
+    if (!parallel::ps::EmbeddingCache::ParsePolicy(policy, &config.policy)) {
+      MS_LOG(EXCEPTION) << "Invalid embedding cache policy " << policy << ", it should be lru or lfu.";
+    }
+  }
+  if (AnfAlgo::HasNodeAttr(kAttrCacheStaleness, kernel_node)) {
+    int staleness = AnfAlgo::GetNodeAttr<int>(kernel_node, kAttrCacheStaleness);
+    if (staleness < 0) {
+      MS_LOG(EXCEPTION) << "The embedding cache staleness should not be negative, but got " << staleness;
+    }
+    config.max_staleness = IntToSize(staleness);
+  }
+  cache_ = std::make_unique<parallel::ps::EmbeddingCache>(row_count, outer_dim_size_, config);
+  MS_LOG(INFO) << "Enable embedding cache for key " << key_ << ", capacity:" << config.capacity
+               << ", policy:" << (config.policy == parallel::ps::kCacheLFU ? "lfu" : "lru")
+               << ", max staleness:" << config.max_staleness;
 }
 
 bool EmbeddingLookUpProxyKernel::Launch(const std::vector<kernel::AddressPtr> &inputs,
@@ -57,6 +98,10 @@ bool EmbeddingLookUpProxyKernel::Launch(const std::vector<kernel::AddressPtr> &i
   size_t output_size = outputs[0]->size;
 
   size_t size = input_size / sizeof(float);
+  if (cache_ != nullptr) {
+    LookupThroughCache(indices_addr, size, output_addr);
+    return true;
+  }
   ::ps::SArray<int> lookup_ids(size, 0);
   ::ps::SArray<int> lengths{size};
   ::ps::SArray<float> lookup_result(output_size / sizeof(float), 0);
@@ -74,6 +119,45 @@ bool EmbeddingLookUpProxyKernel::Launch(const std::vector<kernel::AddressPtr> &i
   }
   return true;
 }
+
+// Serve the cached rows locally and pull only the missed ids, their rows are then offered to the cache.
+void EmbeddingLookUpProxyKernel::LookupThroughCache(const int *indices_addr, size_t indices_num, float *output_addr) {
+  std::vector<size_t> missed;
+  cache_->Lookup(indices_addr, indices_num, output_addr, &missed);
+  if (!missed.empty()) {
+    ::ps::SArray<int> lookup_ids(missed.size(), 0);
+    for (size_t i = 0; i < missed.size(); i++) {
+      lookup_ids[i] = indices_addr[missed[i]];
+    }
+    ::ps::SArray<int> lengths{missed.size()};
+    ::ps::SArray<float> lookup_result(missed.size() * outer_dim_size_, 0);
+    parallel::ps::Worker<float>::GetInstance().DoPSEmbeddingLookup({key_}, lookup_ids, lengths, &lookup_result,
+                                                                   parallel::ps::kEmbeddingLookupCmd);
+    size_t row_bytes = outer_dim_size_ * sizeof(float);
+    for (size_t i = 0; i < missed.size(); i++) {
+      auto ret = memcpy_s(output_addr + missed[i] * outer_dim_size_, row_bytes,
+                          lookup_result.data() + i * outer_dim_size_, row_bytes);
+      if (ret != EOK) {
+        MS_LOG(EXCEPTION) << "Lookup result memcpy failed.";
+      }
+    }
+    cache_->Update(lookup_ids.data(), lookup_ids.size(), lookup_result.data());
+  }
+  cache_->StepEnd();
+
+  if (++steps_ % kCacheStatisticsLogInterval == 0) {
+    LogCacheStatistics();
+  }
+}
+
+void EmbeddingLookUpProxyKernel::LogCacheStatistics() const {
+  const auto &statistics = cache_->statistics();
+  MS_LOG(INFO) << "Embedding cache of key " << key_ << " hit rate:" << statistics.hit_rate()
+               << ", hits:" << statistics.hits << ", misses:" << statistics.misses
+               << ", stale misses:" << statistics.stale_misses << ", evictions:" << statistics.evictions
+               << ", rejections:" << statistics.rejections
+               << ", max served staleness:" << statistics.max_served_staleness << ", cached rows:" << cache_->size();
+}
 }  // namespace ps
 }  // namespace kernel
 }  // namespace mindspore
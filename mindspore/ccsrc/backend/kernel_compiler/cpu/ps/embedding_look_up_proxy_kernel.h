@@ -17,8 +17,10 @@
 #define MINDSPORE_CCSRC_BACKEND_KERNEL_COMPILER_CPU_EMBEDDING_LOOK_UP_PROXY_KERNEL_H_
 
 #include "backend/kernel_compiler/cpu/embedding_look_up_cpu_kernel.h"
+#include <memory>
 #include <vector>
 #include "backend/kernel_compiler/cpu/cpu_kernel_factory.h"
+#include "frontend/parallel/ps/embedding_cache.h"
 
 namespace mindspore {
 namespace kernel {
@@ -26,7 +28,7 @@ namespace ps {
 class EmbeddingLookUpProxyKernel : public EmbeddingLookUpCPUKernel {
  public:
   EmbeddingLookUpProxyKernel() = default;
-  ~EmbeddingLookUpProxyKernel() override = default;
+  ~EmbeddingLookUpProxyKernel() override;
 
   void InitKernel(const CNodePtr &kernel_node) override;
 
@@ -34,8 +36,14 @@ class EmbeddingLookUpProxyKernel : public EmbeddingLookUpCPUKernel {
               const std::vector<AddressPtr> &outputs) override;
 
  private:
+  void InitCache(const CNodePtr &kernel_node, size_t row_count);
+  void LookupThroughCache(const int *indices_addr, size_t indices_num, float *output_addr);
+  void LogCacheStatistics() const;
+
   size_t key_{0};
   size_t input_dims_{1};
+  std::unique_ptr<parallel::ps::EmbeddingCache> cache_;
+  size_t steps_{0};
 };
 
 MS_REG_CPU_KERNEL(
@@ -13,6 +13,7 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include <algorithm>
 #include <map>
 #include <string>
 #include <vector>
@@ -24,7 +25,6 @@ namespace kernel {
 const size_t kReduceTypeMax = 0;
 const size_t kReduceTypeMean = 1;
 const size_t kReduceTypeSum = 2;
-const size_t kMaxDim = 100;
 void ReduceCPUKernel::InitKernel(const CNodePtr &kernel_node) {
   MS_EXCEPTION_IF_NULL(kernel_node);
   std::string kernel_name = AnfAlgo::GetCNodeName(kernel_node);
@@ -75,6 +75,14 @@ void ReduceCPUKernel::InitKernel(const CNodePtr &kernel_node) {
     MS_LOG(EXCEPTION) << "stride_ must greater than zero.";
   }
   left_dims_ = left_dims_ / stride_;
+  std::vector<size_t> transpose_axis;
+  for (size_t i = 0; i < shape_.size(); ++i) {
+    if (std::find(axis_.begin(), axis_.end(), i) == axis_.end()) {
+      transpose_axis.push_back(i);
+    }
+  }
+  (void)transpose_axis.insert(transpose_axis.end(), axis_.begin(), axis_.end());
+  transposer_ = Transposer(shape_, transpose_axis);
 }
 bool ReduceCPUKernel::Launch(const std::vector<kernel::AddressPtr> &inputs,
                              const std::vector<kernel::AddressPtr> & /*workspaces*/,
@@ -86,24 +94,13 @@ bool ReduceCPUKernel::Launch(const std::vector<kernel::AddressPtr> &inputs,
   }
   auto input = reinterpret_cast<float *>(inputs[0]->addr);
   auto output = reinterpret_cast<float *>(outputs[0]->addr);
-  int size = inputs[0]->size / sizeof(float);
-  std::vector<float> new_input(IntToSize(size), 0.0);
-  std::vector<size_t> transpose_axis;
-  for (size_t i = 0; i < shape_.size(); ++i) {
-    bool insert = true;
-    for (size_t j = 0; j < axis_.size(); ++j) {
-      if (axis_[j] == i) {
-        insert = false;
-        break;
-      }
-    }
-    if (insert) {
-      transpose_axis.push_back(i);
-    }
+  if (transposer_.kind() == Transposer::kCopy) {
+    ConvertDataToOutput(input, output);
+    return true;
   }
-  (void)transpose_axis.insert(transpose_axis.end(), axis_.begin(), axis_.end());
-  Transpose(size, input, shape_, transpose_axis, SizeToInt(shape_.size()), &new_input[0]);
-  ConvertDataToOutput(&new_input[0], output);
+  std::vector<float> new_input(transposer_.element_num());
+  transposer_.Run(input, new_input.data());
+  ConvertDataToOutput(new_input.data(), output);
   return true;
 }
 
@@ -132,30 +129,5 @@ void ReduceCPUKernel::ConvertDataToOutput(const float *new_input, float *output)
     }
   }
 }
-void ReduceCPUKernel::Transpose(const int size, const float *input, const std::vector<size_t> &input_shape,
-                                const std::vector<size_t> &input_axis, const int shape_size, float *output) {
-  int pos_array[kMaxDim];
-  int size_offset[kMaxDim];
-  size_offset[0] = size / SizeToInt(input_shape[0]);
-  for (int i = 1; i < shape_size; i++) {
-    size_offset[i] = size_offset[i - 1] / SizeToInt(input_shape[i]);
-  }
-  for (int position = 0; position < size; position += 1) {
-    int temp_position = position;
-    pos_array[0] = temp_position / size_offset[0];
-    for (int i = 1; i < shape_size; i++) {
-      temp_position -= pos_array[i - 1] * size_offset[i - 1];
-      pos_array[i] = temp_position / size_offset[i];
-    }
-    int new_position = pos_array[SizeToInt(input_axis[shape_size - 1])];
-    int new_position_size = 1;
-    for (int j = shape_size - 2; j >= 0; j--) {
-      new_position_size *= SizeToInt(input_shape[SizeToInt(input_axis[j + 1])]);
-      new_position += pos_array[SizeToInt(input_axis[j])] * new_position_size;
-    }
-    output[new_position] = input[position];
-  }
-  return;
-}
 }  // namespace kernel
 }  // namespace mindspore
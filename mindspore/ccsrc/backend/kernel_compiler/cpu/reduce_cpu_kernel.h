@@ -20,6 +20,7 @@
 #include <string>
 #include "backend/kernel_compiler/cpu/cpu_kernel.h"
 #include "backend/kernel_compiler/cpu/cpu_kernel_factory.h"
+#include "backend/kernel_compiler/cpu/transpose_utils.h"
 
 namespace mindspore {
 namespace kernel {
@@ -32,14 +33,14 @@ class ReduceCPUKernel : public CPUKernel {
               const std::vector<AddressPtr> &outputs) override;
 
  private:
-  void Transpose(const int size, const float *input, const std::vector<size_t> &input_shape,
-                 const std::vector<size_t> &input_axis, const int shape_size, float *output);
   void ConvertDataToOutput(const float *input, float *output);
   size_t reduce_type_ = 0;
   std::vector<size_t> axis_;
   std::vector<size_t> shape_;
   size_t left_dims_ = 1;
   size_t stride_ = 1;
+  // Moves the reduced axes innermost, it is a plain copy when they already are.
+  Transposer transposer_;
 };
 MS_REG_CPU_KERNEL(ReduceMean, KernelAttr().AddInputAttr(kNumberTypeFloat32).AddOutputAttr(kNumberTypeFloat32),
                   ReduceCPUKernel);
@@ -157,7 +157,7 @@ bool SparseApplyAdamCPUKernel::Launch(const std::vector<kernel::AddressPtr> &inp
   param.output_grad_ = &unique_sparse_grad;
   param.max_index_ = var_first_dim_size_;
   param.value_stride_ = var_outer_dim_size_;
-  BucketReduceSparseGradient(param);
+  reducer_.Reduce(param);
 
   size_t total_dim_size = var_first_dim_size_ * var_outer_dim_size_;
   lr = lr * std::sqrt(1 - beta2_power) / (1 - beta1_power);
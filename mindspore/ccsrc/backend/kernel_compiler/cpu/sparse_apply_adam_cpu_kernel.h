@@ -18,6 +18,7 @@
 
 #include <vector>
 #include <memory>
+#include "backend/kernel_compiler/common_utils.h"
 #include "backend/kernel_compiler/cpu/cpu_kernel.h"
 #include "backend/kernel_compiler/cpu/cpu_kernel_factory.h"
 
@@ -37,6 +38,7 @@ class SparseApplyAdamCPUKernel : public CPUKernel {
   size_t indices_size_{0};
   size_t var_first_dim_size_{0};
   size_t var_outer_dim_size_{1};
+  SparseGradientReducer reducer_;
   bool use_nesterov_{false};
 };
 
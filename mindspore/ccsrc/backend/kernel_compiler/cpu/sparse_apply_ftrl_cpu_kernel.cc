@@ -144,7 +144,7 @@ bool SparseApplyFtrlCPUKernel::Launch(const std::vector<kernel::AddressPtr> &inp
   param.output_grad_ = &unique_sparse_grad;
   param.max_index_ = var_first_dim_size_;
   param.value_stride_ = var_outer_dim_size_;
-  BucketReduceSparseGradient(param);
+  reducer_.Reduce(param);
 
   MultiThreadComputeParams input_params;
   input_params.var_ = var;
@@ -135,7 +135,7 @@ bool SparseApplyLazyAdamCPUKernel::Launch(const std::vector<kernel::AddressPtr>
   param.output_grad_ = &unique_sparse_grad;
   param.max_index_ = var_first_dim_size_;
   param.value_stride_ = var_outer_dim_size_;
-  BucketReduceSparseGradient(param);
+  reducer_.Reduce(param);
 
   lr = lr * std::sqrt(1 - beta2_power) / (1 - beta1_power);
   MultiThreadComputeParams input_params;
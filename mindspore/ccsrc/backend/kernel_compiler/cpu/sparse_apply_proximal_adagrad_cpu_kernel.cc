@@ -133,7 +133,7 @@ bool SparseApplyProximalAdagradCPUKernel::Launch(const std::vector<kernel::Addre
   param.output_grad_ = &unique_sparse_grad;
   param.max_index_ = var_first_dim_size_;
   param.value_stride_ = var_outer_dim_size_;
-  BucketReduceSparseGradient(param);
+  reducer_.Reduce(param);
 
   MultiThreadComputeParams input_params;
   input_params.var_ = var;
@@ -18,46 +18,31 @@
 #include "runtime/device/cpu/cpu_device_address.h"
 namespace mindspore {
 namespace kernel {
-const size_t kMaxDim = 100;
 void TransposeCPUFwdKernel::InitKernel(const CNodePtr &kernel_node) {
   MS_EXCEPTION_IF_NULL(kernel_node);
-  shape_ = AnfAlgo::GetInputDeviceShape(kernel_node, 0);
-  axis_ = AnfAlgo::GetNodeAttr<std::vector<int>>(kernel_node, "perm");
-  if (shape_.size() != axis_.size()) {
+  auto shape = AnfAlgo::GetInputDeviceShape(kernel_node, 0);
+  auto axis = AnfAlgo::GetNodeAttr<std::vector<int>>(kernel_node, "perm");
+  if (shape.size() != axis.size()) {
     MS_LOG(EXCEPTION) << "The size of input shape and transpose axis shape must be equal.";
   }
+  std::vector<size_t> perm;
+  for (auto dim : axis) {
+    perm.push_back(dim < 0 ? IntToSize(dim + SizeToInt(shape.size())) : IntToSize(dim));
+  }
+  transposer_ = Transposer(shape, perm);
 }
 bool TransposeCPUFwdKernel::Launch(const std::vector<kernel::AddressPtr> &inputs,
                                    const std::vector<kernel::AddressPtr> & /*workspace*/,
                                    const std::vector<kernel::AddressPtr> &outputs) {
-  auto input = reinterpret_cast<float *>(inputs[0]->addr);
-  auto output = reinterpret_cast<float *>(outputs[0]->addr);
-  size_t size = IntToSize(inputs[0]->size / sizeof(float));
-  size_t shape_size = IntToSize(shape_.size());
-  if (shape_size > kMaxDim) {
-    MS_LOG(EXCEPTION) << "Input is " << shape_size << "-D, but transpose supports max " << kMaxDim << "-D inputs.";
-  }
-  size_t pos_array[kMaxDim];
-  size_t size_offset[kMaxDim];
-  size_offset[0] = size / shape_[0];
-  for (size_t i = 1; i < shape_size; i++) {
-    size_offset[i] = size_offset[SizeToInt(i) - 1] / shape_[i];
+  if (inputs.empty() || outputs.empty()) {
+    MS_LOG(EXCEPTION) << "Transpose error input output size!";
   }
-  for (size_t position = 0; position < size; position += 1) {
-    size_t temp_position = position;
-    pos_array[0] = temp_position / size_offset[0];
-    for (size_t i = 1; i < shape_size; i++) {
-      temp_position -= pos_array[SizeToInt(i) - 1] * size_offset[i - 1];
-      pos_array[i] = temp_position / size_offset[i];
-    }
-    size_t new_position = pos_array[axis_[SizeToInt(shape_size) - 1]];
-    size_t new_position_size = 1;
-    for (int j = shape_size - 2; j >= 0; j--) {
-      new_position_size *= shape_[axis_[j + 1]];
-      new_position += pos_array[axis_[j]] * new_position_size;
-    }
-    output[new_position] = input[position];
+  size_t data_size = transposer_.element_num() * sizeof(float);
+  if (inputs[0]->size < data_size || outputs[0]->size < data_size) {
+    MS_LOG(EXCEPTION) << "Transpose expects " << data_size << " bytes, but the input has " << inputs[0]->size
+                      << " and the output " << outputs[0]->size;
   }
+  transposer_.Run(reinterpret_cast<float *>(inputs[0]->addr), reinterpret_cast<float *>(outputs[0]->addr));
   return true;
 }
 }  // namespace kernel
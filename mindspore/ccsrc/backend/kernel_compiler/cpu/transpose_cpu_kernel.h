@@ -20,6 +20,7 @@
 #include <string>
 #include "backend/kernel_compiler/cpu/cpu_kernel.h"
 #include "backend/kernel_compiler/cpu/cpu_kernel_factory.h"
+#include "backend/kernel_compiler/cpu/transpose_utils.h"
 namespace mindspore {
 namespace kernel {
 class TransposeCPUFwdKernel : public CPUKernel {
@@ -33,8 +34,7 @@ class TransposeCPUFwdKernel : public CPUKernel {
               const std::vector<AddressPtr> &outputs) override;
 
  private:
-  std::vector<size_t> shape_;
-  std::vector<int> axis_;
+  Transposer transposer_;
 };
 
 MS_REG_CPU_KERNEL(Transpose, KernelAttr().AddInputAttr(kNumberTypeFloat32).AddOutputAttr(kNumberTypeFloat32),
@@ -0,0 +1,295 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "backend/kernel_compiler/cpu/transpose_utils.h"
+#include <algorithm>
+#if defined(__AVX__) || defined(__SSE2__)
+#include <immintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+#include "backend/kernel_compiler/cpu/cpu_kernel.h"
+#include "securec/include/securec.h"
+#include "utils/log_adapter.h"
+
+namespace mindspore {
+namespace kernel {
+namespace {
+constexpr size_t kMinParallelSize = 64 * 1024;
+// The side of the square block of the plane which one step of kTile transposes, 32x32 floats of the input and of the
+// output fit in L1 together.
+constexpr size_t kBlockSize = 32;
+#if defined(__AVX__)
+constexpr size_t kTileSize = 8;
+#elif defined(__SSE2__) || defined(__ARM_NEON)
+constexpr size_t kTileSize = 4;
+#else
+constexpr size_t kTileSize = 1;
+#endif
+
+// dst[c * dst_stride + r] = src[r * src_stride + c] for a kTileSize x kTileSize tile.
+inline void TransposeTile(const float *src, size_t src_stride, float *dst, size_t dst_stride) {
+#if defined(__AVX__)
+  __m256 r0 = _mm256_loadu_ps(src);
+  __m256 r1 = _mm256_loadu_ps(src + src_stride);
+  __m256 r2 = _mm256_loadu_ps(src + 2 * src_stride);
+  __m256 r3 = _mm256_loadu_ps(src + 3 * src_stride);
+  __m256 r4 = _mm256_loadu_ps(src + 4 * src_stride);
+  __m256 r5 = _mm256_loadu_ps(src + 5 * src_stride);
+  __m256 r6 = _mm256_loadu_ps(src + 6 * src_stride);
+  __m256 r7 = _mm256_loadu_ps(src + 7 * src_stride);
+  __m256 t0 = _mm256_unpacklo_ps(r0, r1);
+  __m256 t1 = _mm256_unpackhi_ps(r0, r1);
+  __m256 t2 = _mm256_unpacklo_ps(r2, r3);
+  __m256 t3 = _mm256_unpackhi_ps(r2, r3);
+  __m256 t4 = _mm256_unpacklo_ps(r4, r5);
+  __m256 t5 = _mm256_unpackhi_ps(r4, r5);
+  __m256 t6 = _mm256_unpacklo_ps(r6, r7);
+  __m256 t7 = _mm256_unpackhi_ps(r6, r7);
+  r0 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(1, 0, 1, 0));
+  r1 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(3, 2, 3, 2));
+  r2 = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(1, 0, 1, 0));
+  r3 = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(3, 2, 3, 2));
+  r4 = _mm256_shuffle_ps(t4, t6, _MM_SHUFFLE(1, 0, 1, 0));
+  r5 = _mm256_shuffle_ps(t4, t6, _MM_SHUFFLE(3, 2, 3, 2));
+  r6 = _mm256_shuffle_ps(t5, t7, _MM_SHUFFLE(1, 0, 1, 0));
+  r7 = _mm256_shuffle_ps(t5, t7, _MM_SHUFFLE(3, 2, 3, 2));
+  _mm256_storeu_ps(dst, _mm256_permute2f128_ps(r0, r4, 0x20));
+  _mm256_storeu_ps(dst + dst_stride, _mm256_permute2f128_ps(r1, r5, 0x20));
+  _mm256_storeu_ps(dst + 2 * dst_stride, _mm256_permute2f128_ps(r2, r6, 0x20));
+  _mm256_storeu_ps(dst + 3 * dst_stride, _mm256_permute2f128_ps(r3, r7, 0x20));
+  _mm256_storeu_ps(dst + 4 * dst_stride, _mm256_permute2f128_ps(r0, r4, 0x31));
+  _mm256_storeu_ps(dst + 5 * dst_stride, _mm256_permute2f128_ps(r1, r5, 0x31));
+  _mm256_storeu_ps(dst + 6 * dst_stride, _mm256_permute2f128_ps(r2, r6, 0x31));
+  _mm256_storeu_ps(dst + 7 * dst_stride, _mm256_permute2f128_ps(r3, r7, 0x31));
+#elif defined(__SSE2__)
+  __m128 r0 = _mm_loadu_ps(src);
+  __m128 r1 = _mm_loadu_ps(src + src_stride);
+  __m128 r2 = _mm_loadu_ps(src + 2 * src_stride);
+  __m128 r3 = _mm_loadu_ps(src + 3 * src_stride);
+  _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+  _mm_storeu_ps(dst, r0);
+  _mm_storeu_ps(dst + dst_stride, r1);
+  _mm_storeu_ps(dst + 2 * dst_stride, r2);
+  _mm_storeu_ps(dst + 3 * dst_stride, r3);
+#elif defined(__ARM_NEON)
+  float32x4x2_t t01 = vtrnq_f32(vld1q_f32(src), vld1q_f32(src + src_stride));
+  float32x4x2_t t23 = vtrnq_f32(vld1q_f32(src + 2 * src_stride), vld1q_f32(src + 3 * src_stride));
+  vst1q_f32(dst, vcombine_f32(vget_low_f32(t01.val[0]), vget_low_f32(t23.val[0])));
+  vst1q_f32(dst + dst_stride, vcombine_f32(vget_low_f32(t01.val[1]), vget_low_f32(t23.val[1])));
+  vst1q_f32(dst + 2 * dst_stride, vcombine_f32(vget_high_f32(t01.val[0]), vget_high_f32(t23.val[0])));
+  vst1q_f32(dst + 3 * dst_stride, vcombine_f32(vget_high_f32(t01.val[1]), vget_high_f32(t23.val[1])));
+#else
+  dst[0] = src[0];
+#endif
+}
+
+// Transposes a rows x cols block, full tiles go through TransposeTile and the edges element by element.
+void TransposeBlock(const float *src, size_t src_stride, float *dst, size_t dst_stride, size_t rows, size_t cols) {
+  size_t tile_rows = rows - rows % kTileSize;
+  size_t tile_cols = cols - cols % kTileSize;
+  for (size_t r = 0; r < tile_rows; r += kTileSize) {
+    for (size_t c = 0; c < tile_cols; c += kTileSize) {
+      TransposeTile(src + r * src_stride + c, src_stride, dst + c * dst_stride + r, dst_stride);
+    }
+  }
+  for (size_t r = 0; r < rows; ++r) {
+    size_t c_start = r < tile_rows ? tile_cols : 0;
+    for (size_t c = c_start; c < cols; ++c) {
+      dst[c * dst_stride + r] = src[r * src_stride + c];
+    }
+  }
+}
+}  // namespace
+
+Transposer::Transposer(const std::vector<size_t> &shape, const std::vector<size_t> &perm) {
+  if (shape.size() != perm.size()) {
+    MS_LOG(EXCEPTION) << "The size of input shape and transpose axis shape must be equal.";
+  }
+  size_t dim_num = shape.size();
+  std::vector<bool> used(dim_num, false);
+  for (auto axis : perm) {
+    if (axis >= dim_num || used[axis]) {
+      MS_LOG(EXCEPTION) << "The transpose axis is not a permutation of the " << dim_num << " input dims.";
+    }
+    used[axis] = true;
+  }
+  element_num_ = 1;
+  for (auto dim : shape) {
+    element_num_ *= dim;
+  }
+
+  // Dims of size 1 are dropped and the others renumbered, then input dims which follow each other in the output are
+  // merged into groups.
+  std::vector<size_t> kept_dims;
+  std::vector<size_t> kept_index(dim_num, 0);
+  for (size_t i = 0; i < dim_num; ++i) {
+    if (shape[i] != 1) {
+      kept_index[i] = kept_dims.size();
+      kept_dims.push_back(i);
+    }
+  }
+  std::vector<size_t> out_dims;
+  for (auto axis : perm) {
+    if (shape[axis] != 1) {
+      out_dims.push_back(kept_index[axis]);
+    }
+  }
+  std::vector<std::vector<size_t>> groups;
+  for (size_t i = 0; i < out_dims.size(); ++i) {
+    if (i > 0 && out_dims[i] == out_dims[i - 1] + 1) {
+      groups.back().push_back(out_dims[i]);
+    } else {
+      groups.push_back({out_dims[i]});
+    }
+  }
+  std::vector<size_t> input_order(groups.size());
+  for (size_t i = 0; i < groups.size(); ++i) {
+    input_order[i] = i;
+  }
+  std::sort(input_order.begin(), input_order.end(),
+            [&groups](size_t a, size_t b) { return groups[a].front() < groups[b].front(); });
+  size_t reduced_num = groups.size();
+  std::vector<size_t> reduced_shape(reduced_num);
+  std::vector<size_t> reduced_perm(reduced_num);
+  for (size_t i = 0; i < reduced_num; ++i) {
+    size_t size = 1;
+    for (auto dim : groups[input_order[i]]) {
+      size *= shape[kept_dims[dim]];
+    }
+    reduced_shape[i] = size;
+    reduced_perm[input_order[i]] = i;
+  }
+  if (reduced_num <= 1) {
+    kind_ = kCopy;
+    return;
+  }
+
+  std::vector<size_t> input_strides(reduced_num, 1);
+  std::vector<size_t> output_strides(reduced_num, 1);
+  for (size_t i = reduced_num - 1; i > 0; --i) {
+    input_strides[i - 1] = input_strides[i] * reduced_shape[i];
+  }
+  size_t output_stride = 1;
+  for (size_t i = reduced_num; i > 0; --i) {
+    output_strides[reduced_perm[i - 1]] = output_stride;
+    output_stride *= reduced_shape[reduced_perm[i - 1]];
+  }
+
+  size_t inner_input_dim = reduced_num - 1;
+  size_t inner_output_dim = reduced_perm[reduced_num - 1];
+  if (inner_output_dim == inner_input_dim) {
+    kind_ = kRows;
+    rows_ = reduced_shape[inner_input_dim];
+  } else {
+    kind_ = kTile;
+    rows_ = reduced_shape[inner_output_dim];
+    cols_ = reduced_shape[inner_input_dim];
+    row_input_stride_ = input_strides[inner_output_dim];
+    col_output_stride_ = output_strides[inner_input_dim];
+  }
+  for (auto dim : reduced_perm) {
+    if (dim == inner_input_dim || dim == inner_output_dim) {
+      continue;
+    }
+    outer_shape_.push_back(reduced_shape[dim]);
+    outer_input_strides_.push_back(input_strides[dim]);
+    outer_output_strides_.push_back(output_strides[dim]);
+    outer_num_ *= reduced_shape[dim];
+  }
+}
+
+void Transposer::OuterOffsets(size_t index, size_t *input_offset, size_t *output_offset) const {
+  *input_offset = 0;
+  *output_offset = 0;
+  for (size_t i = outer_shape_.size(); i > 0; --i) {
+    size_t pos = index % outer_shape_[i - 1];
+    index /= outer_shape_[i - 1];
+    *input_offset += pos * outer_input_strides_[i - 1];
+    *output_offset += pos * outer_output_strides_[i - 1];
+  }
+}
+
+void Transposer::RunCopy(const float *input, float *output) const {
+  CPUKernelUtils::ParallelFor(
+    [input, output](size_t start, size_t end) {
+      auto ret = memcpy_s(output + start, (end - start) * sizeof(float), input + start, (end - start) * sizeof(float));
+      if (ret != EOK) {
+        MS_LOG(EXCEPTION) << "Transpose memcpy failed, ret " << ret;
+      }
+    },
+    element_num_, kMinParallelSize);
+}
+
+void Transposer::RunRows(const float *input, float *output) const {
+  CPUKernelUtils::ParallelFor(
+    [this, input, output](size_t start, size_t end) {
+      for (size_t i = start; i < end; ++i) {
+        size_t input_offset = 0;
+        size_t output_offset = 0;
+        OuterOffsets(i, &input_offset, &output_offset);
+        auto ret = memcpy_s(output + output_offset, rows_ * sizeof(float), input + input_offset, rows_ * sizeof(float));
+        if (ret != EOK) {
+          MS_LOG(EXCEPTION) << "Transpose memcpy failed, ret " << ret;
+        }
+      }
+    },
+    outer_num_, std::max(kMinParallelSize / rows_, static_cast<size_t>(1)));
+}
+
+void Transposer::RunTile(const float *input, float *output) const {
+  // A unit of work is a band of kBlockSize rows of one plane, so a single large plane still spreads over the threads.
+  size_t row_blocks = (rows_ + kBlockSize - 1) / kBlockSize;
+  size_t band_size = std::min(rows_, kBlockSize) * cols_;
+  CPUKernelUtils::ParallelFor(
+    [this, input, output, row_blocks](size_t start, size_t end) {
+      for (size_t unit = start; unit < end; ++unit) {
+        size_t input_offset = 0;
+        size_t output_offset = 0;
+        OuterOffsets(unit / row_blocks, &input_offset, &output_offset);
+        size_t row = (unit % row_blocks) * kBlockSize;
+        size_t rows = std::min(kBlockSize, rows_ - row);
+        for (size_t col = 0; col < cols_; col += kBlockSize) {
+          size_t cols = std::min(kBlockSize, cols_ - col);
+          TransposeBlock(input + input_offset + row * row_input_stride_ + col, row_input_stride_,
+                         output + output_offset + col * col_output_stride_ + row, col_output_stride_, rows, cols);
+        }
+      }
+    },
+    outer_num_ * row_blocks, std::max(kMinParallelSize / band_size, static_cast<size_t>(1)));
+}
+
+void Transposer::Run(const float *input, float *output) const {
+  MS_EXCEPTION_IF_NULL(input);
+  MS_EXCEPTION_IF_NULL(output);
+  if (element_num_ == 0) {
+    return;
+  }
+  switch (kind_) {
+    case kCopy:
+      RunCopy(input, output);
+      break;
+    case kRows:
+      RunRows(input, output);
+      break;
+    case kTile:
+      RunTile(input, output);
+      break;
+    default:
+      MS_LOG(EXCEPTION) << "Unknown transpose kind " << kind_;
+  }
+}
+}  // namespace kernel
+}  // namespace mindspore
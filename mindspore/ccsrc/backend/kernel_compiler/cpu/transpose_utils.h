@@ -0,0 +1,66 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_BACKEND_KERNEL_COMPILER_CPU_TRANSPOSE_UTILS_H_
+#define MINDSPORE_CCSRC_BACKEND_KERNEL_COMPILER_CPU_TRANSPOSE_UTILS_H_
+#include <cstddef>
+#include <vector>
+
+namespace mindspore {
+namespace kernel {
+// Transposes float tensors of one shape and permutation, output dim i is input dim perm[i]. The permutation is
+// simplified once when the transposer is made: dims of size 1 are dropped and input dims which stay neighbours in the
+// output are merged, so NCHW<->NHWC becomes a 3D swap and a batched matrix transpose a 3D one. What is left runs as
+// one of three kinds, all split over the outer dims on the shared thread pool:
+//   kCopy     the permutation is the identity, the data is copied as is;
+//   kRows     the innermost dim stays innermost, whole rows are copied;
+//   kTile     the innermost dims of input and output differ, the plane they span is transposed in cache blocks of
+//             SIMD tiles, 8x8 with AVX and 4x4 with SSE or NEON.
+class Transposer {
+ public:
+  enum Kind { kCopy, kRows, kTile };
+
+  Transposer() = default;
+  Transposer(const std::vector<size_t> &shape, const std::vector<size_t> &perm);
+  ~Transposer() = default;
+
+  void Run(const float *input, float *output) const;
+  Kind kind() const { return kind_; }
+  size_t element_num() const { return element_num_; }
+
+ private:
+  void RunCopy(const float *input, float *output) const;
+  void RunRows(const float *input, float *output) const;
+  void RunTile(const float *input, float *output) const;
+  // The input and output offsets of the outer position index, the outer dims are decoded innermost first.
+  void OuterOffsets(size_t index, size_t *input_offset, size_t *output_offset) const;
+
+  Kind kind_{kCopy};
+  size_t element_num_{0};
+  // The dims which are walked by the outer loop, with their sizes and strides in input and output.
+  std::vector<size_t> outer_shape_;
+  std::vector<size_t> outer_input_strides_;
+  std::vector<size_t> outer_output_strides_;
+  size_t outer_num_{1};
+  // kRows: the row length. kTile: the plane is rows_ x cols_ in the input, rows_ is the innermost output dim and
+  // cols_ the innermost input dim.
+  size_t rows_{0};
+  size_t cols_{0};
+  size_t row_input_stride_{0};
+  size_t col_output_stride_{0};
+};
+}  // namespace kernel
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_BACKEND_KERNEL_COMPILER_CPU_TRANSPOSE_UTILS_H_
@@ -0,0 +1,172 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "backend/optimizer/cpu/elemwise_chain_fusion.h"
+#include <functional>
+#include <memory>
+#include <numeric>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+#include "backend/optimizer/common/helper.h"
+#include "backend/session/anf_runtime_algorithm.h"
+#include "utils/utils.h"
+
+namespace mindspore {
+namespace opt {
+namespace {
+// The kernel keeps one block of every intermediate result on the stack, so the chain length is bounded.
+constexpr size_t kMaxChainLength = 16;
+const std::unordered_set<std::string> kFusibleElemwiseOps = {
+  prim::kPrimTensorAdd->name(), prim::kPrimSub->name(),  prim::kPrimMul->name(),    prim::kPrimRealDiv->name(),
+  prim::kPrimRelu->name(),      prim::kPrimNeg->name(),  prim::kPrimSquare->name(), prim::kPrimSqrt->name()};
+
+size_t ElementNum(const std::vector<size_t> &shape) {
+  return std::accumulate(shape.begin(), shape.end(), static_cast<size_t>(1), std::multiplies<size_t>());
+}
+
+// Every input must either have the shape of the output or be a single element, which the kernel broadcasts.
+bool IsFusibleElemwise(const AnfNodePtr &node) {
+  if (node == nullptr || !node->isa<CNode>() || !AnfAlgo::IsRealCNodeKernel(node)) {
+    return false;
+  }
+  if (kFusibleElemwiseOps.count(AnfAlgo::GetCNodeName(node)) == 0 || AnfAlgo::GetOutputTensorNum(node) != 1 ||
+      AnfAlgo::GetOutputInferDataType(node, 0) != kNumberTypeFloat32) {
+    return false;
+  }
+  auto output_shape = AnfAlgo::GetOutputInferShape(node, 0);
+  for (size_t i = 0; i < AnfAlgo::GetInputTensorNum(node); ++i) {
+    if (AnfAlgo::GetPrevNodeOutputInferDataType(node, i) != kNumberTypeFloat32) {
+      return false;
+    }
+    auto input_shape = AnfAlgo::GetPrevNodeOutputInferShape(node, i);
+    if (input_shape != output_shape && ElementNum(input_shape) != 1) {
+      return false;
+    }
+  }
+  return true;
+}
+}  // namespace
+
+AnfNodePtr ElemwiseChainFusion::CreateFusedNode(const FuncGraphPtr &graph, const std::vector<CNodePtr> &chain) const {
+  MS_EXCEPTION_IF_NULL(graph);
+  std::unordered_map<AnfNodePtr, size_t> op_index;
+  for (size_t i = 0; i < chain.size(); ++i) {
+    op_index[chain[i]] = i;
+  }
+  std::vector<AnfNodePtr> inputs = {NewValueNode(std::make_shared<Primitive>(kFusedElemwiseOpName))};
+  std::unordered_map<AnfNodePtr, size_t> input_index;
+  std::vector<std::string> ops;
+  // Operands are first collected as (is_op, index) and encoded once the number of inputs is known.
+  std::vector<std::pair<bool, size_t>> operands;
+  for (const auto &cnode : chain) {
+    ops.push_back(AnfAlgo::GetCNodeName(cnode));
+    for (size_t i = 1; i < cnode->inputs().size(); ++i) {
+      auto input = cnode->input(i);
+      auto op_iter = op_index.find(input);
+      if (op_iter != op_index.end()) {
+        operands.emplace_back(true, op_iter->second);
+        continue;
+      }
+      auto input_iter = input_index.find(input);
+      if (input_iter == input_index.end()) {
+        input_iter = input_index.emplace(input, inputs.size() - 1).first;
+        inputs.push_back(input);
+      }
+      operands.emplace_back(false, input_iter->second);
+    }
+  }
+  int input_num = SizeToInt(inputs.size() - 1);
+  std::vector<int> encoded_operands;
+  for (const auto &operand : operands) {
+    encoded_operands.push_back(operand.first ? input_num + SizeToInt(operand.second) : SizeToInt(operand.second));
+  }
+  auto tail = chain.back();
+  auto fused_node = graph->NewCNode(inputs);
+  MS_EXCEPTION_IF_NULL(fused_node);
+  fused_node->set_abstract(tail->abstract());
+  fused_node->set_scope(tail->scope());
+  AnfAlgo::SetNodeAttr(kAttrFusedOps, MakeValue(ops), fused_node);
+  AnfAlgo::SetNodeAttr(kAttrFusedOperands, MakeValue(encoded_operands), fused_node);
+  return fused_node;
+}
+
+bool ElemwiseChainFusion::Run(const FuncGraphPtr &graph) {
+  MS_EXCEPTION_IF_NULL(graph);
+  auto manager = graph->manager();
+  MS_EXCEPTION_IF_NULL(manager);
+  // Grow the chains in topological order. A node takes over every chain whose tail it consumes when that tail has no
+  // other user, so only the tail of a chain is visible outside of it. The chains taken over are independent of each
+  // other, so appending them one after another keeps the merged chain in topological order.
+  std::vector<std::vector<CNodePtr>> chains;
+  std::unordered_map<AnfNodePtr, size_t> chain_of_tail;
+  std::vector<AnfNodePtr> node_list = TopoSort(graph->get_return());
+  for (const auto &node : node_list) {
+    if (!IsFusibleElemwise(node)) {
+      continue;
+    }
+    auto cnode = node->cast<CNodePtr>();
+    MS_EXCEPTION_IF_NULL(cnode);
+    auto output_shape = AnfAlgo::GetOutputInferShape(cnode, 0);
+    std::vector<size_t> producers;
+    size_t length = 1;
+    for (size_t i = 1; i < cnode->inputs().size(); ++i) {
+      auto iter = chain_of_tail.find(cnode->input(i));
+      if (iter == chain_of_tail.end()) {
+        continue;
+      }
+      const auto &chain = chains[iter->second];
+      if (length + chain.size() > kMaxChainLength || AnfAlgo::GetOutputInferShape(chain.back(), 0) != output_shape ||
+          IsUsedByOthers(graph, chain.back())) {
+        continue;
+      }
+      producers.push_back(iter->second);
+      length += chain.size();
+    }
+    if (producers.empty()) {
+      chain_of_tail[cnode] = chains.size();
+      chains.push_back({cnode});
+      continue;
+    }
+    auto &merged = chains[producers[0]];
+    (void)chain_of_tail.erase(merged.back());
+    for (size_t i = 1; i < producers.size(); ++i) {
+      auto &chain = chains[producers[i]];
+      (void)chain_of_tail.erase(chain.back());
+      merged.insert(merged.end(), chain.begin(), chain.end());
+      chain.clear();
+    }
+    merged.push_back(cnode);
+    chain_of_tail[cnode] = producers[0];
+  }
+
+  bool changed = false;
+  for (const auto &chain : chains) {
+    if (chain.size() < 2) {
+      continue;
+    }
+    auto fused_node = CreateFusedNode(graph, chain);
+    MS_LOG(INFO) << "Fuse " << chain.size() << " elementwise ops into " << fused_node->DebugString();
+    if (!manager->Replace(chain.back(), fused_node)) {
+      MS_LOG(EXCEPTION) << "Replace node " << chain.back()->DebugString() << " by fused elementwise node failed.";
+    }
+    changed = true;
+  }
+  return changed;
+}
+}  // namespace opt
+}  // namespace mindspore
@@ -0,0 +1,41 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_BACKEND_OPTIMIZER_CPU_ELEMWISE_CHAIN_FUSION_H_
+#define MINDSPORE_CCSRC_BACKEND_OPTIMIZER_CPU_ELEMWISE_CHAIN_FUSION_H_
+
+#include <string>
+#include <vector>
+#include "backend/optimizer/common/pass.h"
+#include "ir/func_graph.h"
+
+namespace mindspore {
+namespace opt {
+// Merges connected float32 elementwise ops of the same shape, where every intermediate result has a single user, into
+// one FusedElemwise node. Its kernel runs the whole chain on cache sized blocks, so the intermediates never go back to
+// memory. The ops of the chain are kept in the attr fused_ops, and the attr fused_operands lists the operands of each
+// op: index i < input num is input i of the fused node, otherwise it is the result of op (i - input num).
+class ElemwiseChainFusion : public Pass {
+ public:
+  explicit ElemwiseChainFusion(const std::string &name = "elemwise_chain_fusion") : Pass(name) {}
+  ~ElemwiseChainFusion() override = default;
+  bool Run(const FuncGraphPtr &graph) override;
+
+ private:
+  AnfNodePtr CreateFusedNode(const FuncGraphPtr &graph, const std::vector<CNodePtr> &chain) const;
+};
+}  // namespace opt
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_BACKEND_OPTIMIZER_CPU_ELEMWISE_CHAIN_FUSION_H_
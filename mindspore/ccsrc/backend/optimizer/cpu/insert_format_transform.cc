@@ -0,0 +1,110 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "backend/optimizer/cpu/insert_format_transform.h"
+#include <map>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <vector>
+#include "backend/kernel_compiler/kernel_build_info.h"
+#include "backend/session/anf_runtime_algorithm.h"
+#include "backend/session/kernel_graph.h"
+#include "frontend/operator/ops.h"
+#include "utils/utils.h"
+
+namespace mindspore {
+namespace opt {
+namespace {
+using TransKey = std::tuple<AnfNodePtr, std::string>;
+
+CNodePtr NewTransDataNode(const KernelGraphPtr &graph, const AnfNodePtr &input, const std::string &src_format,
+                          const std::string &dst_format) {
+  auto trans = graph->NewCNode({NewValueNode(std::make_shared<Primitive>(kTransDataOpName)), input});
+  MS_EXCEPTION_IF_NULL(trans);
+  auto real_input = AnfAlgo::VisitKernel(input, 0);
+  auto dtype = AnfAlgo::GetOutputDeviceDataType(real_input.first, real_input.second);
+  AnfAlgo::SetOutputInferTypeAndShape({AnfAlgo::GetOutputInferDataType(real_input.first, real_input.second)},
+                                      {AnfAlgo::GetOutputInferShape(real_input.first, real_input.second)},
+                                      trans.get());
+  kernel::KernelBuildInfo::KernelBuildInfoBuilder builder;
+  builder.SetInputsFormat({src_format});
+  builder.SetOutputsFormat({dst_format});
+  builder.SetInputsDeviceType({dtype});
+  builder.SetOutputsDeviceType({dtype});
+  AnfAlgo::SetSelectKernelBuildInfo(builder.Build(), trans.get());
+  trans->set_scope(input->scope());
+  return trans;
+}
+
+// Points input index of node to a TransData of its current input, which is created at the first request.
+bool TransformInput(const KernelGraphPtr &graph, const CNodePtr &node, size_t index, const std::string &dst_format,
+                    std::map<TransKey, CNodePtr> *trans_nodes) {
+  auto input = node->input(index);
+  MS_EXCEPTION_IF_NULL(input);
+  auto real_input = AnfAlgo::VisitKernel(input, 0);
+  auto kernel_info = real_input.first->kernel_info();
+  if (kernel_info == nullptr || !kernel_info->has_build_info()) {
+    return false;
+  }
+  auto src_format = AnfAlgo::GetOutputFormat(real_input.first, real_input.second);
+  if (src_format == dst_format) {
+    return false;
+  }
+  auto &trans = (*trans_nodes)[TransKey(input, dst_format)];
+  if (trans == nullptr) {
+    trans = NewTransDataNode(graph, input, src_format, dst_format);
+  }
+  auto manager = graph->manager();
+  MS_EXCEPTION_IF_NULL(manager);
+  manager->SetEdge(node, SizeToInt(index), trans);
+  return true;
+}
+}  // namespace
+
+bool InsertFormatTransform::Run(const FuncGraphPtr &graph) {
+  MS_EXCEPTION_IF_NULL(graph);
+  auto kernel_graph = graph->cast<KernelGraphPtr>();
+  MS_EXCEPTION_IF_NULL(kernel_graph);
+  std::map<TransKey, CNodePtr> trans_nodes;
+  bool changed = false;
+  auto kernels = kernel_graph->execution_order();
+  for (const auto &kernel : kernels) {
+    MS_EXCEPTION_IF_NULL(kernel);
+    size_t input_num = AnfAlgo::GetInputTensorNum(kernel);
+    for (size_t i = 0; i < input_num; ++i) {
+      changed = TransformInput(kernel_graph, kernel, i + 1, AnfAlgo::GetInputFormat(kernel, i), &trans_nodes) ||
+                changed;
+    }
+  }
+
+  // The outputs go back to the host in the default format.
+  auto output = kernel_graph->output();
+  MS_EXCEPTION_IF_NULL(output);
+  if (AnfAlgo::CheckPrimitiveType(output, prim::kPrimMakeTuple)) {
+    auto make_tuple = output->cast<CNodePtr>();
+    for (size_t i = 1; i < make_tuple->inputs().size(); ++i) {
+      changed = TransformInput(kernel_graph, make_tuple, i, kOpFormat_DEFAULT, &trans_nodes) || changed;
+    }
+  } else {
+    changed = TransformInput(kernel_graph, kernel_graph->get_return(), 1, kOpFormat_DEFAULT, &trans_nodes) || changed;
+  }
+  if (changed) {
+    kernel_graph->SetExecOrderByDefault();
+  }
+  return changed;
+}
+}  // namespace opt
+}  // namespace mindspore
@@ -0,0 +1,112 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "backend/optimizer/cpu/post_ops_fusion.h"
+#include <memory>
+#include <string>
+#include <vector>
+#include "backend/optimizer/common/helper.h"
+#include "backend/session/anf_runtime_algorithm.h"
+#include "frontend/operator/ops.h"
+#include "utils/utils.h"
+
+namespace mindspore {
+namespace opt {
+namespace {
+constexpr size_t kComputeInputTensorNum = 2;
+constexpr size_t kReluInputNum = 2;
+
+bool HasBoolAttr(const CNodePtr &cnode, const std::string &attr) {
+  return AnfAlgo::HasNodeAttr(attr, cnode) && AnfAlgo::GetNodeAttr<bool>(cnode, attr);
+}
+
+// The primitive of compute may be shared with other nodes, so the fused node gets a copy of it to carry the post-op
+// attrs.
+CNodePtr NewPostOpNode(const FuncGraphPtr &graph, const CNodePtr &compute, const AnfNodePtr &node,
+                       const std::vector<AnfNodePtr> &input_tensors) {
+  auto prim = AnfAlgo::GetCNodePrimitive(compute);
+  MS_EXCEPTION_IF_NULL(prim);
+  std::vector<AnfNodePtr> inputs = {NewValueNode(std::make_shared<Primitive>(*prim))};
+  inputs.insert(inputs.end(), input_tensors.begin(), input_tensors.end());
+  auto new_node = graph->NewCNode(inputs);
+  MS_EXCEPTION_IF_NULL(new_node);
+  new_node->set_abstract(node->abstract());
+  new_node->set_scope(node->scope());
+  return new_node;
+}
+}  // namespace
+
+const BaseRef BiasAddPostOpFusion::DefinePattern() const {
+  const auto prim_bias_add = std::make_shared<Primitive>(kBiasAddOpName);
+  return VectorRef({prim_bias_add, VectorRef({compute_prim_, inputs_}), bias_});
+}
+
+const AnfNodePtr BiasAddPostOpFusion::Process(const FuncGraphPtr &graph, const AnfNodePtr &node,
+                                              const EquivPtr &equiv) const {
+  MS_EXCEPTION_IF_NULL(graph);
+  MS_EXCEPTION_IF_NULL(node);
+  MS_EXCEPTION_IF_NULL(equiv);
+  auto bias_add = node->cast<CNodePtr>();
+  MS_EXCEPTION_IF_NULL(bias_add);
+  CheckCNodeInputSize(bias_add, kBiasAddInputNum);
+  auto compute = bias_add->input(1)->cast<CNodePtr>();
+  MS_EXCEPTION_IF_NULL(compute);
+  // A bias after the ReLU can not become a post-op, and the unbiased output must not be needed by others.
+  if (AnfAlgo::GetInputTensorNum(compute) != kComputeInputTensorNum || HasBoolAttr(compute, kAttrFusedRelu) ||
+      IsUsedByOthers(graph, compute) || AnfAlgo::GetOutputInferDataType(node, 0) != kNumberTypeFloat32) {
+    return nullptr;
+  }
+  auto bias = utils::cast<AnfNodePtr>((*equiv)[bias_]);
+  MS_EXCEPTION_IF_NULL(bias);
+  auto new_node = NewPostOpNode(graph, compute, node, {compute->input(1), compute->input(2), bias});
+  AnfAlgo::SetNodeAttr(kAttrHasBias, MakeValue(true), new_node);
+  return new_node;
+}
+
+const BaseRef ReluPostOpFusion::DefinePattern() const {
+  return VectorRef({prim::kPrimRelu, VectorRef({compute_prim_, inputs_})});
+}
+
+const AnfNodePtr ReluPostOpFusion::Process(const FuncGraphPtr &graph, const AnfNodePtr &node, const EquivPtr &) const {
+  MS_EXCEPTION_IF_NULL(graph);
+  MS_EXCEPTION_IF_NULL(node);
+  auto relu = node->cast<CNodePtr>();
+  MS_EXCEPTION_IF_NULL(relu);
+  CheckCNodeInputSize(relu, kReluInputNum);
+  auto compute = relu->input(1)->cast<CNodePtr>();
+  MS_EXCEPTION_IF_NULL(compute);
+  if (HasBoolAttr(compute, kAttrFusedRelu) || IsUsedByOthers(graph, compute) ||
+      AnfAlgo::GetOutputInferDataType(node, 0) != kNumberTypeFloat32) {
+    return nullptr;
+  }
+  std::vector<AnfNodePtr> input_tensors(compute->inputs().begin() + 1, compute->inputs().end());
+  auto new_node = NewPostOpNode(graph, compute, node, input_tensors);
+  AnfAlgo::SetNodeAttr(kAttrFusedRelu, MakeValue(true), new_node);
+  return new_node;
+}
+
+Conv2DBiasAddFusion::Conv2DBiasAddFusion(bool multigraph)
+    : BiasAddPostOpFusion("conv2d_biasadd_fusion", prim::kPrimConv2D, multigraph) {}
+
+Conv2DReluFusion::Conv2DReluFusion(bool multigraph)
+    : ReluPostOpFusion("conv2d_relu_fusion", prim::kPrimConv2D, multigraph) {}
+
+MatMulBiasAddFusion::MatMulBiasAddFusion(bool multigraph)
+    : BiasAddPostOpFusion("matmul_biasadd_fusion", prim::kPrimMatMul, multigraph) {}
+
+MatMulReluFusion::MatMulReluFusion(bool multigraph)
+    : ReluPostOpFusion("matmul_relu_fusion", prim::kPrimMatMul, multigraph) {}
+}  // namespace opt
+}  // namespace mindspore
@@ -0,0 +1,81 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_BACKEND_OPTIMIZER_CPU_POST_OPS_FUSION_H_
+#define MINDSPORE_CCSRC_BACKEND_OPTIMIZER_CPU_POST_OPS_FUSION_H_
+
+#include <memory>
+#include <string>
+#include "backend/optimizer/common/optimizer.h"
+
+namespace mindspore {
+namespace opt {
+// BiasAdd(Conv2D(x, w), b) -> Conv2D(x, w, b), the oneDNN kernel adds the bias while writing the output.
+class BiasAddPostOpFusion : public PatternProcessPass {
+ public:
+  BiasAddPostOpFusion(const std::string &name, const PrimitivePtr &compute_prim, bool multigraph = true)
+      : PatternProcessPass(name, multigraph), compute_prim_(compute_prim), inputs_(std::make_shared<SeqVar>()) {
+    bias_ = std::make_shared<Var>();
+  }
+  ~BiasAddPostOpFusion() override = default;
+  const BaseRef DefinePattern() const override;
+  const AnfNodePtr Process(const FuncGraphPtr &, const AnfNodePtr &, const EquivPtr &) const override;
+
+ private:
+  PrimitivePtr compute_prim_;
+  VarPtr inputs_;
+  VarPtr bias_;
+};
+
+// ReLU(Conv2D(x, w[, b])) -> Conv2D(x, w[, b]) with attr fused_relu, executed as an eltwise post-op of oneDNN.
+class ReluPostOpFusion : public PatternProcessPass {
+ public:
+  ReluPostOpFusion(const std::string &name, const PrimitivePtr &compute_prim, bool multigraph = true)
+      : PatternProcessPass(name, multigraph), compute_prim_(compute_prim), inputs_(std::make_shared<SeqVar>()) {}
+  ~ReluPostOpFusion() override = default;
+  const BaseRef DefinePattern() const override;
+  const AnfNodePtr Process(const FuncGraphPtr &, const AnfNodePtr &, const EquivPtr &) const override;
+
+ private:
+  PrimitivePtr compute_prim_;
+  VarPtr inputs_;
+};
+
+class Conv2DBiasAddFusion : public BiasAddPostOpFusion {
+ public:
+  explicit Conv2DBiasAddFusion(bool multigraph = true);
+  ~Conv2DBiasAddFusion() override = default;
+};
+
+class Conv2DReluFusion : public ReluPostOpFusion {
+ public:
+  explicit Conv2DReluFusion(bool multigraph = true);
+  ~Conv2DReluFusion() override = default;
+};
+
+class MatMulBiasAddFusion : public BiasAddPostOpFusion {
+ public:
+  explicit MatMulBiasAddFusion(bool multigraph = true);
+  ~MatMulBiasAddFusion() override = default;
+};
+
+class MatMulReluFusion : public ReluPostOpFusion {
+ public:
+  explicit MatMulReluFusion(bool multigraph = true);
+  ~MatMulReluFusion() override = default;
+};
+}  // namespace opt
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_BACKEND_OPTIMIZER_CPU_POST_OPS_FUSION_H_
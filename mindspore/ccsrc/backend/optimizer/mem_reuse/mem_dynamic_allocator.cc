@@ -15,23 +15,41 @@
  */
 
 #include "backend/optimizer/mem_reuse/mem_dynamic_allocator.h"
+#include <fstream>
 #include "utils/ms_utils.h"
 #include "utils/convert_utils.h"
 #include "utils/log_adapter.h"
 
 namespace mindspore {
 namespace device {
+namespace {
+constexpr auto kEnvMemPoolTrace = "MS_MEM_POOL_TRACE";
+}  // namespace
+
+DynamicMemPoolBestFit::DynamicMemPoolBestFit() {
+  mem_trace_path_ = common::GetEnv(kEnvMemPoolTrace);
+  mem_trace_enable_ = !mem_trace_path_.empty();
+}
+
 DynamicMemPoolBestFit::~DynamicMemPoolBestFit() {
   global_mem_block_list_.clear();
-  global_idle_mem_buf_map_.clear();
+  global_idle_mem_bufs_.clear();
 }
 
 DeviceMemPtr DynamicMemPoolBestFit::AllocTensorMem(size_t size) {
-  size_t align_size = AlignMemorySize(size);
+  DeviceMemPtr device_addr = AllocMemBuf(AlignMemorySize(size));
+  if (device_addr != nullptr) {
+    alloc_num_statistics_++;
+    TraceAlloc(size, device_addr);
+  }
+  return device_addr;
+}
+
+DeviceMemPtr DynamicMemPoolBestFit::AllocMemBuf(size_t size) {
   // Find the idle memory buf by tensor size, if not find, then add new memory block and memory buf.
-  DeviceMemPtr device_addr = FindIdleMemBuf(align_size);
+  DeviceMemPtr device_addr = FindIdleMemBuf(size);
   if (!device_addr) {
-    device_addr = AddMemBlockAndMemBuf(align_size);
+    device_addr = AddMemBlockAndMemBuf(size);
   }
   return device_addr;
 }
@@ -40,7 +58,7 @@ std::vector<DeviceMemPtr> DynamicMemPoolBestFit::AllocContinuousTensorMem(size_t
                                                                           std::vector<size_t> size_list) {
   std::vector<DeviceMemPtr> device_addr_list;
   // Pre-alloc the one whole piece memory.
-  auto device_addr = AllocTensorMem(total_size);
+  auto device_addr = AllocMemBuf(AlignMemorySize(total_size));
   if (!device_addr) {
     return device_addr_list;
   }
@@ -62,6 +80,8 @@ std::vector<DeviceMemPtr> DynamicMemPoolBestFit::AllocContinuousTensorMem(size_t
     continuous_mem_buf = std::make_shared<DynamicMemBuf>(buf_addr, kMemBufUsed, size_list[i]);
     (void)mem_block->block_all_mem_buf_map_.emplace(buf_addr, continuous_mem_buf);
     device_addr_list.emplace_back(buf_addr);
+    alloc_num_statistics_++;
+    TraceAlloc(size_list[i], buf_addr);
     buf_addr = AddressOffset(buf_addr, size_list[i]);
   }
   // Update the size of the last memory buf.
@@ -76,10 +96,65 @@ size_t DynamicMemPoolBestFit::AlignMemorySize(size_t size) const {
   return ((size + DYNAMIC_MEM_ALIGN_SIZE - 1) / DYNAMIC_MEM_ALIGN_SIZE) * DYNAMIC_MEM_ALIGN_SIZE;
 }
 
+size_t DynamicMemPoolBestFit::SizeClass(size_t size) {
+  if (size < 4) {
+    return size;
+  }
+  size_t log2 = 0;
+  for (size_t i = size; i > 1; i >>= 1) {
+    log2++;
+  }
+  // The two bits below the highest one split a power of two into four classes.
+  return log2 * 4 + ((size >> (log2 - 2)) & 3);
+}
+
+size_t DynamicMemPoolBestFit::FindIdleSizeClass(size_t size_class) const {
+  for (size_t word = size_class / 64; word < idle_size_class_bits_.size(); ++word) {
+    uint64_t bits = idle_size_class_bits_[word];
+    if (word == size_class / 64) {
+      bits &= ~uint64_t(0) << (size_class % 64);
+    }
+    if (bits != 0) {
+      size_t bit = 0;
+      while ((bits & 1) == 0) {
+        bits >>= 1;
+        bit++;
+      }
+      return word * 64 + bit;
+    }
+  }
+  return DYNAMIC_MEM_SIZE_CLASS_NUM;
+}
+
+void DynamicMemPoolBestFit::AddIdleMemBuf(const DynamicMemBufPtr &mem_buf) {
+  size_t size_class = SizeClass(mem_buf->size_);
+  (void)global_idle_mem_bufs_[size_class].insert(mem_buf);
+  idle_size_class_bits_[size_class / 64] |= uint64_t(1) << (size_class % 64);
+  idle_mem_buf_num_++;
+}
+
+void DynamicMemPoolBestFit::EraseIdleMemBuf(const IdleMemBufSet::iterator &iter, size_t size_class) {
+  auto &idle_mem_bufs = global_idle_mem_bufs_[size_class];
+  (void)idle_mem_bufs.erase(iter);
+  if (idle_mem_bufs.empty()) {
+    idle_size_class_bits_[size_class / 64] &= ~(uint64_t(1) << (size_class % 64));
+  }
+  idle_mem_buf_num_--;
+}
+
 DeviceMemPtr DynamicMemPoolBestFit::FindIdleMemBuf(size_t size) {
-  auto iter = global_idle_mem_buf_map_.lower_bound(size);
-  if (iter != global_idle_mem_buf_map_.end()) {
-    auto mem_buf = iter->second;
+  // The best fit is the smallest idle buf not smaller than size in the class of size, or else the smallest one of the
+  // next class which is not empty.
+  size_t size_class = SizeClass(size);
+  auto iter = global_idle_mem_bufs_[size_class].lower_bound(IdleMemBufKey(size, nullptr));
+  if (iter == global_idle_mem_bufs_[size_class].end()) {
+    size_class = FindIdleSizeClass(size_class + 1);
+    if (size_class < DYNAMIC_MEM_SIZE_CLASS_NUM) {
+      iter = global_idle_mem_bufs_[size_class].begin();
+    }
+  }
+  if (size_class < DYNAMIC_MEM_SIZE_CLASS_NUM) {
+    auto mem_buf = *iter;
     MS_EXCEPTION_IF_NULL(mem_buf);
     if (mem_buf->status_ != kMemBufIdle) {
       MS_LOG(EXCEPTION) << "Find the mem_buf is not idle, alloc_size[" << size << "] mem_buf_size[" << mem_buf->size_
@@ -87,7 +162,7 @@ DeviceMemPtr DynamicMemPoolBestFit::FindIdleMemBuf(size_t size) {
     }
     mem_buf->status_ = kMemBufUsed;
     // Remove map of old idle memory buf
-    (void)global_idle_mem_buf_map_.erase(iter);
+    EraseIdleMemBuf(iter, size_class);
     // Divide memory buf
     if (IsDivide(size, mem_buf->size_)) {
       DivideMemBuf(size, mem_buf);
@@ -169,7 +244,7 @@ void DynamicMemPoolBestFit::DivideMemBuf(size_t size, const DynamicMemBufPtr &me
   // Add map of new memory buf in the block
   (void)mem_block->block_all_mem_buf_map_.emplace(newbuf_addr, new_mem_buf);
   // Add map of new idle memory buf
-  (void)global_idle_mem_buf_map_.emplace(newbuf_size, new_mem_buf);
+  AddIdleMemBuf(new_mem_buf);
 }
 
 bool DynamicMemPoolBestFit::CmpMemBlock(const DeviceMemPtr device_addr, const DynamicMemBlockPtr mem_block) {
@@ -195,6 +270,8 @@ void DynamicMemPoolBestFit::FreeTensorMem(const DeviceMemPtr device_addr) {
     MS_LOG(DEBUG) << "Can't find the mem_block of the device address[" << device_addr << "].";
     return;
   }
+  free_num_statistics_++;
+  TraceFree(device_addr);
   CombineMemBuf(mem_block, device_addr);
 }
 
@@ -220,7 +297,7 @@ void DynamicMemPoolBestFit::CombineMemBuf(const DynamicMemBlockPtr &mem_block, c
     MS_EXCEPTION_IF_NULL(next_mem_buf);
     if (next_mem_buf->status_ == kMemBufIdle) {
       mem_buf->size_ += next_mem_buf->size_;
-      EraseIdleMemBuf(next_mem_buf->size_, next_mem_buf->device_addr_);
+      EraseIdleMemBuf(next_mem_buf);
       (void)mem_block->block_all_mem_buf_map_.erase(next_iter);
     }
   }
@@ -233,7 +310,7 @@ void DynamicMemPoolBestFit::CombineMemBuf(const DynamicMemBlockPtr &mem_block, c
     prev_mem_buf = prev_iter->second;
     MS_EXCEPTION_IF_NULL(prev_mem_buf);
     if (prev_mem_buf->status_ == kMemBufIdle) {
-      EraseIdleMemBuf(prev_mem_buf->size_, prev_mem_buf->device_addr_);
+      EraseIdleMemBuf(prev_mem_buf);
       prev_mem_buf->size_ += mem_buf->size_;
       (void)mem_block->block_all_mem_buf_map_.erase(iter);
       forward_combine = true;
@@ -241,30 +318,138 @@ void DynamicMemPoolBestFit::CombineMemBuf(const DynamicMemBlockPtr &mem_block, c
   }
   // Add map of new idle memory
   if (forward_combine) {
-    (void)global_idle_mem_buf_map_.emplace(prev_mem_buf->size_, prev_mem_buf);
+    AddIdleMemBuf(prev_mem_buf);
   } else {
-    (void)global_idle_mem_buf_map_.emplace(mem_buf->size_, mem_buf);
+    AddIdleMemBuf(mem_buf);
   }
 }
 
-void DynamicMemPoolBestFit::EraseIdleMemBuf(size_t size, const DeviceMemPtr device_addr) {
-  MS_EXCEPTION_IF_NULL(device_addr);
-  auto iter = global_idle_mem_buf_map_.equal_range(size);
-  while (iter.first != iter.second) {
-    MS_EXCEPTION_IF_NULL(iter.first->second);
-    // Remove map of the idle memory buf by size and device address
-    if (iter.first->second->device_addr_ == device_addr) {
-      (void)global_idle_mem_buf_map_.erase(iter.first);
-      return;
+void DynamicMemPoolBestFit::EraseIdleMemBuf(const DynamicMemBufPtr &mem_buf) {
+  MS_EXCEPTION_IF_NULL(mem_buf);
+  size_t size_class = SizeClass(mem_buf->size_);
+  auto iter = global_idle_mem_bufs_[size_class].find(mem_buf);
+  if (iter == global_idle_mem_bufs_[size_class].end()) {
+    MS_LOG(ERROR) << "Can't find the size[" << mem_buf->size_ << "] and device address[" << mem_buf->device_addr_
+                  << "] in the idle mem_buf.";
+    return;
+  }
+  EraseIdleMemBuf(iter, size_class);
+}
+
+DynamicMemPoolStatistics DynamicMemPoolBestFit::QueryMemPoolStatistics() const {
+  DynamicMemPoolStatistics statistics;
+  statistics.total_mem_size_ = total_mem_statistics_;
+  statistics.used_mem_size_ = total_used_mem_statistics_;
+  statistics.idle_mem_size_ = total_mem_statistics_ - total_used_mem_statistics_;
+  for (auto iter = global_idle_mem_bufs_.rbegin(); iter != global_idle_mem_bufs_.rend(); ++iter) {
+    if (!iter->empty()) {
+      statistics.largest_idle_buf_size_ = (*iter->rbegin())->size_;
+      break;
     }
-    (void)iter.first++;
   }
-  MS_LOG(ERROR) << "Can't find the size[" << size << "] and device address[" << device_addr << "] in the idle mem_buf.";
+  statistics.fragmented_mem_size_ = statistics.idle_mem_size_ - statistics.largest_idle_buf_size_;
+  statistics.used_mem_peak_ = used_mem_peak_statistics_;
+  statistics.mem_block_num_ = global_mem_block_list_.size();
+  statistics.idle_mem_buf_num_ = idle_mem_buf_num_;
+  statistics.alloc_num_ = alloc_num_statistics_;
+  statistics.free_num_ = free_num_statistics_;
+  return statistics;
+}
+
+void DynamicMemPoolBestFit::TraceAlloc(size_t size, DeviceMemPtr device_addr) {
+  if (!mem_trace_enable_) {
+    return;
+  }
+  mem_trace_ids_[device_addr] = mem_trace_.size();
+  mem_trace_.push_back({true, size, mem_trace_.size()});
+}
+
+void DynamicMemPoolBestFit::TraceFree(DeviceMemPtr device_addr) {
+  if (!mem_trace_enable_) {
+    return;
+  }
+  auto iter = mem_trace_ids_.find(device_addr);
+  if (iter == mem_trace_ids_.end()) {
+    // Allocated before the trace started.
+    return;
+  }
+  mem_trace_.push_back({false, 0, iter->second});
+  (void)mem_trace_ids_.erase(iter);
+}
+
+bool DynamicMemPoolBestFit::DumpMemTrace(const std::string &file_path) const {
+  std::ofstream ofs(file_path);
+  if (!ofs.is_open()) {
+    MS_LOG(ERROR) << "Open memory trace file " << file_path << " failed.";
+    return false;
+  }
+  // One request a line, "a <id> <size>" for an alloc and "f <id>" for a free.
+  for (const auto &item : mem_trace_) {
+    if (item.is_alloc_) {
+      ofs << "a " << item.id_ << " " << item.size_ << "\n";
+    } else {
+      ofs << "f " << item.id_ << "\n";
+    }
+  }
+  return ofs.good();
+}
+
+bool DynamicMemPoolBestFit::LoadMemTrace(const std::string &file_path, std::vector<DynamicMemTraceItem> *trace) {
+  MS_EXCEPTION_IF_NULL(trace);
+  std::ifstream ifs(file_path);
+  if (!ifs.is_open()) {
+    MS_LOG(ERROR) << "Open memory trace file " << file_path << " failed.";
+    return false;
+  }
+  trace->clear();
+  char kind = 0;
+  while (ifs >> kind) {
+    DynamicMemTraceItem item;
+    item.is_alloc_ = kind == 'a';
+    if (!(ifs >> item.id_) || (item.is_alloc_ && !(ifs >> item.size_)) || (kind != 'a' && kind != 'f')) {
+      MS_LOG(ERROR) << "Invalid memory trace file " << file_path << " at request " << trace->size() << ".";
+      return false;
+    }
+    trace->push_back(item);
+  }
+  return true;
+}
+
+bool DynamicMemPoolBestFit::ReplayMemTrace(const std::vector<DynamicMemTraceItem> &trace) {
+  std::unordered_map<size_t, DeviceMemPtr> device_addrs;
+  bool ret = true;
+  for (const auto &item : trace) {
+    if (item.is_alloc_) {
+      auto device_addr = AllocTensorMem(item.size_);
+      if (device_addr == nullptr) {
+        MS_LOG(WARNING) << "Replay alloc " << item.id_ << " of size " << item.size_ << " failed.";
+        ret = false;
+        break;
+      }
+      device_addrs[item.id_] = device_addr;
+      continue;
+    }
+    auto iter = device_addrs.find(item.id_);
+    if (iter != device_addrs.end()) {
+      FreeTensorMem(iter->second);
+      (void)device_addrs.erase(iter);
+    }
+  }
+  for (auto &item : device_addrs) {
+    FreeTensorMem(item.second);
+  }
+  return ret;
 }
 
 void DynamicMemPoolBestFit::ReleaseDeviceRes() {
-  MS_LOG(INFO) << "The dynamic memory pool total size is " << total_mem_statistics_ << ", total used size is "
-               << total_used_mem_statistics_ << ", used peak size is " << used_mem_peak_statistics_ << ".";
+  auto statistics = QueryMemPoolStatistics();
+  MS_LOG(INFO) << "The dynamic memory pool total size is " << statistics.total_mem_size_ << ", total used size is "
+               << statistics.used_mem_size_ << ", used peak size is " << statistics.used_mem_peak_
+               << ", fragmented size is " << statistics.fragmented_mem_size_ << ", " << statistics.alloc_num_
+               << " allocs and " << statistics.free_num_ << " frees.";
+  if (!mem_trace_path_.empty()) {
+    (void)DumpMemTrace(mem_trace_path_);
+  }
   for (auto iter = global_mem_block_list_.begin(); iter != global_mem_block_list_.end(); ++iter) {
     auto device_addr = (*iter)->device_addr();
     if (device_addr != nullptr) {
@@ -304,13 +489,15 @@ void DynamicMemPoolBestFit::DumpDynamicMemPoolInfo() {
     }
   }
   // Dump all the idle memory buf info
-  MS_LOG(INFO) << "Dump all idle mem_buf info: counts[" << global_idle_mem_buf_map_.size() << "].";
-  for (auto iter_idle = global_idle_mem_buf_map_.begin(); iter_idle != global_idle_mem_buf_map_.end(); ++iter_idle) {
-    mem_buf = iter_idle->second;
-    MS_EXCEPTION_IF_NULL(mem_buf);
-    total_idle_mem2 += mem_buf->size_;
-    MS_LOG(INFO) << "Idle mem_buf info: size[" << mem_buf->size_ << "] address[" << mem_buf->device_addr_ << "] status["
-                 << mem_buf->status_ << "].";
+  MS_LOG(INFO) << "Dump all idle mem_buf info: counts[" << idle_mem_buf_num_ << "].";
+  for (const auto &idle_mem_bufs : global_idle_mem_bufs_) {
+    for (const auto &idle_mem_buf : idle_mem_bufs) {
+      mem_buf = idle_mem_buf;
+      MS_EXCEPTION_IF_NULL(mem_buf);
+      total_idle_mem2 += mem_buf->size_;
+      MS_LOG(INFO) << "Idle mem_buf info: size[" << mem_buf->size_ << "] address[" << mem_buf->device_addr_
+                   << "] status[" << mem_buf->status_ << "].";
+    }
   }
   // Dump the memory statistical info
   MS_LOG(INFO) << "Total allocated memory[" << total_mem << "], used memory[" << total_used_mem << "], idle memory["
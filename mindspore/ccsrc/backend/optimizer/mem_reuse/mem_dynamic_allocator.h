@@ -17,8 +17,13 @@
 #ifndef MINDSPORE_CCSRC_BACKEND_OPTIMIZER_MEM_REUSE_MEM_DYNAMIC_ALLOCATOR_H_
 #define MINDSPORE_CCSRC_BACKEND_OPTIMIZER_MEM_REUSE_MEM_DYNAMIC_ALLOCATOR_H_
 
+#include <array>
+#include <cstdint>
 #include <memory>
 #include <map>
+#include <set>
+#include <string>
+#include <unordered_map>
 #include <vector>
 #include <algorithm>
 #include <utility>
@@ -36,6 +41,9 @@ static const size_t DYNAMIC_MEM_ALIGN_SIZE = 512;
 // The minimum unit size (500M) of memory block used for dynamic extend.
 static const size_t DYNAMIC_MEM_ALLOC_UNIT_SIZE = 500 << 20;
 
+// The idle memory bufs are kept in size classes, four for each power of two.
+static const size_t DYNAMIC_MEM_SIZE_CLASS_NUM = 256;
+
 // The Comparator of device address from small to large.
 struct DeviceAddrCmp {
   bool operator()(const DeviceMemPtr addr1, const DeviceMemPtr addr2) const { return addr1 < addr2; }
@@ -50,8 +58,23 @@ struct DynamicMemBuf {
   size_t size_;
 };
 using DynamicMemBufPtr = std::shared_ptr<DynamicMemBuf>;
-// Multimap key is the tensor size, for finding the idle memory buf by tensor size.
-using SizeMapMemBuf = std::multimap<size_t, DynamicMemBufPtr>;
+// The Comparator of idle memory buf by size, and by device address for the same size. The bufs are also found by
+// the pair of size and device address.
+using IdleMemBufKey = std::pair<size_t, DeviceMemPtr>;
+struct IdleMemBufCmp {
+  using is_transparent = void;
+  bool operator()(const DynamicMemBufPtr &buf1, const DynamicMemBufPtr &buf2) const {
+    return IdleMemBufKey(buf1->size_, buf1->device_addr_) < IdleMemBufKey(buf2->size_, buf2->device_addr_);
+  }
+  bool operator()(const DynamicMemBufPtr &buf, const IdleMemBufKey &key) const {
+    return IdleMemBufKey(buf->size_, buf->device_addr_) < key;
+  }
+  bool operator()(const IdleMemBufKey &key, const DynamicMemBufPtr &buf) const {
+    return key < IdleMemBufKey(buf->size_, buf->device_addr_);
+  }
+};
+// The idle memory bufs of one size class, the size of a buf in the set must not change.
+using IdleMemBufSet = std::set<DynamicMemBufPtr, IdleMemBufCmp>;
 // Map key is the device address, for finding the used memory buf in memory block by device address.
 using DeviceAddrMapMemBuf = std::map<DeviceMemPtr, DynamicMemBufPtr, DeviceAddrCmp>;
 
@@ -72,10 +95,33 @@ class DynamicMemBlock {
 };
 using DynamicMemBlockPtr = std::shared_ptr<DynamicMemBlock>;
 
+// The memory statistics of the pool. The fragmented memory is the idle memory out of the largest idle buf, which no
+// request can use as a whole.
+struct DynamicMemPoolStatistics {
+  size_t total_mem_size_{0};
+  size_t used_mem_size_{0};
+  size_t idle_mem_size_{0};
+  size_t fragmented_mem_size_{0};
+  size_t largest_idle_buf_size_{0};
+  size_t used_mem_peak_{0};
+  size_t mem_block_num_{0};
+  size_t idle_mem_buf_num_{0};
+  size_t alloc_num_{0};
+  size_t free_num_{0};
+};
+
+// One request to the pool. A trace of them replays the same requests on another pool: the id of an alloc is its
+// number in the trace and a free refers to the alloc it frees. Continuous memory is traced as an alloc per tensor.
+struct DynamicMemTraceItem {
+  bool is_alloc_{true};
+  size_t size_{0};
+  size_t id_{0};
+};
+
 // The main class of dynamic memory pool.
 class DynamicMemPoolBestFit {
  public:
-  DynamicMemPoolBestFit() = default;
+  DynamicMemPoolBestFit();
   virtual ~DynamicMemPoolBestFit();
   // The main program entry of memory alloc.
   DeviceMemPtr AllocTensorMem(size_t size);
@@ -87,6 +133,15 @@ class DynamicMemPoolBestFit {
   void ReleaseDeviceRes();
   // Display the information of memory block and memory buf.
   void DumpDynamicMemPoolInfo();
+  DynamicMemPoolStatistics QueryMemPoolStatistics() const;
+
+  // Record the requests to the pool, it is on from the start when MS_MEM_POOL_TRACE names the file to dump them to.
+  void set_mem_trace_enable(bool enable) { mem_trace_enable_ = enable; }
+  const std::vector<DynamicMemTraceItem> &mem_trace() const { return mem_trace_; }
+  bool DumpMemTrace(const std::string &file_path) const;
+  static bool LoadMemTrace(const std::string &file_path, std::vector<DynamicMemTraceItem> *trace);
+  // Run the requests of a trace on this pool, the memory still used at the end of the trace is freed.
+  bool ReplayMemTrace(const std::vector<DynamicMemTraceItem> &trace);
 
   // Get the related memory statistics information.
   size_t total_mem_statistics() const { return total_mem_statistics_; }
@@ -106,8 +161,16 @@ class DynamicMemPoolBestFit {
   virtual size_t mem_alloc_unit_size() const { return DYNAMIC_MEM_ALLOC_UNIT_SIZE; }
 
  private:
+  // Alloc the memory buf by aligned size from the idle memory bufs or a new memory block.
+  DeviceMemPtr AllocMemBuf(size_t size);
   // Find the idle memory buf by aligned size when memory alloc.
   DeviceMemPtr FindIdleMemBuf(size_t size);
+  static size_t SizeClass(size_t size);
+  // The first size class from size_class on with idle memory bufs, DYNAMIC_MEM_SIZE_CLASS_NUM if there is none.
+  size_t FindIdleSizeClass(size_t size_class) const;
+  void AddIdleMemBuf(const DynamicMemBufPtr &mem_buf);
+  void TraceAlloc(size_t size, DeviceMemPtr device_addr);
+  void TraceFree(DeviceMemPtr device_addr);
   // Add the memory block and memory buf when memory alloc not find the idle memory buf.
   DeviceMemPtr AddMemBlockAndMemBuf(size_t size);
   // Calculate memory block required alloc size when adding the memory block.
@@ -123,18 +186,30 @@ class DynamicMemPoolBestFit {
 
   // Combine the memory buf when memory free, to avoid the memory fragmentation.
   void CombineMemBuf(const DynamicMemBlockPtr &mem_block, const DeviceMemPtr device_addr);
-  // Erase the idle memory buf by size and device address when idle memory buf is combined.
-  void EraseIdleMemBuf(size_t size, const DeviceMemPtr device_addr);
+  // Erase the idle memory buf when idle memory buf is combined.
+  void EraseIdleMemBuf(const DynamicMemBufPtr &mem_buf);
+  void EraseIdleMemBuf(const IdleMemBufSet::iterator &iter, size_t size_class);
 
   // The global memory block list which is arranged in order by base device address of memory block.
   std::vector<DynamicMemBlockPtr> global_mem_block_list_;
-  // The map of all idle memory buf by size.
-  SizeMapMemBuf global_idle_mem_buf_map_;
+  // All the idle memory bufs by size class.
+  std::vector<IdleMemBufSet> global_idle_mem_bufs_ = std::vector<IdleMemBufSet>(DYNAMIC_MEM_SIZE_CLASS_NUM);
+  // One bit for each size class which has idle memory bufs.
+  std::array<uint64_t, DYNAMIC_MEM_SIZE_CLASS_NUM / 64> idle_size_class_bits_{};
+  size_t idle_mem_buf_num_{0};
 
   // The related memory statistics information.
   size_t total_mem_statistics_{0};
   size_t total_used_mem_statistics_{0};
   size_t used_mem_peak_statistics_{0};
+  size_t alloc_num_statistics_{0};
+  size_t free_num_statistics_{0};
+
+  bool mem_trace_enable_{false};
+  std::string mem_trace_path_;
+  std::vector<DynamicMemTraceItem> mem_trace_;
+  // The trace id of the used device addresses.
+  std::unordered_map<DeviceMemPtr, size_t> mem_trace_ids_;
 };
 }  // namespace device
 }  // namespace mindspore
@@ -253,7 +253,9 @@ void MemSwapManager::AddSwapInfo() {
                                        swap_out_order};
       AddKernelMemSwapInfo(execution_order_[swap_out_order], mem_swap_out_info);
 
-      size_t swap_in_order = swap_topo_pair.second - 1;
+      size_t lookahead =
+        std::max<size_t>(std::min(prefetch_lookahead_, swap_topo_pair.second - swap_out_order - 1), 1);
+      size_t swap_in_order = swap_topo_pair.second - lookahead;
       MemSwapInfo mem_swap_in_info = {SwapKind::kHostToDevice, kernel_exec_info.topo_order_, output_idx,
                                       swap_out_order};
       if (swap_in_order <= swap_out_order) {
@@ -264,6 +266,59 @@ void MemSwapManager::AddSwapInfo() {
   }
 }
 
+MemSwapPlan MemSwapManager::QueryMemSwapPlan() const {
+  MemSwapPlan plan;
+  // A tensor takes memory from the kernel producing it to its last user, except between its swap out and swap in.
+  size_t kernel_num = execution_order_.size();
+  std::vector<size_t> allocated(kernel_num + 1, 0);
+  std::vector<size_t> released(kernel_num + 1, 0);
+  std::vector<size_t> swap_allocated(kernel_num + 1, 0);
+  std::vector<size_t> swap_released(kernel_num + 1, 0);
+  for (const auto &tensor_info : ordered_tensors_) {
+    const auto &kernel_exec_info = SearchKernelExecutionInfo(tensor_info.kernel_);
+    size_t first = kernel_exec_info.topo_order_;
+    size_t last = first;
+    auto iter = kernel_exec_info.node_users_map_.find(tensor_info.output_idx_);
+    if (iter != kernel_exec_info.node_users_map_.end() && !iter->second.empty()) {
+      last = std::max(first, iter->second.back());
+    }
+    allocated[first] += tensor_info.tensor_size_;
+    released[last + 1] += tensor_info.tensor_size_;
+  }
+  for (const auto &kernel_exec_info_pair : kernel_execution_info_) {
+    for (const auto &host_addr_pair : kernel_exec_info_pair.second.host_addrs_) {
+      plan.swap_out_bytes_ += host_addr_pair.second.first.size;
+    }
+  }
+  for (const auto &mem_swap_info_pair : mem_swap_info_map_) {
+    auto iter = kernel_execution_info_.find(mem_swap_info_pair.first);
+    if (iter == kernel_execution_info_.end()) {
+      MS_LOG(EXCEPTION) << "Can not find execution info of the kernel triggering memory swap.";
+    }
+    size_t trigger_pos = iter->second.topo_order_;
+    for (const auto &mem_swap_info : mem_swap_info_pair.second) {
+      plan.swap_task_num_++;
+      if (mem_swap_info.swap_kind_ != SwapKind::kHostToDevice) {
+        continue;
+      }
+      auto kernel = QueryKernelByTopoOrder(mem_swap_info.topo_order_);
+      size_t tensor_size = QueryKernelHostAddr(kernel, mem_swap_info.output_idx_).size;
+      plan.swap_in_bytes_ += tensor_size;
+      swap_released[mem_swap_info.swap_out_pos_ + 1] += tensor_size;
+      swap_allocated[trigger_pos + 1] += tensor_size;
+    }
+  }
+  size_t mem_size = 0;
+  size_t swapped_size = 0;
+  for (size_t i = 0; i < kernel_num; ++i) {
+    mem_size = mem_size + allocated[i] - released[i];
+    swapped_size = swapped_size + swap_released[i] - swap_allocated[i];
+    plan.peak_mem_size_ = std::max(plan.peak_mem_size_, mem_size);
+    plan.peak_mem_size_with_swap_ = std::max(plan.peak_mem_size_with_swap_, mem_size - swapped_size);
+  }
+  return plan;
+}
+
 void MemSwapManager::AddMemSwapTask(SwapKind swap_kind, const DeviceAddressPtr &device_address,
                                     const HostAddress &host_address, bool mock, bool profiling,
                                     float *cost_time) const {
@@ -29,6 +29,15 @@ using PerformPair = std::pair<float, float>;
 namespace mindspore {
 namespace device {
 namespace memswap {
+// What a swap scheme costs and saves, the memory sizes are the peak of the kernel outputs alive at once.
+struct MemSwapPlan {
+  size_t swap_out_bytes_{0};
+  size_t swap_in_bytes_{0};
+  size_t swap_task_num_{0};
+  size_t peak_mem_size_{0};
+  size_t peak_mem_size_with_swap_{0};
+};
+
 class MemSwapManager {
  public:
   explicit MemSwapManager(const MemCopyManagerPtr &mem_copy_manager)
@@ -63,6 +72,11 @@ class MemSwapManager {
 
   bool mem_swap_init() const { return mem_swap_initialized_; }
 
+  // Swap a tensor in this many kernels before its user, so that the copy overlaps the kernels in between.
+  void set_prefetch_lookahead(size_t lookahead) { prefetch_lookahead_ = lookahead; }
+
+  MemSwapPlan QueryMemSwapPlan() const;
+
   void AddKernelExecutionPerform(const AnfNodePtr &kernel, float perform);
 
   float QueryKernelExecutionPerform(const AnfNodePtr &kernel) const;
@@ -154,6 +168,7 @@ class MemSwapManager {
   size_t tensor_size_num_;
   size_t distance_threshold_;
   size_t distance_decay_step_;
+  size_t prefetch_lookahead_{1};
 
   MemCopyManagerPtr mem_copy_manager_{nullptr};
   const mindspore::session::KernelGraph *kernel_graph_{nullptr};
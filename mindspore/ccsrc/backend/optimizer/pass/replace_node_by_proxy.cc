@@ -72,6 +72,11 @@ bool ReplaceNodeByProxy::Run(const FuncGraphPtr &func_graph) {
       AbstractBasePtrList abstract_list;
       AnfAlgo::CopyNodeAttr(kAttrPsKey, cnode, proxy_node);
       AnfAlgo::CopyNodeAttr("offset", cnode, proxy_node);
+      for (const auto &cache_attr : {kAttrCacheSize, kAttrCachePolicy, kAttrCacheStaleness}) {
+        if (AnfAlgo::HasNodeAttr(cache_attr, cnode)) {
+          AnfAlgo::CopyNodeAttr(cache_attr, cnode, proxy_node);
+        }
+      }
       abstract_list.push_back(cnode->abstract());
       auto abstract_tuple = std::make_shared<abstract::AbstractTuple>(abstract_list);
       MS_EXCEPTION_IF_NULL(abstract_tuple);
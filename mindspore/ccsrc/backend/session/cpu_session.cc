@@ -17,6 +17,7 @@
 #include "backend/session/cpu_session.h"
 #include <algorithm>
 #include <sstream>
+#include <string>
 #include "ir/tensor.h"
 #include "ir/anf.h"
 #include "backend/kernel_compiler/kernel.h"
@@ -28,6 +29,11 @@
 #include "backend/optimizer/common/optimizer.h"
 #include "backend/optimizer/common/pass_manager.h"
 #include "backend/optimizer/pass/replace_node_by_proxy.h"
+#include "backend/optimizer/cpu/elemwise_chain_fusion.h"
+#include "backend/optimizer/cpu/insert_format_transform.h"
+#include "backend/optimizer/cpu/post_ops_fusion.h"
+#include "backend/optimizer/gpu/adam_fusion.h"
+#include "backend/optimizer/gpu/adam_weight_decay_fusion.h"
 #ifdef ENABLE_DEBUGGER
 #include "debug/debugger/debugger.h"
 #endif
@@ -37,6 +43,26 @@
 
 namespace mindspore {
 namespace session {
+namespace {
+// Comma separated names of the CPU fusions to turn off, "all" turns off every one of them.
+constexpr auto kEnvDisableFusion = "MS_CPU_DISABLE_FUSION";
+constexpr auto kFusionConv2DPostOps = "conv2d_post_ops";
+constexpr auto kFusionMatMulPostOps = "matmul_post_ops";
+constexpr auto kFusionElemwiseChain = "elemwise_chain";
+constexpr auto kFusionAdam = "adam";
+
+bool IsFusionEnabled(const std::string &fusion_name) {
+  std::stringstream disabled(common::GetEnv(kEnvDisableFusion));
+  std::string name;
+  while (std::getline(disabled, name, ',')) {
+    if (name == "all" || name == fusion_name) {
+      return false;
+    }
+  }
+  return true;
+}
+}  // namespace
+
 ParameterPtr CPUSession::CreateNewParameterFromParameter(const AnfNodePtr &anf, bool valid_input, KernelGraph *graph) {
   MS_EXCEPTION_IF_NULL(anf);
   MS_EXCEPTION_IF_NULL(graph);
@@ -55,6 +81,41 @@ ParameterPtr CPUSession::CreateNewParameterFromParameter(const AnfNodePtr &anf,
   return new_parameter;
 }
 
+// The fusions run before the kernels are selected, the fused nodes then pick their kernels like any other node.
+void CPUSession::FusionOptimize(const std::shared_ptr<KernelGraph> &kernel_graph) {
+  MS_EXCEPTION_IF_NULL(kernel_graph);
+  auto optimizer = std::make_shared<opt::GraphOptimizer>();
+  auto pm = std::make_shared<opt::PassManager>("cpu_fusion_pm");
+  if (IsFusionEnabled(kFusionAdam)) {
+    pm->AddPass(std::make_shared<opt::AdamWeightDecayFusion>());
+    pm->AddPass(std::make_shared<opt::AdamFusion>());
+  }
+  if (IsFusionEnabled(kFusionConv2DPostOps)) {
+    pm->AddPass(std::make_shared<opt::Conv2DBiasAddFusion>());
+    pm->AddPass(std::make_shared<opt::Conv2DReluFusion>());
+  }
+  if (IsFusionEnabled(kFusionMatMulPostOps)) {
+    pm->AddPass(std::make_shared<opt::MatMulBiasAddFusion>());
+    pm->AddPass(std::make_shared<opt::MatMulReluFusion>());
+  }
+  if (IsFusionEnabled(kFusionElemwiseChain)) {
+    pm->AddPass(std::make_shared<opt::ElemwiseChainFusion>());
+  }
+  optimizer->AddPassManager(pm);
+  (void)optimizer->Optimize(kernel_graph);
+  kernel_graph->SetExecOrderByDefault();
+}
+
+// Runs after the kernels are selected, to reorder the data between the formats the kernels picked.
+void CPUSession::FormatOptimize(const std::shared_ptr<KernelGraph> &kernel_graph) {
+  MS_EXCEPTION_IF_NULL(kernel_graph);
+  auto optimizer = std::make_shared<opt::GraphOptimizer>();
+  auto pm = std::make_shared<opt::PassManager>("cpu_format_pm");
+  pm->AddPass(std::make_shared<opt::InsertFormatTransform>());
+  optimizer->AddPassManager(pm);
+  (void)optimizer->Optimize(kernel_graph);
+}
+
 void CPUSession::Optimize(const std::shared_ptr<KernelGraph> &kernel_graph) {
   auto optimizer = std::make_shared<opt::GraphOptimizer>();
   auto pm = std::make_shared<opt::PassManager>();
@@ -69,9 +130,30 @@ void CPUSession::Optimize(const std::shared_ptr<KernelGraph> &kernel_graph) {
 GraphId CPUSession::CompileGraph(const AnfNodePtrList &lst, const AnfNodePtrList &outputs) {
   auto graph_id = graph_sum_;
   auto graph = ConstructKernelGraph(lst, outputs);
+  BuildGraph(graph);
+  return graph_id;
+}
+
+// Used by the inference session, which loads a whole model graph without control flow.
+GraphId CPUSession::CompileGraph(NotNull<FuncGraphPtr> func_graph) {
+  std::vector<KernelGraphPtr> all_graphs;
+  auto graph = ConstructKernelGraph(func_graph, &all_graphs);
   MS_EXCEPTION_IF_NULL(graph);
+  if (all_graphs.size() != 1) {
+    MS_LOG(EXCEPTION) << "CPU session only supports the graph without control flow, but got " << all_graphs.size()
+                      << " graphs.";
+  }
+  BuildGraph(graph);
+  return graph->graph_id();
+}
+
+void CPUSession::BuildGraph(const KernelGraphPtr &graph) {
+  MS_EXCEPTION_IF_NULL(graph);
+  MS_LOG(INFO) << "Fusion optimize";
+  FusionOptimize(graph);
   MS_LOG(INFO) << "Set kernel info";
   SetKernelInfo(graph.get());
+  FormatOptimize(graph);
 #if (ENABLE_CPU && (ENABLE_D || ENABLE_GPU))
   AssignParamKey(graph);
   if (parallel::ps::Util::IsRoleOfWorker()) {
@@ -82,7 +164,46 @@ GraphId CPUSession::CompileGraph(const AnfNodePtrList &lst, const AnfNodePtrList
   BuildKernel(graph.get());
   MS_LOG(INFO) << "Assign kernel address";
   runtime_.AssignKernelAddress(graph.get());
-  return graph_id;
+}
+
+bool CPUSession::CheckModelInputs(uint32_t graph_id, const std::vector<tensor::TensorPtr> &inputs,
+                                  std::string *error_msg) const {
+  auto kernel_graph = GetGraph(graph_id);
+  MS_EXCEPTION_IF_NULL(kernel_graph);
+  std::vector<AnfNodePtr> paras;
+  for (const auto &input : kernel_graph->inputs()) {
+    MS_EXCEPTION_IF_NULL(input);
+    if (input->isa<Parameter>() && !AnfAlgo::IsParameterWeight(input->cast<ParameterPtr>())) {
+      paras.push_back(input);
+    }
+  }
+  std::ostringstream error;
+  if (paras.size() != inputs.size()) {
+    error << "Input number is inconsistent. The given input number [" << inputs.size()
+          << "] but the graph input number is [" << paras.size() << "]";
+  } else {
+    for (size_t i = 0; i < paras.size(); ++i) {
+      MS_EXCEPTION_IF_NULL(inputs[i]);
+      auto para_shape = AnfAlgo::GetOutputInferShape(paras[i], 0);
+      auto input_shape = inputs[i]->shape();
+      bool same_shape = para_shape.size() == input_shape.size() &&
+                        std::equal(para_shape.begin(), para_shape.end(), input_shape.begin(),
+                                   [](size_t para_dim, int input_dim) { return para_dim == IntToSize(input_dim); });
+      if (!same_shape || inputs[i]->data_type() != AnfAlgo::GetOutputInferDataType(paras[i], 0)) {
+        error << "The shape or data type of input " << i << " is inconsistent with the parameter "
+              << paras[i]->DebugString();
+        break;
+      }
+    }
+  }
+  if (error.tellp() == 0) {
+    return true;
+  }
+  MS_LOG(ERROR) << error.str();
+  if (error_msg != nullptr) {
+    *error_msg = error.str();
+  }
+  return false;
 }
 
 void CPUSession::RunGraph(const GraphId &graph_id, const std::vector<tensor::TensorPtr> &inputs, VectorRef *outputs) {
@@ -137,9 +258,13 @@ void CPUSession::RunGraph(const GraphId &graph_id, const std::vector<tensor::Ten
 void CPUSession::SetKernelInfo(const KernelGraph *kernel_graph) {
   MS_EXCEPTION_IF_NULL(kernel_graph);
   auto &kernel_nodes = kernel_graph->execution_order();
+  bool blocked_format = device::cpu::IsBlockedFormatEnabled();
   for (const auto &kernel_node : kernel_nodes) {
     MS_EXCEPTION_IF_NULL(kernel_node);
     device::cpu::SetKernelInfo(kernel_node);
+    if (blocked_format) {
+      device::cpu::SetBlockedFormat(kernel_node);
+    }
   }
 }
 
@@ -33,13 +33,20 @@ class CPUSession : public SessionBasic {
     context_ = std::make_shared<Context>(kCPUDevice, device_id);
   }
   GraphId CompileGraph(const AnfNodePtrList &lst, const AnfNodePtrList &outputs) override;
+  GraphId CompileGraph(NotNull<FuncGraphPtr> func_graph) override;
   void RunGraph(const GraphId &graph_id, const std::vector<tensor::TensorPtr> &inputs, VectorRef *outputs) override;
+  // The kernels are built for the shapes the graph was compiled with, inputs of other shapes are rejected.
+  bool CheckModelInputs(uint32_t graph_id, const std::vector<tensor::TensorPtr> &inputs,
+                        std::string *error_msg) const override;
 
  protected:
   ParameterPtr CreateNewParameterFromParameter(const AnfNodePtr &anf, bool valid_input, KernelGraph *graph) override;
+  void FusionOptimize(const std::shared_ptr<KernelGraph> &kernel_graph);
+  void FormatOptimize(const std::shared_ptr<KernelGraph> &kernel_graph);
   void Optimize(const std::shared_ptr<KernelGraph> &kernel_graph);
 
  private:
+  void BuildGraph(const KernelGraphPtr &graph);
   void SetKernelInfo(const KernelGraph *kernel_graph);
   void BuildKernel(const KernelGraph *kernel_graph);
   device::cpu::CPUKernelRuntime runtime_;
@@ -332,8 +332,10 @@ std::vector<tensor::TensorPtr> MSInferSession::RunGraph(uint32_t graph_id,
 string MSInferSession::AjustTargetName(const std::string &device) {
   if (device == kAscendDevice) {
     return std::string(kAscendDevice) + "Inference";
+  } else if (device == kCPUDevice) {
+    return kCPUDevice;
   } else {
-    MS_LOG(ERROR) << "Only support device Ascend right now";
+    MS_LOG(ERROR) << "Only support device Ascend and CPU right now";
     return "";
   }
 }
@@ -0,0 +1,120 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "common/thread_pool.h"
+#include <algorithm>
+
+namespace mindspore {
+namespace common {
+ThreadPool::ThreadPool(size_t thread_num) {
+  threads_.reserve(thread_num);
+  for (size_t i = 0; i < thread_num; i++) {
+    threads_.emplace_back(&ThreadPool::WorkerLoop, this);
+  }
+}
+
+ThreadPool::~ThreadPool() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+  cv_.notify_all();
+  for (auto &thread : threads_) {
+    thread.join();
+  }
+}
+
+ThreadPool &ThreadPool::GetInstance() {
+  static ThreadPool instance(std::max(std::thread::hardware_concurrency(), 1U));
+  return instance;
+}
+
+void ThreadPool::RunItem(const Item &item) {
+  try {
+    (*item.task)();
+  } catch (...) {
+    std::lock_guard<std::mutex> lock(item.batch->mutex);
+    if (item.batch->exception == nullptr) {
+      item.batch->exception = std::current_exception();
+    }
+  }
+  std::lock_guard<std::mutex> lock(item.batch->mutex);
+  if (--item.batch->remaining == 0) {
+    item.batch->cv.notify_all();
+  }
+}
+
+void ThreadPool::WorkerLoop() {
+  while (true) {
+    Item item;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      cv_.wait(lock, [this] { return stop_ || !queue_.empty(); });
+      if (queue_.empty()) {
+        return;
+      }
+      item = queue_.front();
+      queue_.pop_front();
+    }
+    RunItem(item);
+  }
+}
+
+void ThreadPool::SyncRun(const std::vector<Task> &tasks) {
+  if (tasks.empty()) {
+    return;
+  }
+  if (tasks.size() == 1 || threads_.empty()) {
+    for (const auto &task : tasks) {
+      task();
+    }
+    return;
+  }
+  auto batch = std::make_shared<Batch>();
+  batch->remaining = tasks.size();
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (const auto &task : tasks) {
+      queue_.push_back({&task, batch});
+    }
+  }
+  cv_.notify_all();
+
+  // Help with the queued tasks instead of idling, they may belong to this batch or to another caller.
+  while (true) {
+    Item item;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (queue_.empty()) {
+        break;
+      }
+      item = queue_.front();
+      queue_.pop_front();
+    }
+    RunItem(item);
+    std::lock_guard<std::mutex> lock(batch->mutex);
+    if (batch->remaining == 0) {
+      break;
+    }
+  }
+  std::unique_lock<std::mutex> lock(batch->mutex);
+  batch->cv.wait(lock, [&batch] { return batch->remaining == 0; });
+  if (batch->exception != nullptr) {
+    std::rethrow_exception(batch->exception);
+  }
+}
+}  // namespace common
+}  // namespace mindspore
@@ -0,0 +1,74 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_COMMON_THREAD_POOL_H_
+#define MINDSPORE_CCSRC_COMMON_THREAD_POOL_H_
+
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace mindspore {
+namespace common {
+using Task = std::function<void()>;
+
+// A fixed set of threads which run batches of tasks, the caller of SyncRun waits until its whole batch is finished.
+// The caller also runs queued tasks while waiting, so a SyncRun issued from inside a task can not deadlock the pool.
+class ThreadPool {
+ public:
+  explicit ThreadPool(size_t thread_num);
+  ~ThreadPool();
+  ThreadPool(const ThreadPool &) = delete;
+  ThreadPool &operator=(const ThreadPool &) = delete;
+
+  // The pool shared by the kernels of a process, it has one thread per hardware thread.
+  static ThreadPool &GetInstance();
+
+  // Run the tasks and return when all of them finished. If a task throws, the first exception is rethrown here after
+  // the other tasks of the batch finished.
+  void SyncRun(const std::vector<Task> &tasks);
+  size_t thread_num() const { return threads_.size(); }
+
+ private:
+  struct Batch {
+    std::mutex mutex;
+    std::condition_variable cv;
+    size_t remaining{0};
+    std::exception_ptr exception;
+  };
+  struct Item {
+    const Task *task;
+    std::shared_ptr<Batch> batch;
+  };
+
+  void WorkerLoop();
+  static void RunItem(const Item &item);
+
+  std::vector<std::thread> threads_;
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  std::deque<Item> queue_;
+  bool stop_{false};
+};
+}  // namespace common
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_COMMON_THREAD_POOL_H_
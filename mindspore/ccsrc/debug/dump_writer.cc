@@ -0,0 +1,208 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "debug/dump_writer.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <utility>
+#include "debug/common.h"
+#include "utils/log_adapter.h"
+#include "utils/system/lz4.h"
+
+namespace mindspore {
+DumpWriter &DumpWriter::GetInstance() {
+  static DumpWriter instance;
+  return instance;
+}
+
+DumpWriter::~DumpWriter() {
+  Flush();
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+  not_empty_.notify_all();
+  if (writer_.joinable()) {
+    writer_.join();
+  }
+}
+
+void DumpWriter::Configure(bool async, bool compress, size_t staging_bytes) {
+  Flush();
+  std::lock_guard<std::mutex> lock(mutex_);
+  async_ = async;
+  compress_ = compress;
+  staging_limit_ = staging_bytes;
+  free_buffers_.clear();
+  free_bytes_ = 0;
+  MS_LOG(INFO) << "E2E dump writer async: " << async_ << ", compress: " << compress_
+               << ", staging bytes: " << staging_limit_;
+}
+
+std::vector<char> DumpWriter::AcquireBuffer(size_t len) {
+  // Take the smallest free buffer that fits, or the largest one to grow if none fits.
+  auto best = free_buffers_.end();
+  for (auto iter = free_buffers_.begin(); iter != free_buffers_.end(); ++iter) {
+    if (best == free_buffers_.end()) {
+      best = iter;
+      continue;
+    }
+    bool fits = iter->capacity() >= len;
+    bool best_fits = best->capacity() >= len;
+    if ((fits && (!best_fits || iter->capacity() < best->capacity())) ||
+        (!fits && !best_fits && iter->capacity() > best->capacity())) {
+      best = iter;
+    }
+  }
+  if (best == free_buffers_.end()) {
+    return std::vector<char>();
+  }
+  std::vector<char> buffer = std::move(*best);
+  free_bytes_ -= buffer.capacity();
+  (void)free_buffers_.erase(best);
+  return buffer;
+}
+
+void DumpWriter::ReleaseBuffer(std::vector<char> &&buffer) {
+  if (free_bytes_ + buffer.capacity() > staging_limit_) {
+    return;
+  }
+  free_bytes_ += buffer.capacity();
+  buffer.clear();
+  free_buffers_.push_back(std::move(buffer));
+}
+
+bool DumpWriter::Enqueue(const std::string &filename, const void *data, size_t len) {
+  if (filename.empty() || data == nullptr || len == 0) {
+    MS_LOG(ERROR) << "Incorrect parameter.";
+    return false;
+  }
+  auto pos = filename.find_last_of('/');
+  DumpItem item;
+  item.dir = pos == std::string::npos ? "." : filename.substr(0, pos);
+  item.name = pos == std::string::npos ? filename : filename.substr(pos + 1);
+
+  std::unique_lock<std::mutex> lock(mutex_);
+  // A tensor larger than the whole pool is still accepted once the pool is empty.
+  not_full_.wait(lock, [this, len]() { return staging_bytes_ == 0 || staging_bytes_ + len <= staging_limit_; });
+  staging_bytes_ += len;
+  item.data = AcquireBuffer(len);
+  // The copy is done outside the lock, the writer thread only needs the lock to pop the queue.
+  lock.unlock();
+  item.data.resize(len);
+  (void)memcpy(item.data.data(), data, len);
+  lock.lock();
+  queue_.push_back(std::move(item));
+  if (!writer_.joinable()) {
+    writer_ = std::thread(&DumpWriter::WriterLoop, this);
+  }
+  lock.unlock();
+  not_empty_.notify_one();
+  return true;
+}
+
+void DumpWriter::Flush() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  drained_.wait(lock, [this]() { return queue_.empty() && !writing_; });
+}
+
+void DumpWriter::WriterLoop() {
+  std::vector<DumpItem> batch;
+  bool compress = false;
+  while (true) {
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      not_empty_.wait(lock, [this]() { return stop_ || !queue_.empty(); });
+      if (queue_.empty()) {
+        return;
+      }
+      // Take everything queued so far, the tensors of one step are written with one open of each file.
+      batch.clear();
+      std::move(queue_.begin(), queue_.end(), std::back_inserter(batch));
+      queue_.clear();
+      compress = compress_;
+      writing_ = true;
+    }
+    WriteBatch(&batch, compress);
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      for (auto &item : batch) {
+        staging_bytes_ -= item.data.size();
+        ReleaseBuffer(std::move(item.data));
+      }
+      writing_ = false;
+    }
+    not_full_.notify_all();
+    drained_.notify_all();
+  }
+}
+
+void DumpWriter::WriteBatch(std::vector<DumpItem> *batch, bool compress) {
+  std::map<std::string, std::vector<DumpItem *>> dirs;
+  for (auto &item : *batch) {
+    dirs[item.dir].push_back(&item);
+  }
+  for (const auto &dir : dirs) {
+    if (!WriteDir(dir.first, dir.second, compress)) {
+      MS_LOG(ERROR) << "Write " << dir.second.size() << " dump tensors to " << dir.first << " failed.";
+    }
+  }
+}
+
+bool DumpWriter::WriteDir(const std::string &dir, const std::vector<DumpItem *> &items, bool compress) {
+  auto data_path = Common::GetRealPath(dir + "/" + kDataFileName);
+  auto index_path = Common::GetRealPath(dir + "/" + kIndexFileName);
+  if (!data_path.has_value() || !index_path.has_value()) {
+    MS_LOG(ERROR) << "Get real path failed, dir: " << dir;
+    return false;
+  }
+  // The files of a directory are truncated the first time this process writes to it.
+  auto size_iter = data_sizes_.find(dir);
+  bool first_write = size_iter == data_sizes_.end();
+  auto mode = std::ios::binary | std::ios::out | (first_write ? std::ios::trunc : std::ios::app);
+  std::ofstream data_file(data_path.value(), mode);
+  std::ofstream index_file(index_path.value(), mode);
+  if (!data_file.is_open() || !index_file.is_open()) {
+    MS_LOG(ERROR) << "Open file " << data_path.value() << " or " << index_path.value() << " failed.";
+    return false;
+  }
+  uint64_t offset = first_write ? 0 : size_iter->second;
+  for (auto item : items) {
+    const char *stored = item->data.data();
+    size_t stored_size = item->data.size();
+    const char *codec = "none";
+    if (compress) {
+      compress_buffer_.clear();
+      size_t compressed_size = system::Lz4::Compress(item->data.data(), item->data.size(), &compress_buffer_);
+      // Keep the raw bytes of incompressible tensors.
+      if (compressed_size < item->data.size()) {
+        stored = compress_buffer_.data();
+        stored_size = compressed_size;
+        codec = "lz4";
+      }
+    }
+    (void)data_file.write(stored, static_cast<std::streamsize>(stored_size));
+    index_file << item->name << " " << offset << " " << stored_size << " " << item->data.size() << " " << codec
+               << "\n";
+    offset += stored_size;
+  }
+  data_sizes_[dir] = offset;
+  data_file.close();
+  index_file.close();
+  return data_file.good() && index_file.good();
+}
+}  // namespace mindspore
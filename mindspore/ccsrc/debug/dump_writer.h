@@ -0,0 +1,91 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_DEBUG_DUMP_WRITER_H_
+#define MINDSPORE_CCSRC_DEBUG_DUMP_WRITER_H_
+
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace mindspore {
+// Writes the e2e dump tensors from a background thread, so the launch path only pays for one host copy into the
+// staging pool. All tensors dumped into one directory (one directory per net and iteration) are appended to
+// dump_data.bin, and dump_index.txt next to it has one line per tensor:
+//   <file name> <offset> <stored size> <raw size> <codec>
+// where codec is "none" or "lz4" (LZ4 block format).
+class DumpWriter {
+ public:
+  static DumpWriter &GetInstance();
+
+  // staging_bytes bounds the host memory held by queued tensors, Enqueue blocks while the pool is full.
+  void Configure(bool async, bool compress, size_t staging_bytes);
+  bool async() const { return async_; }
+  bool compress() const { return compress_; }
+
+  // Copy data into the staging pool and return, filename is the path the synchronous dump would have written.
+  bool Enqueue(const std::string &filename, const void *data, size_t len);
+  // Block until every queued tensor has been written.
+  void Flush();
+
+  static constexpr const char *kDataFileName = "dump_data.bin";
+  static constexpr const char *kIndexFileName = "dump_index.txt";
+
+ private:
+  struct DumpItem {
+    std::string dir;
+    std::string name;
+    std::vector<char> data;
+  };
+
+  DumpWriter() = default;
+  ~DumpWriter();
+  DumpWriter(const DumpWriter &) = delete;
+  DumpWriter &operator=(const DumpWriter &) = delete;
+
+  void WriterLoop();
+  void WriteBatch(std::vector<DumpItem> *batch, bool compress);
+  bool WriteDir(const std::string &dir, const std::vector<DumpItem *> &items, bool compress);
+  std::vector<char> AcquireBuffer(size_t len);
+  void ReleaseBuffer(std::vector<char> &&buffer);
+
+  bool async_{false};
+  bool compress_{false};
+  size_t staging_limit_{0};
+
+  std::mutex mutex_;
+  std::condition_variable not_empty_;
+  std::condition_variable not_full_;
+  std::condition_variable drained_;
+  std::deque<DumpItem> queue_;
+  // Buffers of written tensors kept for reuse, their total capacity is at most staging_limit_.
+  std::vector<std::vector<char>> free_buffers_;
+  size_t free_bytes_{0};
+  // Bytes of the tensors queued or being written.
+  size_t staging_bytes_{0};
+  bool writing_{false};
+  bool stop_{false};
+  std::thread writer_;
+
+  // Only touched by the writer thread: the bytes already written to the data file of each directory.
+  std::map<std::string, uint64_t> data_sizes_;
+  std::vector<char> compress_buffer_;
+};
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_DEBUG_DUMP_WRITER_H_
@@ -25,10 +25,16 @@
 #include "utils/convert_utils.h"
 #include "utils/ms_context.h"
 #include "debug/common.h"
+#include "debug/dump_writer.h"
 
 using json = nlohmann::json;
 
 namespace mindspore {
+namespace {
+constexpr size_t kDefaultStagingSizeMB = 256;
+constexpr size_t kBytesPerMB = 1024 * 1024;
+}  // namespace
+
 Dump::Dump()
     : dump_enable_(false),
       trans_flag_(false),
@@ -36,12 +42,14 @@ Dump::Dump()
       dump_net_name_("net_name"),
       dump_mode_(0),
       dump_iter_(0),
-      cur_iter_(0) {}
+      cur_iter_(0),
+      dump_iter_interval_(0),
+      has_kernel_regex_(false) {}
 
 bool Dump::IsKernelNeedDump(const std::string &kernel_name) {
   if (dump_mode_ == 0) {
-    // Dump All Kernels mode
-    return true;
+    // Dump All Kernels mode, optionally narrowed by kernel_regex
+    return !has_kernel_regex_ || std::regex_search(kernel_name, kernel_regex_);
   } else {
     auto iter = std::find(dump_kernels_.begin(), dump_kernels_.end(), kernel_name);
     if (iter != dump_kernels_.end()) {
@@ -51,6 +59,16 @@ bool Dump::IsKernelNeedDump(const std::string &kernel_name) {
   return false;
 }
 
+bool Dump::IsIterNeedDump(uint32_t iter) const {
+  if (dump_iter_ != 0) {
+    return iter == dump_iter_;
+  }
+  if (dump_iter_interval_ > 1) {
+    return iter % dump_iter_interval_ == 0;
+  }
+  return true;
+}
+
 bool Dump::ParseDumpConfig(const std::string &dump_config_file) {
   std::ifstream jsonFile(dump_config_file);
   if (!jsonFile.is_open()) {
@@ -121,6 +139,70 @@ bool Dump::IsConfigValid(const nlohmann::json &dumpSettings) {
   for (const auto &kernel : kernels) {
     dump_kernels_.push_back(kernel);
   }
+  return ParseOptionalConfig(dumpSettings);
+}
+
+bool Dump::ParseOptionalConfig(const nlohmann::json &dumpSettings) {
+  bool async = false;
+  bool compress = false;
+  size_t staging_size_mb = kDefaultStagingSizeMB;
+  auto iter = dumpSettings.find("async");
+  if (iter != dumpSettings.end()) {
+    if (!iter->is_boolean()) {
+      MS_LOG(ERROR) << "Dump config async should be a bool.";
+      dump_enable_ = false;
+      return false;
+    }
+    async = *iter;
+  }
+  iter = dumpSettings.find("compress");
+  if (iter != dumpSettings.end()) {
+    if (!iter->is_string() || (*iter != "none" && *iter != "lz4")) {
+      MS_LOG(ERROR) << "Dump config compress should be \"none\" or \"lz4\".";
+      dump_enable_ = false;
+      return false;
+    }
+    compress = *iter == "lz4";
+  }
+  iter = dumpSettings.find("staging_size_mb");
+  if (iter != dumpSettings.end()) {
+    if (!iter->is_number_unsigned() || *iter == 0) {
+      MS_LOG(ERROR) << "Dump config staging_size_mb should be a positive integer.";
+      dump_enable_ = false;
+      return false;
+    }
+    staging_size_mb = *iter;
+  }
+  iter = dumpSettings.find("iteration_interval");
+  if (iter != dumpSettings.end()) {
+    if (!iter->is_number_unsigned()) {
+      MS_LOG(ERROR) << "Dump config iteration_interval should be a non-negative integer.";
+      dump_enable_ = false;
+      return false;
+    }
+    dump_iter_interval_ = *iter;
+  }
+  iter = dumpSettings.find("kernel_regex");
+  if (iter != dumpSettings.end()) {
+    if (!iter->is_string()) {
+      MS_LOG(ERROR) << "Dump config kernel_regex should be a string.";
+      dump_enable_ = false;
+      return false;
+    }
+    std::string pattern = *iter;
+    try {
+      kernel_regex_ = std::regex(pattern);
+    } catch (const std::regex_error &e) {
+      MS_LOG(ERROR) << "Dump config kernel_regex " << pattern << " is invalid: " << e.what();
+      dump_enable_ = false;
+      return false;
+    }
+    has_kernel_regex_ = !pattern.empty();
+  }
+  if (compress && !async) {
+    MS_LOG(WARNING) << "Dump config compress only takes effect when async is true.";
+  }
+  DumpWriter::GetInstance().Configure(async && dump_enable_, compress, staging_size_mb * kBytesPerMB);
   return true;
 }
 
@@ -154,11 +236,17 @@ bool Dump::SetDumpConfFromJsonFile() {
   return ParseDumpConfig(dump_config_file);
 }
 
+void Dump::Flush() { DumpWriter::GetInstance().Flush(); }
+
 bool Dump::DumpToFile(const std::string &filename, const void *data, size_t len) {
   if (filename.empty() || data == nullptr || len == 0) {
     MS_LOG(ERROR) << "Incorrect parameter.";
     return false;
   }
+  auto &writer = DumpWriter::GetInstance();
+  if (writer.async()) {
+    return writer.Enqueue(filename, data, len);
+  }
 
   auto realpath = Common::GetRealPath(filename);
   if (!realpath.has_value()) {
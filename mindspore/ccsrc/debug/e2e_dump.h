@@ -20,6 +20,7 @@
 #include <vector>
 #include <iostream>
 #include <memory>
+#include <regex>
 #include <nlohmann/json.hpp>
 
 namespace mindspore {
@@ -45,9 +46,14 @@ class Dump {
 
   bool IsKernelNeedDump(const std::string &kernel_name);
 
+  bool IsIterNeedDump(uint32_t iter) const;
+
   bool SetDumpConfFromJsonFile();
 
   static bool DumpToFile(const std::string &filename, const void *data, size_t len);
+  // Block until the tensors queued by an async dump are written. Not called per step, which would stall
+  // training; the bounded staging pool throttles the steps instead.
+  static void Flush();
 
  protected:
   bool dump_enable_;
@@ -58,11 +64,15 @@ class Dump {
   uint32_t dump_iter_;
   uint32_t cur_iter_;
   std::vector<std::string> dump_kernels_;
+  uint32_t dump_iter_interval_;
+  bool has_kernel_regex_;
+  std::regex kernel_regex_;
 
  private:
   bool ParseDumpConfig(const std::string &dump_config_file);
   bool IsConfigExist(const nlohmann::json &dumpSettings);
   bool IsConfigValid(const nlohmann::json &dumpSettings);
+  bool ParseOptionalConfig(const nlohmann::json &dumpSettings);
 };
 
 using DumpConfPtr = std::shared_ptr<Dump>;
@@ -17,8 +17,9 @@
  */
 
 #include "frontend/optimizer/cse.h"
+#include <algorithm>
+#include <numeric>
 #include <vector>
-#include <set>
 #include <unordered_map>
 #include "./common.h"
 
@@ -45,55 +46,86 @@ BasePtr AbsOf(const AnfNodePtr &node) {
   return node_abs;
 }
 
-bool CSE::BuildOrderGroupAndDoReplace(const FuncGraphManagerPtr manager) const {
-  bool changed = false;
-  for (FuncGraphPtr fg : manager->func_graphs()) {
-    MS_EXCEPTION_IF_NULL(fg);
-    std::vector<std::size_t> order_group;
-    std::unordered_map<std::size_t, std::vector<AnfNodePtr>> groups;
-    std::unordered_map<AnfNodePtr, std::size_t> hashes;
+namespace {
+// Tensor constants of one shape share the hash of their meta data, so their hash also takes up to this many bytes from
+// each end of the data. CheckReplace compares tensor inputs by value, and equal tensors get equal hashes.
+constexpr size_t kTensorHashBytes = 64;
 
-    std::vector<AnfNodePtr> toposet = TopoSort(fg->get_return());
-    for (auto node : toposet) {
-      MS_EXCEPTION_IF_NULL(node);
-      if (hashes.find(node) != hashes.end()) {
-        continue;
-      }
-
-      std::size_t h = 0;
-      if (node->isa<ValueNode>()) {
-        ValueNodePtr value_node = node->cast<ValueNodePtr>();
-        auto value = value_node->value();
-        MS_EXCEPTION_IF_NULL(value);
-        h = hash_combine(value->hash(), (AbsOf(value_node)->hash()));
-      } else if (node->isa<CNode>()) {
-        auto cnode = node->cast<CNodePtr>();
-        auto &inputs = cnode->inputs();
-        size_t init = 0;
-        h = std::accumulate(inputs.begin(), inputs.end(), init, [&hashes](std::size_t hash, const AnfNodePtr &node_in) {
-          return hash_combine(hash, hashes[node_in]);
-        });
-      } else if (node->isa<Parameter>()) {
-        h = node->hash();
-      } else {
-        MS_LOG(ERROR) << "Unknow node type";
-      }
+std::size_t TensorDataHash(const tensor::Tensor &tensor) {
+  auto data = static_cast<const uint8_t *>(tensor.data().const_data());
+  if (data == nullptr) {
+    return 0;
+  }
+  size_t nbytes = LongToSize(tensor.data().nbytes());
+  size_t head_end = std::min(nbytes, kTensorHashBytes);
+  size_t tail_begin = std::max(head_end, nbytes - std::min(nbytes, kTensorHashBytes));
+  std::size_t h = std::hash<size_t>{}(nbytes);
+  for (size_t i = 0; i < head_end; ++i) {
+    h = hash_combine(h, data[i]);
+  }
+  for (size_t i = tail_begin; i < nbytes; ++i) {
+    h = hash_combine(h, data[i]);
+  }
+  return h;
+}
 
-      hashes[node] = h;
-      if (groups.find(h) == groups.end()) {
-        std::vector<AnfNodePtr> innervec({node});
-        groups[h] = innervec;
-        order_group.emplace_back(h);
-      } else {
-        groups[h].push_back(node);
-      }
+std::size_t NodeHash(const AnfNodePtr &node, const std::unordered_map<AnfNodePtr, std::size_t> &hashes) {
+  std::size_t h = 0;
+  if (node->isa<ValueNode>()) {
+    ValueNodePtr value_node = node->cast<ValueNodePtr>();
+    auto value = value_node->value();
+    MS_EXCEPTION_IF_NULL(value);
+    h = hash_combine(value->hash(), (AbsOf(value_node)->hash()));
+    if (value->isa<tensor::Tensor>()) {
+      h = hash_combine(h, TensorDataHash(*value->cast<tensor::TensorPtr>()));
     }
-
-    changed = DoReplace(manager, order_group, &groups) || changed;
+  } else if (node->isa<CNode>()) {
+    auto cnode = node->cast<CNodePtr>();
+    auto &inputs = cnode->inputs();
+    size_t init = 0;
+    h = std::accumulate(inputs.begin(), inputs.end(), init, [&hashes](std::size_t hash, const AnfNodePtr &node_in) {
+      auto iter = hashes.find(node_in);
+      return hash_combine(hash, iter == hashes.end() ? 0 : iter->second);
+    });
+  } else if (node->isa<Parameter>()) {
+    h = node->hash();
+  } else {
+    MS_LOG(ERROR) << "Unknow node type";
   }
+  return h;
+}
+}  // namespace
 
+bool CSE::HashConsFuncGraph(const FuncGraphManagerPtr &manager, const FuncGraphPtr &fg,
+                            std::unordered_map<AnfNodePtr, std::size_t> *hashes) const {
+  MS_EXCEPTION_IF_NULL(hashes);
+  bool changed = false;
+  // The kept nodes of each hash, a node replaced by an equal one keeps the hash it was stored with, so the hashes of
+  // its users stay valid and nothing is hashed twice.
+  std::unordered_map<std::size_t, std::vector<AnfNodePtr>> kept_nodes;
+  std::vector<AnfNodePtr> toposet = TopoSort(fg->get_return());
+  for (auto &node : toposet) {
+    MS_EXCEPTION_IF_NULL(node);
+    auto hash_iter = hashes->find(node);
+    if (hash_iter == hashes->end()) {
+      hash_iter = hashes->emplace(node, NodeHash(node, *hashes)).first;
+    }
+    auto &same_hash_nodes = kept_nodes[hash_iter->second];
+    auto main_iter =
+      std::find_if(same_hash_nodes.begin(), same_hash_nodes.end(), [this, &node](const AnfNodePtr &main) {
+        return main->func_graph() == node->func_graph() && CheckReplace(node, main);
+      });
+    if (main_iter == same_hash_nodes.end()) {
+      same_hash_nodes.push_back(node);
+      continue;
+    }
+    if (manager->Replace(node, *main_iter)) {
+      changed = true;
+    }
+  }
   return changed;
 }
+
 // The op like print, summary, or the op do not has true output, and always as a depend node input.
 static bool HasSideEffect(const AnfNodePtr &node) {
   auto prim = GetCNodePrimitive(node);
@@ -178,59 +210,17 @@ bool CSE::CheckReplace(const AnfNodePtr &main, const AnfNodePtr &node, bool chec
   return false;
 }
 
-bool CSE::DoReplace(const FuncGraphManagerPtr manager, const std::vector<std::size_t> &order_group,
-                    std::unordered_map<std::size_t, std::vector<AnfNodePtr>> *groups) const {
-  bool changes = false;
-  std::set<size_t> clear_set;
-  for (auto &h : order_group) {
-    std::vector<AnfNodePtr> &group = (*groups)[h];
-    // If there are more than 2 node in that group, they may be same common expression can be eliminated.
-    if (group.size() > 1) {
-      for (size_t k = 0; k < group.size() - 1; k++) {
-        AnfNodePtr main = group[k];
-        MS_EXCEPTION_IF_NULL(main);
-
-        // When all node in group has been replaced
-        // or a valuenode node, skip compare in group
-        if ((k + 1 + clear_set.size() == group.size()) || (k > 0 && main->isa<ValueNode>())) {
-          break;
-        }
-
-        // skip node has been replaced
-        if (clear_set.find(k) != clear_set.end()) {
-          continue;
-        }
-
-        // Compare with rest elements in this group.
-        for (size_t i = k + 1; i < group.size(); i++) {
-          auto node = group[i];
-          MS_EXCEPTION_IF_NULL(node);
-
-          if (clear_set.find(i) != clear_set.end()) {
-            continue;
-          }
-          if (main->func_graph() != node->func_graph()) {
-            continue;
-          }
-          if (CheckReplace(node, main)) {
-            changes = true;
-            (void)manager->Replace(node, main);
-            (void)clear_set.insert(i);
-          }
-        }
-      }
-      clear_set.clear();
-    }
-  }
-
-  return changes;
-}
-
 bool CSE::Cse(const FuncGraphPtr root, const FuncGraphManagerPtr manager) const {
   MS_EXCEPTION_IF_NULL(manager);
   manager->AddFuncGraph(root);
 
-  return BuildOrderGroupAndDoReplace(manager);
+  bool changed = false;
+  std::unordered_map<AnfNodePtr, std::size_t> hashes;
+  for (FuncGraphPtr fg : manager->func_graphs()) {
+    MS_EXCEPTION_IF_NULL(fg);
+    changed = HashConsFuncGraph(manager, fg, &hashes) || changed;
+  }
+  return changed;
 }
 }  // namespace opt
 }  // namespace mindspore
@@ -48,9 +48,11 @@ class CSE {
   bool Cse(const FuncGraphPtr root, const FuncGraphManagerPtr manager) const;
 
  private:
-  bool BuildOrderGroupAndDoReplace(const FuncGraphManagerPtr manager) const;
-  bool DoReplace(const FuncGraphManagerPtr manager, const std::vector<std::size_t> &order_group,
-                 std::unordered_map<std::size_t, std::vector<AnfNodePtr>> *groups) const;
+  // Hash consing: the nodes of a graph are visited in topological order and the first node of every class of equal
+  // nodes is kept in a table by its hash, a later node equal to a kept one is replaced by it at once. A node is only
+  // compared with the kept nodes of its hash, so the pass is near linear in the graph size.
+  bool HashConsFuncGraph(const FuncGraphManagerPtr &manager, const FuncGraphPtr &fg,
+                         std::unordered_map<AnfNodePtr, std::size_t> *hashes) const;
   bool report_changes_;
 };
 
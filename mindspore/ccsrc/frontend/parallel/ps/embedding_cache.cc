@@ -0,0 +1,213 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "frontend/parallel/ps/embedding_cache.h"
+#include <algorithm>
+#include "securec/include/securec.h"
+#include "utils/log_adapter.h"
+
+namespace mindspore {
+namespace parallel {
+namespace ps {
+namespace {
+// The access counts are halved once this many accesses per cached row have been counted, so that ids which were hot
+// long ago do not keep their rows forever.
+constexpr uint64_t kFrequencyAgingFactor = 16;
+}  // namespace
+
+EmbeddingCache::EmbeddingCache(size_t row_count, size_t row_size, const EmbeddingCacheConfig &config)
+    : row_count_(row_count), row_size_(row_size), config_(config) {
+  if (row_size_ == 0) {
+    MS_LOG(EXCEPTION) << "The row size of embedding cache must be greater than 0.";
+  }
+  config_.capacity = std::min(config_.capacity, row_count_);
+  rows_.resize(config_.capacity * row_size_);
+  free_slots_.reserve(config_.capacity);
+  for (size_t slot = config_.capacity; slot > 0; slot--) {
+    free_slots_.push_back(slot - 1);
+  }
+  entries_.reserve(config_.capacity);
+}
+
+bool EmbeddingCache::ParsePolicy(const std::string &name, EmbeddingCachePolicy *policy) {
+  MS_EXCEPTION_IF_NULL(policy);
+  if (name == "lru" || name == "LRU") {
+    *policy = kCacheLRU;
+  } else if (name == "lfu" || name == "LFU") {
+    *policy = kCacheLFU;
+  } else {
+    return false;
+  }
+  return true;
+}
+
+void EmbeddingCache::Lookup(const int *ids, size_t id_num, float *output, std::vector<size_t> *missed) {
+  if (id_num == 0) {
+    return;
+  }
+  MS_EXCEPTION_IF_NULL(ids);
+  MS_EXCEPTION_IF_NULL(output);
+  MS_EXCEPTION_IF_NULL(missed);
+  size_t row_bytes = row_size_ * sizeof(float);
+  for (size_t i = 0; i < id_num; i++) {
+    int id = ids[i];
+    if (config_.policy == kCacheLFU) {
+      (void)AddFrequency(id);
+    }
+    auto iter = entries_.find(id);
+    if (iter == entries_.end()) {
+      statistics_.misses++;
+      missed->push_back(i);
+      continue;
+    }
+    uint64_t age = step_ - iter->second.step;
+    if (age > config_.max_staleness) {
+      statistics_.misses++;
+      statistics_.stale_misses++;
+      missed->push_back(i);
+      continue;
+    }
+    auto ret = memcpy_s(output + i * row_size_, row_bytes, rows_.data() + iter->second.slot * row_size_, row_bytes);
+    if (ret != EOK) {
+      MS_LOG(EXCEPTION) << "Embedding cache memcpy failed, errorno(" << ret << ")";
+    }
+    statistics_.hits++;
+    statistics_.max_served_staleness = std::max(statistics_.max_served_staleness, age);
+    Touch(&iter->second);
+  }
+}
+
+void EmbeddingCache::Update(const int *ids, size_t id_num, const float *rows) {
+  if (id_num == 0) {
+    return;
+  }
+  MS_EXCEPTION_IF_NULL(ids);
+  MS_EXCEPTION_IF_NULL(rows);
+  size_t row_bytes = row_size_ * sizeof(float);
+  for (size_t i = 0; i < id_num; i++) {
+    int id = ids[i];
+    // The servers answer ids out of the table with zeros, there is nothing to cache for them.
+    if (id < 0 || static_cast<size_t>(id) >= row_count_) {
+      continue;
+    }
+    size_t slot = 0;
+    auto iter = entries_.find(id);
+    if (iter != entries_.end()) {
+      slot = iter->second.slot;
+      iter->second.step = step_;
+      Touch(&iter->second);
+    } else {
+      if (!Admit(id, &slot)) {
+        statistics_.rejections++;
+        continue;
+      }
+      Entry entry;
+      entry.slot = slot;
+      entry.step = step_;
+      lru_.push_front(id);
+      entry.lru_iter = lru_.begin();
+      entries_[id] = entry;
+      if (config_.policy == kCacheLFU) {
+        (void)lfu_.emplace(GetFrequency(id), id);
+      }
+    }
+    auto ret = memcpy_s(rows_.data() + slot * row_size_, row_bytes, rows + i * row_size_, row_bytes);
+    if (ret != EOK) {
+      MS_LOG(EXCEPTION) << "Embedding cache memcpy failed, errorno(" << ret << ")";
+    }
+  }
+}
+
+void EmbeddingCache::Touch(Entry *entry) {
+  if (config_.policy == kCacheLRU) {
+    lru_.splice(lru_.begin(), lru_, entry->lru_iter);
+  }
+}
+
+uint32_t EmbeddingCache::AddFrequency(int id) {
+  uint32_t &count = frequency_[id];
+  if (entries_.count(id) != 0) {
+    (void)lfu_.erase(std::make_pair(count, id));
+    (void)lfu_.emplace(count + 1, id);
+  }
+  count++;
+  uint32_t result = count;
+  if (++accesses_since_aging_ >= kFrequencyAgingFactor * std::max<size_t>(config_.capacity, 1)) {
+    AgeFrequency();
+  }
+  return result;
+}
+
+uint32_t EmbeddingCache::GetFrequency(int id) const {
+  auto iter = frequency_.find(id);
+  return iter == frequency_.end() ? 0 : iter->second;
+}
+
+void EmbeddingCache::AgeFrequency() {
+  accesses_since_aging_ = 0;
+  for (auto iter = frequency_.begin(); iter != frequency_.end();) {
+    iter->second /= 2;
+    if (iter->second == 0 && entries_.count(iter->first) == 0) {
+      iter = frequency_.erase(iter);
+    } else {
+      ++iter;
+    }
+  }
+  lfu_.clear();
+  for (const auto &entry : entries_) {
+    (void)lfu_.emplace(GetFrequency(entry.first), entry.first);
+  }
+}
+
+bool EmbeddingCache::Admit(int id, size_t *slot) {
+  if (config_.capacity == 0) {
+    return false;
+  }
+  if (free_slots_.empty()) {
+    int victim = 0;
+    if (config_.policy == kCacheLFU) {
+      // Only replace the coldest cached row by a hotter one, a scan of cold ids must not flush the hot rows.
+      const auto &coldest = *lfu_.begin();
+      if (GetFrequency(id) <= coldest.first) {
+        return false;
+      }
+      victim = coldest.second;
+    } else {
+      victim = lru_.back();
+    }
+    Evict(victim);
+  }
+  *slot = free_slots_.back();
+  free_slots_.pop_back();
+  return true;
+}
+
+void EmbeddingCache::Evict(int id) {
+  auto iter = entries_.find(id);
+  if (iter == entries_.end()) {
+    return;
+  }
+  free_slots_.push_back(iter->second.slot);
+  lru_.erase(iter->second.lru_iter);
+  if (config_.policy == kCacheLFU) {
+    (void)lfu_.erase(std::make_pair(GetFrequency(id), id));
+  }
+  entries_.erase(iter);
+  statistics_.evictions++;
+}
+}  // namespace ps
+}  // namespace parallel
+}  // namespace mindspore
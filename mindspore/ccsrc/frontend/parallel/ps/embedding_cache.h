@@ -0,0 +1,110 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_FRONTEND_PARALLEL_PS_EMBEDDING_CACHE_H_
+#define MINDSPORE_CCSRC_FRONTEND_PARALLEL_PS_EMBEDDING_CACHE_H_
+
+#include <cstdint>
+#include <list>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace mindspore {
+namespace parallel {
+namespace ps {
+enum EmbeddingCachePolicy { kCacheLRU = 0, kCacheLFU };
+
+struct EmbeddingCacheConfig {
+  // Number of rows kept on the worker, 0 disables the cache.
+  size_t capacity{0};
+  EmbeddingCachePolicy policy{kCacheLRU};
+  // Number of steps a cached row may still be served after it was pulled from the servers.
+  size_t max_staleness{0};
+};
+
+struct EmbeddingCacheStatistics {
+  uint64_t hits{0};
+  uint64_t misses{0};
+  // Misses of ids which were cached but older than max_staleness.
+  uint64_t stale_misses{0};
+  uint64_t evictions{0};
+  // Pulled rows which the LFU policy did not admit because they were colder than every cached row.
+  uint64_t rejections{0};
+  // The largest age in steps of a row served from the cache.
+  uint64_t max_served_staleness{0};
+
+  double hit_rate() const { return hits + misses == 0 ? 0 : static_cast<double>(hits) / (hits + misses); }
+};
+
+// Worker side cache of the hot rows of one embedding table served by the parameter servers. A lookup copies the
+// cached rows to the output and reports the positions which have to be pulled, the pulled rows are then offered to
+// the cache, which admits them by the LRU or LFU policy. A cached row is pulled again once it is older than
+// max_staleness steps, so the rows served never lag the servers by more than that.
+class EmbeddingCache {
+ public:
+  EmbeddingCache(size_t row_count, size_t row_size, const EmbeddingCacheConfig &config);
+  ~EmbeddingCache() = default;
+
+  static bool ParsePolicy(const std::string &name, EmbeddingCachePolicy *policy);
+
+  // Copy the rows of the cached ids to their positions in output, the positions of the other ids are appended to
+  // missed.
+  void Lookup(const int *ids, size_t id_num, float *output, std::vector<size_t> *missed);
+  // Offer the rows pulled for ids, the row of ids[i] starts at rows + i * row_size.
+  void Update(const int *ids, size_t id_num, const float *rows);
+  // Called once after all lookups of a step.
+  void StepEnd() { step_++; }
+
+  const EmbeddingCacheStatistics &statistics() const { return statistics_; }
+  size_t size() const { return entries_.size(); }
+
+ private:
+  struct Entry {
+    size_t slot{0};
+    uint64_t step{0};
+    std::list<int>::iterator lru_iter;
+  };
+
+  void Touch(Entry *entry);
+  uint32_t AddFrequency(int id);
+  uint32_t GetFrequency(int id) const;
+  void AgeFrequency();
+  // Find a slot for a new row of id, returns false if the policy does not admit it.
+  bool Admit(int id, size_t *slot);
+  void Evict(int id);
+
+  size_t row_count_;
+  size_t row_size_;
+  EmbeddingCacheConfig config_;
+  uint64_t step_{0};
+  std::vector<float> rows_;
+  std::vector<size_t> free_slots_;
+  std::unordered_map<int, Entry> entries_;
+  // Least recently used id at the back.
+  std::list<int> lru_;
+  // Access counts of the recently seen ids, cached or not, and the cached ids ordered by that count.
+  std::unordered_map<int, uint32_t> frequency_;
+  std::set<std::pair<uint32_t, int>> lfu_;
+  uint64_t accesses_since_aging_{0};
+  EmbeddingCacheStatistics statistics_;
+};
+}  // namespace ps
+}  // namespace parallel
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_FRONTEND_PARALLEL_PS_EMBEDDING_CACHE_H_
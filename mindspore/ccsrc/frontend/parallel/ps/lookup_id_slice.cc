@@ -0,0 +1,82 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "frontend/parallel/ps/lookup_id_slice.h"
+#include <unordered_map>
+
+namespace mindspore {
+namespace parallel {
+namespace ps {
+void LookupIdSlice::Build(const int *ids, size_t id_num, const std::vector<std::pair<uint64_t, uint64_t>> &ranges) {
+  id_num_ = id_num;
+  unique_ids_.clear();
+  server_unique_ids_.assign(ranges.size(), {});
+  unowned_unique_ids_.clear();
+
+  std::unordered_map<int, size_t> unique_index;
+  unique_index.reserve(id_num);
+  std::vector<size_t> inverse(id_num);
+  std::vector<size_t> counts;
+  for (size_t i = 0; i < id_num; i++) {
+    int id = ids[i];
+    auto iter = unique_index.emplace(id, unique_ids_.size());
+    if (iter.second) {
+      unique_ids_.push_back(id);
+      counts.push_back(0);
+      // Find the last range which begins at or before the id.
+      auto range_iter = std::upper_bound(
+        ranges.begin(), ranges.end(), static_cast<uint64_t>(id),
+        [](uint64_t value, const std::pair<uint64_t, uint64_t> &range) { return value < range.first; });
+      if (id < 0 || range_iter == ranges.begin() || static_cast<uint64_t>(id) > (range_iter - 1)->second) {
+        unowned_unique_ids_.push_back(iter.first->second);
+      } else {
+        size_t rank = static_cast<size_t>(range_iter - ranges.begin()) - 1;
+        server_unique_ids_[rank].push_back(iter.first->second);
+      }
+    }
+    inverse[i] = iter.first->second;
+    counts[inverse[i]]++;
+  }
+
+  row_offsets_.assign(counts.size() + 1, 0);
+  for (size_t u = 0; u < counts.size(); u++) {
+    row_offsets_[u + 1] = row_offsets_[u] + counts[u];
+  }
+  rows_.resize(id_num);
+  std::vector<size_t> cursor(row_offsets_.begin(), row_offsets_.end() - 1);
+  for (size_t i = 0; i < id_num; i++) {
+    rows_[cursor[inverse[i]]++] = i;
+  }
+}
+
+const std::vector<size_t> &LookupIdSlice::server_unique_ids(size_t rank) const {
+  if (rank >= server_unique_ids_.size()) {
+    MS_LOG(EXCEPTION) << "Server rank " << rank << " is out of " << server_unique_ids_.size() << " servers.";
+  }
+  return server_unique_ids_[rank];
+}
+
+size_t LookupIdSlice::RowSize(size_t rank, size_t val_num) const {
+  const auto &unique_ids = server_unique_ids(rank);
+  if (unique_ids.empty() || val_num % unique_ids.size() != 0) {
+    MS_LOG(EXCEPTION) << "Server " << rank << " answered " << val_num << " values for " << unique_ids.size()
+                      << " ids.";
+  }
+  return val_num / unique_ids.size();
+}
+}  // namespace ps
+}  // namespace parallel
+}  // namespace mindspore
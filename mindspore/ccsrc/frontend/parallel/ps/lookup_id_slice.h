@@ -0,0 +1,102 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_FRONTEND_PARALLEL_PS_LOOKUP_ID_SLICE_H_
+#define MINDSPORE_CCSRC_FRONTEND_PARALLEL_PS_LOOKUP_ID_SLICE_H_
+
+#include <algorithm>
+#include <cstdint>
+#include <utility>
+#include <vector>
+#include "securec/include/securec.h"
+#include "utils/log_adapter.h"
+
+namespace mindspore {
+namespace parallel {
+namespace ps {
+// The ids of one embedding lookup, deduplicated and split by the parameter server which owns them. The inverse index
+// from each unique id to the rows of the batch which looked it up is kept in CSR form, so the row answered for a
+// unique id is copied straight to all of its positions in the output.
+class LookupIdSlice {
+ public:
+  LookupIdSlice() = default;
+  ~LookupIdSlice() = default;
+
+  // ranges[i] is the inclusive range of table rows held by server i, the ranges are sorted and contiguous. The first
+  // occurrence of an id decides its unique index, ids outside every range are owned by no server.
+  void Build(const int *ids, size_t id_num, const std::vector<std::pair<uint64_t, uint64_t>> &ranges);
+
+  size_t id_num() const { return id_num_; }
+  size_t unique_id_num() const { return unique_ids_.size(); }
+  size_t server_num() const { return server_unique_ids_.size(); }
+  int unique_id(size_t u) const { return unique_ids_[u]; }
+  // The indices of the unique ids sent to server rank, in the order they are sent.
+  const std::vector<size_t> &server_unique_ids(size_t rank) const;
+  // The unique ids which no server owns, their rows are zeros.
+  const std::vector<size_t> &unowned_unique_ids() const { return unowned_unique_ids_; }
+
+  // The row size of an answer of val_num values from server rank.
+  size_t RowSize(size_t rank, size_t val_num) const;
+  // Copy the rows answered by server rank to every position of the batch which looked up the same id.
+  template <typename T>
+  void ScatterRows(size_t rank, const T *vals, size_t row_size, T *output, size_t output_size) const;
+  // Zero the positions of the batch which looked up an unowned id.
+  template <typename T>
+  void FillUnowned(T *output, size_t row_size) const;
+
+ private:
+  size_t id_num_{0};
+  std::vector<int> unique_ids_;
+  std::vector<std::vector<size_t>> server_unique_ids_;
+  std::vector<size_t> unowned_unique_ids_;
+  // The positions of unique id u are rows_[row_offsets_[u]] to rows_[row_offsets_[u + 1] - 1].
+  std::vector<size_t> row_offsets_;
+  std::vector<size_t> rows_;
+};
+
+template <typename T>
+void LookupIdSlice::ScatterRows(size_t rank, const T *vals, size_t row_size, T *output, size_t output_size) const {
+  const auto &unique_ids = server_unique_ids(rank);
+  if (id_num_ * row_size > output_size) {
+    MS_LOG(EXCEPTION) << "Lookup output size " << output_size << " is less than " << id_num_ << " rows of size "
+                      << row_size;
+  }
+  size_t row_bytes = row_size * sizeof(T);
+  for (size_t j = 0; j < unique_ids.size(); j++) {
+    size_t u = unique_ids[j];
+    const T *src = vals + j * row_size;
+    for (size_t k = row_offsets_[u]; k < row_offsets_[u + 1]; k++) {
+      size_t dst_offset = rows_[k] * row_size;
+      auto ret = memcpy_s(output + dst_offset, (output_size - dst_offset) * sizeof(T), src, row_bytes);
+      if (ret != EOK) {
+        MS_LOG(EXCEPTION) << "Lookup result memcpy failed, errorno(" << ret << ")";
+      }
+    }
+  }
+}
+
+template <typename T>
+void LookupIdSlice::FillUnowned(T *output, size_t row_size) const {
+  for (size_t u : unowned_unique_ids_) {
+    for (size_t k = row_offsets_[u]; k < row_offsets_[u + 1]; k++) {
+      std::fill(output + rows_[k] * row_size, output + (rows_[k] + 1) * row_size, static_cast<T>(0));
+    }
+  }
+}
+}  // namespace ps
+}  // namespace parallel
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_FRONTEND_PARALLEL_PS_LOOKUP_ID_SLICE_H_
@@ -29,7 +29,9 @@
 #include <cmath>
 #include <random>
 #include <list>
+#include <unordered_set>
 #include "ir/func_graph.h"
+#include "common/thread_pool.h"
 #include "backend/session/session_basic.h"
 #include "backend/session/anf_runtime_algorithm.h"
 #include "backend/session/session_factory.h"
@@ -51,6 +53,8 @@ namespace mindspore {
 namespace parallel {
 namespace ps {
 using mindspore::kernel::ps::PServerKernel;
+constexpr size_t kKeyMutexNum = 64;
+constexpr size_t kMaxUpdateThreadNum = 32;
 template <typename T>
 class ParameterServer {
  public:
@@ -72,7 +76,9 @@ class ParameterServer {
         func_graph_(nullptr),
         sess_(nullptr),
         running_(true),
-        thread_(nullptr) {}
+        key_mutexes_(kKeyMutexNum),
+        thread_(nullptr),
+        update_pool_(nullptr) {}
   ~ParameterServer() = default;
   ParameterServer(const ParameterServer &) = delete;
   ParameterServer &operator=(const ParameterServer &) = delete;
@@ -125,6 +131,8 @@ class ParameterServer {
   void ResetGradAccumCount();
   const CNodePtr GetCNode(const std::string &name) const;
   std::mutex &mutex();
+  std::mutex &key_mutex(const Key &key);
+  void UpdateWeight(const Key &key);
 
   size_t pserver_num_;
   size_t worker_num_;
@@ -149,10 +157,19 @@ class ParameterServer {
   std::unordered_map<Key, std::shared_ptr<PServerKernel>> embedding_lookup_ops_;
   std::unordered_map<Key, uint64_t> tokens_;
 
+  // mutex_ guards the maps above and the accumulation and token counters. The data of one key, i.e. its weight, its
+  // optimizer info and kernels, is guarded by the stripe of key_mutexes_ the key maps to, so that pushes, pulls and
+  // lookups of different keys and the optimizers of different keys run at the same time.
   std::mutex mutex_;
+  std::vector<std::mutex> key_mutexes_;
   std::condition_variable apply_grads_cv_;
+  std::condition_variable key_updated_cv_;
+  // The keys whose gradients of the last step are accumulated but not applied yet. Gradients of the next step for
+  // keys which are already updated are accumulated while the remaining keys are still updating.
+  std::unordered_set<Key> pending_updates_;
 
   std::unique_ptr<std::thread> thread_;
+  std::unique_ptr<common::ThreadPool> update_pool_;
 
   friend class ServerHandler;
 };
@@ -325,6 +342,8 @@ bool ParameterServer<T>::Init(const FuncGraphPtr &func_graph) {
   handler_->Init();
 
   InitOptimInfoBuilders();
+  size_t update_thread_num = std::min(static_cast<size_t>(std::thread::hardware_concurrency()), kMaxUpdateThreadNum);
+  update_pool_.reset(new common::ThreadPool(std::max(update_thread_num, static_cast<size_t>(1))));
   ps_->set_request_handle(*handler_);
   thread_.reset(new std::thread(&ParameterServer::UpdateWeights, this));
   return true;
@@ -461,64 +480,97 @@ void ParameterServer<T>::Finalize() {
 template <typename T>
 void ParameterServer<T>::UpdateWeights() {
   while (true) {
-    std::unique_lock<std::mutex> lock(mutex_);
-    apply_grads_cv_.wait(lock, [this] { return this->ReadyForUpdateWeights() || !running_; });
-    if (!running_) {
-      break;
+    std::vector<Key> keys;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      apply_grads_cv_.wait(lock, [this] { return this->ReadyForUpdateWeights() || !running_; });
+      if (!running_) {
+        break;
+      }
+      for (auto iter = weights_.begin(); iter != weights_.end(); iter++) {
+        if (optim_infos_[iter->first] != nullptr) {
+          keys.push_back(iter->first);
+          pending_updates_.insert(iter->first);
+        }
+      }
+      ResetGradAccumCount();
     }
 
-    for (auto iter = weights_.begin(); iter != weights_.end(); iter++) {
-      Key key = iter->first;
-      WeightPtr weight_ptr = iter->second;
-
-      std::shared_ptr<PServerKernel> optimizer = nullptr;
-      if (weight_key_to_optims_.count(key) > 0) {
-        optimizer = optimizers_[key];
-      }
-      MS_EXCEPTION_IF_NULL(optimizer);
+    std::vector<common::Task> tasks;
+    tasks.reserve(keys.size());
+    for (const auto &key : keys) {
+      tasks.emplace_back([this, key] { UpdateWeight(key); });
+    }
+    update_pool_->SyncRun(tasks);
+  }
+}
 
-      std::shared_ptr<OptimizerInfo> optim_info = optim_infos_[key];
-      if (optim_info == nullptr) {
-        continue;
-      }
-      const std::vector<kernel::AddressPtr> &inputs = optim_info->inputs();
-      const std::vector<kernel::AddressPtr> &workspaces = optim_info->workspaces();
-      const std::vector<kernel::AddressPtr> &outputs = optim_info->outputs();
-
-      optim_info->ComputeMean(worker_num_);
-      optimizer->Execute(inputs, workspaces, outputs);
-      optim_info->Reset();
-      if (!is_embedding_[key]) {
-        tokens_[key] = worker_num_;
-      }
+template <typename T>
+void ParameterServer<T>::UpdateWeight(const Key &key) {
+  std::shared_ptr<PServerKernel> optimizer = nullptr;
+  std::shared_ptr<OptimizerInfo> optim_info = nullptr;
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (weight_key_to_optims_.count(key) > 0) {
+      optimizer = optimizers_[key];
     }
-    ResetGradAccumCount();
+    optim_info = optim_infos_[key];
   }
+  MS_EXCEPTION_IF_NULL(optimizer);
+  MS_EXCEPTION_IF_NULL(optim_info);
+  {
+    std::unique_lock<std::mutex> key_lock(key_mutex(key));
+    const std::vector<kernel::AddressPtr> &inputs = optim_info->inputs();
+    const std::vector<kernel::AddressPtr> &workspaces = optim_info->workspaces();
+    const std::vector<kernel::AddressPtr> &outputs = optim_info->outputs();
+
+    optim_info->ComputeMean(worker_num_);
+    optimizer->Execute(inputs, workspaces, outputs);
+    optim_info->Reset();
+  }
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (!is_embedding_[key]) {
+      tokens_[key] = worker_num_;
+    }
+    pending_updates_.erase(key);
+  }
+  key_updated_cv_.notify_all();
 }
 
 template <typename T>
 void ParameterServer<T>::AccumGrad(const Keys &keys, const Values &values, const Lengths &lengths) {
-  std::unique_lock<std::mutex> lock(mutex_);
   const Key &key = keys[0];
-  std::shared_ptr<OptimizerInfo> optim_info = optim_infos_[key];
-
-  // Create or update the optimizer info
-  if (optim_info == nullptr) {
-    const std::shared_ptr<OptimizerInfoBuilder> &builder = optim_info_builders_[weight_key_to_optims_[key]];
-    std::shared_ptr<kernel::ps::PServerKernel> pserver_kernel = optimizers_[key];
-    if (pserver_kernel == nullptr) {
-      MS_LOG(EXCEPTION) << "no optimizer found for key " << key << " optim name " << weight_key_to_optims_[key];
+  std::shared_ptr<OptimizerInfo> optim_info = nullptr;
+  bool created = false;
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    // The gradients of the last step for this key must be applied before the ones of this step are accumulated.
+    key_updated_cv_.wait(lock, [this, &key] { return pending_updates_.count(key) == 0; });
+    optim_info = optim_infos_[key];
+
+    // The optimizer info is created from the first push of the key
+    if (optim_info == nullptr) {
+      const std::shared_ptr<OptimizerInfoBuilder> &builder = optim_info_builders_[weight_key_to_optims_[key]];
+      std::shared_ptr<kernel::ps::PServerKernel> pserver_kernel = optimizers_[key];
+      if (pserver_kernel == nullptr) {
+        MS_LOG(EXCEPTION) << "no optimizer found for key " << key << " optim name " << weight_key_to_optims_[key];
+      }
+      MS_EXCEPTION_IF_NULL(pserver_kernel);
+      OptimizerInfo *optim =
+        builder->Build(pserver_kernel, weights_[key], keys, values, lengths, optim_inputs_shape_[key], worker_num_);
+      optim_info.reset(optim);
+      optim_infos_[key] = optim_info;
+      created = true;
     }
-    MS_EXCEPTION_IF_NULL(pserver_kernel);
-    OptimizerInfo *optim =
-      builder->Build(pserver_kernel, weights_[key], keys, values, lengths, optim_inputs_shape_[key], worker_num_);
-    optim_info.reset(optim);
-    optim_infos_[key] = optim_info;
-  } else {
+  }
+  if (!created) {
+    std::unique_lock<std::mutex> key_lock(key_mutex(key));
     optim_info->Update(values, lengths);
     optim_info->Accumulate(values, lengths);
   }
 
+  std::unique_lock<std::mutex> lock(mutex_);
   grads_accum_counter_[key] += 1;
   if (grads_accum_counter_[key] == worker_num_) {
     grad_accum_count_++;
@@ -530,30 +582,39 @@ void ParameterServer<T>::AccumGrad(const Keys &keys, const Values &values, const
 
 template <typename T>
 WeightPtr ParameterServer<T>::weight(const Key &key) {
-  std::unique_lock<std::mutex> lock(mutex_);
-  if (weights_.count(key) == 0) {
-    MS_LOG(EXCEPTION) << "Invalid weight key " << key;
+  WeightPtr weight_ptr = nullptr;
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (weights_.count(key) == 0) {
+      MS_LOG(EXCEPTION) << "Invalid weight key " << key;
+    }
+    weight_ptr = weights_[key];
+    tokens_[key] -= 1;
   }
-  WeightPtr weight_ptr = weights_[key];
+  std::unique_lock<std::mutex> key_lock(key_mutex(key));
   WeightPtr copy_weight_ptr = std::make_shared<::ps::SArray<T>>(weight_ptr->size(), 0);
   copy_weight_ptr->CopyFrom(weight_ptr->data(), weight_ptr->size());
-  tokens_[key] -= 1;
   return copy_weight_ptr;
 }
 
 template <typename T>
 void ParameterServer<T>::DoEmbeddingLookup(Key key, const LookupIds &lookup_ids, ::ps::KVPairs<T> *res) {
-  std::unique_lock<std::mutex> lock(mutex_);
-  if (weights_.count(key) == 0) {
-    MS_LOG(ERROR) << "Invalid embedding table key " << key;
-    return;
-  }
-  if (embedding_lookup_ops_.count(key) == 0) {
-    MS_LOG(ERROR) << "Invalid embedding lookup op key " << key;
-    return;
+  WeightPtr table_ptr = nullptr;
+  std::shared_ptr<PServerKernel> table_lookup_op = nullptr;
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (weights_.count(key) == 0) {
+      MS_LOG(ERROR) << "Invalid embedding table key " << key;
+      return;
+    }
+    if (embedding_lookup_ops_.count(key) == 0) {
+      MS_LOG(ERROR) << "Invalid embedding lookup op key " << key;
+      return;
+    }
+    table_ptr = weights_[key];
+    table_lookup_op = embedding_lookup_ops_[key];
   }
-  WeightPtr table_ptr = weights_[key];
-  std::shared_ptr<PServerKernel> table_lookup_op = embedding_lookup_ops_[key];
+  std::unique_lock<std::mutex> key_lock(key_mutex(key));
 
   // Update shapes of lookup operator
   std::shared_ptr<std::vector<std::shared_ptr<std::vector<size_t>>>> shapes =
@@ -614,7 +675,7 @@ inline bool ParameterServer<T>::ReadyForPush(const Key &key) {
     MS_LOG(EXCEPTION) << "The weights in server is empty. Many reasons could cause this: 1.The Worker didn't send "
                          "kInitWeightsCmd command. 2.The Server failed to initialize weights.";
   }
-  return grad_accum_count_ < weights_.size() && tokens_[key] <= 0;
+  return grad_accum_count_ < weights_.size() && tokens_[key] <= 0 && pending_updates_.count(key) == 0;
 }
 
 template <typename T>
@@ -639,6 +700,11 @@ inline std::mutex &ParameterServer<T>::mutex() {
   return mutex_;
 }
 
+template <typename T>
+inline std::mutex &ParameterServer<T>::key_mutex(const Key &key) {
+  return key_mutexes_[key % key_mutexes_.size()];
+}
+
 template <typename T>
 void ParameterServer<T>::Run(const FuncGraphPtr &func_graph) {
   ::ps::Start(0);
@@ -23,8 +23,12 @@
 #include <memory>
 #include <vector>
 #include <unordered_set>
+#include <mutex>
+#include "securec/include/securec.h"
 #include "ps/ps.h"
+#include "utils/log_adapter.h"
 #include "frontend/parallel/ps/util.h"
+#include "frontend/parallel/ps/lookup_id_slice.h"
 
 namespace mindspore {
 namespace parallel {
@@ -63,25 +67,34 @@ class WorkerProxy : public ::ps::KVWorker<T> {
   void Finalize();
 
  private:
-  template <typename C>
-  int AddLookupCB(const ::ps::SArray<::ps::Key> &keys, const ::ps::SArray<int> &lookup_ids, C *vals, int cmd,
-                  const Callback &cb);
+  // Bookkeeping of one embedding lookup request. The ids of the batch are deduplicated, and each unique id is only
+  // sent to the server whose range of the table owns it.
+  struct LookupSlice {
+    ::ps::SArray<T> *outs{nullptr};
+    LookupIdSlice ids;
+    int expected_count{0};
+    int received_count{0};
+    bool output_ready{false};
+    Callback callback;
+  };
+
+  int AddLookupCB(::ps::SArray<T> *lookup_result, const Callback &cb);
   void LookupIdSlicer(int timestamp, const ::ps::KVPairs<T> &send, const std::vector<::ps::Range> &,
                       std::vector<std::pair<bool, ::ps::KVPairs<T>>> *sliced);
   void BroadcastSlicer(int timestamp, const ::ps::KVPairs<T> &send, const std::vector<::ps::Range> &,
                        std::vector<std::pair<bool, ::ps::KVPairs<T>>> *sliced);
   void ProcessLookupResult(const ::ps::Message &msg);
+  void PrepareLookupOutput(LookupSlice *slice, size_t row_size);
+  void ScatterLookupRows(LookupSlice *slice, size_t server_rank, const ::ps::SArray<T> &vals);
   void Send(::ps::Customer *customer, int timestamp, bool push, bool pull, int cmd, const ::ps::KVPairs<T> &kvs,
             const Slicer &slicer);
 
   std::unique_ptr<::ps::Customer> lookup_customer_;
   std::unordered_map<::ps::Key, std::shared_ptr<std::vector<::ps::Range>>> embedding_table_ranges_;
-  std::unordered_map<int, std::vector<::ps::KVPairs<T>>> lookup_results_;
+  std::unordered_map<int, LookupSlice> lookup_slices_;
   std::mutex mutex_;
   Slicer lookup_slicer_;
   Slicer broadcast_slicer_;
-  std::unordered_map<int, Callback> lookup_callbacks_;
-  std::unordered_map<int, int> expected_result_count_;
 };
 
 template <typename T>
@@ -109,18 +122,27 @@ template <typename T>
 void WorkerProxy<T>::EmbeddingLookup(const ::ps::SArray<::ps::Key> &keys, const ::ps::SArray<int> &lookup_ids,
                                      const ::ps::SArray<int> &lens, ::ps::SArray<T> *outs, int cmd, const Callback &cb,
                                      int priority) {
-  int ts = AddLookupCB(keys, lookup_ids, outs, cmd, cb);
+  int ts = AddLookupCB(outs, cb);
   ::ps::KVPairs<T> kvs;
   kvs.keys = keys;
   kvs.lens = lookup_ids;
   kvs.priority = priority;
-  expected_result_count_[ts] = 0;
   Send(lookup_customer_.get(), ts, true, true, cmd, kvs, lookup_slicer_);
   int server_num = ::ps::NumServers();
-  int expect_rt_count = expected_result_count_[ts];
+  int expect_rt_count = 0;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    expect_rt_count = lookup_slices_[ts].expected_count;
+  }
   lookup_customer_->AddResponse(ts, server_num - expect_rt_count);
   lookup_customer_->WaitRequest(ts);
-  expected_result_count_.erase(ts);
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (expect_rt_count == 0 && outs->size() > 0) {
+    // None of the ids is owned by a server, so every row is zeros.
+    std::fill(outs->begin(), outs->end(), static_cast<T>(0));
+  }
+  lookup_slices_.erase(ts);
 }
 
 template <typename T>
@@ -183,53 +205,52 @@ void WorkerProxy<T>::Finalize() {
 }
 
 template <typename T>
-template <typename C>
-int WorkerProxy<T>::AddLookupCB(const ::ps::SArray<::ps::Key> &keys, const ::ps::SArray<int> &lookup_ids,
-                                C *lookup_result, int cmd, const Callback &cb) {
+int WorkerProxy<T>::AddLookupCB(::ps::SArray<T> *lookup_result, const Callback &cb) {
+  MS_EXCEPTION_IF_NULL(lookup_result);
   int ts = lookup_customer_->NewRequest(::ps::kServerGroup);
-  const auto &callback = [this, ts, keys, lookup_ids, lookup_result, cb]() mutable {
-    mutex_.lock();
-    auto &kvs = lookup_results_[ts];
-    mutex_.unlock();
-
-    auto &s = kvs[0];
-    *lookup_result = s.vals;
-
-    mutex_.lock();
-    lookup_results_.erase(ts);
-    mutex_.unlock();
-    if (cb) cb();
-  };
-  lookup_callbacks_[ts] = callback;
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto &slice = lookup_slices_[ts];
+  slice.outs = lookup_result;
+  slice.callback = cb;
   return ts;
 }
 
 template <typename T>
 void WorkerProxy<T>::LookupIdSlicer(int timestamp, const ::ps::KVPairs<T> &send, const std::vector<::ps::Range> &,
                                     std::vector<std::pair<bool, ::ps::KVPairs<T>>> *sliced) {
-  int *lookup_ids = send.lens.data();
+  const int *lookup_ids = send.lens.data();
   size_t id_size = send.lens.size();
 
   const Key &key = send.keys[0];
   const std::vector<::ps::Range> &ranges = *(embedding_table_ranges_[key]);
+  std::vector<std::pair<uint64_t, uint64_t>> server_ranges;
+  server_ranges.reserve(ranges.size());
+  for (const auto &range : ranges) {
+    server_ranges.emplace_back(range.begin(), range.end());
+  }
   sliced->resize(ranges.size());
 
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto &slice = lookup_slices_[timestamp];
+  slice.ids.Build(lookup_ids, id_size, server_ranges);
+  slice.expected_count = 0;
   for (size_t i = 0; i < ranges.size(); i++) {
+    const auto &server_ids = slice.ids.server_unique_ids(i);
+    if (server_ids.empty()) {
+      sliced->at(i).first = false;
+      continue;
+    }
     auto &kvs = sliced->at(i).second;
-
+    kvs.keys.reserve(server_ids.size() + 1);
+    kvs.vals.reserve(server_ids.size() + 1);
     kvs.keys.push_back(key);
     kvs.vals.push_back(0.0f);
-    for (size_t j = 0; j < id_size; j++) {
-      kvs.keys.push_back(lookup_ids[j]);
+    for (size_t u : server_ids) {
+      kvs.keys.push_back(slice.ids.unique_id(u));
       kvs.vals.push_back(0.0f);
     }
-
-    if (kvs.keys.size() <= 1) {
-      sliced->at(i).first = false;
-    } else {
-      sliced->at(i).first = true;
-      expected_result_count_[timestamp] += 1;
-    }
+    sliced->at(i).first = true;
+    slice.expected_count += 1;
   }
 }
 
@@ -247,23 +268,48 @@ void WorkerProxy<T>::BroadcastSlicer(int timestamp, const ::ps::KVPairs<T> &send
 template <typename T>
 void WorkerProxy<T>::ProcessLookupResult(const ::ps::Message &msg) {
   int ts = msg.meta.timestamp;
-  if (msg.meta.pull) {
-    CHECK_GE(msg.data.size(), (size_t)2);
-    ::ps::KVPairs<T> kvs;
-    kvs.keys = msg.data[0];
-    kvs.vals = msg.data[1];
-    if (msg.data.size() > (size_t)2) {
-      kvs.lens = msg.data[2];
+  Callback cb;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto iter = lookup_slices_.find(ts);
+    if (iter == lookup_slices_.end()) {
+      MS_LOG(ERROR) << "Lookup result of unknown request " << ts;
+      return;
+    }
+    auto &slice = iter->second;
+    if (msg.meta.pull) {
+      CHECK_GE(msg.data.size(), (size_t)2);
+      ::ps::SArray<T> vals = msg.data[1];
+      ScatterLookupRows(&slice, ::ps::Postoffice::IDtoRank(msg.meta.sender), vals);
+    }
+    if (++slice.received_count == slice.expected_count) {
+      cb = slice.callback;
     }
-    mutex_.lock();
-    lookup_results_[ts].push_back(kvs);
-    mutex_.unlock();
   }
-  if (lookup_customer_->NumResponse(ts) == expected_result_count_[ts] - 1) {
-    const auto &cb = lookup_callbacks_[ts];
-    cb();
-    lookup_callbacks_.erase(ts);
+  if (cb) cb();
+}
+
+template <typename T>
+void WorkerProxy<T>::PrepareLookupOutput(LookupSlice *slice, size_t row_size) {
+  if (slice->output_ready) {
+    return;
+  }
+  ::ps::SArray<T> *outs = slice->outs;
+  if (outs->size() != slice->ids.id_num() * row_size) {
+    outs->resize(slice->ids.id_num() * row_size, 0);
+  }
+  slice->ids.FillUnowned(outs->data(), row_size);
+  slice->output_ready = true;
+}
+
+template <typename T>
+void WorkerProxy<T>::ScatterLookupRows(LookupSlice *slice, size_t server_rank, const ::ps::SArray<T> &vals) {
+  if (slice->ids.server_unique_ids(server_rank).empty()) {
+    return;
   }
+  size_t row_size = slice->ids.RowSize(server_rank, vals.size());
+  PrepareLookupOutput(slice, row_size);
+  slice->ids.ScatterRows(server_rank, vals.data(), row_size, slice->outs->data(), slice->outs->size());
 }
 
 template <typename T>
@@ -39,12 +39,18 @@ PYBIND_REGISTER(ConfigManager, 0, ([](const py::module *m) {
                     .def("set_op_connector_size", &ConfigManager::set_op_connector_size)
                     .def("set_seed", &ConfigManager::set_seed)
                     .def("set_monitor_sampling_interval", &ConfigManager::set_monitor_sampling_interval)
+                    .def("set_tensor_pool_size", &ConfigManager::set_tensor_pool_size)
+                    .def("set_text_chunk_size", &ConfigManager::set_text_chunk_size)
+                    .def("set_text_index_dir", &ConfigManager::set_text_index_dir)
                     .def("get_rows_per_buffer", &ConfigManager::rows_per_buffer)
                     .def("get_num_parallel_workers", &ConfigManager::num_parallel_workers)
                     .def("get_worker_connector_size", &ConfigManager::worker_connector_size)
                     .def("get_op_connector_size", &ConfigManager::op_connector_size)
                     .def("get_seed", &ConfigManager::seed)
                     .def("get_monitor_sampling_interval", &ConfigManager::monitor_sampling_interval)
+                    .def("get_tensor_pool_size", &ConfigManager::tensor_pool_size)
+                    .def("get_text_chunk_size", &ConfigManager::text_chunk_size)
+                    .def("get_text_index_dir", &ConfigManager::text_index_dir)
                     .def("load", [](ConfigManager &c, std::string s) { THROW_IF_ERROR(c.LoadFile(s)); });
                 }));
 
@@ -367,6 +367,12 @@ Status DEPipeline::ParseShuffleOp(const py::dict &args, std::shared_ptr<DatasetO
     if (!value.is_none()) {
       if (key == "reshuffle_each_epoch") {
         (void)builder->SetReshuffleEachEpoch(ToBool(args["reshuffle_each_epoch"]));
+      } else if (key == "num_parallel_workers") {
+        (void)builder->SetNumWorkers(ToInt(value));
+      } else if (key == "buffer_bytes") {
+        (void)builder->SetBufferBytes(value.cast<int64_t>());
+      } else if (key == "spill_dir") {
+        (void)builder->SetSpillDir(ToString(value));
       }
     }
   }
@@ -434,7 +440,7 @@ Status DEPipeline::SaveDataset(const std::vector<std::string> &file_names, const
     }
   } while (!row.empty());
   mr_writer->Commit();
-  if (mindrecord::SUCCESS != mindrecord::ShardIndexGenerator::finalize(file_names)) {
+  if (!mr_writer->IsIndexGenerated() && mindrecord::SUCCESS != mindrecord::ShardIndexGenerator::finalize(file_names)) {
     RETURN_STATUS_UNEXPECTED("Error: failed to finalize ShardIndexGenerator.");
   }
   return Status::OK();
@@ -863,6 +869,8 @@ Status DEPipeline::ParseGeneratorOp(const py::dict &args, std::shared_ptr<Datase
         (void)builder->SetColumnNames(ToStringVector(value));
       } else if (key == "column_types") {
         (void)builder->SetColumnTypes(ToTypeVector(value));
+      } else if (key == "columnar") {
+        (void)builder->SetColumnar(ToBool(value));
       }
     }
   }
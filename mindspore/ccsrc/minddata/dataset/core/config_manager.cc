@@ -42,6 +42,9 @@ Status ConfigManager::FromJson(const nlohmann::json &j) {
   set_op_connector_size(j.value("opConnectorSize", op_connector_size_));
   set_seed(j.value("seed", seed_));
   set_monitor_sampling_interval(j.value("monitorSamplingInterval", monitor_sampling_interval_));
+  set_tensor_pool_size(j.value("tensorPoolSize", tensor_pool_size_));
+  set_text_chunk_size(j.value("textChunkSize", text_chunk_size_));
+  set_text_index_dir(j.value("textIndexDir", text_index_dir_));
   return Status::OK();
 }
 
@@ -88,5 +91,11 @@ uint32_t ConfigManager::seed() const { return seed_; }
 void ConfigManager::set_seed(uint32_t seed) { seed_ = seed; }
 
 void ConfigManager::set_monitor_sampling_interval(uint32_t interval) { monitor_sampling_interval_ = interval; }
+
+void ConfigManager::set_tensor_pool_size(int32_t size_in_MB) { tensor_pool_size_ = size_in_MB; }
+
+void ConfigManager::set_text_chunk_size(int32_t size_in_MB) { text_chunk_size_ = size_in_MB; }
+
+void ConfigManager::set_text_index_dir(const std::string &index_dir) { text_index_dir_ = index_dir; }
 }  // namespace dataset
 }  // namespace mindspore
@@ -119,6 +119,31 @@ class ConfigManager {
   // @return The iterval of monitor sampling
   int32_t monitor_sampling_interval() const { return monitor_sampling_interval_; }
 
+  // setter function
+  // @param size_in_MB - The size of the tensor pool of each pipeline, 0 to allocate tensors from the system
+  void set_tensor_pool_size(int32_t size_in_MB);
+
+  // getter function
+  // @return The size of the tensor pool of each pipeline in MB
+  int32_t tensor_pool_size() const { return tensor_pool_size_; }
+
+  // setter function
+  // @param size_in_MB - The size of the chunks which text files are split into for the workers of an op, 0 to read
+  //     every file by a single worker
+  void set_text_chunk_size(int32_t size_in_MB);
+
+  // getter function
+  // @return The size of the chunks of text files in MB
+  int32_t text_chunk_size() const { return text_chunk_size_; }
+
+  // setter function
+  // @param index_dir - The directory to cache the row indexes of text files in, empty to scan the files every time
+  void set_text_index_dir(const std::string &index_dir);
+
+  // getter function
+  // @return The directory of the row indexes of text files
+  std::string text_index_dir() const { return text_index_dir_; }
+
  private:
   int32_t rows_per_buffer_{kCfgRowsPerBuffer};
   int32_t num_parallel_workers_{kCfgParallelWorkers};
@@ -126,6 +151,9 @@ class ConfigManager {
   int32_t op_connector_size_{kCfgOpConnectorSize};
   uint32_t seed_{kCfgDefaultSeed};
   uint32_t monitor_sampling_interval_{kCfgMonitorSamplingInterval};
+  int32_t tensor_pool_size_{kCfgTensorPoolSize};
+  int32_t text_chunk_size_{kCfgTextChunkSize};
+  std::string text_index_dir_;
 
   // Private helper function that taks a nlohmann json format and populates the settings
   // @param j - The json nlohmann json info
@@ -24,6 +24,9 @@
 #include "minddata/dataset/util/allocator.h"
 #include "minddata/dataset/util/circular_pool.h"
 #include "minddata/dataset/util/system_pool.h"
+#ifndef ENABLE_ANDROID
+#include "minddata/dataset/util/task_manager.h"
+#endif
 
 namespace mindspore {
 namespace dataset {
@@ -61,6 +64,16 @@ Status GlobalContext::Init() {
   return Status::OK();
 }
 
+std::shared_ptr<MemoryPool> GlobalContext::tensor_data_pool() const {
+#ifndef ENABLE_ANDROID
+  std::shared_ptr<MemoryPool> pool = this_thread::GetMemoryPool();
+  if (pool != nullptr) {
+    return pool;
+  }
+#endif
+  return mem_pool_;
+}
+
 // A print method typically used for debugging
 void GlobalContext::Print(std::ostream &out) const {
   out << "GlobalContext contains the following default config: " << *config_manager_ << "\n";
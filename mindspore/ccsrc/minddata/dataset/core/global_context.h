@@ -74,6 +74,11 @@ class GlobalContext {
   // @return the mem pool
   std::shared_ptr<MemoryPool> mem_pool() const { return mem_pool_; }
 
+  // Getter method
+  // @return the pool for the data of tensors: the tensor pool of the pipeline the calling thread works for, if it has
+  //     one, otherwise the mem pool
+  std::shared_ptr<MemoryPool> tensor_data_pool() const;
+
   // Getter method
   // @return the tensor allocator as raw pointer
   const TensorAlloc *tensor_allocator() const { return tensor_allocator_.get(); }
@@ -54,9 +54,9 @@ namespace dataset {
   }
 
 Tensor::Tensor(const TensorShape &shape, const DataType &type) : shape_(shape), type_(type), data_(nullptr) {
-  // grab the mem pool from global context and create the allocator for char data area
-  std::shared_ptr<MemoryPool> global_pool = GlobalContext::Instance()->mem_pool();
-  data_allocator_ = std::make_unique<Allocator<unsigned char>>(global_pool);
+  // grab the tensor data pool from global context and create the allocator for char data area
+  std::shared_ptr<MemoryPool> data_pool = GlobalContext::Instance()->tensor_data_pool();
+  data_allocator_ = std::make_unique<Allocator<unsigned char>>(data_pool);
 }
 
 Tensor::Tensor(Tensor &&other) noexcept
@@ -170,8 +170,8 @@ Status Tensor::CreateFromNpArray(const py::array &arr, std::shared_ptr<Tensor> *
 
   if ((*out)->type_ == DataType::DE_UNKNOWN) RETURN_STATUS_UNEXPECTED("Invalid data type.");
 
-  std::shared_ptr<MemoryPool> global_pool = GlobalContext::Instance()->mem_pool();
-  (*out)->data_allocator_ = std::make_unique<Allocator<unsigned char>>(global_pool);
+  std::shared_ptr<MemoryPool> data_pool = GlobalContext::Instance()->tensor_data_pool();
+  (*out)->data_allocator_ = std::make_unique<Allocator<unsigned char>>(data_pool);
   int64_t byte_size = (*out)->SizeInBytes();
   if (byte_size == 0) {
     return Status::OK();
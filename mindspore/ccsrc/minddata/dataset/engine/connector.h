@@ -50,6 +50,11 @@ namespace dataset {
 //        - The caller thread of pop() is not equal to the _expectConsumer. This is to enforce
 //          the ordering.
 //
+// Unordered mode:
+//   A Connector created with ordered = false keeps all the elements in one queue which every producer pushes to and
+//   every consumer pops from, in whatever order they come. Use it only when the consumers neither depend on the
+//   order of the elements nor on which producer an element (e.g. an eoe) came from.
+//
 // Future improvement:
 //   1. Fault tolerant: Right now, if one of the worker dies, the Connector will not work
 //      properly.
@@ -71,8 +76,9 @@ class Connector {
   // @param n_producers The number of threads producing data into this DbConnector.
   // @param n_consumers The number of thread consuming data from this DbConnector.
   // @param queue_capacity The number of element (DataBuffer) for each queue.
-  Connector(int32_t n_producers, int32_t n_consumers, int32_t queue_capacity)
-      : num_producers_(n_producers), num_consumers_(n_consumers) {
+  // @param ordered Whether the consumers pop the elements in the round robin order of the producers.
+  Connector(int32_t n_producers, int32_t n_consumers, int32_t queue_capacity, bool ordered = true)
+      : num_producers_(n_producers), num_consumers_(n_consumers), ordered_(ordered) {
     MS_LOG(DEBUG) << "A connector is created with " << n_producers << " producers and " << n_consumers << " consumers.";
     my_name_ = Services::GetUniqueID();
     // We require the consumers to have ids sequentially from 0 to the num_consumers_-1,
@@ -84,7 +90,11 @@ class Connector {
 
     // Initialize the queues_ to have num_producers_ number of queues.
     // Each queue is a blocking queue and has the same queue_capacity.
-    queues_.Init(num_producers_, queue_capacity);
+    if (ordered_) {
+      queues_.Init(num_producers_, queue_capacity);
+    } else {
+      queues_.Init(1, num_producers_ * queue_capacity);
+    }
   }
 
   // Destructor of Connector
@@ -96,8 +106,13 @@ class Connector {
   // @param result The address of an object where the popped element will be placed.
   virtual Status Pop(int32_t worker_id,  // The worker-id of the caller. See the requirement at the top of this file.
                      T *result) noexcept {
+    MS_ASSERT(worker_id < num_consumers_);
+    if (!ordered_) {
+      RETURN_IF_NOT_OK(queues_[0]->PopFront(result));
+      out_buffers_count_++;
+      return Status::OK();
+    }
     {
-      MS_ASSERT(worker_id < num_consumers_);
       std::unique_lock<std::mutex> lk(m_);
       RETURN_IF_NOT_OK(cv_.Wait(&lk, [this, worker_id]() { return expect_consumer_ == worker_id; }));
       RETURN_IF_NOT_OK(queues_[pop_from_]->PopFront(result));
@@ -106,7 +121,10 @@ class Connector {
       expect_consumer_ = (expect_consumer_ + 1) % num_consumers_;
     }
 
-    cv_.NotifyAll();
+    // A single consumer is always the expected one, it never waits in the cv.
+    if (num_consumers_ > 1) {
+      cv_.NotifyAll();
+    }
     return Status::OK();
   }
 
@@ -116,9 +134,10 @@ class Connector {
   // @param worker_id The id of a worker thread calling this method.
   // @param el A const lvalue element to be passed/added/pushed.
   Status Push(int32_t worker_id, const T &el) noexcept {
-    MS_ASSERT(worker_id < static_cast<int32_t>(queues_.size()));
-    MS_ASSERT(queues_[worker_id] != nullptr);
-    return (queues_[worker_id]->Add(el));
+    MS_ASSERT(worker_id < num_producers_);
+    int32_t queue_id = ordered_ ? worker_id : 0;
+    MS_ASSERT(queues_[queue_id] != nullptr);
+    return (queues_[queue_id]->Add(el));
   }
 
   auto out_buffers_count() const { return out_buffers_count_.load(); }
@@ -129,9 +148,10 @@ class Connector {
   // @param worker_id The id of a worker thread calling this method.
   // @param el An element to be passed/added/pushed.
   virtual Status Push(int32_t worker_id, T &&el) noexcept {
-    MS_ASSERT(worker_id < static_cast<int32_t>(queues_.size()));
-    MS_ASSERT(queues_[worker_id] != nullptr);
-    return (queues_[worker_id]->Add(std::forward<T>(el)));
+    MS_ASSERT(worker_id < num_producers_);
+    int32_t queue_id = ordered_ ? worker_id : 0;
+    MS_ASSERT(queues_[queue_id] != nullptr);
+    return (queues_[queue_id]->Add(std::forward<T>(el)));
   }
 
   // Resets the internal index tracking of the queue so that it can be used again with new inputs,
@@ -200,6 +220,9 @@ class Connector {
   int32_t num_producers_;
   int32_t num_consumers_;
 
+  // Whether the elements are popped in the round robin order of the producers, see the top of this file.
+  bool ordered_;
+
   // Used in the Pop(), when a thread call pop() but it is not the expect_consumer_.
   std::mutex m_;
   CondVar cv_;
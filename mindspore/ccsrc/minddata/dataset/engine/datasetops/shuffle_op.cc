@@ -21,16 +21,22 @@
 #include <chrono>
 #include <iomanip>
 #include <iostream>
+#include <functional>
 #include <limits>
+#include <numeric>
 #include <random>
+#include <string>
 #include <utility>
+#include <vector>
 
 #include "minddata/dataset/core/config_manager.h"
 #include "minddata/dataset/engine/datasetops/shuffle_op.h"
 #include "minddata/dataset/engine/dataset_iterator.h"
 #include "minddata/dataset/engine/data_buffer.h"
 #include "minddata/dataset/engine/db_connector.h"
+#include "minddata/dataset/engine/execution_tree.h"
 #include "minddata/dataset/engine/opt/pass.h"
+#include "minddata/dataset/util/path.h"
 #include "minddata/dataset/util/random.h"
 #include "minddata/dataset/util/status.h"
 
@@ -43,7 +49,8 @@ constexpr int32_t ShuffleOp::kShuffleStateActive;
 constexpr int32_t ShuffleOp::kShuffleStateDrain;
 
 // Builder constructor. Creates the builder object.
-ShuffleOp::Builder::Builder() : build_shuffle_size_(0), build_reshuffle_each_epoch_(true) {
+ShuffleOp::Builder::Builder()
+    : build_shuffle_size_(0), build_reshuffle_each_epoch_(true), build_num_workers_(1), build_buffer_bytes_(0) {
   std::shared_ptr<ConfigManager> cfg = GlobalContext::config_manager();
   build_op_connector_size_ = cfg->op_connector_size();
   build_rows_per_buffer_ = cfg->rows_per_buffer();
@@ -54,6 +61,15 @@ Status ShuffleOp::Builder::SanityCheck() const {
   if (build_shuffle_size_ < 2) {
     RETURN_STATUS_UNEXPECTED("Shuffle buffer size must be greater than 1.");
   }
+  if (build_num_workers_ < 1 || build_num_workers_ > build_shuffle_size_) {
+    RETURN_STATUS_UNEXPECTED("Number of shuffle workers must be between 1 and the shuffle buffer size.");
+  }
+  if (build_buffer_bytes_ < 0) {
+    RETURN_STATUS_UNEXPECTED("Shuffle buffer bytes must not be negative.");
+  }
+  if (!build_spill_dir_.empty() && build_buffer_bytes_ == 0) {
+    RETURN_STATUS_UNEXPECTED("Shuffle spill directory requires a memory budget in buffer bytes.");
+  }
   return Status::OK();
 }
 
@@ -61,13 +77,14 @@ Status ShuffleOp::Builder::SanityCheck() const {
 Status ShuffleOp::Builder::Build(std::shared_ptr<ShuffleOp> *ptr) {
   RETURN_IF_NOT_OK(SanityCheck());
   *ptr = std::make_shared<ShuffleOp>(build_shuffle_size_, build_shuffle_seed_, build_op_connector_size_,
-                                     build_reshuffle_each_epoch_, build_rows_per_buffer_);
+                                     build_reshuffle_each_epoch_, build_rows_per_buffer_, build_num_workers_,
+                                     build_buffer_bytes_, build_spill_dir_);
   return Status::OK();
 }
 
 // Constructor of the ShuffleOp
 ShuffleOp::ShuffleOp(int32_t shuffle_size, uint32_t shuffle_seed, int32_t op_connector_size, bool reset_every_epoch,
-                     int32_t rows_per_buffer)
+                     int32_t rows_per_buffer, int32_t num_workers, int64_t buffer_bytes, const std::string &spill_dir)
     : PipelineOp(op_connector_size),
       shuffle_size_(shuffle_size),
       shuffle_seed_(shuffle_seed),
@@ -77,7 +94,23 @@ ShuffleOp::ShuffleOp(int32_t shuffle_size, uint32_t shuffle_seed, int32_t op_con
       rows_per_buffer_(rows_per_buffer),
       shuffle_buffer_(std::make_unique<TensorTable>()),
       shuffle_last_row_idx_(0),
-      shuffle_buffer_state_(kShuffleStateInit) {}
+      shuffle_buffer_state_(kShuffleStateInit),
+      num_workers_(num_workers),
+      sharded_(num_workers > 1 || buffer_bytes > 0),
+      buffer_bytes_(buffer_bytes),
+      spill_dir_(spill_dir) {
+  shard_rows_ = (shuffle_size_ + num_workers_ - 1) / num_workers_;
+  shard_bytes_ = buffer_bytes_ / num_workers_;
+}
+
+ShuffleOp::~ShuffleOp() {
+  for (int32_t i = 0; i < static_cast<int32_t>(shards_.size()); i++) {
+    Status rc = RemoveSpill(i, &shards_[i]);
+    if (rc.IsError()) {
+      MS_LOG(WARNING) << rc.ToString();
+    }
+  }
+}
 
 // Private function to re-init the shuffle op for another epoch.  Shuffle op calls this by
 // itself rather than waiting for the reset driven from operators above it in the pipeline.
@@ -104,13 +137,15 @@ void ShuffleOp::Print(std::ostream &out, bool show_all) const {
     // Call the super class for displaying any common 1-liner info
     PipelineOp::Print(out, show_all);
     // Then show any custom derived-internal 1-liner info for this op
-    out << " [shuffle size: " << shuffle_size_ << "]\n";
+    out << " [shuffle size: " << shuffle_size_ << "] [workers: " << num_workers_ << "]\n";
   } else {
     // Call the super class for displaying any common detailed info
     PipelineOp::Print(out, show_all);
     // Then show any custom derived-internal stuff
     out << "\nShuffle size: " << shuffle_size_ << "\nRows per buffer: " << rows_per_buffer_
-        << "\nShuffle buffer state: " << shuffle_buffer_state_ << "\nShuffle seed: " << shuffle_seed_ << "\n\n";
+        << "\nShuffle buffer state: " << shuffle_buffer_state_ << "\nShuffle seed: " << shuffle_seed_
+        << "\nNumber of workers: " << num_workers_ << "\nBuffer bytes: " << buffer_bytes_
+        << "\nSpill directory: " << spill_dir_ << "\n\n";
   }
 }
 
@@ -144,7 +179,11 @@ Status ShuffleOp::operator()() {
   // Synchronize with TaskManager once the thread is launched.
   TaskManager::FindMe()->Post();
 
-  // Shuffle op does not have workers, and only consumes from child 0.
+  if (sharded_) {
+    return ShardedShuffle();
+  }
+
+  // Without sub-buffers shuffle op does not have workers, and only consumes from child 0.
   // Create the child iterator to fetch our data from.
   int32_t worker_id = 0;
   int32_t child_idx = 0;
@@ -288,6 +327,270 @@ Status ShuffleOp::InitShuffleBuffer() {
   return Status::OK();
 }
 
+void ShuffleOp::ReseedShard(int32_t worker_id, ShuffleShard *shard) const {
+  std::seed_seq seq{shuffle_seed_, static_cast<uint32_t>(worker_id)};
+  shard->rng.seed(seq);
+}
+
+// The sharded mode of the functor. The order of the output only depends on the seed and the order of the input: the
+// dealer gives the n-th row of an epoch to sub-buffer n % num_workers_, every sub-buffer draws from its own seeded
+// generator, and the merge takes one buffer from each worker per round, in an order drawn from rng_.
+Status ShuffleOp::ShardedShuffle() {
+  shards_ = std::vector<ShuffleShard>(num_workers_);
+  for (int32_t i = 0; i < num_workers_; i++) {
+    ReseedShard(i, &shards_[i]);
+  }
+  // The rows are dealt evenly, so a worker gets ahead of the others by at most the rows the others hold in their
+  // sub-buffers. Its output queue takes all of them, otherwise it could block the dealer while the merge waits for
+  // a worker which needs more rows.
+  int64_t out_queue_size = (static_cast<int64_t>(shard_rows_) + rows_per_buffer_ - 1) / rows_per_buffer_ + 2;
+  in_queues_.Init(num_workers_, oc_queue_size_);
+  out_queues_.Init(num_workers_, static_cast<int>(out_queue_size));
+  RETURN_IF_NOT_OK(in_queues_.Register(tree_->AllTasks()));
+  RETURN_IF_NOT_OK(out_queues_.Register(tree_->AllTasks()));
+  RETURN_IF_NOT_OK(tree_->AllTasks()->CreateAsyncTask("Shuffle dealer", std::bind(&ShuffleOp::DealerEntry, this)));
+  RETURN_IF_NOT_OK(
+    tree_->LaunchWorkers(num_workers_, std::bind(&ShuffleOp::WorkerEntry, this, std::placeholders::_1)));
+
+  std::vector<int32_t> active;
+  while (true) {
+    active.resize(num_workers_);
+    std::iota(active.begin(), active.end(), 0);
+    bool eof = false;
+    while (!active.empty()) {
+      for (size_t i = active.size() - 1; i > 0; i--) {
+        std::swap(active[i], active[rng_() % (i + 1)]);
+      }
+      // A worker leaves the round robin for the rest of the epoch once its eoe is popped.
+      size_t num_active = 0;
+      for (size_t i = 0; i < active.size(); i++) {
+        std::unique_ptr<DataBuffer> buf;
+        RETURN_IF_NOT_OK(out_queues_[active[i]]->PopFront(&buf));
+        if (buf->eof()) {
+          eof = true;
+        } else if (!buf->eoe()) {
+          buf->set_id(buffer_counter_++);
+          RETURN_IF_NOT_OK(out_connector_->Add(0, std::move(buf)));
+          active[num_active++] = active[i];
+        }
+      }
+      active.resize(num_active);
+    }
+    if (eof) {
+      MS_LOG(DEBUG) << "Shuffle operator sending EOF.";
+      return out_connector_->Add(0, std::make_unique<DataBuffer>(0, DataBuffer::kDeBFlagEOF));
+    }
+    MS_LOG(DEBUG) << "Shuffle operator sending EOE.";
+    RETURN_IF_NOT_OK(out_connector_->Add(0, std::make_unique<DataBuffer>(0, DataBuffer::kDeBFlagEOE)));
+    buffer_counter_ = 0;
+    if (!reshuffle_each_epoch_) {
+      rng_ = std::mt19937_64(shuffle_seed_);
+    }
+  }
+}
+
+Status ShuffleOp::DealerEntry() {
+  TaskManager::FindMe()->Post();
+  child_iterator_ = std::make_unique<ChildIterator>(this, 0, 0);
+  std::vector<std::unique_ptr<TensorQTable>> tables(num_workers_);
+  int64_t row_cnt = 0;
+  while (true) {
+    TensorRow new_row;
+    RETURN_IF_NOT_OK(child_iterator_->FetchNextTensorRow(&new_row));
+    if (child_iterator_->eof_handled()) {
+      for (int32_t i = 0; i < num_workers_; i++) {
+        RETURN_IF_NOT_OK(in_queues_[i]->Add(std::make_unique<DataBuffer>(0, DataBuffer::kDeBFlagEOF)));
+      }
+      return Status::OK();
+    }
+    if (new_row.empty()) {
+      // End of the epoch, each worker drains its sub-buffer when it gets the eoe.
+      for (int32_t i = 0; i < num_workers_; i++) {
+        if (tables[i] != nullptr) {
+          auto buf = std::make_unique<DataBuffer>(0, DataBuffer::kDeBFlagNone);
+          buf->set_tensor_table(std::move(tables[i]));
+          RETURN_IF_NOT_OK(in_queues_[i]->Add(std::move(buf)));
+        }
+        RETURN_IF_NOT_OK(in_queues_[i]->Add(std::make_unique<DataBuffer>(0, DataBuffer::kDeBFlagEOE)));
+      }
+      row_cnt = 0;
+      continue;
+    }
+    auto i = static_cast<int32_t>(row_cnt++ % num_workers_);
+    if (tables[i] == nullptr) {
+      tables[i] = std::make_unique<TensorQTable>();
+    }
+    tables[i]->push_back(std::move(new_row));
+    if (tables[i]->size() == static_cast<size_t>(rows_per_buffer_)) {
+      auto buf = std::make_unique<DataBuffer>(0, DataBuffer::kDeBFlagNone);
+      buf->set_tensor_table(std::move(tables[i]));
+      RETURN_IF_NOT_OK(in_queues_[i]->Add(std::move(buf)));
+    }
+  }
+}
+
+Status ShuffleOp::WorkerEntry(int32_t worker_id) {
+  TaskManager::FindMe()->Post();
+  ShuffleShard *shard = &shards_[worker_id];
+  while (true) {
+    std::unique_ptr<DataBuffer> buf;
+    RETURN_IF_NOT_OK(in_queues_[worker_id]->PopFront(&buf));
+    if (buf->eof()) {
+      RETURN_IF_NOT_OK(RemoveSpill(worker_id, shard));
+      return out_queues_[worker_id]->Add(std::move(buf));
+    }
+    if (buf->eoe()) {
+      while (!shard->slots.empty()) {
+        RETURN_IF_NOT_OK(SendRandomRow(worker_id, shard));
+      }
+      if (shard->out_table != nullptr) {
+        auto out_buf = std::make_unique<DataBuffer>(0, DataBuffer::kDeBFlagNone);
+        out_buf->set_tensor_table(std::move(shard->out_table));
+        RETURN_IF_NOT_OK(out_queues_[worker_id]->Add(std::move(out_buf)));
+      }
+      // The spill files only grow, they are removed and created again in the next epoch.
+      RETURN_IF_NOT_OK(RemoveSpill(worker_id, shard));
+      shard->mem_bytes = 0;
+      if (!reshuffle_each_epoch_) {
+        ReseedShard(worker_id, shard);
+      }
+      RETURN_IF_NOT_OK(out_queues_[worker_id]->Add(std::move(buf)));
+      continue;
+    }
+    while (buf->NumRows() > 0) {
+      TensorRow new_row;
+      RETURN_IF_NOT_OK(buf->PopRow(&new_row));
+      RETURN_IF_NOT_OK(AddRowToShard(worker_id, shard, std::move(new_row)));
+    }
+  }
+}
+
+Status ShuffleOp::AddRowToShard(int32_t worker_id, ShuffleShard *shard, TensorRow row) {
+  if (shard->slots.size() >= static_cast<size_t>(shard_rows_)) {
+    RETURN_IF_NOT_OK(SendRandomRow(worker_id, shard));
+  }
+  ShuffleSlot slot;
+  for (const auto &tensor : row) {
+    slot.bytes += tensor->SizeInBytes();
+  }
+  slot.row = std::move(row);
+  if (shard_bytes_ > 0 && shard->mem_bytes + slot.bytes > shard_bytes_) {
+    if (!spill_dir_.empty() && slot.bytes > 0) {
+      RETURN_IF_NOT_OK(SpillRow(worker_id, shard, &slot));
+    } else {
+      // Without spill the budget is kept by sending rows out early, the sub-buffer then holds fewer rows.
+      while (!shard->slots.empty() && shard->mem_bytes + slot.bytes > shard_bytes_) {
+        RETURN_IF_NOT_OK(SendRandomRow(worker_id, shard));
+      }
+    }
+  }
+  if (!slot.spilled) {
+    shard->mem_bytes += slot.bytes;
+  }
+  shard->slots.push_back(std::move(slot));
+  return Status::OK();
+}
+
+Status ShuffleOp::SendRandomRow(int32_t worker_id, ShuffleShard *shard) {
+  size_t random_slot = shard->rng() % shard->slots.size();
+  ShuffleSlot &slot = shard->slots[random_slot];
+  if (slot.spilled) {
+    RETURN_IF_NOT_OK(RestoreRow(shard, &slot));
+  } else {
+    shard->mem_bytes -= slot.bytes;
+  }
+  if (shard->out_table == nullptr) {
+    shard->out_table = std::make_unique<TensorQTable>();
+  }
+  shard->out_table->push_back(std::move(slot.row));
+  if (random_slot != shard->slots.size() - 1) {
+    slot = std::move(shard->slots.back());
+  }
+  shard->slots.pop_back();
+  if (shard->out_table->size() == static_cast<size_t>(rows_per_buffer_)) {
+    auto out_buf = std::make_unique<DataBuffer>(0, DataBuffer::kDeBFlagNone);
+    out_buf->set_tensor_table(std::move(shard->out_table));
+    RETURN_IF_NOT_OK(out_queues_[worker_id]->Add(std::move(out_buf)));
+  }
+  return Status::OK();
+}
+
+Status ShuffleOp::SpillRow(int32_t worker_id, ShuffleShard *shard, ShuffleSlot *slot) {
+  if (shard->spill == nullptr) {
+    Path dir = SpillDir(worker_id);
+    RETURN_IF_NOT_OK(dir.CreateDirectories());
+    auto spill = std::make_unique<StorageManager>(dir);
+    RETURN_IF_NOT_OK(spill->ServiceStart());
+    shard->spill = std::move(spill);
+  }
+  std::vector<ReadableSlice> slices;
+  slices.reserve(slot->row.size());
+  for (const auto &tensor : slot->row) {
+    slot->shapes.push_back(tensor->shape());
+    slot->types.push_back(tensor->type());
+    slot->sizes.push_back(tensor->SizeInBytes());
+    if (tensor->SizeInBytes() > 0) {
+      slices.emplace_back(tensor->GetBuffer(), tensor->SizeInBytes());
+    }
+  }
+  RETURN_IF_NOT_OK(shard->spill->Write(&slot->key, slices));
+  // Only the tensors are dropped, the id and the other info of the row stay in the slot
+  slot->row.clear();
+  slot->spilled = true;
+  return Status::OK();
+}
+
+Status ShuffleOp::RestoreRow(ShuffleShard *shard, ShuffleSlot *slot) {
+  std::vector<uchar> data(slot->bytes);
+  WritableSlice dest(data.data(), data.size());
+  size_t bytes_read = 0;
+  RETURN_IF_NOT_OK(shard->spill->Read(slot->key, &dest, &bytes_read));
+  if (bytes_read != data.size()) {
+    RETURN_STATUS_UNEXPECTED("Spilled shuffle row has " + std::to_string(bytes_read) + " bytes, expected " +
+                             std::to_string(data.size()));
+  }
+  TensorRow &row = slot->row;
+  row.reserve(slot->sizes.size());
+  int64_t offset = 0;
+  for (size_t i = 0; i < slot->sizes.size(); i++) {
+    std::shared_ptr<Tensor> tensor;
+    if (slot->sizes[i] == 0) {
+      RETURN_IF_NOT_OK(Tensor::CreateEmpty(slot->shapes[i], slot->types[i], &tensor));
+    } else {
+      RETURN_IF_NOT_OK(
+        Tensor::CreateFromMemory(slot->shapes[i], slot->types[i], data.data() + offset, slot->sizes[i], &tensor));
+    }
+    offset += slot->sizes[i];
+    row.push_back(std::move(tensor));
+  }
+  return Status::OK();
+}
+
+Path ShuffleOp::SpillDir(int32_t worker_id) const {
+  return Path(spill_dir_) / ("shuffle_" + std::to_string(id()) + "_" + std::to_string(worker_id));
+}
+
+Status ShuffleOp::RemoveSpill(int32_t worker_id, ShuffleShard *shard) {
+  if (shard->spill == nullptr) {
+    return Status::OK();
+  }
+  // Stopping the storage manager closes the spill files
+  shard->spill.reset();
+  Path dir = SpillDir(worker_id);
+  auto dir_it = Path::DirIterator::OpenDirectory(&dir);
+  while (dir_it != nullptr && dir_it->hasNext()) {
+    RETURN_IF_NOT_OK(dir_it->next().Remove());
+  }
+  return dir.Remove();
+}
+
+Status ShuffleOp::EofReceived(int32_t worker_id) {
+  if (sharded_) {
+    return Status::OK();
+  }
+  return PipelineOp::EofReceived(worker_id);
+}
+
 Status ShuffleOp::EoeReceived(int32_t worker_id) {
   state_ = OpState::kDeOpIdle;
   return Status::OK();
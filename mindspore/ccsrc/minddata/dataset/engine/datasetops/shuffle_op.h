@@ -28,7 +28,10 @@
 #include "minddata/dataset/core/tensor_shape.h"
 #include "minddata/dataset/engine/dataset_iterator.h"
 #include "minddata/dataset/engine/datasetops/pipeline_op.h"
+#include "minddata/dataset/util/path.h"
+#include "minddata/dataset/util/queue.h"
 #include "minddata/dataset/util/status.h"
+#include "minddata/dataset/util/storage_manager.h"
 
 namespace mindspore {
 namespace dataset {
@@ -100,6 +103,27 @@ class ShuffleOp : public PipelineOp {
       return *this;
     }
 
+    // Setter method.
+    // @return Builder setter method returns reference to the builder.
+    Builder &SetNumWorkers(int32_t num_workers) {
+      build_num_workers_ = num_workers;
+      return *this;
+    }
+
+    // Setter method.
+    // @return Builder setter method returns reference to the builder.
+    Builder &SetBufferBytes(int64_t buffer_bytes) {
+      build_buffer_bytes_ = buffer_bytes;
+      return *this;
+    }
+
+    // Setter method.
+    // @return Builder setter method returns reference to the builder.
+    Builder &SetSpillDir(const std::string &spill_dir) {
+      build_spill_dir_ = spill_dir;
+      return *this;
+    }
+
     // The builder "build" method creates the final object.
     // @return shared_ptr to the new ShuffleOp object
     Status Build(std::shared_ptr<ShuffleOp> *);
@@ -112,6 +136,9 @@ class ShuffleOp : public PipelineOp {
     int32_t build_rows_per_buffer_;
     bool build_reshuffle_each_epoch_;
     int32_t build_op_connector_size_;
+    int32_t build_num_workers_;
+    int64_t build_buffer_bytes_;
+    std::string build_spill_dir_;
 
     Status SanityCheck() const;
   };
@@ -122,11 +149,15 @@ class ShuffleOp : public PipelineOp {
   // @param shuffle_seed - The seed to use for random number generation
   // @param op_connector_size - The output connector queue size
   // @param rows_per_buffer - The requested number of rows per buffer
+  // @param num_workers - The number of sub-buffers which are filled and drained in parallel, 1 keeps a single buffer
+  // @param buffer_bytes - The memory budget of the shuffle buffer in bytes, 0 means no budget
+  // @param spill_dir - The directory where the rows over the memory budget are spilled to, empty means no spill
   ShuffleOp(int32_t shuffle_size, uint32_t shuffle_seed, int32_t op_connector_size, bool reset_every_epoch,
-            int32_t rows_per_buffer);
+            int32_t rows_per_buffer, int32_t num_workers = 1, int64_t buffer_bytes = 0,
+            const std::string &spill_dir = "");
 
-  // Destructor
-  ~ShuffleOp() = default;
+  // Destructor, removes the spill directories left by an op that did not run to the end
+  ~ShuffleOp();
 
   // A print method typically used for debugging
   // @param out - The output stream to write output to
@@ -155,6 +186,15 @@ class ShuffleOp : public PipelineOp {
   // @return Status - The error code return
   Status EoeReceived(int32_t worker_id) override;
 
+  // Base-class override for special eof handler.
+  // With sub-buffers the eof is sent by the merge after the workers are done, not by the thread which fetches it.
+  // @return Status - The error code return
+  Status EofReceived(int32_t worker_id) override;
+
+  // Getter method
+  // @return The number of sub-buffers
+  int32_t num_workers() const override { return num_workers_; }
+
   // Base-class override for NodePass visitor acceptor.
   // @param p - Pointer to the NodePass to be accepted.
   // @param modified - Whether this node visit modified the pipeline.
@@ -180,6 +220,68 @@ class ShuffleOp : public PipelineOp {
   // @return Status - The error code return
   Status SelfReset();
 
+  // A row held by a sub-buffer. The tensors of a spilled row are in the spill files, only their shapes, types and
+  // sizes stay in memory.
+  struct ShuffleSlot {
+    TensorRow row;  // A spilled row keeps its id and other row info, only its tensors are dropped
+    int64_t bytes = 0;
+    bool spilled = false;
+    StorageManager::key_type key = 0;
+    std::vector<TensorShape> shapes;
+    std::vector<DataType> types;
+    std::vector<int64_t> sizes;
+  };
+
+  // The state of one sub-buffer, only touched by its worker.
+  struct ShuffleShard {
+    std::mt19937_64 rng;
+    std::vector<ShuffleSlot> slots;
+    int64_t mem_bytes = 0;
+    std::unique_ptr<StorageManager> spill;
+    std::unique_ptr<TensorQTable> out_table;
+  };
+
+  // The sharded mode of the functor. The rows are dealt round robin to the sub-buffers by the
+  // dealer thread, each worker shuffles its own sub-buffer, and this thread merges the output of the workers in an
+  // order drawn from rng_.
+  // @return Status - The error code return
+  Status ShardedShuffle();
+
+  // The entry of the dealer thread which fetches the rows from the child.
+  // @return Status - The error code return
+  Status DealerEntry();
+
+  // The entry of the worker threads, each of them shuffles one sub-buffer.
+  // @param worker_id - The id of the worker, which is also the index of its sub-buffer
+  // @return Status - The error code return
+  Status WorkerEntry(int32_t worker_id);
+
+  // Add a row to a sub-buffer, sending out random rows first to make room for it.
+  // @return Status - The error code return
+  Status AddRowToShard(int32_t worker_id, ShuffleShard *shard, TensorRow row);
+
+  // Take a random row out of a sub-buffer and append it to the output table of the worker.
+  // @return Status - The error code return
+  Status SendRandomRow(int32_t worker_id, ShuffleShard *shard);
+
+  // Write the tensors of a row to the spill files of a sub-buffer.
+  // @return Status - The error code return
+  Status SpillRow(int32_t worker_id, ShuffleShard *shard, ShuffleSlot *slot);
+
+  // Read a spilled row back from the spill files of a sub-buffer.
+  // @return Status - The error code return
+  Status RestoreRow(ShuffleShard *shard, ShuffleSlot *slot);
+
+  // The directory of the spill files of a sub-buffer.
+  Path SpillDir(int32_t worker_id) const;
+
+  // Close the spill files of a sub-buffer and remove them with their directory.
+  // @return Status - The error code return
+  Status RemoveSpill(int32_t worker_id, ShuffleShard *shard);
+
+  // Seed the random generator of a sub-buffer from the shuffle seed and the index of the sub-buffer.
+  void ReseedShard(int32_t worker_id, ShuffleShard *shard) const;
+
   int32_t shuffle_size_;  // User config for the size of the shuffle buffer (number of rows)
   uint32_t shuffle_seed_;
   bool reshuffle_each_epoch_;
@@ -197,6 +299,16 @@ class ShuffleOp : public PipelineOp {
   int32_t shuffle_buffer_state_;  // State tracking for the shuffle buffer phases of work
 
   std::unique_ptr<ChildIterator> child_iterator_;  // An iterator for fetching.
+
+  int32_t num_workers_;     // Number of sub-buffers
+  bool sharded_;            // Whether the rows go through sub-buffers, which is needed for a memory budget too
+  int64_t buffer_bytes_;    // User config for the memory budget of the shuffle buffer, 0 for none
+  std::string spill_dir_;   // User config for the directory of the spill files, empty for no spill
+  int32_t shard_rows_;      // The row capacity of a sub-buffer
+  int64_t shard_bytes_;     // The memory budget of a sub-buffer
+  std::vector<ShuffleShard> shards_;
+  QueueList<std::unique_ptr<DataBuffer>> in_queues_;   // Rows dealt to the workers
+  QueueList<std::unique_ptr<DataBuffer>> out_queues_;  // Rows shuffled by the workers
 };
 }  // namespace dataset
 }  // namespace mindspore
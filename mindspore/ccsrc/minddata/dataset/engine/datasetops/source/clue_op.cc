@@ -37,6 +37,7 @@ ClueOp::Builder::Builder()
   builder_op_connector_size_ = config_manager->op_connector_size();
   builder_rows_per_buffer_ = config_manager->rows_per_buffer();
   builder_worker_connector_size_ = config_manager->worker_connector_size();
+  builder_chunk_size_ = static_cast<int64_t>(config_manager->text_chunk_size()) * 1024 * 1024;
 }
 
 Status ClueOp::Builder::ValidateInputs() const {
@@ -49,9 +50,10 @@ Status ClueOp::Builder::ValidateInputs() const {
 Status ClueOp::Builder::Build(std::shared_ptr<ClueOp> *op) {
   RETURN_IF_NOT_OK(ValidateInputs());
 
-  // Throttle the number of workers if we have more workers than files!
-  if (static_cast<size_t>(builder_num_workers_) > builder_clue_files_list_.size()) {
-    builder_num_workers_ = builder_clue_files_list_.size();
+  // Throttle the number of workers if we have more workers than chunks of files!
+  int64_t max_chunks = TextRowIndex::MaxChunks(builder_clue_files_list_, builder_chunk_size_);
+  if (builder_num_workers_ > max_chunks) {
+    builder_num_workers_ = static_cast<int32_t>(max_chunks);
     MS_LOG(WARNING) << "ClueOp operator parallelism reduced to " << builder_num_workers_ << " workers.";
   }
 
@@ -63,7 +65,7 @@ Status ClueOp::Builder::Build(std::shared_ptr<ClueOp> *op) {
   std::shared_ptr<ClueOp> clue_op = std::make_shared<ClueOp>(
     builder_num_workers_, builder_rows_per_buffer_, builder_num_samples_, builder_worker_connector_size_, ck_map,
     builder_clue_files_list_, builder_op_connector_size_, builder_shuffle_files_, builder_num_devices_,
-    builder_device_id_);
+    builder_device_id_, builder_chunk_size_);
   RETURN_IF_NOT_OK(clue_op->Init());
   *op = std::move(clue_op);
 
@@ -83,7 +85,7 @@ std::vector<std::string> ClueOp::Builder::split(const std::string &s, char delim
 
 ClueOp::ClueOp(int32_t num_workers, int64_t rows_per_buffer, int64_t num_samples, int32_t worker_connector_size,
                ColKeyMap cols_to_keyword, std::vector<std::string> clue_files_list, int32_t op_connector_size,
-               bool shuffle_files, int32_t num_device, int32_t device_id)
+               bool shuffle_files, int32_t num_device, int32_t device_id, int64_t chunk_size)
     : ParallelOp(num_workers, op_connector_size),
       rows_per_buffer_(rows_per_buffer),
       num_rows_per_shard_(0),
@@ -97,14 +99,16 @@ ClueOp::ClueOp(int32_t num_workers, int64_t rows_per_buffer, int64_t num_samples
       finished_reading_dataset_(false),
       num_devices_(num_device),
       device_id_(device_id),
-      load_io_block_queue_(true) {
+      load_io_block_queue_(true),
+      chunk_size_(chunk_size) {
   worker_connector_size_ = worker_connector_size;
 }
 
 Status ClueOp::Init() {
   RETURN_IF_NOT_OK(filename_index_->insert(clue_files_list_));
 
-  int32_t safe_queue_size = static_cast<int32_t>(std::ceil(clue_files_list_.size() / num_workers_) + 1);
+  int64_t max_chunks = TextRowIndex::MaxChunks(clue_files_list_, chunk_size_);
+  int32_t safe_queue_size = static_cast<int32_t>((max_chunks + num_workers_ - 1) / num_workers_ + 1);
   io_block_queues_.Init(num_workers_, safe_queue_size);
 
   RETURN_IF_NOT_OK(ParallelOp::CreateWorkerConnector(worker_connector_size_));
@@ -171,8 +175,18 @@ Status ClueOp::LoadFile(const std::string &file, const int64_t start_offset, con
     RETURN_STATUS_UNEXPECTED("Failed to open file " + file);
   }
 
-  int64_t rows_each_buffer = 0;
+  // Start at the indexed row before start_offset instead of the beginning of the file.
   int64_t rows_total = 0;
+  auto row_index = filename_row_index_.find(file);
+  if (row_index != filename_row_index_.end()) {
+    int64_t offset = 0;
+    int64_t skip = 0;
+    row_index->second->Seek(start_offset, &offset, &skip);
+    handle.seekg(offset);
+    rows_total = start_offset - skip;
+  }
+
+  int64_t rows_each_buffer = 0;
   std::string line;
   std::unique_ptr<DataBuffer> cur_buffer = std::make_unique<DataBuffer>(0, DataBuffer::BufferFlags::kDeBFlagNone);
   std::unique_ptr<TensorQTable> tensor_table = std::make_unique<TensorQTable>();
@@ -406,10 +420,14 @@ Status ClueOp::FillIOBlockQueue(const std::vector<int64_t> &i_keys) {
     }
     for (auto file_info : file_index) {
       if (NeedPushFileToBlockQueue(file_info.first, &start_offset, &end_offset, pre_count)) {
-        auto ioBlock =
-          std::make_unique<FilenameBlock>(file_info.second, start_offset, end_offset, IOBlock::kDeIoBlockNone);
-        RETURN_IF_NOT_OK(PushIoBlockQueue(queue_index, std::move(ioBlock)));
-        queue_index = (queue_index + 1) % num_workers_;
+        // A large file goes to the workers in chunks, so that all of them read it.
+        auto chunks = filename_row_index_[file_info.first]->Split(start_offset, end_offset, chunk_size_);
+        for (auto &chunk : chunks) {
+          auto ioBlock =
+            std::make_unique<FilenameBlock>(file_info.second, chunk.first, chunk.second, IOBlock::kDeIoBlockNone);
+          RETURN_IF_NOT_OK(PushIoBlockQueue(queue_index, std::move(ioBlock)));
+          queue_index = (queue_index + 1) % num_workers_;
+        }
       }
 
       pre_count += filename_numrows_[file_info.first];
@@ -492,21 +510,16 @@ Status ClueOp::CalculateNumRowsPerShard() {
 }
 
 int64_t ClueOp::CountTotalRows(const std::string &file) {
-  std::ifstream handle(file);
-  if (!handle.is_open()) {
+  std::shared_ptr<TextRowIndex> row_index;
+  Status rc = TextRowIndex::Create(file, TextRowIndex::Format::kLine, false, num_workers_, &row_index);
+  if (rc.IsError()) {
+    // An empty index reads the file from its beginning.
     MS_LOG(ERROR) << "Failed to open file: " << file;
+    filename_row_index_[file] = std::make_shared<TextRowIndex>();
     return 0;
   }
-
-  std::string line;
-  int64_t count = 0;
-  while (getline(handle, line)) {
-    if (!line.empty()) {
-      count++;
-    }
-  }
-
-  return count;
+  filename_row_index_[file] = row_index;
+  return row_index->num_rows();
 }
 
 // Pushes a control indicator onto the IOBlockQueue for each worker to consume.
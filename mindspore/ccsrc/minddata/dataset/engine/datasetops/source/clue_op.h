@@ -26,6 +26,7 @@
 #include "minddata/dataset/util/auto_index.h"
 #include "minddata/dataset/engine/datasetops/parallel_op.h"
 #include "minddata/dataset/engine/datasetops/source/io_block.h"
+#include "minddata/dataset/engine/datasetops/source/text_row_index.h"
 
 namespace mindspore {
 namespace dataset {
@@ -118,6 +119,15 @@ class ClueOp : public ParallelOp {
       return *this;
     }
 
+    // Setter method.
+    // @param chunk_size - the number of bytes of the chunks which the files are split into, 0 to read every file by a
+    //     single worker.
+    // @return Builder - setter method returns reference to the builder.
+    Builder &SetChunkSize(int64_t chunk_size) {
+      builder_chunk_size_ = chunk_size;
+      return *this;
+    }
+
     // Split string based on a character delimiter
     // @return - the a string vector
     std::vector<std::string> split(const std::string &s, char delim);
@@ -133,12 +143,13 @@ class ClueOp : public ParallelOp {
     std::vector<std::string> builder_clue_files_list_;
     bool builder_shuffle_files_;
     std::map<std::string, std::string> builder_cols_to_keyword_;
+    int64_t builder_chunk_size_;
   };
 
   // Constructor of ClueOp
   ClueOp(int32_t num_workers, int64_t rows_per_buffer, int64_t num_samples, int32_t worker_connector_size,
          ColKeyMap cols_to_keyword, std::vector<std::string> clue_files_list, int32_t op_connector_size,
-         bool shuffle_files, int32_t num_devices, int32_t device_id);
+         bool shuffle_files, int32_t num_devices, int32_t device_id, int64_t chunk_size = 0);
 
   // Default destructor
   ~ClueOp() = default;
@@ -237,7 +248,7 @@ class ClueOp : public ParallelOp {
   // @return Status - the error code returned.
   Status CalculateNumRowsPerShard();
 
-  // Count number of rows in each file.
+  // Count number of rows in each file, and keep the row index of the file for reading it in chunks.
   // @param filename - clue file name.
   // @return int64_t - the total number of rows in file.
   int64_t CountTotalRows(const std::string &file);
@@ -264,6 +275,8 @@ class ClueOp : public ParallelOp {
   int64_t all_num_rows_;
   int64_t num_samples_;
   std::map<std::string, int64_t> filename_numrows_;
+  std::map<std::string, std::shared_ptr<TextRowIndex>> filename_row_index_;
+  int64_t chunk_size_;
   std::unique_ptr<StringIndex> filename_index_;
   std::vector<std::string> clue_files_list_;
   WaitPost io_block_queue_wait_post_;
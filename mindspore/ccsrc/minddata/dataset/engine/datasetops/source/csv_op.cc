@@ -33,6 +33,7 @@ CsvOp::Builder::Builder()
   builder_op_connector_size_ = config_manager->op_connector_size();
   builder_rows_per_buffer_ = config_manager->rows_per_buffer();
   builder_worker_connector_size_ = config_manager->worker_connector_size();
+  builder_chunk_size_ = static_cast<int64_t>(config_manager->text_chunk_size()) * 1024 * 1024;
 }
 
 Status CsvOp::Builder::ValidateInputs() const {
@@ -45,16 +46,17 @@ Status CsvOp::Builder::ValidateInputs() const {
 Status CsvOp::Builder::Build(std::shared_ptr<CsvOp> *op) {
   RETURN_IF_NOT_OK(ValidateInputs());
 
-  // Throttle the number of workers if we have more workers than files!
-  if (static_cast<size_t>(builder_num_workers_) > builder_csv_files_list_.size()) {
-    builder_num_workers_ = builder_csv_files_list_.size();
+  // Throttle the number of workers if we have more workers than chunks of files!
+  int64_t max_chunks = TextRowIndex::MaxChunks(builder_csv_files_list_, builder_chunk_size_);
+  if (builder_num_workers_ > max_chunks) {
+    builder_num_workers_ = static_cast<int32_t>(max_chunks);
     MS_LOG(WARNING) << "CsvOp operator parallelism reduced to " << builder_num_workers_ << " workers.";
   }
 
   std::shared_ptr<CsvOp> csv_op = std::make_shared<CsvOp>(
     builder_csv_files_list_, builder_field_delim_, builder_column_default_list_, builder_column_name_list_,
     builder_num_workers_, builder_rows_per_buffer_, builder_num_samples_, builder_worker_connector_size_,
-    builder_op_connector_size_, builder_shuffle_files_, builder_num_devices_, builder_device_id_);
+    builder_op_connector_size_, builder_shuffle_files_, builder_num_devices_, builder_device_id_, builder_chunk_size_);
   RETURN_IF_NOT_OK(csv_op->Init());
   *op = std::move(csv_op);
 
@@ -65,7 +67,7 @@ CsvOp::CsvOp(const std::vector<std::string> &csv_files_list, char field_delim,
              const std::vector<std::shared_ptr<BaseRecord>> &column_default,
              const std::vector<std::string> &column_name, int32_t num_workers, int64_t rows_per_buffer,
              int64_t num_samples, int32_t worker_connector_size, int32_t op_connector_size, bool shuffle_files,
-             int32_t num_device, int32_t device_id)
+             int32_t num_device, int32_t device_id, int64_t chunk_size)
     : ParallelOp(num_workers, op_connector_size),
       csv_files_list_(std::move(csv_files_list)),
       field_delim_(field_delim),
@@ -81,14 +83,16 @@ CsvOp::CsvOp(const std::vector<std::string> &csv_files_list, char field_delim,
       finished_reading_dataset_(false),
       num_devices_(num_device),
       device_id_(device_id),
-      load_io_block_queue_(true) {
+      load_io_block_queue_(true),
+      chunk_size_(chunk_size) {
   worker_connector_size_ = worker_connector_size;
 }
 
 Status CsvOp::Init() {
   RETURN_IF_NOT_OK(filename_index_->insert(csv_files_list_));
 
-  int32_t safe_queue_size = static_cast<int32_t>(std::ceil(csv_files_list_.size() / num_workers_) + 1);
+  int64_t max_chunks = TextRowIndex::MaxChunks(csv_files_list_, chunk_size_);
+  int32_t safe_queue_size = static_cast<int32_t>((max_chunks + num_workers_ - 1) / num_workers_ + 1);
   io_block_queues_.Init(num_workers_, safe_queue_size);
 
   RETURN_IF_NOT_OK(ParallelOp::CreateWorkerConnector(worker_connector_size_));
@@ -400,14 +404,26 @@ Status CsvOp::Reset() {
 Status CsvOp::LoadFile(const std::string &file, const int64_t start_offset, const int64_t end_offset,
                        const int32_t worker_id) {
   CsvParser csv_parser(worker_id, jagged_buffer_connector_, rows_per_buffer_, field_delim_, column_default_list_);
-  csv_parser.setStartOffset(start_offset);
-  csv_parser.setEndOffset(end_offset);
   std::ifstream ifs;
   ifs.open(file, std::ifstream::in);
-  if (column_name_list_.empty()) {
+  // Start at the indexed row before start_offset instead of the beginning of the file. The rows of the parser count
+  // from there, the indexed rows are past the header.
+  int64_t first_row = 0;
+  bool end_of_chunk = false;
+  auto row_index = filename_row_index_.find(file);
+  if (row_index != filename_row_index_.end()) {
+    int64_t offset = 0;
+    int64_t skip = 0;
+    row_index->second->Seek(start_offset, &offset, &skip);
+    ifs.seekg(offset);
+    first_row = start_offset - skip;
+    end_of_chunk = end_offset < row_index->second->num_rows();
+  } else if (column_name_list_.empty()) {
     std::string tmp;
     getline(ifs, tmp);
   }
+  csv_parser.setStartOffset(start_offset - first_row);
+  csv_parser.setEndOffset(end_offset - first_row);
   csv_parser.Reset();
   try {
     while (ifs.good()) {
@@ -416,15 +432,21 @@ Status CsvOp::LoadFile(const std::string &file, const int64_t start_offset, cons
       // int to receive its return value.
       int chr = ifs.get();
       if (csv_parser.processMessage(chr) != 0) {
-        RETURN_STATUS_UNEXPECTED("Failed to parse file " + file + ":" + std::to_string(csv_parser.total_rows_ + 1) +
+        RETURN_STATUS_UNEXPECTED("Failed to parse file " + file + ":" +
+                                 std::to_string(first_row + csv_parser.total_rows_ + 1) +
                                  ". error message: " + csv_parser.err_message_);
       }
+      // The rows of a chunk end before the file does, the parser flushes them as at the end of file.
+      if (end_of_chunk && csv_parser.total_rows_ >= end_offset - first_row) {
+        (void)csv_parser.processMessage(std::char_traits<char>::eof());
+        break;
+      }
     }
   } catch (std::invalid_argument &ia) {
-    std::string err_row = std::to_string(csv_parser.total_rows_ + 1);
+    std::string err_row = std::to_string(first_row + csv_parser.total_rows_ + 1);
     RETURN_STATUS_UNEXPECTED(file + ":" + err_row + ", type does not match");
   } catch (std::out_of_range &oor) {
-    std::string err_row = std::to_string(csv_parser.total_rows_ + 1);
+    std::string err_row = std::to_string(first_row + csv_parser.total_rows_ + 1);
     RETURN_STATUS_UNEXPECTED(file + ":" + err_row + ", out of range");
   }
   return Status::OK();
@@ -607,10 +629,14 @@ Status CsvOp::FillIOBlockQueue(const std::vector<int64_t> &i_keys) {
     }
     for (auto file_info : file_index) {
       if (NeedPushFileToBlockQueue(file_info.first, &start_offset, &end_offset, pre_count)) {
-        auto ioBlock =
-          std::make_unique<FilenameBlock>(file_info.second, start_offset, end_offset, IOBlock::kDeIoBlockNone);
-        RETURN_IF_NOT_OK(PushIoBlockQueue(queue_index, std::move(ioBlock)));
-        queue_index = (queue_index + 1) % num_workers_;
+        // A large file goes to the workers in chunks, so that all of them read it.
+        auto chunks = filename_row_index_[file_info.first]->Split(start_offset, end_offset, chunk_size_);
+        for (auto &chunk : chunks) {
+          auto ioBlock =
+            std::make_unique<FilenameBlock>(file_info.second, chunk.first, chunk.second, IOBlock::kDeIoBlockNone);
+          RETURN_IF_NOT_OK(PushIoBlockQueue(queue_index, std::move(ioBlock)));
+          queue_index = (queue_index + 1) % num_workers_;
+        }
       }
 
       pre_count += filename_numrows_[file_info.first];
@@ -693,22 +719,18 @@ Status CsvOp::CalculateNumRowsPerShard() {
 }
 
 int64_t CsvOp::CountTotalRows(const std::string &file) {
-  CsvParser csv_parser(0, jagged_buffer_connector_, rows_per_buffer_, field_delim_, column_default_list_);
-  std::ifstream ifs;
-  ifs.open(file, std::ifstream::in);
-  if (column_name_list_.empty()) {
-    std::string tmp;
-    getline(ifs, tmp);
-  }
-  csv_parser.Reset();
-  while (ifs.good()) {
-    int chr = ifs.get();
-    if (csv_parser.countRows(chr) != 0) {
-      break;
-    }
+  // The row index counts the rows as the 'sdl' state diagram of CsvParser does.
+  std::shared_ptr<TextRowIndex> row_index;
+  Status rc =
+    TextRowIndex::Create(file, TextRowIndex::Format::kCsv, column_name_list_.empty(), num_workers_, &row_index);
+  if (rc.IsError()) {
+    // An empty index reads the file from its beginning.
+    MS_LOG(ERROR) << "Failed to open file: " << file;
+    filename_row_index_[file] = std::make_shared<TextRowIndex>();
+    return 0;
   }
-
-  return csv_parser.total_rows_;
+  filename_row_index_[file] = row_index;
+  return row_index->num_rows();
 }
 
 // Pushes a control indicator onto the IOBlockQueue for each worker to consume.
@@ -26,6 +26,7 @@
 #include "minddata/dataset/util/auto_index.h"
 #include "minddata/dataset/engine/datasetops/parallel_op.h"
 #include "minddata/dataset/engine/datasetops/source/io_block.h"
+#include "minddata/dataset/engine/datasetops/source/text_row_index.h"
 
 namespace mindspore {
 namespace dataset {
@@ -289,6 +290,15 @@ class CsvOp : public ParallelOp {
       return *this;
     }
 
+    // Setter method.
+    // @param chunk_size - the number of bytes of the chunks which the files are split into, 0 to read every file by a
+    //     single worker.
+    // @return Builder - setter method returns reference to the builder.
+    Builder &SetChunkSize(int64_t chunk_size) {
+      builder_chunk_size_ = chunk_size;
+      return *this;
+    }
+
    private:
     int32_t builder_device_id_;
     int32_t builder_num_devices_;
@@ -302,6 +312,7 @@ class CsvOp : public ParallelOp {
     char builder_field_delim_;
     std::vector<std::shared_ptr<CsvOp::BaseRecord>> builder_column_default_list_;
     std::vector<std::string> builder_column_name_list_;
+    int64_t builder_chunk_size_;
   };
 
   // Constructor of CsvOp
@@ -310,7 +321,8 @@ class CsvOp : public ParallelOp {
   CsvOp(const std::vector<std::string> &csv_files_list, char field_delim,
         const std::vector<std::shared_ptr<BaseRecord>> &column_default, const std::vector<std::string> &column_name,
         int32_t num_workers, int64_t rows_per_buffer, int64_t num_samples, int32_t worker_connector_size,
-        int32_t op_connector_size, bool shuffle_files, int32_t num_devices, int32_t device_id);
+        int32_t op_connector_size, bool shuffle_files, int32_t num_devices, int32_t device_id,
+        int64_t chunk_size = 0);
 
   // Default destructor
   ~CsvOp() = default;
@@ -410,7 +422,7 @@ class CsvOp : public ParallelOp {
   // @return Status - the error code returned.
   Status CalculateNumRowsPerShard();
 
-  // Count number of rows in each file.
+  // Count number of rows in each file, and keep the row index of the file for reading it in chunks.
   // @param filename - csv file name.
   // @return int64_t - the total number of rows in file.
   int64_t CountTotalRows(const std::string &file);
@@ -438,6 +450,7 @@ class CsvOp : public ParallelOp {
   int64_t all_num_rows_;
   int64_t num_samples_;
   std::map<std::string, int64_t> filename_numrows_;
+  std::map<std::string, std::shared_ptr<TextRowIndex>> filename_row_index_;
   std::unique_ptr<StringIndex> filename_index_;
   std::vector<std::string> csv_files_list_;
   WaitPost io_block_queue_wait_post_;
@@ -447,6 +460,7 @@ class CsvOp : public ParallelOp {
   char field_delim_;
   std::vector<std::shared_ptr<CsvOp::BaseRecord>> column_default_list_;
   std::vector<std::string> column_name_list_;
+  int64_t chunk_size_;
 };
 }  // namespace dataset
 }  // namespace mindspore
@@ -43,19 +43,21 @@ Status GeneratorOp::Builder::SanityCheck() {
 Status GeneratorOp::Builder::Build(std::shared_ptr<GeneratorOp> *ptr) {
   RETURN_IF_NOT_OK(SanityCheck());
   *ptr = std::make_shared<GeneratorOp>(build_generator_function_, build_column_names_, build_column_types_,
-                                       build_prefetch_size_, build_buffer_size_, build_op_connector_size_);
+                                       build_prefetch_size_, build_buffer_size_, build_op_connector_size_,
+                                       build_columnar_);
   return (*ptr)->Init();
 }
 
 GeneratorOp::GeneratorOp(py::function generator_function, std::vector<std::string> column_names,
                          std::vector<DataType> column_types, int32_t prefetch_size, int32_t buffer_size,
-                         int32_t connector_size)
+                         int32_t connector_size, bool columnar)
     : PipelineOp(connector_size),
       generator_function_(generator_function),
       column_names_(column_names),
       column_types_(column_types),
       prefetch_size_(prefetch_size),
       buffer_size_(buffer_size),
+      columnar_(columnar),
       buffer_id_(0) {}
 
 GeneratorOp::~GeneratorOp() { this->Dealloc(); }
@@ -146,6 +148,85 @@ Status GeneratorOp::FillBuffer(TensorQTable *tt) {
   return Status::OK();
 }
 
+Status GeneratorOp::PyBlockToColumns(py::object py_data, std::vector<ColumnBlock> *columns, int64_t *num_rows) {
+  if (!py::isinstance<py::tuple>(py_data)) {
+    return Status(StatusCode::kPyFuncException, __LINE__, __FILE__, "Generator should return a tuple of numpy arrays.");
+  }
+  py::tuple py_block = py_data.cast<py::tuple>();
+  if (py_block.size() != column_names_.size()) {
+    return Status(StatusCode::kPyFuncException, __LINE__, __FILE__,
+                  "Generator should return same number of numpy arrays as specified in column names.");
+  }
+  columns->resize(py_block.size());
+  for (int i = 0; i < py_block.size(); ++i) {
+    py::object ret_py_ele = py_block[i];
+    if (!py::isinstance<py::array>(ret_py_ele)) {
+      return Status(StatusCode::kPyFuncException, __LINE__, __FILE__,
+                    "Generator should return a tuple of numpy arrays.");
+    }
+    ColumnBlock &column = (*columns)[i];
+    // The rows are copied out with plain offsets, so a strided array is made contiguous first.
+    column.array = py::array::ensure(ret_py_ele, py::array::c_style);
+    if (!column.array || column.array.ndim() < 1) {
+      return Status(StatusCode::kPyFuncException, __LINE__, __FILE__,
+                    "Columnar generator should return arrays with the rows in the first dimension.");
+    }
+    auto rows = static_cast<int64_t>(column.array.shape(0));
+    if (i > 0 && rows != *num_rows) {
+      return Status(StatusCode::kPyFuncException, __LINE__, __FILE__,
+                    "Columnar generator should return the same number of rows in every column.");
+    }
+    *num_rows = rows;
+    column.type = DataType::FromNpArray(column.array);
+    if ((!column_types_.empty()) && (column_types_[i] != DataType::DE_UNKNOWN) && (column_types_[i] != column.type)) {
+      return Status(StatusCode::kPyFuncException, __LINE__, __FILE__, "Generator type check failed.");
+    }
+    if (column.type == DataType::DE_STRING) {
+      for (int64_t r = 0; r < rows; r++) {
+        std::shared_ptr<Tensor> tensor;
+        RETURN_IF_NOT_OK(Tensor::CreateFromNpArray(py::array::ensure(column.array[py::int_(r)]), &tensor));
+        column.rows.push_back(std::move(tensor));
+      }
+      continue;
+    }
+    if (column.type == DataType::DE_UNKNOWN) {
+      RETURN_STATUS_UNEXPECTED("Invalid data type.");
+    }
+    std::vector<dsize_t> row_shape;
+    for (dsize_t d = 1; d < column.array.ndim(); d++) {
+      row_shape.push_back(static_cast<dsize_t>(column.array.shape(d)));
+    }
+    column.row_shape = TensorShape(row_shape);
+    column.row_bytes = column.row_shape.NumOfElements() * column.type.SizeInBytes();
+    column.data = static_cast<const uchar *>(column.array.data());
+  }
+  return Status::OK();
+}
+
+Status GeneratorOp::FillBufferFromBlock(TensorQTable *tt) {
+  std::vector<ColumnBlock> columns;
+  int64_t num_rows = 0;
+  RETURN_IF_NOT_OK(PyBlockToColumns(generator_.attr("__next__")(), &columns, &num_rows));
+  // The arrays are held by columns, and they go away after the GIL is taken back.
+  py::gil_scoped_release gil_release;
+  for (int64_t r = 0; r < num_rows; r++) {
+    TensorRow row;
+    row.reserve(columns.size());
+    for (auto &column : columns) {
+      if (column.type == DataType::DE_STRING) {
+        row.push_back(std::move(column.rows[r]));
+        continue;
+      }
+      std::shared_ptr<Tensor> tensor;
+      const uchar *src = column.row_bytes == 0 ? nullptr : column.data + r * column.row_bytes;
+      RETURN_IF_NOT_OK(Tensor::CreateFromMemory(column.row_shape, column.type, src, &tensor));
+      row.push_back(std::move(tensor));
+    }
+    tt->push_back(std::move(row));
+  }
+  return Status::OK();
+}
+
 // Entry point for Generator, called by launch()
 // Note that this function is very easy to break because of the Python GIL mechanism
 // The master thread has the following workflow
@@ -153,6 +234,7 @@ Status GeneratorOp::FillBuffer(TensorQTable *tt) {
 // while !eof:
 //      Try:
 //          Prepare one data buffer                                   GIL, Can throw
+//          (columnar: copy the rows out of the block)                No GIL
 //      Catch:
 //          Fetch Python Exception                                    GIL
 //          Check if Exception is StopIteration (EOE)                 GIL
@@ -196,7 +278,11 @@ Status GeneratorOp::operator()() {
         return Status(StatusCode::kPythonInterpreterFailure, "Python Interpreter is finalized");
       }
       try {
-        RETURN_IF_NOT_OK(FillBuffer(fetched_table.get()));
+        if (columnar_) {
+          RETURN_IF_NOT_OK(FillBufferFromBlock(fetched_table.get()));
+        } else {
+          RETURN_IF_NOT_OK(FillBuffer(fetched_table.get()));
+        }
       } catch (py::error_already_set &e) {
         eoe = e.matches(PyExc_StopIteration);
         // Restore exception to python
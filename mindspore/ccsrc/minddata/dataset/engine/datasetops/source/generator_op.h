@@ -74,6 +74,13 @@ class GeneratorOp : public PipelineOp {
       return *this;
     }
 
+    // Setter method.
+    // @return Builder setter method returns reference to the builder.
+    Builder &SetColumnar(bool columnar) {
+      build_columnar_ = columnar;
+      return *this;
+    }
+
     // The builder "build" method creates the final object.
     // @return shared_ptr to the new GeneratorOp object
     Status Build(std::shared_ptr<GeneratorOp> *);
@@ -86,14 +93,18 @@ class GeneratorOp : public PipelineOp {
     std::vector<DataType> build_column_types_;
 
     int32_t build_prefetch_size_ = 0;
+    bool build_columnar_ = false;
     int32_t build_buffer_size_;
     int32_t build_op_connector_size_;
 
     Status SanityCheck();
   };
 
+  // @param columnar - the generator yields blocks of rows, each array holds one column of the block with the rows
+  //     in its first dimension
   GeneratorOp(py::function generator_function, std::vector<std::string> column_names,
-              std::vector<DataType> column_types, int32_t prefetch_size, int32_t buffer_size, int32_t connector_size);
+              std::vector<DataType> column_types, int32_t prefetch_size, int32_t buffer_size, int32_t connector_size,
+              bool columnar = false);
 
   ~GeneratorOp();
 
@@ -135,11 +146,22 @@ class GeneratorOp : public PipelineOp {
   std::string Name() const override { return "GeneratorOp"; }
 
  private:
+  // One column of a block from a columnar generator. The array is kept alive until the rows are copied out.
+  struct ColumnBlock {
+    py::array array;
+    const uchar *data = nullptr;
+    TensorShape row_shape = TensorShape::CreateScalar();
+    DataType type;
+    int64_t row_bytes = 0;
+    std::vector<std::shared_ptr<Tensor>> rows;  // The rows of a string column, which are created with the GIL
+  };
+
   py::function generator_function_;
   std::vector<std::string> column_names_;
   std::vector<DataType> column_types_;
   int32_t prefetch_size_;
   int32_t buffer_size_;
+  bool columnar_;
 
   py::object generator_;
   int32_t buffer_id_;
@@ -154,6 +176,13 @@ class GeneratorOp : public PipelineOp {
 
   Status FillBuffer(TensorQTable *tt);
 
+  // Check a block from a columnar generator and take the layout of its columns, called with the GIL.
+  Status PyBlockToColumns(py::object py_data, std::vector<ColumnBlock> *columns, int64_t *num_rows);
+
+  // Fill a buffer with the rows of the next block, called with the GIL. The rows are copied out of the arrays
+  // without the GIL.
+  Status FillBufferFromBlock(TensorQTable *tt);
+
   // Private function for computing the assignment of the column name map.
   // @return - Status
   Status ComputeColMap() override;
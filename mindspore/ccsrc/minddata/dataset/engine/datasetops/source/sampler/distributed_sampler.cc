@@ -54,7 +54,9 @@ Status DistributedSampler::InitSampler() {
     }
   }
   samples_per_buffer_ = num_samples_ < samples_per_buffer_ ? num_samples_ : samples_per_buffer_;
-  if (shuffle_ == true) {
+  if (shuffle_ == true && num_rows_ > kShuffleVectorMaxRows) {
+    permutation_.Init(num_rows_, rnd_());
+  } else if (shuffle_ == true) {
     shuffle_vec_.reserve(num_rows_);
     for (int64_t i = 0; i < num_rows_; i++) {
       shuffle_vec_.push_back(i);
@@ -80,7 +82,9 @@ Status DistributedSampler::GetNextSample(std::unique_ptr<DataBuffer> *out_buffer
     auto id_ptr = sample_ids->begin<int64_t>();
     while (cnt_ < samples_per_buffer_ && id_ptr != sample_ids->end<int64_t>()) {
       int64_t sampled_id = (num_devices_ * cnt_ + device_id_) % num_rows_;
-      if (shuffle_) {
+      if (shuffle_ && shuffle_vec_.empty()) {
+        sampled_id = permutation_(sampled_id);
+      } else if (shuffle_) {
         sampled_id = shuffle_vec_[static_cast<size_t>(sampled_id)];
       }
 
@@ -105,7 +109,11 @@ Status DistributedSampler::ResetSampler() {
   if (shuffle_ == true) {
     rnd_.seed(seed_);
     seed_++;
-    std::shuffle(shuffle_vec_.begin(), shuffle_vec_.end(), rnd_);
+    if (shuffle_vec_.empty()) {
+      permutation_.Reseed(rnd_());
+    } else {
+      std::shuffle(shuffle_vec_.begin(), shuffle_vec_.end(), rnd_);
+    }
   }
 
   if (HasChildSampler()) {
@@ -22,6 +22,7 @@
 #include <vector>
 
 #include "minddata/dataset/engine/datasetops/source/sampler/sampler.h"
+#include "minddata/dataset/util/random_permutation.h"
 
 namespace mindspore {
 namespace dataset {
@@ -65,6 +66,7 @@ class DistributedSampler : public Sampler {
   bool shuffle_;
   std::mt19937 rnd_;
   std::vector<int64_t> shuffle_vec_;
+  RandomPermutation permutation_;  // replaces shuffle_vec_ above kShuffleVectorMaxRows rows
   bool even_dist_;
 };
 }  // namespace dataset
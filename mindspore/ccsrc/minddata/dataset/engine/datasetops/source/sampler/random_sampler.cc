@@ -51,6 +51,8 @@ Status RandomSampler::GetNextSample(std::unique_ptr<DataBuffer> *out_buffer) {
       int64_t sampled_id = 0;
       if (replacement_) {
         sampled_id = (*dist)(rnd_);
+      } else if (shuffled_ids_.empty()) {
+        sampled_id = permutation_(i + next_id_);
       } else {
         sampled_id = shuffled_ids_[static_cast<size_t>(i + next_id_)];
       }
@@ -78,7 +80,9 @@ Status RandomSampler::InitSampler() {
   samples_per_buffer_ = samples_per_buffer_ > num_samples_ ? num_samples_ : samples_per_buffer_;
   rnd_.seed(seed_);
 
-  if (replacement_ == false) {
+  if (replacement_ == false && num_rows_ > kShuffleVectorMaxRows) {
+    permutation_.Init(num_rows_, rnd_());
+  } else if (replacement_ == false) {
     shuffled_ids_.reserve(num_rows_);
     for (int64_t i = 0; i < num_rows_; i++) {
       shuffled_ids_.push_back(i);
@@ -102,7 +106,11 @@ Status RandomSampler::ResetSampler() {
   rnd_.seed(seed_);
 
   if (replacement_ == false && reshuffle_each_epoch_) {
-    std::shuffle(shuffled_ids_.begin(), shuffled_ids_.end(), rnd_);
+    if (shuffled_ids_.empty()) {
+      permutation_.Reseed(rnd_());
+    } else {
+      std::shuffle(shuffled_ids_.begin(), shuffled_ids_.end(), rnd_);
+    }
   }
 
   if (HasChildSampler()) {
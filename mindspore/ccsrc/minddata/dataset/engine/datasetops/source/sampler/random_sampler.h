@@ -21,6 +21,7 @@
 #include <vector>
 
 #include "minddata/dataset/engine/datasetops/source/sampler/sampler.h"
+#include "minddata/dataset/util/random_permutation.h"
 
 namespace mindspore {
 namespace dataset {
@@ -56,6 +57,7 @@ class RandomSampler : public Sampler {
   uint32_t seed_;
   bool replacement_;
   std::vector<int64_t> shuffled_ids_;  // only used for NO REPLACEMENT
+  RandomPermutation permutation_;      // replaces shuffled_ids_ above kShuffleVectorMaxRows rows
   int64_t next_id_;
   std::mt19937 rnd_;
   std::unique_ptr<std::uniform_int_distribution<int64_t>> dist;
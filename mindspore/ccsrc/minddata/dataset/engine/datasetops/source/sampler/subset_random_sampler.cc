@@ -49,7 +49,12 @@ Status SubsetRandomSampler::InitSampler() {
 
   // num_samples_ could be smaller than the total number of input id's.
   // We will shuffle the full set of id's, but only select the first num_samples_ of them later.
-  std::shuffle(indices_.begin(), indices_.end(), rand_gen_);
+  use_permutation_ = static_cast<int64_t>(indices_.size()) > kShuffleVectorMaxRows;
+  if (use_permutation_) {
+    permutation_.Init(static_cast<int64_t>(indices_.size()), rand_gen_());
+  } else {
+    std::shuffle(indices_.begin(), indices_.end(), rand_gen_);
+  }
 
   return Status::OK();
 }
@@ -62,7 +67,11 @@ Status SubsetRandomSampler::ResetSampler() {
 
   // Randomized the indices again.
   rand_gen_.seed(GetSeed());
-  std::shuffle(indices_.begin(), indices_.end(), rand_gen_);
+  if (use_permutation_) {
+    permutation_.Reseed(rand_gen_());
+  } else {
+    std::shuffle(indices_.begin(), indices_.end(), rand_gen_);
+  }
 
   if (HasChildSampler()) {
     RETURN_IF_NOT_OK(child_[0]->ResetSampler());
@@ -96,14 +105,13 @@ Status SubsetRandomSampler::GetNextSample(std::unique_ptr<DataBuffer> *out_buffe
     // Initialize tensor
     auto id_ptr = outputIds->begin<int64_t>();
     while (sample_id_ < last_id) {
-      if (indices_[sample_id_] >= num_rows_) {
-        std::string err_msg =
-          "Generated id is bigger than numRows (out of bound). indices_: " + std::to_string(indices_[sample_id_]) +
-          " num_rows_: " + std::to_string(num_rows_);
+      int64_t sampled_id = indices_[use_permutation_ ? permutation_(sample_id_) : sample_id_];
+      if (sampled_id >= num_rows_) {
+        std::string err_msg = "Generated id is bigger than numRows (out of bound). indices_: " +
+                              std::to_string(sampled_id) + " num_rows_: " + std::to_string(num_rows_);
         RETURN_STATUS_UNEXPECTED(err_msg);
       }
 
-      int64_t sampled_id = indices_[sample_id_];
       if (HasChildSampler()) {
         RETURN_IF_NOT_OK(GetAssociatedChildId(&sampled_id, sampled_id));
       }
@@ -21,6 +21,7 @@
 #include <vector>
 
 #include "minddata/dataset/engine/datasetops/source/sampler/sampler.h"
+#include "minddata/dataset/util/random_permutation.h"
 
 namespace mindspore {
 namespace dataset {
@@ -68,6 +69,10 @@ class SubsetRandomSampler : public Sampler {
 
   // A random number generator.
   std::mt19937 rand_gen_;
+
+  // The order of the indices when there are more than kShuffleVectorMaxRows of them, which are then not shuffled.
+  RandomPermutation permutation_;
+  bool use_permutation_{false};
 };
 }  // namespace dataset
 }  // namespace mindspore
@@ -43,6 +43,7 @@ TextFileOp::Builder::Builder()
   builder_op_connector_size_ = config_manager->op_connector_size();
   builder_rows_per_buffer_ = config_manager->rows_per_buffer();
   builder_worker_connector_size_ = config_manager->worker_connector_size();
+  builder_chunk_size_ = static_cast<int64_t>(config_manager->text_chunk_size()) * 1024 * 1024;
 }
 
 Status TextFileOp::Builder::ValidateInputs() const {
@@ -55,9 +56,10 @@ Status TextFileOp::Builder::ValidateInputs() const {
 Status TextFileOp::Builder::Build(std::shared_ptr<TextFileOp> *op) {
   RETURN_IF_NOT_OK(ValidateInputs());
 
-  // Throttle the number of workers if we have more workers than files!
-  if (static_cast<size_t>(builder_num_workers_) > builder_text_files_list_.size()) {
-    builder_num_workers_ = builder_text_files_list_.size();
+  // Throttle the number of workers if we have more workers than chunks of files!
+  int64_t max_chunks = TextRowIndex::MaxChunks(builder_text_files_list_, builder_chunk_size_);
+  if (builder_num_workers_ > max_chunks) {
+    builder_num_workers_ = static_cast<int32_t>(max_chunks);
     MS_LOG(DEBUG) << "TextFileOp operator parallelism reduced to " << builder_num_workers_ << " workers.";
   }
 
@@ -68,7 +70,7 @@ Status TextFileOp::Builder::Build(std::shared_ptr<TextFileOp> *op) {
   std::shared_ptr<TextFileOp> text_file_op = std::make_shared<TextFileOp>(
     builder_num_workers_, builder_rows_per_buffer_, builder_total_rows_, builder_worker_connector_size_,
     std::move(builder_schema_), builder_text_files_list_, builder_op_connector_size_, builder_shuffle_files_,
-    builder_num_devices_, builder_device_id_, std::move(builder_sampler_));
+    builder_num_devices_, builder_device_id_, std::move(builder_sampler_), builder_chunk_size_);
   RETURN_IF_NOT_OK(text_file_op->Init());
   *op = std::move(text_file_op);
 
@@ -78,7 +80,7 @@ Status TextFileOp::Builder::Build(std::shared_ptr<TextFileOp> *op) {
 TextFileOp::TextFileOp(int32_t num_workers, int64_t rows_per_buffer, int64_t total_rows, int32_t worker_connector_size,
                        std::unique_ptr<DataSchema> schema, std::vector<std::string> text_files_list,
                        int32_t op_connector_size, bool shuffle_files, int32_t num_device, int32_t device_id,
-                       std::shared_ptr<Sampler> sampler)
+                       std::shared_ptr<Sampler> sampler, int64_t chunk_size)
     : ParallelOp(num_workers, op_connector_size, std::move(sampler)),
       device_id_(device_id),
       num_devices_(num_device),
@@ -89,6 +91,7 @@ TextFileOp::TextFileOp(int32_t num_workers, int64_t rows_per_buffer, int64_t tot
       data_schema_(std::move(schema)),
       all_num_rows_(0),
       num_rows_per_shard_(0),
+      chunk_size_(chunk_size),
       filename_index_(std::make_unique<StringIndex>()),
       finished_reading_dataset_(false),
       load_io_block_queue_(true),
@@ -121,7 +124,8 @@ void TextFileOp::Print(std::ostream &out, bool show_all) const {
 Status TextFileOp::Init() {
   RETURN_IF_NOT_OK(filename_index_->insert(text_files_list_));
 
-  int32_t safe_queue_size = static_cast<int32_t>(std::ceil(text_files_list_.size() / num_workers_) + 1);
+  int64_t max_chunks = TextRowIndex::MaxChunks(text_files_list_, chunk_size_);
+  int32_t safe_queue_size = static_cast<int32_t>((max_chunks + num_workers_ - 1) / num_workers_ + 1);
   io_block_queues_.Init(num_workers_, safe_queue_size);
 
   RETURN_IF_NOT_OK(ParallelOp::CreateWorkerConnector(worker_connector_size_));
@@ -156,8 +160,18 @@ Status TextFileOp::LoadFile(const std::string &file, const int64_t start_offset,
     RETURN_STATUS_UNEXPECTED("Failed to open file " + file);
   }
 
-  int64_t rows_each_buffer = 0;
+  // Start at the indexed row before start_offset instead of the beginning of the file.
   int64_t rows_total = 0;
+  auto row_index = filename_row_index_.find(file);
+  if (row_index != filename_row_index_.end()) {
+    int64_t offset = 0;
+    int64_t skip = 0;
+    row_index->second->Seek(start_offset, &offset, &skip);
+    handle.seekg(offset);
+    rows_total = start_offset - skip;
+  }
+
+  int64_t rows_each_buffer = 0;
   std::string line;
   std::unique_ptr<DataBuffer> cur_buffer = std::make_unique<DataBuffer>(0, DataBuffer::BufferFlags::kDeBFlagNone);
   std::unique_ptr<TensorQTable> tensor_table = std::make_unique<TensorQTable>();
@@ -326,10 +340,14 @@ Status TextFileOp::FillIOBlockQueue(const std::vector<int64_t> &i_keys) {
     }
     for (auto file_info : file_index) {
       if (NeedPushFileToBlockQueue(file_info.first, &start_offset, &end_offset, pre_count)) {
-        auto ioBlock =
-          std::make_unique<FilenameBlock>(file_info.second, start_offset, end_offset, IOBlock::kDeIoBlockNone);
-        RETURN_IF_NOT_OK(PushIoBlockQueue(queue_index, std::move(ioBlock)));
-        queue_index = (queue_index + 1) % num_workers_;
+        // A large file goes to the workers in chunks, so that all of them read it.
+        auto chunks = filename_row_index_[file_info.first]->Split(start_offset, end_offset, chunk_size_);
+        for (auto &chunk : chunks) {
+          auto ioBlock =
+            std::make_unique<FilenameBlock>(file_info.second, chunk.first, chunk.second, IOBlock::kDeIoBlockNone);
+          RETURN_IF_NOT_OK(PushIoBlockQueue(queue_index, std::move(ioBlock)));
+          queue_index = (queue_index + 1) % num_workers_;
+        }
       }
 
       pre_count += filename_numrows_[file_info.first];
@@ -438,21 +456,16 @@ Status TextFileOp::operator()() {
 }
 
 int64_t TextFileOp::CountTotalRows(const std::string &file) {
-  std::ifstream handle(file);
-  if (!handle.is_open()) {
+  std::shared_ptr<TextRowIndex> row_index;
+  Status rc = TextRowIndex::Create(file, TextRowIndex::Format::kLine, false, num_workers_, &row_index);
+  if (rc.IsError()) {
+    // An empty index reads the file from its beginning.
     MS_LOG(ERROR) << "Failed to open file: " << file;
+    filename_row_index_[file] = std::make_shared<TextRowIndex>();
     return 0;
   }
-
-  std::string line;
-  int64_t count = 0;
-  while (getline(handle, line)) {
-    if (!line.empty()) {
-      count++;
-    }
-  }
-
-  return count;
+  filename_row_index_[file] = row_index;
+  return row_index->num_rows();
 }
 
 Status TextFileOp::CalculateNumRowsPerShard() {
@@ -28,6 +28,7 @@
 #include "minddata/dataset/engine/data_schema.h"
 #include "minddata/dataset/engine/datasetops/parallel_op.h"
 #include "minddata/dataset/engine/datasetops/source/io_block.h"
+#include "minddata/dataset/engine/datasetops/source/text_row_index.h"
 #include "minddata/dataset/util/queue.h"
 #include "minddata/dataset/util/wait_post.h"
 #include "minddata/dataset/engine/jagged_connector.h"
@@ -121,6 +122,15 @@ class TextFileOp : public ParallelOp {
       return *this;
     }
 
+    // Setter method.
+    // @param chunk_size - the number of bytes of the chunks which the files are split into, 0 to read every file by a
+    //     single worker.
+    // @return Builder - setter method returns reference to the builder.
+    Builder &SetChunkSize(int64_t chunk_size) {
+      builder_chunk_size_ = chunk_size;
+      return *this;
+    }
+
    private:
     int32_t builder_device_id_;
     int32_t builder_num_devices_;
@@ -133,6 +143,7 @@ class TextFileOp : public ParallelOp {
     bool builder_shuffle_files_;
     std::unique_ptr<DataSchema> builder_schema_;
     std::shared_ptr<Sampler> builder_sampler_;
+    int64_t builder_chunk_size_;
   };
 
   // Constructor of TextFileOp
@@ -147,9 +158,12 @@ class TextFileOp : public ParallelOp {
   // @param shuffle_files - whether or not to shuffle the files before reading data.
   // @param equal_rows_per_shard - whether or not to get equal rows for each process.
   // @param sampler - allow a sampler.  Only valid if a cache exists in ascendent tree nodes
+  // @param chunk_size - the number of bytes of the chunks which the files are split into, 0 to read every file by a
+  //     single worker.
   TextFileOp(int32_t num_workers, int64_t rows_per_buffer, int64_t total_rows, int32_t worker_connector_size,
              std::unique_ptr<DataSchema>, std::vector<std::string> text_files_list, int32_t op_connector_size,
-             bool shuffle_files, int32_t num_devices, int32_t device_id, std::shared_ptr<Sampler> sampler);
+             bool shuffle_files, int32_t num_devices, int32_t device_id, std::shared_ptr<Sampler> sampler,
+             int64_t chunk_size = 0);
 
   // Default destructor
   ~TextFileOp() = default;
@@ -214,7 +228,7 @@ class TextFileOp : public ParallelOp {
   // @return Status - the error code returned.
   Status CalculateNumRowsPerShard();
 
-  // Count number of rows in each file.
+  // Count number of rows in each file, and keep the row index of the file for reading it in chunks.
   // @param filename - text file name.
   // @return int64_t - the total number of rows in file.
   int64_t CountTotalRows(const std::string &file);
@@ -276,6 +290,8 @@ class TextFileOp : public ParallelOp {
   int64_t all_num_rows_;
   int64_t num_rows_per_shard_;
   std::map<std::string, int64_t> filename_numrows_;
+  std::map<std::string, std::shared_ptr<TextRowIndex>> filename_row_index_;
+  int64_t chunk_size_;
   std::unique_ptr<StringIndex> filename_index_;
   QueueList<std::unique_ptr<FilenameBlock>> io_block_queues_;
   WaitPost io_block_queue_wait_post_;
@@ -0,0 +1,411 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "minddata/dataset/engine/datasetops/source/text_row_index.h"
+
+#include <sys/stat.h>
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <random>
+
+#include "minddata/dataset/core/config_manager.h"
+#include "minddata/dataset/core/global_context.h"
+#include "minddata/dataset/util/path.h"
+#include "minddata/dataset/util/task_manager.h"
+#include "utils/log_adapter.h"
+
+namespace mindspore {
+namespace dataset {
+namespace {
+constexpr int64_t kScanBlockSize = 4 << 20;
+constexpr int64_t kMinScanRangeSize = 16 << 20;
+constexpr uint64_t kIndexMagic = 0x3258444952545854;  // "TXTRIDX2"
+
+// The states of a CSV scan. They fold the states of the row counting diagram of CsvOp::CsvParser which act the same:
+// START_OF_FILE and END_OF_LINE to kLineStart, UNQUOTE and SECOND_QUOTE to kField.
+enum ScanState : uint8_t { kLineStart = 0, kField, kQuote };
+
+// @return - the first double quote or end of line in [p, end), end if there is none
+const char *FindCsvSpecial(const char *p, const char *end) {
+#if defined(__SSE2__)
+  const __m128i quote = _mm_set1_epi8('"');
+  const __m128i cr = _mm_set1_epi8('\r');
+  const __m128i lf = _mm_set1_epi8('\n');
+  while (end - p >= 16) {
+    __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p));
+    __m128i hit = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(v, quote), _mm_cmpeq_epi8(v, cr)), _mm_cmpeq_epi8(v, lf));
+    int mask = _mm_movemask_epi8(hit);
+    if (mask != 0) {
+      return p + __builtin_ctz(static_cast<unsigned int>(mask));
+    }
+    p += 16;
+  }
+#endif
+  while (p < end && *p != '"' && *p != '\r' && *p != '\n') {
+    ++p;
+  }
+  return p;
+}
+
+// @return - the nanoseconds of the modification time of a file, a file rewritten within a second changes them
+int64_t ModifyTimeNsec(const struct stat &sb) {
+#if defined(_WIN32) || defined(_WIN64)
+  return 0;
+#else
+  return static_cast<int64_t>(sb.st_mtim.tv_nsec);
+#endif
+}
+
+// A scan run by the tasks of a TaskGroup stops when the group is interrupted, for example when another range fails.
+Status CheckInterrupt() {
+  if (TaskManager::FindMe() != nullptr) {
+    RETURN_IF_INTERRUPTED();
+  }
+  return Status::OK();
+}
+
+std::string IndexFileName(const std::string &index_dir, const std::string &file, TextRowIndex::Format format,
+                          bool skip_header) {
+  std::string key = file + "|" + std::to_string(static_cast<int>(format)) + "|" + (skip_header ? "1" : "0");
+  Path index_file = Path(index_dir) / (Path(file).Basename() + "." + std::to_string(std::hash<std::string>()(key)));
+  return index_file.toString() + ".idx";
+}
+}  // namespace
+
+// The result of scanning a byte range. Index 0 is for the case that the range starts out of double quotes, index 1
+// for the case that it starts within them, only the first one is used for lines. The rows of the marks count from
+// the start of the range.
+struct TextRowIndex::ScanResult {
+  int64_t num_rows[2] = {0, 0};
+  uint8_t end_state[2] = {kLineStart, kQuote};
+  std::vector<Mark> marks[2];
+  Status rc;
+
+  // Marks the first record of the range and then every kRowStride-th one.
+  void StartRecord(int i, int64_t offset) {
+    if (num_rows[i] % kRowStride == 0 || marks[i].empty()) {
+      marks[i].push_back({num_rows[i], offset});
+    }
+  }
+
+  void ScanLines(const char *p, const char *end, int64_t offset) {
+    const char *start = p;
+    while (p < end) {
+      if (end_state[0] == kLineStart) {
+        if (*p == '\n') {
+          ++p;
+          continue;
+        }
+        StartRecord(0, offset + (p - start));
+        num_rows[0]++;
+        end_state[0] = kField;
+      }
+      auto eol = static_cast<const char *>(memchr(p, '\n', end - p));
+      if (eol == nullptr) {
+        break;
+      }
+      p = eol + 1;
+      end_state[0] = kLineStart;
+    }
+  }
+
+  void ScanCsv(const char *p, const char *end, int64_t offset) {
+    const char *start = p;
+    while (p < end) {
+      const char *special = FindCsvSpecial(p, end);
+      if (special > p) {
+        for (int i = 0; i < 2; ++i) {
+          if (end_state[i] == kLineStart) {
+            StartRecord(i, offset + (p - start));
+            end_state[i] = kField;
+          }
+        }
+      }
+      if (special == end) {
+        break;
+      }
+      for (int i = 0; i < 2; ++i) {
+        switch (end_state[i]) {
+          case kLineStart:
+            if (*special == '"') {
+              StartRecord(i, offset + (special - start));
+              end_state[i] = kQuote;
+            }
+            break;
+          case kField:
+            if (*special == '"') {
+              end_state[i] = kQuote;
+            } else {
+              num_rows[i]++;
+              end_state[i] = kLineStart;
+            }
+            break;
+          default:
+            if (*special == '"') {
+              end_state[i] = kField;
+            }
+            break;
+        }
+      }
+      p = special + 1;
+    }
+  }
+};
+
+Status TextRowIndex::Create(const std::string &file, Format format, bool skip_header, int32_t num_threads,
+                            std::shared_ptr<TextRowIndex> *index) {
+  struct stat sb;
+  if (stat(file.c_str(), &sb) != 0) {
+    RETURN_STATUS_UNEXPECTED("Failed to open file " + file);
+  }
+  auto new_index = std::make_shared<TextRowIndex>();
+  std::string index_dir = GlobalContext::config_manager()->text_index_dir();
+  std::string index_file;
+  if (!index_dir.empty()) {
+    index_file = IndexFileName(index_dir, file, format, skip_header);
+    if (new_index->Load(index_file, sb.st_size, sb.st_mtime, ModifyTimeNsec(sb)).IsOk()) {
+      *index = std::move(new_index);
+      return Status::OK();
+    }
+  }
+
+  RETURN_IF_NOT_OK(new_index->Scan(file, format, skip_header, num_threads));
+  if (!index_file.empty()) {
+    // The index is only a cache, reading goes on without it.
+    Status rc = new_index->Save(index_file, sb.st_mtime, ModifyTimeNsec(sb));
+    if (rc.IsError()) {
+      MS_LOG(WARNING) << "Failed to save the row index of " << file << ": " << rc.ToString();
+    }
+  }
+  *index = std::move(new_index);
+  return Status::OK();
+}
+
+Status TextRowIndex::Scan(const std::string &file, Format format, bool skip_header, int32_t num_threads) {
+  std::ifstream handle(file, std::ios::binary | std::ios::ate);
+  if (!handle.is_open()) {
+    RETURN_STATUS_UNEXPECTED("Failed to open file " + file);
+  }
+  file_size_ = static_cast<int64_t>(handle.tellg());
+  int64_t begin = 0;
+  if (skip_header) {
+    handle.seekg(0);
+    std::string header;
+    if (getline(handle, header) && !handle.eof()) {
+      begin = static_cast<int64_t>(handle.tellg());
+    } else {
+      begin = file_size_;
+    }
+  }
+  handle.close();
+
+  // Each task scans at least kMinScanRangeSize bytes, so small files take a single one.
+  int64_t scan_size = file_size_ - begin;
+  int64_t num_ranges = std::max<int64_t>(1, std::min<int64_t>(num_threads, scan_size / kMinScanRangeSize));
+  std::vector<ScanResult> results(num_ranges);
+  auto range_begin = [begin, scan_size, num_ranges](int64_t i) { return begin + scan_size * i / num_ranges; };
+  if (num_ranges == 1) {
+    RETURN_IF_NOT_OK(ScanRange(file, format, begin, file_size_, true, &results[0]));
+  } else {
+    // A failed range interrupts the others through the group, and the interrupts of the pipeline reach them too.
+    TaskGroup vg;
+    Status rc;
+    for (int64_t i = 0; i < num_ranges && rc.IsOk(); ++i) {
+      rc = vg.CreateAsyncTask("TextRowIndex scan", [&file, format, i, &range_begin, &results]() -> Status {
+        TaskManager::FindMe()->Post();
+        results[i].rc = ScanRange(file, format, range_begin(i), range_begin(i + 1), i == 0, &results[i]);
+        return results[i].rc;
+      });
+    }
+    if (rc.IsError()) {
+      vg.interrupt_all();
+    }
+    // The tasks use the results and the locals here, so they are joined before any return.
+    (void)vg.join_all(Task::WaitFlag::kBlocking);
+    RETURN_IF_NOT_OK(rc);
+    RETURN_IF_NOT_OK(vg.GetTaskErrorIfAny());
+    // A range stopped by an interrupt is not an error of the group, but its result is incomplete.
+    for (auto &result : results) {
+      RETURN_IF_NOT_OK(result.rc);
+    }
+  }
+
+  // Stitch the ranges in file order, each one continues with the state the previous one ends at.
+  marks_.clear();
+  marks_.push_back({0, begin});
+  num_rows_ = 0;
+  uint8_t state = kLineStart;
+  for (auto &result : results) {
+    int i = state == kQuote ? 1 : 0;
+    for (auto &mark : result.marks[i]) {
+      if (num_rows_ + mark.row > marks_.back().row) {
+        marks_.push_back({num_rows_ + mark.row, mark.offset});
+      }
+    }
+    num_rows_ += result.num_rows[i];
+    state = result.end_state[i];
+  }
+  // The end of file ends the last row of a CSV file as an end of line.
+  if (format == Format::kCsv && state == kField) {
+    num_rows_++;
+  }
+  if (num_rows_ > marks_.back().row) {
+    marks_.push_back({num_rows_, file_size_});
+  }
+  return Status::OK();
+}
+
+Status TextRowIndex::ScanRange(const std::string &file, Format format, int64_t begin, int64_t end,
+                               bool at_file_start, ScanResult *result) {
+  std::ifstream handle(file, std::ios::binary);
+  if (!handle.is_open()) {
+    RETURN_STATUS_UNEXPECTED("Failed to open file " + file);
+  }
+  // Out of double quotes, a range starts a record when the byte before it ends a line.
+  char prev = '\n';
+  if (!at_file_start) {
+    handle.seekg(begin - 1);
+    handle.get(prev);
+  } else {
+    handle.seekg(begin);
+  }
+  bool line_end = format == Format::kCsv ? (prev == '\r' || prev == '\n') : prev == '\n';
+  if (!line_end) {
+    result->end_state[0] = kField;
+  }
+
+  std::vector<char> buffer(std::max<int64_t>(1, std::min(kScanBlockSize, end - begin)));
+  int64_t offset = begin;
+  while (offset < end) {
+    RETURN_IF_NOT_OK(CheckInterrupt());
+    int64_t n = std::min(static_cast<int64_t>(buffer.size()), end - offset);
+    if (!handle.read(buffer.data(), n)) {
+      RETURN_STATUS_UNEXPECTED("Failed to read file " + file);
+    }
+    if (format == Format::kCsv) {
+      result->ScanCsv(buffer.data(), buffer.data() + n, offset);
+    } else {
+      result->ScanLines(buffer.data(), buffer.data() + n, offset);
+    }
+    offset += n;
+  }
+  return Status::OK();
+}
+
+void TextRowIndex::Seek(int64_t row, int64_t *offset, int64_t *skip) const {
+  auto it = std::upper_bound(marks_.begin(), marks_.end(), row,
+                             [](int64_t value, const Mark &mark) { return value < mark.row; });
+  if (it == marks_.begin()) {
+    *offset = 0;
+    *skip = row;
+    return;
+  }
+  --it;
+  *offset = it->offset;
+  *skip = row - it->row;
+}
+
+std::vector<std::pair<int64_t, int64_t>> TextRowIndex::Split(int64_t start_row, int64_t end_row,
+                                                             int64_t chunk_bytes) const {
+  std::vector<std::pair<int64_t, int64_t>> ranges;
+  int64_t first = start_row;
+  int64_t first_offset = 0;
+  int64_t skip = 0;
+  Seek(start_row, &first_offset, &skip);
+  if (chunk_bytes > 0) {
+    auto it = std::upper_bound(marks_.begin(), marks_.end(), start_row,
+                               [](int64_t value, const Mark &mark) { return value < mark.row; });
+    for (; it != marks_.end() && it->row < end_row; ++it) {
+      if (it->offset - first_offset >= chunk_bytes) {
+        ranges.emplace_back(first, it->row);
+        first = it->row;
+        first_offset = it->offset;
+      }
+    }
+  }
+  ranges.emplace_back(first, end_row);
+  return ranges;
+}
+
+int64_t TextRowIndex::MaxChunks(const std::vector<std::string> &files, int64_t chunk_bytes) {
+  int64_t num_chunks = 0;
+  for (auto &file : files) {
+    struct stat sb;
+    num_chunks++;
+    if (chunk_bytes > 0 && stat(file.c_str(), &sb) == 0) {
+      num_chunks += static_cast<int64_t>(sb.st_size) / chunk_bytes;
+    }
+  }
+  return num_chunks;
+}
+
+Status TextRowIndex::Load(const std::string &index_file, int64_t file_size, int64_t mtime, int64_t mtime_nsec) {
+  std::ifstream handle(index_file, std::ios::binary);
+  if (!handle.is_open()) {
+    RETURN_STATUS_UNEXPECTED("Failed to open file " + index_file);
+  }
+  uint64_t magic = 0;
+  // file size, modification time in seconds and its nanoseconds, number of rows, number of marks
+  int64_t header[5] = {0, 0, 0, 0, 0};
+  handle.read(reinterpret_cast<char *>(&magic), sizeof(magic));
+  handle.read(reinterpret_cast<char *>(header), sizeof(header));
+  if (!handle || magic != kIndexMagic || header[0] != file_size || header[1] != mtime || header[2] != mtime_nsec ||
+      header[4] <= 0) {
+    RETURN_STATUS_UNEXPECTED("Row index " + index_file + " is stale");
+  }
+  std::vector<Mark> marks(header[4]);
+  handle.read(reinterpret_cast<char *>(marks.data()), static_cast<std::streamsize>(marks.size() * sizeof(Mark)));
+  if (!handle) {
+    RETURN_STATUS_UNEXPECTED("Failed to read file " + index_file);
+  }
+  file_size_ = file_size;
+  num_rows_ = header[3];
+  marks_ = std::move(marks);
+  return Status::OK();
+}
+
+Status TextRowIndex::Save(const std::string &index_file, int64_t mtime, int64_t mtime_nsec) const {
+  RETURN_IF_NOT_OK(Path(Path(index_file).ParentPath()).CreateDirectories());
+  // Write to a file of its own and rename it, readers in other processes see the whole index or none.
+  std::string tmp_file = index_file + "." + std::to_string(std::random_device()()) + ".tmp";
+  {
+    std::ofstream handle(tmp_file, std::ios::binary | std::ios::trunc);
+    if (!handle.is_open()) {
+      RETURN_STATUS_UNEXPECTED("Failed to open file " + tmp_file);
+    }
+    int64_t header[5] = {file_size_, mtime, mtime_nsec, num_rows_, static_cast<int64_t>(marks_.size())};
+    handle.write(reinterpret_cast<const char *>(&kIndexMagic), sizeof(kIndexMagic));
+    handle.write(reinterpret_cast<const char *>(header), sizeof(header));
+    handle.write(reinterpret_cast<const char *>(marks_.data()),
+                 static_cast<std::streamsize>(marks_.size() * sizeof(Mark)));
+    if (!handle) {
+      (void)remove(tmp_file.c_str());
+      RETURN_STATUS_UNEXPECTED("Failed to write file " + tmp_file);
+    }
+  }
+  if (rename(tmp_file.c_str(), index_file.c_str()) != 0) {
+    (void)remove(tmp_file.c_str());
+    RETURN_STATUS_UNEXPECTED("Failed to write file " + index_file);
+  }
+  return Status::OK();
+}
+}  // namespace dataset
+}  // namespace mindspore
@@ -0,0 +1,110 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_DATASETOPS_SOURCE_TEXT_ROW_INDEX_H_
+#define MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_DATASETOPS_SOURCE_TEXT_ROW_INDEX_H_
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "minddata/dataset/util/status.h"
+
+namespace mindspore {
+namespace dataset {
+// The row index of a text file: the number of rows, and the byte offset of about every kRowStride-th row. With it a
+// reader starts at any row of a file by seeking to an offset and skipping less than kRowStride rows, so a large file
+// is read in chunks by many workers, and the rows of a file are known without parsing it again.
+//
+// The file is scanned by the tasks of a TaskGroup, each one over a byte range of it. A range may start within a
+// record, so for CSV the scan of a range follows both the case that it starts out of double quotes and the case that
+// it starts within them, and the ranges are stitched in file order with the state the previous range ends at.
+//
+// When the index directory is set in the config, the index is saved there and used again while the size and the
+// modification time of the file, in nanoseconds, stay the same.
+class TextRowIndex {
+ public:
+  // How the records of a file are delimited.
+  enum class Format : uint8_t {
+    kLine = 0,  // a record is a non-empty line, as TextFileOp and ClueOp read them
+    kCsv = 1,   // a record ends at an end of line out of double quotes, as CsvOp counts them
+  };
+
+  static constexpr int64_t kRowStride = 1024;
+
+  TextRowIndex() = default;
+
+  ~TextRowIndex() = default;
+
+  // Loads the index of a file from the index directory, or scans the file and saves the index there.
+  // @param file - the file to index.
+  // @param format - how the records are delimited.
+  // @param skip_header - whether the first line holds the column names and is not a record.
+  // @param num_threads - the number of tasks which scan the file.
+  // @param index - the index of the file.
+  // @return Status - the error code returned.
+  static Status Create(const std::string &file, Format format, bool skip_header, int32_t num_threads,
+                       std::shared_ptr<TextRowIndex> *index);
+
+  // @return - the number of rows in the file
+  int64_t num_rows() const { return num_rows_; }
+
+  // @param row - a row in [0, num_rows].
+  // @param offset - the byte offset of a row at or before the given one, the offset of the first byte after the
+  //     last row if row is num_rows.
+  // @param skip - the number of rows between that row and the given one.
+  void Seek(int64_t row, int64_t *offset, int64_t *skip) const;
+
+  // Splits the rows [start_row, end_row) into ranges of about chunk_bytes bytes each. The ranges but the first one
+  // start at an indexed row, so reading them skips no rows.
+  // @param start_row - the first row.
+  // @param end_row - the row after the last one.
+  // @param chunk_bytes - the number of bytes of a range, 0 or less to keep a single range.
+  // @return - the ranges in order.
+  std::vector<std::pair<int64_t, int64_t>> Split(int64_t start_row, int64_t end_row, int64_t chunk_bytes) const;
+
+  // @param files - the files to read.
+  // @param chunk_bytes - the number of bytes of a range, 0 or less to keep a single range.
+  // @return - the largest number of ranges Split makes of the files
+  static int64_t MaxChunks(const std::vector<std::string> &files, int64_t chunk_bytes);
+
+ private:
+  // A row and the byte offset where it starts.
+  struct Mark {
+    int64_t row;
+    int64_t offset;
+  };
+
+  struct ScanResult;
+
+  Status Scan(const std::string &file, Format format, bool skip_header, int32_t num_threads);
+
+  static Status ScanRange(const std::string &file, Format format, int64_t begin, int64_t end, bool at_file_start,
+                          ScanResult *result);
+
+  Status Load(const std::string &index_file, int64_t file_size, int64_t mtime, int64_t mtime_nsec);
+
+  Status Save(const std::string &index_file, int64_t mtime, int64_t mtime_nsec) const;
+
+  int64_t num_rows_{0};
+  int64_t file_size_{0};
+  std::vector<Mark> marks_;
+};
+}  // namespace dataset
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_DATASETOPS_SOURCE_TEXT_ROW_INDEX_H_
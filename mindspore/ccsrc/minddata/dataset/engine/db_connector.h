@@ -84,7 +84,10 @@ class DbConnector : public Connector<std::unique_ptr<DataBuffer>> {
       }
     }
     out_buffers_count_++;
-    cv_.NotifyAll();
+    // A single consumer is always the expected one, it never waits in the cv.
+    if (num_consumers_ > 1) {
+      cv_.NotifyAll();
+    }
     return Status::OK();
   }
 
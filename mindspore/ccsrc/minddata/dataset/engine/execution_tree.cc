@@ -16,6 +16,8 @@
 #include "minddata/dataset/engine/execution_tree.h"
 #include <iostream>
 #include <string>
+#include "minddata/dataset/core/config_manager.h"
+#include "minddata/dataset/core/global_context.h"
 #include "minddata/dataset/engine/datasetops/dataset_op.h"
 #include "minddata/dataset/engine/datasetops/shuffle_op.h"
 #include "minddata/dataset/util/task_manager.h"
@@ -132,6 +134,13 @@ Status ExecutionTree::Launch() {
   std::ostringstream ss;
   ss << *this;
 
+  // The tensors of the pipeline take their buffers from its own pool, which needs to be set before any task starts
+  int32_t tensor_pool_size = GlobalContext::config_manager()->tensor_pool_size();
+  if (tensor_pool_size > 0) {
+    RETURN_IF_NOT_OK(TensorPool::CreateTensorPool(&tensor_pool_, tensor_pool_size));
+    tg_->SetMemoryPool(tensor_pool_);
+  }
+
   // Profiling infrastructures need to be initialized before Op launching
   if (profiling_manager_->IsProfilingEnable()) {
     // Setup profiling manager
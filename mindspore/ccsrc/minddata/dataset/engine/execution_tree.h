@@ -23,6 +23,7 @@
 #include <vector>
 #include "minddata/dataset/engine/datasetops/dataset_op.h"
 #include "minddata/dataset/util/status.h"
+#include "minddata/dataset/util/tensor_pool.h"
 #include "mindspore/ccsrc/minddata/dataset/engine/perf/profiling.h"
 
 namespace mindspore {
@@ -217,6 +218,10 @@ class ExecutionTree {
   // Getter for profiling manager, no ownership
   ProfilingManager *GetProfilingManager() { return profiling_manager_.get(); }
 
+  // Getter for the pool of the tensors created by the tree's threads
+  // @return the tensor pool, nullptr if the tensors take their buffers from the global pool
+  std::shared_ptr<TensorPool> tensor_pool() const { return tensor_pool_; }
+
   // Set optional optimization if tree has not been prepared yet
   Status SetOptimize(bool value) {
     if (tree_state_ != kDeTStateInit && tree_state_ != kDeTStateBuilding) {
@@ -253,6 +258,7 @@ class ExecutionTree {
   int32_t num_epochs_;                                   // Total number of epochs to run for this tree
   std::unique_ptr<Monitor> perf_monitor_;                // Performance Monitor
   std::unique_ptr<ProfilingManager> profiling_manager_;  // Profiling manager
+  std::shared_ptr<TensorPool> tensor_pool_;              // Pool of the tensor buffers, capped by the config
   bool optimize_;                                        // Flag to enable optional optimizations
 };
 
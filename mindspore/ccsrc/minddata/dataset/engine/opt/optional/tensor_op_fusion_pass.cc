@@ -19,6 +19,7 @@
 #include "minddata/dataset/kernels/image/decode_op.h"
 #include "minddata/dataset/engine/datasetops/map_op/map_op.h"
 #include "minddata/dataset/kernels/image/random_crop_decode_resize_op.h"
+#include "minddata/dataset/kernels/image/resize_op.h"
 
 namespace mindspore {
 namespace dataset {
@@ -44,9 +45,21 @@ Status TensorOpFusionPass::RunOnNode(std::shared_ptr<MapOp> node, bool *modified
   if (it != tfuncs.end()) {
     auto next = it + 1;
     auto op = static_cast<RandomCropAndResizeOp *>(next->get());
-    *it = std::static_pointer_cast<TensorOp>(std::make_shared<RandomCropDecodeResizeOp>(*op));
+    auto fused_op = std::make_shared<RandomCropDecodeResizeOp>(*op);
+    fused_op->set_scaled_decode(true);
+    *it = std::static_pointer_cast<TensorOp>(fused_op);
     tfuncs.erase(next);
   }
+
+  // DecodeOp immediately followed by ResizeOp: the decode only has to cover the resized image. The ops may be shared
+  // with other pipelines, so the hint goes to a copy of the DecodeOp.
+  it = std::find_if(tfuncs.begin(), tfuncs.end(), [](const auto &tf) -> bool { return tf->Name() == kDecodeOp; });
+  if (it != tfuncs.end() && it + 1 != tfuncs.end() && (*(it + 1))->Name() == kResizeOp) {
+    auto resize_op = static_cast<ResizeOp *>((it + 1)->get());
+    auto decode_op = std::make_shared<DecodeOp>(*static_cast<DecodeOp *>(it->get()));
+    decode_op->set_size_hint(resize_op->size1(), resize_op->size2());
+    *it = std::static_pointer_cast<TensorOp>(decode_op);
+  }
   if (modified != nullptr) {
     *modified = true;
   } else {
@@ -24,6 +24,8 @@
 #include "minddata/dataset/engine/perf/connector_size.h"
 #include "minddata/dataset/engine/perf/connector_throughput.h"
 #include "minddata/dataset/engine/perf/dataset_iterator_tracing.h"
+#include "minddata/dataset/engine/perf/tensor_pool_usage.h"
+#include "minddata/dataset/engine/execution_tree.h"
 #include "utils/log_adapter.h"
 
 namespace mindspore {
@@ -77,6 +79,12 @@ Status ProfilingManager::Initialize() {
 
   std::shared_ptr<Sampling> connector_thr_sampling = std::make_shared<ConnectorThroughput>(tree_);
   RETURN_IF_NOT_OK(RegisterSamplingNode(connector_thr_sampling));
+
+  // The tensor pool is only there if the config asks for one.
+  if (tree_->tensor_pool() != nullptr) {
+    std::shared_ptr<Sampling> tensor_pool_sampling = std::make_shared<TensorPoolUsage>(tree_->tensor_pool());
+    RETURN_IF_NOT_OK(RegisterSamplingNode(tensor_pool_sampling));
+  }
   return Status::OK();
 }
 
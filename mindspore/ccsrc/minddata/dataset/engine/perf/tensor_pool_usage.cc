@@ -0,0 +1,66 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "minddata/dataset/engine/perf/tensor_pool_usage.h"
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include "minddata/dataset/core/config_manager.h"
+#include "minddata/dataset/core/global_context.h"
+#include "minddata/dataset/util/path.h"
+
+namespace mindspore {
+namespace dataset {
+// Sample action
+Status TensorPoolUsage::Sample() {
+  sample_table_.push_back(pool_->GetStats());
+  return Status::OK();
+}
+
+// Save profiling data to file
+Status TensorPoolUsage::SaveToFile() {
+  std::ofstream os(file_path_, std::ios::trunc);
+  json output;
+  std::shared_ptr<ConfigManager> cfg = GlobalContext::config_manager();
+  output["sampling_interval"] = cfg->monitor_sampling_interval();
+  output["pool_bytes"] = pool_->get_max_size();
+  auto column = [this](uint64_t TensorPool::Stats::*field) {
+    std::vector<uint64_t> values;
+    std::transform(sample_table_.begin(), sample_table_.end(), std::back_inserter(values),
+                   [field](const TensorPool::Stats &stats) { return stats.*field; });
+    return values;
+  };
+  output["in_use_bytes"] = column(&TensorPool::Stats::in_use_bytes);
+  output["idle_bytes"] = column(&TensorPool::Stats::idle_bytes);
+  output["arena_bytes"] = column(&TensorPool::Stats::arena_bytes);
+  output["system_bytes"] = column(&TensorPool::Stats::system_bytes);
+  // The counters only grow, the last stats have the totals.
+  TensorPool::Stats last = pool_->GetStats();
+  output["peak_bytes"] = last.peak_bytes;
+  output["num_alloc"] = last.num_alloc;
+  output["num_cache_hit"] = last.num_cache_hit;
+  output["num_central_hit"] = last.num_central_hit;
+  output["num_system_alloc"] = last.num_system_alloc;
+  os << output;
+  return Status::OK();
+}
+
+Status TensorPoolUsage::Init(const std::string &dir_path, const std::string &device_id) {
+  file_path_ = (Path(dir_path) / Path("tensor_pool_profiling_" + device_id + ".json")).toString();
+  return Status::OK();
+}
+}  // namespace dataset
+}  // namespace mindspore
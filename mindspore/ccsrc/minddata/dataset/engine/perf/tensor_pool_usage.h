@@ -0,0 +1,58 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_MINDDATA_DATASET_TENSOR_POOL_USAGE_H
+#define MINDSPORE_CCSRC_MINDDATA_DATASET_TENSOR_POOL_USAGE_H
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+#include <nlohmann/json.hpp>
+#include "minddata/dataset/engine/perf/profiling.h"
+#include "minddata/dataset/util/tensor_pool.h"
+
+using json = nlohmann::json;
+
+namespace mindspore {
+namespace dataset {
+// Tensor pool usage sampling samples the stats of the tensor pool of the pipeline: the bytes in use, idle in the
+// caches, taken from the arena and from the system allocator, and how the allocations were served.
+// It support JSON serialization for external usage.
+class TensorPoolUsage : public Sampling {
+ public:
+  explicit TensorPoolUsage(std::shared_ptr<TensorPool> pool) : pool_(std::move(pool)) {}
+
+  ~TensorPoolUsage() override = default;
+
+  // Driver function for tensor pool sampling.
+  Status Sample() override;
+
+  std::string Name() const override { return kTensorPoolSamplingName; }
+
+  // Save sampling data to file
+  // @return Status - The error code return
+  Status SaveToFile() override;
+
+  Status Init(const std::string &dir_path, const std::string &device_id) override;
+
+ private:
+  std::shared_ptr<TensorPool> pool_;
+  std::vector<TensorPool::Stats> sample_table_;  // One row of stats for each sample
+};
+}  // namespace dataset
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_MINDDATA_DATASET_TENSOR_POOL_USAGE_H
@@ -33,7 +33,7 @@ DecodeOp::DecodeOp(bool is_rgb_format) : is_rgb_format_(is_rgb_format) {
 Status DecodeOp::Compute(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output) {
   IO_CHECK(input, output);
   if (is_rgb_format_) {  // RGB colour mode
-    return Decode(input, output);
+    return Decode(input, output, target_height_, target_width_);
   } else {  // BGR colour mode
     RETURN_STATUS_UNEXPECTED("Decode BGR is deprecated");
   }
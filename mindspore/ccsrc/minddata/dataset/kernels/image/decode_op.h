@@ -42,8 +42,17 @@ class DecodeOp : public TensorOp {
 
   std::string Name() const override { return kDecodeOp; }
 
+  // Lets the decode of a JPEG scale the image down in the DCT as long as it still covers target_height x
+  // target_width, see JpegCropAndDecode. Set by TensorOpFusionPass when a resize follows the decode.
+  void set_size_hint(int32_t target_height, int32_t target_width) {
+    target_height_ = target_height;
+    target_width_ = target_width;
+  }
+
  private:
   bool is_rgb_format_ = true;
+  int32_t target_height_ = 0;
+  int32_t target_width_ = 0;
 };
 }  // namespace dataset
 }  // namespace mindspore
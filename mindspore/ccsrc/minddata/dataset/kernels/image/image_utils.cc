@@ -127,9 +127,9 @@ bool IsNonEmptyJPEG(const std::shared_ptr<Tensor> &input) {
   return input->SizeInBytes() > kJpegMagicLen && memcmp(input->GetBuffer(), kJpegMagic, kJpegMagicLen) == 0;
 }
 
-Status Decode(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output) {
+Status Decode(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output, int target_h, int target_w) {
   if (IsNonEmptyJPEG(input)) {
-    return JpegCropAndDecode(input, output);
+    return JpegCropAndDecode(input, output, 0, 0, 0, 0, target_h, target_w);
   } else {
     return DecodeCv(input, output);
   }
@@ -264,6 +264,23 @@ static Status JpegSetColorSpace(jpeg_decompress_struct *cinfo) {
   }
 }
 
+int JpegScaleDenom(int h, int w, int target_h, int target_w) {
+  constexpr int kMaxScaleDenom = 8;
+  if (target_h <= 0) {
+    return 1;
+  }
+  for (int denom = kMaxScaleDenom; denom > 1; denom /= 2) {
+    int scaled_h = (h + denom - 1) / denom;
+    int scaled_w = (w + denom - 1) / denom;
+    bool covered = target_w <= 0 ? std::min(scaled_h, scaled_w) >= target_h
+                                 : (scaled_h >= target_h && scaled_w >= target_w);
+    if (covered) {
+      return denom;
+    }
+  }
+  return 1;
+}
+
 void JpegErrorExitCustom(j_common_ptr cinfo) {
   char jpeg_last_error_msg[JMSG_LENGTH_MAX];
   (*(cinfo->err->format_message))(cinfo, jpeg_last_error_msg);
@@ -271,7 +288,7 @@ void JpegErrorExitCustom(j_common_ptr cinfo) {
 }
 
 Status JpegCropAndDecode(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output, int crop_x, int crop_y,
-                         int crop_w, int crop_h) {
+                         int crop_w, int crop_h, int target_h, int target_w) {
   struct jpeg_decompress_struct cinfo;
   auto DestroyDecompressAndReturnError = [&cinfo](const std::string &err) {
     jpeg_destroy_decompress(&cinfo);
@@ -285,17 +302,34 @@ Status JpegCropAndDecode(const std::shared_ptr<Tensor> &input, std::shared_ptr<T
     JpegSetSource(&cinfo, input->GetBuffer(), input->SizeInBytes());
     (void)jpeg_read_header(&cinfo, TRUE);
     RETURN_IF_NOT_OK(JpegSetColorSpace(&cinfo));
-    jpeg_calc_output_dimensions(&cinfo);
   } catch (std::runtime_error &e) {
     return DestroyDecompressAndReturnError(e.what());
   }
   if (crop_x == 0 && crop_y == 0 && crop_w == 0 && crop_h == 0) {
-    crop_w = cinfo.output_width;
-    crop_h = cinfo.output_height;
-  } else if (crop_w == 0 || static_cast<unsigned int>(crop_w + crop_x) > cinfo.output_width || crop_h == 0 ||
-             static_cast<unsigned int>(crop_h + crop_y) > cinfo.output_height) {
+    crop_w = cinfo.image_width;
+    crop_h = cinfo.image_height;
+  } else if (crop_w == 0 || static_cast<unsigned int>(crop_w + crop_x) > cinfo.image_width || crop_h == 0 ||
+             static_cast<unsigned int>(crop_h + crop_y) > cinfo.image_height) {
     return DestroyDecompressAndReturnError("Crop window is not valid");
   }
+  // The scaled image is ceil(image_width / scale_denom) wide, so the rounded out crop window stays inside it and still
+  // covers the target.
+  const int scale_denom = JpegScaleDenom(crop_h, crop_w, target_h, target_w);
+  if (scale_denom > 1) {
+    cinfo.scale_num = 1;
+    cinfo.scale_denom = scale_denom;
+    int crop_right = (crop_x + crop_w + scale_denom - 1) / scale_denom;
+    int crop_bottom = (crop_y + crop_h + scale_denom - 1) / scale_denom;
+    crop_x /= scale_denom;
+    crop_y /= scale_denom;
+    crop_w = crop_right - crop_x;
+    crop_h = crop_bottom - crop_y;
+  }
+  try {
+    jpeg_calc_output_dimensions(&cinfo);
+  } catch (std::runtime_error &e) {
+    return DestroyDecompressAndReturnError(e.what());
+  }
   const int mcu_size = cinfo.min_DCT_scaled_size;
   unsigned int crop_x_aligned = (crop_x / mcu_size) * mcu_size;
   unsigned int crop_w_aligned = crop_w + crop_x - crop_x_aligned;
@@ -88,7 +88,9 @@ Status Resize(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *out
 // supported by opencv, if user need more image analysis capabilities, please compile opencv particularlly.
 // @param input: CVTensor containing the not decoded image 1D bytes
 // @param output: Decoded image Tensor of shape <H,W,C> and type DE_UINT8. Pixel order is RGB
-Status Decode(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output);
+// @param target_h, target_w: size hint of the image needed later, used by JPEG only, see JpegCropAndDecode
+Status Decode(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output, int target_h = 0,
+              int target_w = 0);
 
 Status DecodeCv(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output);
 
@@ -96,8 +98,17 @@ bool IsNonEmptyJPEG(const std::shared_ptr<Tensor> &input);
 
 void JpegSetSource(j_decompress_ptr c_info, const void *data, int64_t data_size);
 
+// Returns the largest libjpeg scale denominator out of 8, 4, 2 and 1 which still decodes an image of h x w to at least
+// target_h x target_w. A target_w of 0 means the shorter side has to reach target_h, a target_h of 0 returns 1.
+int JpegScaleDenom(int h, int w, int target_h, int target_w);
+
+// Returns the decoded crop window of a JPEG image
+// @param x, y, w, h: the crop window in the full size image, all 0 for the whole image
+// @param target_h, target_w: size hint, the smallest image the caller needs from the crop window. The image is
+//     scaled down by 1/2, 1/4 or 1/8 in the DCT when that still covers it, see JpegScaleDenom. The output is then
+//     the scaled down crop window. 0 decodes at full size.
 Status JpegCropAndDecode(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output, int x = 0, int y = 0,
-                         int w = 0, int h = 0);
+                         int w = 0, int h = 0, int target_h = 0, int target_w = 0);
 // Returns Rescaled image
 // @param input: Tensor of shape <H,W,C> or <H,W> and any OpenCv compatible type, see CVTensor.
 // @param rescale: rescale parameter
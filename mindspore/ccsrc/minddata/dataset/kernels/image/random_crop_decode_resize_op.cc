@@ -61,7 +61,12 @@ Status RandomCropDecodeResizeOp::Compute(const std::shared_ptr<Tensor> &input, s
     (void)GetCropBox(h_in, w_in, &x, &y, &crop_height, &crop_width);
 
     std::shared_ptr<Tensor> decoded;
-    RETURN_IF_NOT_OK(JpegCropAndDecode(input, &decoded, x, y, crop_width, crop_height));
+    if (scaled_decode_) {
+      RETURN_IF_NOT_OK(
+        JpegCropAndDecode(input, &decoded, x, y, crop_width, crop_height, target_height_, target_width_));
+    } else {
+      RETURN_IF_NOT_OK(JpegCropAndDecode(input, &decoded, x, y, crop_width, crop_height));
+    }
     return Resize(decoded, output, target_height_, target_width_, 0.0, 0.0, interpolation_);
   }
 }
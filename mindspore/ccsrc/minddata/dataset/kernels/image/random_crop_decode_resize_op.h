@@ -46,6 +46,13 @@ class RandomCropDecodeResizeOp : public RandomCropAndResizeOp {
   Status Compute(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output) override;
 
   std::string Name() const override { return kRandomCropDecodeResizeOp; }
+
+  // Decodes the crop window of a JPEG scaled down in the DCT as long as it still covers the target size, set by
+  // TensorOpFusionPass. The output then differs slightly from a full size decode.
+  void set_scaled_decode(bool scaled_decode) { scaled_decode_ = scaled_decode; }
+
+ private:
+  bool scaled_decode_ = false;
 };
 }  // namespace dataset
 }  // namespace mindspore
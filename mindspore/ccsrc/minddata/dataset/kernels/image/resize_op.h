@@ -57,6 +57,10 @@ class ResizeOp : public TensorOp {
 
   std::string Name() const override { return kResizeOp; }
 
+  int32_t size1() const { return size1_; }
+
+  int32_t size2() const { return size2_; }
+
  protected:
   int32_t size1_;
   int32_t size2_;
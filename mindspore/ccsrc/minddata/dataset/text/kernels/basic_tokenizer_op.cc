@@ -14,8 +14,8 @@
  * limitations under the License.
  */
 #include "minddata/dataset/text/kernels/basic_tokenizer_op.h"
+#include <array>
 #include <memory>
-#include <queue>
 #include <string>
 #include <string_view>
 #include <utility>
@@ -23,120 +23,294 @@
 
 #include "unicode/errorcode.h"
 #include "unicode/normalizer2.h"
+#include "unicode/uchar.h"
+#include "unicode/utf8.h"
 #include "unicode/utypes.h"
 
 namespace mindspore {
 namespace dataset {
+namespace {
+// The classes of characters, as the chain of ops sees them. Control characters become spaces, marks are removed when
+// the text is lower cased and are word characters otherwise. Space characters are the \s of the regex of the
+// tokenizer, punctuation characters are the ASCII punctuation, \p{P} and the CJK characters, each of them is a token.
+enum CharClass : uint8_t { kWordChar, kSpaceChar, kPunctChar, kControlChar, kMarkChar };
+
+constexpr std::array<CharClass, 128> MakeAsciiClasses() {
+  std::array<CharClass, 128> classes{};
+  for (int c = 0; c < 128; c++) {
+    if (c < ' ' || c == 0x7F) {
+      classes[c] = kControlChar;
+    } else if (c == ' ') {
+      classes[c] = kSpaceChar;
+    } else if ((c >= '!' && c <= '/') || (c >= ':' && c <= '@') || (c >= '[' && c <= '`') || (c >= '{' && c <= '~')) {
+      classes[c] = kPunctChar;
+    } else {
+      classes[c] = kWordChar;
+    }
+  }
+  return classes;
+}
+
+constexpr UChar32 kReplacementChar = 0xFFFD;
+constexpr char kReplacementCharUtf8[] = "\xEF\xBF\xBD";
+
+// Most characters of a text are ASCII, they need no ICU property lookup.
+constexpr std::array<CharClass, 128> kAsciiClasses = MakeAsciiClasses();
+
+bool IsCjkChar(UChar32 c) {
+  return (c >= 0x4E00 && c <= 0x9FFF) || (c >= 0x3400 && c <= 0x4DBF) || (c >= 0x20000 && c <= 0x2A6DF) ||
+         (c >= 0x2A700 && c <= 0x2B73F) || (c >= 0x2B740 && c <= 0x2B81F) || (c >= 0x2B820 && c <= 0x2CEAF) ||
+         (c >= 0xF900 && c <= 0xFAFF) || (c >= 0x2F800 && c <= 0x2FA1F);
+}
+
+CharClass GetCharClass(UChar32 c) {
+  if (c >= 0 && c < 0x80) {
+    return kAsciiClasses[c];
+  }
+  switch (u_charType(c)) {
+    case U_CONTROL_CHAR:
+    case U_FORMAT_CHAR:
+      return kControlChar;
+    case U_NON_SPACING_MARK:
+      return kMarkChar;
+    default:
+      break;
+  }
+  if (u_isUWhiteSpace(c)) {
+    return kSpaceChar;
+  }
+  if (u_ispunct(c) || IsCjkChar(c)) {
+    return kPunctChar;
+  }
+  return kWordChar;
+}
+
+// ASCII is unchanged by all the normalization forms except case fold, and every normalization form has a boundary
+// before an ASCII character. So an ASCII character followed by another one or the end of the text normalizes by
+// itself.
+bool IsAsciiAt(const std::string_view &text, size_t i) {
+  return static_cast<uint8_t>(text[i]) < 0x80 && (i + 1 == text.size() || static_cast<uint8_t>(text[i + 1]) < 0x80);
+}
+
+Status GetNormalizer(NormalizeForm form, const icu::Normalizer2 **normalizer) {
+  icu::ErrorCode error;
+  switch (form) {
+    case NormalizeForm::kNone:
+      *normalizer = nullptr;
+      return Status::OK();
+    case NormalizeForm::kNfc:
+      *normalizer = icu::Normalizer2::getNFCInstance(error);
+      break;
+    case NormalizeForm::kNfkc:
+      *normalizer = icu::Normalizer2::getNFKCInstance(error);
+      break;
+    case NormalizeForm::kNfd:
+      *normalizer = icu::Normalizer2::getNFDInstance(error);
+      break;
+    case NormalizeForm::kNfkd:
+      *normalizer = icu::Normalizer2::getNFKDInstance(error);
+      break;
+    default:
+      RETURN_STATUS_UNEXPECTED("unexpected normalize form");
+  }
+  CHECK_FAIL_RETURN_UNEXPECTED(error.isSuccess(), "Get normalizer instance failed.");
+  return Status::OK();
+}
+}  // namespace
 
 const bool BasicTokenizerOp::kDefLowerCase = false;
 const bool BasicTokenizerOp::kDefKeepWhitespace = false;
 const NormalizeForm BasicTokenizerOp::kDefNormalizationForm = NormalizeForm::kNone;
 const bool BasicTokenizerOp::kDefPreserveUnusedToken = true;
 const bool BasicTokenizerOp::kDefWithOffsets = false;
-const char BasicTokenizerOp::kCommonPattern[] =
-  "[!-/]"
-  "|[:-@]"
-  "|[\\[-`]"
-  "|[{-~]"
-  "|[\\p{P}]"
-  "|[\\x{4E00}-\\x{9FFF}]"
-  "|[\\x{3400}-\\x{4DBF}]"
-  "|[\\x{20000}-\\x{2A6DF}]"
-  "|[\\x{2A700}-\\x{2B73F}]"
-  "|[\\x{2B740}-\\x{2B81F}]"
-  "|[\\x{2B820}-\\x{2CEAF}]"
-  "|[\\x{F900}-\\x{FAFF}]"
-  "|[\\x{2F800}-\\x{2FA1F}]";
-const char BasicTokenizerOp::kUnusedPattern[] = "\\[CLS\\]|\\[SEP\\]|\\[UNK\\]|\\[PAD\\]|\\[MASK\\]|\\[unused\\d+\\]|";
 const std::unordered_set<std::string> BasicTokenizerOp::kUnusedWords{"[CLS]", "[SEP]", "[UNK]", "[PAD]", "[MASK]"};
 
 BasicTokenizerOp::BasicTokenizerOp(const bool &lower_case, const bool &keep_whitespace,
                                    const NormalizeForm &normalization_form, const bool &preserve_unused_token,
                                    const bool &with_offsets)
-    : lower_case_(lower_case),
+    : with_offsets_(with_offsets),
+      lower_case_(lower_case),
       keep_whitespace_(keep_whitespace),
-      preserve_unused_token_(preserve_unused_token),
-      with_offsets_(with_offsets),
-      case_fold_(std::make_unique<CaseFoldOp>()),
-      nfd_normalize_(std::make_unique<NormalizeUTF8Op>(NormalizeForm::kNfd)),
       normalization_form_(normalization_form),
-      common_normalize_(std::make_unique<NormalizeUTF8Op>(normalization_form)),
-      replace_accent_chars_(std::make_unique<RegexReplaceOp>("\\p{Mn}", "")),
-      replace_control_chars_(std::make_unique<RegexReplaceOp>("\\p{Cc}|\\p{Cf}", " ")) {
-  std::string delim_pattern = std::string("\\s+|") + kCommonPattern;
-  std::string keep_delim_pattern;
-  if (keep_whitespace_) {
-    keep_delim_pattern = delim_pattern;
+      preserve_unused_token_(preserve_unused_token) {}
+
+void BasicTokenizerOp::AppendCleaned(const std::string_view &text, std::string *output) const {
+  int32_t i = 0;
+  auto length = static_cast<int32_t>(text.size());
+  while (i < length) {
+    int32_t start = i;
+    UChar32 c;
+    U8_NEXT_OR_FFFD(text.data(), i, length, c);
+    switch (GetCharClass(c)) {
+      case kControlChar:
+        output->push_back(' ');
+        break;
+      case kMarkChar:
+        if (!lower_case_) {
+          output->append(text.data() + start, i - start);
+        }
+        break;
+      default:
+        if (c == kReplacementChar) {
+          // Ill-formed bytes come out of the regex ops as U+FFFD.
+          output->append(kReplacementCharUtf8);
+        } else {
+          output->append(text.data() + start, i - start);
+        }
+        break;
+    }
+  }
+}
+
+Status BasicTokenizerOp::AppendNormalized(const std::string_view &text, std::string *output) const {
+  icu::ErrorCode error;
+  const icu::Normalizer2 *normalizer = nullptr;
+  const icu::Normalizer2 *nfd_normalizer = nullptr;
+  if (lower_case_) {
+    normalizer = icu::Normalizer2::getNFKCCasefoldInstance(error);
+    CHECK_FAIL_RETURN_UNEXPECTED(error.isSuccess(), "getNFKCCasefoldInstance failed.");
+    nfd_normalizer = icu::Normalizer2::getNFDInstance(error);
+    CHECK_FAIL_RETURN_UNEXPECTED(error.isSuccess(), "getNFDInstance failed.");
   } else {
-    keep_delim_pattern = kCommonPattern;
+    RETURN_IF_NOT_OK(GetNormalizer(normalization_form_, &normalizer));
   }
-  if (preserve_unused_token_) {
-    keep_delim_pattern = kUnusedPattern + keep_delim_pattern;
-    delim_pattern = kUnusedPattern + delim_pattern;
+  size_t i = 0;
+  while (i < text.size()) {
+    if (IsAsciiAt(text, i)) {
+      char c = text[i++];
+      if (kAsciiClasses[static_cast<uint8_t>(c)] == kControlChar) {
+        c = ' ';
+      } else if (lower_case_ && c >= 'A' && c <= 'Z') {
+        c = static_cast<char>(c - 'A' + 'a');
+      }
+      output->push_back(c);
+      continue;
+    }
+    // The rest goes to ICU up to the next ASCII character which normalizes by itself.
+    size_t end = i + 1;
+    while (end < text.size() && !IsAsciiAt(text, end)) {
+      end++;
+    }
+    std::string_view piece = text.substr(i, end - i);
+    std::string folded, normalized;
+    if (normalizer != nullptr) {
+      icu::StringByteSink<std::string> sink(&folded);
+      normalizer->normalizeUTF8(0, icu::StringPiece(piece.data(), piece.size()), sink, nullptr, error);
+      CHECK_FAIL_RETURN_UNEXPECTED(error.isSuccess(), "normalizeUTF8 failed.");
+      piece = folded;
+    }
+    if (nfd_normalizer != nullptr) {
+      icu::StringByteSink<std::string> sink(&normalized);
+      nfd_normalizer->normalizeUTF8(0, icu::StringPiece(piece.data(), piece.size()), sink, nullptr, error);
+      CHECK_FAIL_RETURN_UNEXPECTED(error.isSuccess(), "normalizeUTF8 failed.");
+      piece = normalized;
+    }
+    AppendCleaned(piece, output);
+    i = end;
   }
-  regex_tokenizer_ = std::make_unique<RegexTokenizerOp>(delim_pattern, keep_delim_pattern, with_offsets_);
+  return Status::OK();
 }
 
-Status BasicTokenizerOp::CaseFoldWithoutUnusedWords(const std::string_view &text,
-                                                    const std::unordered_set<std::string> &unused_words,
-                                                    std::string *outupt) {
-  icu::ErrorCode error;
-  const icu::Normalizer2 *nfkc_case_fold = icu::Normalizer2::getNFKCCasefoldInstance(error);
-  CHECK_FAIL_RETURN_UNEXPECTED(error.isSuccess(), "getNFKCCasefoldInstance failed.");
-  outupt->clear();
-
-  // 1. get start and end offsets of not case fold strs
-  std::queue<std::pair<int, int>> offsets;  // offsets of not used words
-  int start = -1;
-  int len = 0;
-  for (int i = 0; i < text.length(); i++) {
+Status BasicTokenizerOp::NormalizeText(const std::string_view &text, std::string *output) const {
+  output->clear();
+  output->reserve(text.size());
+  if (!lower_case_ || !preserve_unused_token_) {
+    return AppendNormalized(text, output);
+  }
+  // The words in kUnusedWords are not case folded, the pieces between them are normalized one by one.
+  size_t piece_start = 0;
+  size_t word_start = std::string_view::npos;
+  for (size_t i = 0; i < text.size(); i++) {
     if (text[i] == '[') {
-      start = i;
-      ++len;
-    } else if (text[i] == ']' && start >= 0) {
-      ++len;
-      std::string word(text.substr(start, len));
-      if (unused_words.find(word) != unused_words.end()) {
-        offsets.push(std::make_pair(start, start + len - 1));
+      word_start = i;
+    } else if (text[i] == ']' && word_start != std::string_view::npos) {
+      std::string word(text.substr(word_start, i + 1 - word_start));
+      if (kUnusedWords.find(word) != kUnusedWords.end()) {
+        RETURN_IF_NOT_OK(AppendNormalized(text.substr(piece_start, word_start - piece_start), output));
+        output->append(word);
+        piece_start = i + 1;
       }
-      start = -1;
-      len = 0;
-    } else if (start >= 0) {
-      ++len;
+      word_start = std::string_view::npos;
     }
   }
+  return AppendNormalized(text.substr(piece_start), output);
+}
 
-  // 2. Do not apply case fold on `unused_words`
-  start = 0;
-  for (int i = 0; i < text.length();) {
-    std::string_view process_text;
-    std::string preserve_token;
-    if (offsets.empty()) {
-      i = text.length();
-      process_text = text.substr(start, i - start);
-    } else {
-      preserve_token = text.substr(offsets.front().first, offsets.front().second - offsets.front().first + 1);
-      process_text = text.substr(start, offsets.front().first - start);
-      i = offsets.front().second + 1;
-      offsets.pop();
+size_t BasicTokenizerOp::MatchUnusedToken(const std::string &text, size_t pos) const {
+  for (const auto &word : kUnusedWords) {
+    if (text.compare(pos, word.size(), word) == 0) {
+      return pos + word.size();
     }
-    std::string temp;
-    icu::StringByteSink<std::string> sink(&temp);
-    nfkc_case_fold->normalizeUTF8(0, icu::StringPiece(process_text.data(), process_text.size()), sink, nullptr, error);
-    *outupt += temp + preserve_token;
   }
-  return Status::OK();
+  // [unused\d+], \d is any decimal digit of Unicode
+  const std::string_view prefix = "[unused";
+  if (text.compare(pos, prefix.size(), prefix) != 0) {
+    return pos;
+  }
+  auto i = static_cast<int32_t>(pos + prefix.size());
+  auto length = static_cast<int32_t>(text.size());
+  int32_t digits_end = i;
+  while (i < length) {
+    UChar32 c;
+    U8_NEXT(text.data(), i, length, c);
+    if (c < 0 || !u_isdigit(c)) {
+      break;
+    }
+    digits_end = i;
+  }
+  if (digits_end == static_cast<int32_t>(pos + prefix.size()) || digits_end == length || text[digits_end] != ']') {
+    return pos;
+  }
+  return digits_end + 1;
 }
 
-Status BasicTokenizerOp::CaseFoldWithoutUnusedWords(const std::shared_ptr<Tensor> &input,
-                                                    std::shared_ptr<Tensor> *output) {
-  IO_CHECK(input, output);
-  std::vector<std::string> strs(input->Size());
-  int i = 0;
-  for (auto iter = input->begin<std::string_view>(); iter != input->end<std::string_view>(); iter++) {
-    RETURN_IF_NOT_OK(CaseFoldWithoutUnusedWords(*iter, kUnusedWords, &strs[i++]));
+Status BasicTokenizerOp::Tokenize(const std::string &text, std::vector<std::string> *tokens,
+                                  std::vector<uint32_t> *offsets_start, std::vector<uint32_t> *offsets_limit) const {
+  auto add_token = [&](size_t start, size_t end) {
+    tokens->emplace_back(text, start, end - start);
+    offsets_start->push_back(static_cast<uint32_t>(start));
+    offsets_limit->push_back(static_cast<uint32_t>(end));
+  };
+  auto length = static_cast<int32_t>(text.size());
+  int32_t token_start = 0;
+  int32_t i = 0;
+  while (i < length) {
+    // The delimiters are tried in the order of the regex: unused tokens, whitespace, punctuation and CJK.
+    int32_t delim_start = i;
+    bool keep_delim = true;
+    size_t unused_end = preserve_unused_token_ && text[i] == '[' ? MatchUnusedToken(text, i) : i;
+    if (unused_end > static_cast<size_t>(i)) {
+      i = static_cast<int32_t>(unused_end);
+    } else {
+      UChar32 c;
+      U8_NEXT(text.data(), i, length, c);
+      CharClass char_class = GetCharClass(c);
+      if (char_class == kSpaceChar) {
+        int32_t next = i;
+        while (next < length) {
+          U8_NEXT(text.data(), next, length, c);
+          if (GetCharClass(c) != kSpaceChar) {
+            break;
+          }
+          i = next;
+        }
+        keep_delim = keep_whitespace_;
+      } else if (char_class != kPunctChar) {
+        continue;
+      }
+    }
+    if (delim_start > token_start) {
+      add_token(token_start, delim_start);
+    }
+    if (keep_delim) {
+      add_token(delim_start, i);
+    }
+    token_start = i;
   }
-  return Tensor::CreateFromVector(strs, input->shape(), output);
+  if (token_start < length) {
+    add_token(token_start, length);
+  }
+  return Status::OK();
 }
 
 Status BasicTokenizerOp::Compute(const TensorRow &input, TensorRow *output) {
@@ -145,28 +319,23 @@ Status BasicTokenizerOp::Compute(const TensorRow &input, TensorRow *output) {
   if (input[0]->Rank() != 0 || input[0]->type() != DataType::DE_STRING) {
     RETURN_STATUS_UNEXPECTED("The input tensor should be scalar string tensor");
   }
-  std::shared_ptr<Tensor> cur_input;
-  std::shared_ptr<Tensor> processed_tensor;
-  if (lower_case_) {
-    if (!preserve_unused_token_) {
-      // to lower case
-      RETURN_IF_NOT_OK(case_fold_->Compute(input[0], &processed_tensor));
-    } else {
-      // to lower case except words in kUnusedWords
-      RETURN_IF_NOT_OK(CaseFoldWithoutUnusedWords(input[0], &processed_tensor));
-    }
-    cur_input = processed_tensor;
-    // strip accent characters
-    RETURN_IF_NOT_OK(nfd_normalize_->Compute(cur_input, &processed_tensor));
-    cur_input = processed_tensor;
-    RETURN_IF_NOT_OK(replace_accent_chars_->Compute(cur_input, &processed_tensor));
-  } else {
-    RETURN_IF_NOT_OK(common_normalize_->Compute(input[0], &processed_tensor));
+  std::string_view text;
+  RETURN_IF_NOT_OK(input[0]->GetItemAt(&text, {}));
+  std::string normalized;
+  RETURN_IF_NOT_OK(NormalizeText(text, &normalized));
+  std::vector<std::string> tokens;
+  std::vector<uint32_t> offsets_start, offsets_limit;
+  RETURN_IF_NOT_OK(Tokenize(normalized, &tokens, &offsets_start, &offsets_limit));
+  std::shared_ptr<Tensor> token_tensor, offsets_start_tensor, offsets_limit_tensor;
+  RETURN_IF_NOT_OK(Tensor::CreateFromVector(std::move(tokens), &token_tensor));
+  output->push_back(token_tensor);
+  if (with_offsets_) {
+    RETURN_IF_NOT_OK(Tensor::CreateFromVector(offsets_start, &offsets_start_tensor));
+    RETURN_IF_NOT_OK(Tensor::CreateFromVector(offsets_limit, &offsets_limit_tensor));
+    output->push_back(offsets_start_tensor);
+    output->push_back(offsets_limit_tensor);
   }
-  // strip control characters
-  cur_input = processed_tensor;
-  RETURN_IF_NOT_OK(replace_control_chars_->Compute(cur_input, &processed_tensor));
-  return regex_tokenizer_->Compute(TensorRow(0, {std::move(processed_tensor)}), output);
+  return Status::OK();
 }
 }  // namespace dataset
 }  // namespace mindspore
@@ -18,18 +18,19 @@
 #include <memory>
 #include <string>
 #include <unordered_set>
+#include <vector>
 
 #include "minddata/dataset/core/tensor.h"
 #include "minddata/dataset/kernels/tensor_op.h"
-#include "minddata/dataset/text/kernels/case_fold_op.h"
 #include "minddata/dataset/text/kernels/normalize_utf8_op.h"
-#include "minddata/dataset/text/kernels/regex_replace_op.h"
-#include "minddata/dataset/text/kernels/regex_tokenizer_op.h"
 #include "minddata/dataset/util/status.h"
 
 namespace mindspore {
 namespace dataset {
 
+// Normalizes a text and splits it on whitespace, punctuation and CJK characters like the BasicTokenizer of BERT. The
+// result is the same as case fold, NFD, removing \p{Mn}, replacing \p{Cc}|\p{Cf} with a space and a RegexTokenizerOp
+// one after another, but the text is normalized and cleaned in one pass and tokenized in a second one.
 class BasicTokenizerOp : public TensorOp {
  public:
   static const bool kDefLowerCase;
@@ -48,27 +49,32 @@ class BasicTokenizerOp : public TensorOp {
   Status Compute(const TensorRow &input, TensorRow *output) override;
 
  protected:
-  Status CaseFoldWithoutUnusedWords(const std::string_view &text, const std::unordered_set<std::string> &unused_words,
-                                    std::string *outupt);
-  Status CaseFoldWithoutUnusedWords(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output);
+  // Normalize text and replace its control characters with spaces, the words in kUnusedWords are not case folded
+  // when preserve_unused_token is set.
+  Status NormalizeText(const std::string_view &text, std::string *output) const;
+
+  // Split a text from NormalizeText, the offsets are the bytes of the tokens in it.
+  Status Tokenize(const std::string &text, std::vector<std::string> *tokens, std::vector<uint32_t> *offsets_start,
+                  std::vector<uint32_t> *offsets_limit) const;
 
   std::string Name() const override { return kBasicTokenizerOp; }
 
  private:
-  static const char kCommonPattern[];
-  static const char kUnusedPattern[];
+  // Normalize a piece of text which has no word of kUnusedWords in it, and append it to output.
+  Status AppendNormalized(const std::string_view &text, std::string *output) const;
+
+  // Clean a normalized text and append it to output.
+  void AppendCleaned(const std::string_view &text, std::string *output) const;
+
+  // @return the end of the unused token at pos in text, or pos if there is none
+  size_t MatchUnusedToken(const std::string &text, size_t pos) const;
+
   static const std::unordered_set<std::string> kUnusedWords;
   bool with_offsets_;
   bool lower_case_;
   bool keep_whitespace_;
   NormalizeForm normalization_form_;
   bool preserve_unused_token_;
-  std::unique_ptr<CaseFoldOp> case_fold_;
-  std::unique_ptr<NormalizeUTF8Op> nfd_normalize_;
-  std::unique_ptr<NormalizeUTF8Op> common_normalize_;
-  std::unique_ptr<RegexReplaceOp> replace_accent_chars_;
-  std::unique_ptr<RegexReplaceOp> replace_control_chars_;
-  std::unique_ptr<RegexTokenizerOp> regex_tokenizer_;
 };
 }  // namespace dataset
 }  // namespace mindspore
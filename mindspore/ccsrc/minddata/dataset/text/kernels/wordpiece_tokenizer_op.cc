@@ -35,32 +35,31 @@ WordpieceTokenizerOp::WordpieceTokenizerOp(const std::shared_ptr<Vocab> &vocab,
       unknown_token_(unknown_token),
       with_offsets_(with_offsets) {}
 
-Status WordpieceTokenizerOp::LookupWord(const std::string &input_token, const RuneStrArray &runes, const int start,
-                                        bool *out_found, int *out_end) const {
-  CHECK_FAIL_RETURN_UNEXPECTED(start >= 0 && start < input_token.size(), "Out of range");
+Status WordpieceTokenizerOp::LookupWord(const std::string_view &input_token, const RuneStrArray &runes,
+                                        const int start_rune, const int32_t start_node, bool *out_found,
+                                        int *out_end_rune) const {
+  CHECK_FAIL_RETURN_UNEXPECTED(start_rune >= 0 && start_rune < runes.size(), "Out of range");
   *out_found = false;
-  for (int i = runes.size() - 1; i >= 0; i--) {
-    *out_end = runes[i].offset + runes[i].len;
-    int len = *out_end - start;
-    std::string word = input_token.substr(start, len);
-    if (start > 0) {
-      word = suffix_indicator_ + word;
-    }
-    if (vocab_->Lookup(word) != Vocab::kNoTokenExists) {
+  const VocabTrie &trie = vocab_->trie();
+  int32_t node = start_node;
+  // One walk finds every piece from start_rune which is a word, the pieces are never copied.
+  for (int i = start_rune; i < runes.size() && node != VocabTrie::kNoNode; i++) {
+    node = trie.Walk(node, input_token.substr(runes[i].offset, runes[i].len));
+    if (node != VocabTrie::kNoNode && trie.Id(node) != Vocab::kNoTokenExists) {
       *out_found = true;
-      break;
+      *out_end_rune = i + 1;
     }
   }
   return Status::OK();
 }
 
-Status WordpieceTokenizerOp::FoundNoToken(const std::string &input_token, const uint32_t &basic_start,
+Status WordpieceTokenizerOp::FoundNoToken(const std::string_view &input_token, const uint32_t &basic_start,
                                           std::vector<std::string> *out_tokens, std::vector<uint32_t> *offsets_start,
                                           std::vector<uint32_t> *offsets_limit) const {
   out_tokens->clear();
   offsets_start->push_back(basic_start);
   if (unknown_token_.empty()) {
-    out_tokens->emplace_back(input_token);
+    out_tokens->emplace_back(std::string(input_token));
     offsets_limit->push_back(basic_start + input_token.length());
   } else {
     out_tokens->emplace_back(unknown_token_);
@@ -69,18 +68,19 @@ Status WordpieceTokenizerOp::FoundNoToken(const std::string &input_token, const
   return Status::OK();
 }
 
-Status WordpieceTokenizerOp::AddSubword(const std::string &input_token, const int &start, const int &end,
+Status WordpieceTokenizerOp::AddSubword(const std::string_view &input_token, const int &start, const int &end,
                                         std::vector<std::string> *out_tokens) const {
   CHECK_FAIL_RETURN_UNEXPECTED(start >= 0 && end > start && end <= input_token.size(), "Out of range");
-  std::string subword = input_token.substr(start, end - start);
+  std::string subword;
   if (start > 0) {
-    subword = suffix_indicator_ + subword;
+    subword = suffix_indicator_;
   }
-  out_tokens->emplace_back(subword);
+  subword.append(input_token.substr(start, end - start));
+  out_tokens->emplace_back(std::move(subword));
   return Status::OK();
 }
 
-Status WordpieceTokenizerOp::GetTokens(const std::string &input_token, const uint32_t &basic_start,
+Status WordpieceTokenizerOp::GetTokens(const std::string_view &input_token, const uint32_t &basic_start,
                                        std::vector<std::string> *out_tokens, std::vector<uint32_t> *offsets_start,
                                        std::vector<uint32_t> *offsets_limit) const {
   if (input_token.size() > max_bytes_per_token_) {
@@ -89,7 +89,7 @@ Status WordpieceTokenizerOp::GetTokens(const std::string &input_token, const uin
       offsets_limit->push_back(basic_start + unknown_token_.size());
       out_tokens->emplace_back(unknown_token_);
     } else {
-      out_tokens->emplace_back(input_token);
+      out_tokens->emplace_back(std::string(input_token));
       offsets_limit->push_back(basic_start + input_token.size());
     }
     return Status::OK();
@@ -98,15 +98,22 @@ Status WordpieceTokenizerOp::GetTokens(const std::string &input_token, const uin
   if (!DecodeRunesInString(input_token.data(), input_token.size(), runes)) {
     RETURN_STATUS_UNEXPECTED("Decode utf8 string failed.");
   }
-  int end = 0;
-  for (int start = 0; start < input_token.size();) {
+  // The pieces after the first one are looked up with the suffix indicator in front, so their walks start below it.
+  int32_t suffix_node = vocab_->trie().Walk(VocabTrie::kRoot, suffix_indicator_);
+  int end_rune = 0;
+  for (int start_rune = 0; start_rune < runes.size();) {
     bool found = false;
-    RETURN_IF_NOT_OK(LookupWord(input_token, runes, start, &found, &end));
+    int32_t start_node = start_rune > 0 ? suffix_node : VocabTrie::kRoot;
+    if (start_node != VocabTrie::kNoNode) {
+      RETURN_IF_NOT_OK(LookupWord(input_token, runes, start_rune, start_node, &found, &end_rune));
+    }
     if (found) {
+      int start = runes[start_rune].offset;
+      int end = runes[end_rune - 1].offset + runes[end_rune - 1].len;
       RETURN_IF_NOT_OK(AddSubword(input_token, start, end, out_tokens));
       offsets_start->push_back(static_cast<uint32_t>(basic_start + start));
       offsets_limit->push_back(static_cast<uint32_t>(basic_start + end));
-      start = end;
+      start_rune = end_rune;
     } else {
       return FoundNoToken(input_token, basic_start, out_tokens, offsets_start, offsets_limit);
     }
@@ -129,7 +136,7 @@ Status WordpieceTokenizerOp::Compute(const TensorRow &input, TensorRow *output)
     if (with_offsets_ && input.size() == 3) {
       RETURN_IF_NOT_OK(input[1]->GetItemAt<uint32_t>(&basic_start, {count, 0}));
     }
-    RETURN_IF_NOT_OK(GetTokens(std::string(*iter), basic_start, &temp_tokens, &offsets_start, &offsets_limit));
+    RETURN_IF_NOT_OK(GetTokens(*iter, basic_start, &temp_tokens, &offsets_start, &offsets_limit));
     out_tokens.insert(out_tokens.end(), temp_tokens.begin(), temp_tokens.end());
     count++;
   }
@@ -47,14 +47,19 @@ class WordpieceTokenizerOp : public TensorOp {
   Status Compute(const TensorRow &input, TensorRow *output) override;
 
  protected:
-  Status AddSubword(const std::string &input_token, const int &start, const int &end,
+  Status AddSubword(const std::string_view &input_token, const int &start, const int &end,
                     std::vector<std::string> *out_token) const;
-  Status FoundNoToken(const std::string &input_token, const uint32_t &basic_start, std::vector<std::string> *out_tokens,
-                      std::vector<uint32_t> *offsets_start, std::vector<uint32_t> *offsets_limit) const;
-  Status LookupWord(const std::string &input_token, const RuneStrArray &runes, const int start, bool *out_found,
-                    int *out_end) const;
-  Status GetTokens(const std::string &input_token, const uint32_t &basic_start, std::vector<std::string> *out_tokens,
-                   std::vector<uint32_t> *offsets_start, std::vector<uint32_t> *offsets_limit) const;
+  Status FoundNoToken(const std::string_view &input_token, const uint32_t &basic_start,
+                      std::vector<std::string> *out_tokens, std::vector<uint32_t> *offsets_start,
+                      std::vector<uint32_t> *offsets_limit) const;
+  // Walk the vocab trie from start_rune down the runes of input_token, and find the longest piece which is a word.
+  // @param int32_t start_node - the trie node to walk from, the root or the node of the suffix indicator
+  // @param int *out_end_rune - the index of the rune after the longest piece found
+  Status LookupWord(const std::string_view &input_token, const RuneStrArray &runes, const int start_rune,
+                    const int32_t start_node, bool *out_found, int *out_end_rune) const;
+  Status GetTokens(const std::string_view &input_token, const uint32_t &basic_start,
+                   std::vector<std::string> *out_tokens, std::vector<uint32_t> *offsets_start,
+                   std::vector<uint32_t> *offsets_limit) const;
 
   std::string Name() const override { return kWordpieceTokenizerOp; }
 
@@ -22,7 +22,36 @@
 
 namespace mindspore {
 namespace dataset {
-Vocab::Vocab(std::unordered_map<WordType, WordIdType> word2id) { word2id_ = std::move(word2id); }
+VocabTrie::VocabTrie() : nodes_(1) { root_children_.fill(kNoNode); }
+
+void VocabTrie::Insert(std::string_view word, WordIdType id) {
+  int32_t node = kRoot;
+  for (char c : word) {
+    auto byte = static_cast<uint8_t>(c);
+    int32_t child = Child(node, byte);
+    if (child == kNoNode) {
+      child = static_cast<int32_t>(nodes_.size());
+      nodes_.emplace_back();
+      if (node == kRoot) {
+        root_children_[byte] = child;
+      } else {
+        auto &children = nodes_[node].children;
+        auto iter = std::lower_bound(children.begin(), children.end(), byte,
+                                     [](const Edge &edge, uint8_t value) { return edge.byte < value; });
+        (void)children.insert(iter, Edge{byte, child});
+      }
+    }
+    node = child;
+  }
+  nodes_[node].id = id;
+}
+
+Vocab::Vocab(std::unordered_map<WordType, WordIdType> word2id) {
+  word2id_ = std::move(word2id);
+  for (const auto &p : word2id_) {
+    trie_.Insert(p.first, p.second);
+  }
+}
 
 WordIdType Vocab::Lookup(const WordType &word) const {
   auto itr = word2id_.find(word);
@@ -97,7 +126,9 @@ Status Vocab::BuildFromPyDict(const py::dict &words, std::shared_ptr<Vocab> *voc
 
 void Vocab::append_word(const std::string &word) {
   if (word2id_.find(word) == word2id_.end()) {
-    word2id_[word] = word2id_.size();
+    WordIdType id = word2id_.size();
+    word2id_[word] = id;
+    trie_.Insert(word, id);
   }
 }
 
@@ -17,7 +17,10 @@
 #ifndef MINDSPORE_CCSRC_MINDDATA_DATASET_TEXT_VOCAB_H_
 #define MINDSPORE_CCSRC_MINDDATA_DATASET_TEXT_VOCAB_H_
 
+#include <algorithm>
+#include <array>
 #include <string>
+#include <string_view>
 #include <memory>
 #include <unordered_map>
 #include <vector>
@@ -33,6 +36,66 @@ namespace py = pybind11;
 using WordIdType = int32_t;
 using WordType = std::string;
 
+// A byte trie of the words of a vocab. Words are looked up by string_view without building a string, and a walk
+// from a node down the bytes of a text finds all the words which start there in one pass, see WordpieceTokenizerOp.
+class VocabTrie {
+ public:
+  static constexpr int32_t kRoot = 0;
+  static constexpr int32_t kNoNode = -1;
+  // Same as Vocab::kNoTokenExists.
+  static constexpr WordIdType kNoWordId = -1;
+
+  VocabTrie();
+
+  ~VocabTrie() = default;
+
+  // Add a word, or set the id of a word which is already in the trie.
+  void Insert(std::string_view word, WordIdType id);
+
+  // @return the child of node by byte, or kNoNode
+  int32_t Child(int32_t node, uint8_t byte) const {
+    if (node == kRoot) {
+      return root_children_[byte];
+    }
+    const auto &children = nodes_[node].children;
+    auto iter = std::lower_bound(children.begin(), children.end(), byte,
+                                 [](const Edge &edge, uint8_t value) { return edge.byte < value; });
+    return (iter != children.end() && iter->byte == byte) ? iter->child : kNoNode;
+  }
+
+  // @return the node reached from node by the bytes of str, or kNoNode
+  int32_t Walk(int32_t node, std::string_view str) const {
+    for (size_t i = 0; i < str.size() && node != kNoNode; i++) {
+      node = Child(node, static_cast<uint8_t>(str[i]));
+    }
+    return node;
+  }
+
+  // @return the id of the word which ends at node, or kNoWordId
+  WordIdType Id(int32_t node) const { return nodes_[node].id; }
+
+  WordIdType Lookup(std::string_view word) const {
+    int32_t node = Walk(kRoot, word);
+    return node == kNoNode ? kNoWordId : Id(node);
+  }
+
+ private:
+  struct Edge {
+    uint8_t byte;
+    int32_t child;
+  };
+
+  struct Node {
+    // Sorted by byte, so a child is found by binary search.
+    std::vector<Edge> children;
+    WordIdType id{kNoWordId};
+  };
+
+  std::vector<Node> nodes_;
+  // The root has most of the children, it finds them by index.
+  std::array<int32_t, 256> root_children_;
+};
+
 class Vocab {
  public:
   // Build a vocab from a python dictionary key is each word ,id needs to start from 2, no duplicate and continuous
@@ -63,6 +126,9 @@ class Vocab {
   // @return WordIdType, word_id
   WordIdType Lookup(const WordType &word) const;
 
+  // The words of the vocab in a trie, for lookups without building strings
+  const VocabTrie &trie() const { return trie_; }
+
   // constructor, shouldn't be called directly, can't be private due to std::make_unique()
   // @param std::unordered_map<WordType, WordIdType> map - sanitized word2id map
   explicit Vocab(std::unordered_map<WordType, WordIdType> map);
@@ -80,6 +146,7 @@ class Vocab {
 
  private:
   std::unordered_map<WordType, WordIdType> word2id_;
+  VocabTrie trie_;
 };
 
 }  // namespace dataset
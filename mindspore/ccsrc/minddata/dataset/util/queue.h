@@ -16,10 +16,12 @@
 #ifndef MINDSPORE_CCSRC_MINDDATA_DATASET_UTIL_QUEUE_H_
 #define MINDSPORE_CCSRC_MINDDATA_DATASET_UTIL_QUEUE_H_
 
+#include <algorithm>
 #include <atomic>
 #include <memory>
 #include <mutex>
 #include <string>
+#include <thread>
 #include <type_traits>
 #include <utility>
 #include <vector>
@@ -45,7 +47,11 @@ struct is_unique_ptr : public std::false_type {};
 template <typename T>
 struct is_unique_ptr<std::unique_ptr<T>> : public std::true_type {};
 
-// A simple thread safe queue using a fixed size array
+// A bounded thread safe queue on a fixed size array, for any number of producers and consumers. Each slot has a
+// sequence number which tells whether it is free or filled for the current round. A thread claims a slot with a CAS
+// on tail_ (producers) or head_ (consumers) and hands it over by bumping its sequence number, so Add and PopFront
+// take no lock unless they have to wait. A thread which has to wait spins a little, then blocks on a CondVar under
+// mux_. The other side only takes mux_ to wake it up when some thread is waiting.
 template <typename T>
 class Queue {
  public:
@@ -63,6 +69,10 @@ class Queue {
       for (uint64_t i = 0; i < sz_; i++) {
         std::allocator_traits<Allocator<T>>::construct(alloc_, &(arr_[i]));
       }
+      seq_ = std::make_unique<std::atomic<uint64_t>[]>(sz_);
+      for (uint64_t i = 0; i < sz_; i++) {
+        seq_[i].store(i, std::memory_order_relaxed);
+      }
     }
   }
 
@@ -73,6 +83,10 @@ class Queue {
         tail_(0),
         my_name_(Services::GetUniqueID()),
         alloc_(Services::GetInstance().GetServiceMemPool()) {
+    // The slot of a position is found by modulo of the capacity.
+    if (sz <= 0) {
+      MS_LOG(EXCEPTION) << "The capacity of a queue must be positive, but got " << sz << ".";
+    }
     Init();
     MS_LOG(DEBUG) << "Create Q with uuid " << my_name_ << " of size " << sz_ << ".";
   }
@@ -88,26 +102,24 @@ class Queue {
   }
 
   int size() const {
-    int v = tail_ - head_;
-    return (v >= 0) ? v : 0;
+    int64_t v = static_cast<int64_t>(tail_.load(std::memory_order_acquire) - head_.load(std::memory_order_acquire));
+    // The positions are read one after another, so a size taken while the queue is busy may be off by a little.
+    return static_cast<int>(std::min(std::max(v, static_cast<int64_t>(0)), static_cast<int64_t>(sz_)));
   }
 
   int capacity() const { return sz_; }
 
-  bool empty() const { return head_ == tail_; }
+  bool empty() const { return size() == 0; }
 
   void Reset() { ResetQue(); }
 
   // Producer
   Status Add(const_reference ele) noexcept {
-    std::unique_lock<std::mutex> _lock(mux_);
-    // Block when full
-    Status rc = full_cv_.Wait(&_lock, [this]() -> bool { return (size() != capacity()); });
+    uint64_t pos = 0;
+    Status rc = Claim(&full_cv_, &num_waiting_producers_, &tail_, 0, &pos);
     if (rc.IsOk()) {
-      uint32_t k = tail_++ % sz_;
-      arr_[k] = ele;
-      empty_cv_.NotifyAll();
-      _lock.unlock();
+      arr_[pos % sz_] = ele;
+      Publish(pos);
     } else {
       empty_cv_.Interrupt();
     }
@@ -115,14 +127,11 @@ class Queue {
   }
 
   Status Add(T &&ele) noexcept {
-    std::unique_lock<std::mutex> _lock(mux_);
-    // Block when full
-    Status rc = full_cv_.Wait(&_lock, [this]() -> bool { return (size() != capacity()); });
+    uint64_t pos = 0;
+    Status rc = Claim(&full_cv_, &num_waiting_producers_, &tail_, 0, &pos);
     if (rc.IsOk()) {
-      uint32_t k = tail_++ % sz_;
-      arr_[k] = std::forward<T>(ele);
-      empty_cv_.NotifyAll();
-      _lock.unlock();
+      arr_[pos % sz_] = std::forward<T>(ele);
+      Publish(pos);
     } else {
       empty_cv_.Interrupt();
     }
@@ -131,14 +140,11 @@ class Queue {
 
   template <typename... Ts>
   Status EmplaceBack(Ts &&... args) noexcept {
-    std::unique_lock<std::mutex> _lock(mux_);
-    // Block when full
-    Status rc = full_cv_.Wait(&_lock, [this]() -> bool { return (size() != capacity()); });
+    uint64_t pos = 0;
+    Status rc = Claim(&full_cv_, &num_waiting_producers_, &tail_, 0, &pos);
     if (rc.IsOk()) {
-      uint32_t k = tail_++ % sz_;
-      new (&(arr_[k])) T(std::forward<Ts>(args)...);
-      empty_cv_.NotifyAll();
-      _lock.unlock();
+      new (&(arr_[pos % sz_])) T(std::forward<Ts>(args)...);
+      Publish(pos);
     } else {
       empty_cv_.Interrupt();
     }
@@ -147,48 +153,48 @@ class Queue {
 
   // Consumer
   Status PopFront(pointer p) {
-    std::unique_lock<std::mutex> _lock(mux_);
-    // Block when empty
-    Status rc = empty_cv_.Wait(&_lock, [this]() -> bool { return !empty(); });
+    uint64_t pos = 0;
+    Status rc = Claim(&empty_cv_, &num_waiting_consumers_, &head_, 1, &pos);
     if (rc.IsOk()) {
-      uint32_t k = head_++ % sz_;
-      *p = std::move(arr_[k]);
-      if (std::is_destructible<T>::value) {
-        // std::move above only changes arr_[k] from rvalue to lvalue.
-        // The real implementation of move constructor depends on T.
-        // It may be compiler generated or user defined. But either case
-        // the result of arr_[k] is still a valid object of type T, and
-        // we will not keep any extra copy in the queue.
-        arr_[k].~T();
-        // For gcc 9, an extra fix is needed here to clear the memory content
-        // of arr_[k] because this slot can be reused by another Add which can
-        // do another std::move. We have seen SEGV here in this case.
-        std::allocator_traits<Allocator<T>>::construct(alloc_, &(arr_[k]));
-      }
-      full_cv_.NotifyAll();
-      _lock.unlock();
+      Take(pos, p);
     } else {
       full_cv_.Interrupt();
     }
     return rc;
   }
 
+  // Pop the front element if there is one, without waiting.
+  // @return false if the queue is empty
+  bool TryPopFront(pointer p) {
+    uint64_t pos = 0;
+    if (!TryClaim(&head_, 1, &pos)) {
+      return false;
+    }
+    Take(pos, p);
+    return true;
+  }
+
   void ResetQue() noexcept {
     std::unique_lock<std::mutex> _lock(mux_);
     // If there are elements in the queue, invoke its destructor one by one.
-    if (!empty() && std::is_destructible<T>::value) {
-      for (uint64_t i = head_; i < tail_; i++) {
+    uint64_t head = head_.load(std::memory_order_acquire);
+    uint64_t tail = tail_.load(std::memory_order_acquire);
+    if (std::is_destructible<T>::value) {
+      for (uint64_t i = head; i < tail; i++) {
         uint32_t k = i % sz_;
-        arr_[k].~T();
+        if (seq_[k].load(std::memory_order_acquire) == i + 1) {
+          arr_[k].~T();
+        }
       }
     }
     for (uint64_t i = 0; i < sz_; i++) {
       std::allocator_traits<Allocator<T>>::construct(alloc_, &(arr_[i]));
+      seq_[i].store(i, std::memory_order_relaxed);
     }
     empty_cv_.ResetIntrpState();
     full_cv_.ResetIntrpState();
-    head_ = 0;
-    tail_ = 0;
+    head_.store(0, std::memory_order_release);
+    tail_.store(0, std::memory_order_release);
   }
 
   Status Register(TaskGroup *vg) {
@@ -202,10 +208,113 @@ class Queue {
   }
 
  private:
+  // A thread which finds the queue full or empty retries this many times before it blocks, and yields the cpu on all
+  // but the first few of them.
+  static constexpr int kSpinCount = 64;
+  static constexpr int kBusySpinCount = 16;
+
+  // Try to claim the slot at *next, a slot is ready for the claim when its sequence number is its position plus
+  // ready_offset (0 for a free slot to fill, 1 for a filled slot to take).
+  // @return false if the queue is full (or empty)
+  bool TryClaim(std::atomic<uint64_t> *next, uint64_t ready_offset, uint64_t *pos) {
+    uint64_t cur = next->load(std::memory_order_relaxed);
+    while (true) {
+      auto diff = static_cast<int64_t>(seq_[cur % sz_].load(std::memory_order_acquire) - (cur + ready_offset));
+      if (diff == 0) {
+        if (next->compare_exchange_weak(cur, cur + 1, std::memory_order_relaxed)) {
+          *pos = cur;
+          return true;
+        }
+      } else if (diff < 0) {
+        return false;
+      } else {
+        // Another thread claimed the slot, try the next one.
+        cur = next->load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  bool Claimable(const std::atomic<uint64_t> &next, uint64_t ready_offset) const {
+    uint64_t cur = next.load(std::memory_order_relaxed);
+    return static_cast<int64_t>(seq_[cur % sz_].load(std::memory_order_acquire) - (cur + ready_offset)) >= 0;
+  }
+
+  // Claim a slot, wait on cv while there is none.
+  Status Claim(CondVar *cv, std::atomic<int32_t> *num_waiting, std::atomic<uint64_t> *next, uint64_t ready_offset,
+               uint64_t *pos) {
+    // An interrupted queue fails in the wait below, as the locked queue did.
+    if (!cv->Interrupted()) {
+      for (int i = 0; i < kSpinCount; i++) {
+        if (TryClaim(next, ready_offset, pos)) {
+          return Status::OK();
+        }
+        if (i >= kBusySpinCount) {
+          std::this_thread::yield();
+        }
+      }
+    }
+    std::unique_lock<std::mutex> _lock(mux_);
+    num_waiting->fetch_add(1);
+    // Pairs with the fence in WakeUp: either we see the slot, or the other side sees us waiting.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    Status rc;
+    while (true) {
+      rc = cv->Wait(&_lock, [this, next, ready_offset]() { return Claimable(*next, ready_offset); });
+      if (rc.IsError() || TryClaim(next, ready_offset, pos)) {
+        break;
+      }
+      if (cv->Interrupted()) {
+        // The master thread gets an ok from an interrupted wait, it must not wait again.
+        rc = Status(StatusCode::kInterrupted);
+        break;
+      }
+    }
+    num_waiting->fetch_sub(1);
+    return rc;
+  }
+
+  void WakeUp(CondVar *cv, const std::atomic<int32_t> &num_waiting) {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (num_waiting.load(std::memory_order_relaxed) > 0) {
+      std::unique_lock<std::mutex> _lock(mux_);
+      cv->NotifyAll();
+    }
+  }
+
+  // Hand a filled slot over to the consumers.
+  void Publish(uint64_t pos) {
+    seq_[pos % sz_].store(pos + 1, std::memory_order_release);
+    WakeUp(&empty_cv_, num_waiting_consumers_);
+  }
+
+  // Move the element out of a claimed slot and hand the slot back to the producers.
+  void Take(uint64_t pos, pointer p) {
+    uint32_t k = pos % sz_;
+    *p = std::move(arr_[k]);
+    if (std::is_destructible<T>::value) {
+      // std::move above only changes arr_[k] from rvalue to lvalue.
+      // The real implementation of move constructor depends on T.
+      // It may be compiler generated or user defined. But either case
+      // the result of arr_[k] is still a valid object of type T, and
+      // we will not keep any extra copy in the queue.
+      arr_[k].~T();
+      // For gcc 9, an extra fix is needed here to clear the memory content
+      // of arr_[k] because this slot can be reused by another Add which can
+      // do another std::move. We have seen SEGV here in this case.
+      std::allocator_traits<Allocator<T>>::construct(alloc_, &(arr_[k]));
+    }
+    seq_[k].store(pos + sz_, std::memory_order_release);
+    WakeUp(&full_cv_, num_waiting_producers_);
+  }
+
   uint64_t sz_;
   pointer arr_;
-  uint64_t head_;
-  uint64_t tail_;
+  std::unique_ptr<std::atomic<uint64_t>[]> seq_;
+  // The producers and the consumers update their positions all the time, keep them apart.
+  alignas(64) std::atomic<uint64_t> head_;
+  alignas(64) std::atomic<uint64_t> tail_;
+  alignas(64) std::atomic<int32_t> num_waiting_producers_{0};
+  std::atomic<int32_t> num_waiting_consumers_{0};
   std::string my_name_;
   std::mutex mux_;
   CondVar empty_cv_;
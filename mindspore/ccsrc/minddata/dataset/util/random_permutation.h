@@ -0,0 +1,103 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_MINDDATA_DATASET_UTIL_RANDOM_PERMUTATION_H_
+#define MINDSPORE_CCSRC_MINDDATA_DATASET_UTIL_RANDOM_PERMUTATION_H_
+
+#include <array>
+#include <cstdint>
+
+namespace mindspore {
+namespace dataset {
+// Samplers shuffle a vector of ids for datasets up to this many rows, which costs at most 32MB and keeps the order
+// they draw for a seed. Larger datasets are shuffled by a RandomPermutation instead.
+constexpr int64_t kShuffleVectorMaxRows = static_cast<int64_t>(1) << 22;
+
+// A seeded random permutation of [0, size) which takes constant memory: index i maps to permutation(i), and every
+// value in [0, size) comes out exactly once. It is a Feistel network over the smallest domain of 2^(2k) values which
+// holds size, the values out of [0, size) are encrypted again until they fall into it (cycle walking). The domain is
+// less than 4 times the size, so a lookup takes less than 4 encryptions on average. Reseed is as cheap as the
+// constructor, so a new order for each epoch costs nothing.
+class RandomPermutation {
+ public:
+  RandomPermutation() = default;
+
+  // @param int64_t size - the number of values to permute
+  // @param uint64_t seed - the seed of the order
+  RandomPermutation(int64_t size, uint64_t seed) { Init(size, seed); }
+
+  ~RandomPermutation() = default;
+
+  void Init(int64_t size, uint64_t seed) {
+    size_ = static_cast<uint64_t>(size);
+    int bits = 1;
+    while (bits < 64 && (static_cast<uint64_t>(1) << bits) < size_) {
+      bits++;
+    }
+    half_bits_ = (bits + 1) / 2;
+    half_mask_ = (static_cast<uint64_t>(1) << half_bits_) - 1;
+    Reseed(seed);
+  }
+
+  void Reseed(uint64_t seed) {
+    for (auto &key : keys_) {
+      seed += kGoldenGamma;
+      key = Mix(seed);
+    }
+  }
+
+  int64_t size() const { return static_cast<int64_t>(size_); }
+
+  // @param int64_t index - a value in [0, size)
+  // @return - the value at position index of the permutation
+  int64_t operator()(int64_t index) const {
+    auto value = static_cast<uint64_t>(index);
+    do {
+      value = Encrypt(value);
+    } while (value >= size_);
+    return static_cast<int64_t>(value);
+  }
+
+ private:
+  static constexpr int kRoundNum = 4;
+  static constexpr uint64_t kGoldenGamma = 0x9E3779B97F4A7C15ULL;
+
+  // The finalizer of splitmix64.
+  static uint64_t Mix(uint64_t x) {
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+    return x ^ (x >> 31);
+  }
+
+  uint64_t Encrypt(uint64_t value) const {
+    uint64_t left = value >> half_bits_;
+    uint64_t right = value & half_mask_;
+    for (auto key : keys_) {
+      uint64_t next = left ^ (Mix(right ^ key) & half_mask_);
+      left = right;
+      right = next;
+    }
+    return (left << half_bits_) | right;
+  }
+
+  uint64_t size_{0};
+  int half_bits_{0};
+  uint64_t half_mask_{0};
+  std::array<uint64_t, kRoundNum> keys_{};
+};
+}  // namespace dataset
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_MINDDATA_DATASET_UTIL_RANDOM_PERMUTATION_H_
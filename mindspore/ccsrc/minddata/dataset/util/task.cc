@@ -148,6 +148,10 @@ TaskGroup *Task::MyTaskGroup() { return task_group_; }
 
 void Task::set_task_group(TaskGroup *vg) { task_group_ = vg; }
 
+std::shared_ptr<MemoryPool> Task::GetMemoryPool() {
+  return task_group_ == nullptr ? nullptr : task_group_->GetMemoryPool();
+}
+
 Task::~Task() { task_group_ = nullptr; }
 Status Task::OverrideInterruptRc(const Status &rc) {
   if (rc.IsInterrupted() && this_thread::is_master_thread()) {
@@ -97,6 +97,9 @@ class Task : public IntrpResource {
 
   static Status OverrideInterruptRc(const Status &rc);
 
+  // The memory pool of the group of this task, nullptr if the group has none.
+  std::shared_ptr<MemoryPool> GetMemoryPool();
+
  private:
   mutable std::mutex mux_;
   std::string my_name_;
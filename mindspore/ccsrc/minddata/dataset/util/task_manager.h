@@ -25,6 +25,7 @@
 #include <memory>
 #include <string>
 #include <set>
+#include <utility>
 #include "minddata/dataset/util/allocator.h"
 #include "minddata/dataset/util/intrp_service.h"
 #include "minddata/dataset/util/lock.h"
@@ -138,6 +139,12 @@ class TaskGroup : public Service {
 
   std::shared_ptr<IntrpService> GetIntrpService();
 
+  // The tensors created by the tasks of the group take their buffers from this pool. It is set before any task of
+  // the group is created.
+  void SetMemoryPool(std::shared_ptr<MemoryPool> mem_pool) { mem_pool_ = std::move(mem_pool); }
+
+  std::shared_ptr<MemoryPool> GetMemoryPool() const { return mem_pool_; }
+
  private:
   Status rc_;
   // Can't use rw_lock_ as we will lead to deadlatch. Create another mutex to serialize access to rc_.
@@ -145,6 +152,7 @@ class TaskGroup : public Service {
   RWLock rw_lock_;
   List<Task> grp_list_;
   std::shared_ptr<IntrpService> intrp_svc_;
+  std::shared_ptr<MemoryPool> mem_pool_;
 };
 
 namespace this_thread {
@@ -166,6 +174,12 @@ inline Status GetInterruptStatus() {
   Task *my_task = TaskManager::FindMe();
   return my_task->GetInterruptStatus();
 }
+
+// The memory pool of the task group of the calling thread, nullptr if it runs outside of a group with one.
+inline std::shared_ptr<MemoryPool> GetMemoryPool() {
+  Task *my_task = TaskManager::FindMe();
+  return my_task == nullptr ? nullptr : my_task->GetMemoryPool();
+}
 }  // namespace this_thread
 
 #define RETURN_IF_INTERRUPTED()                                            \
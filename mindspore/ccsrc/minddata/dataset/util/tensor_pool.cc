@@ -0,0 +1,389 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "minddata/dataset/util/tensor_pool.h"
+#include <algorithm>
+#include <cstdlib>
+#include <utility>
+#include "./securec.h"
+#include "utils/log_adapter.h"
+
+namespace mindspore {
+namespace dataset {
+namespace {
+// Every block starts with a header. With the header of the arena in front of it, the user address lands on an arena
+// block boundary and keeps the alignment of the arena memory.
+struct BlockHeader {
+  uint64_t size;
+  int32_t size_class;
+  uint32_t reserved;
+  uint64_t padding[2];
+};
+constexpr size_t kHeaderSize = sizeof(BlockHeader);
+static_assert(kHeaderSize == 32, "The header of a tensor pool block must be 32 bytes");
+
+// Blocks too large for the size classes come from the arena directly and go back to it when freed.
+constexpr int kDirectClass = -1;
+// Blocks which did not fit into the arena come from the system allocator.
+constexpr int kSystemClass = -2;
+
+// A thread cache holds at most this much, or a sixteenth of the arena if it is smaller.
+constexpr uint64_t kMaxThreadCacheBytes = 32u << 20;
+// A refill moves up to this many blocks, or this many bytes, from the central list to the thread cache.
+constexpr size_t kMaxRefillBlocks = 16;
+constexpr uint64_t kRefillBytes = 1u << 20;
+
+// Set when the thread caches of the thread are gone, frees during the thread exit go to the central lists.
+thread_local bool gThreadCachesGone = false;
+
+BlockHeader *GetHeader(void *p) { return reinterpret_cast<BlockHeader *>(static_cast<char *>(p) - kHeaderSize); }
+}  // namespace
+
+// The free blocks of one thread for one pool. Other threads only lock it to flush it when the arena is full.
+struct TensorPool::ThreadCache {
+  std::mutex mux;
+  uint64_t pool_id;
+  std::weak_ptr<TensorPool> owner;
+  std::vector<std::vector<void *>> blocks;
+  uint64_t bytes{0};
+};
+
+// All the thread caches of one thread. They go back to their pools when the thread exits.
+struct TensorPool::ThreadCacheList {
+  ThreadCacheList() = default;
+
+  ~ThreadCacheList() {
+    gThreadCachesGone = true;
+    for (auto &cache : caches) {
+      std::shared_ptr<TensorPool> pool = cache->owner.lock();
+      if (pool != nullptr) {
+        pool->RemoveThreadCache(cache.get());
+      }
+    }
+  }
+
+  std::vector<std::unique_ptr<ThreadCache>> caches;
+};
+
+std::atomic<uint64_t> TensorPool::next_pool_id_{0};
+
+TensorPool::TensorPool(size_t val_in_MB)
+    : pool_id_(next_pool_id_++),
+      size_in_MB_(val_in_MB),
+      thread_cache_bytes_(std::min(kMaxThreadCacheBytes, static_cast<uint64_t>(val_in_MB) * 1048576L / 16)),
+      arena_(nullptr),
+      central_(std::make_unique<CentralList[]>(kNumClasses)) {}
+
+TensorPool::~TensorPool() = default;
+
+Status TensorPool::CreateTensorPool(std::shared_ptr<TensorPool> *p_pool, size_t val_in_MB) {
+  RETURN_UNEXPECTED_IF_NULL(p_pool);
+  if (val_in_MB == 0) {
+    RETURN_STATUS_UNEXPECTED("The size of a tensor pool must be positive.");
+  }
+  std::shared_ptr<TensorPool> pool(new TensorPool(val_in_MB));
+  RETURN_IF_NOT_OK(Arena::CreateArena(&pool->arena_, val_in_MB));
+  *p_pool = std::move(pool);
+  return Status::OK();
+}
+
+int TensorPool::SizeToClass(size_t n) {
+  if (n <= (static_cast<size_t>(1) << kMinClassShift)) {
+    return 0;
+  }
+  // The class of n is the smallest of 2^shift * (1 + k / 4), k in [1, 4], which is not less than n.
+  size_t m = n - 1;
+  int shift = kMinClassShift;
+  while ((m >> (shift + 1)) != 0) {
+    shift++;
+  }
+  if (shift >= kMaxClassShift) {
+    return kDirectClass;
+  }
+  auto k = static_cast<int>((m >> (shift - 2)) & 3);
+  return (shift - kMinClassShift) * 4 + k + 1;
+}
+
+size_t TensorPool::ClassToSize(int size_class) {
+  if (size_class == 0) {
+    return static_cast<size_t>(1) << kMinClassShift;
+  }
+  int shift = kMinClassShift + (size_class - 1) / 4;
+  auto k = static_cast<size_t>((size_class - 1) % 4);
+  return (static_cast<size_t>(1) << shift) + (k + 1) * (static_cast<size_t>(1) << (shift - 2));
+}
+
+TensorPool::ThreadCache *TensorPool::MyThreadCache() {
+  if (gThreadCachesGone) {
+    return nullptr;
+  }
+  static thread_local ThreadCacheList cache_list;
+  auto &caches = cache_list.caches;
+  for (auto it = caches.begin(); it != caches.end();) {
+    if ((*it)->pool_id == pool_id_) {
+      return it->get();
+    }
+    // The blocks of a pool which is gone went away with its arena.
+    if ((*it)->owner.expired()) {
+      it = caches.erase(it);
+    } else {
+      ++it;
+    }
+  }
+  auto cache = std::make_unique<ThreadCache>();
+  cache->pool_id = pool_id_;
+  cache->owner = weak_from_this();
+  cache->blocks.resize(kNumClasses);
+  {
+    std::lock_guard<std::mutex> lck(thread_caches_mux_);
+    thread_caches_.push_back(cache.get());
+  }
+  caches.push_back(std::move(cache));
+  return caches.back().get();
+}
+
+void TensorPool::AddInUse(uint64_t sz) {
+  uint64_t in_use = in_use_bytes_.fetch_add(sz, std::memory_order_relaxed) + sz;
+  uint64_t peak = peak_bytes_.load(std::memory_order_relaxed);
+  while (in_use > peak && !peak_bytes_.compare_exchange_weak(peak, in_use, std::memory_order_relaxed)) {
+  }
+}
+
+Status TensorPool::Allocate(size_t n, void **p) {
+  RETURN_UNEXPECTED_IF_NULL(p);
+  if (n == 0) {
+    *p = nullptr;
+    return Status::OK();
+  }
+  num_alloc_.fetch_add(1, std::memory_order_relaxed);
+  int size_class = SizeToClass(n);
+  if (size_class == kDirectClass) {
+    return AllocateBlock(kDirectClass, n, p);
+  }
+  uint64_t sz = ClassToSize(size_class);
+  ThreadCache *cache = MyThreadCache();
+  void *q = nullptr;
+  if (cache != nullptr) {
+    std::lock_guard<std::mutex> lck(cache->mux);
+    auto &blocks = cache->blocks[size_class];
+    if (!blocks.empty()) {
+      num_cache_hit_.fetch_add(1, std::memory_order_relaxed);
+    } else {
+      RefillFromCentral(size_class, cache);
+    }
+    if (!blocks.empty()) {
+      q = blocks.back();
+      blocks.pop_back();
+      cache->bytes -= sz;
+    }
+  } else {
+    CentralList &central = central_[size_class];
+    std::lock_guard<std::mutex> lck(central.mux);
+    if (!central.blocks.empty()) {
+      num_central_hit_.fetch_add(1, std::memory_order_relaxed);
+      q = central.blocks.back();
+      central.blocks.pop_back();
+    }
+  }
+  if (q == nullptr) {
+    return AllocateBlock(size_class, sz, p);
+  }
+  idle_bytes_.fetch_sub(sz, std::memory_order_relaxed);
+  AddInUse(sz);
+  *p = q;
+  return Status::OK();
+}
+
+Status TensorPool::AllocateBlock(int size_class, size_t size, void **p) {
+  void *base = nullptr;
+  Status rc = arena_->Allocate(size + kHeaderSize, &base);
+  if (rc.IsOutofMemory()) {
+    // Give the idle blocks of every thread back to the arena, a block of the right size may come out of them.
+    FlushThreadCaches();
+    ReleaseIdle();
+    rc = arena_->Allocate(size + kHeaderSize, &base);
+  }
+  if (rc.IsOutofMemory()) {
+    base = malloc(size + kHeaderSize);
+    if (base == nullptr) {
+      return Status(StatusCode::kOutOfMemory, __LINE__, __FILE__);
+    }
+    size_class = kSystemClass;
+    num_system_alloc_.fetch_add(1, std::memory_order_relaxed);
+    system_bytes_.fetch_add(size, std::memory_order_relaxed);
+  } else {
+    RETURN_IF_NOT_OK(rc);
+    arena_bytes_.fetch_add(size, std::memory_order_relaxed);
+  }
+  auto *hdr = static_cast<BlockHeader *>(base);
+  hdr->size = size;
+  hdr->size_class = size_class;
+  AddInUse(size);
+  *p = static_cast<char *>(base) + kHeaderSize;
+  return Status::OK();
+}
+
+void TensorPool::RefillFromCentral(int size_class, ThreadCache *cache) {
+  uint64_t sz = ClassToSize(size_class);
+  size_t num = std::max(static_cast<size_t>(1), std::min(kMaxRefillBlocks, static_cast<size_t>(kRefillBytes / sz)));
+  auto &blocks = cache->blocks[size_class];
+  CentralList &central = central_[size_class];
+  std::lock_guard<std::mutex> lck(central.mux);
+  if (central.blocks.empty()) {
+    return;
+  }
+  num_central_hit_.fetch_add(1, std::memory_order_relaxed);
+  num = std::min(num, central.blocks.size());
+  blocks.insert(blocks.end(), central.blocks.end() - num, central.blocks.end());
+  central.blocks.resize(central.blocks.size() - num);
+  cache->bytes += num * sz;
+}
+
+void TensorPool::MoveToCentral(int size_class, ThreadCache *cache, size_t keep) {
+  auto &blocks = cache->blocks[size_class];
+  if (blocks.size() <= keep) {
+    return;
+  }
+  size_t num = blocks.size() - keep;
+  CentralList &central = central_[size_class];
+  {
+    std::lock_guard<std::mutex> lck(central.mux);
+    central.blocks.insert(central.blocks.end(), blocks.begin() + keep, blocks.end());
+  }
+  blocks.resize(keep);
+  cache->bytes -= num * ClassToSize(size_class);
+}
+
+void TensorPool::Deallocate(void *p) {
+  if (p == nullptr) {
+    return;
+  }
+  BlockHeader *hdr = GetHeader(p);
+  uint64_t sz = hdr->size;
+  in_use_bytes_.fetch_sub(sz, std::memory_order_relaxed);
+  if (hdr->size_class == kSystemClass) {
+    system_bytes_.fetch_sub(sz, std::memory_order_relaxed);
+    free(hdr);
+  } else if (hdr->size_class == kDirectClass) {
+    arena_bytes_.fetch_sub(sz, std::memory_order_relaxed);
+    arena_->Deallocate(hdr);
+  } else {
+    FreeBlock(p);
+  }
+}
+
+void TensorPool::FreeBlock(void *p) {
+  int size_class = GetHeader(p)->size_class;
+  uint64_t sz = ClassToSize(size_class);
+  idle_bytes_.fetch_add(sz, std::memory_order_relaxed);
+  ThreadCache *cache = MyThreadCache();
+  if (cache == nullptr || sz > thread_cache_bytes_) {
+    CentralList &central = central_[size_class];
+    std::lock_guard<std::mutex> lck(central.mux);
+    central.blocks.push_back(p);
+    return;
+  }
+  std::lock_guard<std::mutex> cache_lck(cache->mux);
+  auto &blocks = cache->blocks[size_class];
+  blocks.push_back(p);
+  cache->bytes += sz;
+  if (cache->bytes > thread_cache_bytes_) {
+    // Share half of the blocks of this class with the other threads. If the other classes still take too much of
+    // the budget, the thread cache is emptied.
+    MoveToCentral(size_class, cache, blocks.size() / 2);
+    if (cache->bytes > thread_cache_bytes_) {
+      for (int i = 0; i < kNumClasses; ++i) {
+        MoveToCentral(i, cache, 0);
+      }
+    }
+  }
+}
+
+Status TensorPool::Reallocate(void **p, size_t old_sz, size_t new_sz) {
+  RETURN_UNEXPECTED_IF_NULL(p);
+  void *q = nullptr;
+  RETURN_IF_NOT_OK(Allocate(new_sz, &q));
+  if (*p != nullptr && q != nullptr) {
+    size_t copy_sz = std::min(old_sz, new_sz);
+    errno_t err = memcpy_s(q, new_sz, *p, copy_sz);
+    if (err) {
+      Deallocate(q);
+      RETURN_STATUS_UNEXPECTED("Error from memcpy: " + std::to_string(err));
+    }
+  }
+  Deallocate(*p);
+  *p = q;
+  return Status::OK();
+}
+
+void TensorPool::ReleaseIdle() {
+  for (int i = 0; i < kNumClasses; ++i) {
+    std::vector<void *> blocks;
+    {
+      std::lock_guard<std::mutex> lck(central_[i].mux);
+      blocks.swap(central_[i].blocks);
+    }
+    for (void *p : blocks) {
+      arena_->Deallocate(GetHeader(p));
+    }
+    idle_bytes_.fetch_sub(blocks.size() * ClassToSize(i), std::memory_order_relaxed);
+    arena_bytes_.fetch_sub(blocks.size() * ClassToSize(i), std::memory_order_relaxed);
+  }
+}
+
+// A thread holds the lock of its cache only while it does not wait for thread_caches_mux_, so taking the cache locks
+// under thread_caches_mux_ does not deadlock.
+void TensorPool::FlushThreadCaches() {
+  std::lock_guard<std::mutex> lck(thread_caches_mux_);
+  for (ThreadCache *cache : thread_caches_) {
+    std::lock_guard<std::mutex> cache_lck(cache->mux);
+    for (int i = 0; i < kNumClasses; ++i) {
+      MoveToCentral(i, cache, 0);
+    }
+  }
+}
+
+void TensorPool::RemoveThreadCache(ThreadCache *cache) {
+  std::lock_guard<std::mutex> lck(thread_caches_mux_);
+  thread_caches_.erase(std::remove(thread_caches_.begin(), thread_caches_.end(), cache), thread_caches_.end());
+  std::lock_guard<std::mutex> cache_lck(cache->mux);
+  for (int i = 0; i < kNumClasses; ++i) {
+    MoveToCentral(i, cache, 0);
+  }
+}
+
+uint64_t TensorPool::get_max_size() const { return arena_->get_max_size() - kHeaderSize; }
+
+int TensorPool::PercentFree() const {
+  uint64_t size_in_bytes = static_cast<uint64_t>(size_in_MB_) * 1048576L;
+  uint64_t used = std::min(arena_bytes_.load(std::memory_order_relaxed), size_in_bytes);
+  return static_cast<int>((size_in_bytes - used) * 100 / size_in_bytes);
+}
+
+TensorPool::Stats TensorPool::GetStats() const {
+  Stats stats{};
+  stats.in_use_bytes = in_use_bytes_.load(std::memory_order_relaxed);
+  stats.peak_bytes = peak_bytes_.load(std::memory_order_relaxed);
+  stats.idle_bytes = idle_bytes_.load(std::memory_order_relaxed);
+  stats.arena_bytes = arena_bytes_.load(std::memory_order_relaxed);
+  stats.system_bytes = system_bytes_.load(std::memory_order_relaxed);
+  stats.num_alloc = num_alloc_.load(std::memory_order_relaxed);
+  stats.num_cache_hit = num_cache_hit_.load(std::memory_order_relaxed);
+  stats.num_central_hit = num_central_hit_.load(std::memory_order_relaxed);
+  stats.num_system_alloc = num_system_alloc_.load(std::memory_order_relaxed);
+  return stats;
+}
+}  // namespace dataset
+}  // namespace mindspore
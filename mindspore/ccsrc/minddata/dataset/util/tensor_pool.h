@@ -0,0 +1,144 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_MINDDATA_DATASET_UTIL_TENSOR_POOL_H_
+#define MINDSPORE_CCSRC_MINDDATA_DATASET_UTIL_TENSOR_POOL_H_
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include "minddata/dataset/util/arena.h"
+#include "minddata/dataset/util/memory_pool.h"
+
+namespace mindspore {
+namespace dataset {
+// A memory pool for the buffers of tensors, built on top of an Arena which caps its size.
+//
+// Requests are rounded up to a size class, there are four classes between two powers of two so at most 25% is
+// wasted. A freed block goes to a cache of the freeing thread, and the next allocation of its class on that thread
+// takes it back under the lock of that cache, which no other thread takes unless the arena is full. A thread cache which grows beyond its budget moves blocks to the central free list of
+// the class, where the other threads refill from. So a buffer allocated by one worker and freed by another one goes
+// back to the pool, and is reused without touching the system allocator or faulting pages in again.
+//
+// When the arena is full, the idle blocks of all the thread caches and the central lists go back to the arena and the
+// allocation is retried.
+// If the arena is still full the block comes from the system allocator, so that a pipeline which needs more than the
+// cap keeps running; the stats count these blocks.
+class TensorPool : public MemoryPool, public std::enable_shared_from_this<TensorPool> {
+ public:
+  struct Stats {
+    uint64_t in_use_bytes;      // bytes of the blocks handed out, rounded up to their size class
+    uint64_t peak_bytes;        // the largest in_use_bytes so far
+    uint64_t idle_bytes;        // bytes of the blocks in the thread caches and the central lists
+    uint64_t arena_bytes;       // bytes of the blocks taken from the arena, in use or idle
+    uint64_t system_bytes;      // bytes of the blocks in use which come from the system allocator
+    uint64_t num_alloc;         // number of allocations
+    uint64_t num_cache_hit;     // allocations served by the cache of the calling thread
+    uint64_t num_central_hit;   // allocations served by a central free list
+    uint64_t num_system_alloc;  // allocations which did not fit into the arena
+  };
+
+  TensorPool(const TensorPool &) = delete;
+
+  TensorPool &operator=(const TensorPool &) = delete;
+
+  ~TensorPool() override;
+
+  Status Allocate(size_t n, void **p) override;
+
+  Status Reallocate(void **p, size_t old_sz, size_t new_sz) override;
+
+  void Deallocate(void *p) override;
+
+  uint64_t get_max_size() const override;
+
+  int PercentFree() const override;
+
+  Stats GetStats() const;
+
+  // Return the blocks in the central free lists to the arena. The thread caches are left alone.
+  void ReleaseIdle();
+
+  // Move the blocks in the caches of all the threads to the central free lists.
+  void FlushThreadCaches();
+
+  // @param p_pool - the created pool
+  // @param val_in_MB - the size of the arena, which caps the memory of the pool
+  static Status CreateTensorPool(std::shared_ptr<TensorPool> *p_pool, size_t val_in_MB);
+
+  // @param n - the requested size
+  // @return - the index of the smallest size class which holds n bytes, or -1 if n is larger than all the classes
+  static int SizeToClass(size_t n);
+
+  // @return - the size of the blocks of the size class
+  static size_t ClassToSize(int size_class);
+
+  static constexpr int kMinClassShift = 6;
+  static constexpr int kMaxClassShift = 26;
+  static constexpr int kNumClasses = (kMaxClassShift - kMinClassShift) * 4 + 1;
+
+ private:
+  struct ThreadCache;
+  struct ThreadCacheList;
+
+  // The free blocks of one size class which are shared by all the threads.
+  struct CentralList {
+    std::mutex mux;
+    std::vector<void *> blocks;
+  };
+
+  explicit TensorPool(size_t val_in_MB);
+
+  ThreadCache *MyThreadCache();
+
+  Status AllocateBlock(int size_class, size_t size, void **p);
+
+  void FreeBlock(void *p);
+
+  void RefillFromCentral(int size_class, ThreadCache *cache);
+
+  void MoveToCentral(int size_class, ThreadCache *cache, size_t keep);
+
+  // Called when the thread of the cache exits, its blocks go to the central free lists.
+  void RemoveThreadCache(ThreadCache *cache);
+
+  void AddInUse(uint64_t sz);
+
+  static std::atomic<uint64_t> next_pool_id_;
+
+  uint64_t pool_id_;
+  size_t size_in_MB_;
+  uint64_t thread_cache_bytes_;
+  std::shared_ptr<Arena> arena_;
+  std::unique_ptr<CentralList[]> central_;
+  // The caches of the threads which use the pool, so that an allocation which finds the arena full can flush them.
+  std::mutex thread_caches_mux_;
+  std::vector<ThreadCache *> thread_caches_;
+  std::atomic<uint64_t> in_use_bytes_{0};
+  std::atomic<uint64_t> peak_bytes_{0};
+  std::atomic<uint64_t> idle_bytes_{0};
+  std::atomic<uint64_t> arena_bytes_{0};
+  std::atomic<uint64_t> system_bytes_{0};
+  std::atomic<uint64_t> num_alloc_{0};
+  std::atomic<uint64_t> num_cache_hit_{0};
+  std::atomic<uint64_t> num_central_hit_{0};
+  std::atomic<uint64_t> num_system_alloc_{0};
+};
+}  // namespace dataset
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_MINDDATA_DATASET_UTIL_TENSOR_POOL_H_
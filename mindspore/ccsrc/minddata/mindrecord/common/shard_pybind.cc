@@ -75,6 +75,9 @@ void BindShardWriter(py::module *m) {
     .def("set_header_size", &ShardWriter::SetHeaderSize)
     .def("set_page_size", &ShardWriter::SetPageSize)
     .def("set_shard_header", &ShardWriter::SetShardHeader)
+    .def("set_blob_compression", &ShardWriter::SetBlobCompression)
+    .def("set_generate_index", &ShardWriter::SetGenerateIndex)
+    .def("is_index_generated", &ShardWriter::IsIndexGenerated)
     .def("write_raw_data", (MSRStatus(ShardWriter::*)(std::map<uint64_t, std::vector<py::handle>> &,
                                                       vector<vector<uint8_t>> &, bool, bool)) &
                              ShardWriter::WriteRawData)
@@ -68,6 +68,9 @@ enum LabelCategory { kSchemaLabel, kStatisticsLabel, kIndexLabel };
 const char kVersion[] = "3.0";
 const std::vector<std::string> kSupportedVersion = {"2.0", kVersion};
 
+// codec of the blobs which is recorded in the header, the blobs are not compressed if it is absent
+const char kBlobCompressionLz4[] = "lz4";
+
 enum ShardType {
   kNLP = 0,
   kCV = 1,
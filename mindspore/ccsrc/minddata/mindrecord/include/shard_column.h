@@ -77,6 +77,20 @@ class ShardColumn {
   /// \brief check if blob compressed
   bool CheckCompressBlob() const { return has_compress_blob_; }
 
+  /// \brief compress the whole blob of a row with LZ4, the blob keeps its bytes if they do not shrink
+  /// \param[in] blob the blob of a row
+  /// \return the size of the blob in 8 bytes big-endian, followed by the LZ4 block or by the blob itself
+  static std::vector<uint8_t> CompressBytes(const std::vector<uint8_t> &blob);
+
+  /// \brief restore the blob of a row compressed by CompressBytes
+  /// \param[in, out] blob the compressed blob, replaced by the original one
+  /// \param[in] max_size the largest size of the original blob, the page size of the file
+  /// \return SUCCESS if the blob is restored, FAILED if it is corrupted
+  static MSRStatus UncompressBytes(std::vector<uint8_t> *blob, uint64_t max_size);
+
+  /// \brief get the size of the original blob of a row compressed by CompressBytes
+  static uint64_t UncompressedSize(const std::vector<uint8_t> &blob);
+
   uint64_t GetNumBlobColumn() const { return num_blob_column_; }
 
   std::vector<std::string> GetColumnName() { return column_name_; }
@@ -118,6 +118,12 @@ class ShardHeader {
 
   void SetPageSize(const uint64_t &page_size) { page_size_ = page_size; }
 
+  /// \brief get the codec of the blobs
+  /// \return the codec, empty if the blobs are not compressed
+  const std::string &GetBlobCompression() const { return blob_compression_; }
+
+  void SetBlobCompression(const std::string &blob_compression) { blob_compression_ = blob_compression; }
+
   std::vector<std::string> SerializeHeader();
 
   MSRStatus PagesToFile(const std::string dump_file_name);
@@ -177,6 +183,7 @@ class ShardHeader {
   uint32_t shard_count_;
   uint64_t header_size_;
   uint64_t page_size_;
+  std::string blob_compression_;
 
   std::shared_ptr<Index> index_;
   std::vector<std::string> shard_addresses_;
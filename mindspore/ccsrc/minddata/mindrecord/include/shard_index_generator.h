@@ -36,6 +36,10 @@ class ShardIndexGenerator {
  public:
   explicit ShardIndexGenerator(const std::string &file_path, bool append = false);
 
+  /// \brief create a generator for the files a writer is writing, which adds the rows of the pages as it writes them
+  /// \param[in] header the header of the writer, with the schemas and the index fields
+  explicit ShardIndexGenerator(const ShardHeader &header);
+
   MSRStatus Build();
 
   static std::pair<MSRStatus, std::string> GenerateFieldName(const std::pair<uint64_t, std::string> &field);
@@ -59,6 +63,26 @@ class ShardIndexGenerator {
 
   static MSRStatus finalize(const std::vector<std::string> file_names);
 
+  /// \brief create the databases of the files a writer is writing
+  /// \param[in] shard_addresses the paths of the files
+  MSRStatus OpenForWriter(const std::vector<std::string> &shard_addresses);
+
+  /// \brief add rows to the database of a shard, different shards may be written by different threads
+  /// \param[in] shard_no the shard of the rows
+  /// \param[in] data the rows, with their place in the pages and the fields added by AddIndexFieldByRawData
+  MSRStatus WriteRows(int shard_no,
+                      const std::vector<std::vector<std::tuple<std::string, std::string, std::string>>> &data);
+
+  /// \brief commit the rows and close the databases of a writer
+  /// \param[in] discard remove the databases instead, if they miss rows of the files
+  MSRStatus CloseForWriter(bool discard = false);
+
+  /// \brief add the index fields of a row
+  /// \param[in] schema_detail the raw data of the row for each schema
+  /// \param[in, out] row_data the fields to bind to the insert statement
+  void AddIndexFieldByRawData(const std::vector<json> &schema_detail,
+                              std::vector<std::tuple<std::string, std::string, std::string>> &row_data);
+
  private:
   static int Callback(void *not_used, int argc, char **argv, char **az_col_name);
 
@@ -66,7 +90,7 @@ class ShardIndexGenerator {
 
   static std::string ConvertJsonToSQL(const std::string &json);
 
-  std::pair<MSRStatus, sqlite3 *> CreateDatabase(int shard_no);
+  std::pair<MSRStatus, sqlite3 *> CreateDatabase(const std::string &shard_address);
 
   std::pair<MSRStatus, std::vector<json>> GetSchemaDetails(const std::vector<uint64_t> &schema_lens, std::fstream &in);
 
@@ -102,9 +126,6 @@ class ShardIndexGenerator {
                             const std::shared_ptr<Page> cur_blob_page, uint64_t &cur_blob_page_offset,
                             std::fstream &in);
 
-  void AddIndexFieldByRawData(const std::vector<json> &schema_detail,
-                              std::vector<std::tuple<std::string, std::string, std::string>> &row_data);
-
   void DatabaseWriter();  // worker thread
 
   std::string file_path_;
@@ -116,6 +137,9 @@ class ShardIndexGenerator {
   std::atomic_int task_;
   std::atomic_bool write_success_;
   std::vector<std::pair<uint64_t, std::string>> fields_;
+  std::vector<std::string> writer_addresses_;  // the databases opened for a writer
+  std::vector<sqlite3 *> writer_dbs_;
+  std::string writer_sql_;
 };
 }  // namespace mindrecord
 }  // namespace mindspore
@@ -26,6 +26,7 @@
 #include <exception>
 #include <fstream>
 #include <functional>
+#include <future>
 #include <map>
 #include <memory>
 #include <mutex>
@@ -40,6 +41,7 @@
 #include "minddata/mindrecord/include/shard_error.h"
 #include "minddata/mindrecord/include/shard_header.h"
 #include "minddata/mindrecord/include/shard_index.h"
+#include "minddata/mindrecord/include/shard_index_generator.h"
 #include "pybind11/pybind11.h"
 #include "pybind11/stl.h"
 #include "utils/log_adapter.h"
@@ -83,11 +85,27 @@ class ShardWriter {
   /// \return MSRStatus the status of MSRStatus
   MSRStatus SetShardHeader(std::shared_ptr<ShardHeader> header_data);
 
+  /// \brief Set the codec to compress the blob of each row
+  /// \param[in] blob_compression the codec, only lz4 is accepted, empty to keep the blobs as they are
+  ///        WARNING, only called when file is empty
+  /// \return MSRStatus the status of MSRStatus
+  MSRStatus SetBlobCompression(const std::string &blob_compression);
+
+  /// \brief Generate the index databases while writing, instead of by ShardIndexGenerator after commit
+  /// \param[in] generate_index the index is generated while writing if true
+  ///        it does not apply to the files opened for append or written in parallel
+  void SetGenerateIndex(bool generate_index) { generate_index_ = generate_index; }
+
+  /// \brief check if the index databases are generated while writing, so ShardIndexGenerator is not needed
+  bool IsIndexGenerated() const { return index_generated_; }
+
   /// \brief write raw data by group size
   /// \param[in] raw_data the vector of raw json data, vector format
   /// \param[in] blob_data the vector of image data
   /// \param[in] sign validate data or not
   /// \return MSRStatus the status of MSRStatus to judge if write successfully
+  ///        the data is copied into the writer and written to disk in background, so the failure of writing it
+  ///        is returned by the next call or by Commit
   MSRStatus WriteRawData(std::map<uint64_t, std::vector<json>> &raw_data, vector<vector<uint8_t>> &blob_data,
                          bool sign = true, bool parallel_writer = false);
 
@@ -137,17 +155,28 @@ class ShardWriter {
   void FillArray(int start, int end, std::map<uint64_t, vector<json>> &raw_data,
                  std::vector<std::vector<uint8_t>> &bin_data);
 
+  /// \brief compress the blob data of rows in multiple thread run
+  void CompressArray(int start, int end, std::vector<std::vector<uint8_t>> &blob_data);
+
+  /// \brief compress blob data
+  MSRStatus CompressBlobData(std::vector<std::vector<uint8_t>> &blob_data);
+
   /// \brief serialized raw data
   MSRStatus SerializeRawData(std::map<uint64_t, std::vector<json>> &raw_data,
                              std::vector<std::vector<uint8_t>> &bin_data, uint32_t row_count);
 
   /// \brief write all data parallel
   MSRStatus ParallelWriteData(const std::vector<std::vector<uint8_t>> &blob_data,
-                              const std::vector<std::vector<uint8_t>> &bin_raw_data);
+                              const std::vector<std::vector<uint8_t>> &bin_raw_data,
+                              const std::map<uint64_t, std::vector<json>> &raw_data);
 
   /// \brief write data shard by shard
   MSRStatus WriteByShard(int shard_id, int start_row, int end_row, const std::vector<std::vector<uint8_t>> &blob_data,
-                         const std::vector<std::vector<uint8_t>> &bin_raw_data);
+                         const std::vector<std::vector<uint8_t>> &bin_raw_data,
+                         const std::map<uint64_t, std::vector<json>> &raw_data);
+
+  /// \brief wait for the data written in background
+  MSRStatus WaitForWriting();
 
   /// \brief break image data up into multiple row groups
   MSRStatus CutRowGroup(int start_row, int end_row, const std::vector<std::vector<uint8_t>> &blob_data,
@@ -170,7 +199,8 @@ class ShardWriter {
 
   /// \brief write raw data page to disk
   MSRStatus WriteRawPage(const int &shard_id, const std::vector<std::pair<int, int>> &rows_in_group,
-                         std::shared_ptr<Page> &last_raw_page, const std::vector<std::vector<uint8_t>> &bin_raw_data);
+                         std::shared_ptr<Page> &last_raw_page, const std::vector<std::vector<uint8_t>> &bin_raw_data,
+                         std::vector<std::pair<int, uint64_t>> &raw_chunks);
 
   /// \brief generate empty raw data page
   void EmptyRawPage(const int &shard_id, std::shared_ptr<Page> &last_raw_page);
@@ -190,13 +220,29 @@ class ShardWriter {
                           const std::vector<std::vector<uint8_t>> &bin_raw_data);
 
   /// \brief break up into tasks by shard
-  std::vector<std::pair<int, int>> BreakIntoShards();
+  std::vector<std::pair<int, int>> BreakIntoShards(uint32_t row_count);
 
   /// \brief calculate raw data size row by row
-  MSRStatus SetRawDataSize(const std::vector<std::vector<uint8_t>> &bin_raw_data);
+  MSRStatus SetRawDataSize(const std::vector<std::vector<uint8_t>> &bin_raw_data, std::vector<uint64_t> &raw_data_size);
 
   /// \brief calculate blob data size row by row
-  MSRStatus SetBlobDataSize(const std::vector<std::vector<uint8_t>> &blob_data);
+  MSRStatus SetBlobDataSize(const std::vector<std::vector<uint8_t>> &blob_data, std::vector<uint64_t> &blob_data_size);
+
+  /// \brief open the index databases to fill while writing, if the files are written by this writer only
+  MSRStatus InitIndexGenerator(bool parallel_writer);
+
+  /// \brief add the index rows of the chunks written to a shard
+  MSRStatus AddIndexRows(const int &shard_id, const std::vector<std::pair<int, int>> &rows_in_group,
+                         const std::vector<std::pair<int, int>> &blob_pages, uint64_t blob_offset, uint64_t row_id,
+                         const std::vector<std::pair<int, uint64_t>> &raw_chunks,
+                         const std::map<uint64_t, std::vector<json>> &raw_data);
+
+  /// \brief move the index rows of the last row group of a shard, with their place in the raw page
+  void PopIndexRowGroup(const int &shard_id,
+                        std::vector<std::vector<std::tuple<std::string, std::string, std::string>>> &rows);
+
+  /// \brief add the index rows left and close the index databases
+  MSRStatus CloseIndexGenerator();
 
   /// \brief populate last raw page pointer
   void SetLastRawPage(const int &shard_id, std::shared_ptr<Page> &last_raw_page);
@@ -244,6 +290,7 @@ class ShardWriter {
   uint64_t page_size_;     // page size
   uint32_t row_count_;     // count of rows
   uint32_t schema_count_;  // count of schemas
+  std::string blob_compression_;  // codec of blobs
 
   std::vector<uint64_t> raw_data_size_;   // Raw data size
   std::vector<uint64_t> blob_data_size_;  // Blob data size
@@ -257,6 +304,28 @@ class ShardWriter {
 
   std::mutex check_mutex_;  // mutex for data check
   std::atomic<bool> flag_{false};
+
+  bool append_;                                                   // open for append
+  std::future<MSRStatus> write_result_;                           // the data written in background
+  bool write_failed_;                                             // the data failed to be written in background
+  std::map<uint64_t, std::vector<json>> writing_raw_data_;        // raw data written in background
+  std::vector<std::vector<uint8_t>> writing_blob_data_;           // blob data written in background
+  std::vector<std::vector<uint8_t>> writing_bin_raw_data_;        // serialized raw data written in background
+
+  // the index rows of the last row group of a shard, the row group may still grow or be shifted to a new raw page
+  struct IndexRowGroup {
+    int raw_page_id = -1;
+    uint64_t raw_offset = 0;
+    uint64_t raw_size = 0;
+    std::vector<std::pair<uint64_t, uint64_t>> raw_rows;  // offsets of the rows in the row group
+    std::vector<std::vector<std::tuple<std::string, std::string, std::string>>> rows;
+  };
+
+  bool generate_index_;                                   // generate the index databases while writing
+  std::unique_ptr<ShardIndexGenerator> index_generator_;  // fills the index databases while writing
+  std::vector<IndexRowGroup> index_row_groups_;           // the last row group of each shard
+  bool index_disabled_;                                   // the index is left to ShardIndexGenerator
+  bool index_generated_;                                  // the index databases are complete
 };
 }  // namespace mindrecord
 }  // namespace mindspore
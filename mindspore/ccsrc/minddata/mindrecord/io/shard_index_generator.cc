@@ -13,6 +13,7 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include <cstdio>
 #include <thread>
 
 #include "minddata/mindrecord/include/shard_index_generator.h"
@@ -35,6 +36,15 @@ ShardIndexGenerator::ShardIndexGenerator(const std::string &file_path, bool appe
       task_(0),
       write_success_(true) {}
 
+ShardIndexGenerator::ShardIndexGenerator(const ShardHeader &header)
+    : append_(false),
+      shard_header_(header),
+      page_size_(0),
+      header_size_(0),
+      schema_count_(0),
+      task_(0),
+      write_success_(true) {}
+
 MSRStatus ShardIndexGenerator::Build() {
   auto ret = ShardHeader::BuildSingleHeader(file_path_);
   if (ret.first != SUCCESS) {
@@ -216,16 +226,14 @@ MSRStatus ShardIndexGenerator::CreateShardNameTable(sqlite3 *db, const std::stri
   return SUCCESS;
 }
 
-std::pair<MSRStatus, sqlite3 *> ShardIndexGenerator::CreateDatabase(int shard_no) {
-  std::string shard_address = shard_header_.GetShardAddressByID(shard_no);
+std::pair<MSRStatus, sqlite3 *> ShardIndexGenerator::CreateDatabase(const std::string &shard_address) {
   if (shard_address.empty()) {
-    MS_LOG(ERROR) << "Shard address is null, shard no: " << shard_no;
+    MS_LOG(ERROR) << "Shard address is null";
     return {FAILED, nullptr};
   }
 
   string shard_name = GetFileName(shard_address).second;
-  shard_address += ".db";
-  auto ret1 = CheckDatabase(shard_address);
+  auto ret1 = CheckDatabase(shard_address + ".db");
   if (ret1.first != SUCCESS) {
     return {FAILED, nullptr};
   }
@@ -592,7 +600,7 @@ MSRStatus ShardIndexGenerator::WriteToDatabase() {
 void ShardIndexGenerator::DatabaseWriter() {
   int shard_no = task_++;
   while (shard_no < shard_header_.GetShardCount()) {
-    auto db = CreateDatabase(shard_no);
+    auto db = CreateDatabase(shard_header_.GetShardAddressByID(shard_no));
     if (db.first != SUCCESS || db.second == nullptr || write_success_ == false) {
       write_success_ = false;
       return;
@@ -622,6 +630,71 @@ void ShardIndexGenerator::DatabaseWriter() {
     shard_no = task_++;
   }
 }
+
+MSRStatus ShardIndexGenerator::OpenForWriter(const std::vector<std::string> &shard_addresses) {
+  fields_ = shard_header_.GetFields();
+  page_size_ = shard_header_.GetPageSize();
+  header_size_ = shard_header_.GetHeaderSize();
+  schema_count_ = shard_header_.GetSchemaCount();
+  auto sql = GenerateRawSQL(fields_);
+  if (sql.first != SUCCESS) {
+    MS_LOG(ERROR) << "Generate raw SQL failed";
+    return FAILED;
+  }
+  writer_sql_ = sql.second;
+
+  for (const auto &shard_address : shard_addresses) {
+    auto db = CreateDatabase(shard_address);
+    if (db.first != SUCCESS || db.second == nullptr) {
+      (void)CloseForWriter(true);
+      return FAILED;
+    }
+    writer_addresses_.push_back(shard_address);
+    writer_dbs_.push_back(db.second);
+
+    // All the rows of a shard go into one transaction, as when they are generated from the file
+    if (ExecuteSQL("BEGIN TRANSACTION;", db.second) != SUCCESS) {
+      (void)CloseForWriter(true);
+      return FAILED;
+    }
+  }
+  return SUCCESS;
+}
+
+MSRStatus ShardIndexGenerator::WriteRows(
+  int shard_no, const std::vector<std::vector<std::tuple<std::string, std::string, std::string>>> &data) {
+  if (shard_no < 0 || shard_no >= static_cast<int>(writer_dbs_.size())) {
+    MS_LOG(ERROR) << "Database of shard " << shard_no << " is not opened.";
+    return FAILED;
+  }
+  if (BindParameterExecuteSQL(writer_dbs_[shard_no], writer_sql_, data) == FAILED) {
+    MS_LOG(ERROR) << "Execute SQL failed";
+    return FAILED;
+  }
+  MS_LOG(DEBUG) << "Insert " << data.size() << " rows to index db of shard " << shard_no << ".";
+  return SUCCESS;
+}
+
+MSRStatus ShardIndexGenerator::CloseForWriter(bool discard) {
+  MSRStatus ret = SUCCESS;
+  for (size_t i = 0; i < writer_dbs_.size(); ++i) {
+    // Closing a database rolls back the transaction which is not ended
+    if (!discard && ExecuteSQL("END TRANSACTION;", writer_dbs_[i]) != SUCCESS) {
+      ret = FAILED;
+    }
+    if (sqlite3_close(writer_dbs_[i]) != SQLITE_OK) {
+      MS_LOG(ERROR) << "Close database failed";
+      ret = FAILED;
+    }
+    if (discard) {
+      (void)std::remove(common::SafeCStr(writer_addresses_[i] + ".db"));
+    }
+  }
+  writer_dbs_.clear();
+  writer_addresses_.clear();
+  return discard ? SUCCESS : ret;
+}
+
 MSRStatus ShardIndexGenerator::finalize(const std::vector<std::string> file_names) {
   if (file_names.empty()) {
     MS_LOG(ERROR) << "Mindrecord files is empty.";
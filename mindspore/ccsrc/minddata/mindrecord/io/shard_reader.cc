@@ -1124,6 +1124,13 @@ TASK_RETURN_CONTENT ShardReader::ConsumerOneTask(int task_id, uint32_t consumer_
                           std::pair(TaskType::kCommonTask, std::vector<std::tuple<std::vector<uint8_t>, json>>()));
   }
 
+  // Restore the blob if the blobs are compressed
+  if (!shard_header_->GetBlobCompression().empty() &&
+      ShardColumn::UncompressBytes(&images, shard_header_->GetPageSize()) == FAILED) {
+    return std::make_pair(FAILED,
+                          std::pair(TaskType::kCommonTask, std::vector<std::tuple<std::vector<uint8_t>, json>>()));
+  }
+
   // Deliver batch data to output map
   std::vector<std::tuple<std::vector<uint8_t>, json>> batch;
   batch.emplace_back(std::move(images), std::move(std::get<3>(task)));
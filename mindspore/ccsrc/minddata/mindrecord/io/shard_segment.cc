@@ -229,6 +229,12 @@ std::pair<MSRStatus, std::vector<uint8_t>> ShardSegment::PackImages(int group_id
     return {FAILED, {}};
   }
 
+  // Restore the blob if the blobs are compressed
+  if (!shard_header_->GetBlobCompression().empty() &&
+      ShardColumn::UncompressBytes(&images, shard_header_->GetPageSize()) == FAILED) {
+    return {FAILED, {}};
+  }
+
   return {SUCCESS, std::move(images)};
 }
 
@@ -32,9 +32,21 @@ ShardWriter::ShardWriter()
       header_size_(kDefaultHeaderSize),
       page_size_(kDefaultPageSize),
       row_count_(0),
-      schema_count_(1) {}
+      schema_count_(1),
+      append_(false),
+      write_failed_(false),
+      generate_index_(false),
+      index_disabled_(false),
+      index_generated_(false) {}
 
 ShardWriter::~ShardWriter() {
+  if (write_result_.valid()) {
+    write_result_.wait();
+  }
+  if (index_generator_ != nullptr) {
+    // The databases miss the rows which are not committed
+    (void)index_generator_->CloseForWriter(true);
+  }
   for (int i = static_cast<int>(file_streams_.size()) - 1; i >= 0; i--) {
     file_streams_[i]->close();
   }
@@ -193,6 +205,8 @@ MSRStatus ShardWriter::OpenForAppend(const std::string &path) {
     return FAILED;
   }
   shard_header_ = std::make_shared<ShardHeader>(header);
+  blob_compression_ = shard_header_->GetBlobCompression();
+  schema_count_ = shard_header_->GetSchemaCount();
   MSRStatus ret = SetHeaderSize(shard_header_->GetHeaderSize());
   if (ret == FAILED) {
     return FAILED;
@@ -207,10 +221,22 @@ MSRStatus ShardWriter::OpenForAppend(const std::string &path) {
     return FAILED;
   }
   shard_column_ = std::make_shared<ShardColumn>(shard_header_);
+  append_ = true;
   return SUCCESS;
 }
 
 MSRStatus ShardWriter::Commit() {
+  // Wait for the data written in background
+  if (WaitForWriting() == FAILED) {
+    MS_LOG(ERROR) << "Write data failed";
+    return FAILED;
+  }
+
+  if (CloseIndexGenerator() == FAILED) {
+    MS_LOG(ERROR) << "Write index failed";
+    return FAILED;
+  }
+
   // Read pages file
   std::ifstream page_file(pages_file_.c_str());
   if (page_file.good()) {
@@ -272,7 +298,26 @@ MSRStatus ShardWriter::SetShardHeader(std::shared_ptr<ShardHeader> header_data)
   shard_header_ = header_data;
   shard_header_->SetHeaderSize(header_size_);
   shard_header_->SetPageSize(page_size_);
+  shard_header_->SetBlobCompression(blob_compression_);
   shard_column_ = std::make_shared<ShardColumn>(shard_header_);
+  schema_count_ = shard_header_->GetSchemaCount();
+  return SUCCESS;
+}
+
+MSRStatus ShardWriter::SetBlobCompression(const std::string &blob_compression) {
+  if (!blob_compression.empty() && blob_compression != kBlobCompressionLz4) {
+    MS_LOG(ERROR) << "Blob compression " << blob_compression << " is not supported, only " << kBlobCompressionLz4
+                  << " is supported.";
+    return FAILED;
+  }
+  if (append_) {
+    MS_LOG(ERROR) << "Blob compression can not be changed when appending to mindrecord files.";
+    return FAILED;
+  }
+  blob_compression_ = blob_compression;
+  if (shard_header_ != nullptr) {
+    shard_header_->SetBlobCompression(blob_compression_);
+  }
   return SUCCESS;
 }
 
@@ -458,9 +503,9 @@ MSRStatus ShardWriter::CheckData(const std::map<uint64_t, std::vector<json>> &ra
 std::tuple<MSRStatus, int, int> ShardWriter::ValidateRawData(std::map<uint64_t, std::vector<json>> &raw_data,
                                                              std::vector<std::vector<uint8_t>> &blob_data, bool sign) {
   auto rawdata_iter = raw_data.begin();
-  schema_count_ = raw_data.size();
+  uint32_t schema_count = raw_data.size();
   std::tuple<MSRStatus, int, int> failed(FAILED, 0, 0);
-  if (schema_count_ == 0) {
+  if (schema_count == 0) {
     MS_LOG(ERROR) << "Data size is zero";
     return failed;
   }
@@ -468,10 +513,10 @@ std::tuple<MSRStatus, int, int> ShardWriter::ValidateRawData(std::map<uint64_t,
   // keep schema_id
   std::set<int64_t> schema_ids;
   row_count_ = (rawdata_iter->second).size();
-  MS_LOG(DEBUG) << "Schema count is " << schema_count_;
+  MS_LOG(DEBUG) << "Schema count is " << schema_count;
 
   // Determine if the number of schemas is the same
-  if (shard_header_->GetSchemas().size() != schema_count_) {
+  if (shard_header_->GetSchemas().size() != schema_count) {
     MS_LOG(ERROR) << "Data size is not equal with the schema size";
     return failed;
   }
@@ -500,14 +545,14 @@ std::tuple<MSRStatus, int, int> ShardWriter::ValidateRawData(std::map<uint64_t,
   }
 
   if (!sign) {
-    std::tuple<MSRStatus, int, int> success(SUCCESS, schema_count_, row_count_);
+    std::tuple<MSRStatus, int, int> success(SUCCESS, schema_count, row_count_);
     return success;
   }
 
   // check the data according the schema
   if (CheckData(raw_data) != SUCCESS) {
     MS_LOG(ERROR) << "Data validate check failed";
-    return std::tuple<MSRStatus, int, int>(FAILED, schema_count_, row_count_);
+    return std::tuple<MSRStatus, int, int>(FAILED, schema_count, row_count_);
   }
 
   // delete wrong data from raw data
@@ -515,7 +560,7 @@ std::tuple<MSRStatus, int, int> ShardWriter::ValidateRawData(std::map<uint64_t,
 
   // update raw count
   row_count_ = row_count_ - err_mg_.begin()->second.size();
-  std::tuple<MSRStatus, int, int> success(SUCCESS, schema_count_, row_count_);
+  std::tuple<MSRStatus, int, int> success(SUCCESS, schema_count, row_count_);
   return success;
 }
 
@@ -541,6 +586,44 @@ void ShardWriter::FillArray(int start, int end, std::map<uint64_t, vector<json>>
   }
 }
 
+void ShardWriter::CompressArray(int start, int end, std::vector<std::vector<uint8_t>> &blob_data) {
+  bool compress_bytes = !shard_header_->GetBlobCompression().empty();
+  for (int x = start; x < end; ++x) {
+    // Integer arrays are compressed at first, which makes the blob shorter and more regular
+    if (shard_column_->CheckCompressBlob()) {
+      blob_data[x] = shard_column_->CompressBlob(blob_data[x]);
+    }
+    if (compress_bytes) {
+      blob_data[x] = ShardColumn::CompressBytes(blob_data[x]);
+    }
+  }
+}
+
+MSRStatus ShardWriter::CompressBlobData(std::vector<std::vector<uint8_t>> &blob_data) {
+  if (!shard_column_->CheckCompressBlob() && shard_header_->GetBlobCompression().empty()) {
+    return SUCCESS;
+  }
+  // define the number of thread
+  uint32_t thread_num = std::thread::hardware_concurrency();
+  if (thread_num == 0) thread_num = kThreadNumber;
+  int row_count = static_cast<int>(blob_data.size());
+  // Set the number of samples processed by each thread
+  int group_num = ceil(row_count * 1.0 / thread_num);
+  std::vector<std::thread> thread_set;
+  for (uint32_t x = 0; x < thread_num; ++x) {
+    int start_num = x * group_num;
+    int end_num = ((x + 1) * group_num > row_count) ? row_count : (x + 1) * group_num;
+    if (start_num >= end_num) {
+      continue;
+    }
+    thread_set.emplace_back(&ShardWriter::CompressArray, this, start_num, end_num, std::ref(blob_data));
+  }
+  for (auto &thread : thread_set) {
+    thread.join();
+  }
+  return SUCCESS;
+}
+
 int ShardWriter::LockWriter(bool parallel_writer) {
   if (!parallel_writer) {
     return 0;
@@ -611,13 +694,6 @@ MSRStatus ShardWriter::WriteRawDataPreCheck(std::map<uint64_t, std::vector<json>
     return FAILED;
   }
 
-  // compress blob
-  if (shard_column_->CheckCompressBlob()) {
-    for (auto &blob : blob_data) {
-      blob = shard_column_->CompressBlob(blob);
-    }
-  }
-
   // Add 4-bytes dummy blob data if no any blob fields
   if (blob_data.size() == 0 && raw_data.size() > 0) {
     blob_data = std::vector<std::vector<uint8_t>>(raw_data[0].size(), std::vector<uint8_t>(kUnsignedInt4, 0));
@@ -635,6 +711,12 @@ MSRStatus ShardWriter::WriteRawDataPreCheck(std::map<uint64_t, std::vector<json>
   }
   *schema_count = std::get<1>(v);
   *row_count = std::get<2>(v);
+
+  // compress blob of the valid rows
+  if (CompressBlobData(blob_data) == FAILED) {
+    MS_LOG(ERROR) << "Compress blob data failed";
+    return FAILED;
+  }
   return SUCCESS;
 }
 MSRStatus ShardWriter::MergeBlobData(const std::vector<string> &blob_fields,
@@ -676,6 +758,12 @@ MSRStatus ShardWriter::MergeBlobData(const std::vector<string> &blob_fields,
 
 MSRStatus ShardWriter::WriteRawData(std::map<uint64_t, std::vector<json>> &raw_data,
                                     std::vector<std::vector<uint8_t>> &blob_data, bool sign, bool parallel_writer) {
+  // Other writers change the files once they are unlocked, so the data in background must be written before
+  if (parallel_writer && WaitForWriting() == FAILED) {
+    MS_LOG(ERROR) << "Write data failed";
+    return FAILED;
+  }
+
   // Lock Writer if loading data parallel
   int fd = LockWriter(parallel_writer);
   if (fd < 0) {
@@ -707,23 +795,44 @@ MSRStatus ShardWriter::WriteRawData(std::map<uint64_t, std::vector<json>> &raw_d
   }
 
   // Set row size of raw data
-  if (SetRawDataSize(bin_raw_data) == FAILED) {
+  std::vector<uint64_t> raw_data_size;
+  if (SetRawDataSize(bin_raw_data, raw_data_size) == FAILED) {
     MS_LOG(ERROR) << "Set raw data size failed";
     return FAILED;
   }
 
   // Set row size of blob data
-  if (SetBlobDataSize(blob_data) == FAILED) {
+  std::vector<uint64_t> blob_data_size;
+  if (SetBlobDataSize(blob_data, blob_data_size) == FAILED) {
     MS_LOG(ERROR) << "Set blob data size failed";
     return FAILED;
   }
 
-  // Write data to disk with multi threads
-  if (ParallelWriteData(blob_data, bin_raw_data) == FAILED) {
+  // Only one batch is written at a time, the next one is prepared while it is written
+  if (WaitForWriting() == FAILED) {
+    MS_LOG(ERROR) << "Write data failed";
+    return FAILED;
+  }
+
+  if (InitIndexGenerator(parallel_writer) == FAILED) {
+    MS_LOG(ERROR) << "Init index generator failed";
+    return FAILED;
+  }
+
+  // Write data to disk with multi threads in background, the data of the caller is copied as it may be used again
+  raw_data_size_ = std::move(raw_data_size);
+  blob_data_size_ = std::move(blob_data_size);
+  writing_raw_data_ = raw_data;
+  writing_blob_data_ = blob_data;
+  writing_bin_raw_data_ = std::move(bin_raw_data);
+  write_result_ = std::async(std::launch::async, &ShardWriter::ParallelWriteData, this, std::cref(writing_blob_data_),
+                             std::cref(writing_bin_raw_data_), std::cref(writing_raw_data_));
+  MS_LOG(INFO) << "Write " << row_count << " records in background.";
+
+  if (parallel_writer && WaitForWriting() == FAILED) {
     MS_LOG(ERROR) << "Parallel write data failed";
     return FAILED;
   }
-  MS_LOG(INFO) << "Write " << bin_raw_data.size() << " records successfully.";
 
   if (UnlockWriter(fd, parallel_writer) == FAILED) {
     MS_LOG(ERROR) << "Unlock writer failed";
@@ -787,8 +896,10 @@ MSRStatus ShardWriter::WriteRawData(std::map<uint64_t, std::vector<py::handle>>
 }
 
 MSRStatus ShardWriter::ParallelWriteData(const std::vector<std::vector<uint8_t>> &blob_data,
-                                         const std::vector<std::vector<uint8_t>> &bin_raw_data) {
-  auto shards = BreakIntoShards();
+                                         const std::vector<std::vector<uint8_t>> &bin_raw_data,
+                                         const std::map<uint64_t, std::vector<json>> &raw_data) {
+  auto shards = BreakIntoShards(static_cast<uint32_t>(raw_data_size_.size()));
+  std::vector<MSRStatus> results(shard_count_, SUCCESS);
   // define the number of thread
   int thread_num = static_cast<int>(shard_count_);
   if (thread_num < 0) {
@@ -809,8 +920,11 @@ MSRStatus ShardWriter::ParallelWriteData(const std::vector<std::vector<uint8_t>>
       for (int x = 0; x < thread_num; ++x) {
         int start_row = shards[current_thread + x].first;
         int end_row = shards[current_thread + x].second;
-        thread_set[x] = std::thread(&ShardWriter::WriteByShard, this, current_thread + x, start_row, end_row,
-                                    std::ref(blob_data), std::ref(bin_raw_data));
+        int shard_id = current_thread + x;
+        thread_set[x] = std::thread([this, shard_id, start_row, end_row, &blob_data, &bin_raw_data, &raw_data,
+                                     &results]() {
+          results[shard_id] = WriteByShard(shard_id, start_row, end_row, blob_data, bin_raw_data, raw_data);
+        });
       }
       // Wait for threads done
       for (int x = 0; x < thread_num; ++x) {
@@ -820,12 +934,25 @@ MSRStatus ShardWriter::ParallelWriteData(const std::vector<std::vector<uint8_t>>
       current_thread += thread_num;
     }
   }
+  if (std::any_of(results.begin(), results.end(), [](MSRStatus result) { return result == FAILED; })) {
+    return FAILED;
+  }
+  MS_LOG(INFO) << "Write " << raw_data_size_.size() << " records successfully.";
   return SUCCESS;
 }
 
+MSRStatus ShardWriter::WaitForWriting() {
+  if (write_result_.valid() && write_result_.get() == FAILED) {
+    // Pages in the header do not match the files any more, so nothing can be written after
+    write_failed_ = true;
+  }
+  return write_failed_ ? FAILED : SUCCESS;
+}
+
 MSRStatus ShardWriter::WriteByShard(int shard_id, int start_row, int end_row,
                                     const std::vector<std::vector<uint8_t>> &blob_data,
-                                    const std::vector<std::vector<uint8_t>> &bin_raw_data) {
+                                    const std::vector<std::vector<uint8_t>> &bin_raw_data,
+                                    const std::map<uint64_t, std::vector<json>> &raw_data) {
   MS_LOG(DEBUG) << "Shard: " << shard_id << ", start: " << start_row << ", end: " << end_row
                 << ", schema size: " << schema_count_;
   if (start_row == end_row) {
@@ -842,6 +969,17 @@ MSRStatus ShardWriter::WriteByShard(int shard_id, int start_row, int end_row,
     return FAILED;
   }
 
+  // Blob pages of the row groups: the first one is appended to the last blob page, the others are new pages
+  std::vector<std::pair<int, int>> blob_pages;
+  int blob_page_id = last_blob_page ? last_blob_page->GetPageID() : -1;
+  int blob_page_type_id = last_blob_page ? last_blob_page->GetPageTypeID() : -1;
+  uint64_t blob_offset = last_blob_page ? last_blob_page->GetPageSize() : 0;
+  uint64_t row_id = last_blob_page ? last_blob_page->GetEndRowID() : 0;
+  int last_page_id = shard_header_->GetLastPageId(shard_id);
+  for (int i = 0; i < static_cast<int>(rows_in_group.size()); ++i) {
+    blob_pages.emplace_back(i == 0 ? blob_page_id : last_page_id + i, blob_page_type_id + i);
+  }
+
   if (AppendBlobPage(shard_id, blob_data, rows_in_group, last_blob_page) == FAILED) {
     MS_LOG(ERROR) << "Append bolb page failed";
     return FAILED;
@@ -857,11 +995,17 @@ MSRStatus ShardWriter::WriteByShard(int shard_id, int start_row, int end_row,
     return FAILED;
   }
 
-  if (WriteRawPage(shard_id, rows_in_group, last_raw_page, bin_raw_data) == FAILED) {
+  std::vector<std::pair<int, uint64_t>> raw_chunks;
+  if (WriteRawPage(shard_id, rows_in_group, last_raw_page, bin_raw_data, raw_chunks) == FAILED) {
     MS_LOG(ERROR) << "Write raw page failed";
     return FAILED;
   }
 
+  if (AddIndexRows(shard_id, rows_in_group, blob_pages, blob_offset, row_id, raw_chunks, raw_data) == FAILED) {
+    MS_LOG(ERROR) << "Add index rows failed";
+    return FAILED;
+  }
+
   return SUCCESS;
 }
 
@@ -917,7 +1061,9 @@ MSRStatus ShardWriter::AppendBlobPage(const int &shard_id, const std::vector<std
     return FAILED;
   }
 
-  (void)FlushBlobChunk(file_streams_[shard_id], blob_data, blob_row);
+  if (FlushBlobChunk(file_streams_[shard_id], blob_data, blob_row) == FAILED) {
+    return FAILED;
+  }
 
   // Update last blob page
   bytes_page += std::accumulate(blob_data_size_.begin() + blob_row.first, blob_data_size_.begin() + blob_row.second, 0);
@@ -946,7 +1092,9 @@ MSRStatus ShardWriter::NewBlobPage(const int &shard_id, const std::vector<std::v
       return FAILED;
     }
 
-    (void)FlushBlobChunk(file_streams_[shard_id], blob_data, blob_row);
+    if (FlushBlobChunk(file_streams_[shard_id], blob_data, blob_row) == FAILED) {
+      return FAILED;
+    }
     // Create new page info for header
     auto page_size =
       std::accumulate(blob_data_size_.begin() + blob_row.first, blob_data_size_.begin() + blob_row.second, 0);
@@ -1029,8 +1177,10 @@ MSRStatus ShardWriter::ShiftRawPage(const int &shard_id, const std::vector<std::
 
 MSRStatus ShardWriter::WriteRawPage(const int &shard_id, const std::vector<std::pair<int, int>> &rows_in_group,
                                     std::shared_ptr<Page> &last_raw_page,
-                                    const std::vector<std::vector<uint8_t>> &bin_raw_data) {
+                                    const std::vector<std::vector<uint8_t>> &bin_raw_data,
+                                    std::vector<std::pair<int, uint64_t>> &raw_chunks) {
   int last_row_group_id = last_raw_page ? last_raw_page->GetLastRowGroupID().first : -1;
+  raw_chunks = std::vector<std::pair<int, uint64_t>>(rows_in_group.size(), std::make_pair(-1, 0));
   for (uint32_t i = 0; i < rows_in_group.size(); ++i) {
     const auto &blob_row = rows_in_group[i];
     if (blob_row.first == blob_row.second) continue;
@@ -1042,6 +1192,7 @@ MSRStatus ShardWriter::WriteRawPage(const int &shard_id, const std::vector<std::
       (void)shard_header_->SetPage(last_raw_page);
       EmptyRawPage(shard_id, last_raw_page);
     }
+    raw_chunks[i] = std::make_pair(last_raw_page->GetPageID(), last_raw_page->GetPageSize());
     if (AppendRawPage(shard_id, rows_in_group, i, last_row_group_id, last_raw_page, bin_raw_data) != SUCCESS) {
       return FAILED;
     }
@@ -1078,7 +1229,9 @@ MSRStatus ShardWriter::AppendRawPage(const int &shard_id, const std::vector<std:
   if (chunk_id > 0) row_group_ids.emplace_back(++last_row_group_id, n_bytes);
   n_bytes += std::accumulate(raw_data_size_.begin() + rows_in_group[chunk_id].first,
                              raw_data_size_.begin() + rows_in_group[chunk_id].second, 0);
-  (void)FlushRawChunk(file_streams_[shard_id], rows_in_group, chunk_id, bin_raw_data);
+  if (FlushRawChunk(file_streams_[shard_id], rows_in_group, chunk_id, bin_raw_data) == FAILED) {
+    return FAILED;
+  }
 
   // Update previous raw data page
   last_raw_page->SetPageSize(n_bytes);
@@ -1108,8 +1261,8 @@ MSRStatus ShardWriter::FlushBlobChunk(const std::shared_ptr<std::fstream> &out,
     }
 
     // Write the data of blob
-    auto line = blob_data[j];
-    auto &io_handle_data = out->write(reinterpret_cast<char *>(&line[0]), line_len);
+    const auto &line = blob_data[j];
+    auto &io_handle_data = out->write(reinterpret_cast<const char *>(line.data()), line_len);
     if (!io_handle_data.good() || io_handle_data.fail() || io_handle_data.bad()) {
       MS_LOG(ERROR) << "File write failed";
       out->close();
@@ -1135,8 +1288,8 @@ MSRStatus ShardWriter::FlushRawChunk(const std::shared_ptr<std::fstream> &out,
     }
     // Write the data of multi schemas
     for (uint32_t j = 0; j < schema_count_; ++j) {
-      auto line = bin_raw_data[i * schema_count_ + j];
-      auto &io_handle = out->write(reinterpret_cast<char *>(&line[0]), line.size());
+      const auto &line = bin_raw_data[i * schema_count_ + j];
+      auto &io_handle = out->write(reinterpret_cast<const char *>(line.data()), line.size());
       if (!io_handle.good() || io_handle.fail() || io_handle.bad()) {
         MS_LOG(ERROR) << "File write failed";
         out->close();
@@ -1148,10 +1301,10 @@ MSRStatus ShardWriter::FlushRawChunk(const std::shared_ptr<std::fstream> &out,
 }
 
 // Allocate data to shards evenly
-std::vector<std::pair<int, int>> ShardWriter::BreakIntoShards() {
+std::vector<std::pair<int, int>> ShardWriter::BreakIntoShards(uint32_t row_count) {
   std::vector<std::pair<int, int>> shards;
-  int row_in_shard = row_count_ / shard_count_;
-  int remains = row_count_ % shard_count_;
+  int row_in_shard = row_count / shard_count_;
+  int remains = row_count % shard_count_;
 
   std::vector<int> v_list(shard_count_);
   std::iota(v_list.begin(), v_list.end(), 0);
@@ -1244,28 +1397,39 @@ MSRStatus ShardWriter::SerializeRawData(std::map<uint64_t, std::vector<json>> &r
   return flag_ == true ? FAILED : SUCCESS;
 }
 
-MSRStatus ShardWriter::SetRawDataSize(const std::vector<std::vector<uint8_t>> &bin_raw_data) {
-  raw_data_size_ = std::vector<uint64_t>(row_count_, 0);
+MSRStatus ShardWriter::SetRawDataSize(const std::vector<std::vector<uint8_t>> &bin_raw_data,
+                                      std::vector<uint64_t> &raw_data_size) {
+  raw_data_size = std::vector<uint64_t>(row_count_, 0);
   for (uint32_t i = 0; i < row_count_; ++i) {
-    raw_data_size_[i] = std::accumulate(
+    raw_data_size[i] = std::accumulate(
       bin_raw_data.begin() + (i * schema_count_), bin_raw_data.begin() + (i * schema_count_) + schema_count_, 0,
       [](uint64_t accumulator, const std::vector<uint8_t> &row) { return accumulator + kInt64Len + row.size(); });
   }
-  if (*std::max_element(raw_data_size_.begin(), raw_data_size_.end()) > page_size_) {
+  if (*std::max_element(raw_data_size.begin(), raw_data_size.end()) > page_size_) {
     MS_LOG(ERROR) << "Page size is too small to save a row!";
     return FAILED;
   }
   return SUCCESS;
 }
 
-MSRStatus ShardWriter::SetBlobDataSize(const std::vector<std::vector<uint8_t>> &blob_data) {
-  blob_data_size_ = std::vector<uint64_t>(row_count_);
-  (void)std::transform(blob_data.begin(), blob_data.end(), blob_data_size_.begin(),
+MSRStatus ShardWriter::SetBlobDataSize(const std::vector<std::vector<uint8_t>> &blob_data,
+                                       std::vector<uint64_t> &blob_data_size) {
+  blob_data_size = std::vector<uint64_t>(row_count_);
+  (void)std::transform(blob_data.begin(), blob_data.end(), blob_data_size.begin(),
                        [](const std::vector<uint8_t> &row) { return kInt64Len + row.size(); });
-  if (*std::max_element(blob_data_size_.begin(), blob_data_size_.end()) > page_size_) {
+  if (*std::max_element(blob_data_size.begin(), blob_data_size.end()) > page_size_) {
     MS_LOG(ERROR) << "Page size is too small to save a row!";
     return FAILED;
   }
+  // The original blob of a compressed row has to fit in a page as well, the reader rejects larger ones
+  if (!shard_header_->GetBlobCompression().empty()) {
+    for (const auto &row : blob_data) {
+      if (ShardColumn::UncompressedSize(row) > page_size_) {
+        MS_LOG(ERROR) << "Page size is too small to save a row!";
+        return FAILED;
+      }
+    }
+  }
   return SUCCESS;
 }
 
@@ -1287,6 +1451,122 @@ void ShardWriter::SetLastBlobPage(const int &shard_id, std::shared_ptr<Page> &la
   }
 }
 
+MSRStatus ShardWriter::InitIndexGenerator(bool parallel_writer) {
+  if (!generate_index_ || index_disabled_ || index_generated_) {
+    return SUCCESS;
+  }
+  // Rows written by other writers or before appending are only known from the files, leave them to the generator
+  if (parallel_writer || append_) {
+    if (index_generator_ != nullptr) {
+      (void)index_generator_->CloseForWriter(true);
+      index_generator_ = nullptr;
+    }
+    index_disabled_ = true;
+    return SUCCESS;
+  }
+  if (index_generator_ != nullptr) {
+    return SUCCESS;
+  }
+
+  auto index_generator = std::make_unique<ShardIndexGenerator>(*shard_header_);
+  if (index_generator->OpenForWriter(file_paths_) == FAILED) {
+    MS_LOG(WARNING) << "Open index databases failed, the index is generated after commit.";
+    index_disabled_ = true;
+    return SUCCESS;
+  }
+  index_generator_ = std::move(index_generator);
+  index_row_groups_ = std::vector<IndexRowGroup>(shard_count_);
+  return SUCCESS;
+}
+
+MSRStatus ShardWriter::AddIndexRows(const int &shard_id, const std::vector<std::pair<int, int>> &rows_in_group,
+                                    const std::vector<std::pair<int, int>> &blob_pages, uint64_t blob_offset,
+                                    uint64_t row_id, const std::vector<std::pair<int, uint64_t>> &raw_chunks,
+                                    const std::map<uint64_t, std::vector<json>> &raw_data) {
+  if (index_generator_ == nullptr) {
+    return SUCCESS;
+  }
+  std::vector<std::vector<std::tuple<std::string, std::string, std::string>>> full_data;
+  auto &row_group = index_row_groups_[shard_id];
+  for (uint32_t i = 0; i < rows_in_group.size(); ++i) {
+    const auto &blob_row = rows_in_group[i];
+    if (blob_row.first == blob_row.second) continue;
+    if (i > 0) {
+      // The last row group is complete once a new one starts
+      PopIndexRowGroup(shard_id, full_data);
+      row_group.raw_offset = raw_chunks[i].second;
+    } else {
+      // The rows are appended to the last row group, which may be shifted to a new raw page
+      row_group.raw_offset = raw_chunks[i].second - row_group.raw_size;
+    }
+    row_group.raw_page_id = raw_chunks[i].first;
+
+    uint64_t cur_blob_offset = i == 0 ? blob_offset : 0;
+    for (int j = blob_row.first; j < blob_row.second; ++j) {
+      std::vector<std::tuple<std::string, std::string, std::string>> row_data;
+      row_data.emplace_back(":ROW_ID", "INTEGER", std::to_string(row_id++));
+      row_data.emplace_back(":ROW_GROUP_ID", "INTEGER", std::to_string(blob_pages[i].second));
+      row_data.emplace_back(":PAGE_ID_BLOB", "INTEGER", std::to_string(blob_pages[i].first));
+      row_data.emplace_back(":PAGE_OFFSET_BLOB", "INTEGER", std::to_string(cur_blob_offset));
+      cur_blob_offset += blob_data_size_[j];
+      row_data.emplace_back(":PAGE_OFFSET_BLOB_END", "INTEGER", std::to_string(cur_blob_offset));
+
+      // Index fields are taken from the raw data, as the generator does from the raw page
+      std::vector<json> schema_detail;
+      for (const auto &raw : raw_data) {
+        schema_detail.push_back(raw.second[j]);
+      }
+      index_generator_->AddIndexFieldByRawData(schema_detail, row_data);
+
+      row_group.raw_rows.emplace_back(row_group.raw_size, row_group.raw_size + raw_data_size_[j]);
+      row_group.raw_size += raw_data_size_[j];
+      row_group.rows.push_back(std::move(row_data));
+    }
+  }
+  if (full_data.empty()) {
+    return SUCCESS;
+  }
+  return index_generator_->WriteRows(shard_id, full_data);
+}
+
+void ShardWriter::PopIndexRowGroup(
+  const int &shard_id, std::vector<std::vector<std::tuple<std::string, std::string, std::string>>> &rows) {
+  auto &row_group = index_row_groups_[shard_id];
+  for (uint32_t i = 0; i < row_group.rows.size(); ++i) {
+    auto &row_data = row_group.rows[i];
+    row_data.emplace_back(":PAGE_ID_RAW", "INTEGER", std::to_string(row_group.raw_page_id));
+    row_data.emplace_back(":PAGE_OFFSET_RAW", "INTEGER",
+                          std::to_string(row_group.raw_offset + row_group.raw_rows[i].first));
+    row_data.emplace_back(":PAGE_OFFSET_RAW_END", "INTEGER",
+                          std::to_string(row_group.raw_offset + row_group.raw_rows[i].second));
+    rows.push_back(std::move(row_data));
+  }
+  row_group = IndexRowGroup();
+}
+
+MSRStatus ShardWriter::CloseIndexGenerator() {
+  if (index_generator_ == nullptr) {
+    return SUCCESS;
+  }
+  for (int shard_id = 0; shard_id < shard_count_; ++shard_id) {
+    std::vector<std::vector<std::tuple<std::string, std::string, std::string>>> full_data;
+    PopIndexRowGroup(shard_id, full_data);
+    if (!full_data.empty() && index_generator_->WriteRows(shard_id, full_data) == FAILED) {
+      (void)index_generator_->CloseForWriter(true);
+      index_generator_ = nullptr;
+      return FAILED;
+    }
+  }
+  if (index_generator_->CloseForWriter() == FAILED) {
+    index_generator_ = nullptr;
+    return FAILED;
+  }
+  index_generator_ = nullptr;
+  index_generated_ = true;
+  MS_LOG(INFO) << "Write index databases successfully.";
+  return SUCCESS;
+}
+
 MSRStatus ShardWriter::initialize(const std::unique_ptr<ShardWriter> *writer_ptr,
                                   const std::vector<std::string> &file_names) {
   if (nullptr == writer_ptr) {
@@ -1300,6 +1580,7 @@ MSRStatus ShardWriter::initialize(const std::unique_ptr<ShardWriter> *writer_ptr
   }
   (*writer_ptr)->SetHeaderSize(1 << 24);
   (*writer_ptr)->SetPageSize(1 << 25);
+  (*writer_ptr)->SetGenerateIndex(true);
   return SUCCESS;
 }
 }  // namespace mindrecord
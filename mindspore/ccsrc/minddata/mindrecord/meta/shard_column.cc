@@ -17,6 +17,7 @@
 #include "minddata/mindrecord/include/shard_column.h"
 
 #include "utils/ms_utils.h"
+#include "utils/system/lz4.h"
 #include "minddata/mindrecord/include/common/shard_utils.h"
 #include "minddata/mindrecord/include/shard_error.h"
 
@@ -290,7 +291,7 @@ std::vector<uint8_t> ShardColumn::CompressBlob(const std::vector<uint8_t> &blob)
   uint64_t i_src = 0;
   for (int64_t i = 0; i < num_blob_column_; i++) {
     // Get column data type
-    auto src_data_type = column_data_type_[column_name_id_[blob_column_[i]]];
+    auto src_data_type = column_data_type_[column_name_id_.at(blob_column_[i])];
     auto int_type = src_data_type == ColumnInt32 ? kInt32Type : kInt64Type;
 
     // Compress and return is blob has 1 column only
@@ -322,6 +323,52 @@ std::vector<uint8_t> ShardColumn::CompressBlob(const std::vector<uint8_t> &blob)
   return dst_blob;
 }
 
+std::vector<uint8_t> ShardColumn::CompressBytes(const std::vector<uint8_t> &blob) {
+  std::vector<char> block;
+  block.reserve(system::Lz4::MaxCompressedSize(blob.size()));
+  auto block_size = system::Lz4::Compress(reinterpret_cast<const char *>(blob.data()), blob.size(), &block);
+
+  // Keep the blob as it is if it does not shrink, e.g. encoded images, so reading it needs no decompression
+  auto dst_blob = UIntToBytesBig(blob.size(), kInt64Type);
+  if (block_size < blob.size()) {
+    dst_blob.insert(dst_blob.end(), block.begin(), block.begin() + block_size);
+  } else {
+    dst_blob.insert(dst_blob.end(), blob.begin(), blob.end());
+  }
+  return dst_blob;
+}
+
+MSRStatus ShardColumn::UncompressBytes(std::vector<uint8_t> *blob, uint64_t max_size) {
+  if (blob->size() < kInt64Len) {
+    MS_LOG(ERROR) << "Compressed blob is too short: " << blob->size() << ".";
+    return FAILED;
+  }
+  uint64_t blob_size = BytesBigToUInt64(*blob, 0, kInt64Type);
+  if (blob_size > max_size) {
+    MS_LOG(ERROR) << "Compressed blob is corrupted, its size " << blob_size << " is larger than the page size "
+                  << max_size << ".";
+    return FAILED;
+  }
+  uint64_t block_size = blob->size() - kInt64Len;
+  if (block_size == blob_size) {
+    (void)blob->erase(blob->begin(), blob->begin() + kInt64Len);
+    return SUCCESS;
+  }
+
+  std::vector<uint8_t> dst_blob(blob_size);
+  if (!system::Lz4::Decompress(reinterpret_cast<const char *>(blob->data() + kInt64Len), block_size,
+                               reinterpret_cast<char *>(dst_blob.data()), blob_size)) {
+    MS_LOG(ERROR) << "Compressed blob is corrupted.";
+    return FAILED;
+  }
+  *blob = std::move(dst_blob);
+  return SUCCESS;
+}
+
+uint64_t ShardColumn::UncompressedSize(const std::vector<uint8_t> &blob) {
+  return blob.size() < kInt64Len ? 0 : BytesBigToUInt64(blob, 0, kInt64Type);
+}
+
 vector<uint8_t> ShardColumn::CompressInt(const vector<uint8_t> &src_bytes, const IntegerType &int_type) {
   uint64_t i_size = kUnsignedOne << static_cast<uint8_t>(int_type);
   // Get number of elements
@@ -54,6 +54,13 @@ MSRStatus ShardHeader::InitializeHeader(const std::vector<json> &headers, bool l
       ParseShardAddress(header["shard_addresses"]);
       header_size_ = header["header_size"].get<uint64_t>();
       page_size_ = header["page_size"].get<uint64_t>();
+      if (header.find("blob_compression") != header.end()) {
+        blob_compression_ = header["blob_compression"].get<std::string>();
+        if (blob_compression_ != kBlobCompressionLz4) {
+          MS_LOG(ERROR) << "Blob compression " << blob_compression_ << " is not supported.";
+          return FAILED;
+        }
+      }
     }
     if (SUCCESS != ParsePage(header["page"], shard_index, load_dataset)) {
       return FAILED;
@@ -338,8 +345,11 @@ std::vector<std::string> ShardHeader::SerializeHeader() {
   }
   if (shard_count_ <= kMaxShardCount) {
     for (int shardId = 0; shardId < shard_count_; shardId++) {
-      string s;
-      s += "{\"header_size\":" + std::to_string(header_size_) + ",";
+      string s = "{";
+      if (!blob_compression_.empty()) {
+        s += "\"blob_compression\":\"" + blob_compression_ + "\",";
+      }
+      s += "\"header_size\":" + std::to_string(header_size_) + ",";
       s += "\"index_fields\":" + index + ",";
       s += "\"page\":" + pages[shardId] + ",";
       s += "\"page_size\":" + std::to_string(page_size_) + ",";
@@ -36,6 +36,9 @@
 #else
 #include "runtime/device/gpu/distribution/collective_fake_init.h"
 #endif
+#ifdef ENABLE_CPU
+#include "runtime/device/cpu/profiling/cpu_profiling.h"
+#endif
 namespace py = pybind11;
 
 using EnvInstance = mindspore::EnvInstance;
@@ -98,6 +101,17 @@ PYBIND11_MODULE(_c_expression, m) {
   (void)m.def("init_backend", &mindspore::pipeline::InitBackend, "Init Backend.");
 
   (void)m.def("export_graph", &mindspore::pipeline::ExportGraph, "Export Graph.");
+#ifdef ENABLE_CPU
+  (void)m.def(
+    "export_cpu_profiling_data",
+    [](const std::string &output_path, uint32_t device_id) {
+      return mindspore::device::cpu::CPUProfiler::GetInstance().Export(output_path, device_id);
+    },
+    py::arg("output_path"), py::arg("device_id"), "Export CPU kernel timeline and op summary.");
+  (void)m.def(
+    "clear_cpu_profiling_data", []() { mindspore::device::cpu::CPUProfiler::GetInstance().Clear(); },
+    "Clear collected CPU kernel profiling data.");
+#endif
 
   (void)py::class_<mindspore::MsContext, std::shared_ptr<mindspore::MsContext>>(m, "MSContext")
     .def_static("get_instance", &mindspore::MsContext::GetInstance, "Get ms context instance.")
@@ -303,7 +317,12 @@ PYBIND11_MODULE(_c_expression, m) {
     .def("GetFileName", &EventWriter::GetFileName, "Get the file name.")
     .def("Open", &EventWriter::Open, "Open the write file.")
     .def("Write", &EventWriter::Write, "Write the serialize event.")
+    .def("WriteDroppable", &EventWriter::WriteDroppable, "Write the serialize event which may be dropped.")
+    .def("StepEnd", &EventWriter::StepEnd, "Mark the end of a step.")
+    .def("SetFlushPolicy", &EventWriter::SetFlushPolicy, "Set the flush steps and flush interval(ms).")
+    .def("SetDropBudget", &EventWriter::SetDropBudget, "Set the bytes of droppable events allowed to be pending.")
     .def("EventCount", &EventWriter::GetWriteEventCount, "Write event count.")
+    .def("DropCount", &EventWriter::GetDropEventCount, "Dropped event count.")
     .def("Flush", &EventWriter::Flush, "Flush the event.")
     .def("Close", &EventWriter::Close, "Close the write.")
     .def("Shut", &EventWriter::Shut, "Final close the write.");
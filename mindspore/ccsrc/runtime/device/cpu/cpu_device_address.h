@@ -35,6 +35,11 @@ class CPUDeviceAddress : public DeviceAddress {
   bool SyncDeviceToHost(const std::vector<int> &shape, size_t size, TypeId type, void *host_ptr) const override;
   bool SyncHostToDevice(const std::vector<int> &shape, size_t size, TypeId type, const void *host_ptr) const override;
   DeviceAddressType DeviceType() const override { return DeviceAddressType::kCPU; }
+  void set_status(DeviceAddressStatus status) override { status_ = status; }
+  DeviceAddressStatus status() const override { return status_; }
+
+ private:
+  DeviceAddressStatus status_{DeviceAddressStatus::kInDevice};
 };
 }  // namespace cpu
 }  // namespace device
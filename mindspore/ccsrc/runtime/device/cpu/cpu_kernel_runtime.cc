@@ -18,12 +18,14 @@
 #include <vector>
 #include <memory>
 #include <numeric>
+#include <cstdlib>
 #include <utility>
 #include <functional>
 #include <map>
 #include <set>
 #include "backend/kernel_compiler/kernel.h"
 #include "runtime/device/cpu/cpu_device_address.h"
+#include "runtime/device/cpu/profiling/cpu_profiling.h"
 #include "utils/ms_context.h"
 #include "utils/config_manager.h"
 #include "utils/profile.h"
@@ -35,11 +37,54 @@
 namespace mindspore {
 namespace device {
 namespace cpu {
+using mindspore::device::memswap::MemSwapInfoSet;
+using mindspore::device::memswap::MemSwapManager;
+using mindspore::device::memswap::SwapKind;
 const size_t INIT_NODE_REF = 1;
+namespace {
+// The memory in MB the kernel outputs may take at once, the rest is swapped out to host memory or to MS_CPU_SWAP_FILE.
+constexpr auto kEnvSwapMemoryLimit = "MS_CPU_SWAP_MEMORY_LIMIT";
+constexpr auto kEnvSwapFile = "MS_CPU_SWAP_FILE";
+constexpr auto kEnvSwapLookahead = "MS_CPU_SWAP_LOOKAHEAD";
+constexpr size_t kDefaultSwapLookahead = 2;
+
+size_t GetEnvSize(const char *name, size_t default_value) {
+  auto value = common::GetEnv(name);
+  if (value.empty()) {
+    return default_value;
+  }
+  char *end = nullptr;
+  auto size = std::strtoull(value.c_str(), &end, 10);
+  if (end == value.c_str() || *end != '\0') {
+    MS_LOG(WARNING) << "Invalid value " << value << " of " << name << ", use " << default_value << " instead.";
+    return default_value;
+  }
+  return static_cast<size_t>(size);
+}
+
+size_t GetSwapMemoryLimit() { return GetEnvSize(kEnvSwapMemoryLimit, 0) << 20; }
+}  // namespace
+
+CPUKernelRuntime::~CPUKernelRuntime() {
+  for (auto &item : mem_swap_map_) {
+    auto &mem_swap_manager = item.second;
+    if (mem_swap_manager != nullptr) {
+      mem_swap_manager->ClearSwapQueue(false);
+      mem_swap_manager->ReleaseHostPinnedMem();
+    }
+  }
+  mem_swap_map_.clear();
+}
+
 void CPUKernelRuntime::AssignKernelAddress(session::KernelGraph *kernel_graph) {
   AssignValueNodeAddress(kernel_graph);
   AssignInputNodeAddress(kernel_graph);
   AssignKernelOutputAddress(kernel_graph);
+  if (GetSwapMemoryLimit() > 0) {
+    // Swapping a tensor out only gives memory back when every tensor has its own allocation.
+    resource_manager_.set_dynamic_malloc(true);
+    return;
+  }
   resource_manager_.AssignMemory(kernel_graph);
 }
 
@@ -276,22 +321,173 @@ void CPUKernelRuntime::DecreaseSummaryRefCount(const session::NamedSummaryOutput
   resource_manager_.DecreaseSummaryRefCount(summary_outputs);
 }
 
+MemSwapManagerPtr CPUKernelRuntime::GetMemSwapManager(const session::KernelGraph *kernel_graph) {
+  MS_EXCEPTION_IF_NULL(kernel_graph);
+  size_t mem_limit = GetSwapMemoryLimit();
+  if (mem_limit == 0) {
+    return nullptr;
+  }
+  auto graph_id = kernel_graph->graph_id();
+  auto iter = mem_swap_map_.find(graph_id);
+  if (iter != mem_swap_map_.end()) {
+    return iter->second;
+  }
+  mem_swap_map_[graph_id] = nullptr;
+  if (kernel_graph->execution_order().empty()) {
+    return nullptr;
+  }
+  // The graphs share one slow tier, a graph still holding the previous one keeps it alive.
+  auto swap_file = common::GetEnv(kEnvSwapFile);
+  if (swap_file.empty() && (slow_mem_tier_ == nullptr || slow_mem_tier_->name() != HostMemTier().name())) {
+    slow_mem_tier_ = std::make_shared<HostMemTier>();
+  } else if (!swap_file.empty() && (slow_mem_tier_ == nullptr || slow_mem_tier_->name() != swap_file)) {
+    slow_mem_tier_ = std::make_shared<FileMemTier>(swap_file);
+  }
+  auto mem_swap_manager = std::make_shared<MemSwapManager>(std::make_shared<CPUMemCopyManager>(slow_mem_tier_));
+  mem_swap_manager->set_prefetch_lookahead(GetEnvSize(kEnvSwapLookahead, kDefaultSwapLookahead));
+  if (!mem_swap_manager->Init(kernel_graph)) {
+    MS_LOG(WARNING) << "Init memory swap of graph " << graph_id << " failed, run it without swapping.";
+    return nullptr;
+  }
+  auto plan = mem_swap_manager->QueryMemSwapPlan();
+  if (plan.peak_mem_size_ <= mem_limit) {
+    MS_LOG(INFO) << "Graph " << graph_id << " needs " << plan.peak_mem_size_ << " bytes, no memory swap.";
+    return nullptr;
+  }
+  // Each retreat swaps smaller tensors over shorter distances, until the peak fits in the limit.
+  do {
+    if (!mem_swap_manager->RetreatSwapInfo()) {
+      MS_LOG(WARNING) << "No memory swap scheme of graph " << graph_id << " fits in " << mem_limit
+                      << " bytes, run it without swapping.";
+      return nullptr;
+    }
+    plan = mem_swap_manager->QueryMemSwapPlan();
+  } while (plan.peak_mem_size_with_swap_ > mem_limit);
+  mem_swap_manager->AssignHostMemory();
+  MS_LOG(INFO) << "Memory swap of graph " << graph_id << " to " << slow_mem_tier_->name() << ": "
+               << plan.swap_task_num_ << " tasks, " << plan.swap_out_bytes_ << " bytes out and " << plan.swap_in_bytes_
+               << " bytes in per step, peak memory " << plan.peak_mem_size_ << " -> " << plan.peak_mem_size_with_swap_
+               << " bytes.";
+  mem_swap_map_[graph_id] = mem_swap_manager;
+  return mem_swap_manager;
+}
+
+void CPUKernelRuntime::AddMemSwapTask(const MemSwapManagerPtr &mem_swap_manager, const AnfNodePtr &kernel) {
+  MS_EXCEPTION_IF_NULL(mem_swap_manager);
+  const MemSwapInfoSet &mem_swap_info_set = mem_swap_manager->QueryKernelMemSwapInfo(kernel);
+  for (auto &mem_swap_info : mem_swap_info_set) {
+    auto need_swap_kernel = mem_swap_manager->QueryKernelByTopoOrder(mem_swap_info.topo_order_);
+    MS_EXCEPTION_IF_NULL(need_swap_kernel);
+    const HostAddress &host_address =
+      mem_swap_manager->QueryKernelHostAddr(need_swap_kernel, mem_swap_info.output_idx_);
+    auto device_address = AnfAlgo::GetMutableOutputAddr(need_swap_kernel, mem_swap_info.output_idx_, false);
+    MS_EXCEPTION_IF_NULL(device_address);
+    // The graph outputs live in the memory of their tensors.
+    if (bound_addresses_.find(device_address) != bound_addresses_.end()) {
+      continue;
+    }
+    if (mem_swap_info.swap_kind_ == SwapKind::kDeviceToHost) {
+      if (device_address->ptr_ == nullptr) {
+        continue;
+      }
+      if (mem_swap_manager->QueryKernelHostAddrIsDirty(need_swap_kernel, mem_swap_info.output_idx_)) {
+        mem_swap_manager->AddMemSwapTask(SwapKind::kDeviceToHost, device_address, host_address, false);
+        mem_swap_manager->AddKernelHostAddrIsDirty(need_swap_kernel, mem_swap_info.output_idx_, false);
+        swap_out_bytes_ += device_address->size_;
+      } else {
+        resource_manager_.MemFree(device_address->ptr_);
+        device_address->ptr_ = nullptr;
+        device_address->set_status(DeviceAddressStatus::kInHost);
+      }
+    } else if (mem_swap_info.swap_kind_ == SwapKind::kHostToDevice) {
+      auto status = device_address->status();
+      if (status == DeviceAddressStatus::kInDeviceToHost) {
+        // Still being copied out, keep it once the host copy is complete for the later swap outs.
+        (void)mem_swap_manager->SyncMemCopyStream(SwapKind::kDeviceToHost);
+        device_address->set_status(DeviceAddressStatus::kInDevice);
+      } else if (status == DeviceAddressStatus::kInHost) {
+        device_address->ptr_ = resource_manager_.MemMalloc(device_address->size_);
+        mem_swap_manager->AddMemSwapTask(SwapKind::kHostToDevice, device_address, host_address, false);
+        swap_in_bytes_ += device_address->size_;
+      }
+    }
+  }
+}
+
+void CPUKernelRuntime::UpdateSwapOutQueue(const MemSwapManagerPtr &mem_swap_manager) {
+  MS_EXCEPTION_IF_NULL(mem_swap_manager);
+  while (auto device_address = mem_swap_manager->UpdateSwapQueue(SwapKind::kDeviceToHost, false)) {
+    if (device_address->status() == DeviceAddressStatus::kInDeviceToHost && device_address->ptr_ != nullptr) {
+      device_address->set_status(DeviceAddressStatus::kInHost);
+      resource_manager_.MemFree(device_address->ptr_);
+      device_address->ptr_ = nullptr;
+    }
+  }
+}
+
+void CPUKernelRuntime::UpdateSwapInQueue(const MemSwapManagerPtr &mem_swap_manager) {
+  MS_EXCEPTION_IF_NULL(mem_swap_manager);
+  while (auto device_address = mem_swap_manager->UpdateSwapQueue(SwapKind::kHostToDevice, false)) {
+    device_address->set_status(DeviceAddressStatus::kInDevice);
+  }
+}
+
+void CPUKernelRuntime::WaitSwapIn(const MemSwapManagerPtr &mem_swap_manager, DeviceAddress *device_address) {
+  MS_EXCEPTION_IF_NULL(device_address);
+  auto status = device_address->status();
+  if (status == DeviceAddressStatus::kInHostToDevice) {
+    (void)mem_swap_manager->SyncMemCopyStream(SwapKind::kHostToDevice);
+    UpdateSwapInQueue(mem_swap_manager);
+  } else if (status == DeviceAddressStatus::kInHost) {
+    MS_LOG(EXCEPTION) << "The input is still swapped out when its kernel runs.";
+  }
+}
+
+void CPUKernelRuntime::ClearSwapInfo(const MemSwapManagerPtr &mem_swap_manager) {
+  MS_EXCEPTION_IF_NULL(mem_swap_manager);
+  (void)mem_swap_manager->SyncMemCopyStream(SwapKind::kDeviceToHost);
+  (void)mem_swap_manager->SyncMemCopyStream(SwapKind::kHostToDevice);
+  UpdateSwapOutQueue(mem_swap_manager);
+  UpdateSwapInQueue(mem_swap_manager);
+  mem_swap_manager->ClearSwapQueue(false);
+  mem_swap_manager->ClearSwapQueue(true);
+  mem_swap_manager->ResetHostAddrIsDirty();
+}
+
 bool CPUKernelRuntime::Run(session::KernelGraph *kernel_graph, Debugger *debugger) {
   MS_EXCEPTION_IF_NULL(kernel_graph);
   resource_manager_.IncreaseAddressRefCount(kernel_graph);
+  auto mem_swap_manager = GetMemSwapManager(kernel_graph);
+  if (mem_swap_manager != nullptr) {
+    resource_manager_.ResetDynamicMemPeak();
+    swap_out_bytes_ = 0;
+    swap_in_bytes_ = 0;
+  }
 
   auto kernels = kernel_graph->execution_order();
-  for (const auto &kernel : kernels) {
+  auto &profiler = CPUProfiler::GetInstance();
+  bool profiling = profiler.IsProfiling();
+  static const std::vector<uint32_t> kNoOpIds;
+  const auto &op_ids = profiling ? profiler.GraphOpIds(kernel_graph->graph_id(), kernels) : kNoOpIds;
+  for (size_t index = 0; index < kernels.size(); ++index) {
+    const auto &kernel = kernels[index];
 #ifdef ENABLE_PROFILE
     double start_time = GetTime();
 #endif
     std::vector<kernel::AddressPtr> kernel_inputs;
     std::vector<kernel::AddressPtr> kernel_workspaces;
     std::vector<kernel::AddressPtr> kernel_outputs;
+    if (mem_swap_manager != nullptr) {
+      UpdateSwapOutQueue(mem_swap_manager);
+      UpdateSwapInQueue(mem_swap_manager);
+    }
     size_t input_num = AnfAlgo::GetInputTensorNum(kernel);
     for (size_t i = 0; i < input_num; ++i) {
       auto device_address = AnfAlgo::GetPrevNodeMutableOutputAddr(kernel, i).get();
       MS_EXCEPTION_IF_NULL(device_address);
+      if (mem_swap_manager != nullptr) {
+        WaitSwapIn(mem_swap_manager, device_address);
+      }
       AddRuntimeAddress(device_address, &kernel_inputs);
     }
     size_t output_num = AnfAlgo::GetOutputTensorNum(kernel);
@@ -307,16 +503,44 @@ bool CPUKernelRuntime::Run(session::KernelGraph *kernel_graph, Debugger *debugge
       MS_EXCEPTION_IF_NULL(device_address);
       AddRuntimeAddress(device_address, &kernel_workspaces);
     }
+    KernelEvent event;
+    if (profiling) {
+      event.start_ns = CPUProfiler::NowNs();
+    }
     auto ret = kernel_mod->Launch(kernel_inputs, kernel_workspaces, kernel_outputs, 0);
+    if (profiling) {
+      event.end_ns = CPUProfiler::NowNs();
+      event.op_id = op_ids[index];
+      event.thread_id = CPUProfiler::CurrentThreadId();
+      for (const auto &input : kernel_inputs) {
+        event.bytes_read += input->size;
+      }
+      for (const auto &output : kernel_outputs) {
+        event.bytes_written += output->size;
+      }
+      profiler.Record(event);
+    }
     resource_manager_.DecreaseAddressRefCount(kernel);
     if (!ret) {
       MS_LOG(EXCEPTION) << "Launch kernel failed.";
     }
+    if (mem_swap_manager != nullptr && mem_swap_manager->QueryKernelTriggerSwap(kernel)) {
+      AddMemSwapTask(mem_swap_manager, kernel);
+    }
 #ifdef ENABLE_PROFILE
     double cost_time = GetTime() - start_time;
     MS_LOG(INFO) << "cpu kernel: " << kernel->fullname_with_scope() << "  costs " << cost_time * 1e6 << " us";
 #endif
   }
+  if (mem_swap_manager != nullptr) {
+    ClearSwapInfo(mem_swap_manager);
+    MS_LOG(INFO) << "Peak memory of graph " << kernel_graph->graph_id() << " with memory swap is "
+                 << resource_manager_.dynamic_mem_peak() << " bytes, " << swap_out_bytes_ << " bytes swapped out and "
+                 << swap_in_bytes_ << " bytes swapped in.";
+  }
+  if (profiling) {
+    profiler.StepEnd();
+  }
   return true;
 }
 }  // namespace cpu
@@ -25,15 +25,18 @@
 #include "backend/session/kernel_graph.h"
 #include "backend/session/session_basic.h"
 #include "runtime/device/cpu/cpu_resource_manager.h"
+#include "runtime/device/cpu/cpu_memory_copy_manager.h"
+#include "backend/optimizer/mem_reuse/mem_swap_manager.h"
 #include "backend/session/anf_runtime_algorithm.h"
 #include "utils/any.h"
 namespace mindspore {
 namespace device {
 namespace cpu {
+using mindspore::device::memswap::MemSwapManagerPtr;
 class CPUKernelRuntime : public KernelRuntime {
  public:
   CPUKernelRuntime() = default;
-  ~CPUKernelRuntime() override = default;
+  ~CPUKernelRuntime() override;
 
   bool Init() override { return true; }
   bool Run(session::KernelGraph *graph, Debugger *debugger = nullptr) override;
@@ -58,9 +61,22 @@ class CPUKernelRuntime : public KernelRuntime {
   void AssignInputNodeAddress(const session::KernelGraph *kernel_graph);
   void AssignKernelOutputAddress(const session::KernelGraph *kernel_graph);
   void AddRuntimeAddress(DeviceAddress *address, std::vector<kernel::AddressPtr> *input_list);
+  // Memory swap to a slower tier, on when MS_CPU_SWAP_MEMORY_LIMIT is set. The scheme of a graph is searched on its
+  // first run and is null when the graph fits in the limit.
+  MemSwapManagerPtr GetMemSwapManager(const session::KernelGraph *kernel_graph);
+  void AddMemSwapTask(const MemSwapManagerPtr &mem_swap_manager, const AnfNodePtr &kernel);
+  void UpdateSwapOutQueue(const MemSwapManagerPtr &mem_swap_manager);
+  void UpdateSwapInQueue(const MemSwapManagerPtr &mem_swap_manager);
+  void WaitSwapIn(const MemSwapManagerPtr &mem_swap_manager, DeviceAddress *device_address);
+  void ClearSwapInfo(const MemSwapManagerPtr &mem_swap_manager);
   CPUResourceManager resource_manager_;
   std::set<DeviceAddressPtr> bound_addresses_;
   std::map<AnfNodePtr, tensor::TensorPtr> input_param_tensor_map_;
+  SlowMemTierPtr slow_mem_tier_{nullptr};
+  std::map<uint32_t, MemSwapManagerPtr> mem_swap_map_;
+  // The bytes copied to and from the slow tier in the current run.
+  size_t swap_out_bytes_{0};
+  size_t swap_in_bytes_{0};
 };
 }  // namespace cpu
 }  // namespace device
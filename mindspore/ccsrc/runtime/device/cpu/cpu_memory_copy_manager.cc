@@ -0,0 +1,293 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "runtime/device/cpu/cpu_memory_copy_manager.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+#include "utils/log_adapter.h"
+
+namespace mindspore {
+namespace device {
+namespace cpu {
+namespace {
+// The file of the slow tier grows by at least this much, so that small tensors do not map one chunk each.
+constexpr size_t kFileChunkSize = 256 << 20;
+constexpr size_t kBlockAlign = 64;
+}  // namespace
+
+bool HostMemTier::Alloc(size_t size, void **addr) {
+  MS_EXCEPTION_IF_NULL(addr);
+  *addr = malloc(size);
+  return *addr != nullptr;
+}
+
+void HostMemTier::Free(void *addr) { free(addr); }
+
+FileMemTier::~FileMemTier() {
+#ifndef _WIN32
+  for (auto &chunk : chunks_) {
+    (void)munmap(chunk.first, chunk.second);
+  }
+  chunks_.clear();
+  if (fd_ >= 0) {
+    (void)close(fd_);
+    (void)unlink(path_.c_str());
+  }
+#endif
+}
+
+bool FileMemTier::Grow(size_t size) {
+#ifndef _WIN32
+  if (fd_ < 0) {
+    fd_ = open(path_.c_str(), O_RDWR | O_CREAT | O_TRUNC, S_IRUSR | S_IWUSR);
+    if (fd_ < 0) {
+      MS_LOG(ERROR) << "Open memory swap file " << path_ << " failed.";
+      return false;
+    }
+  }
+  auto page_size = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+  size_t chunk_size = (std::max(size, kFileChunkSize) + page_size - 1) / page_size * page_size;
+  if (ftruncate(fd_, static_cast<off_t>(file_size_ + chunk_size)) != 0) {
+    MS_LOG(ERROR) << "Grow memory swap file " << path_ << " to " << file_size_ + chunk_size << " bytes failed.";
+    return false;
+  }
+  void *addr = mmap(nullptr, chunk_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, static_cast<off_t>(file_size_));
+  if (addr == MAP_FAILED) {
+    MS_LOG(ERROR) << "Map " << chunk_size << " bytes of memory swap file " << path_ << " failed.";
+    return false;
+  }
+  file_size_ += chunk_size;
+  chunks_.emplace_back(reinterpret_cast<uint8_t *>(addr), chunk_size);
+  return true;
+#else
+  MS_LOG(ERROR) << "Memory swap to a file is not supported on Windows.";
+  return false;
+#endif
+}
+
+bool FileMemTier::Alloc(size_t size, void **addr) {
+  MS_EXCEPTION_IF_NULL(addr);
+  size_t block_size = (size + kBlockAlign - 1) / kBlockAlign * kBlockAlign;
+  while (chunk_index_ < chunks_.size() && chunk_offset_ + block_size > chunks_[chunk_index_].second) {
+    chunk_index_++;
+    chunk_offset_ = 0;
+  }
+  if (chunk_index_ == chunks_.size() && !Grow(block_size)) {
+    return false;
+  }
+  *addr = chunks_[chunk_index_].first + chunk_offset_;
+  chunk_offset_ += block_size;
+  live_num_++;
+  return true;
+}
+
+void FileMemTier::Free(void *addr) {
+  if (addr == nullptr || live_num_ == 0) {
+    return;
+  }
+  if (--live_num_ == 0) {
+    chunk_index_ = 0;
+    chunk_offset_ = 0;
+  }
+}
+
+CPUMemCopyManager::~CPUMemCopyManager() {
+  if (initialized_) {
+    StopStream(&swap_out_stream_);
+    StopStream(&swap_in_stream_);
+  }
+}
+
+void CPUMemCopyManager::Init() {
+  if (initialized_) {
+    return;
+  }
+  swap_out_stream_.thread = std::thread(CopyLoop, &swap_out_stream_);
+  swap_in_stream_.thread = std::thread(CopyLoop, &swap_in_stream_);
+  initialized_ = true;
+}
+
+void CPUMemCopyManager::CopyLoop(CopyStream *stream) {
+  while (true) {
+    CopyTask task;
+    {
+      std::unique_lock<std::mutex> lock(stream->mutex);
+      stream->cv.wait(lock, [stream] { return stream->stop || !stream->tasks.empty(); });
+      if (stream->tasks.empty()) {
+        return;
+      }
+      task = stream->tasks.front();
+      stream->tasks.pop();
+      stream->busy_num++;
+    }
+    (void)std::copy_n(reinterpret_cast<const uint8_t *>(task.src), task.size, reinterpret_cast<uint8_t *>(task.dst));
+    task.done->store(true, std::memory_order_release);
+    {
+      std::lock_guard<std::mutex> lock(stream->mutex);
+      stream->busy_num--;
+    }
+    stream->cv.notify_all();
+  }
+}
+
+std::shared_ptr<std::atomic<bool>> CPUMemCopyManager::AddCopyTask(CopyStream *stream, void *dst, const void *src,
+                                                                  size_t size) {
+  auto done = std::make_shared<std::atomic<bool>>(false);
+  {
+    std::lock_guard<std::mutex> lock(stream->mutex);
+    stream->tasks.push({dst, src, size, done});
+  }
+  stream->cv.notify_all();
+  return done;
+}
+
+void CPUMemCopyManager::SyncStream(CopyStream *stream) {
+  std::unique_lock<std::mutex> lock(stream->mutex);
+  stream->cv.wait(lock, [stream] { return stream->tasks.empty() && stream->busy_num == 0; });
+}
+
+void CPUMemCopyManager::StopStream(CopyStream *stream) {
+  {
+    std::lock_guard<std::mutex> lock(stream->mutex);
+    stream->stop = true;
+  }
+  stream->cv.notify_all();
+  if (stream->thread.joinable()) {
+    stream->thread.join();
+  }
+}
+
+void CPUMemCopyManager::AddMemSwapOutTask(const DeviceAddressPtr &device_address, const HostAddress &host_addr) {
+  MS_EXCEPTION_IF_NULL(device_address);
+  MS_EXCEPTION_IF_NULL(host_addr.addr);
+  auto device_ptr = device_address->GetPtr();
+  MS_EXCEPTION_IF_NULL(device_ptr);
+  device_address->set_status(DeviceAddressStatus::kInDeviceToHost);
+  auto done = AddCopyTask(&swap_out_stream_, host_addr.addr, device_ptr, host_addr.size);
+  swap_out_queue_.emplace(device_address, done);
+}
+
+void CPUMemCopyManager::AddMemSwapInTask(const DeviceAddressPtr &device_address, const HostAddress &host_addr,
+                                         bool profiling, float *cost_time) {
+  MS_EXCEPTION_IF_NULL(device_address);
+  MS_EXCEPTION_IF_NULL(host_addr.addr);
+  auto device_ptr = const_cast<void *>(device_address->GetPtr());
+  MS_EXCEPTION_IF_NULL(device_ptr);
+  device_address->set_status(DeviceAddressStatus::kInHostToDevice);
+  auto done = AddCopyTask(&swap_in_stream_, device_ptr, host_addr.addr, host_addr.size);
+  if (profiling) {
+    MS_EXCEPTION_IF_NULL(cost_time);
+    auto start = std::chrono::steady_clock::now();
+    SyncStream(&swap_in_stream_);
+    std::chrono::duration<float, std::milli> cost = std::chrono::steady_clock::now() - start;
+    *cost_time = cost.count();
+  }
+  swap_in_queue_.emplace(device_address, done);
+}
+
+void CPUMemCopyManager::AddMemSwapOutTaskMock(const DeviceAddressPtr &device_address) {
+  MS_EXCEPTION_IF_NULL(device_address);
+  device_address->set_status(DeviceAddressStatus::kInDeviceToHost);
+  swap_out_queue_mock_.emplace(device_address);
+}
+
+void CPUMemCopyManager::AddMemSwapInTaskMock(const DeviceAddressPtr &device_address) {
+  MS_EXCEPTION_IF_NULL(device_address);
+  device_address->set_status(DeviceAddressStatus::kInHostToDevice);
+  swap_in_queue_mock_.emplace(device_address);
+}
+
+bool CPUMemCopyManager::SyncMemCopyStream(SwapKind swap_kind) {
+  SyncStream(swap_kind == SwapKind::kDeviceToHost ? &swap_out_stream_ : &swap_in_stream_);
+  return true;
+}
+
+DeviceAddressPtr CPUMemCopyManager::UpdateSwapOutQueue() {
+  if (swap_out_queue_.empty() || !swap_out_queue_.front().second->load(std::memory_order_acquire)) {
+    return nullptr;
+  }
+  auto device_address = swap_out_queue_.front().first;
+  swap_out_queue_.pop();
+  return device_address;
+}
+
+DeviceAddressPtr CPUMemCopyManager::UpdateSwapInQueue() {
+  if (swap_in_queue_.empty() || !swap_in_queue_.front().second->load(std::memory_order_acquire)) {
+    return nullptr;
+  }
+  auto device_address = swap_in_queue_.front().first;
+  swap_in_queue_.pop();
+  return device_address;
+}
+
+DeviceAddressPtr CPUMemCopyManager::UpdateSwapOutQueueMock() {
+  if (swap_out_queue_mock_.empty()) {
+    return nullptr;
+  }
+  auto device_address = swap_out_queue_mock_.front();
+  swap_out_queue_mock_.pop();
+  return device_address;
+}
+
+DeviceAddressPtr CPUMemCopyManager::UpdateSwapInQueueMock() {
+  if (swap_in_queue_mock_.empty()) {
+    return nullptr;
+  }
+  auto device_address = swap_in_queue_mock_.front();
+  swap_in_queue_mock_.pop();
+  return device_address;
+}
+
+bool CPUMemCopyManager::AllocHostPinnedMem(size_t size, void **addr) const {
+  MS_EXCEPTION_IF_NULL(slow_tier_);
+  return slow_tier_->Alloc(size, addr);
+}
+
+void CPUMemCopyManager::FreeHostPinnedMem(void *addr) const {
+  MS_EXCEPTION_IF_NULL(slow_tier_);
+  slow_tier_->Free(addr);
+}
+
+void CPUMemCopyManager::ClearSwapQueue() {
+  if (initialized_) {
+    SyncStream(&swap_out_stream_);
+    SyncStream(&swap_in_stream_);
+  }
+  while (!swap_out_queue_.empty()) {
+    swap_out_queue_.pop();
+  }
+  while (!swap_in_queue_.empty()) {
+    swap_in_queue_.pop();
+  }
+}
+
+void CPUMemCopyManager::ClearSwapQueueMock() {
+  while (!swap_out_queue_mock_.empty()) {
+    swap_out_queue_mock_.pop();
+  }
+  while (!swap_in_queue_mock_.empty()) {
+    swap_in_queue_mock_.pop();
+  }
+}
+}  // namespace cpu
+}  // namespace device
+}  // namespace mindspore
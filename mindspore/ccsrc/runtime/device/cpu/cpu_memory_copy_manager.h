@@ -0,0 +1,153 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_RUNTIME_DEVICE_CPU_CPU_MEMORY_COPY_MANAGER_H_
+#define MINDSPORE_CCSRC_RUNTIME_DEVICE_CPU_CPU_MEMORY_COPY_MANAGER_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+#include "backend/optimizer/mem_reuse/mem_copy_manager.h"
+#include "runtime/device/device_address.h"
+
+namespace mindspore {
+namespace device {
+namespace cpu {
+using mindspore::device::memswap::MemCopyManager;
+using mindspore::device::memswap::SwapKind;
+
+// The slow tier which holds the swapped out tensors of the CPU backend.
+class SlowMemTier {
+ public:
+  SlowMemTier() = default;
+  virtual ~SlowMemTier() = default;
+  virtual bool Alloc(size_t size, void **addr) = 0;
+  virtual void Free(void *addr) = 0;
+  virtual std::string name() const = 0;
+};
+using SlowMemTierPtr = std::shared_ptr<SlowMemTier>;
+
+// Host DRAM, for a compute tier with less memory than the host or to test the swapping.
+class HostMemTier : public SlowMemTier {
+ public:
+  HostMemTier() = default;
+  ~HostMemTier() override = default;
+  bool Alloc(size_t size, void **addr) override;
+  void Free(void *addr) override;
+  std::string name() const override { return "host"; }
+};
+
+// A file mapped into memory, normally on an NVMe drive. The file grows by mapped chunks as tensors are swapped to it,
+// space is handed out from the chunks in order and all of it is reused once every block was freed.
+class FileMemTier : public SlowMemTier {
+ public:
+  explicit FileMemTier(const std::string &path) : path_(path) {}
+  ~FileMemTier() override;
+  bool Alloc(size_t size, void **addr) override;
+  void Free(void *addr) override;
+  std::string name() const override { return path_; }
+
+ private:
+  bool Grow(size_t size);
+
+  std::string path_;
+  int fd_{-1};
+  size_t file_size_{0};
+  std::vector<std::pair<uint8_t *, size_t>> chunks_;
+  size_t chunk_index_{0};
+  size_t chunk_offset_{0};
+  size_t live_num_{0};
+};
+
+// Copies between the kernel memory and a slow tier on two threads, one for each direction, so that the kernels keep
+// running while tensors move. A task is finished when its copy is done, the queues report them in issue order.
+class CPUMemCopyManager : public MemCopyManager {
+ public:
+  explicit CPUMemCopyManager(const SlowMemTierPtr &slow_tier) : slow_tier_(slow_tier) {}
+  ~CPUMemCopyManager() override;
+
+  void Init() override;
+
+  void AddMemSwapOutTask(const DeviceAddressPtr &device_address, const HostAddress &host_addr) override;
+
+  void AddMemSwapInTask(const DeviceAddressPtr &device_address, const HostAddress &host_addr, bool profiling,
+                        float *cost_time) override;
+
+  void AddMemSwapOutTaskMock(const DeviceAddressPtr &device_address) override;
+
+  void AddMemSwapInTaskMock(const DeviceAddressPtr &device_address) override;
+
+  bool SyncMemCopyStream(SwapKind swap_kind) override;
+
+  DeviceAddressPtr UpdateSwapOutQueue() override;
+
+  DeviceAddressPtr UpdateSwapInQueue() override;
+
+  DeviceAddressPtr UpdateSwapOutQueueMock() override;
+
+  DeviceAddressPtr UpdateSwapInQueueMock() override;
+
+  bool AllocHostPinnedMem(size_t size, void **addr) const override;
+
+  void FreeHostPinnedMem(void *addr) const override;
+
+  void ClearSwapQueue() override;
+
+  void ClearSwapQueueMock() override;
+
+ private:
+  struct CopyTask {
+    void *dst{nullptr};
+    const void *src{nullptr};
+    size_t size{0};
+    std::shared_ptr<std::atomic<bool>> done;
+  };
+  // One copy thread with its pending tasks.
+  struct CopyStream {
+    std::thread thread;
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::queue<CopyTask> tasks;
+    size_t busy_num{0};
+    bool stop{false};
+  };
+
+  static void CopyLoop(CopyStream *stream);
+  static std::shared_ptr<std::atomic<bool>> AddCopyTask(CopyStream *stream, void *dst, const void *src, size_t size);
+  static void SyncStream(CopyStream *stream);
+  static void StopStream(CopyStream *stream);
+
+  SlowMemTierPtr slow_tier_;
+  bool initialized_{false};
+  CopyStream swap_out_stream_;
+  CopyStream swap_in_stream_;
+  std::queue<std::pair<DeviceAddressPtr, std::shared_ptr<std::atomic<bool>>>> swap_out_queue_;
+  std::queue<std::pair<DeviceAddressPtr, std::shared_ptr<std::atomic<bool>>>> swap_in_queue_;
+  std::queue<DeviceAddressPtr> swap_out_queue_mock_;
+  std::queue<DeviceAddressPtr> swap_in_queue_mock_;
+};
+using CPUMemCopyManagerPtr = std::shared_ptr<CPUMemCopyManager>;
+}  // namespace cpu
+}  // namespace device
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_RUNTIME_DEVICE_CPU_CPU_MEMORY_COPY_MANAGER_H_
@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 #include "runtime/device/cpu/cpu_resource_manager.h"
+#include <algorithm>
 #include "backend/session/anf_runtime_algorithm.h"
 
 namespace mindspore {
@@ -32,6 +33,7 @@ void CPUResourceManager::MemFree() {
     free(iter.first);
   }
   dynamic_mem_.clear();
+  dynamic_mem_size_ = 0;
 }
 
 void CPUResourceManager::AssignMemory(const session::KernelGraph *graph) {
@@ -61,6 +63,8 @@ void *CPUResourceManager::MemMalloc(size_t mem_size) {
   if (ptr != nullptr) {
     memset_s(ptr, mem_size, 0, mem_size);
     dynamic_mem_[ptr] = mem_size;
+    dynamic_mem_size_ += mem_size;
+    dynamic_mem_peak_ = std::max(dynamic_mem_peak_, dynamic_mem_size_);
     return ptr;
   } else {
     MS_LOG(EXCEPTION) << "Malloc memory failed: size " << mem_size;
@@ -70,6 +74,7 @@ void *CPUResourceManager::MemMalloc(size_t mem_size) {
 void CPUResourceManager::MemFree(void *ptr) {
   auto iter = dynamic_mem_.find(ptr);
   if (iter != dynamic_mem_.end()) {
+    dynamic_mem_size_ -= iter->second;
     (void)dynamic_mem_.erase(iter);
     free(ptr);
   }
@@ -31,6 +31,11 @@ class CPUResourceManager {
   ~CPUResourceManager();
 
   void AssignMemory(const session::KernelGraph *graph);
+  // Every tensor is allocated when it is first written and freed after its last user, instead of planned in one block.
+  void set_dynamic_malloc(bool dynamic_malloc) { dynamic_malloc_ = dynamic_malloc; }
+  size_t dynamic_mem_size() const { return dynamic_mem_size_; }
+  size_t dynamic_mem_peak() const { return dynamic_mem_peak_; }
+  void ResetDynamicMemPeak() { dynamic_mem_peak_ = dynamic_mem_size_; }
   void IncreaseAddressRefCount(const session::KernelGraph *graph);
   void DecreaseAddressRefCount(const AnfNodePtr &kernel);
   void *MemMalloc(size_t mem_size);
@@ -46,6 +51,8 @@ class CPUResourceManager {
   uint8_t *mem_ptr_{nullptr};
   bool dynamic_malloc_{false};
   std::map<void *, size_t> dynamic_mem_;
+  size_t dynamic_mem_size_{0};
+  size_t dynamic_mem_peak_{0};
 };
 }  // namespace cpu
 }  // namespace device
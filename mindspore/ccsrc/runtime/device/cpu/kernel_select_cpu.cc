@@ -19,8 +19,11 @@
 #include <string>
 #include <memory>
 #include <algorithm>
+#include <set>
 
 #include "backend/kernel_compiler/cpu/cpu_kernel_factory.h"
+#include "frontend/operator/ops.h"
+#include "utils/ms_utils.h"
 
 namespace mindspore {
 namespace device {
@@ -28,6 +31,9 @@ namespace cpu {
 using AnfAlgo = mindspore::session::AnfRuntimeAlgorithm;
 using mindspore::kernel::KernelBuildInfo;
 namespace {
+constexpr auto kEnvBlockedFormat = "MS_CPU_BLOCKED_FORMAT";
+constexpr size_t kBlockedFormatDims = 4;
+
 bool IsInputNotCNode(const CNodePtr &kernel_node, size_t input_index) {
   auto input_node = AnfAlgo::VisitKernel(kernel_node->input(input_index + 1), 0).first;
   MS_EXCEPTION_IF_NULL(input_node);
@@ -121,8 +127,46 @@ void ExpandKernelAttr(const CNodePtr &kernel_node, KernelAttr *kernel_attr) {
     kernel_attr->AddOutputAttr(output_dtype);
   }
 }
+
+bool IsBlockedFormatSupported(const CNodePtr &kernel_node) {
+  // The oneDNN kernels which run on NC1HWC0 data, only their data input and output change layout.
+  static const std::set<std::string> kBlockedFormatOps = {prim::kPrimConv2D->name(), prim::kPrimMaxPool->name(),
+                                                          prim::kPrimRelu->name()};
+  if (kBlockedFormatOps.find(AnfAlgo::GetCNodeName(kernel_node)) == kBlockedFormatOps.end()) {
+    return false;
+  }
+  if (AnfAlgo::GetInputTensorNum(kernel_node) == 0 || AnfAlgo::GetOutputTensorNum(kernel_node) != 1) {
+    return false;
+  }
+  return AnfAlgo::GetPrevNodeOutputInferShape(kernel_node, 0).size() == kBlockedFormatDims &&
+         AnfAlgo::GetOutputInferShape(kernel_node, 0).size() == kBlockedFormatDims &&
+         AnfAlgo::GetInputDeviceDataType(kernel_node, 0) == kNumberTypeFloat32 &&
+         AnfAlgo::GetOutputDeviceDataType(kernel_node, 0) == kNumberTypeFloat32;
+}
 }  // namespace
 
+bool IsBlockedFormatEnabled() { return common::GetEnv(kEnvBlockedFormat) == "1"; }
+
+void SetBlockedFormat(const CNodePtr &kernel_node) {
+  MS_EXCEPTION_IF_NULL(kernel_node);
+  if (!IsBlockedFormatSupported(kernel_node)) {
+    return;
+  }
+  bool input_blocked = AnfAlgo::GetPrevNodeOutputFormat(kernel_node, 0) == kOpFormat_NC1HWC0;
+  if (!input_blocked && AnfAlgo::GetCNodeName(kernel_node) != prim::kPrimConv2D->name()) {
+    return;
+  }
+  auto build_info = AnfAlgo::GetSelectKernelBuildInfo(kernel_node);
+  MS_EXCEPTION_IF_NULL(build_info);
+  auto builder = std::make_shared<kernel::KernelBuildInfo::KernelBuildInfoBuilder>(build_info);
+  MS_EXCEPTION_IF_NULL(builder);
+  auto input_formats = build_info->GetAllInputFormats();
+  input_formats[0] = kOpFormat_NC1HWC0;
+  builder->SetInputsFormat(input_formats);
+  builder->SetOutputsFormat({kOpFormat_NC1HWC0});
+  AnfAlgo::SetSelectKernelBuildInfo(builder->Build(), kernel_node.get());
+}
+
 void SetKernelInfo(const CNodePtr &kernel_node) {
   std::vector<std::string> input_formats;
   std::vector<TypeId> input_types;
@@ -29,6 +29,12 @@ namespace mindspore {
 namespace device {
 namespace cpu {
 void SetKernelInfo(const CNodePtr &apply_kernel_ptr);
+// Whether chains of oneDNN kernels keep their data in the blocked layout NC1HWC0 (nChw16c) instead of NCHW. It is
+// off unless MS_CPU_BLOCKED_FORMAT=1.
+bool IsBlockedFormatEnabled();
+// Switches the selected kernel of the node to NC1HWC0 for its data input and output when the kernel supports it. Conv2D
+// always switches, the others only when their data input is already blocked, so the layout spreads along the chain.
+void SetBlockedFormat(const CNodePtr &kernel_node);
 
 class KernelAttr {
  public:
@@ -0,0 +1,265 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "runtime/device/cpu/profiling/cpu_profiling.h"
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <functional>
+#include <thread>
+#include "backend/session/anf_runtime_algorithm.h"
+#include "debug/common.h"
+#include "utils/log_adapter.h"
+
+namespace mindspore {
+namespace device {
+namespace cpu {
+namespace {
+constexpr size_t kRingBufferCapacity = 1 << 16;
+constexpr size_t kMaxTimelineEvents = 1 << 20;
+constexpr double kNsPerUs = 1000.0;
+
+std::string JsonEscape(const std::string &str) {
+  std::string out;
+  out.reserve(str.size());
+  for (char c : str) {
+    if (c == '"' || c == '\\') {
+      out.push_back('\\');
+      out.push_back(c);
+    } else if (static_cast<unsigned char>(c) >= 0x20) {
+      out.push_back(c);
+    }
+  }
+  return out;
+}
+}  // namespace
+
+KernelEventRingBuffer::KernelEventRingBuffer(size_t capacity_pow2) : slots_(capacity_pow2), mask_(capacity_pow2 - 1) {
+  if (capacity_pow2 == 0 || (capacity_pow2 & (capacity_pow2 - 1)) != 0) {
+    MS_LOG(EXCEPTION) << "The capacity of ring buffer must be a power of 2, but got " << capacity_pow2;
+  }
+}
+
+// Each slot works as a seqlock: an odd sequence number marks a write in progress, 2 * index + 2 marks the event of
+// index as published.
+void KernelEventRingBuffer::Push(const KernelEvent &event) {
+  uint64_t index = head_.fetch_add(1, std::memory_order_relaxed);
+  Slot &slot = slots_[index & mask_];
+  slot.seq.store(2 * index + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  slot.event = event;
+  slot.seq.store(2 * index + 2, std::memory_order_release);
+}
+
+uint64_t KernelEventRingBuffer::Drain(std::vector<KernelEvent> *const out) {
+  MS_EXCEPTION_IF_NULL(out);
+  uint64_t head = head_.load(std::memory_order_acquire);
+  uint64_t lost = 0;
+  if (head - tail_ > slots_.size()) {
+    lost = head - tail_ - slots_.size();
+    tail_ = head - slots_.size();
+  }
+  for (; tail_ < head; ++tail_) {
+    Slot &slot = slots_[tail_ & mask_];
+    uint64_t published = 2 * tail_ + 2;
+    uint64_t seq = slot.seq.load(std::memory_order_acquire);
+    if (seq < published) {
+      // The producer of this slot has not finished yet, pick it up in the next drain.
+      break;
+    }
+    if (seq > published) {
+      ++lost;
+      continue;
+    }
+    KernelEvent event = slot.event;
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (slot.seq.load(std::memory_order_relaxed) != published) {
+      ++lost;
+      continue;
+    }
+    out->push_back(event);
+  }
+  return lost;
+}
+
+CPUProfiler &CPUProfiler::GetInstance() {
+  static CPUProfiler instance;
+  return instance;
+}
+
+CPUProfiler::CPUProfiler() : ring_buffer_(kRingBufferCapacity) {}
+
+uint64_t CPUProfiler::NowNs() {
+  return static_cast<uint64_t>(
+    std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+uint32_t CPUProfiler::CurrentThreadId() {
+  static thread_local uint32_t thread_id =
+    static_cast<uint32_t>(std::hash<std::thread::id>()(std::this_thread::get_id()));
+  return thread_id;
+}
+
+const std::vector<uint32_t> &CPUProfiler::GraphOpIds(uint32_t graph_id, const std::vector<CNodePtr> &kernels) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto iter = graph_op_ids_.find(graph_id);
+  if (iter != graph_op_ids_.end() && iter->second.size() == kernels.size()) {
+    return iter->second;
+  }
+  auto &ids = graph_op_ids_[graph_id];
+  ids = RegisterOpsLocked(kernels);
+  return ids;
+}
+
+std::vector<uint32_t> CPUProfiler::RegisterOpsLocked(const std::vector<CNodePtr> &kernels) {
+  std::vector<uint32_t> ids;
+  ids.reserve(kernels.size());
+  for (const auto &kernel : kernels) {
+    MS_EXCEPTION_IF_NULL(kernel);
+    auto op_name = kernel->fullname_with_scope();
+    auto iter = op_ids_.find(op_name);
+    if (iter != op_ids_.end()) {
+      ids.push_back(iter->second);
+      continue;
+    }
+    auto op_id = static_cast<uint32_t>(summaries_.size());
+    OpSummary summary;
+    summary.op_name = op_name;
+    summary.op_type = AnfAlgo::GetCNodeName(kernel);
+    summaries_.push_back(summary);
+    op_ids_[op_name] = op_id;
+    ids.push_back(op_id);
+  }
+  return ids;
+}
+
+void CPUProfiler::Record(const KernelEvent &event) { ring_buffer_.Push(event); }
+
+void CPUProfiler::StepEnd() {
+  if (ring_buffer_.size() < ring_buffer_.capacity() / 2) {
+    return;
+  }
+  std::lock_guard<std::mutex> lock(mutex_);
+  DrainLocked();
+}
+
+void CPUProfiler::DrainLocked() {
+  std::vector<KernelEvent> events;
+  lost_events_ += ring_buffer_.Drain(&events);
+  for (const auto &event : events) {
+    if (event.op_id >= summaries_.size()) {
+      continue;
+    }
+    auto &summary = summaries_[event.op_id];
+    uint64_t cost_ns = event.end_ns - event.start_ns;
+    summary.count++;
+    summary.total_ns += cost_ns;
+    summary.min_ns = std::min(summary.min_ns, cost_ns);
+    summary.max_ns = std::max(summary.max_ns, cost_ns);
+    summary.bytes_read += event.bytes_read;
+    summary.bytes_written += event.bytes_written;
+    if (first_ns_ == 0 || event.start_ns < first_ns_) {
+      first_ns_ = event.start_ns;
+    }
+    if (timeline_.size() < kMaxTimelineEvents) {
+      timeline_.push_back(event);
+    }
+  }
+}
+
+bool CPUProfiler::Export(const std::string &dir, uint32_t device_id) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  DrainLocked();
+  if (lost_events_ != 0) {
+    MS_LOG(WARNING) << "CPU profiling lost " << lost_events_ << " kernel events because the ring buffer was full.";
+  }
+  if (timeline_.size() >= kMaxTimelineEvents) {
+    MS_LOG(WARNING) << "CPU profiling timeline is truncated to the first " << kMaxTimelineEvents << " kernel events.";
+  }
+  std::string suffix = "_" + std::to_string(device_id);
+  auto timeline_path = Common::GetRealPath(dir + "/cpu_op_timeline" + suffix + ".json");
+  auto summary_path = Common::GetRealPath(dir + "/cpu_op_summary" + suffix + ".csv");
+  if (!timeline_path.has_value() || !summary_path.has_value()) {
+    MS_LOG(ERROR) << "Get real path failed, dir: " << dir;
+    return false;
+  }
+  return WriteTimeline(timeline_path.value()) && WriteSummary(summary_path.value());
+}
+
+// The timeline is written in the chrome trace event format, which can be loaded by chrome://tracing and Perfetto.
+bool CPUProfiler::WriteTimeline(const std::string &file_path) const {
+  std::ofstream ofs(file_path, std::ios::out | std::ios::trunc);
+  if (!ofs.is_open()) {
+    MS_LOG(ERROR) << "Open file " << file_path << " failed.";
+    return false;
+  }
+  ofs << "{\"traceEvents\":[";
+  bool first = true;
+  for (const auto &event : timeline_) {
+    const auto &summary = summaries_[event.op_id];
+    ofs << (first ? "\n" : ",\n") << "{\"name\":\"" << JsonEscape(summary.op_name) << "\",\"cat\":\""
+        << JsonEscape(summary.op_type) << "\",\"ph\":\"X\",\"pid\":0,\"tid\":" << event.thread_id
+        << ",\"ts\":" << static_cast<double>(event.start_ns - first_ns_) / kNsPerUs
+        << ",\"dur\":" << static_cast<double>(event.end_ns - event.start_ns) / kNsPerUs
+        << ",\"args\":{\"bytes_read\":" << event.bytes_read << ",\"bytes_written\":" << event.bytes_written << "}}";
+    first = false;
+  }
+  ofs << "\n],\"displayTimeUnit\":\"ms\"}\n";
+  ofs.close();
+  MS_LOG(INFO) << "Write " << timeline_.size() << " kernel events to " << file_path;
+  return true;
+}
+
+bool CPUProfiler::WriteSummary(const std::string &file_path) const {
+  std::ofstream ofs(file_path, std::ios::out | std::ios::trunc);
+  if (!ofs.is_open()) {
+    MS_LOG(ERROR) << "Open file " << file_path << " failed.";
+    return false;
+  }
+  ofs << "op_name,op_type,count,total_us,avg_us,min_us,max_us,bytes_read,bytes_written\n";
+  for (const auto &summary : summaries_) {
+    if (summary.count == 0) {
+      continue;
+    }
+    ofs << summary.op_name << "," << summary.op_type << "," << summary.count << ","
+        << static_cast<double>(summary.total_ns) / kNsPerUs << ","
+        << static_cast<double>(summary.total_ns) / kNsPerUs / summary.count << ","
+        << static_cast<double>(summary.min_ns) / kNsPerUs << "," << static_cast<double>(summary.max_ns) / kNsPerUs
+        << "," << summary.bytes_read << "," << summary.bytes_written << "\n";
+  }
+  ofs.close();
+  return true;
+}
+
+void CPUProfiler::Clear() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  std::vector<KernelEvent> events;
+  (void)ring_buffer_.Drain(&events);
+  for (auto &summary : summaries_) {
+    summary.count = 0;
+    summary.total_ns = 0;
+    summary.min_ns = UINT64_MAX;
+    summary.max_ns = 0;
+    summary.bytes_read = 0;
+    summary.bytes_written = 0;
+  }
+  timeline_.clear();
+  lost_events_ = 0;
+  first_ns_ = 0;
+}
+}  // namespace cpu
+}  // namespace device
+}  // namespace mindspore
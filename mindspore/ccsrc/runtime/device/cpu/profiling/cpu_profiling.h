@@ -0,0 +1,125 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_RUNTIME_DEVICE_CPU_PROFILING_CPU_PROFILING_H_
+#define MINDSPORE_CCSRC_RUNTIME_DEVICE_CPU_PROFILING_CPU_PROFILING_H_
+
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "ir/anf.h"
+#include "utils/ms_context.h"
+
+namespace mindspore {
+namespace device {
+namespace cpu {
+// One kernel launch as recorded on the launch path, names are kept in the op table of CPUProfiler.
+struct KernelEvent {
+  uint32_t op_id{0};
+  uint32_t thread_id{0};
+  uint64_t start_ns{0};
+  uint64_t end_ns{0};
+  uint64_t bytes_read{0};
+  uint64_t bytes_written{0};
+};
+
+// Fixed capacity ring buffer of kernel events. Any number of launch threads may Push concurrently without a lock,
+// a slot is claimed with one atomic increment and published through its sequence number. Drain is called by a
+// single consumer and skips the slots that have been overwritten since the last drain.
+class KernelEventRingBuffer {
+ public:
+  explicit KernelEventRingBuffer(size_t capacity_pow2);
+  ~KernelEventRingBuffer() = default;
+
+  void Push(const KernelEvent &event);
+  // Move the published events to out, returns the number of events lost because the buffer wrapped around.
+  uint64_t Drain(std::vector<KernelEvent> *const out);
+  uint64_t size() const { return head_.load(std::memory_order_acquire) - tail_; }
+  size_t capacity() const { return slots_.size(); }
+
+ private:
+  struct Slot {
+    std::atomic<uint64_t> seq{0};
+    KernelEvent event;
+  };
+  std::vector<Slot> slots_;
+  uint64_t mask_;
+  std::atomic<uint64_t> head_{0};
+  uint64_t tail_{0};
+};
+
+struct OpSummary {
+  std::string op_name;
+  std::string op_type;
+  uint64_t count{0};
+  uint64_t total_ns{0};
+  uint64_t min_ns{UINT64_MAX};
+  uint64_t max_ns{0};
+  uint64_t bytes_read{0};
+  uint64_t bytes_written{0};
+};
+
+class CPUProfiler {
+ public:
+  static CPUProfiler &GetInstance();
+
+  inline bool IsProfiling() const {
+    auto context = MsContext::GetInstance();
+    MS_EXCEPTION_IF_NULL(context);
+    return context->enable_profiling();
+  }
+  // Resolve the op ids of a graph's execution order on its first profiled run and cache them, the launch loop then
+  // only records integers.
+  const std::vector<uint32_t> &GraphOpIds(uint32_t graph_id, const std::vector<CNodePtr> &kernels);
+  void Record(const KernelEvent &event);
+  // Called after each run, drains the ring buffer into the summary once it is half full.
+  void StepEnd();
+  // Write the chrome trace timeline and the op summary to dir, returns false if the files can not be written.
+  bool Export(const std::string &dir, uint32_t device_id);
+  void Clear();
+
+  static uint64_t NowNs();
+  static uint32_t CurrentThreadId();
+
+ protected:
+  CPUProfiler();
+  ~CPUProfiler() = default;
+
+ private:
+  std::vector<uint32_t> RegisterOpsLocked(const std::vector<CNodePtr> &kernels);
+  void DrainLocked();
+  bool WriteTimeline(const std::string &file_path) const;
+  bool WriteSummary(const std::string &file_path) const;
+
+  KernelEventRingBuffer ring_buffer_;
+  std::mutex mutex_;
+  std::unordered_map<std::string, uint32_t> op_ids_;
+  std::unordered_map<uint32_t, std::vector<uint32_t>> graph_op_ids_;
+  std::vector<OpSummary> summaries_;
+  std::vector<KernelEvent> timeline_;
+  uint64_t lost_events_{0};
+  uint64_t first_ns_{0};
+};
+}  // namespace cpu
+}  // namespace device
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_RUNTIME_DEVICE_CPU_PROFILING_CPU_PROFILING_H_
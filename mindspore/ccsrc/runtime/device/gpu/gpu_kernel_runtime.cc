@@ -193,10 +193,8 @@ bool GPUKernelRuntime::DumpData(mindspore::session::KernelGraph *graph, Debugger
     return true;
   }
   uint32_t cur_iter = dump_conf->cur_iter();
-  if (dump_conf->dump_iter() != 0) {
-    if (cur_iter != dump_conf->dump_iter()) {
-      return true;
-    }
+  if (!dump_conf->IsIterNeedDump(cur_iter)) {
+    return true;
   }
   MS_LOG(INFO) << "Cur iter is " << cur_iter;
   std::string net_name = dump_conf->dump_net_name();
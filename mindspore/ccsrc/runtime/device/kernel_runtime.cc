@@ -38,6 +38,7 @@ namespace mindspore {
 namespace device {
 KernelRuntime::~KernelRuntime() {
 #ifdef ENABLE_DUMP_E2E
+  Dump::Flush();
   dump_conf_ptr_ = nullptr;
 #endif
 }
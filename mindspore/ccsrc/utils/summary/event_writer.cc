@@ -15,6 +15,8 @@
  */
 
 #include "utils/summary/event_writer.h"
+#include <algorithm>
+#include <chrono>
 #include <string>
 #include <memory>
 #include <vector>
@@ -24,8 +26,48 @@
 namespace mindspore {
 namespace summary {
 
+namespace {
+constexpr int32_t kDefaultFlushSteps = 16;
+constexpr int32_t kDefaultFlushIntervalMs = 500;
+constexpr int64_t kDefaultDropBudget = 64 * 1024 * 1024;
+// 8: data length, 4: crc32 of data length, 4: crc32 of data
+constexpr size_t kRecordMetaLength = 16;
+}  // namespace
+
+EventQueue::~EventQueue() {
+  auto node = PopAll();
+  while (node != nullptr) {
+    auto next = node->next;
+    delete node;
+    node = next;
+  }
+}
+
+void EventQueue::Push(Node *node) {
+  auto head = head_.load(std::memory_order_relaxed);
+  do {
+    node->next = head;
+  } while (!head_.compare_exchange_weak(head, node, std::memory_order_release, std::memory_order_relaxed));
+}
+
+EventQueue::Node *EventQueue::PopAll() {
+  auto node = head_.exchange(nullptr, std::memory_order_acquire);
+  Node *reversed = nullptr;
+  while (node != nullptr) {
+    auto next = node->next;
+    node->next = reversed;
+    reversed = node;
+    node = next;
+  }
+  return reversed;
+}
+
 // implement the EventWriter
-EventWriter::EventWriter(const std::string &file_full_name) : filename_(file_full_name), events_write_count_(0) {
+EventWriter::EventWriter(const std::string &file_full_name)
+    : filename_(file_full_name),
+      flush_steps_(kDefaultFlushSteps),
+      flush_interval_ms_(kDefaultFlushIntervalMs),
+      drop_budget_(kDefaultDropBudget) {
   fs_ = system::Env::GetFileSystem();
   if (fs_ == nullptr) {
     MS_LOG(EXCEPTION) << "Get the file system failed.";
@@ -45,10 +87,11 @@ EventWriter::~EventWriter() {
       MS_LOG(ERROR) << "Close file(" << filename_ << ") failed.";
     }
   }
+  StopWriter();
 }
 
 // get the write event count
-int32_t EventWriter::GetWriteEventCount() const { return events_write_count_; }
+int32_t EventWriter::GetWriteEventCount() const { return events_write_count_.load(); }
 
 // Open the file
 bool EventWriter::Open() {
@@ -63,19 +106,172 @@ bool EventWriter::Open() {
   return result;
 }
 
+void EventWriter::SetFlushPolicy(int32_t flush_steps, int32_t flush_interval_ms) {
+  if (flush_steps <= 0 || flush_interval_ms <= 0) {
+    MS_LOG(EXCEPTION) << "The flush steps(" << flush_steps << ") and flush interval(" << flush_interval_ms
+                      << "ms) should be positive.";
+  }
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    flush_steps_ = flush_steps;
+    flush_interval_ms_ = flush_interval_ms;
+  }
+  wake_cv_.notify_one();
+}
+
+void EventWriter::SetDropBudget(int64_t drop_budget) {
+  if (drop_budget < 0) {
+    MS_LOG(EXCEPTION) << "The drop budget(" << drop_budget << ") should not be negative.";
+  }
+  std::lock_guard<std::mutex> lock(mutex_);
+  drop_budget_ = drop_budget;
+}
+
 // write the event serialization string to file
 void EventWriter::Write(const std::string &event_str) {
   if (event_file_ == nullptr) {
     MS_LOG(ERROR) << "Write failed because file could not be opened.";
     return;
   }
+  (void)Enqueue(event_str, false);
+}
+
+bool EventWriter::WriteDroppable(const std::string &event_str) {
+  if (event_file_ == nullptr) {
+    MS_LOG(ERROR) << "Write failed because file could not be opened.";
+    return false;
+  }
+  return Enqueue(event_str, true);
+}
+
+void EventWriter::StepEnd() {
+  if (pending_steps_.fetch_add(1) + 1 == flush_steps_) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    wake_cv_.notify_one();
+  }
+}
+
+bool EventWriter::Enqueue(const std::string &event_str, bool droppable) {
+  if (!writer_started_) {
+    StartWriter();
+  }
+  if (writer_stopped_) {
+    events_write_count_++;
+    if (!WriteRecord(event_str)) {
+      MS_LOG(ERROR) << "Event write failed.";
+    }
+    return true;
+  }
+  auto size = static_cast<int64_t>(event_str.size());
+  if (droppable) {
+    if (pending_drop_bytes_.fetch_add(size) + size > drop_budget_) {
+      (void)pending_drop_bytes_.fetch_sub(size);
+      // log the first drop and then every 100 drops
+      if (events_drop_count_++ % 100 == 0) {
+        MS_LOG(WARNING) << "The summary writer of file(" << filename_ << ") falls behind, " << events_drop_count_
+                        << " droppable events are dropped.";
+      }
+      return false;
+    }
+  }
   events_write_count_++;
-  bool result = WriteRecord(event_str);
-  if (!result) {
+  auto node = new EventQueue::Node();
+  node->data = event_str;
+  node->droppable = droppable;
+  queue_.Push(node);
+  (void)enqueued_events_.fetch_add(1);
+  return true;
+}
+
+void EventWriter::StartWriter() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (writer_started_ || writer_stopped_) {
+    return;
+  }
+  writer_started_ = true;
+  writer_ = std::thread(&EventWriter::WriterLoop, this);
+}
+
+void EventWriter::StopWriter() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!writer_started_ || writer_stopped_) {
+      writer_stopped_ = true;
+      return;
+    }
+    stop_ = true;
+  }
+  wake_cv_.notify_one();
+  if (writer_.joinable()) {
+    writer_.join();
+  }
+  writer_stopped_ = true;
+  // Write the events enqueued while the writer thread was exiting
+  int64_t count = 0;
+  if (!WriteBatch(queue_.PopAll(), &count)) {
     MS_LOG(ERROR) << "Event write failed.";
   }
 }
 
+void EventWriter::WriterLoop() {
+  while (true) {
+    bool stop = false;
+    bool flush = false;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      (void)wake_cv_.wait_for(lock, std::chrono::milliseconds(flush_interval_ms_), [this]() {
+        return stop_ || written_events_ < flush_target_ || pending_steps_.load() >= flush_steps_;
+      });
+      stop = stop_;
+      flush = written_events_ < flush_target_;
+    }
+    // The batch taken below holds every event of the steps ended so far
+    pending_steps_ = 0;
+    int64_t count = 0;
+    bool result = WriteBatch(queue_.PopAll(), &count);
+    if (!result) {
+      MS_LOG(ERROR) << "Event write failed.";
+    }
+    if (flush && !event_file_->Flush()) {
+      MS_LOG(ERROR) << "Failed to sync to file(" << filename_ << ").";
+    }
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      written_events_ += count;
+    }
+    written_cv_.notify_all();
+    if (stop && queue_.Empty()) {
+      return;
+    }
+  }
+}
+
+bool EventWriter::WriteBatch(EventQueue::Node *batch, int64_t *count) {
+  if (batch == nullptr) {
+    return true;
+  }
+  size_t total_size = 0;
+  for (auto node = batch; node != nullptr; node = node->next) {
+    total_size += node->data.size() + kRecordMetaLength;
+  }
+  std::string buffer;
+  buffer.reserve(total_size);
+  int64_t drop_bytes = 0;
+  while (batch != nullptr) {
+    EncodeRecord(batch->data, &buffer);
+    if (batch->droppable) {
+      drop_bytes += static_cast<int64_t>(batch->data.size());
+    }
+    auto next = batch->next;
+    delete batch;
+    batch = next;
+    ++(*count);
+  }
+  bool result = event_file_->Write(buffer);
+  (void)pending_drop_bytes_.fetch_sub(drop_bytes);
+  return result;
+}
+
 bool EventWriter::Flush() {
   // Confirm the event file is exist?
   if (!fs_->FileExist(filename_)) {
@@ -86,6 +282,17 @@ bool EventWriter::Flush() {
     MS_LOG(ERROR) << "Can't flush because the event file is null.";
     return false;
   }
+  {
+    // Wait for the writer thread to write and sync the events enqueued before
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (writer_started_ && !writer_stopped_) {
+      flush_target_ = std::max(flush_target_, enqueued_events_.load());
+      wake_cv_.notify_one();
+      written_cv_.wait(lock, [this]() { return written_events_ >= flush_target_; });
+      MS_LOG(DEBUG) << "Flush " << events_write_count_ << " events to disk file(" << filename_ << ").";
+      return true;
+    }
+  }
   // Sync the file
   if (!event_file_->Flush()) {
     MS_LOG(ERROR) << "Failed to sync to file(" << filename_ << "), the event count(" << events_write_count_ << ").";
@@ -102,6 +309,7 @@ bool EventWriter::Close() noexcept {
     MS_LOG(INFO) << "The event writer is closed.";
     return result;
   }
+  StopWriter();
   if (event_file_ != nullptr) {
     result = event_file_->Close();
     if (!result) {
@@ -117,6 +325,7 @@ bool EventWriter::Shut() noexcept {
     MS_LOG(INFO) << "The event writer is closed.";
     return true;
   }
+  StopWriter();
   bool result = Flush();
   if (!result) {
     MS_LOG(ERROR) << "Flush failed when close the file.";
@@ -138,50 +347,44 @@ bool EventWriter::Shut() noexcept {
 //  2 uint32 : mask crc value of data length
 //  3 bytes  : data
 //  4 uint32 : mask crc value of data
-bool EventWriter::WriteRecord(const std::string &data) {
-  if (event_file_ == nullptr) {
-    MS_LOG(ERROR) << "Writer not initialized or previously closed.";
-    return false;
-  }
-  // Write the data to event file
+void EventWriter::EncodeRecord(const std::string &data, std::string *out) {
+  MS_EXCEPTION_IF_NULL(out);
   const unsigned int kArrayLen = sizeof(uint64_t);
   char data_len_array[kArrayLen];
   char crc_array[sizeof(uint32_t)];
 
-  // step 1: write the data length
+  // step 1: the data length
   system::EncodeFixed64(data_len_array, kArrayLen, static_cast<int64_t>(data.size()));
-  bool result = event_file_->Write(string(data_len_array, sizeof(data_len_array)));
-  if (!result) {
-    MS_LOG(ERROR) << "Write the Summary data length failed.";
-    return false;
-  }
+  (void)out->append(data_len_array, sizeof(data_len_array));
 
-  // step 2: write the crc of data length
+  // step 2: the crc of data length
   system::EncodeFixed64(data_len_array, kArrayLen, SizeToInt(data.size()));
   uint32_t crc = system::Crc32c::GetMaskCrc32cValue(data_len_array, sizeof(data_len_array));
   system::EncodeFixed32(crc_array, crc);
-  result = event_file_->Write(string(crc_array, sizeof(crc_array)));
-  if (!result) {
-    MS_LOG(ERROR) << "Write the Summary data length crc failed.";
-    return false;
-  }
+  (void)out->append(crc_array, sizeof(crc_array));
 
-  // step 3: write the data
-  result = event_file_->Write(data);
-  if (!result) {
-    MS_LOG(ERROR) << "Write the Summary data failed.";
-    return false;
-  }
+  // step 3: the data
+  (void)out->append(data);
 
-  // step 4: write data crc
+  // step 4: the data crc
   crc = system::Crc32c::GetMaskCrc32cValue(data.data(), data.size());
   system::EncodeFixed32(crc_array, crc);
-  result = event_file_->Write(string(crc_array, sizeof(crc_array)));
+  (void)out->append(crc_array, sizeof(crc_array));
+}
+
+bool EventWriter::WriteRecord(const std::string &data) {
+  if (event_file_ == nullptr) {
+    MS_LOG(ERROR) << "Writer not initialized or previously closed.";
+    return false;
+  }
+  std::string record;
+  record.reserve(data.size() + kRecordMetaLength);
+  EncodeRecord(data, &record);
+  bool result = event_file_->Write(record);
   if (!result) {
-    MS_LOG(ERROR) << "Write the Summary footer failed.";
+    MS_LOG(ERROR) << "Write the Summary record failed.";
     return false;
   }
-
   return true;
 }
 
@@ -17,8 +17,12 @@
 #ifndef SUMMARY_EVENT_WRITER_H_
 #define SUMMARY_EVENT_WRITER_H_
 
+#include <atomic>
+#include <condition_variable>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
 
 #include "pybind11/pybind11.h"
 #include "securec/include/securec.h"
@@ -36,6 +40,32 @@ using WriteFile = system::WriteFile;
 using WriteFilePtr = std::shared_ptr<WriteFile>;
 using FileSystem = system::FileSystem;
 
+// Lock free multi-producer single-consumer queue of serialized events. Producers push with one CAS on the head of
+// an intrusive stack, the consumer takes the whole stack with one exchange and reverses it into write order.
+class EventQueue {
+ public:
+  struct Node {
+    std::string data;
+    bool droppable{false};
+    Node *next{nullptr};
+  };
+
+  EventQueue() = default;
+  ~EventQueue();
+
+  void Push(Node *node);
+  // Return all pushed nodes in push order, the caller owns the list.
+  Node *PopAll();
+  bool Empty() const { return head_.load(std::memory_order_acquire) == nullptr; }
+
+ private:
+  std::atomic<Node *> head_{nullptr};
+};
+
+// Events are written by a background thread: Write only copies the event into the queue, the writer thread
+// computes the crc of a batch of records and writes them with one file write. A batch is written when
+// flush_steps steps have ended (see StepEnd) or flush_interval_ms has passed, and Flush/Close/Shut drain the queue
+// first.
 class EventWriter {
  public:
   // The file name = path + file_name
@@ -52,9 +82,25 @@ class EventWriter {
   // Open the file
   bool Open();
 
-  // write the Serialized "event_str" to file
+  // write the Serialized "event_str" to file, the event is never dropped
   void Write(const std::string &event_str);
 
+  // write an event that may be dropped when the pending droppable events exceed the drop budget,
+  // used for the large summaries such as histogram and image, return false if the event is dropped
+  bool WriteDroppable(const std::string &event_str);
+
+  // mark the end of a step, the events written so far belong to it
+  void StepEnd();
+
+  // write the pending events when flush_steps steps have ended or every flush_interval_ms
+  void SetFlushPolicy(int32_t flush_steps, int32_t flush_interval_ms);
+
+  // the bytes of droppable events allowed to wait for the writer thread
+  void SetDropBudget(int64_t drop_budget);
+
+  // return the count of dropped event
+  int32_t GetDropEventCount() const { return events_drop_count_.load(); }
+
   // Flush the cache to disk
   bool Flush();
 
@@ -71,13 +117,42 @@ class EventWriter {
   //  4 uint32 : mask crc value of data
   bool WriteRecord(const std::string &data);
 
+  // Append the record of data in the format above to out
+  static void EncodeRecord(const std::string &data, std::string *out);
+
  private:
+  bool Enqueue(const std::string &event_str, bool droppable);
+  void StartWriter();
+  // Drain the queue and stop the writer thread, later writes are written synchronously
+  void StopWriter();
+  void WriterLoop();
+  bool WriteBatch(EventQueue::Node *batch, int64_t *count);
+
   // True: valid / False: closed
   bool status_ = false;
   std::shared_ptr<FileSystem> fs_;
   std::string filename_;
   WriteFilePtr event_file_;
-  int32_t events_write_count_ = 0;
+  std::atomic<int32_t> events_write_count_{0};
+  std::atomic<int32_t> events_drop_count_{0};
+
+  EventQueue queue_;
+  std::atomic<int32_t> pending_steps_{0};
+  std::atomic<int64_t> pending_drop_bytes_{0};
+  // count of the events enqueued and written, Flush waits until written_events_ reaches flush_target_
+  std::atomic<int64_t> enqueued_events_{0};
+  int64_t written_events_ = 0;
+  int64_t flush_target_ = 0;
+  std::atomic<int32_t> flush_steps_;
+  int32_t flush_interval_ms_;
+  std::atomic<int64_t> drop_budget_;
+  std::mutex mutex_;
+  std::condition_variable wake_cv_;
+  std::condition_variable written_cv_;
+  std::thread writer_;
+  std::atomic<bool> writer_started_{false};
+  std::atomic<bool> writer_stopped_{false};
+  bool stop_ = false;
 };
 
 }  // namespace summary
@@ -0,0 +1,181 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "utils/system/lz4.h"
+#include <cstring>
+
+namespace mindspore {
+namespace system {
+namespace {
+constexpr size_t kMinMatch = 4;
+// The last match must start at least 12 bytes before the end of block, and the last 5 bytes are always literals.
+constexpr size_t kMatchFindLimit = 12;
+constexpr size_t kLastLiterals = 5;
+constexpr size_t kMaxOffset = 65535;
+constexpr int kHashLog = 16;
+constexpr uint32_t kHashPrime = 2654435761U;
+constexpr uint8_t kRunMask = 15;
+
+inline uint32_t Read32(const uint8_t *p) {
+  uint32_t value;
+  (void)memcpy(&value, p, sizeof(value));
+  return value;
+}
+
+inline uint32_t Hash(uint32_t sequence) { return (sequence * kHashPrime) >> (32 - kHashLog); }
+
+inline void WriteLength(size_t length, std::vector<char> *out) {
+  for (; length >= 255; length -= 255) {
+    out->push_back(static_cast<char>(255));
+  }
+  out->push_back(static_cast<char>(length));
+}
+
+void WriteSequence(const uint8_t *literals, size_t literal_len, size_t offset, size_t match_len,
+                   std::vector<char> *out) {
+  uint8_t token = static_cast<uint8_t>((literal_len < kRunMask ? literal_len : kRunMask) << 4);
+  if (match_len != 0) {
+    size_t match_code = match_len - kMinMatch;
+    token |= static_cast<uint8_t>(match_code < kRunMask ? match_code : kRunMask);
+  }
+  out->push_back(static_cast<char>(token));
+  if (literal_len >= kRunMask) {
+    WriteLength(literal_len - kRunMask, out);
+  }
+  out->insert(out->end(), literals, literals + literal_len);
+  if (match_len == 0) {
+    return;
+  }
+  out->push_back(static_cast<char>(offset & 0xff));
+  out->push_back(static_cast<char>(offset >> 8));
+  if (match_len - kMinMatch >= kRunMask) {
+    WriteLength(match_len - kMinMatch - kRunMask, out);
+  }
+}
+
+// The hash table is kept per thread and reused by every Compress call instead of allocating and clearing 512KB per
+// block. Positions are stored relative to a base that each call moves past its own block, so the entries left by the
+// previous blocks are below the base and read as empty without clearing the table.
+struct HashTable {
+  std::vector<uint64_t> entries = std::vector<uint64_t>(1 << kHashLog, 0);
+  uint64_t base{1};
+};
+
+bool ReadLength(const uint8_t **ip, const uint8_t *end, size_t *length) {
+  uint8_t byte;
+  do {
+    if (*ip >= end) {
+      return false;
+    }
+    byte = *(*ip)++;
+    *length += byte;
+  } while (byte == 255);
+  return true;
+}
+}  // namespace
+
+size_t Lz4::Compress(const char *src, size_t size, std::vector<char> *out) {
+  if (out == nullptr || (src == nullptr && size != 0)) {
+    return 0;
+  }
+  size_t begin = out->size();
+  out->reserve(begin + MaxCompressedSize(size));
+  auto base = reinterpret_cast<const uint8_t *>(src);
+  size_t anchor = 0;
+  if (size > kMatchFindLimit) {
+    static thread_local HashTable table;
+    uint64_t table_base = table.base;
+    table.base += size;
+    size_t match_limit = size - kLastLiterals;
+    size_t pos = 0;
+    while (pos < size - kMatchFindLimit) {
+      uint32_t sequence = Read32(base + pos);
+      uint32_t h = Hash(sequence);
+      uint64_t entry = table.entries[h];
+      table.entries[h] = table_base + pos;
+      if (entry < table_base) {
+        ++pos;
+        continue;
+      }
+      size_t ref = static_cast<size_t>(entry - table_base);
+      if (pos - ref > kMaxOffset || Read32(base + ref) != sequence) {
+        ++pos;
+        continue;
+      }
+      size_t match_len = kMinMatch;
+      while (pos + match_len < match_limit && base[ref + match_len] == base[pos + match_len]) {
+        ++match_len;
+      }
+      WriteSequence(base + anchor, pos - anchor, pos - ref, match_len, out);
+      pos += match_len;
+      anchor = pos;
+    }
+  }
+  WriteSequence(base + anchor, size - anchor, 0, 0, out);
+  return out->size() - begin;
+}
+
+bool Lz4::Decompress(const char *src, size_t size, char *dst, size_t dst_size) {
+  if ((src == nullptr && size != 0) || (dst == nullptr && dst_size != 0)) {
+    return false;
+  }
+  auto ip = reinterpret_cast<const uint8_t *>(src);
+  const uint8_t *ip_end = ip + size;
+  auto op = reinterpret_cast<uint8_t *>(dst);
+  uint8_t *op_begin = op;
+  uint8_t *op_end = op + dst_size;
+  while (ip < ip_end) {
+    uint8_t token = *ip++;
+    size_t literal_len = token >> 4;
+    if (literal_len == kRunMask && !ReadLength(&ip, ip_end, &literal_len)) {
+      return false;
+    }
+    if (literal_len > static_cast<size_t>(ip_end - ip) || literal_len > static_cast<size_t>(op_end - op)) {
+      return false;
+    }
+    (void)memcpy(op, ip, literal_len);
+    ip += literal_len;
+    op += literal_len;
+    if (ip == ip_end) {
+      break;
+    }
+    if (ip_end - ip < 2) {
+      return false;
+    }
+    size_t offset = ip[0] | (static_cast<size_t>(ip[1]) << 8);
+    ip += 2;
+    if (offset == 0 || offset > static_cast<size_t>(op - op_begin)) {
+      return false;
+    }
+    size_t match_len = token & kRunMask;
+    if (match_len == kRunMask && !ReadLength(&ip, ip_end, &match_len)) {
+      return false;
+    }
+    match_len += kMinMatch;
+    if (match_len > static_cast<size_t>(op_end - op)) {
+      return false;
+    }
+    // The match may overlap the bytes it produces, so copy byte by byte.
+    const uint8_t *match = op - offset;
+    for (size_t i = 0; i < match_len; ++i) {
+      op[i] = match[i];
+    }
+    op += match_len;
+  }
+  return op == op_end;
+}
+}  // namespace system
+}  // namespace mindspore
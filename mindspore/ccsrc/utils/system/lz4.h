@@ -0,0 +1,47 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_UTILS_SYSTEM_LZ4_H_
+#define MINDSPORE_CCSRC_UTILS_SYSTEM_LZ4_H_
+
+#include <stddef.h>
+#include <cstdint>
+#include <vector>
+
+namespace mindspore {
+namespace system {
+// Provide the LZ4 block format codec, the output can be read by any lz4 implementation (e.g. LZ4_decompress_safe).
+// Only the fast single-pass compression level is supported, which is meant for dumping large tensors where the
+// compression must keep up with the disk.
+class Lz4 {
+ public:
+  Lz4() = default;
+  ~Lz4() = default;
+
+  // The upper bound of the compressed size of size bytes.
+  static size_t MaxCompressedSize(size_t size) { return size + size / 255 + 16; }
+
+  // Compress size bytes of src and append the block to out, returns the number of bytes appended.
+  static size_t Compress(const char *src, size_t size, std::vector<char> *out);
+
+  // Decompress a block of size bytes into dst, which must be exactly dst_size bytes of the original data.
+  // Returns false if the block is corrupted or does not match dst_size.
+  static bool Decompress(const char *src, size_t size, char *dst, size_t dst_size);
+};
+}  // namespace system
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_UTILS_SYSTEM_LZ4_H_
@@ -58,19 +58,108 @@ std::ostream &operator<<(std::ostream &os, const SwitchCondStatus &other) {
   return os;
 }
 
+namespace {
+bool DecodeSlots(const VectorRef &args, size_t begin, std::vector<int> *const slots) {
+  MS_EXCEPTION_IF_NULL(slots);
+  slots->clear();
+  slots->reserve(args.size() > begin ? args.size() - begin : 0);
+  for (size_t i = begin; i < args.size(); ++i) {
+    if (!utils::isa<int>(args[i])) {
+      return false;
+    }
+    slots->push_back(utils::cast<int>(args[i]));
+  }
+  return true;
+}
+
+// Decode one instruction, returns false if its arguments do not match the layout emitted by CompileGraph.
+bool DecodeInst(const InstType &inst, DecodedInst *const decoded) {
+  MS_EXCEPTION_IF_NULL(decoded);
+  const VectorRef &args = inst.second;
+  decoded->op = inst.first;
+  switch (inst.first) {
+    case Instruction::kCall:
+    case Instruction::kInput:
+    case Instruction::kPadStack:
+      return args.size() == 1 && DecodeSlots(args, 0, &decoded->slots);
+    case Instruction::kReturn:
+    case Instruction::kSwitchLayer:
+      return args.size() == 2 && DecodeSlots(args, 0, &decoded->slots);
+    case Instruction::kTailCall:
+    case Instruction::kSwitch:
+      return args.size() == 3 && DecodeSlots(args, 0, &decoded->slots);
+    case Instruction::kPartial:
+      return !args.empty() && DecodeSlots(args, 0, &decoded->slots);
+    case Instruction::kTuple:
+      return DecodeSlots(args, 0, &decoded->slots);
+    case Instruction::kSwitchReturn:
+      return args.size() == 1;
+    case Instruction::kPush:
+      if (args.size() != 1) {
+        return false;
+      }
+      decoded->value = args[0];
+      return true;
+    case Instruction::kExternal:
+      if (args.size() < 2 || !utils::isa<RunFunctionRef>(args[0])) {
+        return false;
+      }
+      decoded->func = utils::cast<RunFunctionRef>(args[0]).func_;
+      return decoded->func != nullptr && DecodeSlots(args, 2, &decoded->slots);
+    case Instruction::kPrim:
+      if (args.size() < 2 || !utils::isa<PrimitivePtr>(args[0])) {
+        return false;
+      }
+      decoded->prim = utils::cast<PrimitivePtr>(args[0]);
+      return decoded->prim != nullptr && DecodeSlots(args, 1, &decoded->slots);
+    default:
+      return false;
+  }
+}
+
+std::vector<int> ArgsToSlots(const VectorRef &args, size_t begin) {
+  std::vector<int> slots;
+  slots.reserve(args.size() > begin ? args.size() - begin : 0);
+  for (size_t i = begin; i < args.size(); ++i) {
+    slots.push_back(utils::cast<int>(args[i]));
+  }
+  return slots;
+}
+}  // namespace
+
 // Follow the specified instructions to create a VM.
 // Arguments:
 //   insts_: std::vector<std::map<std::string, VectorRef>>
+//   decoded_insts_: insts_ with the arguments decoded ahead of time.
 //   insts_stack_: The value stack.
 //   retp_: The call stack.
 //   pc_: program counter (next instruction)
 //   sp_: stack pointer (for the value stack)
 FinalVM::FinalVM(const InstSet &insts, const BackendPtr &backend) : insts_(insts), pc_(0), sp_(0), backend_(backend) {
   MS_LOG(DEBUG) << "InstSet size:" << insts_.size();
+  Decode();
   insts_stack_.emplace_back(BaseRef());
   retp_.push(-1);
 }
 
+void FinalVM::set_insts(const InstSet &value) {
+  insts_ = value;
+  Decode();
+}
+
+void FinalVM::Decode() {
+  decoded_insts_.clear();
+  decoded_insts_.resize(insts_.size());
+  size_t fallback_count = 0;
+  for (size_t i = 0; i < insts_.size(); ++i) {
+    decoded_insts_[i].decoded = DecodeInst(insts_[i], &decoded_insts_[i]);
+    if (!decoded_insts_[i].decoded) {
+      ++fallback_count;
+    }
+  }
+  MS_LOG(DEBUG) << "Decoded instructions:" << insts_.size() - fallback_count << ", fallback:" << fallback_count;
+}
+
 void FinalVM::Push(const BaseRef &v) {
   MS_LOG(DEBUG) << "Push " << v.ToString() << " sp_:" << sp_;
   insts_stack_[IntToSize(sp_++)] = v;
@@ -94,7 +183,7 @@ void FinalVM::MoveStack(int nitems, int height) {
   int src = sp_ - height;
   int dst = sp_ - nitems;
   for (int i = 0; i < nitems; i++) {
-    insts_stack_[IntToSize(src + i)] = insts_stack_[IntToSize(dst + i)];
+    insts_stack_[IntToSize(src + i)] = std::move(insts_stack_[IntToSize(dst + i)]);
   }
   Pop(n);
 }
@@ -146,8 +235,8 @@ void FinalVM::DoJmp(const BaseRef &jmp_orig) {
   if (utils::isa<StructPartial>(jmp)) {  // need to inherit from Base
     MS_LOG(DEBUG) << "Start jump StructPartial";
     auto new_jmp = utils::cast<std::shared_ptr<StructPartial>>(jmp);
-    auto args = new_jmp->args_;
-    InstPadStack(VectorRef(std::vector<BaseRef>{static_cast<int>(args.size())}));
+    auto &args = new_jmp->args_;
+    DoPadStack(static_cast<int>(args.size()));
     auto iter = args.rbegin();
     for (; iter != args.rend(); ++iter) {
       Push(*iter);
@@ -186,15 +275,24 @@ BaseRef FinalVM::Eval(const VectorRef &args) {
     Push(*riter);
   }
 
+  const size_t insts_size = decoded_insts_.size();
   while (pc_ >= 0) {
-    auto inst = insts_[IntToSize(pc_)];
-    MS_LOG(DEBUG) << "Loop " << insts_.size() << ", pc:" << pc_ << ", inst:" << inst_str[inst.first];
+    size_t pc = IntToSize(pc_);
+    if (pc >= insts_size) {
+      MS_LOG(EXCEPTION) << "Program counter " << pc << " out of range [0, " << insts_size << ").";
+    }
+    const DecodedInst &inst = decoded_insts_[pc];
+    MS_LOG(DEBUG) << "Loop " << insts_size << ", pc:" << pc_ << ", inst:" << inst_str[inst.op];
     ++pc_;
-    auto iter = inst_function_map.find(inst.first);
+    if (inst.decoded) {
+      Dispatch(inst);
+      continue;
+    }
+    auto iter = inst_function_map.find(inst.op);
     if (iter != inst_function_map.end()) {
-      iter->second(inst.second);
+      iter->second(insts_[pc].second);
     } else {
-      MS_LOG(EXCEPTION) << "Unknown instruction {" << inst_str[inst.first] << "}";
+      MS_LOG(EXCEPTION) << "Unknown instruction {" << inst_str[inst.op] << "}";
     }
   }
 
@@ -202,6 +300,54 @@ BaseRef FinalVM::Eval(const VectorRef &args) {
   return insts_stack_[0];
 }
 
+void FinalVM::Dispatch(const DecodedInst &inst) {
+  const std::vector<int> &slots = inst.slots;
+  switch (inst.op) {
+    case Instruction::kCall:
+      DoCall(slots[0]);
+      break;
+    case Instruction::kTailCall:
+      DoTailCall(slots[0], slots[1], slots[2]);
+      break;
+    case Instruction::kReturn:
+      DoReturn(slots[0], slots[1]);
+      break;
+    case Instruction::kPartial:
+      DoPartial(slots);
+      break;
+    case Instruction::kSwitch:
+      DoSwitch(slots[0], slots[1], slots[2]);
+      break;
+    case Instruction::kSwitchReturn:
+      Pop(1);
+      Popsp();
+      break;
+    case Instruction::kTuple:
+      DoTuple(slots);
+      break;
+    case Instruction::kInput:
+      Push(Ref(slots[0]));
+      break;
+    case Instruction::kExternal:
+      DoExternal(inst.func, slots);
+      break;
+    case Instruction::kPush:
+      Push(inst.value);
+      break;
+    case Instruction::kPrim:
+      DoPrim(inst.prim, slots);
+      break;
+    case Instruction::kPadStack:
+      DoPadStack(slots[0]);
+      break;
+    case Instruction::kSwitchLayer:
+      DoSwitchLayer(slots[0], slots[1]);
+      break;
+    default:
+      MS_LOG(EXCEPTION) << "Unknown instruction {" << inst_str[inst.op] << "}";
+  }
+}
+
 void FinalVM::InstCall(const VectorRef &args) {
   MS_LOG(DEBUG) << "Start";
   const size_t args_size = 1;
@@ -211,7 +357,10 @@ void FinalVM::InstCall(const VectorRef &args) {
     return;
   }
 
-  int jmp = utils::cast<int>(args[0]);
+  DoCall(utils::cast<int>(args[0]));
+}
+
+void FinalVM::DoCall(int jmp) {
   MS_LOG(DEBUG) << "Call pushp:" << pc_ << ", jmp:" << jmp << ", sp:" << sp_;
   Pushp();
   DoJmp(Ref(jmp));
@@ -227,10 +376,10 @@ void FinalVM::InstTailCall(const VectorRef &args) {
     return;
   }
 
-  int jmp = utils::cast<int>(args[0]);
-  int height = utils::cast<int>(args[1]);
-  int nargs = utils::cast<int>(args[2]);
+  DoTailCall(utils::cast<int>(args[0]), utils::cast<int>(args[1]), utils::cast<int>(args[2]));
+}
 
+void FinalVM::DoTailCall(int jmp, int height, int nargs) {
   auto new_jmp = Ref(jmp);
   MoveStack(nargs, height);
   MS_LOG(DEBUG) << "TailCall pushp:" << pc_ << ", jmp:" << jmp;
@@ -257,9 +406,10 @@ void FinalVM::InstReturn(const VectorRef &args) {
     return;
   }
 
-  int rpos = utils::cast<int>(args[0]);
-  int height = utils::cast<int>(args[1]);
+  DoReturn(utils::cast<int>(args[0]), utils::cast<int>(args[1]));
+}
 
+void FinalVM::DoReturn(int rpos, int height) {
   auto rv = Ref(rpos);
   Pop(height);
   Push(rv);
@@ -275,12 +425,14 @@ void FinalVM::InstRealPartial(const VectorRef &args) {
     return;
   }
 
-  int fn_ = utils::cast<int>(args[0]);
-  auto fn = utils::cast<int>(Ref(fn_));
-  MS_LOG(DEBUG) << "Partial argssize:" << args.size();
-  std::vector<BaseRef> outs(args.size() - 1);
-  (void)std::transform(args.begin() + 1, args.end(), outs.begin(),
-                       [&, this](const BaseRef &a) { return Ref(utils::cast<int>(a)); });
+  DoPartial(ArgsToSlots(args, 0));
+}
+
+void FinalVM::DoPartial(const std::vector<int> &slots) {
+  auto fn = utils::cast<int>(Ref(slots[0]));
+  MS_LOG(DEBUG) << "Partial argssize:" << slots.size();
+  std::vector<BaseRef> outs(slots.size() - 1);
+  (void)std::transform(slots.begin() + 1, slots.end(), outs.begin(), [this](int a) { return Ref(a); });
   Push(std::make_shared<StructPartial>(fn, VectorRef(outs)));
 }
 
@@ -298,10 +450,10 @@ void FinalVM::InstRealSwitch(const VectorRef &args) {
     return;
   }
 
-  int cond = utils::cast<int>(args[0]);
-  int vtrue = utils::cast<int>(args[1]);
-  int vfalse = utils::cast<int>(args[2]);
+  DoSwitch(utils::cast<int>(args[0]), utils::cast<int>(args[1]), utils::cast<int>(args[2]));
+}
 
+void FinalVM::DoSwitch(int cond, int vtrue, int vfalse) {
   BaseRef c = Ref(cond);
   MS_LOG(DEBUG) << vtrue << " false:" << vfalse << " InstSwitch: " << c.ToString();
   bool bool_value = false;
@@ -332,8 +484,12 @@ void FinalVM::InstSwitchLayer(const VectorRef &args) {
     return;
   }
 
-  int idx = utils::cast<int>(args[0]);
-  VectorRef branches = utils::cast<VectorRef>(Ref(utils::cast<int>(args[1])));
+  DoSwitchLayer(utils::cast<int>(args[0]), utils::cast<int>(args[1]));
+  MS_LOG(DEBUG) << "End";
+}
+
+void FinalVM::DoSwitchLayer(int idx, int branches_pos) {
+  VectorRef branches = utils::cast<VectorRef>(Ref(branches_pos));
   int size = static_cast<int>(branches.size());
 
   BaseRef index = Ref(idx);
@@ -350,19 +506,21 @@ void FinalVM::InstSwitchLayer(const VectorRef &args) {
                       << "of index in [" << -size << ", " << size << "), and the type is int32.";
   }
   Push(branches[idx_value]);
-  MS_LOG(DEBUG) << "End";
 }
 
 void FinalVM::InstTuple(const VectorRef &args) {
   MS_LOG(DEBUG) << "Start";
+  DoTuple(ArgsToSlots(args, 0));
+  MS_LOG(DEBUG) << "End";
+}
+
+void FinalVM::DoTuple(const std::vector<int> &slots) {
   VectorRef tuple;
-  auto iter = args.begin();
-  for (; iter != args.end(); ++iter) {
-    auto a = utils::cast<int>(*iter);
+  tuple.elements().reserve(slots.size());
+  for (int a : slots) {
     tuple.push_back(Ref(a));
   }
   Push(tuple);
-  MS_LOG(DEBUG) << "End";
 }
 
 void FinalVM::InstPush(const VectorRef &args) {
@@ -402,7 +560,11 @@ void FinalVM::InstPadStack(const VectorRef &args) {
     return;
   }
 
-  int sz = utils::cast<int>(args[0]);
+  DoPadStack(utils::cast<int>(args[0]));
+  MS_LOG(DEBUG) << "End";
+}
+
+void FinalVM::DoPadStack(int sz) {
   MS_LOG(DEBUG) << insts_stack_.size() << " need padstack " << sz << " sp_ " << sp_;
   size_t stack_size = insts_stack_.size();
   int need = sz - (static_cast<int>(stack_size) - sp_);
@@ -410,7 +572,6 @@ void FinalVM::InstPadStack(const VectorRef &args) {
     MS_LOG(DEBUG) << "InstPadStack resize: size:" << insts_stack_.size() << " need pad:" << need;
     insts_stack_.resize(stack_size + IntToSize(need));
   }
-  MS_LOG(DEBUG) << "End";
 }
 
 void FinalVM::InstExternal(const VectorRef &args) {
@@ -420,25 +581,28 @@ void FinalVM::InstExternal(const VectorRef &args) {
     MS_LOG(EXCEPTION) << "Args is empty!";
   }
 
-  VectorRef tuple;
   RunFunctionRef run_ref = utils::cast<RunFunctionRef>(args[0]);
-  compile::RunFuncPtr fn = run_ref.func_;
-  for (size_t i = 2; i < args.size(); ++i) {
-    auto index = utils::cast<int>(args[i]);
-    tuple.push_back(Ref(index));
-  }
+  DoExternal(run_ref.func_, ArgsToSlots(args, 2));
+  MS_LOG(DEBUG) << "End";
+}
 
+void FinalVM::DoExternal(const RunFuncPtr &fn, const std::vector<int> &slots) {
   if (!fn) {
     MS_LOG(EXCEPTION) << "Function not callable";
   }
 
+  VectorRef tuple;
+  tuple.elements().reserve(slots.size());
+  for (int index : slots) {
+    tuple.push_back(Ref(index));
+  }
+
   auto outs = (*fn)(tuple);
   MS_LOG(DEBUG) << "'fn' out size:" << outs.size();
   for (auto &o : outs) {
     MS_LOG(DEBUG) << "InstExternal value:" << o.ToString();
     Push(o);
   }
-  MS_LOG(DEBUG) << "End";
 }
 
 void FinalVM::InstPushPrim(const VectorRef &args) {
@@ -450,10 +614,15 @@ void FinalVM::InstPushPrim(const VectorRef &args) {
     return;
   }
 
-  auto prim = utils::cast<PrimitivePtr>(args[0]);
+  DoPrim(utils::cast<PrimitivePtr>(args[0]), ArgsToSlots(args, 1));
+  MS_LOG(DEBUG) << "End";
+}
+
+void FinalVM::DoPrim(const PrimitivePtr &prim, const std::vector<int> &slots) {
+  MS_EXCEPTION_IF_NULL(prim);
   VectorRef tuple;
-  for (size_t i = 1; i < args.size(); ++i) {
-    auto index = utils::cast<int>(args[i]);
+  tuple.elements().reserve(slots.size());
+  for (int index : slots) {
     tuple.push_back(Ref(index));
   }
 
@@ -464,8 +633,6 @@ void FinalVM::InstPushPrim(const VectorRef &args) {
     auto outs = RunOperation(prim, tuple);
     Push(outs);
   }
-
-  MS_LOG(DEBUG) << "End";
 }
 
 void FinalVM::SyncData(const py::object &arg) {
@@ -26,7 +26,6 @@
 #include <tuple>
 #include <utility>
 #include <vector>
-#include <deque>
 #include <unordered_map>
 
 #include "ir/anf.h"
@@ -57,6 +56,20 @@ enum Instruction {
 
 using InstType = std::pair<Instruction, VectorRef>;
 using InstSet = std::vector<InstType>;
+
+// Pre-decoded form of an InstType. The stack slot operands are resolved to plain ints and the constant operand
+// (pushed value, external function or primitive) is unpacked once when the VM is built, so that the interpreter
+// loop does not need to cast BaseRef arguments on every step. An instruction whose arguments can not be decoded
+// keeps decoded = false and is executed through the generic VectorRef handlers instead.
+struct DecodedInst {
+  Instruction op{kPush};
+  bool decoded{false};
+  std::vector<int> slots;
+  BaseRef value;
+  RunFuncPtr func;
+  PrimitivePtr prim;
+};
+using DecodedInstSet = std::vector<DecodedInst>;
 using InstFunctionMap = std::map<Instruction, std::function<void(const VectorRef &)>>;
 
 const std::vector<std::string> inst_str{"call",          "tail_call", "return",    "partial",     "switch",
@@ -114,7 +127,7 @@ class FinalVM {
   void InstPushPrim(const VectorRef &args);
   void InstSwitchReturn(const VectorRef &args);
   void InstSwitchLayer(const VectorRef &args);
-  void set_insts(const InstSet &value) { insts_ = value; }
+  void set_insts(const InstSet &value);
   BaseRef RunHook(const PrimitivePtr &prim, const VectorRef &arg);
 
  protected:
@@ -129,9 +142,23 @@ class FinalVM {
   void DoJmp(const BaseRef &jmp);
   void SyncData(const py::object &args);
 
+  void Decode();
+  void Dispatch(const DecodedInst &inst);
+  void DoCall(int jmp);
+  void DoTailCall(int jmp, int height, int nargs);
+  void DoReturn(int rpos, int height);
+  void DoPartial(const std::vector<int> &slots);
+  void DoSwitch(int cond, int vtrue, int vfalse);
+  void DoSwitchLayer(int idx, int branches_pos);
+  void DoTuple(const std::vector<int> &slots);
+  void DoPadStack(int sz);
+  void DoExternal(const RunFuncPtr &fn, const std::vector<int> &slots);
+  void DoPrim(const PrimitivePtr &prim, const std::vector<int> &slots);
+
  private:
   InstSet insts_;
-  std::deque<BaseRef> insts_stack_;
+  DecodedInstSet decoded_insts_;
+  std::vector<BaseRef> insts_stack_;
   std::stack<int> retp_;
   std::stack<int> retsp_;
   int pc_;
@@ -51,6 +51,8 @@ class TensorData {
   virtual ssize_t ndim() const = 0;
   /// Data pointer.
   virtual void *data() = 0;
+  /// Data pointer without lazy allocation, null if the data is not allocated yet.
+  virtual const void *const_data() const = 0;
   /// Is data equals.
   virtual bool equals(const TensorData &other) const = 0;
   /// To string.
@@ -20,7 +20,9 @@ import numpy
 import mindspore._c_dataengine as cde
 
 __all__ = ['set_seed', 'get_seed', 'set_prefetch_size', 'get_prefetch_size', 'set_num_parallel_workers',
-           'get_num_parallel_workers', 'set_monitor_sampling_interval', 'get_monitor_sampling_interval', 'load']
+           'get_num_parallel_workers', 'set_monitor_sampling_interval', 'get_monitor_sampling_interval',
+           'set_tensor_pool_size', 'get_tensor_pool_size', 'set_text_chunk_size', 'get_text_chunk_size',
+           'set_text_index_dir', 'get_text_index_dir', 'load']
 
 INT32_MAX = 2147483647
 UINT32_MAX = 4294967295
@@ -157,6 +159,105 @@ def get_monitor_sampling_interval():
     return _config.get_monitor_sampling_interval()
 
 
+def set_tensor_pool_size(size):
+    """
+    Set the size(MB) of the tensor pool of each pipeline.
+
+    With a pool, the pipeline keeps the buffers of its tensors in a cache of that size and reuses them, instead of
+    taking every buffer from the system allocator. Buffers beyond the size still come from the system allocator.
+    The size applies to the pipelines launched afterwards.
+
+    Args:
+        size (int): size(MB) of the tensor pool, 0 to take the buffers from the system allocator.
+
+    Raises:
+        ValueError: If size is invalid (< 0 or > MAX_INT_32).
+
+    Examples:
+        >>> import mindspore.dataset as ds
+        >>> # every pipeline caches up to 2GB of tensor buffers.
+        >>> ds.config.set_tensor_pool_size(2048)
+    """
+    if size < 0 or size > INT32_MAX:
+        raise ValueError("Tensor pool size given is not within the required range.")
+    _config.set_tensor_pool_size(size)
+
+
+def get_tensor_pool_size():
+    """
+    Get the size of the tensor pool of each pipeline.
+
+    Returns:
+        Int, size(MB) of the tensor pool, 0 if the buffers come from the system allocator.
+    """
+    return _config.get_tensor_pool_size()
+
+
+def set_text_chunk_size(size):
+    """
+    Set the size(MB) of the chunks which TextFileDataset, CLUEDataset and CSVDataset split their files into.
+
+    The chunks of a file are read by different workers, so a large file is read by all the workers of the dataset
+    instead of a single one. The rows and their order within each shard stay the same.
+
+    Args:
+        size (int): size(MB) of a chunk, 0 to read every file by a single worker.
+
+    Raises:
+        ValueError: If size is invalid (< 0 or > MAX_INT_32).
+
+    Examples:
+        >>> import mindspore.dataset as ds
+        >>> # every worker reads about 256MB of a file at a time.
+        >>> ds.config.set_text_chunk_size(256)
+    """
+    if size < 0 or size > INT32_MAX:
+        raise ValueError("Text chunk size given is not within the required range.")
+    _config.set_text_chunk_size(size)
+
+
+def get_text_chunk_size():
+    """
+    Get the size of the chunks which text files are split into.
+
+    Returns:
+        Int, size(MB) of a chunk, 0 if every file is read by a single worker.
+    """
+    return _config.get_text_chunk_size()
+
+
+def set_text_index_dir(index_dir):
+    """
+    Set the directory to cache the row indexes of the files of TextFileDataset, CLUEDataset and CSVDataset in.
+
+    Without the cache the files are scanned for their rows every time a pipeline starts. An index is used again
+    while the size and the modification time of its file stay the same.
+
+    Args:
+        index_dir (str): path of the directory, empty to scan the files every time.
+
+    Raises:
+        TypeError: If index_dir is not a str.
+
+    Examples:
+        >>> import mindspore.dataset as ds
+        >>> ds.config.set_text_index_dir("/path/to/index_dir")
+    """
+    if not isinstance(index_dir, str):
+        raise TypeError("Text index dir given is not a str.")
+    _config.set_text_index_dir(index_dir)
+
+
+def get_text_index_dir():
+    """
+    Get the directory of the row indexes of text files.
+
+    Returns:
+        Str, path of the directory, empty if the files are scanned every time.
+    """
+    return _config.get_text_index_dir()
+
+
 def __str__():
     """
     String representation of the configurations.
@@ -311,7 +311,7 @@ class Dataset:
         return SyncWaitDataset(self, condition_name, num_batch, callback)
 
     @check_shuffle
-    def shuffle(self, buffer_size):
+    def shuffle(self, buffer_size, num_parallel_workers=None, buffer_bytes=None, spill_dir=None):
         """
         Randomly shuffles the rows of this dataset using the following algorithm:
 
@@ -328,6 +328,15 @@ class Dataset:
             buffer_size (int): The size of the buffer (must be larger than 1) for
                 shuffling. Setting buffer_size equal to the number of rows in the entire
                 dataset will result in a global shuffle.
+            num_parallel_workers (int, optional): Number of sub-buffers which are filled and
+                drained in parallel (default=None, one buffer). The rows are dealt to the
+                sub-buffers in turn and each of them holds buffer_size/num_parallel_workers
+                rows, the output is the same for the same seed.
+            buffer_bytes (int, optional): Memory budget of the shuffle buffer in bytes
+                (default=None, no budget). Rows over the budget are sent out early, or
+                spilled to spill_dir if it is given.
+            spill_dir (str, optional): Directory for the rows over buffer_bytes (default=None,
+                no spill).
 
         Returns:
             ShuffleDataset, dataset shuffled.
@@ -344,7 +353,7 @@ class Dataset:
             >>> # creates a shuffled dataset using a shuffle buffer of size 4
             >>> data = data.shuffle(4)
         """
-        return ShuffleDataset(self, buffer_size)
+        return ShuffleDataset(self, buffer_size, num_parallel_workers, buffer_bytes, spill_dir)
 
     def flat_map(self, func):
         """
@@ -1854,14 +1863,19 @@ class ShuffleDataset(DatasetOp):
     Args:
         input_dataset (Dataset): Input Dataset to be shuffled.
         buffer_size (int): The size of the buffer.
+        num_parallel_workers (int, optional): Number of sub-buffers (default=None).
+        buffer_bytes (int, optional): Memory budget of the buffer in bytes (default=None).
+        spill_dir (str, optional): Directory for the rows over the budget (default=None).
 
     Raises:
         RuntimeError: If exist sync operators before shuffle.
     """
 
-    def __init__(self, input_dataset, buffer_size):
-        super().__init__()
+    def __init__(self, input_dataset, buffer_size, num_parallel_workers=None, buffer_bytes=None, spill_dir=None):
+        super().__init__(num_parallel_workers)
         self.buffer_size = buffer_size
+        self.buffer_bytes = buffer_bytes
+        self.spill_dir = spill_dir
         self.children.append(input_dataset)
         self.reshuffle_each_epoch = None
         input_dataset.parent.append(self)
@@ -1872,6 +1886,8 @@ class ShuffleDataset(DatasetOp):
     def get_args(self):
         args = super().get_args()
         args["buffer_size"] = self.buffer_size
+        args["buffer_bytes"] = self.buffer_bytes
+        args["spill_dir"] = self.spill_dir
         if self.reshuffle_each_epoch is not None:
             args["reshuffle_each_epoch"] = self.reshuffle_each_epoch
 
@@ -3166,6 +3182,10 @@ class GeneratorDataset(MappableDataset):
             When this argument is specified, 'num_samples' will not effect. Random accessible input is required.
         shard_id (int, optional): The shard ID within num_shards (default=None). This argument should be specified only
             when num_shards is also specified. Random accessible input is required.
+        columnar (bool, optional): Whether the source yields blocks of rows instead of single rows (default=False).
+            Each array of a block holds one column of many rows, with the rows in the first dimension. The rows are
+            copied out of the blocks without the Python GIL, which is much faster than yielding them one by one.
+            Sampler, shuffle, num_samples and num_shards are not supported with columnar source.
 
     Examples:
         >>> import mindspore.dataset as ds
@@ -3197,15 +3217,25 @@ class GeneratorDataset(MappableDataset):
         >>> list_generator = ds.GeneratorDataset([(np.array(0),), (np.array(1)), (np.array(2))], ["col1"])
         >>> # 5) Built-in Sampler
         >>> my_generator = ds.GeneratorDataset(my_ds, ["img", "label"], sampler=samplers.RandomSampler())
+        >>> # 6) Columnar generator function, which yields blocks of 256 rows
+        >>> def generator_columnar():
+        >>>     for i in range(0, 65536, 256):
+        >>>         yield (np.arange(i, i + 256), np.ones((256, 2, 2), np.float32))
+        >>> columnar_dataset = ds.GeneratorDataset(generator_columnar, ["col1", "col2"], columnar=True)
         >>>
     """
 
     @check_generatordataset
     def __init__(self, source, column_names=None, column_types=None, schema=None, num_samples=None,
-                 num_parallel_workers=1, shuffle=None, sampler=None, num_shards=None, shard_id=None):
+                 num_parallel_workers=1, shuffle=None, sampler=None, num_shards=None, shard_id=None, columnar=False):
         super().__init__(num_parallel_workers)
         self.source = source
-        self.sampler = _select_sampler(num_samples, sampler, shuffle, num_shards, shard_id)
+        self.columnar = columnar
+        if columnar:
+            # Blocks are read in the order of the source, the samplers work on rows.
+            self.sampler = None
+        else:
+            self.sampler = _select_sampler(num_samples, sampler, shuffle, num_shards, shard_id)
         self.num_samples = num_samples
 
         if column_names is not None and not isinstance(column_names, list):
@@ -3227,7 +3257,7 @@ class GeneratorDataset(MappableDataset):
                 self.column_names.append(col["name"])
                 self.column_types.append(DataType(col["type"]))
 
-        if source is not None and hasattr(source, "__len__"):
+        if source is not None and hasattr(source, "__len__") and not columnar:
             self._dataset_size = len(source)
 
     def get_args(self):
@@ -3235,6 +3265,7 @@ class GeneratorDataset(MappableDataset):
         args["source"] = self.source
         args["column_names"] = self.column_names
         args["column_types"] = self.column_types
+        args["columnar"] = self.columnar
         return args
 
     def get_dataset_size(self):
@@ -3273,6 +3304,7 @@ class GeneratorDataset(MappableDataset):
         new_op.column_types = copy.deepcopy(self.column_types, memodict)
         new_op.column_names = copy.deepcopy(self.column_names, memodict)
         new_op.num_samples = copy.deepcopy(self.num_samples, memodict)
+        new_op.columnar = self.columnar
 
         new_op.sampler = copy.deepcopy(self.sampler)
         if new_op.sampler is not None and hasattr(self.source, "__getitem__"):
@@ -3305,9 +3337,13 @@ class GeneratorDataset(MappableDataset):
         return new_op
 
     def is_shuffled(self):
+        if self.sampler is None:
+            return False
         return self.sampler.is_shuffled()
 
     def is_sharded(self):
+        if self.sampler is None:
+            return False
         return self.sampler.is_sharded()
 
 
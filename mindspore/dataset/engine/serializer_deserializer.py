@@ -340,7 +340,8 @@ def create_node(node):
                                  node.get('columns_order'), node.get('num_parallel_workers'))
 
     elif dataset_op == 'ShuffleDataset':
-        pyobj = de.Dataset().shuffle(node.get('buffer_size'))
+        pyobj = de.Dataset().shuffle(node.get('buffer_size'), node.get('num_parallel_workers'),
+                                     node.get('buffer_bytes'), node.get('spill_dir'))
 
     elif dataset_op == 'BatchDataset':
         pyobj = de.Dataset().batch(node['batch_size'], node.get('drop_remainder'))
@@ -25,7 +25,7 @@ from mindspore._c_expression import typing
 from ..core.validator_helpers import parse_user_args, type_check, type_check_list, check_value, \
     INT32_MAX, check_valid_detype, check_dir, check_file, check_sampler_shuffle_shard_options, \
     validate_dataset_param_value, check_padding_options, check_gnn_list_or_ndarray, check_num_parallel_workers, \
-    check_columns, check_pos_int32
+    check_columns, check_pos_int32, check_pos_int64
 
 from . import datasets
 from . import samplers
@@ -327,7 +327,7 @@ def check_generatordataset(method):
         validate_dataset_param_value(nreq_param_int, param_dict, int)
         nreq_param_list = ["column_types"]
         validate_dataset_param_value(nreq_param_list, param_dict, list)
-        nreq_param_bool = ["shuffle"]
+        nreq_param_bool = ["shuffle", "columnar"]
         validate_dataset_param_value(nreq_param_bool, param_dict, bool)
 
         num_shards = param_dict.get("num_shards")
@@ -335,6 +335,10 @@ def check_generatordataset(method):
         if (num_shards is None) != (shard_id is None):
             # These two parameters appear together.
             raise ValueError("num_shards and shard_id need to be passed in together")
+        if param_dict.get("columnar"):
+            if any(param_dict.get(arg) is not None for arg in ["sampler", "num_samples", "num_shards"]) or \
+                    param_dict.get("shuffle"):
+                raise ValueError("sampler, shuffle, num_samples and num_shards are not supported with columnar source.")
         if num_shards is not None:
             check_pos_int32(num_shards, "num_shards")
             if shard_id >= num_shards:
@@ -528,12 +532,25 @@ def check_shuffle(method):
 
     @wraps(method)
     def new_method(self, *args, **kwargs):
-        [buffer_size], _ = parse_user_args(method, *args, **kwargs)
+        [buffer_size, num_parallel_workers, buffer_bytes, spill_dir], _ = parse_user_args(method, *args, **kwargs)
 
         type_check(buffer_size, (int,), "buffer_size")
 
         check_value(buffer_size, [2, INT32_MAX], "buffer_size")
 
+        if num_parallel_workers is not None:
+            check_num_parallel_workers(num_parallel_workers)
+            if num_parallel_workers > buffer_size:
+                raise ValueError("num_parallel_workers should not be larger than buffer_size.")
+
+        if buffer_bytes is not None:
+            check_pos_int64(buffer_bytes, "buffer_bytes")
+
+        if spill_dir is not None:
+            type_check(spill_dir, (str,), "spill_dir")
+            if not buffer_bytes:
+                raise ValueError("spill_dir requires a positive buffer_bytes.")
+
         return method(self, *args, **kwargs)
 
     return new_method
@@ -70,6 +70,7 @@ class FileWriter:
         self._append = False
         self._header = ShardHeader()
         self._writer = ShardWriter()
+        self._writer.set_generate_index(True)
         self._generator = None
 
     @classmethod
@@ -273,6 +274,26 @@ class FileWriter:
         """
         return self._writer.set_page_size(page_size)
 
+    def set_blob_compression(self, blob_compression):
+        """
+        Set the codec to compress the blob data of each row, which is recorded in the header \
+        and decompressed by readers. Blob data which does not shrink is kept as it is, \
+        e.g. encoded images. It should be called before writing raw data.
+
+        Args:
+           blob_compression (str): Codec of blob data, only 'lz4' is supported, empty to not compress.
+
+        Returns:
+            MSRStatus, SUCCESS or FAILED.
+
+        Raises:
+            ParamValueError: If blob_compression is not supported.
+            MRMSetHeaderError: If failed to set the codec.
+        """
+        if blob_compression not in ('', 'lz4'):
+            raise ParamValueError("Blob compression {} is not supported.".format(blob_compression))
+        return self._writer.set_blob_compression(blob_compression)
+
     def commit(self):
         """
         Flush data to disk and generate the correspond db files.
@@ -293,7 +314,8 @@ class FileWriter:
         if not self._writer.get_shard_header():
             self._writer.set_shard_header(self._header)
         ret = self._writer.commit()
-        if self._index_generator is True:
+        # the index files are generated while writing unless the files are appended or written in parallel
+        if self._index_generator is True and not self._writer.is_index_generated:
             if self._append:
                 self._generator = ShardIndexGenerator(self._file_name, self._append)
             elif len(self._paths) >= 1:
@@ -35,6 +35,16 @@ class ShardWriter:
         self._header = None
         self._is_open = False
 
+    def set_generate_index(self, generate_index):
+        """
+        Generate the index files while writing raw data, instead of after commit.
+
+        Args:
+           generate_index (bool): Generate the index files while writing if it equals to True, \
+               which does not apply to appending or writing in parallel.
+        """
+        self._writer.set_generate_index(generate_index)
+
     def open(self, paths):
         """
         Open a new MindRecord File and prepare to write raw data.
@@ -113,6 +123,25 @@ class ShardWriter:
             raise MRMInvalidPageSizeError
         return ret
 
+    def set_blob_compression(self, blob_compression):
+        """
+        Set the codec to compress the blob data of each row.
+
+        Args:
+           blob_compression (str): Codec of blob data, only 'lz4' is supported, empty to not compress.
+
+        Returns:
+            MSRStatus, SUCCESS or FAILED.
+
+        Raises:
+            MRMSetHeaderError: If failed to set the codec.
+        """
+        ret = self._writer.set_blob_compression(blob_compression)
+        if ret != ms.MSRStatus.SUCCESS:
+            logger.error("Failed to set blob compression.")
+            raise MRMSetHeaderError
+        return ret
+
     def set_shard_header(self, shard_header):
         """
         Set header which contains schema and index before write raw data.
@@ -224,3 +253,8 @@ class ShardWriter:
     def is_open(self):
         """getter function"""
         return self._is_open
+
+    @property
+    def is_index_generated(self):
+        """getter function, the index files are generated while writing if it equals to True"""
+        return self._writer.is_index_generated()
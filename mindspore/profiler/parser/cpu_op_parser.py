@@ -0,0 +1,115 @@
+# Copyright 2020 Huawei Technologies Co., Ltd
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# ============================================================================
+"""CPU op summary file parser."""
+import csv
+import os
+
+from mindspore.profiler.common.exceptions.exceptions import ProfilerFileNotFoundException, \
+    ProfilerIOException
+from mindspore.profiler.common.util import fwrite_format
+from mindspore.profiler.common.validator.validate_path import validate_and_normalize_path
+from mindspore import log as logger
+
+
+class CpuOpSummaryParser:
+    """
+    Parse the op summary exported by the CPU kernel runtime and aggregate it by op type.
+
+    Args:
+         output_path (str): The directory of the exported profiling data.
+         device_id (str): The device id.
+    """
+    _summary_filename = 'cpu_op_summary_{}.csv'
+    _detail_filename = 'output_op_compute_time_detail_{}.txt'
+    _timeline_filename = 'cpu_op_timeline_{}.json'
+
+    def __init__(self, output_path, device_id):
+        self._output_path = validate_and_normalize_path(output_path)
+        self._device_id = device_id
+        self._op_details = []
+
+    @property
+    def timeline_path(self):
+        """The path of the chrome trace timeline file."""
+        return os.path.join(self._output_path, self._timeline_filename.format(self._device_id))
+
+    def parse(self):
+        """
+        Read the op summary file.
+
+        Returns:
+            list[dict], one item per op instance.
+        """
+        summary_path = os.path.join(self._output_path, self._summary_filename.format(self._device_id))
+        if not os.path.isfile(summary_path):
+            raise ProfilerFileNotFoundException(summary_path)
+        self._op_details = []
+        try:
+            with open(summary_path, 'r') as summary_file:
+                for row in csv.DictReader(summary_file):
+                    self._op_details.append({
+                        'op_name': row['op_name'],
+                        'op_type': row['op_type'],
+                        'count': int(row['count']),
+                        'total_us': float(row['total_us']),
+                        'avg_us': float(row['avg_us']),
+                        'min_us': float(row['min_us']),
+                        'max_us': float(row['max_us']),
+                        'bytes_read': int(row['bytes_read']),
+                        'bytes_written': int(row['bytes_written'])
+                    })
+        except (IOError, OSError, KeyError, ValueError) as err:
+            logger.error('Error occurred when read CPU op summary file: %s', err)
+            raise ProfilerIOException
+        return self._op_details
+
+    def get_op_type_info(self):
+        """
+        Aggregate the op instances by op type, sorted by total time in descending order.
+
+        Returns:
+            list[list], each item is [op_type, total_time(ms), called_times, percent].
+        """
+        op_types = {}
+        total_us = 0.0
+        for detail in self._op_details:
+            op_type = op_types.setdefault(detail['op_type'], [0.0, 0])
+            op_type[0] += detail['total_us']
+            op_type[1] += detail['count']
+            total_us += detail['total_us']
+        result = []
+        for op_type, (op_total_us, count) in op_types.items():
+            percent = op_total_us / total_us * 100 if total_us else 0
+            result.append([op_type, round(op_total_us / 1000, 6), count, round(percent, 2)])
+        result.sort(key=lambda item: item[1], reverse=True)
+        return result
+
+    def write_op_detail(self, is_detail=True):
+        """Write the op type summary, and the hottest op instances if is_detail, to the detail file."""
+        detail_file_path = os.path.join(self._output_path, self._detail_filename.format(self._device_id))
+        fwrite_format(detail_file_path, data_source='title:op compute time', is_start=True)
+        display_names = ['optype_name', 'compute_time(ms)', 'called_times', 'percent']
+        fwrite_format(detail_file_path, data_source=" ".join(display_names), is_print=True)
+        fwrite_format(detail_file_path, data_source=self.get_op_type_info(), is_print=True)
+        if is_detail:
+            ops = sorted(self._op_details, key=lambda item: item['total_us'], reverse=True)
+            col_names = ['op_name', 'op_type', 'avg_execution_time(us)', 'called_times',
+                         'bytes_read', 'bytes_written']
+            fwrite_format(detail_file_path, data_source='', is_print=True)
+            fwrite_format(detail_file_path, data_source='Detail:', is_print=True)
+            fwrite_format(detail_file_path, data_source=" ".join(col_names), is_print=True)
+            fwrite_format(detail_file_path, data_source=[
+                [op['op_name'], op['op_type'], round(op['avg_us'], 3), op['count'],
+                 op['bytes_read'], op['bytes_written']] for op in ops], is_print=True)
@@ -17,6 +17,7 @@ import os
 import time
 
 from mindspore import log as logger, context
+from mindspore import _c_expression as c_expression
 from mindspore.communication.management import release
 from mindspore.profiler.common.exceptions.exceptions import ProfilerFileNotFoundException, \
     ProfilerIOException, ProfilerException
@@ -26,6 +27,7 @@ from mindspore.profiler.common.validator.checkparam import \
 from mindspore.profiler.common.validator.validate_path import \
     validate_and_normalize_path
 from mindspore.profiler.parser.aicpu_data_parser import DataPreProcessParser
+from mindspore.profiler.parser.cpu_op_parser import CpuOpSummaryParser
 from mindspore.profiler.parser.framework_parser import FrameworkParser
 from mindspore.profiler.parser.hwts_log_parser import HWTSLogParser
 from mindspore.profiler.parser.integrator import Integrator
@@ -77,6 +79,10 @@ class Profiler:
                  optypes_to_deal='', optypes_not_deal='Variable', job_id=""):
         # get device_id and device_target
         self._get_devid_and_devtarget()
+        self._detail = check_bool(is_detail, 'is_detail')
+        if self._device_target == "CPU":
+            self._init_cpu_profiling(output_path)
+            return
         self._container_path = os.path.join(self._base_profiling_container_path, self._dev_id)
         data_path = os.path.join(self._container_path, "data")
         if not os.path.exists(data_path):
@@ -99,7 +105,6 @@ class Profiler:
         self._subgraph = check_subgraph(subgraph)
         self._valid_optype_name = optypes_to_deal.split(",") if optypes_to_deal else []
         self._filt_optype_names = optypes_not_deal.split(",") if optypes_not_deal else []
-        self._detail = check_bool(is_detail, 'is_detail')
         self._withfullpath = check_bool(is_show_op_path, 'is_show_op_path')
         self._profiling_job_id = job_id
         # add job id env through user input later
@@ -121,6 +126,10 @@ class Profiler:
             >>> model.train()
             >>> profiler.analyse()
         """
+        if self._device_target == "CPU":
+            self._analyse_cpu()
+            return
+
         release()
 
         job_id = self._get_profiling_job_id()
@@ -187,6 +196,28 @@ class Profiler:
         except (ProfilerIOException, ProfilerFileNotFoundException, RuntimeError) as err:
             logger.warning('Fail to write timeline data: %s', err)
 
+    def _init_cpu_profiling(self, output_path):
+        """Enable the kernel instrumentation of the CPU backend."""
+        self._output_path = validate_and_normalize_path(output_path)
+        self._output_path = os.path.join(self._output_path, "profiler")
+        if not os.path.exists(self._output_path):
+            os.makedirs(self._output_path, exist_ok=True)
+        c_expression.clear_cpu_profiling_data()
+        context.set_context(enable_profiling=True)
+
+    def _analyse_cpu(self):
+        """Export the CPU kernel timeline and op summary, then write the op compute time detail file."""
+        if not c_expression.export_cpu_profiling_data(self._output_path, int(self._dev_id)):
+            logger.error("Profiling: fail to export CPU profiling data.")
+            return
+        cpu_op_parser = CpuOpSummaryParser(self._output_path, self._dev_id)
+        try:
+            cpu_op_parser.parse()
+            cpu_op_parser.write_op_detail(self._detail)
+        except ProfilerException as err:
+            logger.warning(err.message)
+        logger.info("Profiling: CPU timeline is saved to %s", cpu_op_parser.timeline_path)
+
     def _analyse_step_trace(self, source_path, framework_parser):
         """
         Analyse step trace data and save the result.
@@ -414,12 +445,12 @@ class Profiler:
             dev_id = "0"
             logger.error("Fail to get DEVICE_ID, use 0 instead.")
 
-        if device_target and device_target != "Davinci" \
-            and device_target != "Ascend":
+        if device_target and device_target not in ("Davinci", "Ascend", "CPU"):
             msg = "Profiling: unsupport backend: %s" % device_target
             raise RuntimeError(msg)
 
         self._dev_id = dev_id
+        self._device_target = device_target
 
     @staticmethod
     def trainable_parameters(network):
@@ -52,14 +52,22 @@ class BaseWriter:
         # 4: crc32 of data
         metadata_length = 8 + 4 + 4
         required_length = len(data) + metadata_length
-        if self._max_file_size is None:
-            self.writer.Write(data)
-        elif self._max_file_size >= required_length:
-            self._max_file_size -= required_length
-            self.writer.Write(data)
-        else:
+        if self._max_file_size is not None and self._max_file_size < required_length:
             raise RuntimeError(f"'max_file_size' reached: There are {self._max_file_size} bytes remaining, "
                                f"but the '{self._filepath}' requires to write {required_length} bytes.")
+        if plugin == 'droppable_summary':
+            # Only the bytes actually written are charged, a dropped event does not count.
+            written = self.writer.WriteDroppable(data)
+        else:
+            self.writer.Write(data)
+            written = True
+        if written and self._max_file_size is not None:
+            self._max_file_size -= required_length
+
+    def end_step(self):
+        """Mark the end of a step, the events of `flush_steps` steps are written together."""
+        if self._writer is not None:
+            self._writer.StepEnd()
 
     def flush(self):
         """Flush the writer."""
@@ -75,13 +83,20 @@ class BaseWriter:
 class SummaryWriter(BaseWriter):
     """SummaryWriter for write summaries."""
 
+    def __init__(self, filepath, max_file_size=None, write_policy=None) -> None:
+        super().__init__(filepath, max_file_size)
+        self._write_policy = write_policy
+
     def init_writer(self):
         """Write some metadata etc."""
+        if self._write_policy:
+            self._writer.SetFlushPolicy(self._write_policy['flush_steps'], self._write_policy['flush_interval_ms'])
+            self._writer.SetDropBudget(self._write_policy['drop_budget'])
         self.writer.Write(package_init_event().SerializeToString())
 
     def write(self, plugin, data):
         """Write data to file."""
-        if plugin in ('summary', 'graph'):
+        if plugin in ('summary', 'droppable_summary', 'graph'):
             super().write(plugin, data)
 
 
@@ -27,7 +27,7 @@ from ._summary_writer import LineageWriter, SummaryWriter
 
 def _pack_data(datadict, wall_time):
     """Pack data according to which plugin."""
-    result, summaries, step = [], [], None
+    result, summaries, droppable_summaries, step = [], [], [], None
     for plugin, datalist in datadict.items():
         for data in datalist:
             if plugin == 'graph':
@@ -35,10 +35,16 @@ def _pack_data(datadict, wall_time):
             elif plugin in ('train_lineage', 'eval_lineage', 'custom_lineage_data', 'dataset_graph'):
                 result.append([plugin, serialize_to_lineage_event(plugin, data.get('value'))])
             elif plugin in ('scalar', 'tensor', 'histogram', 'image'):
-                summaries.append({'_type': plugin.title(), 'name': data.get('tag'), 'data': data.get('value')})
+                # Histograms and images are large and may be dropped by the writer when it falls behind,
+                # so they are packed into an event of their own.
+                target = droppable_summaries if plugin in ('histogram', 'image') else summaries
+                target.append({'_type': plugin.title(), 'name': data.get('tag'), 'data': data.get('value')})
                 step = data.get('step')
     if summaries:
         result.append(['summary', package_summary_event(summaries, step, wall_time).SerializeToString()])
+    if droppable_summaries:
+        result.append(['droppable_summary',
+                       package_summary_event(droppable_summaries, step, wall_time).SerializeToString()])
     return result
 
 
@@ -48,14 +54,16 @@ class WriterPool(Process):
 
     Args:
         base_dir (str): The base directory to hold all the files.
+        max_file_size (Optional[int]): The maximum size in bytes each file can be written to the disk.
+        write_policy (Optional[dict]): The `flush_steps`, `flush_interval_ms` and `drop_budget` of the summary writer.
         filelist (str): The mapping from short name to long filename.
     """
 
-    def __init__(self, base_dir, max_file_size, **filedict) -> None:
+    def __init__(self, base_dir, max_file_size, write_policy=None, **filedict) -> None:
         super().__init__()
         self._base_dir, self._filedict = base_dir, filedict
         self._queue, self._writers_ = Queue(cpu_count() * 2), None
-        self._max_file_size = max_file_size
+        self._max_file_size, self._write_policy = max_file_size, write_policy
         self.start()
 
     def run(self):
@@ -65,6 +73,7 @@ class WriterPool(Process):
                 while deq and deq[0].ready():
                     for plugin, data in deq.popleft().get():
                         self._write(plugin, data)
+                    self._end_step()
 
                 if not self._queue.empty():
                     action, data = self._queue.get()
@@ -89,7 +98,7 @@ class WriterPool(Process):
         for plugin, filename in self._filedict.items():
             filepath = os.path.join(self._base_dir, filename)
             if plugin == 'summary':
-                self._writers_.append(SummaryWriter(filepath, self._max_file_size))
+                self._writers_.append(SummaryWriter(filepath, self._max_file_size, self._write_policy))
             elif plugin == 'lineage':
                 self._writers_.append(LineageWriter(filepath, self._max_file_size))
         return self._writers_
@@ -104,6 +113,11 @@ class WriterPool(Process):
                 self._writers.remove(writer)
                 writer.close()
 
+    def _end_step(self):
+        """Mark the end of a step for the writers in the subprocess."""
+        for writer in self._writers:
+            writer.end_step()
+
     def _flush(self):
         """Flush the writers in the subprocess."""
         for writer in self._writers:
@@ -31,6 +31,10 @@ from ._writer_pool import WriterPool
 _summary_lock = threading.Lock()
 # cache the summary data
 _summary_tensor_cache = {}
+# the default write policy of the summary writer
+_DEFAULT_FLUSH_STEPS = 16
+_DEFAULT_FLUSH_INTERVAL_MS = 500
+_DEFAULT_DROP_BUDGET = 64 * 1024**2
 
 
 def _cache_summary_tensor_data(summary):
@@ -82,10 +86,16 @@ class SummaryRecord:
         network (Cell): Obtain a pipeline through network for saving graph summary. Default: None.
         max_file_size (Optional[int]): The maximum size in bytes each file can be written to the disk. \
             Unlimited by default. For example, to write not larger than 4GB, specify `max_file_size=4 * 1024**3`.
+        flush_steps (int): The events are written to the disk in a batch every `flush_steps` steps. Default: 16.
+        flush_interval_ms (int): The longest time in milliseconds the events wait before they are written,
+            even if `flush_steps` steps have not ended. Default: 500.
+        drop_budget (int): The bytes of histogram and image summaries allowed to wait for the writer. When the
+            writer falls behind, the summaries beyond it are dropped instead of stalling the training, and 0 drops
+            all of them. Default: 64 * 1024**2.
 
     Raises:
-        TypeError: If `max_file_size`, `queue_max_size` or `flush_time` is not int, \
-            or `file_prefix` and `file_suffix` is not str.
+        TypeError: If `max_file_size`, `queue_max_size`, `flush_time`, `flush_steps`, `flush_interval_ms` or \
+            `drop_budget` is not int, or `file_prefix` and `file_suffix` is not str.
         RuntimeError: If the log_dir can not be resolved to a canonicalized absolute pathname.
 
     Examples:
@@ -107,7 +117,10 @@ class SummaryRecord:
                  file_prefix="events",
                  file_suffix="_MS",
                  network=None,
-                 max_file_size=None):
+                 max_file_size=None,
+                 flush_steps=_DEFAULT_FLUSH_STEPS,
+                 flush_interval_ms=_DEFAULT_FLUSH_INTERVAL_MS,
+                 drop_budget=_DEFAULT_DROP_BUDGET):
 
         self._closed, self._event_writer = False, None
         self._mode, self._data_pool = 'train', _dictlist()
@@ -129,6 +142,23 @@ class SummaryRecord:
             logger.warning("The 'max_file_size' should be greater than 0.")
             max_file_size = None
 
+        for arg_name, arg in (('flush_steps', flush_steps), ('flush_interval_ms', flush_interval_ms),
+                              ('drop_budget', drop_budget)):
+            if not isinstance(arg, int) or isinstance(arg, bool):
+                raise TypeError(f"The '{arg_name}' should be int type.")
+        if flush_steps <= 0:
+            logger.warning("The flush_steps(%r) set error, will use the default value: %r",
+                           flush_steps, _DEFAULT_FLUSH_STEPS)
+            flush_steps = _DEFAULT_FLUSH_STEPS
+        if flush_interval_ms <= 0:
+            logger.warning("The flush_interval_ms(%r) set error, will use the default value: %r",
+                           flush_interval_ms, _DEFAULT_FLUSH_INTERVAL_MS)
+            flush_interval_ms = _DEFAULT_FLUSH_INTERVAL_MS
+        if drop_budget < 0:
+            logger.warning("The drop_budget(%r) set error, will use the default value: %r",
+                           drop_budget, _DEFAULT_DROP_BUDGET)
+            drop_budget = _DEFAULT_DROP_BUDGET
+
         self.queue_max_size = queue_max_size
         if queue_max_size < 0:
             # 0 is not limit
@@ -154,6 +184,9 @@ class SummaryRecord:
 
         self._event_writer = WriterPool(log_dir,
                                         max_file_size,
+                                        dict(flush_steps=flush_steps,
+                                             flush_interval_ms=flush_interval_ms,
+                                             drop_budget=drop_budget),
                                         summary=self.full_file_name,
                                         lineage=get_event_file_name('events', '_lineage'))
         atexit.register(self.close)
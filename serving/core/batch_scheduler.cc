@@ -0,0 +1,431 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "core/batch_scheduler.h"
+#include <algorithm>
+#include <string>
+#include <utility>
+#include <vector>
+#include "include/infer_log.h"
+#include "core/serving_tensor.h"
+
+namespace mindspore {
+namespace serving {
+namespace {
+constexpr int kMetricsLogIntervalSeconds = 60;
+// a signature that failed to run merged is retried merged after this time, and at most this many are remembered
+constexpr int kUnbatchableExpireSeconds = 300;
+constexpr size_t kMaxUnbatchableSignatures = 1024;
+
+double DurationMs(std::chrono::steady_clock::time_point start, std::chrono::steady_clock::time_point end) {
+  return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+size_t RowBytes(const inference::InferTensorBase &tensor, int64_t rows) {
+  if (rows <= 0 || tensor.data_size() % static_cast<size_t>(rows) != 0) {
+    return 0;
+  }
+  return tensor.data_size() / static_cast<size_t>(rows);
+}
+}  // namespace
+
+BatchScheduler::BatchScheduler(const BatchOptions &options)
+    : options_(options), last_log_time_(std::chrono::steady_clock::now()) {
+  if (options_.max_batch_size == 0) {
+    options_.max_batch_size = 1;
+  }
+}
+
+BatchScheduler::~BatchScheduler() { Stop(); }
+
+void BatchScheduler::AddInstance(const std::shared_ptr<inference::InferSession> &session) {
+  auto instance = std::make_unique<Instance>();
+  instance->session = session;
+  instances_.push_back(std::move(instance));
+}
+
+Status BatchScheduler::LoadModel(const std::string &file_name) {
+  for (auto &instance : instances_) {
+    std::lock_guard<std::mutex> lock(instance->mutex);
+    instance->model_loaded = false;
+    auto ret = instance->session->LoadModelFromFile(file_name, instance->model_id);
+    if (ret != SUCCESS) {
+      MSI_LOG(ERROR) << "Load graph model failed, file name is " << file_name.c_str();
+      return ret;
+    }
+    instance->model_loaded = true;
+  }
+  std::lock_guard<std::mutex> lock(mutex_);
+  // the new model may accept the merged inputs that the old one rejected
+  unbatchable_signatures_.clear();
+  return SUCCESS;
+}
+
+void BatchScheduler::Start() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (started_) {
+    return;
+  }
+  started_ = true;
+  stop_ = false;
+  for (auto &instance : instances_) {
+    instance->worker = std::thread(&BatchScheduler::WorkerLoop, this, instance.get());
+  }
+  MSI_LOG_INFO << "Batch scheduler started, instances " << instances_.size() << ", max batch size "
+               << options_.max_batch_size << ", max queue delay " << options_.max_queue_delay_us << " us";
+}
+
+void BatchScheduler::Stop() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!started_) {
+      return;
+    }
+    stop_ = true;
+  }
+  cond_.notify_all();
+  for (auto &instance : instances_) {
+    if (instance->worker.joinable()) {
+      instance->worker.join();
+    }
+  }
+  std::lock_guard<std::mutex> lock(mutex_);
+  started_ = false;
+  for (auto &task : queue_) {
+    task->promise.set_value(FAILED);
+  }
+  queue_.clear();
+}
+
+void BatchScheduler::Clear() {
+  Stop();
+  for (auto &instance : instances_) {
+    std::lock_guard<std::mutex> lock(instance->mutex);
+    if (instance->session != nullptr) {
+      instance->session->UnloadModel(instance->model_id);
+      instance->session->FinalizeEnv();
+      instance->session = nullptr;
+    }
+    instance->model_loaded = false;
+  }
+}
+
+// A request can be merged with others if it has no images and all its inputs have the same dim 0, the signature
+// records the data type and the other dims of every input. The data size of every input should match its shape and
+// data type, otherwise the request fails alone before it could be merged.
+Status BatchScheduler::InitTask(Task *task) {
+  auto &request = *task->request;
+  for (auto &tensor : request.data()) {
+    ServingTensor serving_tensor(const_cast<ms_serving::Tensor &>(tensor));
+    auto element_num = serving_tensor.ElementNum();
+    auto type_size = serving_tensor.GetTypeSize(serving_tensor.data_type());
+    if (element_num < 0 || type_size == 0 ||
+        static_cast<size_t>(element_num) * static_cast<size_t>(type_size) != serving_tensor.data_size()) {
+      MSI_LOG(ERROR) << "the data size " << serving_tensor.data_size() << " of the input does not match its shape "
+                     << "and data type, element number " << element_num << ", type size " << type_size;
+      return INVALID_INPUTS;
+    }
+  }
+  if (request.images_size() > 0 || request.data_size() == 0) {
+    return SUCCESS;
+  }
+  int64_t rows = -1;
+  std::string signature;
+  for (auto &tensor : request.data()) {
+    auto &dims = tensor.tensor_shape().dims();
+    if (dims.empty() || dims[0] <= 0 || (rows != -1 && dims[0] != rows)) {
+      return SUCCESS;
+    }
+    rows = dims[0];
+    signature += std::to_string(tensor.tensor_type());
+    for (int i = 1; i < dims.size(); i++) {
+      signature += "," + std::to_string(dims[i]);
+    }
+    signature += ";";
+  }
+  task->rows = rows;
+  task->signature = std::move(signature);
+  return SUCCESS;
+}
+
+Status BatchScheduler::Predict(const PredictRequest &request, PredictReply &reply) {
+  auto task = std::make_shared<Task>();
+  task->request = &request;
+  task->reply = &reply;
+  task->enqueue_time = std::chrono::steady_clock::now();
+  auto ret = InitTask(task.get());
+  if (ret != SUCCESS) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    metrics_.requests++;
+    metrics_.failed_requests++;
+    return ret;
+  }
+  auto future = task->promise.get_future();
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!started_ || stop_) {
+      MSI_LOG(ERROR) << "the batch scheduler has not started";
+      return FAILED;
+    }
+    queue_.push_back(task);
+  }
+  cond_.notify_all();
+  return future.get();
+}
+
+std::vector<BatchScheduler::TaskPtr> BatchScheduler::NextBatch() {
+  std::vector<TaskPtr> batch;
+  std::unique_lock<std::mutex> lock(mutex_);
+  cond_.wait(lock, [this]() { return stop_ || !queue_.empty(); });
+  if (queue_.empty()) {
+    return batch;
+  }
+  auto first = queue_.front();
+  queue_.pop_front();
+  batch.push_back(first);
+  int64_t max_rows = options_.max_batch_size;
+  if (first->rows == 0 || first->rows >= max_rows ||
+      IsUnbatchable(first->signature, std::chrono::steady_clock::now())) {
+    return batch;
+  }
+  int64_t rows = first->rows;
+  auto deadline = first->enqueue_time + std::chrono::microseconds(options_.max_queue_delay_us);
+  while (true) {
+    // take the queued requests of the same signature in arrival order while they fit
+    for (auto iter = queue_.begin(); iter != queue_.end() && rows < max_rows;) {
+      auto &task = *iter;
+      if (task->signature == first->signature && rows + task->rows <= max_rows) {
+        rows += task->rows;
+        batch.push_back(task);
+        iter = queue_.erase(iter);
+      } else {
+        ++iter;
+      }
+    }
+    if (rows >= max_rows || stop_ || std::chrono::steady_clock::now() >= deadline) {
+      break;
+    }
+    (void)cond_.wait_until(lock, deadline);
+  }
+  // other workers may pick up what is left
+  if (!queue_.empty()) {
+    cond_.notify_one();
+  }
+  return batch;
+}
+
+void BatchScheduler::WorkerLoop(Instance *instance) {
+  while (true) {
+    auto batch = NextBatch();
+    if (batch.empty()) {
+      return;
+    }
+    RunBatch(instance, batch);
+  }
+}
+
+void BatchScheduler::RunBatch(Instance *instance, const std::vector<TaskPtr> &batch) {
+  std::lock_guard<std::mutex> lock(instance->mutex);
+  if (batch.size() > 1) {
+    auto start = std::chrono::steady_clock::now();
+    int64_t rows = 0;
+    auto ret = RunMerged(instance, batch, &rows);
+    if (ret == SUCCESS) {
+      RecordExecution(batch.size(), rows, start, std::chrono::steady_clock::now());
+      for (auto &task : batch) {
+        Finish(task, ret, start);
+      }
+      return;
+    }
+    {
+      std::lock_guard<std::mutex> queue_lock(mutex_);
+      AddUnbatchable(batch[0]->signature, std::chrono::steady_clock::now());
+    }
+    MSI_LOG_WARNING << "The model can not run the merged requests, the requests of this input signature will run "
+                       "one by one for "
+                    << kUnbatchableExpireSeconds << " seconds";
+  }
+  for (auto &task : batch) {
+    auto start = std::chrono::steady_clock::now();
+    task->reply->Clear();
+    auto ret = RunSingle(instance, *task);
+    RecordExecution(1, task->rows, start, std::chrono::steady_clock::now());
+    Finish(task, ret, start);
+  }
+}
+
+Status BatchScheduler::RunSingle(Instance *instance, const Task &task) {
+  if (!instance->model_loaded || instance->session == nullptr) {
+    MSI_LOG(ERROR) << "the model has not loaded";
+    return FAILED;
+  }
+  auto &request = *task.request;
+  auto &reply = *task.reply;
+  if (request.images_size() > 0) {
+    ServingImagesRequest serving_images(request);
+    ServingRequest serving_request(request);
+    ServingReply serving_reply(reply);
+    Status ret = instance->session->ExecuteModel(instance->model_id, serving_images, serving_request, serving_reply);
+    if (ret != SUCCESS) {
+      MSI_LOG(ERROR) << "execute model with images return failed";
+      return ret;
+    }
+  } else if (request.data_size() > 0) {
+    ServingRequest serving_request(request);
+    ServingReply serving_reply(reply);
+    Status ret = instance->session->ExecuteModel(instance->model_id, serving_request, serving_reply);
+    if (ret != SUCCESS) {
+      MSI_LOG(ERROR) << "execute model with datas return failed";
+      return ret;
+    }
+  }
+  return SUCCESS;
+}
+
+Status BatchScheduler::RunMerged(Instance *instance, const std::vector<TaskPtr> &batch, int64_t *rows) {
+  if (!instance->model_loaded || instance->session == nullptr) {
+    MSI_LOG(ERROR) << "the model has not loaded";
+    return FAILED;
+  }
+  int64_t total_rows = 0;
+  for (auto &task : batch) {
+    total_rows += task->rows;
+  }
+  *rows = total_rows;
+  // concatenate every input of the requests along dim 0
+  auto &first_request = *batch[0]->request;
+  std::vector<inference::InferTensor> inputs(first_request.data_size());
+  for (int i = 0; i < first_request.data_size(); i++) {
+    auto &first_tensor = first_request.data(i);
+    auto &input = inputs[i];
+    input.set_data_type(ServingTensor(const_cast<ms_serving::Tensor &>(first_tensor)).data_type());
+    std::vector<int64_t> shape(first_tensor.tensor_shape().dims().begin(), first_tensor.tensor_shape().dims().end());
+    shape[0] = total_rows;
+    input.set_shape(shape);
+    size_t total_size = 0;
+    for (auto &task : batch) {
+      total_size += task->request->data(i).data().size();
+    }
+    input.data_.reserve(total_size);
+    for (auto &task : batch) {
+      auto &data = task->request->data(i).data();
+      input.data_.insert(input.data_.end(), data.begin(), data.end());
+    }
+  }
+  std::vector<inference::InferTensor> outputs;
+  auto ret = instance->session->ExecuteModel(instance->model_id, inputs, outputs);
+  if (ret != SUCCESS) {
+    return ret;
+  }
+  // every output should have total_rows rows to be split back to the requests
+  for (auto &output : outputs) {
+    auto shape = output.shape();
+    if (shape.empty() || shape[0] != total_rows || RowBytes(output, total_rows) * total_rows != output.data_size()) {
+      return FAILED;
+    }
+  }
+  for (auto &output : outputs) {
+    auto shape = output.shape();
+    size_t row_bytes = RowBytes(output, total_rows);
+    size_t offset = 0;
+    for (auto &task : batch) {
+      ServingReply reply(*task->reply);
+      auto result = reply.add();
+      if (result == nullptr) {
+        return FAILED;
+      }
+      shape[0] = task->rows;
+      size_t size = row_bytes * static_cast<size_t>(task->rows);
+      result->set_data_type(output.data_type());
+      result->set_shape(shape);
+      if (!result->set_data(output.data_.data() + offset, size)) {
+        return FAILED;
+      }
+      offset += size;
+    }
+  }
+  return SUCCESS;
+}
+
+// called with mutex_ held
+bool BatchScheduler::IsUnbatchable(const std::string &signature, TimePoint now) {
+  auto iter = unbatchable_signatures_.find(signature);
+  if (iter == unbatchable_signatures_.end()) {
+    return false;
+  }
+  if (now < iter->second) {
+    return true;
+  }
+  (void)unbatchable_signatures_.erase(iter);
+  return false;
+}
+
+// called with mutex_ held
+void BatchScheduler::AddUnbatchable(const std::string &signature, TimePoint now) {
+  if (unbatchable_signatures_.size() >= kMaxUnbatchableSignatures &&
+      unbatchable_signatures_.find(signature) == unbatchable_signatures_.end()) {
+    // drop the entry that expires first
+    auto oldest = std::min_element(unbatchable_signatures_.begin(), unbatchable_signatures_.end(),
+                                   [](const auto &lhs, const auto &rhs) { return lhs.second < rhs.second; });
+    (void)unbatchable_signatures_.erase(oldest);
+  }
+  unbatchable_signatures_[signature] = now + std::chrono::seconds(kUnbatchableExpireSeconds);
+}
+
+void BatchScheduler::RecordExecution(size_t requests, int64_t rows, TimePoint start, TimePoint end) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  metrics_.batches++;
+  metrics_.batched_rows += static_cast<uint64_t>(std::max<int64_t>(rows, 1));
+  metrics_.execute_ms_total += DurationMs(start, end);
+  if (requests > 1) {
+    metrics_.merged_requests += requests;
+  }
+  if (end - last_log_time_ >= std::chrono::seconds(kMetricsLogIntervalSeconds)) {
+    LogMetrics();
+    last_log_time_ = end;
+  }
+}
+
+void BatchScheduler::Finish(const TaskPtr &task, const Status &status, TimePoint start) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto queue_ms = DurationMs(task->enqueue_time, start);
+    metrics_.requests++;
+    if (status != SUCCESS) {
+      metrics_.failed_requests++;
+    }
+    metrics_.queue_ms_total += queue_ms;
+    metrics_.queue_ms_max = std::max(metrics_.queue_ms_max, queue_ms);
+  }
+  task->promise.set_value(status);
+}
+
+void BatchScheduler::LogMetrics() {
+  if (metrics_.requests == 0 || metrics_.batches == 0) {
+    return;
+  }
+  MSI_LOG_INFO << "Serving metrics: requests " << metrics_.requests << ", failed " << metrics_.failed_requests
+               << ", merged " << metrics_.merged_requests << ", batches " << metrics_.batches << ", avg rows per batch "
+               << static_cast<double>(metrics_.batched_rows) / metrics_.batches << ", avg queue "
+               << metrics_.queue_ms_total / metrics_.requests << " ms, max queue " << metrics_.queue_ms_max
+               << " ms, avg execute " << metrics_.execute_ms_total / metrics_.batches << " ms";
+}
+
+ModelMetrics BatchScheduler::GetMetrics() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return metrics_;
+}
+}  // namespace serving
+}  // namespace mindspore
@@ -0,0 +1,128 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_SERVING_BATCH_SCHEDULER_H
+#define MINDSPORE_SERVING_BATCH_SCHEDULER_H
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <future>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "util/status.h"
+#include "include/inference.h"
+#include "serving/ms_service.pb.h"
+
+namespace mindspore {
+namespace serving {
+
+using ms_serving::PredictReply;
+using ms_serving::PredictRequest;
+
+struct BatchOptions {
+  // the max rows (dim 0 of the inputs) merged into one execution, 1 means no batching
+  uint32_t max_batch_size = 1;
+  // how long the first request of a batch waits for more requests
+  uint32_t max_queue_delay_us = 1000;
+};
+
+struct ModelMetrics {
+  uint64_t requests = 0;
+  uint64_t failed_requests = 0;
+  // requests run merged with others
+  uint64_t merged_requests = 0;
+  // model executions and the rows they ran
+  uint64_t batches = 0;
+  uint64_t batched_rows = 0;
+  double queue_ms_total = 0;
+  double queue_ms_max = 0;
+  double execute_ms_total = 0;
+};
+
+// Serve one model with several model instances (inference sessions). Predict requests are put into the queue of
+// the model, each instance runs a worker which merges the queued requests of the same input signature along dim 0
+// up to max_batch_size rows, executes the model once and splits the outputs back to the replies. A model whose
+// outputs can not be split by rows, or which rejects the merged inputs, is served one request at a time for that
+// input signature for a while.
+class BatchScheduler {
+ public:
+  explicit BatchScheduler(const BatchOptions &options);
+  ~BatchScheduler();
+
+  // add one model instance, should be called before Start
+  void AddInstance(const std::shared_ptr<inference::InferSession> &session);
+  size_t InstanceCount() const { return instances_.size(); }
+  // load the model on every instance, the instance being reloaded stops taking requests meanwhile
+  Status LoadModel(const std::string &file_name);
+  void Start();
+  void Stop();
+  // unload the model and finalize the sessions, the scheduler should be stopped
+  void Clear();
+  // enqueue the request and wait for the reply
+  Status Predict(const PredictRequest &request, PredictReply &reply);
+  ModelMetrics GetMetrics() const;
+
+ private:
+  using TimePoint = std::chrono::steady_clock::time_point;
+  struct Task {
+    const PredictRequest *request = nullptr;
+    PredictReply *reply = nullptr;
+    std::promise<Status> promise;
+    TimePoint enqueue_time;
+    // dim 0 of the inputs, 0 if the request can not be batched
+    int64_t rows = 0;
+    std::string signature;
+  };
+  using TaskPtr = std::shared_ptr<Task>;
+  struct Instance {
+    std::shared_ptr<inference::InferSession> session;
+    uint32_t model_id = 0;
+    bool model_loaded = false;
+    std::mutex mutex;
+    std::thread worker;
+  };
+
+  void WorkerLoop(Instance *instance);
+  std::vector<TaskPtr> NextBatch();
+  void RunBatch(Instance *instance, const std::vector<TaskPtr> &batch);
+  Status RunSingle(Instance *instance, const Task &task);
+  Status RunMerged(Instance *instance, const std::vector<TaskPtr> &batch, int64_t *rows);
+  void RecordExecution(size_t requests, int64_t rows, TimePoint start, TimePoint end);
+  void Finish(const TaskPtr &task, const Status &status, TimePoint start);
+  void LogMetrics();
+  bool IsUnbatchable(const std::string &signature, TimePoint now);
+  void AddUnbatchable(const std::string &signature, TimePoint now);
+  static Status InitTask(Task *task);
+
+  BatchOptions options_;
+  std::vector<std::unique_ptr<Instance>> instances_;
+  mutable std::mutex mutex_;
+  std::condition_variable cond_;
+  std::deque<TaskPtr> queue_;
+  // signatures of the inputs that the model failed to run merged, and when they may be merged again
+  std::map<std::string, TimePoint> unbatchable_signatures_;
+  bool started_ = false;
+  bool stop_ = false;
+  ModelMetrics metrics_;
+  TimePoint last_log_time_;
+};
+}  // namespace serving
+}  // namespace mindspore
+#endif  // MINDSPORE_SERVING_BATCH_SCHEDULER_H
@@ -24,6 +24,7 @@
 #include <memory>
 #include <future>
 #include <chrono>
+#include <algorithm>
 
 #include "include/infer_log.h"
 #include "serving/ms_service.grpc.pb.h"
@@ -47,12 +48,20 @@ namespace serving {
     MSI_LOG_INFO << #name " Time Cost # " << time_cost << " ms ---------------------";                          \
   }
 
-Status Session::CreatDeviceSession(const std::string &device, uint32_t device_id) {
-  session_ = inference::InferSession::CreateSession(device, device_id);
-  if (session_ == nullptr) {
-    MSI_LOG(ERROR) << "Creat Session Failed";
-    return FAILED;
+Status Session::CreatDeviceSession(const std::string &device, uint32_t device_id, uint32_t instance_count,
+                                   const BatchOptions &batch_options) {
+  auto scheduler = std::make_unique<BatchScheduler>(batch_options);
+  for (uint32_t i = 0; i < std::max(instance_count, 1u); i++) {
+    auto session = inference::InferSession::CreateSession(device, device_id);
+    if (session == nullptr) {
+      MSI_LOG(ERROR) << "Creat Session Failed";
+      scheduler->Clear();
+      return FAILED;
+    }
+    scheduler->AddInstance(session);
   }
+  scheduler->Start();
+  scheduler_ = std::move(scheduler);
   device_type_ = device;
   return SUCCESS;
 }
@@ -67,49 +76,31 @@ Status Session::Predict(const PredictRequest &request, PredictReply &reply) {
     MSI_LOG(ERROR) << "the model has not loaded";
     return FAILED;
   }
-  if (session_ == nullptr) {
+  if (scheduler_ == nullptr) {
     MSI_LOG(ERROR) << "the inference session has not be initialized";
     return FAILED;
   }
-  std::lock_guard<std::mutex> lock(mutex_);
   MSI_LOG(INFO) << "run Predict";
-
-  if (request.images_size() > 0) {
-    ServingImagesRequest serving_images(request);
-    ServingRequest serving_request(request);
-    ServingReply serving_reply(reply);
-    Status ret = session_->ExecuteModel(graph_id_, serving_images, serving_request, serving_reply);
-    if (ret != SUCCESS) {
-      MSI_LOG(ERROR) << "execute model with images return failed";
-      return ret;
-    }
-  } else if (request.data_size() > 0) {
-    ServingRequest serving_request(request);
-    ServingReply serving_reply(reply);
-    Status ret = session_->ExecuteModel(graph_id_, serving_request, serving_reply);
-    if (ret != SUCCESS) {
-      MSI_LOG(ERROR) << "execute model with datas return failed";
-      return ret;
-    }
+  Status ret = scheduler_->Predict(request, reply);
+  if (ret != SUCCESS) {
+    return ret;
   }
-
   MSI_LOG(INFO) << "run Predict finished";
   return SUCCESS;
 }
 
 Status Session::Warmup(const MindSporeModelPtr model) {
-  if (session_ == nullptr) {
+  if (scheduler_ == nullptr) {
     MSI_LOG(ERROR) << "The CreatDeviceSession should be called, before warmup";
     return FAILED;
   }
   std::lock_guard<std::mutex> lock(mutex_);
   std::string file_name = model->GetModelPath() + '/' + model->GetModelName();
-  model_loaded_ = false;
   MSI_TIME_STAMP_START(LoadModelFromFile)
-  auto ret = session_->LoadModelFromFile(file_name, graph_id_);
+  auto ret = scheduler_->LoadModel(file_name);
   MSI_TIME_STAMP_END(LoadModelFromFile)
   if (ret != SUCCESS) {
-    MSI_LOG(ERROR) << "Load graph model failed, file name is " << file_name.c_str();
+    model_loaded_ = false;
     return ret;
   }
   model_loaded_ = true;
@@ -118,10 +109,9 @@ Status Session::Warmup(const MindSporeModelPtr model) {
 }
 
 Status Session::Clear() {
-  if (session_ != nullptr) {
-    session_->UnloadModel(graph_id_);
-    session_->FinalizeEnv();
-    session_ = nullptr;
+  if (scheduler_ != nullptr) {
+    scheduler_->Clear();
+    scheduler_ = nullptr;
   }
   return SUCCESS;
 }
@@ -156,7 +146,6 @@ grpc::Status CreatGRPCStatus(const Status &status) {
 // Service Implement
 class MSServiceImpl final : public MSService::Service {
   grpc::Status Predict(grpc::ServerContext *context, const PredictRequest *request, PredictReply *reply) override {
-    std::lock_guard<std::mutex> lock(mutex_);
     MSI_TIME_STAMP_START(Predict)
     auto res = Session::Instance().Predict(*request, *reply);
     MSI_TIME_STAMP_END(Predict)
@@ -171,7 +160,6 @@ class MSServiceImpl final : public MSService::Service {
     MSI_LOG(INFO) << "TestService call";
     return grpc::Status::OK;
   }
-  std::mutex mutex_;
 };
 
 Status Server::BuildAndStart() {
@@ -185,7 +173,11 @@ Status Server::BuildAndStart() {
   std::string model_name = option_args->model_name;
   std::string device_type = option_args->device_type;
   auto device_id = option_args->device_id;
-  res = Session::Instance().CreatDeviceSession(device_type, device_id);
+  BatchOptions batch_options;
+  batch_options.max_batch_size = static_cast<uint32_t>(option_args->max_batch_size);
+  batch_options.max_queue_delay_us = static_cast<uint32_t>(option_args->max_queue_delay_us);
+  res = Session::Instance().CreatDeviceSession(device_type, device_id,
+                                               static_cast<uint32_t>(option_args->instance_count), batch_options);
   if (res != SUCCESS) {
     MSI_LOG(ERROR) << "creat session failed";
     ClearEnv();
@@ -22,6 +22,7 @@
 #include <memory>
 #include "util/status.h"
 #include "version_control/model.h"
+#include "core/batch_scheduler.h"
 #include "include/inference.h"
 #include "serving/ms_service.pb.h"
 #include "serving/ms_service.grpc.pb.h"
@@ -39,7 +40,9 @@ using inference::INVALID_INPUTS;
 class Session {
  public:
   static Session &Instance();
-  Status CreatDeviceSession(const std::string &device, uint32_t device_id);
+  // create instance_count inference sessions of the device, which share the requests of the model
+  Status CreatDeviceSession(const std::string &device, uint32_t device_id, uint32_t instance_count = 1,
+                            const BatchOptions &batch_options = BatchOptions());
   // Status Predict(const inference::MultiTensor &inputs, inference::MultiTensor &output);
   Status Predict(const PredictRequest &request, PredictReply &reply);
   Status Warmup(const MindSporeModelPtr model);
@@ -48,10 +51,8 @@ class Session {
  private:
   Session() = default;
   ~Session() = default;
-  int sesseion_id_{0};
-  std::shared_ptr<inference::InferSession> session_{nullptr};
+  std::unique_ptr<BatchScheduler> scheduler_{nullptr};
   bool model_loaded_ = false;
-  uint32_t graph_id_{0};
   std::mutex mutex_;
   std::string device_type_;
 };
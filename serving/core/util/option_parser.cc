@@ -163,6 +163,13 @@ void Options::CreateOptions() {
     Option("model_name", &args_->model_name, "[Required] model name "),
     Option("model_path", &args_->model_path, "[Required] the path of the model files"),
     Option("device_id", &args_->device_id, "[Optional] the device id, default is 0, range from 0 to 7"),
+    Option("device_type", &args_->device_type, "[Optional] the device type, Ascend or CPU, default is Ascend"),
+    Option("instance_count", &args_->instance_count,
+           "[Optional] the number of model instances on the device, default is 1, range from 1 to 16"),
+    Option("max_batch_size", &args_->max_batch_size,
+           "[Optional] the max rows of the concurrent requests merged into one execution, default is 1(no batching)"),
+    Option("max_queue_delay_us", &args_->max_queue_delay_us,
+           "[Optional] the max time(us) a request waits for others to be merged with, default is 1000"),
   };
   options_ = options;
 }
@@ -172,8 +179,20 @@ bool Options::CheckOptions() {
     std::cout << "model_path and model_name should not be null" << std::endl;
     return false;
   }
-  if (args_->device_type != "Ascend") {
-    std::cout << "device_type only support Ascend right now" << std::endl;
+  if (args_->device_type != "Ascend" && args_->device_type != "CPU") {
+    std::cout << "device_type only support Ascend and CPU right now" << std::endl;
+    return false;
+  }
+  if (args_->instance_count < 1 || args_->instance_count > 16) {
+    std::cout << "the instance_count should be in [1~16]" << std::endl;
+    return false;
+  }
+  if (args_->max_batch_size < 1) {
+    std::cout << "the max_batch_size should be positive" << std::endl;
+    return false;
+  }
+  if (args_->max_queue_delay_us < 0) {
+    std::cout << "the max_queue_delay_us should not be negative" << std::endl;
     return false;
   }
   if (args_->device_id > 7) {
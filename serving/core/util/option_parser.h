@@ -31,6 +31,9 @@ struct Arguments {
   std::string model_path;
   std::string device_type = "Ascend";
   int32_t device_id = 0;
+  int32_t instance_count = 1;
+  int32_t max_batch_size = 1;
+  int32_t max_queue_delay_us = 1000;
 };
 
 class Option {
@@ -13,6 +13,8 @@
 # limitations under the License.
 # ============================================================================
 
+import os
+
 import numpy as np
 import pytest
 
@@ -70,3 +72,35 @@ def test_conv2d():
                          [198, 210, 222]]]]).astype(np.float32)
     print(output)
     assert (output.asnumpy() == expect).all()
+
+
+class NetConv2dWeight(nn.Cell):
+    def __init__(self, weight):
+        super(NetConv2dWeight, self).__init__()
+        self.conv = P.Conv2D(out_channel=16, kernel_size=3, pad_mode="same")
+        self.w = Parameter(Tensor(weight), name='w')
+
+    def construct(self, x):
+        return self.conv(x, self.w)
+
+
+@pytest.mark.level0
+@pytest.mark.platform_x86_cpu
+@pytest.mark.env_onecard
+def test_conv2d_blocked_format_weight_update():
+    """Weights replaced between two runs, as load_checkpoint does, are reordered again, and reused otherwise."""
+    os.environ['MS_CPU_BLOCKED_FORMAT'] = '1'
+    try:
+        x = np.random.randn(1, 16, 8, 8).astype(np.float32)
+        weight = np.random.randn(16, 16, 3, 3).astype(np.float32)
+        net = NetConv2dWeight(weight)
+        first = net(Tensor(x)).asnumpy()
+        net.w.set_parameter_data(Tensor(weight * 2))
+        second = net(Tensor(x)).asnumpy()
+        # the reordered copy of the unchanged weights is reused
+        third = net(Tensor(x * 3)).asnumpy()
+    finally:
+        os.environ.pop('MS_CPU_BLOCKED_FORMAT', None)
+    assert not np.allclose(first, second)
+    assert np.allclose(second, first * 2, rtol=1e-4, atol=1e-4)
+    assert np.allclose(third, second * 3, rtol=1e-4, atol=1e-3)
@@ -0,0 +1,144 @@
+# Copyright 2019 Huawei Technologies Co., Ltd
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# ============================================================================
+"""Correctness and speed of the CPU fusions with MS_CPU_DISABLE_FUSION unset and set to all."""
+import os
+import time
+
+import numpy as np
+import pytest
+
+import mindspore.context as context
+import mindspore.nn as nn
+from mindspore import Tensor
+from mindspore.ops import operations as P
+
+context.set_context(mode=context.GRAPH_MODE, device_target='CPU')
+
+
+class ConvBiasRelu(nn.Cell):
+    def __init__(self):
+        super(ConvBiasRelu, self).__init__()
+        self.conv = P.Conv2D(out_channel=16, kernel_size=3, pad_mode="same")
+        self.bias_add = P.BiasAdd()
+        self.relu = P.ReLU()
+
+    def construct(self, x, w, b):
+        return self.relu(self.bias_add(self.conv(x, w), b))
+
+
+class MatMulBiasRelu(nn.Cell):
+    def __init__(self):
+        super(MatMulBiasRelu, self).__init__()
+        self.matmul = P.MatMul(transpose_b=True)
+        self.bias_add = P.BiasAdd()
+        self.relu = P.ReLU()
+
+    def construct(self, x, w, b):
+        return self.relu(self.bias_add(self.matmul(x, w), b))
+
+
+class ElemwiseChain(nn.Cell):
+    def __init__(self):
+        super(ElemwiseChain, self).__init__()
+        self.mul = P.Mul()
+        self.relu = P.ReLU()
+
+    def construct(self, x, y, z):
+        return self.relu(self.mul(self.mul(x, y), z))
+
+
+def run(net_class, inputs, disable_fusion, steps=1):
+    """Compile a new instance of net_class and return its output and the average time of one step."""
+    if disable_fusion:
+        os.environ['MS_CPU_DISABLE_FUSION'] = 'all'
+    else:
+        os.environ.pop('MS_CPU_DISABLE_FUSION', None)
+    net = net_class()
+    output = net(*inputs)
+    start = time.time()
+    for _ in range(steps):
+        output = net(*inputs)
+    cost = (time.time() - start) / steps
+    os.environ.pop('MS_CPU_DISABLE_FUSION', None)
+    return output.asnumpy(), cost
+
+
+def conv_inputs():
+    np.random.seed(0)
+    return [Tensor(np.random.randn(8, 16, 32, 32).astype(np.float32)),
+            Tensor(np.random.randn(16, 16, 3, 3).astype(np.float32)),
+            Tensor(np.random.randn(16).astype(np.float32))]
+
+
+def matmul_inputs():
+    np.random.seed(0)
+    return [Tensor(np.random.randn(256, 512).astype(np.float32)),
+            Tensor(np.random.randn(1024, 512).astype(np.float32)),
+            Tensor(np.random.randn(1024).astype(np.float32))]
+
+
+def elemwise_inputs():
+    np.random.seed(0)
+    return [Tensor(np.random.randn(1024, 1024).astype(np.float32)),
+            Tensor(np.random.randn(1024, 1024).astype(np.float32)),
+            Tensor(np.random.randn(1024, 1024).astype(np.float32))]
+
+
+@pytest.mark.level0
+@pytest.mark.platform_x86_cpu
+@pytest.mark.env_onecard
+def test_conv_bias_relu_fusion():
+    fused, _ = run(ConvBiasRelu, conv_inputs(), False)
+    unfused, _ = run(ConvBiasRelu, conv_inputs(), True)
+    assert (fused >= 0).all()
+    assert np.allclose(fused, unfused, rtol=1e-4, atol=1e-4)
+
+
+@pytest.mark.level0
+@pytest.mark.platform_x86_cpu
+@pytest.mark.env_onecard
+def test_matmul_bias_relu_fusion():
+    inputs = matmul_inputs()
+    x, w, b = [t.asnumpy() for t in inputs]
+    expect = np.maximum(np.matmul(x, w.T) + b, 0)
+    fused, _ = run(MatMulBiasRelu, inputs, False)
+    assert np.allclose(fused, expect, rtol=1e-4, atol=1e-3)
+
+
+@pytest.mark.level0
+@pytest.mark.platform_x86_cpu
+@pytest.mark.env_onecard
+def test_elemwise_chain_fusion():
+    inputs = elemwise_inputs()
+    x, y, z = [t.asnumpy() for t in inputs]
+    expect = np.maximum(x * y * z, 0)
+    fused, _ = run(ElemwiseChain, inputs, False)
+    unfused, _ = run(ElemwiseChain, inputs, True)
+    assert np.allclose(fused, expect, rtol=1e-5, atol=1e-5)
+    assert np.allclose(unfused, expect, rtol=1e-5, atol=1e-5)
+
+
+def benchmark(steps=50):
+    """Print the time of one step of each pattern before and after its fusion."""
+    for net_class, inputs in [(ConvBiasRelu, conv_inputs()), (MatMulBiasRelu, matmul_inputs()),
+                              (ElemwiseChain, elemwise_inputs())]:
+        _, unfused_cost = run(net_class, inputs, True, steps)
+        _, fused_cost = run(net_class, inputs, False, steps)
+        print("{}: unfused {:.3f} ms, fused {:.3f} ms, speedup {:.2f}x".format(
+            net_class.__name__, unfused_cost * 1000, fused_cost * 1000, unfused_cost / fused_cost))
+
+
+if __name__ == '__main__':
+    benchmark()
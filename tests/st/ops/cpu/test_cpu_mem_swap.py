@@ -0,0 +1,109 @@
+# Copyright 2020 Huawei Technologies Co., Ltd
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# ============================================================================
+"""The CPU backend gives the same results when MS_CPU_SWAP_MEMORY_LIMIT forces tensors out to host memory or a file."""
+import os
+import re
+import subprocess
+import sys
+import tempfile
+
+import numpy as np
+import pytest
+
+import mindspore.context as context
+import mindspore.nn as nn
+from mindspore import Tensor
+from mindspore.ops import operations as P
+
+context.set_context(mode=context.GRAPH_MODE, device_target='CPU')
+
+
+class LongSkipNet(nn.Cell):
+    """The first matmul result is used again only by the last add, so it is the tensor to swap."""
+    def __init__(self):
+        super(LongSkipNet, self).__init__()
+        self.matmul = P.MatMul()
+        self.tanh = P.Tanh()
+        self.add = P.TensorAdd()
+        self.reduce_mean = P.ReduceMean(keep_dims=True)
+
+    def construct(self, x, w):
+        skip = self.matmul(x, w)
+        out = self.tanh(skip)
+        for _ in range(8):
+            out = self.add(self.tanh(self.matmul(out, w)), out)
+        return self.add(skip, self.reduce_mean(out, 1))
+
+
+def run(env, steps=2):
+    os.environ['MS_CPU_DISABLE_FUSION'] = 'all'
+    os.environ.update(env)
+    np.random.seed(0)
+    x = Tensor(np.random.randn(1024, 512).astype(np.float32))
+    w = Tensor((np.random.randn(512, 512) / 32).astype(np.float32))
+    net = LongSkipNet()
+    outputs = [net(x, w).asnumpy() for _ in range(steps)]
+    for key in list(env.keys()) + ['MS_CPU_DISABLE_FUSION']:
+        os.environ.pop(key, None)
+    return outputs
+
+
+def run_in_subprocess(env):
+    """Run the net in a child process logging at INFO level, returns its outputs and its log."""
+    with tempfile.TemporaryDirectory() as output_dir:
+        output_file = os.path.join(output_dir, 'outputs.npy')
+        child_env = dict(os.environ, GLOG_v='1', GLOG_logtostderr='1', **env)
+        result = subprocess.run([sys.executable, __file__, output_file], env=child_env, stderr=subprocess.PIPE,
+                                universal_newlines=True, check=True)
+        return list(np.load(output_file)), result.stderr
+
+
+def check_swapped(log, steps=2):
+    """Every step copied tensors out to the slow tier and back."""
+    swaps = re.findall(r"with memory swap is \d+ bytes, (\d+) bytes swapped out and (\d+) bytes swapped in", log)
+    assert len(swaps) == steps
+    for swap_out, swap_in in swaps:
+        assert int(swap_out) > 0
+        assert int(swap_in) > 0
+
+
+@pytest.mark.level0
+@pytest.mark.platform_x86_cpu
+@pytest.mark.env_onecard
+def test_swap_to_host():
+    expect = run({})
+    # Every intermediate result takes 2 MB, the loop keeps 8 MB alive with the skip tensor and 6 MB without it.
+    outputs, log = run_in_subprocess({'MS_CPU_SWAP_MEMORY_LIMIT': '7', 'MS_CPU_SWAP_LOOKAHEAD': '2'})
+    check_swapped(log)
+    for output, expect_output in zip(outputs, expect):
+        assert np.allclose(output, expect_output, rtol=1e-5, atol=1e-5)
+
+
+@pytest.mark.level0
+@pytest.mark.platform_x86_cpu
+@pytest.mark.env_onecard
+def test_swap_to_file():
+    expect = run({})
+    with tempfile.TemporaryDirectory() as swap_dir:
+        outputs, log = run_in_subprocess({'MS_CPU_SWAP_MEMORY_LIMIT': '7',
+                                          'MS_CPU_SWAP_FILE': os.path.join(swap_dir, 'swap.bin')})
+    check_swapped(log)
+    for output, expect_output in zip(outputs, expect):
+        assert np.allclose(output, expect_output, rtol=1e-5, atol=1e-5)
+
+
+if __name__ == '__main__':
+    # The child of run_in_subprocess, its environment holds the swap settings.
+    np.save(sys.argv[1], np.stack(run({})))
@@ -23,6 +23,8 @@ export MS_WORKER_NUM=$2
 export MS_SERVER_NUM=$3
 export MS_SCHED_HOST=$4
 export MS_SCHED_PORT=$5
+CACHE_SIZE=${6:-0}
+CACHE_STALENESS=${7:-0}
 
 export MS_ROLE=MS_SCHED
 for((i=0;i<1;i++));
@@ -30,7 +32,7 @@ do
   rm -rf ${execute_path}/sched_$i/
   mkdir ${execute_path}/sched_$i/
   cd ${execute_path}/sched_$i/ || exit
-  python ${self_path}/../test_cmp_sparse_embedding.py &
+  python ${self_path}/../test_cmp_sparse_embedding.py --cache_size=${CACHE_SIZE} --cache_staleness=${CACHE_STALENESS} &
 done
 
 export MS_ROLE=MS_PSERVER
@@ -39,16 +41,19 @@ do
   rm -rf ${execute_path}/server_$i/
   mkdir ${execute_path}/server_$i/
   cd ${execute_path}/server_$i/ || exit
-  python ${self_path}/../test_cmp_sparse_embedding.py &
+  python ${self_path}/../test_cmp_sparse_embedding.py --cache_size=${CACHE_SIZE} --cache_staleness=${CACHE_STALENESS} &
 done
 
 export MS_ROLE=MS_WORKER
+# The embedding cache statistics are logged at INFO level.
+export GLOG_v=1
 for((i=0;i<$MS_WORKER_NUM;i++));
 do
   rm -rf ${execute_path}/worker_$i/
   mkdir ${execute_path}/worker_$i/
   cd ${execute_path}/worker_$i/ || exit
-  python ${self_path}/../test_cmp_sparse_embedding.py &
+  python ${self_path}/../test_cmp_sparse_embedding.py --cache_size=${CACHE_SIZE} --cache_staleness=${CACHE_STALENESS} \
+    > worker.log 2>&1 &
 done
 
 wait $!
@@ -29,8 +29,12 @@ from mindspore import Parameter
 
 parser = argparse.ArgumentParser(description="test_sparse_embedding")
 parser.add_argument("--device_target", type=str, default="Ascend")
+parser.add_argument("--cache_size", type=int, default=0)
+parser.add_argument("--cache_staleness", type=int, default=0)
 args, _ = parser.parse_known_args()
 device_target = args.device_target
+cache_size = args.cache_size
+cache_staleness = args.cache_staleness
 context.set_context(
     mode=context.GRAPH_MODE, device_target=device_target, enable_sparse=True
 )
@@ -57,6 +61,11 @@ class LeNet5(nn.Cell):
             initializer("normal", (16, 4), mstype.float32), name="embedding_table"
         )
         self.embedding = nn.EmbeddingLookup()
+        if cache_size > 0:
+            # With staleness 0 a cached row is pulled again in the next step, so no row is served from the cache.
+            # A staleness longer than the training serves every row pulled in the first step until the end.
+            self.embedding.embeddinglookup.add_prim_attr("cache_size", cache_size)
+            self.embedding.embeddinglookup.add_prim_attr("cache_staleness", cache_staleness)
         self.relu = nn.ReLU()
         self.fc = fc_with_initialize(12, num_class)
 
@@ -68,11 +77,13 @@ class LeNet5(nn.Cell):
         return x
 
 
-def do_sparse_embedding(ps=False):
+def do_sparse_embedding(ps=False, freeze_embedding=False):
     epoch = 10
     net = LeNet5(10)
     if ps:
         net.embedding_table.set_param_ps()
+    if freeze_embedding:
+        net.embedding_table.requires_grad = False
 
     optimizer = Adam(filter(lambda x: x.requires_grad, net.get_parameters()))
     optimizer.sparse_opt.add_prim_attr("primitive_target", "CPU")
@@ -83,8 +94,12 @@ def do_sparse_embedding(ps=False):
     train_network = TrainOneStepCell(net_with_criterion, optimizer)
     train_network.set_train()
     losses = []
-    for _ in range(epoch):
-        data = Tensor(np.random.randint(0, 15, (32, 3), np.int32))
+    for i in range(epoch):
+        data = np.random.randint(0, 15, (32, 3), np.int32)
+        if i == 0:
+            # Look up every id in the first step.
+            data[:5] = np.arange(15, dtype=np.int32).reshape((5, 3))
+        data = Tensor(data)
         label = Tensor(np.random.randint(0, 9, (32), np.int32))
         loss = train_network(data, label).asnumpy()
         losses.append(loss)
@@ -100,7 +115,8 @@ if __name__ == "__main__":
     if envs.get("MS_ROLE") == "MS_WORKER":
         envs["MS_ROLE"] = ""
         np.random.seed(0)
-        no_ps_loss = do_sparse_embedding()
+        # When the cache serves the rows of the first step until the end, the worker trains as if the table is frozen.
+        no_ps_loss = do_sparse_embedding(freeze_embedding=cache_size > 0 and cache_staleness > 0)
         envs["MS_ROLE"] = "MS_WORKER"
 
     assert np.allclose(ps_loss, no_ps_loss, rtol=1.0e-6, atol=1.0e-6)
@@ -13,6 +13,7 @@
 # limitations under the License.
 # ============================================================================
 import os
+import re
 import pytest
 
 
@@ -23,3 +24,29 @@ import pytest
 def test_cmp_sparse_embedding():
     return_code = os.system("bash shell_run_test.sh Ascend 1 1 127.0.0.1 8081")
     assert return_code == 0
+
+
+@pytest.mark.level0
+@pytest.mark.platform_arm_ascend_training
+@pytest.mark.platform_x86_ascend_training
+@pytest.mark.env_onecard
+def test_cmp_sparse_embedding_with_cache():
+    return_code = os.system("bash shell_run_test.sh Ascend 1 1 127.0.0.1 8082 8")
+    assert return_code == 0
+
+
+@pytest.mark.level0
+@pytest.mark.platform_arm_ascend_training
+@pytest.mark.platform_x86_ascend_training
+@pytest.mark.env_onecard
+def test_cmp_sparse_embedding_with_stale_cache():
+    # The cache holds all 15 ids and a row is never pulled again within the 10 steps, so only the 32 * 3 lookups of
+    # the first step miss.
+    return_code = os.system("bash shell_run_test.sh Ascend 1 1 127.0.0.1 8083 16 100")
+    assert return_code == 0
+    with open("worker_0/worker.log") as f:
+        statistics = re.findall(r"hits:(\d+), misses:(\d+)", f.read())
+    assert statistics
+    hits, misses = statistics[-1]
+    assert int(hits) == 9 * 32 * 3
+    assert int(misses) == 32 * 3
@@ -0,0 +1,52 @@
+# Copyright 2020 Huawei Technologies Co., Ltd
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# ============================================================================
+"""Compare the outputs of requests batched by the CPU serving with the same rows run unbatched."""
+from concurrent.futures import ThreadPoolExecutor
+
+import grpc
+import numpy as np
+import ms_service_pb2
+import ms_service_pb2_grpc
+from .generate_batch_model import BATCH_SIZE, IN_CHANNELS
+
+
+def _predict(stub, x):
+    request = ms_service_pb2.PredictRequest()
+    tensor = request.data.add()
+    tensor.tensor_shape.dims.extend(list(x.shape))
+    tensor.tensor_type = ms_service_pb2.MS_FLOAT32
+    tensor.data = x.tobytes()
+    result = stub.Predict(request)
+    return np.frombuffer(result.result[0].data, dtype=np.float32).reshape(result.result[0].tensor_shape.dims)
+
+
+def test_batch_cpu():
+    channel = grpc.insecure_channel('localhost:5500')
+    stub = ms_service_pb2_grpc.MSServiceStub(channel)
+    np.random.seed(2)
+    x = np.random.randn(BATCH_SIZE, IN_CHANNELS).astype(np.float32)
+
+    # A request of BATCH_SIZE rows runs alone, it is the unbatched reference.
+    unbatched = _predict(stub, x)
+
+    # One row per request, sent together, they are merged into one execution of BATCH_SIZE rows. The CPU session
+    # rejects a single row run alone, so these replies can only come from the merged execution.
+    with ThreadPoolExecutor(max_workers=BATCH_SIZE) as executor:
+        futures = [executor.submit(_predict, stub, x[i:i + 1]) for i in range(BATCH_SIZE)]
+        batched = np.concatenate([future.result() for future in futures])
+    print("unbatched: ", unbatched)
+    print("batched: ", batched)
+    assert batched.shape == unbatched.shape
+    assert np.allclose(batched, unbatched, 0.0001, 0.0001)
@@ -0,0 +1,51 @@
+# Copyright 2020 Huawei Technologies Co., Ltd
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# ============================================================================
+"""Export a small model whose dim 0 is the batch, served on CPU by the batching test."""
+import numpy as np
+import mindspore.nn as nn
+from mindspore import Tensor, context
+from mindspore.common.parameter import Parameter
+from mindspore.ops import operations as P
+from mindspore.train.serialization import export
+
+context.set_context(mode=context.GRAPH_MODE, device_target="CPU")
+
+# The CPU kernels are built for the exported shape, so merged requests run only when their rows add up to it.
+BATCH_SIZE = 4
+IN_CHANNELS = 8
+OUT_CHANNELS = 3
+
+
+class MatMulAddNet(nn.Cell):
+    def __init__(self):
+        super(MatMulAddNet, self).__init__()
+        np.random.seed(1)
+        self.matmul = P.MatMul()
+        self.add = P.TensorAdd()
+        self.w = Parameter(Tensor(np.random.randn(IN_CHANNELS, OUT_CHANNELS).astype(np.float32)), name='w')
+        self.b = Parameter(Tensor(np.random.randn(OUT_CHANNELS).astype(np.float32)), name='b')
+
+    def construct(self, x_):
+        return self.add(self.matmul(x_, self.w), self.b)
+
+
+def export_batch_model():
+    net = MatMulAddNet()
+    x = np.ones([BATCH_SIZE, IN_CHANNELS]).astype(np.float32)
+    export(net, Tensor(x), file_name='batch.pb', file_format='BINARY')
+
+
+if __name__ == '__main__':
+    export_batch_model()
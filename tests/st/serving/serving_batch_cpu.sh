@@ -0,0 +1,92 @@
+#!/bin/bash
+
+export GLOG_v=1
+
+MINDSPORE_INSTALL_PATH=$1
+CURRPATH=$(cd $(dirname $0); pwd)
+cd ${CURRPATH}
+CURRUSER=$(whoami)
+echo "MINDSPORE_INSTALL_PATH:"  ${MINDSPORE_INSTALL_PATH}
+echo "CURRPATH:"  ${CURRPATH}
+
+MODEL_PATH=${CURRPATH}/model
+export LD_LIBRARY_PATH=${MINDSPORE_INSTALL_PATH}/lib:/usr/local/python/python375/lib/:${LD_LIBRARY_PATH}
+export PYTHONPATH=${MINDSPORE_INSTALL_PATH}/../:${PYTHONPATH}
+
+clean_pid()
+{
+  ps aux | grep 'ms_serving' | grep ${CURRUSER} | grep -v grep | awk '{print $2}' | xargs kill -15
+  if [ $? -ne 0 ]
+  then
+    echo "clean pip failed"
+  fi
+  sleep 6
+}
+
+prepare_model()
+{
+  echo "### begin to generate mode for serving batch test ###"
+  python3 generate_batch_model.py &> generate_batch_model_serving.log
+  echo "### end to generate mode for serving batch test ###"
+  if [ ! -f batch.pb ]
+  then
+    cat generate_batch_model_serving.log
+    echo "### generate model for serving batch test failed ###" && exit 1
+  fi
+  rm -rf model
+  mkdir model
+  mv batch.pb ${CURRPATH}/model
+  cp ${MINDSPORE_INSTALL_PATH}/ms_serving ./
+}
+
+start_service()
+{
+  ${CURRPATH}/ms_serving --port=5500 --model_path=${MODEL_PATH} --model_name=batch.pb --device_type=CPU \
+    --instance_count=2 --max_batch_size=4 --max_queue_delay_us=2000000 > batch_service.log 2>&1 &
+  if [ $? -ne 0 ]
+  then
+    echo "batch.pb faile to start."
+  fi
+
+  result=`grep -E 'MS Serving listening on 0.0.0.0:5500' batch_service.log | wc -l`
+  count=0
+  while [[ ${result} -ne 1 && ${count} -lt 150 ]]
+  do
+    sleep 1
+    count=$(($count+1))
+    result=`grep -E 'MS Serving listening on 0.0.0.0:5500' batch_service.log | wc -l`
+  done
+
+  if [ ${count} -eq 150 ]
+  then
+    clean_pid
+    cat batch_service.log
+    echo "start serving service failed!" && exit 1
+  fi
+  echo "### start serving service end ###"
+}
+
+pytest_serving()
+{
+  unset http_proxy https_proxy
+  echo "### test_batch_cpu client start ###"
+  python3 -m pytest -v -s client_batch_example.py::test_batch_cpu > test_batch_cpu_client.log 2>&1
+  ret=$?
+  if [ ${ret} -ne 0 ]
+  then
+    cat test_batch_cpu_client.log
+    cat batch_service.log
+    echo "client test_batch_cpu failed."
+  fi
+  echo "### test_batch_cpu client end ###"
+  return ${ret}
+}
+
+echo "-----serving batch cpu start-----"
+rm -rf ms_serving *.log *.pb ${CURRPATH}/model
+prepare_model
+start_service
+pytest_serving
+ret=$?
+clean_pid
+exit ${ret}
@@ -35,5 +35,21 @@ def test_serving():
     ret = os.system(f"sh {sh_path}/serving.sh {folders[0].split('mindspore', 1)[0] + 'mindspore'}")
     assert np.allclose(ret, 0, 0.0001, 0.0001)
 
+@pytest.mark.level0
+@pytest.mark.platform_x86_cpu
+@pytest.mark.env_onecard
+def test_serving_batch_cpu():
+    """test_serving_batch_cpu"""
+    sh_path = os.path.split(os.path.realpath(__file__))[0]
+    folders = []
+    for python_path in sys.path:
+        if not os.path.isdir(python_path):
+            continue
+        folders += [os.path.join(python_path, x) for x in os.listdir(python_path) \
+                if os.path.isdir(os.path.join(python_path, x)) and \
+                '/site-packages/mindspore' in os.path.join(python_path, x)]
+    ret = os.system(f"sh {sh_path}/serving_batch_cpu.sh {folders[0].split('mindspore', 1)[0] + 'mindspore'}")
+    assert np.allclose(ret, 0, 0.0001, 0.0001)
+
 if __name__ == '__main__':
     test_serving()
@@ -51,9 +51,11 @@ class SummaryReader:
         return False
 
     def read_event(self):
-        """Read next event."""
+        """Read next event, return None at the end of the file."""
         file_handler = self._file_handler
         header = file_handler.read(_HEADER_SIZE)
+        if not header:
+            return None
         data_len = struct.unpack('Q', header)[0]
         # Ignore crc check.
         file_handler.read(_HEADER_CRC_SIZE)
@@ -0,0 +1,71 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+#include "common/common_test.h"
+#include "common/thread_pool.h"
+
+namespace mindspore {
+namespace common {
+class ThreadPoolTest : public UT::Common {
+ public:
+  ThreadPoolTest() = default;
+  void SetUp() override {}
+  void TearDown() override {}
+};
+
+TEST_F(ThreadPoolTest, sync_run_all_tasks) {
+  ThreadPool pool(4);
+  std::vector<int> results(100, 0);
+  std::vector<Task> tasks;
+  for (size_t i = 0; i < results.size(); i++) {
+    tasks.emplace_back([&results, i] { results[i] = static_cast<int>(i) * 2; });
+  }
+  pool.SyncRun(tasks);
+  for (size_t i = 0; i < results.size(); i++) {
+    EXPECT_EQ(results[i], static_cast<int>(i) * 2);
+  }
+}
+
+TEST_F(ThreadPoolTest, nested_sync_run) {
+  ThreadPool pool(2);
+  std::atomic<int> count{0};
+  std::vector<Task> tasks;
+  for (int i = 0; i < 4; i++) {
+    tasks.emplace_back([&pool, &count] {
+      std::vector<Task> inner_tasks(4, [&count] { count++; });
+      pool.SyncRun(inner_tasks);
+    });
+  }
+  pool.SyncRun(tasks);
+  EXPECT_EQ(count.load(), 16);
+}
+
+TEST_F(ThreadPoolTest, rethrow_task_exception) {
+  ThreadPool pool(2);
+  std::atomic<int> count{0};
+  std::vector<Task> tasks;
+  tasks.emplace_back([] { throw std::runtime_error("task failed"); });
+  for (int i = 0; i < 8; i++) {
+    tasks.emplace_back([&count] { count++; });
+  }
+  EXPECT_THROW(pool.SyncRun(tasks), std::runtime_error);
+  EXPECT_EQ(count.load(), 8);
+}
+}  // namespace common
+}  // namespace mindspore
@@ -20,6 +20,7 @@
 #include <vector>
 #include <chrono>
 #include <thread>
+#include <atomic>
 
 
 #include "common/common.h"
@@ -124,6 +125,40 @@ TEST_F(MindDataTestConnector, Test2) {
 
 
 
+// Unordered connector: every element pushed by any producer is popped once by some consumer.
+TEST_F(MindDataTestConnector, TestUnordered) {
+  MS_LOG(INFO) << "MindDataTestConnector TestUnordered.";
+  const int num_producers = 4;
+  const int num_consumers = 3;
+  const uint32_t num_elements = 3000;
+  Connector<uint32_t> conn(num_producers, num_consumers, 2, false);
+  std::vector<std::atomic<int>> popped(num_elements);
+  std::vector<std::thread> workers;
+  for (int p = 0; p < num_producers; p++) {
+    workers.emplace_back([&conn, p]() {
+      for (uint32_t i = p; i < num_elements; i += num_producers) {
+        EXPECT_TRUE(conn.Push(p, i).IsOk());
+      }
+    });
+  }
+  for (int c = 0; c < num_consumers; c++) {
+    workers.emplace_back([&conn, &popped, c]() {
+      for (uint32_t i = c; i < num_elements; i += num_consumers) {
+        uint32_t v = 0;
+        EXPECT_TRUE(conn.Pop(c, &v).IsOk());
+        popped[v]++;
+      }
+    });
+  }
+  for (auto &worker : workers) {
+    worker.join();
+  }
+  for (uint32_t i = 0; i < num_elements; i++) {
+    ASSERT_EQ(popped[i].load(), 1);
+  }
+  ASSERT_EQ(conn.out_buffers_count(), num_elements);
+}
+
 // Implementation of MindDataTestConnector class and the helper functions.
 MindDataTestConnector::MindDataTestConnector() : tg_(new TaskGroup()) {
   last_input_ = 150;
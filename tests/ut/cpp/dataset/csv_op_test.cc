@@ -13,8 +13,11 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include <cstdio>
+#include <fstream>
 #include <iostream>
 #include <memory>
+#include <string>
 #include <vector>
 
 #include "minddata/dataset/core/client.h"
@@ -120,3 +123,58 @@ TEST_F(MindDataTestCSVOp, TestTotalRows) {
   ASSERT_EQ(total_rows, 8);
   files.clear();
 }
+
+TEST_F(MindDataTestCSVOp, TestCSVChunks) {
+  // A single file whose quoted fields hold line breaks, split into chunks of 8KB which are read by 4 workers.
+  std::string file = "./csv_chunks.csv";
+  const int64_t num_rows = 6000;
+  {
+    std::ofstream handle(file);
+    handle << "id,text\n";
+    for (int64_t i = 0; i < num_rows; ++i) {
+      handle << i << ",\"a\nb\"\n";
+    }
+  }
+
+  auto tree = std::make_shared<ExecutionTree>();
+  std::vector<std::shared_ptr<CsvOp::BaseRecord>> column_default_list;
+  column_default_list.push_back(std::make_shared<CsvOp::Record<int>>(CsvOp::INT, 0));
+  column_default_list.push_back(std::make_shared<CsvOp::Record<std::string>>(CsvOp::STRING, ""));
+  std::shared_ptr<CsvOp> op;
+  CsvOp::Builder builder;
+  builder.SetCsvFilesList({file})
+    .SetRowsPerBuffer(16)
+    .SetNumWorkers(4)
+    .SetShuffleFiles(false)
+    .SetFieldDelim(',')
+    .SetColumDefault(column_default_list)
+    .SetChunkSize(8 * 1024);
+  ASSERT_TRUE(builder.Build(&op).IsOk());
+  ASSERT_EQ(op->num_workers(), 4);
+  ASSERT_TRUE(tree->AssociateNode(op).IsOk());
+  ASSERT_TRUE(tree->AssignRoot(op).IsOk());
+  ASSERT_TRUE(tree->Prepare().IsOk());
+  ASSERT_TRUE(tree->Launch().IsOk());
+
+  DatasetIterator di(tree);
+  TensorRow tensor_list;
+  ASSERT_TRUE(di.FetchNextTensorRow(&tensor_list).IsOk());
+  std::vector<int32_t> read_times(num_rows, 0);
+  int64_t row_count = 0;
+  while (!tensor_list.empty()) {
+    int32_t id = 0;
+    std::string_view text;
+    ASSERT_TRUE(tensor_list[0]->GetItemAt(&id, {}).IsOk());
+    ASSERT_TRUE(tensor_list[1]->GetItemAt(&text, {}).IsOk());
+    ASSERT_TRUE(id >= 0 && id < num_rows);
+    ASSERT_EQ(text, "a\nb");
+    read_times[id]++;
+    row_count++;
+    ASSERT_TRUE(di.FetchNextTensorRow(&tensor_list).IsOk());
+  }
+  ASSERT_EQ(row_count, num_rows);
+  for (int64_t i = 0; i < num_rows; ++i) {
+    ASSERT_EQ(read_times[i], 1);
+  }
+  ASSERT_EQ(remove(file.c_str()), 0);
+}
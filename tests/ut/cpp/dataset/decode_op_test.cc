@@ -17,6 +17,7 @@
 #include "common/common.h"
 #include "common/cvop_common.h"
 #include "minddata/dataset/kernels/image/decode_op.h"
+#include "minddata/dataset/kernels/image/image_utils.h"
 #include "utils/log_adapter.h"
 
 using namespace mindspore::dataset;
@@ -38,3 +39,25 @@ TEST_F(MindDataTestDecodeOp, TestOp) {
 
   CheckImageShapeAndData(output_tensor, kDecode);
 }
+
+TEST_F(MindDataTestDecodeOp, TestOpSizeHint) {
+  MS_LOG(INFO) << "Doing testDecodeSizeHint";
+  EXPECT_EQ(JpegScaleDenom(3000, 4000, 224, 224), 8);
+  EXPECT_EQ(JpegScaleDenom(3000, 4000, 500, 0), 4);
+  EXPECT_EQ(JpegScaleDenom(3000, 4000, 2000, 2000), 1);
+  EXPECT_EQ(JpegScaleDenom(3000, 4000, 0, 0), 1);
+
+  std::shared_ptr<Tensor> full_tensor;
+  DecodeOp op(true);
+  EXPECT_TRUE(op.Compute(raw_input_tensor_, &full_tensor).IsOk());
+  int64_t height = full_tensor->shape()[0];
+  int64_t width = full_tensor->shape()[1];
+
+  // A resize to a quarter of the image lets the decode scale it by 1/4, it still covers the resized image.
+  std::shared_ptr<Tensor> output_tensor;
+  op.set_size_hint(height / 4, width / 4);
+  EXPECT_TRUE(op.Compute(raw_input_tensor_, &output_tensor).IsOk());
+  EXPECT_EQ(output_tensor->shape()[0], (height + 3) / 4);
+  EXPECT_EQ(output_tensor->shape()[1], (width + 3) / 4);
+  EXPECT_EQ(output_tensor->shape()[2], 3);
+}
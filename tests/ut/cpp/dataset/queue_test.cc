@@ -21,6 +21,8 @@
 #include <atomic>
 #include <chrono>
 #include <random>
+#include <thread>
+#include <vector>
 #include "utils/log_adapter.h"
 
 using namespace mindspore::dataset;
@@ -236,3 +238,61 @@ TEST_F(MindDataTestQueue, TestPerf) {
 //  std::cin >> fs;
   Fuzz<Queue<std::vector<int>>, std::vector<int>>(fs, 1, "New queue");
 }
+
+// Runs num_elements through a queue of the given capacity with many producers and consumers, checks that every
+// element comes out once and returns the nanoseconds per element.
+int64_t MultiProducerConsumer(int num_producers, int num_consumers, int64_t num_elements, int capacity) {
+  Queue<std::unique_ptr<int64_t>> que(capacity);
+  std::atomic<int64_t> sum(0);
+  std::vector<std::thread> workers;
+  auto t0 = high_resolution_clock::now();
+  for (int p = 0; p < num_producers; p++) {
+    workers.emplace_back([&que, p, num_producers, num_elements]() {
+      for (int64_t i = p; i < num_elements; i += num_producers) {
+        EXPECT_TRUE(que.Add(std::make_unique<int64_t>(i)).IsOk());
+      }
+    });
+  }
+  for (int c = 0; c < num_consumers; c++) {
+    int64_t num_pops = num_elements / num_consumers + (c == 0 ? num_elements % num_consumers : 0);
+    workers.emplace_back([&que, &sum, num_pops]() {
+      int64_t local_sum = 0;
+      for (int64_t i = 0; i < num_pops; i++) {
+        std::unique_ptr<int64_t> v;
+        EXPECT_TRUE(que.PopFront(&v).IsOk());
+        local_sum += *v;
+      }
+      sum += local_sum;
+    });
+  }
+  for (auto &worker : workers) {
+    worker.join();
+  }
+  auto cost = duration_cast<nanoseconds>(high_resolution_clock::now() - t0).count() / num_elements;
+  EXPECT_EQ(sum.load(), num_elements * (num_elements - 1) / 2);
+  EXPECT_TRUE(que.empty());
+  return cost;
+}
+
+// Many producers and consumers on one small queue, checks that every element comes out once.
+TEST_F(MindDataTestQueue, TestMultiProducerConsumer) {
+  for (auto threads : std::vector<std::pair<int, int>>{{1, 1}, {4, 1}, {1, 4}, {4, 4}}) {
+    (void)MultiProducerConsumer(threads.first, threads.second, 10000, 4);
+  }
+}
+
+// Microbenchmark of the queue, reports the cost of an element for each number of producers and consumers.
+// Disabled by default, run it with --gtest_also_run_disabled_tests --gtest_filter=*TestMultiProducerConsumerPerf.
+TEST_F(MindDataTestQueue, DISABLED_TestMultiProducerConsumerPerf) {
+  const int64_t num_elements = 2000000;
+  for (auto threads : std::vector<std::pair<int, int>>{{1, 1}, {4, 1}, {1, 4}, {8, 8}, {32, 1}, {32, 32}}) {
+    auto cost = MultiProducerConsumer(threads.first, threads.second, num_elements, 16);
+    std::cout << threads.first << " producers and " << threads.second << " consumers: " << cost
+              << " ns per element." << std::endl;
+  }
+}
+
+TEST_F(MindDataTestQueue, TestZeroCapacity) {
+  EXPECT_ANY_THROW(Queue<int>(0));
+  EXPECT_ANY_THROW(Queue<int>(-1));
+}
@@ -14,11 +14,14 @@
  * limitations under the License.
  */
 #include "minddata/dataset/core/client.h"
+#include "minddata/dataset/util/path.h"
 #include "common/common.h"
 #include "utils/ms_utils.h"
 #include "gtest/gtest.h"
 #include "utils/log_adapter.h"
+#include <algorithm>
 #include <memory>
+#include <string>
 #include <vector>
 #include <iostream>
 
@@ -29,8 +32,28 @@ using mindspore::MsLogLevel::INFO;
 using mindspore::ExceptionType::NoExceptionType;
 using mindspore::LogStream;
 
-class MindDataTestShuffleOp : public UT::DatasetOpTesting {
+// Remove a file, or a directory with everything below it.
+static void RemoveTree(Path *path) {
+  if (path->IsDirectory()) {
+    auto dir_it = Path::DirIterator::OpenDirectory(path);
+    while (dir_it != nullptr && dir_it->hasNext()) {
+      Path child = dir_it->next();
+      RemoveTree(&child);
+    }
+  }
+  EXPECT_TRUE(path->Remove().IsOk());
+}
 
+class MindDataTestShuffleOp : public UT::DatasetOpTesting {
+ protected:
+  // The spill directories of this test and of test_shuffle.py.
+  void TearDown() override {
+    for (auto dir : {"./shuffle_spill_test", "./shuffle_parallel_spill"}) {
+      Path path(dir);
+      RemoveTree(&path);
+    }
+    UT::DatasetOpTesting::TearDown();
+  }
 };
 
 
@@ -333,3 +356,88 @@ TEST_F(MindDataTestShuffleOp, TestRepeatShuffle) {
   }
   ASSERT_EQ(row_count, 20);
 }
+
+// Runs a shuffle with sub-buffers over testDataset1, and returns the rows printed as strings.
+static std::vector<std::string> RunShardedShuffle(const std::string &dataset_path, int64_t buffer_bytes,
+                                                  const std::string &spill_dir) {
+  auto my_tree = std::make_shared<ExecutionTree>();
+  std::shared_ptr<TFReaderOp> my_tfreader_op;
+  Status rc = TFReaderOp::Builder()
+      .SetDatasetFilesList({dataset_path})
+      .SetRowsPerBuffer(2)
+      .SetWorkerConnectorSize(16)
+      .SetNumWorkers(1)
+      .Build(&my_tfreader_op);
+  EXPECT_TRUE(rc.IsOk());
+  rc = my_tree->AssociateNode(my_tfreader_op);
+  EXPECT_TRUE(rc.IsOk());
+  std::shared_ptr<ShuffleOp> my_shuffle_op;
+  rc = ShuffleOp::Builder()
+      .SetShuffleSize(6)
+      .SetShuffleSeed(5)
+      .SetRowsPerBuffer(2)
+      .SetNumWorkers(3)
+      .SetBufferBytes(buffer_bytes)
+      .SetSpillDir(spill_dir)
+      .Build(&my_shuffle_op);
+  EXPECT_TRUE(rc.IsOk());
+  rc = my_tree->AssociateNode(my_shuffle_op);
+  EXPECT_TRUE(rc.IsOk());
+  rc = my_shuffle_op->AddChild(my_tfreader_op);
+  EXPECT_TRUE(rc.IsOk());
+  rc = my_tree->AssignRoot(my_shuffle_op);
+  EXPECT_TRUE(rc.IsOk());
+  rc = my_tree->Prepare();
+  EXPECT_TRUE(rc.IsOk());
+  rc = my_tree->Launch();
+  EXPECT_TRUE(rc.IsOk());
+
+  std::vector<std::string> rows;
+  DatasetIterator di(my_tree);
+  TensorRow tensor_list;
+  rc = di.FetchNextTensorRow(&tensor_list);
+  EXPECT_TRUE(rc.IsOk());
+  while (!tensor_list.empty()) {
+    std::ostringstream ss;
+    for (int i = 0; i < tensor_list.size(); i++) {
+      ss << *tensor_list[i] << ";";
+    }
+    rows.push_back(ss.str());
+    rc = di.FetchNextTensorRow(&tensor_list);
+    EXPECT_TRUE(rc.IsOk());
+  }
+  return rows;
+}
+
+// Test info:
+// - Dataset from testDataset1 has 10 rows, 2 columns.
+// - Three sub-buffers shuffle in parallel, the order only depends on the seed.
+// - A memory budget smaller than a row spills the rows, which come back unchanged, and the spill files are removed.
+//
+// Tree: shuffle over TFReader
+//
+//    ShuffleOp
+//       |
+//    TFReaderOp
+//
+TEST_F(MindDataTestShuffleOp, TestShardedShuffle) {
+  MS_LOG(INFO) << "UT test TestShardedShuffle.";
+  std::string dataset_path = datasets_root_path_ + "/testDataset1/testDataset1.data";
+
+  std::vector<std::string> rows = RunShardedShuffle(dataset_path, 0, "");
+  ASSERT_EQ(rows.size(), 10);
+  EXPECT_EQ(RunShardedShuffle(dataset_path, 0, ""), rows);
+
+  std::string spill_dir = "./shuffle_spill_test";
+  std::vector<std::string> spilled_rows = RunShardedShuffle(dataset_path, 3, spill_dir);
+  ASSERT_EQ(spilled_rows.size(), 10);
+  EXPECT_EQ(RunShardedShuffle(dataset_path, 3, spill_dir), spilled_rows);
+  // The spill directories of the sub-buffers are removed at the end of the epoch
+  Path spill_path(spill_dir);
+  auto dir_it = Path::DirIterator::OpenDirectory(&spill_path);
+  ASSERT_NE(dir_it, nullptr);
+  EXPECT_FALSE(dir_it->hasNext());
+  std::sort(rows.begin(), rows.end());
+  std::sort(spilled_rows.begin(), spilled_rows.end());
+  EXPECT_EQ(spilled_rows, rows);
+}
@@ -14,6 +14,8 @@
  * limitations under the License.
  */
 
+#include <set>
+
 #include "common/common.h"
 #include "minddata/dataset/core/client.h"
 #include "minddata/dataset/core/global_context.h"
@@ -21,6 +23,7 @@
 #include "minddata/dataset/engine/datasetops/source/sampler/random_sampler.h"
 #include "minddata/dataset/engine/datasetops/source/sampler/sampler.h"
 #include "minddata/dataset/engine/datasetops/source/sampler/sequential_sampler.h"
+#include "minddata/dataset/util/random_permutation.h"
 #include "minddata/dataset/util/status.h"
 #include "gtest/gtest.h"
 #include "utils/log_adapter.h"
@@ -99,3 +102,57 @@ TEST_F(MindDataTestStandAloneSampler, TestStandAoneSequentialSampler) {
   db->GetTensor(&tensor, 0, 0);
   EXPECT_TRUE((*tensor) == (*label2));
 }
+
+TEST_F(MindDataTestStandAloneSampler, TestRandomPermutation) {
+  int64_t size = kShuffleVectorMaxRows + 3;
+  RandomPermutation permutation(size, 5);
+  std::vector<bool> seen(size, false);
+  for (int64_t i = 0; i < size; i++) {
+    int64_t id = permutation(i);
+    ASSERT_TRUE(id >= 0 && id < size);
+    ASSERT_FALSE(seen[id]);
+    seen[id] = true;
+  }
+  int64_t same_num = 0;
+  RandomPermutation reseeded(size, 6);
+  for (int64_t i = 0; i < 1000; i++) {
+    same_num += (permutation(i) == reseeded(i));
+  }
+  EXPECT_LT(same_num, 10);
+}
+
+TEST_F(MindDataTestStandAloneSampler, TestPermutationSamplers) {
+  // Too many rows for a shuffled id vector, the samplers draw from a RandomPermutation instead.
+  int64_t num_rows = kShuffleVectorMaxRows * 4;
+  int64_t num_samples = 1000;
+  MockStorageOp mock(num_rows);
+  std::unique_ptr<DataBuffer> db;
+  std::shared_ptr<Tensor> tensor;
+  std::set<int64_t> ids;
+  std::shared_ptr<Sampler> sampler = std::make_shared<RandomSampler>(num_samples, false, true);
+  sampler->HandshakeRandomAccessOp(&mock);
+  for (int epoch = 0; epoch < 2; epoch++) {
+    sampler->GetNextSample(&db);
+    db->GetTensor(&tensor, 0, 0);
+    for (auto it = tensor->begin<int64_t>(); it != tensor->end<int64_t>(); ++it) {
+      EXPECT_TRUE(*it >= 0 && *it < num_rows);
+      ids.insert(*it);
+    }
+    sampler->GetNextSample(&db);
+    EXPECT_TRUE(db->eoe());
+    sampler->ResetSampler();
+  }
+  // Unique within an epoch, and a new order in the next one.
+  EXPECT_GT(ids.size(), static_cast<size_t>(num_samples * 3 / 2));
+
+  // The shards of a distributed sampler do not overlap.
+  ids.clear();
+  for (int64_t shard = 0; shard < 4; shard++) {
+    sampler = std::make_shared<DistributedSampler>(num_samples, 4, shard, true, 1);
+    sampler->HandshakeRandomAccessOp(&mock);
+    sampler->GetNextSample(&db);
+    db->GetTensor(&tensor, 0, 0);
+    ids.insert(tensor->begin<int64_t>(), tensor->end<int64_t>());
+  }
+  EXPECT_EQ(ids.size(), static_cast<size_t>(4 * num_samples));
+}
@@ -0,0 +1,160 @@
+/**
+ * Copyright 2026 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <memory>
+#include <future>
+#include <thread>
+#include <vector>
+#include "common/common.h"
+#include "minddata/dataset/core/global_context.h"
+#include "minddata/dataset/core/tensor.h"
+#include "minddata/dataset/util/task_manager.h"
+#include "minddata/dataset/util/tensor_pool.h"
+#include "utils/log_adapter.h"
+
+using namespace mindspore::dataset;
+
+class MindDataTestTensorPool : public UT::Common {
+ public:
+  MindDataTestTensorPool() {}
+};
+
+TEST_F(MindDataTestTensorPool, TestSizeClass) {
+  for (size_t n = 1; n <= (static_cast<size_t>(1) << TensorPool::kMaxClassShift); n = n * 9 / 8 + 1) {
+    int size_class = TensorPool::SizeToClass(n);
+    ASSERT_GE(size_class, 0);
+    ASSERT_LT(size_class, TensorPool::kNumClasses);
+    // The smallest class which fits, and at most a quarter is wasted.
+    ASSERT_GE(TensorPool::ClassToSize(size_class), n);
+    if (size_class > 0) {
+      ASSERT_LT(TensorPool::ClassToSize(size_class - 1), n);
+      ASSERT_LE(TensorPool::ClassToSize(size_class) * 4, n * 5 + 4);
+    }
+  }
+  ASSERT_EQ(TensorPool::SizeToClass((static_cast<size_t>(1) << TensorPool::kMaxClassShift) + 1), -1);
+}
+
+TEST_F(MindDataTestTensorPool, TestCrossThreadReuse) {
+  std::shared_ptr<TensorPool> pool;
+  ASSERT_TRUE(TensorPool::CreateTensorPool(&pool, 64).IsOk());
+  std::vector<void *> v;
+  for (int i = 0; i < 1000; i++) {
+    void *p = nullptr;
+    ASSERT_TRUE(pool->Allocate(1000 + i, &p).IsOk());
+    v.push_back(p);
+  }
+  // Another thread frees the blocks, they go back to this pool when the thread exits.
+  std::thread consumer([&pool, &v]() {
+    for (auto p : v) {
+      pool->Deallocate(p);
+    }
+  });
+  consumer.join();
+  TensorPool::Stats stats = pool->GetStats();
+  ASSERT_EQ(stats.in_use_bytes, static_cast<uint64_t>(0));
+  ASSERT_EQ(stats.idle_bytes, stats.arena_bytes);
+  uint64_t arena_bytes = stats.arena_bytes;
+
+  // The second round is served by the idle blocks, the arena does not grow.
+  for (int i = 0; i < 1000; i++) {
+    void *p = nullptr;
+    ASSERT_TRUE(pool->Allocate(1000 + i, &p).IsOk());
+    v[i] = p;
+  }
+  stats = pool->GetStats();
+  ASSERT_EQ(stats.arena_bytes, arena_bytes);
+  ASSERT_EQ(stats.idle_bytes, static_cast<uint64_t>(0));
+  ASSERT_EQ(stats.num_system_alloc, static_cast<uint64_t>(0));
+  MS_LOG(INFO) << "Cache hits: " << stats.num_cache_hit << ", central hits: " << stats.num_central_hit << ".";
+  for (auto p : v) {
+    pool->Deallocate(p);
+  }
+}
+
+TEST_F(MindDataTestTensorPool, TestCap) {
+  std::shared_ptr<TensorPool> pool;
+  ASSERT_TRUE(TensorPool::CreateTensorPool(&pool, 16).IsOk());
+  std::vector<void *> v;
+  for (int i = 0; i < 4; i++) {
+    void *p = nullptr;
+    ASSERT_TRUE(pool->Allocate(5 << 20, &p).IsOk());
+    v.push_back(p);
+  }
+  // The fourth buffer does not fit into the arena and comes from the system.
+  TensorPool::Stats stats = pool->GetStats();
+  ASSERT_EQ(stats.num_system_alloc, static_cast<uint64_t>(1));
+  ASSERT_LE(stats.arena_bytes, static_cast<uint64_t>(16 << 20));
+  for (auto p : v) {
+    pool->Deallocate(p);
+  }
+  stats = pool->GetStats();
+  ASSERT_EQ(stats.system_bytes, static_cast<uint64_t>(0));
+  ASSERT_EQ(stats.in_use_bytes, static_cast<uint64_t>(0));
+}
+
+TEST_F(MindDataTestTensorPool, TestFlushOtherThreadCaches) {
+  std::shared_ptr<TensorPool> pool;
+  ASSERT_TRUE(TensorPool::CreateTensorPool(&pool, 16).IsOk());
+  std::vector<void *> v;
+  for (int i = 0; i < 3; i++) {
+    void *p = nullptr;
+    ASSERT_TRUE(pool->Allocate(5 << 20, &p).IsOk());
+    v.push_back(p);
+  }
+  // A live thread keeps a freed block in its cache, next to the free end of the arena.
+  std::promise<void> cached;
+  std::promise<void> done;
+  std::thread worker([&pool, &cached, &done]() {
+    void *p = nullptr;
+    EXPECT_TRUE(pool->Allocate(512 << 10, &p).IsOk());
+    pool->Deallocate(p);
+    cached.set_value();
+    done.get_future().wait();
+  });
+  cached.get_future().wait();
+  // The rest of the arena is too small, the block only fits once the cache of the worker is flushed.
+  void *p = nullptr;
+  ASSERT_TRUE(pool->Allocate(768 << 10, &p).IsOk());
+  v.push_back(p);
+  done.set_value();
+  worker.join();
+  TensorPool::Stats stats = pool->GetStats();
+  ASSERT_EQ(stats.num_system_alloc, static_cast<uint64_t>(0));
+  ASSERT_EQ(stats.idle_bytes, static_cast<uint64_t>(0));
+  for (auto q : v) {
+    pool->Deallocate(q);
+  }
+}
+
+TEST_F(MindDataTestTensorPool, TestTaskGroupPool) {
+  std::shared_ptr<TensorPool> pool;
+  ASSERT_TRUE(TensorPool::CreateTensorPool(&pool, 64).IsOk());
+  TaskGroup vg;
+  vg.SetMemoryPool(pool);
+  std::shared_ptr<Tensor> t;
+  Status rc = vg.CreateAsyncTask("Tensor pool test", [&t]() -> Status {
+    RETURN_IF_NOT_OK(Tensor::CreateEmpty(TensorShape({224, 224, 3}), DataType(DataType::DE_UINT8), &t));
+    return Status::OK();
+  });
+  ASSERT_TRUE(rc.IsOk());
+  ASSERT_TRUE(vg.join_all().IsOk());
+  ASSERT_TRUE(vg.GetTaskErrorIfAny().IsOk());
+  // The tensor of the task comes from the pool of its group, and the buffer goes back to it with the tensor.
+  ASSERT_GE(pool->GetStats().in_use_bytes, static_cast<uint64_t>(224 * 224 * 3));
+  t.reset();
+  ASSERT_EQ(pool->GetStats().in_use_bytes, static_cast<uint64_t>(0));
+  // Outside of the group the tensors come from the global pool.
+  ASSERT_EQ(GlobalContext::Instance()->tensor_data_pool(), GlobalContext::Instance()->mem_pool());
+}
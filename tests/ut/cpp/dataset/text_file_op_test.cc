@@ -13,8 +13,11 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include <cstdio>
+#include <fstream>
 #include <iostream>
 #include <memory>
+#include <string>
 #include <vector>
 
 #include "minddata/dataset/core/client.h"
@@ -110,3 +113,57 @@ TEST_F(MindDataTestTextFileOp, TestTotalRows) {
   ASSERT_EQ(total_rows, 5);
   files.clear();
 }
+
+TEST_F(MindDataTestTextFileOp, TestTextFileChunks) {
+  // A single file of 10000 rows split into chunks of 16KB, which are read by 4 workers.
+  std::string file = "./text_file_chunks.txt";
+  const int64_t num_rows = 10000;
+  {
+    std::ofstream handle(file);
+    for (int64_t i = 0; i < num_rows; ++i) {
+      handle << "row " << i << "\n\n";
+    }
+  }
+
+  const int32_t num_devices = 3;
+  std::vector<int32_t> read_times(num_rows, 0);
+  for (int32_t device_id = 0; device_id < num_devices; ++device_id) {
+    auto tree = std::make_shared<ExecutionTree>();
+    std::shared_ptr<TextFileOp> op;
+    TextFileOp::Builder builder;
+    builder.SetTextFilesList({file})
+      .SetRowsPerBuffer(16)
+      .SetNumWorkers(4)
+      .SetNumDevices(num_devices)
+      .SetDeviceId(device_id)
+      .SetChunkSize(16 * 1024);
+    ASSERT_TRUE(builder.Build(&op).IsOk());
+    ASSERT_EQ(op->num_workers(), 4);
+    ASSERT_TRUE(tree->AssociateNode(op).IsOk());
+    ASSERT_TRUE(tree->AssignRoot(op).IsOk());
+    ASSERT_TRUE(tree->Prepare().IsOk());
+    ASSERT_TRUE(tree->Launch().IsOk());
+
+    DatasetIterator di(tree);
+    TensorRow tensor_list;
+    ASSERT_TRUE(di.FetchNextTensorRow(&tensor_list).IsOk());
+    int64_t row_count = 0;
+    while (!tensor_list.empty()) {
+      std::string_view line;
+      ASSERT_TRUE(tensor_list[0]->GetItemAt(&line, {}).IsOk());
+      int64_t row = std::stoll(std::string(line.substr(4)));
+      ASSERT_TRUE(row >= 0 && row < num_rows);
+      read_times[row]++;
+      row_count++;
+      ASSERT_TRUE(di.FetchNextTensorRow(&tensor_list).IsOk());
+    }
+    // Each shard takes ceil(10000 / 3) rows, the last one wraps around to the first rows.
+    ASSERT_EQ(row_count, 3334);
+  }
+  ASSERT_EQ(read_times[0], 2);
+  ASSERT_EQ(read_times[1], 2);
+  for (int64_t i = 2; i < num_rows; ++i) {
+    ASSERT_EQ(read_times[i], 1);
+  }
+  ASSERT_EQ(remove(file.c_str()), 0);
+}
@@ -0,0 +1,182 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+#include "common/common.h"
+#include "gtest/gtest.h"
+#include "minddata/dataset/core/config_manager.h"
+#include "minddata/dataset/core/global_context.h"
+#include "minddata/dataset/engine/datasetops/source/text_row_index.h"
+#include "minddata/dataset/util/path.h"
+#include "utils/log_adapter.h"
+
+using namespace mindspore::dataset;
+
+class MindDataTestTextRowIndex : public UT::Common {
+ public:
+  // Writes the content to the file and returns the offset of the first byte of each row.
+  std::vector<int64_t> WriteFile(const std::string &file, const std::string &header, int64_t num_rows,
+                                 const std::string &row) {
+    std::ofstream handle(file, std::ios::binary);
+    handle << header;
+    std::vector<int64_t> offsets;
+    for (int64_t i = 0; i < num_rows; ++i) {
+      offsets.push_back(static_cast<int64_t>(handle.tellp()));
+      handle << i << row;
+    }
+    return offsets;
+  }
+};
+
+TEST_F(MindDataTestTextRowIndex, TestLines) {
+  std::string file = "./text_row_index_lines.txt";
+  // The empty lines are no rows.
+  auto offsets = WriteFile(file, "\n\n", 5000, "\n\n");
+  std::shared_ptr<TextRowIndex> index;
+  ASSERT_TRUE(TextRowIndex::Create(file, TextRowIndex::Format::kLine, false, 4, &index).IsOk());
+  ASSERT_EQ(index->num_rows(), 5000);
+
+  int64_t offset = 0;
+  int64_t skip = 0;
+  index->Seek(3000, &offset, &skip);
+  ASSERT_LT(skip, TextRowIndex::kRowStride);
+  ASSERT_EQ(offset, offsets[3000 - skip]);
+
+  // The ranges cover all the rows, and start at indexed rows.
+  auto ranges = index->Split(100, 5000, 8 * 1024);
+  ASSERT_GT(ranges.size(), 1);
+  ASSERT_EQ(ranges.front().first, 100);
+  ASSERT_EQ(ranges.back().second, 5000);
+  for (size_t i = 1; i < ranges.size(); ++i) {
+    ASSERT_EQ(ranges[i].first, ranges[i - 1].second);
+    index->Seek(ranges[i].first, &offset, &skip);
+    ASSERT_EQ(skip, 0);
+    ASSERT_EQ(offset, offsets[ranges[i].first]);
+  }
+  ASSERT_EQ(index->Split(100, 5000, 0).size(), 1);
+  ASSERT_EQ(remove(file.c_str()), 0);
+}
+
+TEST_F(MindDataTestTextRowIndex, TestCsv) {
+  std::string file = "./text_row_index.csv";
+  // Line breaks and double quotes within quotes are no row ends, the header is no row.
+  auto offsets = WriteFile(file, "id,text\r\n", 3000, ",\"a\"\"\nb\"\r\n");
+  std::shared_ptr<TextRowIndex> index;
+  ASSERT_TRUE(TextRowIndex::Create(file, TextRowIndex::Format::kCsv, true, 4, &index).IsOk());
+  ASSERT_EQ(index->num_rows(), 3000);
+  int64_t offset = 0;
+  int64_t skip = 0;
+  index->Seek(2500, &offset, &skip);
+  ASSERT_EQ(offset, offsets[2500 - skip]);
+
+  // Without the header the first line is a row too.
+  ASSERT_TRUE(TextRowIndex::Create(file, TextRowIndex::Format::kCsv, false, 4, &index).IsOk());
+  ASSERT_EQ(index->num_rows(), 3001);
+
+  // The last row needs no line break.
+  {
+    std::ofstream handle(file, std::ios::binary | std::ios::app);
+    handle << "3000,\"c\"";
+  }
+  ASSERT_TRUE(TextRowIndex::Create(file, TextRowIndex::Format::kCsv, true, 4, &index).IsOk());
+  ASSERT_EQ(index->num_rows(), 3001);
+  ASSERT_EQ(remove(file.c_str()), 0);
+}
+
+TEST_F(MindDataTestTextRowIndex, TestParallelScan) {
+  std::string file = "./text_row_index_parallel.csv";
+  // Over 32MB, so the file is scanned by several tasks, and the ranges start within quoted line breaks.
+  std::string row = ",\"" + std::string(100, 'a') + "\n" + std::string(100, 'b') + "\"\r\n";
+  auto offsets = WriteFile(file, "id,text\r\n", 200000, row);
+  std::shared_ptr<TextRowIndex> index;
+  ASSERT_TRUE(TextRowIndex::Create(file, TextRowIndex::Format::kCsv, true, 3, &index).IsOk());
+  ASSERT_EQ(index->num_rows(), 200000);
+  std::shared_ptr<TextRowIndex> serial;
+  ASSERT_TRUE(TextRowIndex::Create(file, TextRowIndex::Format::kCsv, true, 1, &serial).IsOk());
+  ASSERT_EQ(serial->num_rows(), 200000);
+  for (int64_t i : {0, 1, 65000, 131072, 199999, 200000}) {
+    int64_t offset = 0;
+    int64_t skip = 0;
+    index->Seek(i, &offset, &skip);
+    ASSERT_LT(skip, TextRowIndex::kRowStride);
+    if (i < 200000) {
+      ASSERT_EQ(offset, offsets[i - skip]);
+    }
+  }
+  ASSERT_EQ(remove(file.c_str()), 0);
+}
+
+TEST_F(MindDataTestTextRowIndex, TestIndexDir) {
+  std::string file = "./text_row_index_cache.txt";
+  std::string index_dir = "./text_row_index_dir";
+  WriteFile(file, "", 2000, "\n");
+  auto config_manager = GlobalContext::config_manager();
+  config_manager->set_text_index_dir(index_dir);
+
+  std::shared_ptr<TextRowIndex> index;
+  ASSERT_TRUE(TextRowIndex::Create(file, TextRowIndex::Format::kLine, false, 1, &index).IsOk());
+  ASSERT_EQ(index->num_rows(), 2000);
+  Path dir(index_dir);
+  auto dir_it = Path::DirIterator::OpenDirectory(&dir);
+  ASSERT_NE(dir_it, nullptr);
+  ASSERT_TRUE(dir_it->hasNext());
+  Path index_file = dir_it->next();
+
+  // The saved index is loaded again.
+  std::shared_ptr<TextRowIndex> cached;
+  ASSERT_TRUE(TextRowIndex::Create(file, TextRowIndex::Format::kLine, false, 1, &cached).IsOk());
+  ASSERT_EQ(cached->num_rows(), 2000);
+  int64_t offset = 0;
+  int64_t skip = 0;
+  int64_t cached_offset = 0;
+  int64_t cached_skip = 0;
+  index->Seek(1500, &offset, &skip);
+  cached->Seek(1500, &cached_offset, &cached_skip);
+  ASSERT_EQ(offset, cached_offset);
+  ASSERT_EQ(skip, cached_skip);
+
+  // A file of another size is scanned again.
+  WriteFile(file, "", 1000, "\n");
+  ASSERT_TRUE(TextRowIndex::Create(file, TextRowIndex::Format::kLine, false, 1, &cached).IsOk());
+  ASSERT_EQ(cached->num_rows(), 1000);
+
+  // A file of the same size rewritten within the same second is scanned again.
+  struct stat sb;
+  ASSERT_EQ(stat(file.c_str(), &sb), 0);
+  {
+    std::string content(sb.st_size, 'x');
+    for (size_t i = 1; i < content.size(); i += 4) {
+      content[i] = '\n';
+    }
+    std::ofstream handle(file, std::ios::binary | std::ios::trunc);
+    handle << content;
+  }
+  struct timespec times[2] = {sb.st_atim, sb.st_mtim};
+  times[1].tv_nsec = sb.st_mtim.tv_nsec > 0 ? sb.st_mtim.tv_nsec - 1 : 1;
+  ASSERT_EQ(utimensat(AT_FDCWD, file.c_str(), times, 0), 0);
+  ASSERT_TRUE(TextRowIndex::Create(file, TextRowIndex::Format::kLine, false, 1, &cached).IsOk());
+  ASSERT_EQ(cached->num_rows(), (sb.st_size + 2) / 4);
+
+  config_manager->set_text_index_dir("");
+  ASSERT_TRUE(index_file.Remove().IsOk());
+  ASSERT_TRUE(dir.Remove().IsOk());
+  ASSERT_EQ(remove(file.c_str()), 0);
+}
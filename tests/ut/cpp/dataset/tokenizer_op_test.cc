@@ -26,6 +26,7 @@
 #include "minddata/dataset/text/kernels/unicode_char_tokenizer_op.h"
 #include "minddata/dataset/text/kernels/unicode_script_tokenizer_op.h"
 #include "minddata/dataset/text/kernels/whitespace_tokenizer_op.h"
+#include "minddata/dataset/text/kernels/wordpiece_tokenizer_op.h"
 #include "gtest/gtest.h"
 #include "utils/log_adapter.h"
 
@@ -358,4 +359,58 @@ std::shared_ptr<Tensor> input;
   TensorRow output;
   Status s = basic_tokenizer->Compute(TensorRow(0, {input}), &output);
   EXPECT_TRUE(s.IsOk());
-}
\ No newline at end of file
+}
+
+TEST_F(MindDataTestTokenizerOp, TestBasicTokenizerOutput) {
+  MS_LOG(INFO) << "Doing TestBasicTokenizerOutput.";
+  std::unique_ptr<BasicTokenizerOp> basic_tokenizer(new BasicTokenizerOp(true, false, NormalizeForm::kNone, true, true));
+  std::shared_ptr<Tensor> input;
+  // The zero width space is removed by the case fold, the accent by NFD.
+  Tensor::CreateScalar<std::string>("Hello [CLS] Caf\xC3\xA9\xE2\x80\x8B [unused7]!\t\xE4\xB8\xAD", &input);
+  TensorRow output;
+  Status s = basic_tokenizer->Compute(TensorRow(0, {input}), &output);
+  EXPECT_TRUE(s.IsOk());
+  ASSERT_EQ(output.size(), 3);
+  std::vector<std::string> expect = {"hello", "[CLS]", "cafe", "[unused7]", "!", "\xE4\xB8\xAD"};
+  std::vector<uint32_t> expect_start = {0, 6, 12, 17, 26, 28};
+  std::vector<uint32_t> expect_limit = {5, 11, 16, 26, 27, 31};
+  ASSERT_EQ(output[0]->Size(), static_cast<dsize_t>(expect.size()));
+  for (dsize_t i = 0; i < static_cast<dsize_t>(expect.size()); i++) {
+    CheckEqual(output[0], {i}, expect[i]);
+    uint32_t start = 0, limit = 0;
+    EXPECT_TRUE(output[1]->GetItemAt(&start, {i}).IsOk());
+    EXPECT_TRUE(output[2]->GetItemAt(&limit, {i}).IsOk());
+    EXPECT_EQ(start, expect_start[i]);
+    EXPECT_EQ(limit, expect_limit[i]);
+  }
+}
+
+TEST_F(MindDataTestTokenizerOp, TestWordpieceTokenizer) {
+  MS_LOG(INFO) << "Doing TestWordpieceTokenizer.";
+  std::shared_ptr<Vocab> vocab = std::make_shared<Vocab>();
+  for (const auto &word : {"my", "favor", "##ite", "book", "is", "love", "##ly", "北", "##京", "[UNK]"}) {
+    vocab->append_word(word);
+  }
+  EXPECT_EQ(vocab->trie().Lookup("##ly"), vocab->Lookup("##ly"));
+  EXPECT_EQ(vocab->trie().Lookup("favorite"), Vocab::kNoTokenExists);
+  EXPECT_EQ(vocab->trie().Lookup("fav"), Vocab::kNoTokenExists);
+  std::unique_ptr<WordpieceTokenizerOp> op(new WordpieceTokenizerOp(vocab, "##", 100, "[UNK]", true));
+  std::shared_ptr<Tensor> input;
+  Tensor::CreateFromVector(std::vector<std::string>{"my", "favorite", "lovely", "北京", "booky", "favo"}, &input);
+  TensorRow output;
+  Status s = op->Compute(TensorRow(0, {input}), &output);
+  EXPECT_TRUE(s.IsOk());
+  ASSERT_EQ(output.size(), 3);
+  ASSERT_EQ(output[0]->Size(), 9);
+  std::vector<std::string> expect = {"my", "favor", "##ite", "love", "##ly", "北", "##京", "[UNK]", "[UNK]"};
+  std::vector<uint32_t> expect_start = {0, 0, 5, 0, 4, 0, 3, 0, 0};
+  std::vector<uint32_t> expect_limit = {2, 5, 8, 4, 6, 3, 6, 5, 4};
+  for (dsize_t i = 0; i < static_cast<dsize_t>(expect.size()); i++) {
+    CheckEqual(output[0], {i}, expect[i]);
+    uint32_t start = 0, limit = 0;
+    EXPECT_TRUE(output[1]->GetItemAt(&start, {i}).IsOk());
+    EXPECT_TRUE(output[2]->GetItemAt(&limit, {i}).IsOk());
+    EXPECT_EQ(start, expect_start[i]);
+    EXPECT_EQ(limit, expect_limit[i]);
+  }
+}
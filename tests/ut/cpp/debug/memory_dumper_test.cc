@@ -14,12 +14,18 @@
  * limitations under the License.
  */
 #include <fcntl.h>
+#include <fstream>
 #include <iostream>
 #include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
 #include "common/common_test.h"
 #include "./common.h"
 #include "utils/system/file_system.h"
 #include "utils/system/env.h"
+#include "utils/system/lz4.h"
+#include "debug/dump_writer.h"
 #define private public
 #include "debug/e2e_dump.h"
 #undef private
@@ -126,4 +132,67 @@ TEST_F(TestMemoryDumper, test_DumpToFileNotExistDir) {
 
   ASSERT_EQ(ret, true);
 }
+
+TEST_F(TestMemoryDumper, test_Lz4RoundTrip) {
+  std::vector<char> data(100000);
+  for (size_t i = 0; i < data.size(); i++) {
+    data[i] = static_cast<char>((i % 7 == 0) ? i % 251 : 0);
+  }
+  std::vector<char> compressed;
+  size_t size = system::Lz4::Compress(data.data(), data.size(), &compressed);
+  ASSERT_EQ(size, compressed.size());
+  ASSERT_LT(size, data.size());
+
+  std::vector<char> restored(data.size());
+  ASSERT_TRUE(system::Lz4::Decompress(compressed.data(), size, restored.data(), restored.size()));
+  ASSERT_EQ(restored, data);
+  ASSERT_FALSE(system::Lz4::Decompress(compressed.data(), size - 1, restored.data(), restored.size()));
+}
+
+TEST_F(TestMemoryDumper, test_AsyncDumpToFile) {
+  auto &writer = DumpWriter::GetInstance();
+  writer.Configure(true, true, 1024);
+  std::string dir = "./tmp/async_dump/1";
+  std::vector<std::vector<int>> tensors;
+  for (int i = 0; i < 10; i++) {
+    // Larger than the staging pool, every Enqueue waits for the previous tensor to be written.
+    tensors.emplace_back(1000, i);
+    std::string filename = dir + "/Default--Add-op" + std::to_string(i) + "_output_0";
+    ASSERT_TRUE(Dump::DumpToFile(filename, tensors.back().data(), tensors.back().size() * sizeof(int)));
+  }
+  writer.Flush();
+  writer.Configure(false, false, 0);
+
+  std::ifstream index_file(dir + "/" + DumpWriter::kIndexFileName);
+  std::ifstream data_file(dir + "/" + DumpWriter::kDataFileName, std::ios::binary);
+  ASSERT_TRUE(index_file.is_open());
+  ASSERT_TRUE(data_file.is_open());
+  std::string line;
+  int count = 0;
+  while (std::getline(index_file, line)) {
+    std::istringstream iss(line);
+    std::string name;
+    std::string codec;
+    uint64_t offset = 0;
+    size_t stored_size = 0;
+    size_t raw_size = 0;
+    iss >> name >> offset >> stored_size >> raw_size >> codec;
+    ASSERT_EQ(name, "Default--Add-op" + std::to_string(count) + "_output_0");
+    ASSERT_EQ(raw_size, tensors[count].size() * sizeof(int));
+    ASSERT_EQ(codec, "lz4");
+    std::vector<char> stored(stored_size);
+    data_file.seekg(offset);
+    data_file.read(stored.data(), stored_size);
+    std::vector<int> restored(tensors[count].size());
+    ASSERT_TRUE(system::Lz4::Decompress(stored.data(), stored_size, reinterpret_cast<char *>(restored.data()),
+                                        raw_size));
+    ASSERT_EQ(restored, tensors[count]);
+    count++;
+  }
+  ASSERT_EQ(count, 10);
+
+  std::shared_ptr<system::FileSystem> fs = system::Env::GetFileSystem();
+  fs->DeleteFile(dir + "/" + DumpWriter::kIndexFileName);
+  fs->DeleteFile(dir + "/" + DumpWriter::kDataFileName);
+}
 }  // namespace mindspore
@@ -0,0 +1,79 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <thread>
+#include <vector>
+
+#include "common/common_test.h"
+#include "runtime/device/cpu/profiling/cpu_profiling.h"
+
+namespace mindspore {
+namespace device {
+namespace cpu {
+class TestCPUProfiling : public UT::Common {
+ public:
+  TestCPUProfiling() {}
+};
+
+TEST_F(TestCPUProfiling, test_ring_buffer_drain) {
+  KernelEventRingBuffer ring_buffer(8);
+  for (uint32_t i = 0; i < 5; ++i) {
+    KernelEvent event;
+    event.op_id = i;
+    ring_buffer.Push(event);
+  }
+  std::vector<KernelEvent> events;
+  EXPECT_EQ(ring_buffer.Drain(&events), 0);
+  ASSERT_EQ(events.size(), 5);
+  EXPECT_EQ(events[4].op_id, 4);
+  EXPECT_EQ(ring_buffer.size(), 0);
+}
+
+TEST_F(TestCPUProfiling, test_ring_buffer_overwrite) {
+  KernelEventRingBuffer ring_buffer(8);
+  for (uint32_t i = 0; i < 20; ++i) {
+    KernelEvent event;
+    event.op_id = i;
+    ring_buffer.Push(event);
+  }
+  std::vector<KernelEvent> events;
+  EXPECT_EQ(ring_buffer.Drain(&events), 12);
+  ASSERT_EQ(events.size(), 8);
+  EXPECT_EQ(events[0].op_id, 12);
+  EXPECT_EQ(events[7].op_id, 19);
+}
+
+TEST_F(TestCPUProfiling, test_ring_buffer_concurrent_push) {
+  KernelEventRingBuffer ring_buffer(1024);
+  std::vector<std::thread> threads;
+  for (uint32_t t = 0; t < 4; ++t) {
+    threads.emplace_back([&ring_buffer, t]() {
+      for (uint32_t i = 0; i < 100; ++i) {
+        KernelEvent event;
+        event.thread_id = t;
+        ring_buffer.Push(event);
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  std::vector<KernelEvent> events;
+  EXPECT_EQ(ring_buffer.Drain(&events), 0);
+  EXPECT_EQ(events.size(), 400);
+}
+}  // namespace cpu
+}  // namespace device
+}  // namespace mindspore
@@ -14,6 +14,9 @@
  * limitations under the License.
  */
 
+#include <algorithm>
+#include <chrono>
+#include <map>
 #include <vector>
 #include "common/common_test.h"
 #include "backend/kernel_compiler/common_utils.h"
@@ -130,5 +133,65 @@ TEST_F(CommonUtilTest, BucketReduceSparseGradient2) {
     EXPECT_EQ(unique_grad.value_[i], expect_value[i]);
   }
 }
+
+TEST_F(CommonUtilTest, SparseGradientReducerBenchmark) {
+  // Sweeps the number of indices and the share of them which repeat an earlier index, the reducer is reused across
+  // steps the way a kernel holds it.
+  const size_t kStride = 64;
+  const size_t kSteps = 5;
+  SparseGradientReducer reducer;
+  for (size_t indices_size : {1024, 16384, 131072}) {
+    for (size_t dup_percent : {0, 50, 90}) {
+      size_t unique_num = std::max(indices_size * (100 - dup_percent) / 100, static_cast<size_t>(1));
+      std::vector<int> indices(indices_size);
+      std::vector<float> grad(indices_size * kStride);
+      for (size_t i = 0; i < indices_size; ++i) {
+        indices[i] = static_cast<int>((i * 7919) % unique_num);
+        for (size_t j = 0; j < kStride; ++j) {
+          grad[i * kStride + j] = static_cast<float>((i + j) % 17);
+        }
+      }
+      std::vector<int> unique_indices(indices_size);
+      std::vector<float> summed_grad(indices_size * kStride);
+      std::vector<int> tmp_indices(indices_size);
+      std::vector<float> tmp_grad(indices_size * kStride);
+      SparseGradient input_grad({grad.data(), indices.data(), indices_size});
+      SparseGradient workspace_grad({tmp_grad.data(), tmp_indices.data(), indices_size});
+      SparseGradient unique_grad({summed_grad.data(), unique_indices.data(), indices_size});
+      ReduceSparseGradientParam param;
+      param.input_grad_ = &input_grad;
+      param.workspace_grad_ = &workspace_grad;
+      param.output_grad_ = &unique_grad;
+      param.max_index_ = unique_num;
+      param.value_stride_ = kStride;
+
+      auto start = std::chrono::steady_clock::now();
+      for (size_t step = 0; step < kSteps; ++step) {
+        unique_grad.indices_size_ = indices_size;
+        reducer.Reduce(param);
+      }
+      auto cost = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+      MS_LOG(INFO) << "Reduce " << indices_size << " indices with " << dup_percent << "% duplicates: "
+                   << cost.count() / (kSteps * indices_size) << " ns per index";
+
+      std::map<int, std::vector<float>> expect;
+      for (size_t i = 0; i < indices_size; ++i) {
+        auto &row = expect[indices[i]];
+        row.resize(kStride, 0);
+        for (size_t j = 0; j < kStride; ++j) {
+          row[j] += grad[i * kStride + j];
+        }
+      }
+      ASSERT_EQ(unique_grad.indices_size_, expect.size());
+      for (size_t i = 0; i < unique_grad.indices_size_; ++i) {
+        auto iter = expect.find(unique_grad.indices_[i]);
+        ASSERT_TRUE(iter != expect.end());
+        for (size_t j = 0; j < kStride; ++j) {
+          EXPECT_EQ(unique_grad.value_[i * kStride + j], iter->second[j]);
+        }
+      }
+    }
+  }
+}
 }  // namespace kernel
 }  // namespace mindspore
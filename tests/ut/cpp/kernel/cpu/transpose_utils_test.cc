@@ -0,0 +1,84 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <vector>
+#include "common/common_test.h"
+#include "backend/kernel_compiler/cpu/transpose_utils.h"
+
+namespace mindspore {
+namespace kernel {
+class TransposeUtilsTest : public UT::Common {
+ public:
+  TransposeUtilsTest() = default;
+
+  // Transposes with the transposer and compares with the element by element result.
+  void CheckTranspose(const std::vector<size_t> &shape, const std::vector<size_t> &perm, Transposer::Kind kind) {
+    Transposer transposer(shape, perm);
+    EXPECT_EQ(transposer.kind(), kind);
+    size_t dim_num = shape.size();
+    size_t size = transposer.element_num();
+    std::vector<float> input(size);
+    for (size_t i = 0; i < size; ++i) {
+      input[i] = static_cast<float>(i);
+    }
+    std::vector<size_t> input_strides(dim_num, 1);
+    for (size_t i = dim_num - 1; i > 0; --i) {
+      input_strides[i - 1] = input_strides[i] * shape[i];
+    }
+    std::vector<float> expect(size);
+    for (size_t pos = 0; pos < size; ++pos) {
+      size_t rest = pos;
+      size_t offset = 0;
+      for (size_t i = dim_num; i > 0; --i) {
+        size_t dim = shape[perm[i - 1]];
+        offset += (rest % dim) * input_strides[perm[i - 1]];
+        rest /= dim;
+      }
+      expect[pos] = input[offset];
+    }
+    std::vector<float> output(size, -1);
+    transposer.Run(input.data(), output.data());
+    EXPECT_EQ(output, expect);
+  }
+};
+
+TEST_F(TransposeUtilsTest, IdentityIsCopy) {
+  CheckTranspose({2, 3, 4}, {0, 1, 2}, Transposer::kCopy);
+  CheckTranspose({2, 1, 4}, {1, 0, 2}, Transposer::kCopy);
+}
+
+TEST_F(TransposeUtilsTest, InnerDimKeptCopiesRows) {
+  CheckTranspose({3, 5, 7}, {1, 0, 2}, Transposer::kRows);
+  CheckTranspose({2, 3, 4, 5}, {2, 0, 1, 3}, Transposer::kRows);
+}
+
+TEST_F(TransposeUtilsTest, MatrixTranspose) {
+  CheckTranspose({8, 8}, {1, 0}, Transposer::kTile);
+  CheckTranspose({37, 70}, {1, 0}, Transposer::kTile);
+  CheckTranspose({4, 33, 65}, {0, 2, 1}, Transposer::kTile);
+}
+
+TEST_F(TransposeUtilsTest, NchwNhwc) {
+  CheckTranspose({2, 16, 9, 11}, {0, 2, 3, 1}, Transposer::kTile);
+  CheckTranspose({2, 9, 11, 16}, {0, 3, 1, 2}, Transposer::kTile);
+}
+
+TEST_F(TransposeUtilsTest, GeneralPermutation) {
+  CheckTranspose({3, 4, 5, 6, 7}, {4, 2, 0, 3, 1}, Transposer::kTile);
+  CheckTranspose({5, 1, 6, 1, 7}, {4, 3, 2, 1, 0}, Transposer::kTile);
+}
+}  // namespace kernel
+}  // namespace mindspore
@@ -14,10 +14,12 @@
  * limitations under the License.
  */
 
+#include <algorithm>
 #include <chrono>
 #include <cstring>
 #include <iostream>
 #include <memory>
+#include <set>
 #include <string>
 #include <vector>
 
@@ -784,6 +786,220 @@ TEST_F(TestShardWriter, TestShardReaderStringAndNumberColumnInIndex) {
   }
 }
 
+TEST_F(TestShardWriter, TestShardWriterCompressBlobAndGenerateIndex) {
+  MS_LOG(INFO) << common::SafeCStr(FormatInfo("Test write compressed blob and generate index while writing"));
+
+  // load binary data
+  std::vector<std::vector<uint8_t>> bin_data;
+  std::vector<std::string> filenames;
+  ASSERT_NE(-1, mindrecord::GetAbsoluteFiles("./data/mindrecord/testImageNetData/images", filenames));
+  ASSERT_NE(-1, mindrecord::Img2DataUint8(filenames, bin_data));
+  bin_data.resize(10);
+
+  // init shardHeader
+  mindrecord::ShardHeader header_data;
+  json anno_schema_json =
+    R"({"file_name": {"type": "string"}, "label": {"type": "int32"}, "data":{"type":"bytes"}})"_json;
+  std::shared_ptr<mindrecord::Schema> anno_schema = mindrecord::Schema::Build("annotation", anno_schema_json);
+  ASSERT_TRUE(anno_schema != nullptr);
+  int anno_schema_id = header_data.AddSchema(anno_schema);
+  ASSERT_EQ(anno_schema_id, 0);
+  std::vector<std::pair<uint64_t, std::string>> fields{{anno_schema_id, "file_name"}, {anno_schema_id, "label"}};
+  ASSERT_EQ(header_data.AddIndexFields(fields), SUCCESS);
+
+  // load  meta data
+  std::vector<json> annotations;
+  LoadDataFromImageNet("./data/mindrecord/testImageNetData/annotation.txt", annotations, 10);
+
+  std::vector<std::string> file_names;
+  for (int i = 1; i <= 4; i++) {
+    file_names.emplace_back(std::string("./imagenet_lz4.shard0") + std::to_string(i));
+  }
+
+  mindrecord::ShardWriter fw;
+  ASSERT_TRUE(fw.Open(file_names) == SUCCESS);
+  ASSERT_TRUE(fw.SetBlobCompression("zip") == FAILED);
+  ASSERT_TRUE(fw.SetBlobCompression("lz4") == SUCCESS);
+  fw.SetGenerateIndex(true);
+  ASSERT_TRUE(fw.SetShardHeader(std::make_shared<mindrecord::ShardHeader>(header_data)) == SUCCESS);
+
+  // write in two batches, so rows are appended to the row groups written before
+  for (int batch = 0; batch < 2; batch++) {
+    std::map<std::uint64_t, std::vector<json>> rawdatas;
+    rawdatas[anno_schema_id] = std::vector<json>(annotations.begin() + batch * 5, annotations.begin() + batch * 5 + 5);
+    std::vector<std::vector<uint8_t>> blob_data(bin_data.begin() + batch * 5, bin_data.begin() + batch * 5 + 5);
+    ASSERT_TRUE(fw.WriteRawData(rawdatas, blob_data) == SUCCESS);
+    // the data written in background is a copy, the containers of the caller are kept
+    ASSERT_EQ(rawdatas[anno_schema_id].size(), 5);
+    ASSERT_EQ(blob_data.size(), 5);
+  }
+  ASSERT_TRUE(fw.Commit() == SUCCESS);
+  ASSERT_TRUE(fw.IsIndexGenerated());
+
+  // read the mindrecord file, the blobs are restored
+  auto column_list = std::vector<std::string>{"label", "file_name", "data"};
+  ShardReader dataset;
+  ASSERT_EQ(dataset.Open({file_names[0]}, true, 4, column_list), SUCCESS);
+  dataset.Launch();
+
+  std::vector<std::vector<uint8_t>> images;
+  while (true) {
+    auto x = dataset.GetNext();
+    if (x.empty()) break;
+    for (auto &j : x) {
+      images.push_back(std::get<0>(j));
+      ASSERT_EQ(std::get<1>(j).size(), 2);
+    }
+  }
+  dataset.Finish();
+  std::sort(images.begin(), images.end());
+  std::sort(bin_data.begin(), bin_data.end());
+  ASSERT_TRUE(images == bin_data);
+
+  for (const auto &filename : file_names) {
+    auto filename_db = filename + ".db";
+    remove(common::SafeCStr(filename_db));
+    remove(common::SafeCStr(filename));
+  }
+}
+
+namespace {
+int DumpIndexCallback(void *p_data, int num_fields, char **p_fields, char **p_col_names) {
+  auto *rows = static_cast<std::vector<std::vector<std::string>> *>(p_data);
+  std::vector<std::string> row;
+  for (int i = 0; i < num_fields; ++i) {
+    row.emplace_back(p_fields[i] == nullptr ? "NULL" : p_fields[i]);
+  }
+  rows->push_back(std::move(row));
+  return 0;
+}
+
+std::vector<std::vector<std::string>> DumpIndex(const std::string &db_file, const std::string &sql) {
+  std::vector<std::vector<std::string>> rows;
+  sqlite3 *db = nullptr;
+  if (sqlite3_open_v2(common::SafeCStr(db_file), &db, SQLITE_OPEN_READONLY, nullptr) != SQLITE_OK) {
+    sqlite3_close(db);
+    return rows;
+  }
+  char *errmsg = nullptr;
+  if (sqlite3_exec(db, common::SafeCStr(sql), DumpIndexCallback, &rows, &errmsg) != SQLITE_OK) {
+    MS_LOG(ERROR) << "Error in select statement, sql: " << sql << ", error: " << errmsg;
+    sqlite3_free(errmsg);
+    rows.clear();
+  }
+  sqlite3_close(db);
+  return rows;
+}
+}  // namespace
+
+TEST_F(TestShardWriter, TestShardWriterGenerateIndexSameAsIndexGenerator) {
+  MS_LOG(INFO) << common::SafeCStr(FormatInfo("Test the index generated while writing matches the index generator"));
+
+  mindrecord::ShardHeader header_data;
+  json anno_schema_json =
+    R"({"file_name": {"type": "string"}, "label": {"type": "int32"}, "padding": {"type": "string"},
+        "data": {"type": "bytes"}})"_json;
+  std::shared_ptr<mindrecord::Schema> anno_schema = mindrecord::Schema::Build("annotation", anno_schema_json);
+  ASSERT_TRUE(anno_schema != nullptr);
+  int anno_schema_id = header_data.AddSchema(anno_schema);
+  ASSERT_EQ(anno_schema_id, 0);
+  std::vector<std::pair<uint64_t, std::string>> fields{{anno_schema_id, "file_name"}, {anno_schema_id, "label"}};
+  ASSERT_EQ(header_data.AddIndexFields(fields), SUCCESS);
+
+  // With 32KB pages a blob page holds 3 rows of 10KB, so a row group has 3 rows and about 9KB of raw data.
+  // Writing 2 rows at a time appends to the row group of the previous batch: the 4th row group starts at the
+  // end of the first raw page with row 9, and the rows 10 and 11 do not fit, so it is shifted to a new raw page.
+  const int kBatchSize = 2;
+  const int kBatchNum = 15;
+  const int kLastBatchSize = 7;
+  std::vector<json> annotations;
+  std::vector<std::vector<uint8_t>> bin_data;
+  for (int i = 0; i < kBatchSize * kBatchNum + kLastBatchSize; i++) {
+    json anno;
+    anno["file_name"] = "image_" + std::to_string(i) + ".jpg";
+    anno["label"] = i % 7;
+    anno["padding"] = std::string(3000, static_cast<char>('a' + i % 26));
+    annotations.push_back(anno);
+    bin_data.emplace_back(10240, static_cast<uint8_t>(i));
+  }
+
+  std::string filename = "./generate_index_cmp.mindrecord";
+  std::string filename_db = filename + ".db";
+  remove(common::SafeCStr(filename_db));
+  remove(common::SafeCStr(filename));
+  {
+    mindrecord::ShardWriter fw;
+    ASSERT_TRUE(fw.Open({filename}) == SUCCESS);
+    ASSERT_TRUE(fw.SetHeaderSize(1 << 14) == SUCCESS);
+    ASSERT_TRUE(fw.SetPageSize(1 << 15) == SUCCESS);
+    fw.SetGenerateIndex(true);
+    ASSERT_TRUE(fw.SetShardHeader(std::make_shared<mindrecord::ShardHeader>(header_data)) == SUCCESS);
+    for (int start = 0; start < static_cast<int>(annotations.size());) {
+      int end = start < kBatchSize * kBatchNum ? start + kBatchSize : static_cast<int>(annotations.size());
+      std::map<std::uint64_t, std::vector<json>> rawdatas;
+      rawdatas[anno_schema_id] = std::vector<json>(annotations.begin() + start, annotations.begin() + end);
+      std::vector<std::vector<uint8_t>> blob_data(bin_data.begin() + start, bin_data.begin() + end);
+      ASSERT_TRUE(fw.WriteRawData(rawdatas, blob_data) == SUCCESS);
+      start = end;
+    }
+    ASSERT_TRUE(fw.Commit() == SUCCESS);
+    ASSERT_TRUE(fw.IsIndexGenerated());
+  }
+
+  const std::string kSelectIndexes = "SELECT * FROM INDEXES ORDER BY ROW_ID;";
+  const std::string kSelectShardName = "SELECT NAME FROM SHARD_NAME;";
+  auto inline_rows = DumpIndex(filename_db, kSelectIndexes);
+  auto inline_name = DumpIndex(filename_db, kSelectShardName);
+  ASSERT_EQ(inline_rows.size(), annotations.size());
+
+  // The 4th row group spans two batches and has been shifted to the start of another raw page
+  auto pages =
+    DumpIndex(filename_db, "SELECT ROW_GROUP_ID, PAGE_ID_RAW, PAGE_OFFSET_RAW FROM INDEXES ORDER BY ROW_ID;");
+  ASSERT_EQ(pages.size(), annotations.size());
+  ASSERT_EQ(pages[9][0], pages[10][0]);
+  ASSERT_EQ(pages[9][0], pages[11][0]);
+  ASSERT_NE(pages[9][1], pages[0][1]);
+  ASSERT_EQ(pages[9][2], "0");
+  std::set<std::string> raw_pages;
+  std::set<std::string> row_groups;
+  for (const auto &page : pages) {
+    row_groups.insert(page[0]);
+    raw_pages.insert(page[1]);
+  }
+  ASSERT_GT(raw_pages.size(), 2);
+  ASSERT_GT(row_groups.size(), 10);
+
+  // Build the index of the same file with the index generator and compare
+  remove(common::SafeCStr(filename_db));
+  mindrecord::ShardIndexGenerator sg{filename};
+  ASSERT_EQ(sg.Build(), SUCCESS);
+  ASSERT_EQ(sg.WriteToDatabase(), SUCCESS);
+  ASSERT_TRUE(DumpIndex(filename_db, kSelectIndexes) == inline_rows);
+  ASSERT_TRUE(DumpIndex(filename_db, kSelectShardName) == inline_name);
+
+  remove(common::SafeCStr(filename_db));
+  remove(common::SafeCStr(filename));
+}
+
+TEST_F(TestShardWriter, TestUncompressBytesBound) {
+  MS_LOG(INFO) << common::SafeCStr(FormatInfo("Test the size of a decompressed blob is bounded by the page size"));
+  std::vector<uint8_t> original(4096, 7);
+  auto compressed = ShardColumn::CompressBytes(original);
+  ASSERT_LT(compressed.size(), original.size());
+  ASSERT_EQ(ShardColumn::UncompressedSize(compressed), original.size());
+
+  auto blob = compressed;
+  ASSERT_EQ(ShardColumn::UncompressBytes(&blob, original.size() - 1), FAILED);
+  blob = compressed;
+  ASSERT_EQ(ShardColumn::UncompressBytes(&blob, original.size()), SUCCESS);
+  ASSERT_TRUE(blob == original);
+
+  // a corrupted size is rejected before anything is allocated
+  blob = compressed;
+  std::fill(blob.begin(), blob.begin() + 8, 0xff);
+  ASSERT_EQ(ShardColumn::UncompressBytes(&blob, 1 << 25), FAILED);
+}
+
 TEST_F(TestShardWriter, TestShardNoBlob) {
   MS_LOG(INFO) << common::SafeCStr(FormatInfo("Test no-blob"));
 
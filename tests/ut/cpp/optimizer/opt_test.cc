@@ -13,6 +13,7 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include <chrono>
 #include <iostream>
 #include <memory>
 
@@ -20,6 +21,7 @@
 #include "common/py_func_graph_fetcher.h"
 
 #include "ir/anf.h"
+#include "ir/tensor.h"
 #include "ir/visitor.h"
 #include "ir/func_graph_cloner.h"
 #include "frontend/optimizer/opt.h"
@@ -212,5 +214,34 @@ TEST_F(TestOptOpt, CSE) {
   draw::Draw("opt_cse_after_2.dot", test_graph2);
 }
 
+TEST_F(TestOptOpt, CSELargeGraph) {
+  // An unrolled loop which multiplies the input by a different constant in each step and computes every product twice.
+  // All the products have the same input and constants of the same shape.
+  const int step_num = 20000;
+  FuncGraphPtr fg = std::make_shared<FuncGraph>();
+  auto x = fg->add_parameter();
+  auto mul = NewValueNode(prim::kPrimMul);
+  auto add = NewValueNode(prim::kPrimTensorAdd);
+  AnfNodePtr out = x;
+  for (int i = 0; i < step_num; ++i) {
+    auto const1 = NewValueNode(std::make_shared<tensor::Tensor>(static_cast<double>(i)));
+    auto const2 = NewValueNode(std::make_shared<tensor::Tensor>(static_cast<double>(i)));
+    auto mul1 = fg->NewCNode({mul, x, const1});
+    auto mul2 = fg->NewCNode({mul, x, const2});
+    out = fg->NewCNode({add, out, fg->NewCNode({add, mul1, mul2})});
+  }
+  fg->set_output(out);
+  FuncGraphManagerPtr manager = Manage(fg);
+  size_t node_num = manager->all_nodes().size();
+
+  auto start = std::chrono::steady_clock::now();
+  auto cse = std::make_shared<CSE>();
+  ASSERT_TRUE(cse->Cse(fg, manager));
+  std::chrono::duration<double, std::milli> cost = std::chrono::steady_clock::now() - start;
+  MS_LOG(INFO) << "Cse on a graph of " << node_num << " nodes cost " << cost.count() << " ms.";
+  // The second product and its constant are gone in every step.
+  ASSERT_EQ(manager->all_nodes().size(), node_num - 2 * step_num);
+}
+
 }  // namespace opt
 }  // namespace mindspore
@@ -0,0 +1,109 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <vector>
+#include "common/common_test.h"
+#include "frontend/parallel/ps/embedding_cache.h"
+
+namespace mindspore {
+namespace parallel {
+namespace ps {
+class TestEmbeddingCache : public UT::Common {
+ public:
+  TestEmbeddingCache() {}
+
+  // Look up ids through cache, pulling the missed rows from a table whose row of id i is filled with i.
+  std::vector<size_t> LookupStep(EmbeddingCache *cache, const std::vector<int> &ids, std::vector<float> *output) {
+    output->assign(ids.size() * kRowSize, -1);
+    std::vector<size_t> missed;
+    cache->Lookup(ids.data(), ids.size(), output->data(), &missed);
+    std::vector<int> missed_ids;
+    std::vector<float> rows;
+    for (auto pos : missed) {
+      missed_ids.push_back(ids[pos]);
+      for (size_t j = 0; j < kRowSize; j++) {
+        rows.push_back(static_cast<float>(ids[pos]));
+        (*output)[pos * kRowSize + j] = static_cast<float>(ids[pos]);
+      }
+    }
+    cache->Update(missed_ids.data(), missed_ids.size(), rows.data());
+    cache->StepEnd();
+    return missed;
+  }
+
+  static constexpr size_t kRowSize = 2;
+};
+
+TEST_F(TestEmbeddingCache, test_lru_hit_and_evict) {
+  EmbeddingCacheConfig config;
+  config.capacity = 2;
+  config.max_staleness = 100;
+  EmbeddingCache cache(10, kRowSize, config);
+  std::vector<float> output;
+
+  ASSERT_EQ(LookupStep(&cache, {1, 2, 1}, &output).size(), 3);
+  ASSERT_EQ(LookupStep(&cache, {1, 2}, &output).size(), 0);
+  ASSERT_EQ(output, std::vector<float>({1, 1, 2, 2}));
+  // 1 is used more recently than 2, so 2 is evicted for 3.
+  ASSERT_EQ(LookupStep(&cache, {1, 3}, &output).size(), 1);
+  // Pulling 2 again evicts 1, the least recently used row by now.
+  ASSERT_EQ(LookupStep(&cache, {2}, &output).size(), 1);
+  ASSERT_EQ(LookupStep(&cache, {1}, &output).size(), 1);
+  const auto &statistics = cache.statistics();
+  ASSERT_EQ(statistics.hits, 3);
+  ASSERT_EQ(statistics.evictions, 3);
+}
+
+TEST_F(TestEmbeddingCache, test_staleness_bound) {
+  EmbeddingCacheConfig config;
+  config.capacity = 4;
+  config.max_staleness = 1;
+  EmbeddingCache cache(10, kRowSize, config);
+  std::vector<float> output;
+
+  ASSERT_EQ(LookupStep(&cache, {5, 11, -1}, &output).size(), 3);
+  ASSERT_EQ(LookupStep(&cache, {5}, &output).size(), 0);
+  ASSERT_EQ(LookupStep(&cache, {5}, &output).size(), 1);
+  ASSERT_EQ(LookupStep(&cache, {5}, &output).size(), 0);
+  const auto &statistics = cache.statistics();
+  ASSERT_EQ(statistics.stale_misses, 1);
+  ASSERT_EQ(statistics.max_served_staleness, 1);
+  // Ids out of the table are never cached.
+  ASSERT_EQ(cache.size(), 1);
+}
+
+TEST_F(TestEmbeddingCache, test_lfu_keeps_hot_rows_on_scan) {
+  EmbeddingCacheConfig config;
+  config.capacity = 2;
+  config.policy = kCacheLFU;
+  config.max_staleness = 100;
+  EmbeddingCache cache(100, kRowSize, config);
+  std::vector<float> output;
+
+  for (int i = 0; i < 3; i++) {
+    (void)LookupStep(&cache, {1, 2}, &output);
+  }
+  // A scan of ids seen once must not replace the hot rows.
+  for (int id = 10; id < 20; id++) {
+    (void)LookupStep(&cache, {id}, &output);
+  }
+  ASSERT_EQ(LookupStep(&cache, {1, 2}, &output).size(), 0);
+  ASSERT_EQ(cache.statistics().rejections, 10);
+  ASSERT_EQ(cache.statistics().evictions, 0);
+}
+}  // namespace ps
+}  // namespace parallel
+}  // namespace mindspore
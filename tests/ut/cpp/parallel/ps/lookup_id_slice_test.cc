@@ -0,0 +1,118 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <utility>
+#include <vector>
+#include "common/common_test.h"
+#include "frontend/parallel/ps/lookup_id_slice.h"
+
+namespace mindspore {
+namespace parallel {
+namespace ps {
+class TestLookupIdSlice : public UT::Common {
+ public:
+  TestLookupIdSlice() {}
+
+  // The ids sent to server rank, in the order they are sent.
+  static std::vector<int> ServerIds(const LookupIdSlice &slice, size_t rank) {
+    std::vector<int> ids;
+    for (auto u : slice.server_unique_ids(rank)) {
+      ids.push_back(slice.unique_id(u));
+    }
+    return ids;
+  }
+
+  // The answer of server rank, the row of id i is filled with i + 0.5.
+  static std::vector<float> ServerAnswer(const LookupIdSlice &slice, size_t rank) {
+    std::vector<float> vals;
+    for (auto id : ServerIds(slice, rank)) {
+      vals.insert(vals.end(), kRowSize, static_cast<float>(id) + 0.5f);
+    }
+    return vals;
+  }
+
+  static constexpr size_t kRowSize = 3;
+  // Three servers holding the rows 0 to 9 of the table.
+  const std::vector<std::pair<uint64_t, uint64_t>> ranges_{{0, 3}, {4, 6}, {7, 9}};
+};
+
+TEST_F(TestLookupIdSlice, test_dedup_and_slice) {
+  std::vector<int> ids = {8, 1, 5, 1, 8, 2, 5, 9, 1};
+  LookupIdSlice slice;
+  slice.Build(ids.data(), ids.size(), ranges_);
+
+  ASSERT_EQ(slice.id_num(), ids.size());
+  ASSERT_EQ(slice.unique_id_num(), 5);
+  ASSERT_EQ(slice.server_num(), 3);
+  // Each unique id is sent once, to the server owning it, in the order of its first occurrence.
+  ASSERT_EQ(ServerIds(slice, 0), std::vector<int>({1, 2}));
+  ASSERT_EQ(ServerIds(slice, 1), std::vector<int>({5}));
+  ASSERT_EQ(ServerIds(slice, 2), std::vector<int>({8, 9}));
+  ASSERT_TRUE(slice.unowned_unique_ids().empty());
+}
+
+TEST_F(TestLookupIdSlice, test_server_without_ids) {
+  std::vector<int> ids = {0, 3, 3, 9, 0};
+  LookupIdSlice slice;
+  slice.Build(ids.data(), ids.size(), ranges_);
+
+  ASSERT_EQ(ServerIds(slice, 0), std::vector<int>({0, 3}));
+  ASSERT_TRUE(slice.server_unique_ids(1).empty());
+  ASSERT_EQ(ServerIds(slice, 2), std::vector<int>({9}));
+}
+
+TEST_F(TestLookupIdSlice, test_scatter_to_original_order) {
+  std::vector<int> ids = {8, 1, -1, 5, 1, 8, 10, 2, 5, 9, 1, -1};
+  LookupIdSlice slice;
+  slice.Build(ids.data(), ids.size(), ranges_);
+  // -1 and 10 are outside the table.
+  ASSERT_EQ(slice.unowned_unique_ids().size(), 2);
+
+  std::vector<float> output(ids.size() * kRowSize, -1);
+  slice.FillUnowned(output.data(), kRowSize);
+  // The servers answer in any order.
+  for (size_t rank : {2, 0, 1}) {
+    auto vals = ServerAnswer(slice, rank);
+    size_t row_size = slice.RowSize(rank, vals.size());
+    ASSERT_EQ(row_size, kRowSize);
+    slice.ScatterRows(rank, vals.data(), row_size, output.data(), output.size());
+  }
+
+  for (size_t i = 0; i < ids.size(); i++) {
+    float expect = (ids[i] < 0 || ids[i] > 9) ? 0 : static_cast<float>(ids[i]) + 0.5f;
+    for (size_t j = 0; j < kRowSize; j++) {
+      ASSERT_EQ(output[i * kRowSize + j], expect) << "row " << i;
+    }
+  }
+}
+
+TEST_F(TestLookupIdSlice, test_wrong_answer_size) {
+  std::vector<int> ids = {1, 2, 5};
+  LookupIdSlice slice;
+  slice.Build(ids.data(), ids.size(), ranges_);
+
+  ASSERT_EQ(slice.RowSize(0, 2 * kRowSize), kRowSize);
+  EXPECT_ANY_THROW(slice.RowSize(0, 2 * kRowSize + 1));
+  EXPECT_ANY_THROW(slice.RowSize(2, kRowSize));
+  EXPECT_ANY_THROW(slice.server_unique_ids(3));
+
+  std::vector<float> vals(2 * kRowSize, 1);
+  std::vector<float> output((ids.size() - 1) * kRowSize);
+  EXPECT_ANY_THROW(slice.ScatterRows(0, vals.data(), kRowSize, output.data(), output.size()));
+}
+}  // namespace ps
+}  // namespace parallel
+}  // namespace mindspore
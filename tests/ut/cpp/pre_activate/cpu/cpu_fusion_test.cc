@@ -0,0 +1,108 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "backend/optimizer/cpu/post_ops_fusion.h"
+#include "backend/optimizer/cpu/elemwise_chain_fusion.h"
+#include "backend/session/anf_runtime_algorithm.h"
+#include "common/backend_common_test.h"
+#include "common/py_func_graph_fetcher.h"
+#include "utils/utils.h"
+
+namespace mindspore {
+namespace opt {
+class TestHWCPUFusion : public BackendCommon {
+ public:
+  TestHWCPUFusion() : get_py_fun_("gtest_input.pre_activate.cpu_fusion_test", true) {}
+  ~TestHWCPUFusion() override = default;
+
+  std::shared_ptr<session::KernelGraph> GetGraph(const std::string &name, const std::vector<std::vector<int>> &shapes) {
+    FuncGraphPtr g = get_py_fun_.CallAndParseRet(name, "before");
+    EXPECT_NE(g, nullptr);
+    AbstractBasePtrList args_spec_list;
+    for (const auto &shape : shapes) {
+      args_spec_list.push_back(std::make_shared<abstract::AbstractTensor>(kFloat32, shape));
+    }
+    return GetKernelGraph(g, args_spec_list);
+  }
+
+  // The node returned by the graph, GetKernelGraph wraps the outputs in a make_tuple.
+  CNodePtr GetOutputNode(const FuncGraphPtr &graph) {
+    auto make_tuple = graph->get_return()->input(1)->cast<CNodePtr>();
+    EXPECT_NE(make_tuple, nullptr);
+    return make_tuple->input(1)->cast<CNodePtr>();
+  }
+
+  UT::PyFuncGraphFetcher get_py_fun_;
+};
+
+TEST_F(TestHWCPUFusion, test_conv2d_bias_relu_fusion) {
+  auto kg = GetGraph("test_conv2d_bias_relu_fusion", {{1, 3, 8, 8}, {4, 3, 3, 3}, {4}});
+  auto optimizer = std::make_shared<opt::GraphOptimizer>();
+  auto pm = std::make_shared<opt::PassManager>();
+  pm->AddPass(std::make_shared<opt::Conv2DBiasAddFusion>());
+  pm->AddPass(std::make_shared<opt::Conv2DReluFusion>());
+  optimizer->AddPassManager(pm);
+  FuncGraphPtr new_graph = optimizer->Optimize(kg);
+
+  FuncGraphPtr g_after = get_py_fun_.CallAndParseRet("test_conv2d_bias_relu_fusion", "after");
+  EXPECT_TRUE(CheckEqualGraph(g_after, new_graph));
+  auto conv = GetOutputNode(new_graph);
+  EXPECT_TRUE(AnfAlgo::GetNodeAttr<bool>(conv, kAttrHasBias));
+  EXPECT_TRUE(AnfAlgo::GetNodeAttr<bool>(conv, kAttrFusedRelu));
+}
+
+TEST_F(TestHWCPUFusion, test_matmul_bias_relu_fusion) {
+  auto kg = GetGraph("test_matmul_bias_relu_fusion", {{2, 3}, {3, 4}, {4}});
+  auto optimizer = std::make_shared<opt::GraphOptimizer>();
+  auto pm = std::make_shared<opt::PassManager>();
+  pm->AddPass(std::make_shared<opt::MatMulBiasAddFusion>());
+  pm->AddPass(std::make_shared<opt::MatMulReluFusion>());
+  optimizer->AddPassManager(pm);
+  FuncGraphPtr new_graph = optimizer->Optimize(kg);
+
+  FuncGraphPtr g_after = get_py_fun_.CallAndParseRet("test_matmul_bias_relu_fusion", "after");
+  EXPECT_TRUE(CheckEqualGraph(g_after, new_graph));
+  EXPECT_TRUE(AnfAlgo::GetNodeAttr<bool>(GetOutputNode(new_graph), kAttrFusedRelu));
+}
+
+TEST_F(TestHWCPUFusion, test_matmul_used_by_others) {
+  // The unbiased result of MatMul is also an output, so the bias can not be folded into it.
+  auto kg = GetGraph("test_matmul_used_by_others", {{2, 3}, {3, 4}, {4}});
+  auto optimizer = std::make_shared<opt::GraphOptimizer>();
+  auto pm = std::make_shared<opt::PassManager>();
+  pm->AddPass(std::make_shared<opt::MatMulBiasAddFusion>());
+  optimizer->AddPassManager(pm);
+  FuncGraphPtr new_graph = optimizer->Optimize(kg);
+  EXPECT_EQ(AnfAlgo::GetCNodeName(GetOutputNode(new_graph)), kBiasAddOpName);
+}
+
+TEST_F(TestHWCPUFusion, test_elemwise_chain_fusion) {
+  auto kg = GetGraph("test_elemwise_chain_fusion", {{2, 32}, {2, 32}, {2, 32}});
+  auto optimizer = std::make_shared<opt::GraphOptimizer>();
+  auto pm = std::make_shared<opt::PassManager>();
+  pm->AddPass(std::make_shared<opt::ElemwiseChainFusion>());
+  optimizer->AddPassManager(pm);
+  FuncGraphPtr new_graph = optimizer->Optimize(kg);
+
+  FuncGraphPtr g_after = get_py_fun_.CallAndParseRet("test_elemwise_chain_fusion", "after");
+  EXPECT_TRUE(CheckEqualGraph(g_after, new_graph));
+  auto fused = GetOutputNode(new_graph);
+  std::vector<std::string> expect_ops = {"Mul", "Sqrt", "TensorAdd", "ReLU"};
+  std::vector<int> expect_operands = {0, 1, 2, 3, 4, 5};
+  EXPECT_EQ(AnfAlgo::GetNodeAttr<std::vector<std::string>>(fused, kAttrFusedOps), expect_ops);
+  EXPECT_EQ(AnfAlgo::GetNodeAttr<std::vector<int>>(fused, kAttrFusedOperands), expect_operands);
+}
+}  // namespace opt
+}  // namespace mindspore
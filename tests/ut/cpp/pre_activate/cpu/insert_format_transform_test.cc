@@ -0,0 +1,74 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "backend/optimizer/cpu/insert_format_transform.h"
+#include "backend/session/anf_runtime_algorithm.h"
+#include "common/backend_common_test.h"
+#include "common/py_func_graph_fetcher.h"
+#include "runtime/device/kernel_info.h"
+#include "utils/utils.h"
+
+namespace mindspore {
+namespace opt {
+using KernelBuildInfoBuilder = kernel::KernelBuildInfo::KernelBuildInfoBuilder;
+
+class TestHWInsertFormatTransform : public BackendCommon {
+ public:
+  TestHWInsertFormatTransform() : get_py_fun_("gtest_input.pre_activate.insert_format_transform_test", true) {}
+  ~TestHWInsertFormatTransform() override = default;
+
+  void SetBuildInfo(const AnfNodePtr &node, const std::vector<std::string> &input_formats,
+                    const std::vector<std::string> &output_formats) {
+    KernelBuildInfoBuilder builder;
+    builder.SetInputsFormat(input_formats);
+    builder.SetInputsDeviceType(std::vector<TypeId>(input_formats.size(), kNumberTypeFloat32));
+    builder.SetOutputsFormat(output_formats);
+    builder.SetOutputsDeviceType(std::vector<TypeId>(output_formats.size(), kNumberTypeFloat32));
+    if (node->kernel_info() == nullptr) {
+      node->set_kernel_info(std::make_shared<device::KernelInfo>());
+    }
+    AnfAlgo::SetSelectKernelBuildInfo(builder.Build(), node.get());
+  }
+
+  UT::PyFuncGraphFetcher get_py_fun_;
+};
+
+TEST_F(TestHWInsertFormatTransform, test_insert_format_transform) {
+  FuncGraphPtr g = get_py_fun_.CallAndParseRet("test_insert_format_transform", "before");
+  AbstractBasePtrList args_spec_list{std::make_shared<abstract::AbstractTensor>(kFloat32, std::vector<int>{1, 3, 8, 8}),
+                                     std::make_shared<abstract::AbstractTensor>(kFloat32, std::vector<int>{4, 3, 3, 3})};
+  auto kg = GetKernelGraph(g, args_spec_list);
+  // Conv2D and ReLU run on blocked data, as picked by the CPU kernel select.
+  auto relu = kg->get_return()->input(1)->cast<CNodePtr>()->input(1)->cast<CNodePtr>();
+  auto conv = relu->input(1)->cast<CNodePtr>();
+  SetBuildInfo(conv->input(1), {}, {kOpFormat_DEFAULT});
+  SetBuildInfo(conv->input(2), {}, {kOpFormat_DEFAULT});
+  SetBuildInfo(conv, {kOpFormat_NC1HWC0, kOpFormat_DEFAULT}, {kOpFormat_NC1HWC0});
+  SetBuildInfo(relu, {kOpFormat_NC1HWC0}, {kOpFormat_NC1HWC0});
+
+  auto optimizer = std::make_shared<opt::GraphOptimizer>();
+  auto pm = std::make_shared<opt::PassManager>();
+  pm->AddPass(std::make_shared<opt::InsertFormatTransform>());
+  optimizer->AddPassManager(pm);
+  FuncGraphPtr new_graph = optimizer->Optimize(kg);
+
+  FuncGraphPtr g_after = get_py_fun_.CallAndParseRet("test_insert_format_transform", "after");
+  EXPECT_TRUE(CheckEqualGraph(g_after, new_graph));
+  auto output_trans = new_graph->get_return()->input(1)->cast<CNodePtr>()->input(1);
+  EXPECT_EQ(AnfAlgo::GetInputFormat(output_trans, 0), kOpFormat_NC1HWC0);
+  EXPECT_EQ(AnfAlgo::GetOutputFormat(output_trans, 0), kOpFormat_DEFAULT);
+}
+}  // namespace opt
+}  // namespace mindspore
@@ -0,0 +1,141 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "backend/optimizer/mem_reuse/mem_dynamic_allocator.h"
+#include "common/common_test.h"
+#include "utils/log_adapter.h"
+
+namespace mindspore {
+namespace device {
+namespace {
+// Hands out fake device addresses, the pool never touches the memory.
+class FakeMemPool : public DynamicMemPoolBestFit {
+ public:
+  FakeMemPool() = default;
+  ~FakeMemPool() override = default;
+  size_t AllocDeviceMem(size_t size, DeviceMemPtr *addr) override {
+    *addr = reinterpret_cast<DeviceMemPtr>(next_addr_);
+    next_addr_ += size + kBlockGap;
+    return size;
+  }
+  bool FreeDeviceMem(const DeviceMemPtr &addr) override { return true; }
+  size_t free_mem_size() override { return kDeviceMemSize; }
+  size_t total_mem_size() override { return kDeviceMemSize; }
+
+ protected:
+  size_t mem_alloc_unit_size() const override { return kUnitSize; }
+
+ private:
+  static constexpr size_t kUnitSize = 64 << 20;
+  static constexpr size_t kBlockGap = 1 << 20;
+  static constexpr size_t kDeviceMemSize = static_cast<size_t>(1) << 40;
+  uintptr_t next_addr_{kBlockGap};
+};
+}  // namespace
+
+class TestMemDynamicAllocator : public UT::Common {
+ public:
+  TestMemDynamicAllocator() = default;
+};
+
+TEST_F(TestMemDynamicAllocator, test_best_fit_and_statistics) {
+  FakeMemPool pool;
+  auto addr1 = pool.AllocTensorMem(1000);
+  auto addr2 = pool.AllocTensorMem(4096);
+  auto addr3 = pool.AllocTensorMem(1000);
+  auto addr4 = pool.AllocTensorMem(512);
+  ASSERT_NE(addr4, nullptr);
+  pool.FreeTensorMem(addr1);
+  pool.FreeTensorMem(addr3);
+  // The smallest idle buf which fits is taken, equal sizes go to the lower address.
+  EXPECT_EQ(pool.AllocTensorMem(600), addr1);
+  pool.FreeTensorMem(addr1);
+
+  auto statistics = pool.QueryMemPoolStatistics();
+  EXPECT_EQ(statistics.used_mem_size_, 4096 + 512);
+  EXPECT_EQ(statistics.idle_mem_size_, statistics.total_mem_size_ - statistics.used_mem_size_);
+  EXPECT_EQ(statistics.idle_mem_buf_num_, 3);
+  EXPECT_EQ(statistics.fragmented_mem_size_, 2048);
+  EXPECT_EQ(statistics.used_mem_peak_, 1024 + 4096 + 1024 + 512);
+  EXPECT_EQ(statistics.alloc_num_, 5);
+  EXPECT_EQ(statistics.free_num_, 3);
+
+  // Freeing the bufs between the idle ones combines the whole block into one idle buf.
+  pool.FreeTensorMem(addr2);
+  pool.FreeTensorMem(addr4);
+  statistics = pool.QueryMemPoolStatistics();
+  EXPECT_EQ(statistics.used_mem_size_, 0);
+  EXPECT_EQ(statistics.idle_mem_buf_num_, 1);
+  EXPECT_EQ(statistics.fragmented_mem_size_, 0);
+  EXPECT_EQ(statistics.largest_idle_buf_size_, statistics.total_mem_size_);
+}
+
+TEST_F(TestMemDynamicAllocator, test_trace_replay) {
+  FakeMemPool pool;
+  pool.set_mem_trace_enable(true);
+  std::vector<DeviceMemPtr> addrs;
+  for (size_t i = 0; i < 100; ++i) {
+    addrs.push_back(pool.AllocTensorMem((i % 7 + 1) * 3000));
+    if (i % 3 == 2) {
+      pool.FreeTensorMem(addrs[i - 1]);
+    }
+  }
+  auto continuous_addrs = pool.AllocContinuousTensorMem(3072, {1024, 2048});
+  ASSERT_EQ(continuous_addrs.size(), 2);
+  pool.FreeTensorMem(continuous_addrs[0]);
+  EXPECT_EQ(pool.mem_trace().size(), 100 + 33 + 2 + 1);
+
+  std::string trace_file = "./mem_dynamic_allocator_trace.txt";
+  ASSERT_TRUE(pool.DumpMemTrace(trace_file));
+  std::vector<DynamicMemTraceItem> trace;
+  ASSERT_TRUE(DynamicMemPoolBestFit::LoadMemTrace(trace_file, &trace));
+  ASSERT_EQ(trace.size(), pool.mem_trace().size());
+  (void)remove(trace_file.c_str());
+
+  FakeMemPool replay_pool;
+  ASSERT_TRUE(replay_pool.ReplayMemTrace(trace));
+  auto statistics = replay_pool.QueryMemPoolStatistics();
+  EXPECT_EQ(statistics.used_mem_size_, 0);
+  EXPECT_EQ(statistics.used_mem_peak_, pool.QueryMemPoolStatistics().used_mem_peak_);
+}
+
+TEST_F(TestMemDynamicAllocator, test_scattered_free_benchmark) {
+  // Thousands of idle bufs of one size, and every free combines with one of them.
+  FakeMemPool pool;
+  const size_t tensor_num = 20000;
+  std::vector<DeviceMemPtr> addrs(tensor_num);
+  auto start = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < tensor_num; ++i) {
+    addrs[i] = pool.AllocTensorMem(1024);
+  }
+  for (size_t i = 0; i < tensor_num; i += 2) {
+    pool.FreeTensorMem(addrs[i]);
+  }
+  for (size_t i = tensor_num; i > 1; i -= 2) {
+    pool.FreeTensorMem(addrs[i - 1]);
+  }
+  auto cost = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+  MS_LOG(INFO) << "Alloc and free " << tensor_num << " tensors cost " << cost / (2 * tensor_num) << " ns each.";
+  auto statistics = pool.QueryMemPoolStatistics();
+  EXPECT_EQ(statistics.used_mem_size_, 0);
+  EXPECT_EQ(statistics.idle_mem_buf_num_, 1);
+}
+}  // namespace device
+}  // namespace mindspore
@@ -0,0 +1,90 @@
+# Copyright 2020 Huawei Technologies Co., Ltd
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# ============================================================================
+from mindspore.ops import Primitive
+from mindspore.ops import operations as P
+
+Conv2D = P.Conv2D(out_channel=4, kernel_size=3)
+MatMul = P.MatMul()
+BiasAdd = P.BiasAdd()
+Relu = P.ReLU()
+Mul = P.Mul()
+TensorAdd = P.TensorAdd()
+Sqrt = P.Sqrt()
+make_tuple = Primitive('make_tuple')
+FusedElemwise = Primitive('FusedElemwise')
+
+
+class FnDict:
+    def __init__(self):
+        self.fnDict = {}
+
+    def __call__(self, fn):
+        self.fnDict[fn.__name__] = fn
+
+    def __getitem__(self, name):
+        return self.fnDict[name]
+
+
+def test_conv2d_bias_relu_fusion(tag):
+    fns = FnDict()
+
+    @fns
+    def before(x, w, b):
+        return Relu(BiasAdd(Conv2D(x, w), b))
+
+    @fns
+    def after(x, w, b):
+        return make_tuple(Conv2D(x, w, b))
+
+    return fns[tag]
+
+
+def test_matmul_bias_relu_fusion(tag):
+    fns = FnDict()
+
+    @fns
+    def before(x, w, b):
+        return Relu(BiasAdd(MatMul(x, w), b))
+
+    @fns
+    def after(x, w, b):
+        return make_tuple(MatMul(x, w, b))
+
+    return fns[tag]
+
+
+def test_matmul_used_by_others(tag):
+    fns = FnDict()
+
+    @fns
+    def before(x, w, b):
+        matmul = MatMul(x, w)
+        return make_tuple(BiasAdd(matmul, b), matmul)
+
+    return fns[tag]
+
+
+def test_elemwise_chain_fusion(tag):
+    fns = FnDict()
+
+    @fns
+    def before(x, y, z):
+        return Relu(TensorAdd(Mul(x, y), Sqrt(z)))
+
+    @fns
+    def after(x, y, z):
+        return make_tuple(FusedElemwise(x, y, z))
+
+    return fns[tag]
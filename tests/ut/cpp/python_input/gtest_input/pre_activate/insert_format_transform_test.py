@@ -0,0 +1,49 @@
+# Copyright 2020 Huawei Technologies Co., Ltd
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# ============================================================================
+from mindspore.ops import Primitive
+from mindspore.ops import operations as P
+
+Conv2D = P.Conv2D(out_channel=4, kernel_size=3)
+Relu = P.ReLU()
+make_tuple = Primitive('make_tuple')
+TransData = Primitive('TransData')
+
+
+class FnDict:
+    def __init__(self):
+        self.fnDict = {}
+
+    def __call__(self, fn):
+        self.fnDict[fn.__name__] = fn
+
+    def __getitem__(self, name):
+        return self.fnDict[name]
+
+
+def test_insert_format_transform(tag):
+    fns = FnDict()
+
+    @fns
+    def before(x, w):
+        conv = Conv2D(x, w)
+        return Relu(conv)
+
+    @fns
+    def after(x, w):
+        conv = Conv2D(TransData(x), w)
+        res = TransData(Relu(conv))
+        return make_tuple(res)
+
+    return fns[tag]
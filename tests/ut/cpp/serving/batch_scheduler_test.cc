@@ -0,0 +1,190 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <atomic>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include "common/common_test.h"
+#include "serving/core/batch_scheduler.h"
+#include "serving/core/serving_tensor.h"
+
+namespace mindspore {
+namespace serving {
+// Adds one to every float32 input element, only accepts inputs of at most max_rows rows.
+class MockAddOneSession : public inference::InferSession {
+ public:
+  explicit MockAddOneSession(int64_t max_rows) : max_rows_(max_rows) {}
+  Status InitEnv(const std::string &, uint32_t) override { return SUCCESS; }
+  Status FinalizeEnv() override { return SUCCESS; }
+  Status LoadModelFromFile(const std::string &, uint32_t &model_id) override {
+    model_id = 1;
+    return SUCCESS;
+  }
+  Status UnloadModel(uint32_t) override { return SUCCESS; }
+  Status ExecuteModel(uint32_t, const inference::RequestBase &request, inference::ReplyBase &reply) override {
+    executions_++;
+    reply.clear();
+    for (size_t i = 0; i < request.size(); i++) {
+      auto input = request[i];
+      if (input->shape().empty() || input->shape()[0] > max_rows_) {
+        return INVALID_INPUTS;
+      }
+      max_executed_rows_ = std::max<int64_t>(max_executed_rows_, input->shape()[0]);
+      auto output = reply.add();
+      output->set_data_type(input->data_type());
+      output->set_shape(input->shape());
+      output->set_data(input->data(), input->data_size());
+      auto data = static_cast<float *>(output->mutable_data());
+      for (size_t j = 0; j < output->data_size() / sizeof(float); j++) {
+        data[j] += 1;
+      }
+    }
+    return SUCCESS;
+  }
+  std::atomic<int> executions_{0};
+  std::atomic<int64_t> max_executed_rows_{0};
+
+ private:
+  int64_t max_rows_;
+};
+
+class TestBatchScheduler : public UT::Common {
+ public:
+  TestBatchScheduler() = default;
+
+  static void CreateRequest(PredictRequest *request, int64_t rows, float value) {
+    auto tensor = request->add_data();
+    tensor->set_tensor_type(ms_serving::MS_FLOAT32);
+    tensor->mutable_tensor_shape()->add_dims(rows);
+    tensor->mutable_tensor_shape()->add_dims(2);
+    std::vector<float> data(rows * 2, value);
+    tensor->set_data(data.data(), data.size() * sizeof(float));
+  }
+
+  static bool CheckReply(const PredictReply &reply, int64_t rows, float value) {
+    if (reply.result_size() != 1 || reply.result(0).tensor_shape().dims(0) != rows) {
+      return false;
+    }
+    auto data = reinterpret_cast<const float *>(reply.result(0).data().data());
+    for (int64_t i = 0; i < rows * 2; i++) {
+      if (data[i] != value + 1) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  void RunConcurrently(BatchScheduler *scheduler, int request_count, std::vector<int> *results) {
+    std::vector<std::thread> threads;
+    results->assign(request_count, 0);
+    for (int i = 0; i < request_count; i++) {
+      threads.emplace_back([scheduler, results, i]() {
+        PredictRequest request;
+        PredictReply reply;
+        CreateRequest(&request, 1 + i % 2, static_cast<float>(i));
+        (*results)[i] = scheduler->Predict(request, reply) == SUCCESS && CheckReply(reply, 1 + i % 2, i);
+      });
+    }
+    for (auto &thread : threads) {
+      thread.join();
+    }
+  }
+};
+
+TEST_F(TestBatchScheduler, test_merge_concurrent_requests) {
+  BatchOptions options;
+  options.max_batch_size = 16;
+  options.max_queue_delay_us = 200000;
+  BatchScheduler scheduler(options);
+  auto session = std::make_shared<MockAddOneSession>(16);
+  scheduler.AddInstance(session);
+  ASSERT_EQ(scheduler.LoadModel("model"), SUCCESS);
+  scheduler.Start();
+
+  std::vector<int> results;
+  RunConcurrently(&scheduler, 8, &results);
+  for (auto result : results) {
+    ASSERT_TRUE(result);
+  }
+  ASSERT_LT(session->executions_, 8);
+  ASSERT_LE(session->max_executed_rows_, 16);
+  auto metrics = scheduler.GetMetrics();
+  ASSERT_EQ(metrics.requests, 8);
+  ASSERT_EQ(metrics.failed_requests, 0);
+  ASSERT_GT(metrics.merged_requests, 0);
+  scheduler.Clear();
+}
+
+TEST_F(TestBatchScheduler, test_fallback_when_model_rejects_merged_inputs) {
+  BatchOptions options;
+  options.max_batch_size = 16;
+  options.max_queue_delay_us = 200000;
+  BatchScheduler scheduler(options);
+  scheduler.AddInstance(std::make_shared<MockAddOneSession>(2));
+  scheduler.AddInstance(std::make_shared<MockAddOneSession>(2));
+  ASSERT_EQ(scheduler.LoadModel("model"), SUCCESS);
+  scheduler.Start();
+
+  std::vector<int> results;
+  RunConcurrently(&scheduler, 8, &results);
+  for (auto result : results) {
+    ASSERT_TRUE(result);
+  }
+  ASSERT_EQ(scheduler.GetMetrics().failed_requests, 0);
+  scheduler.Clear();
+}
+
+TEST_F(TestBatchScheduler, test_fail_request_with_wrong_data_size) {
+  BatchOptions options;
+  options.max_batch_size = 16;
+  options.max_queue_delay_us = 200000;
+  BatchScheduler scheduler(options);
+  auto session = std::make_shared<MockAddOneSession>(16);
+  scheduler.AddInstance(session);
+  ASSERT_EQ(scheduler.LoadModel("model"), SUCCESS);
+  scheduler.Start();
+
+  std::vector<int> results(4, 0);
+  std::vector<std::thread> threads;
+  for (int i = 0; i < 4; i++) {
+    threads.emplace_back([&scheduler, &results, i]() {
+      PredictRequest request;
+      PredictReply reply;
+      CreateRequest(&request, 2, static_cast<float>(i));
+      if (i == 0) {
+        // one float short of the declared shape
+        auto data = request.data(0).data();
+        request.mutable_data(0)->set_data(data.substr(0, data.size() - sizeof(float)));
+        results[i] = scheduler.Predict(request, reply) == INVALID_INPUTS;
+        return;
+      }
+      results[i] = scheduler.Predict(request, reply) == SUCCESS && CheckReply(reply, 2, i);
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  for (auto result : results) {
+    ASSERT_TRUE(result);
+  }
+  auto metrics = scheduler.GetMetrics();
+  ASSERT_EQ(metrics.requests, 4);
+  ASSERT_EQ(metrics.failed_requests, 1);
+  scheduler.Clear();
+}
+}  // namespace serving
+}  // namespace mindspore
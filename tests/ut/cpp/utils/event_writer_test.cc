@@ -0,0 +1,110 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <chrono>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <thread>
+#include <vector>
+#include "common/common_test.h"
+#include "utils/summary/event_writer.h"
+
+namespace mindspore {
+namespace summary {
+namespace {
+constexpr size_t kRecordMetaLength = 16;
+
+std::string ReadFile(const std::string &file_name) {
+  std::ifstream ifs(file_name, std::ios::binary);
+  return std::string((std::istreambuf_iterator<char>(ifs)), std::istreambuf_iterator<char>());
+}
+}  // namespace
+
+class TestEventWriter : public UT::Common {
+ public:
+  TestEventWriter() : file_name_("./event_writer_test.summary") {}
+  void SetUp() override { std::ofstream(file_name_).close(); }
+  void TearDown() override { (void)remove(file_name_.c_str()); }
+
+ protected:
+  std::string file_name_;
+};
+
+// Events written from several threads are all in the file after Flush.
+TEST_F(TestEventWriter, test_multi_thread_write_flush) {
+  EventWriter writer(file_name_);
+  writer.SetFlushPolicy(4, 50);
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; t++) {
+    threads.emplace_back([&writer, t]() {
+      for (int i = 0; i < 100; i++) {
+        writer.Write(std::string(10, static_cast<char>('a' + t)));
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  ASSERT_TRUE(writer.Flush());
+  ASSERT_EQ(writer.GetWriteEventCount(), 400);
+  ASSERT_EQ(ReadFile(file_name_).size(), 400 * (10 + kRecordMetaLength));
+  ASSERT_TRUE(writer.Shut());
+}
+
+// Droppable events over the budget are dropped, the others are never dropped.
+TEST_F(TestEventWriter, test_drop_budget) {
+  EventWriter writer(file_name_);
+  writer.SetFlushPolicy(1000, 100000);
+  writer.SetDropBudget(100);
+  int written = 0;
+  for (int i = 0; i < 10; i++) {
+    written += writer.WriteDroppable(std::string(30, 'h')) ? 1 : 0;
+    writer.Write(std::string(30, 's'));
+  }
+  ASSERT_EQ(written, 3);
+  ASSERT_EQ(writer.GetDropEventCount(), 7);
+  ASSERT_TRUE(writer.Shut());
+  ASSERT_EQ(ReadFile(file_name_).size(), 13 * (30 + kRecordMetaLength));
+
+  std::string record;
+  EventWriter::EncodeRecord("abc", &record);
+  ASSERT_EQ(record.size(), 3 + kRecordMetaLength);
+}
+
+// The pending events are written once flush_steps steps have ended, however many events a step has.
+TEST_F(TestEventWriter, test_flush_steps) {
+  EventWriter writer(file_name_);
+  writer.SetFlushPolicy(2, 100000);
+  // The events are larger than the stdio buffer, so a written batch reaches the file without a flush.
+  const size_t event_size = 16 * 1024;
+  for (int i = 0; i < 5; i++) {
+    writer.Write(std::string(event_size, 'a'));
+  }
+  writer.StepEnd();
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  ASSERT_EQ(ReadFile(file_name_).size(), 0);
+
+  writer.Write(std::string(event_size, 'b'));
+  writer.StepEnd();
+  for (int i = 0; i < 500 && ReadFile(file_name_).empty(); i++) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+  ASSERT_FALSE(ReadFile(file_name_).empty());
+  ASSERT_TRUE(writer.Shut());
+  ASSERT_EQ(ReadFile(file_name_).size(), 6 * (event_size + kRecordMetaLength));
+}
+}  // namespace summary
+}  // namespace mindspore
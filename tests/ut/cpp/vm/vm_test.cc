@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 #include "vm/vm.h"
+#include <chrono>
 #include "common/common_test.h"
 #include "frontend/operator/ops.h"
 #include "vm/backend.h"
@@ -56,5 +57,64 @@ TEST_F(TestCompileVM, FinalVM) {
   vm = nullptr;
 }
 
+// Instructions of `while (n > 0) { n = n - 1; } return n;` in the layout emitted by CompileGraph: the loop header
+// switches between the body and the exit graph and tail calls the chosen branch.
+InstSet WhileLoopInsts() {
+  auto cond = std::make_shared<RunFunc>([](const VectorRef &args) -> VectorRef {
+    return VectorRef(std::vector<BaseRef>{utils::cast<int>(args[0]) > 0});
+  });
+  auto dec = std::make_shared<RunFunc>([](const VectorRef &args) -> VectorRef {
+    return VectorRef(std::vector<BaseRef>{utils::cast<int>(args[0]) - 1});
+  });
+  const int header = 0;
+  const int body = 7;
+  const int exit = 12;
+  InstSet insts;
+  // header(n)
+  insts.push_back({Instruction::kPadStack, VectorRef({5})});
+  insts.push_back({Instruction::kExternal, VectorRef({cond, cond, -1})});
+  insts.push_back({Instruction::kPush, VectorRef({body})});
+  insts.push_back({Instruction::kPush, VectorRef({exit})});
+  insts.push_back({Instruction::kSwitch, VectorRef({-3, -2, -1})});
+  insts.push_back({Instruction::kInput, VectorRef({-5})});
+  insts.push_back({Instruction::kTailCall, VectorRef({-2, 6, 1})});
+  // body(n)
+  insts.push_back({Instruction::kPadStack, VectorRef({3})});
+  insts.push_back({Instruction::kExternal, VectorRef({dec, dec, -1})});
+  insts.push_back({Instruction::kPush, VectorRef({header})});
+  insts.push_back({Instruction::kInput, VectorRef({-2})});
+  insts.push_back({Instruction::kTailCall, VectorRef({-2, 4, 1})});
+  // exit(n)
+  insts.push_back({Instruction::kPadStack, VectorRef({1})});
+  insts.push_back({Instruction::kInput, VectorRef({-1})});
+  insts.push_back({Instruction::kReturn, VectorRef({-2, 2})});
+  return insts;
+}
+
+TEST_F(TestCompileVM, FinalVMWhileLoop) {
+  BackendPtr backend = std::make_shared<Backend>("vm");
+  auto vm = std::make_shared<FinalVM>(WhileLoopInsts(), backend);
+  BaseRef ret = vm->Eval(VectorRef({10}));
+  ASSERT_TRUE(utils::isa<int>(ret));
+  ASSERT_EQ(utils::cast<int>(ret), 0);
+}
+
+// Micro benchmark of the interpreter loop on a control flow heavy program, the time is reported per executed
+// instruction so that it can be compared across changes of the dispatch path.
+TEST_F(TestCompileVM, FinalVMWhileLoopBenchmark) {
+  BackendPtr backend = std::make_shared<Backend>("vm");
+  auto vm = std::make_shared<FinalVM>(WhileLoopInsts(), backend);
+  const int iterations = 100000;
+  // Each iteration runs the header and the body, the last one runs the header and the exit graph.
+  const double executed_insts = 12.0 * iterations + 10.0;
+  auto start = std::chrono::steady_clock::now();
+  BaseRef ret = vm->Eval(VectorRef({iterations}));
+  auto end = std::chrono::steady_clock::now();
+  ASSERT_EQ(utils::cast<int>(ret), 0);
+  double cost_ns = std::chrono::duration<double, std::nano>(end - start).count();
+  MS_LOG(INFO) << "FinalVM while loop: " << iterations << " iterations, " << cost_ns / executed_insts
+               << " ns per instruction.";
+}
+
 }  // namespace compile
 }  // namespace mindspore
@@ -18,7 +18,9 @@ Testing configuration manager
 import os
 import filecmp
 import glob
+import tempfile
 import numpy as np
+import pytest
 
 import mindspore.dataset as ds
 import mindspore.dataset.transforms.vision.c_transforms as c_vision
@@ -359,6 +361,60 @@ def test_deterministic_python_seed_multi_thread():
     ds.config.set_seed(seed_original)
 
 
+def test_tensor_pool():
+    """
+    Test that a pipeline with a tensor pool gives the same output as one without it
+    """
+    tensor_pool_size_original = ds.config.get_tensor_pool_size()
+    assert tensor_pool_size_original == 0
+
+    def decode_pipeline():
+        data = ds.TFRecordDataset(DATA_DIR, SCHEMA_DIR, shuffle=False)
+        data = data.map(input_columns=["image"], operations=[c_vision.Decode(), c_vision.Resize((100, 100))])
+        data = data.batch(3)
+        return [item["image"] for item in data.create_dict_iterator(num_epochs=1)]
+
+    expected = decode_pipeline()
+    ds.config.set_tensor_pool_size(64)
+    assert ds.config.get_tensor_pool_size() == 64
+    output = decode_pipeline()
+    np.testing.assert_equal(output, expected)
+
+    with pytest.raises(ValueError, match="Tensor pool size"):
+        ds.config.set_tensor_pool_size(-1)
+
+    # Restore original configuration values
+    ds.config.set_tensor_pool_size(tensor_pool_size_original)
+
+
+def test_text_index():
+    """
+    Test that the text datasets give the same rows with the row indexes cached in a directory
+    """
+    text_files = ["../data/dataset/testTextFileDataset/1.txt", "../data/dataset/testTextFileDataset/2.txt"]
+    assert ds.config.get_text_chunk_size() == 64
+    assert ds.config.get_text_index_dir() == ""
+
+    def text_pipeline():
+        data = ds.TextFileDataset(text_files, shuffle=False)
+        return data.get_dataset_size(), [item["text"].item() for item in data.create_dict_iterator(num_epochs=1)]
+
+    expected = text_pipeline()
+    with tempfile.TemporaryDirectory() as index_dir:
+        ds.config.set_text_index_dir(index_dir)
+        assert ds.config.get_text_index_dir() == index_dir
+        assert text_pipeline() == expected
+        assert len(os.listdir(index_dir)) == 2
+        # The second run loads the indexes.
+        assert text_pipeline() == expected
+        ds.config.set_text_index_dir("")
+
+    with pytest.raises(ValueError, match="Text chunk size"):
+        ds.config.set_text_chunk_size(-1)
+    with pytest.raises(TypeError, match="Text index dir"):
+        ds.config.set_text_index_dir(1)
+
+
 if __name__ == '__main__':
     test_basic()
     test_get_seed()
@@ -369,3 +425,5 @@ if __name__ == '__main__':
     test_deterministic_run_distribution()
     test_deterministic_python_seed()
     test_deterministic_python_seed_multi_thread()
+    test_tensor_pool()
+    test_text_index()
@@ -615,6 +615,51 @@ def test_generator_schema():
         type_tester_with_type_check_2c_schema(np_types[i], [de_types[i], de_types[i]])
 
 
+def test_generator_columnar():
+    """
+    Test columnar Generator, which yields blocks of rows
+    """
+    logger.info("Test columnar Generator : 0 - 63 in blocks of 10 rows")
+
+    def generator_columnar():
+        for i in range(0, 64, 10):
+            n = min(10, 64 - i)
+            ids = np.arange(i, i + n)
+            # A strided view is made contiguous before the rows are copied out.
+            mats = np.stack([ids, ids + 1, ids + 2, ids + 3], axis=1).reshape(n, 2, 2)[:, ::-1, :]
+            yield (ids, mats, np.array(["row" + str(j) for j in range(i, i + n)]))
+
+    data1 = ds.GeneratorDataset(generator_columnar, ["id", "mat", "name"], columnar=True).repeat(2)
+    i = 0
+    for item in data1.create_dict_iterator():  # each data is a dictionary
+        row = i % 64
+        np.testing.assert_array_equal(item["id"], np.array(row))
+        np.testing.assert_array_equal(item["mat"], np.array([[row + 2, row + 3], [row, row + 1]]))
+        np.testing.assert_array_equal(item["name"], np.array("row" + str(row)))
+        i = i + 1
+    assert i == 128
+
+
+def test_generator_columnar_error():
+    """
+    Test columnar Generator with a different number of rows in the columns, and with a sampler
+    """
+    logger.info("Test columnar Generator errors")
+
+    def generator_columnar():
+        yield (np.arange(4), np.arange(3))
+
+    with pytest.raises(RuntimeError) as info:
+        data1 = ds.GeneratorDataset(generator_columnar, ["col1", "col2"], columnar=True)
+        for _ in data1.create_dict_iterator():
+            pass
+    assert "same number of rows" in str(info.value)
+
+    with pytest.raises(ValueError) as info:
+        ds.GeneratorDataset(generator_columnar, ["col1", "col2"], columnar=True, num_samples=2)
+    assert "columnar" in str(info.value)
+
+
 def manual_test_generator_keyboard_interrupt():
     """
     Test keyboard_interrupt
@@ -663,3 +708,5 @@ if __name__ == "__main__":
     test_generator_num_samples()
     test_generator_num_samples_underflow()
     test_generator_schema()
+    test_generator_columnar()
+    test_generator_columnar_error()
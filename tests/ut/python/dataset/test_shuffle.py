@@ -12,6 +12,8 @@
 # See the License for the specific language governing permissions and
 # limitations under the License.
 # ==============================================================================
+import os
+import shutil
 import numpy as np
 import mindspore.dataset as ds
 from mindspore import log as logger
@@ -133,6 +135,32 @@ def test_shuffle_06():
         np.testing.assert_equal(item1, item2)
 
 
+def test_shuffle_parallel():
+    """
+    Test shuffle: sub-buffers in parallel give the same rows for the same seed, with and without spill
+    """
+    logger.info("test_shuffle_parallel")
+    spill_dir = "./shuffle_parallel_spill"
+
+    def run(buffer_bytes=None, spill=None):
+        data1 = ds.TFRecordDataset(DATA_DIR, shuffle=ds.Shuffle.FILES)
+        ds.config.set_seed(1)
+        data1 = data1.shuffle(6, num_parallel_workers=3, buffer_bytes=buffer_bytes, spill_dir=spill)
+        return [item["col_sint64"][0] for item in data1.create_dict_iterator()]
+
+    rows = run()
+    assert len(rows) == 12
+    assert run() == rows
+    try:
+        spilled_rows = run(buffer_bytes=3, spill=spill_dir)
+        assert run(buffer_bytes=3, spill=spill_dir) == spilled_rows
+        assert sorted(spilled_rows) == sorted(rows)
+        # the spill directories of the sub-buffers are removed at the end of the epoch
+        assert not os.listdir(spill_dir)
+    finally:
+        shutil.rmtree(spill_dir, ignore_errors=True)
+
+
 def test_shuffle_exception_01():
     """
     Test shuffle exception: buffer_size<0
@@ -248,6 +276,7 @@ if __name__ == '__main__':
     test_shuffle_04()
     test_shuffle_05()
     test_shuffle_06()
+    test_shuffle_parallel()
     test_shuffle_exception_01()
     test_shuffle_exception_02()
     test_shuffle_exception_03()
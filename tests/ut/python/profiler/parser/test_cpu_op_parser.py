@@ -0,0 +1,59 @@
+# Copyright 2020 Huawei Technologies Co., Ltd
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# ============================================================================
+"""Test the cpu op summary parser."""
+import os
+import tempfile
+import shutil
+
+from unittest import TestCase
+
+from mindspore.profiler.common.exceptions.exceptions import ProfilerFileNotFoundException
+from mindspore.profiler.parser.cpu_op_parser import CpuOpSummaryParser
+
+SUMMARY_CONTENT = """op_name,op_type,count,total_us,avg_us,min_us,max_us,bytes_read,bytes_written
+Default/Conv2D-op1,Conv2D,10,3000,300,250,400,1024,512
+Default/Conv2D-op2,Conv2D,10,1000,100,90,120,1024,512
+Default/ReLU-op3,ReLU,10,1000,100,80,150,512,512
+"""
+
+
+class TestCpuOpSummaryParser(TestCase):
+    """Test the class of CpuOpSummaryParser."""
+
+    def setUp(self) -> None:
+        """Initialization before test case execution."""
+        self.output_path = tempfile.mkdtemp(prefix='cpu_op_summary_')
+        with open(os.path.join(self.output_path, 'cpu_op_summary_0.csv'), 'w') as summary_file:
+            summary_file.write(SUMMARY_CONTENT)
+
+    def tearDown(self) -> None:
+        """Clean up after test case execution."""
+        shutil.rmtree(self.output_path)
+
+    def test_parse_and_aggregate(self):
+        """Test the op type aggregation of CpuOpSummaryParser."""
+        parser = CpuOpSummaryParser(self.output_path, '0')
+        details = parser.parse()
+        assert len(details) == 3
+        assert details[0]['bytes_read'] == 1024
+        assert parser.get_op_type_info() == [['Conv2D', 4.0, 20, 80.0], ['ReLU', 1.0, 10, 20.0]]
+        parser.write_op_detail()
+        assert os.path.isfile(os.path.join(self.output_path, 'output_op_compute_time_detail_0.txt'))
+
+    def test_summary_file_not_exist(self):
+        """Test CpuOpSummaryParser when the summary file is missing."""
+        parser = CpuOpSummaryParser(self.output_path, '1')
+        with self.assertRaises(ProfilerFileNotFoundException):
+            parser.parse()
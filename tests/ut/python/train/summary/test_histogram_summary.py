@@ -84,6 +84,35 @@ def test_histogram_multi_summary():
                 event = reader.read_event()
                 assert event.summary.value[0].histogram.count == size
 
+def test_histogram_summary_drop_budget():
+    """Test the histograms beyond the drop budget are dropped, while the scalars are kept."""
+    with tempfile.TemporaryDirectory() as tmp_dir:
+        with SummaryRecord(tmp_dir, file_suffix="_MS_HISTOGRAM", flush_steps=1, flush_interval_ms=10,
+                           drop_budget=0) as test_writer:
+            test_writer.add_value('histogram', 'test_data', Tensor([[1, 2, 3], [4, 5, 6]]))
+            test_writer.add_value('scalar', 'loss', Tensor(0.5))
+            test_writer.record(step=1)
+
+        file_name = os.path.join(tmp_dir, test_writer.event_file_name)
+        with SummaryReader(file_name) as reader:
+            event = reader.read_event()
+            assert len(event.summary.value) == 1
+            assert event.summary.value[0].tag == 'loss'
+            assert reader.read_event() is None
+
+    # with the default budget the histogram is written as an event of its own
+    with tempfile.TemporaryDirectory() as tmp_dir:
+        with SummaryRecord(tmp_dir, file_suffix="_MS_HISTOGRAM") as test_writer:
+            test_writer.add_value('histogram', 'test_data', Tensor([[1, 2, 3], [4, 5, 6]]))
+            test_writer.add_value('scalar', 'loss', Tensor(0.5))
+            test_writer.record(step=1)
+
+        file_name = os.path.join(tmp_dir, test_writer.event_file_name)
+        with SummaryReader(file_name) as reader:
+            assert reader.read_event().summary.value[0].tag == 'loss'
+            assert reader.read_event().summary.value[0].histogram.count == 6
+
+
 def test_histogram_summary_empty_tensor():
     """Test histogram summary, input is an empty tensor."""
     with tempfile.TemporaryDirectory() as tmp_dir: